@@ -25,6 +25,9 @@ Enemy::Enemy() {
 Enemy::~Enemy()
 {
 	//obbCollider_->~OBBCollider();
+	if (gameTime_) {
+		gameTime_->UnregisterObject(timeHandle_);
+	}
 }
 void Enemy::Initialize(Camera* camera, const Vector3& pos)
 {
@@ -67,9 +70,8 @@ void Enemy::Initialize(Camera* camera, const Vector3& pos)
     particleEmitter_ = std::make_unique<ParticleEmitter>("EnemyParticle", worldTransform_.translation_, 5);
     particleEmitter_->Initialize();
 	
-	timeID_ = "Enemy : " + std::to_string(serialNumber_);
 	gameTime_ = GameTime::GetInstance();
-	gameTime_->RegisterObject(timeID_);
+	timeHandle_ = gameTime_->RegisterObject();
 
     //InitJson();
 }
@@ -143,11 +145,6 @@ void Enemy::Update()
     }
 	isHit_ = false;
 
-#ifdef _DEBUG
-   ShowCoordinatesImGui();
-
-#endif // _DEBUG
- 
    //particleEmitter_->UpdateEmit("Enemy", WS_.translation_, 5);
 
     worldTransform_.UpdateMatrix();
@@ -240,7 +237,7 @@ void Enemy::OnCollision(BaseCollider* self, BaseCollider* other)
             isActive_ = false;  // 完全に無効化
         }
         isShake_ = true;
-        HitStop::GetInstance()->Start("Player", HitStop::HitStopType::Heavy);
+        HitStop::GetInstance()->Start(player_->GetTimeHandle(), HitStop::HitStopType::Heavy);
     }
 }
 
@@ -321,7 +318,7 @@ void Enemy::EnemyAllHitStop()
 
 void Enemy::Move() {
     // デルタタイムの取得
-    deltaTime_ = gameTime_->GetDeltaTime(timeID_);
+    deltaTime_ = gameTime_->GetDeltaTime(timeHandle_);
 
     // ヒットストップ中は動きを停止
     if (deltaTime_ <= 0.001f) {
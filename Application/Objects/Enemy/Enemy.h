@@ -97,6 +97,7 @@ public: // アクセッサ
 	/// シリアルナンバーの取得
 	/// </summary>
 	uint32_t GetSerialNumber() const { return serialNumber_; }
+	TimeHandle GetTimeHandle() const { return timeHandle_; }
 	bool IsActive() const { return isActive_; }
 
 
@@ -140,7 +141,7 @@ private:
 	bool isHit_ = false;
 
 
-	std::string timeID_;
+	TimeHandle timeHandle_ = TimeHandleUtil::kInvalid;
 	GameTime* gameTime_ = nullptr;
 	float deltaTime_;
 
@@ -1,4 +1,6 @@
 #include "EnemyManager.h"
+#include "Systems/GameTime/FrameTimer.h"
+#include "Systems/Random/RandomSeed.h"
 #include <random>
 
 void EnemyManager::Initialize(Camera* camera) {
@@ -8,7 +10,7 @@ void EnemyManager::Initialize(Camera* camera) {
 
 void EnemyManager::Update() {
     // スポーンタイマーの更新
-    spawnTimer_ += 1.0f / 60.0f;
+    spawnTimer_ += FrameTimer::GetInstance()->GetDeltaTime();
     if (spawnTimer_ >= spawnInterval_ && enemies_.size() < maxEnemyCount_) {
         SpawnEnemy();
         spawnTimer_ = 0.0f;
@@ -30,6 +32,12 @@ void EnemyManager::Update() {
     }
 }
 
+void EnemyManager::ShowImGui() {
+    for (auto& enemy : enemies_) {
+        enemy->ShowCoordinatesImGui();
+    }
+}
+
 void EnemyManager::Draw() {
     for (auto& enemy : enemies_) {
         enemy->Draw();
@@ -46,9 +54,8 @@ void EnemyManager::DrawCollision()
 void EnemyManager::SpawnEnemy() {
     if (!player_) return;
 
-    // 乱数生成
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    // 乱数生成 (シードは RandomSeed からもらい、入力の再生時に同じ位置へ出す)
+    std::mt19937 gen(RandomSeed::GetInstance()->Next());
     std::uniform_real_distribution<float> dist(-spawnRange_, spawnRange_);
 
     // プレイヤーの位置を基準にランダムな位置を計算
@@ -25,6 +25,11 @@ public:
     void Draw();
 	void DrawCollision();
 
+    /// <summary>
+    /// ImGui
+    /// </summary>
+    void ShowImGui();
+
     /// <summary>
     /// 敵のスポーン処理
     /// </summary>
@@ -38,11 +43,12 @@ public:
     
      // 全ての敵にヒットストップを適用
      void ApplyHitStopToAllEnemies(HitStop::HitStopType type) {
+         // 各敵の時間ハンドルを集めてまとめて適用
+         timeHandles_.clear();
          for (auto& enemy : enemies_) {
-             // 各敵のtimeIDを取得してヒットストップを適用
-             std::string timeID = "Enemy : " + std::to_string(enemy->GetSerialNumber());
-             HitStop::GetInstance()->Start(timeID, type);
+             timeHandles_.push_back(enemy->GetTimeHandle());
          }
+         HitStop::GetInstance()->StartBatch(timeHandles_, type);
      }
 
 private:
@@ -55,6 +61,7 @@ private:
 
     // ポインタ
     std::vector<std::unique_ptr<Enemy>> enemies_;
+    std::vector<TimeHandle> timeHandles_;
     Camera* camera_ = nullptr;
     Player* player_ = nullptr;
 };
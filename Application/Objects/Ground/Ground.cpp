@@ -1,4 +1,5 @@
 #include "Ground.h"
+#include "Culling/OcclusionRasterizer.h"
 
 void Ground::Initialize(Camera* camera)
 {
@@ -21,3 +22,15 @@ void Ground::Draw()
 {
 	obj_->Draw(camera_,worldTransform_);
 }
+
+void Ground::AddOccluders(OcclusionRasterizer& occlusion)
+{
+	const Model::ModelData& modelData = obj_->GetModel()->GetModelData();
+	if (modelData.vertices.empty()) {
+		return;
+	}
+	// Object3d::Draw と同じワールド行列
+	Matrix4x4 worldMatrix = worldTransform_.GetInterpolatedMatWorld() * modelData.rootNode.localMatrix;
+	occlusion.AddOccluder(&modelData.vertices[0].position.x, sizeof(Model::VertexData), static_cast<uint32_t>(modelData.vertices.size()),
+		modelData.indices.data(), static_cast<uint32_t>(modelData.indices.size()), worldMatrix);
+}
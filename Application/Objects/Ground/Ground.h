@@ -5,6 +5,8 @@
 #include "WorldTransform/WorldTransform.h"
 #include "Systems/Camera/Camera.h"
 
+class OcclusionRasterizer;
+
 class Ground
 {
 public:
@@ -24,6 +26,11 @@ public:
 	/// </summary>
 	void Draw();
 
+	/// <summary>
+	/// 遮蔽物として地面のメッシュを追加
+	/// </summary>
+	void AddOccluders(OcclusionRasterizer& occlusion);
+
 
 private:
 	// ポインタ
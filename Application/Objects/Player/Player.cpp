@@ -49,9 +49,8 @@ void Player::Initialize(Camera* camera)
 
 	InitJson();
 
-	timeID_ = "Player";
 	gameTime_ = GameTime::GetInstance();
-	gameTime_->RegisterObject(timeID_);
+	timeHandle_ = gameTime_->RegisterObject();
 }
 
 void Player::InitCollision()
@@ -189,7 +188,7 @@ void Player::Rotate()
 
 void Player::MoveController()
 {
-	deltaTime_ = gameTime_->GetDeltaTime(timeID_);
+	deltaTime_ = gameTime_->GetDeltaTime(timeHandle_);
 
 	// ヒットストップ中は動きを停止
 	if (deltaTime_ <= 0.001f) {
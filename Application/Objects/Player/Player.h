@@ -159,6 +159,8 @@ public: // アクセッサ
 	void SetCameraSprite(Camera* camera) { sprite_->SetCamera(camera); }
 	void SetCamera(Camera* camera) { camera_ = camera; }
 	void SetPosition(Vector3 pos) { worldTransform_.translation_ = pos; }
+	TimeHandle GetTimeHandle() const { return timeHandle_; }
+	void SetMapChipBoxes(const MapChipBoxes* boxes) { mpCollision_.SetBoxes(boxes); }
 
 private: 
 	/*===============================================================//
@@ -239,7 +241,7 @@ private:
 	//float deceleration_ = 0.0f;  // 減速度
 	
 
-	std::string timeID_;
+	TimeHandle timeHandle_ = TimeHandleUtil::kInvalid;
 	GameTime* gameTime_ = nullptr;
 	float deltaTime_ = 0.0f;
 };
@@ -21,6 +21,11 @@ public: // 純粋仮想関数
 	/// </summary>
 	virtual void Update() = 0;
 
+	/// <summary>
+	/// ImGui (描画フレームごとに1回。固定ステップの更新とは別に呼ばれる)
+	/// </summary>
+	virtual void UpdateImGui() {}
+
 	/// <summary>
 	/// 描画
 	/// </summary>
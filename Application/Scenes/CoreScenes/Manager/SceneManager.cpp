@@ -72,6 +72,13 @@ void SceneManager::Update()
     }
 }
 
+void SceneManager::UpdateImGui()
+{
+    if (scene_) {
+        scene_->UpdateImGui();
+    }
+}
+
 void SceneManager::Draw()
 {
     // 現在のシーンの描画
@@ -25,6 +25,9 @@ public:
     /// <summary> 更新 </summary>
     void Update();
 
+    /// <summary> ImGui (描画フレームごとに1回) </summary>
+    void UpdateImGui();
+
     /// <summary> 描画 </summary>
     void Draw();
 
@@ -4,13 +4,14 @@
 #include "Systems./Input./Input.h"
 #include "Loaders./Texture./TextureManager.h"
 #include "Particle./ParticleManager.h"
+#include "Systems/GameTime/FrameTimer.h"
 #include "Object3D/Object3dCommon.h"
 #include "Sprite/SpriteCommon.h"
 
 void ClearScene::Initialize()
 {
     sprite_ = std::make_unique<Sprite>();
-    sprite_->Initialize("Resources/Textures/KoboClear.png");
+    sprite_->Initialize(kClearTexturePath);
     sprite_->SetSize(Vector2{ 1280.0f,720.0f });
     sprite_->SetTextureSize(Vector2{ 1280,720 });
 
@@ -19,6 +20,9 @@ void ClearScene::Initialize()
 
 void ClearScene::Finalize()
 {
+    // このシーンでしか使わない画像を解放してSRVを返す
+    sprite_.reset();
+    TextureManager::GetInstance()->UnloadTexture(kClearTexturePath);
 }
 
 void ClearScene::Update()
@@ -29,6 +33,9 @@ void ClearScene::Update()
 
 void ClearScene::Draw()
 {
+    // 固定ステップの間を補間したカメラで描画する
+    cameraManager_.InterpolateAllCameras(FrameTimer::GetInstance()->GetInterpolationAlpha());
+
 #pragma region 演出描画
     ParticleManager::GetInstance()->Draw();
 
@@ -44,6 +51,7 @@ void ClearScene::Draw()
 
     sprite_->Draw();
 
+    SpriteCommon::GetInstance()->DrawBatch();
 
 #pragma endregion
 
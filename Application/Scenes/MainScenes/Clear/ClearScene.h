@@ -62,6 +62,8 @@ private:
 	// プレイヤー
 
 	std::unique_ptr<Fade> fade_;
+	// 背景 (このシーンだけで使うので Finalize で解放する)
+	static inline const std::string kClearTexturePath = "Resources/Textures/KoboClear.png";
 	std::unique_ptr<Sprite> sprite_;
 };
 
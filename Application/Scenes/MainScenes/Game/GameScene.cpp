@@ -6,15 +6,14 @@
 #include "Loaders./Texture./TextureManager.h"
 #include "Particle./ParticleManager.h"
 #include "Object3D/Object3dCommon.h"
-#include "PipelineManager/SkinningManager.h"
+#include "RenderQueue/RenderQueueManager.h"
 #include "Loaders/Model/Model.h"
 #include "Collision/Core/CollisionManager.h"
 #include <Systems/GameTime/HitStop.h>
-#include "../Graphics/Culling/OcclusionCullingManager.h"
+#include "Systems/Random/RandomSeed.h"
 
 //C++
 #include <cstdlib>
-#include <ctime>
 #include <numbers>
 
 #ifdef _DEBUG
@@ -23,13 +22,14 @@
 #include "LightManager/LightManager.h"
 #include "Sprite/SpriteCommon.h"
 #include <Systems/GameTime/GameTIme.h>
+#include <Systems/GameTime/FrameTimer.h>
 #include "Quaternion.h"
 /// <summary>
 /// 初期化処理
 /// </summary>
 void GameScene::Initialize()
 {
-	srand(static_cast<unsigned int>(time(nullptr))); // 乱数シード設定
+	srand(RandomSeed::GetInstance()->Next()); // 乱数シード設定 (入力の再生時は記録した時と同じ並びになる)
 	// カメラの生成
 	sceneCamera_ = cameraManager_.AddCamera();
 
@@ -63,6 +63,7 @@ void GameScene::Initialize()
 	debugCamera_.Initialize();
 	// 各オブジェクトの初期化
 	player_ = std::make_unique<Player>(mpInfo_->GetMapChipField());
+	player_->SetMapChipBoxes(mpInfo_->GetMapChipBoxes());
 	player_->Initialize(sceneCamera_.get());
 	Vector3 playerPosition = mpInfo_->GetMapChipField()->GetMapChipPositionByIndex(1, 16);
 	player_->SetPosition(playerPosition);
@@ -108,7 +109,7 @@ void GameScene::Initialize()
 
 
 	sprite_ = std::make_unique<Sprite>();
-	sprite_->Initialize("Resources/Textures/KoboRB.png");
+	sprite_->Initialize(kSpriteTexturePath);
 	sprite_->SetSize(Vector2{ 1280.0f,720.0f });
 	sprite_->SetTextureSize(Vector2{ 1280,720 });
 
@@ -125,8 +126,6 @@ void GameScene::Initialize()
 	obb.center = { 0.0f, 2.0f, 0.0f },
 	obb.size = { 1.0f, 2.0f, 0.5f },
 	obb.rotation = { 0.0f,0.0f,0.0f};
-
-	OcclusionCullingManager::GetInstance()->Initialize();
 }
 
 /// <summary>
@@ -148,7 +147,10 @@ void GameScene::Update()
 	//    iCommand_->Exec(*player_.get());
 	//}
 
-	// パーティクル更新
+	// 時間領域とヒットストップを進める
+	GameTime::GetInstance()->GameUpdate(FrameTimer::GetInstance()->GetDeltaTime());
+
+	// マップチップ更新
 	mpInfo_->Update();
 
 
@@ -167,16 +169,11 @@ void GameScene::Update()
 
 	ParticleManager::GetInstance()->Update();
 	// カメラ更新
-	UpdateCameraMode();
 	UpdateCamera();
 
 
-	ShowImGui();
-
-
 	// particleEmitter_[1]->Update();
 
-	JsonManager::ImGuiManager();
 	// ワールドトランスフォーム更新
 	testWorldTransform_.UpdateMatrix();
 	cameraManager_.UpdateAllCameras();
@@ -186,10 +183,6 @@ void GameScene::Update()
 	/*                  これより下は触るな危険　　　　　　　   　*/
 	//=====================================================//
 
-	// ライティング
-	LightManager::GetInstance()->ShowLightingEditor();
-	
-
 	sprite_->Update();
 	uiBase_->Update();
 
@@ -198,31 +191,57 @@ void GameScene::Update()
 }
 
 
+/// <summary>
+/// ImGui
+/// 更新は1フレームに0回以上回るので、ウィンドウはここで描画フレームごとに1回だけ出す
+/// </summary>
+void GameScene::UpdateImGui()
+{
+	UpdateCameraMode();
+	ShowImGui();
+	JsonManager::ImGuiManager();
+	// ライティング
+	LightManager::GetInstance()->ShowLightingEditor();
+
+	mpInfo_->ShowImGui();
+	enemyManager_->ShowImGui();
+	ParticleManager::GetInstance()->ShowImGui();
+#ifdef _DEBUG
+	uiBase_->ImGUi();
+	uiSub_->ImGUi();
+#endif // _DEBUG
+}
+
 /// <summary>
 /// 描画処理
 /// </summary>
 void GameScene::Draw()
 {
+	// 固定ステップの間を補間したカメラで描画する
+	cameraManager_.InterpolateAllCameras(FrameTimer::GetInstance()->GetInterpolationAlpha());
+
 	//---------
-	// 3D
+	// 3D・Animation
 	//---------
-	Object3dCommon::GetInstance()->DrawPreference();
-	LightManager::GetInstance()->SetCommandList();
+	// 大きい遮蔽物 (マップチップ・地面) を低解像度の深度に描いておき、隠れる描画はFlushで間引く
+	OcclusionRasterizer& occlusion = RenderQueueManager::GetInstance()->GetOcclusionRasterizer();
+	occlusion.BeginFrame(sceneCamera_->GetViewProjectionMatrix());
+	mpInfo_->AddOccluders(occlusion);
+	ground_->AddOccluders(occlusion);
+	occlusion.Rasterize();
+
+	// 描画キューに積んで、パイプライン・マテリアル・テクスチャ順に並べてまとめて描画する
 	DrawObject();
-
+	DrawAnimation();
+	RenderQueueManager::GetInstance()->Flush();
 
 	//---------
-	// Animation
+	// Instancing
 	//---------
-	SkinningManager::GetInstance()->DrawPreference();
+	Object3dCommon::GetInstance()->DrawPreferenceInstancing();
 	LightManager::GetInstance()->SetCommandList();
-	DrawAnimation();
+	mpInfo_->Draw();
 	
-
-
-
-	OcclusionCullingManager::GetInstance()->ResolvedOcclusionQuery();
-
 }
 
 void GameScene::DrawOffScreen()
@@ -237,6 +256,7 @@ void GameScene::DrawOffScreen()
 	//----------
 	SpriteCommon::GetInstance()->DrawPreference();
 	DrawSprite();
+	SpriteCommon::GetInstance()->DrawBatch();
 
 	//----------
 	// Line
@@ -247,7 +267,6 @@ void GameScene::DrawOffScreen()
 
 void GameScene::DrawObject()
 {
-	mpInfo_->Draw();
 	player_->Draw();
 	ground_->Draw();
 	enemyManager_->Draw();
@@ -286,6 +305,9 @@ void GameScene::DrawLine()
 void GameScene::Finalize()
 {
 	cameraManager_.RemoveCamera(sceneCamera_);
+	// このシーンでしか使わない画像を解放してSRVを返す
+	sprite_.reset();
+	TextureManager::GetInstance()->UnloadTexture(kSpriteTexturePath);
 }
 
 
@@ -366,6 +388,13 @@ void GameScene::ShowImGui()
 #ifdef _DEBUG
 	ImGui::Begin("FPS");
 	ImGui::Text("FPS:%.1f", ImGui::GetIO().Framerate);
+	// 描画キュー (インスタンシングでまとめた後のドローコール数)
+	const RenderQueue::Stats& renderStats = RenderQueueManager::GetInstance()->GetStats();
+	ImGui::Text("Draw Calls:%u (Objects:%u Batched:%u)", renderStats.drawCalls, renderStats.packets, renderStats.batchedPackets);
+	// 視錐台カリング
+	ImGui::Text("Culled:%u (%.1fus)", RenderQueueManager::GetInstance()->GetCulledCount(), RenderQueueManager::GetInstance()->GetCullMicroseconds());
+	const OcclusionRasterizer::Stats& occlusionStats = RenderQueueManager::GetInstance()->GetOcclusionRasterizer().GetStats();
+	ImGui::Text("Occluded:%u (Occluder Tris:%u Raster:%.1fus)", RenderQueueManager::GetInstance()->GetOccludedCount(), occlusionStats.occluderTriangles, occlusionStats.rasterizeMicroseconds);
 	ImGui::End();
 	ImGui::Begin("Emitter");
 	ImGui::DragFloat3("Emitter Position", &emitterPosition_.x, 0.1f);
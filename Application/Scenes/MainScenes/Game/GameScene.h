@@ -62,6 +62,11 @@ public:
     /// </summary>
     void Update() override;
 
+    /// <summary>
+    /// ImGui
+    /// </summary>
+    void UpdateImGui() override;
+
     /// <summary>
     /// 描画
     /// </summary>
@@ -134,7 +139,7 @@ private:
 
     =================================================================*/
     Audio::SoundData soundData;
-    IXAudio2SourceVoice* sourceVoice;
+    VoicePool::Handle sourceVoice = VoicePool::kInvalidHandle;
 
     /*=================================================================
 
@@ -151,6 +156,8 @@ private:
 
     =================================================================*/
     Vector3 weaponPos;
+    // このシーンだけで使うので Finalize で解放する
+    static inline const std::string kSpriteTexturePath = "Resources/Textures/KoboRB.png";
     std::unique_ptr<Sprite> sprite_;
     std::vector<std::unique_ptr<Sprite>> sprites;
 
@@ -4,6 +4,7 @@
 #include "Systems./Input./Input.h"
 #include "Loaders./Texture./TextureManager.h"
 #include "Particle./ParticleManager.h"
+#include "Systems/GameTime/FrameTimer.h"
 #include "Object3D/Object3dCommon.h"
 
 #ifdef _DEBUG
@@ -29,18 +30,18 @@ void TitleScene::Initialize()
     //player_->Initialize(currentCamera_.get());
 
     sprite_ = std::make_unique<Sprite>();
-    sprite_->Initialize("Resources/Textures/KoboTitle.png");
+    sprite_->Initialize(kTitleTexturePath);
     sprite_->SetSize(Vector2{ 1280.0f,720.0f });
     sprite_->SetTextureSize(Vector2{ 1280,720 });
 
-    // オーディオファイルのロード（例: MP3）
-    soundData = Audio::GetInstance()->LoadAudio(L"Resources./images./harpohikunezumi.mp3");
+    // BGMはストリーミングで開く（曲全体のデコードを待たない）
+    bgmStream_ = Audio::GetInstance()->OpenStream("Resources./images./harpohikunezumi.mp3");
 
-    //// オーディオの再生
-    //sourceVoice = Audio::GetInstance()->SoundPlayAudio(soundData);
+    //// オーディオの再生（繰り返し）
+    //bgmStream_->Play(true);
 
     //// 音量の設定（0.0f ～ 1.0f）
-    //Audio::GetInstance()->SetVolume(sourceVoice, 0.05f); // 80%の音量に設定
+    //bgmStream_->SetVolume(0.05f); // 80%の音量に設定
 
 
 }
@@ -70,6 +71,9 @@ void TitleScene::Update()
 /// </summary>
 void TitleScene::Draw()
 {
+    // 固定ステップの間を補間したカメラで描画する
+    cameraManager_.InterpolateAllCameras(FrameTimer::GetInstance()->GetInterpolationAlpha());
+
 #pragma region 演出描画
     ParticleManager::GetInstance()->Draw();
 
@@ -85,6 +89,7 @@ void TitleScene::Draw()
 
     sprite_->Draw();
 
+    SpriteCommon::GetInstance()->DrawBatch();
 
 #pragma endregion
 
@@ -115,6 +120,11 @@ void TitleScene::DrawOffScreen()
 void TitleScene::Finalize()
 {
     cameraManager_.RemoveCamera(currentCamera_);
+    // デコード用スレッドとボイスを止める
+    bgmStream_.reset();
+    // このシーンでしか使わない画像を解放してSRVを返す
+    sprite_.reset();
+    TextureManager::GetInstance()->UnloadTexture(kTitleTexturePath);
 }
 
 
@@ -82,12 +82,13 @@ private:
 	std::shared_ptr<Camera> currentCamera_;
 	CameraManager cameraManager_;
 	// サウンド
-	Audio::SoundData soundData;
-	IXAudio2SourceVoice* sourceVoice;
+	std::unique_ptr<AudioStream> bgmStream_;
 
 	// プレイヤー
 	//std::unique_ptr<Player> player_;
 
+	// 背景 (このシーンだけで使うので Finalize で解放する)
+	static inline const std::string kTitleTexturePath = "Resources/Textures/KoboTitle.png";
 	std::unique_ptr<Sprite> sprite_;
 };
 
@@ -1,6 +1,7 @@
 #include "Fade.h"
 #include "Fade.h"
 #include "algorithm"
+#include "Systems/GameTime/FrameTimer.h"
 void Fade::Initialize(const std::string textureFilePath) {
 	// スプライトの生成
 	sprite_ = std::make_unique<Sprite>();
@@ -36,7 +37,7 @@ void Fade::Update() {
 void Fade::FadeIn()
 {
 	// 1フレーム分の秒数をカウントアップ
-	counter_ += 1.0f / 60.0f;
+	counter_ += FrameTimer::GetInstance()->GetDeltaTime();
 	// フェード継続時間に達したら打ち止め
 	if (counter_ >= duration_) {
 		counter_ = duration_;
@@ -50,7 +51,7 @@ void Fade::FadeIn()
 void Fade::FadeOut()
 {
 	// 1フレーム分の秒数をカウントアップ
-	counter_ += 1.0f / 60.0f;
+	counter_ += FrameTimer::GetInstance()->GetDeltaTime();
 	// フェード継続時間に達したら打ち止め
 	if (counter_ >= duration_) {
 		counter_ = duration_;
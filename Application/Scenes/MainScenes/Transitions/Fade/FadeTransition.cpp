@@ -15,6 +15,7 @@ void FadeTransition::Draw()
 {
 	SpriteCommon::GetInstance()->DrawPreference();
 	fade_->Draw();
+	SpriteCommon::GetInstance()->DrawBatch();
 }
 
 bool FadeTransition::IsFinished() const
@@ -3,9 +3,13 @@
 // C++
 #include <cassert>
 #include <thread>
+#include <atomic>
 #include <format>
 #include "d3dx12.h"
 
+// Engine
+#include "Loaders/Archive/FileSystem.h"
+
 // lib
 #pragma comment(lib,"d3d12.lib")
 #pragma comment(lib,"dxgi.lib")
@@ -16,6 +20,55 @@
 
 using namespace Microsoft::WRL;
 
+namespace {
+	/// <summary>
+	/// シェーダーの #include を FileSystem から読む
+	/// </summary>
+	class FileSystemIncludeHandler : public IDxcIncludeHandler
+	{
+	public:
+		explicit FileSystemIncludeHandler(IDxcUtils* dxcUtils) : dxcUtils_(dxcUtils) {}
+
+		HRESULT STDMETHODCALLTYPE LoadSource(LPCWSTR pFilename, IDxcBlob** ppIncludeSource) override
+		{
+			*ppIncludeSource = nullptr;
+			FileSystem::FileView file = FileSystem::GetInstance()->Open(DirectXCommon::ConvertString(std::wstring(pFilename)));
+			if (!file.IsValid()) {
+				return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+			}
+			// コンパイルが終わるまで残るようにコピーする (includeは小さい)
+			IDxcBlobEncoding* blob = nullptr;
+			HRESULT hr = dxcUtils_->CreateBlob(file.GetData(), static_cast<UINT32>(file.GetSize()), DXC_CP_UTF8, &blob);
+			*ppIncludeSource = blob;
+			return hr;
+		}
+
+		HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) override
+		{
+			if (riid == __uuidof(IDxcIncludeHandler) || riid == __uuidof(IUnknown)) {
+				*ppvObject = static_cast<IDxcIncludeHandler*>(this);
+				AddRef();
+				return S_OK;
+			}
+			*ppvObject = nullptr;
+			return E_NOINTERFACE;
+		}
+		ULONG STDMETHODCALLTYPE AddRef() override { return ++refCount_; }
+		ULONG STDMETHODCALLTYPE Release() override
+		{
+			const ULONG count = --refCount_;
+			if (count == 0) {
+				delete this;
+			}
+			return count;
+		}
+
+	private:
+		ComPtr<IDxcUtils> dxcUtils_;
+		std::atomic<ULONG> refCount_ = 1;
+	};
+}
+
 
 
 DirectXCommon* DirectXCommon::GetInstance()
@@ -279,8 +332,8 @@ void DirectXCommon::CreateDXCompiler()
 	assert(SUCCEEDED(hr));
 	hr = DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&dxcCompiler_));
 	assert(SUCCEEDED(hr));
-	hr = dxcUtils_->CreateDefaultIncludeHandler(&includeHandler_);
-	assert(SUCCEEDED(hr));
+	// includeもアーカイブから読めるようにする
+	includeHandler_ = new FileSystemIncludeHandler(dxcUtils_.Get());
 }
 
 
@@ -339,13 +392,16 @@ void DirectXCommon::PostDraw()
 	commandQueue_->ExecuteCommandLists(1, commandLists);
 
 	// GPUと05に画面の交換を行うよう通知する
-	swapChain_->Present(1, 0);
+	swapChain_->Present(isVSyncEnabled_ ? 1 : 0, 0);
 
 	// GPUの処理完了を待機（WaitForGpu関数に切り出した部分を呼び出す）
 	WaitForGpu();
 
 	//FPS固定
-	UpdateFixFPS();
+	// VSync中は Present がリフレッシュレートで待つので、それより低い上限を指定した時だけ待つ
+	if (isFixFPSEnabled_ && (!isVSyncEnabled_ || framePacer_.GetTargetFps() < displayRefreshRate_ - 0.5)) {
+		UpdateFixFPS();
+	}
 
 	// 次のフレーム用のコマンドリストを準備
 	hr = commandAllocator_->Reset();
@@ -499,34 +555,31 @@ D3D12_GPU_DESCRIPTOR_HANDLE DirectXCommon::GetDSVGPUDescriptorHandle(uint32_t in
 
 void DirectXCommon::InitializeFixFPS()
 {
-	// 現在時間を記録
-	reference_ = chrono::steady_clock::now();
-	// 1/60ぴったりの時間
-
+	// 既定はディスプレイのリフレッシュレート (Framework から上限を指定できる)
+	displayRefreshRate_ = QueryDisplayRefreshRate();
+	framePacer_.Initialize(displayRefreshRate_);
 }
 
 void DirectXCommon::UpdateFixFPS()
 {
-	static const std::chrono::microseconds kMinTime(uint64_t(1000000.0f / 60.0f));
-	// 1/60よりわずかに短い時間
-	static const std::chrono::microseconds kMinCheckTime(uint64_t(1000000.0f / 62.0f));
-	// 現在時間を取得
-	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
-	// 前回記録からの経過時間を取得
-	std::chrono::microseconds elapsed =
-		std::chrono::duration_cast<std::chrono::microseconds>(now - reference_);
-
-	// 1/60立ってない場合
-	if (elapsed < kMinCheckTime) {
-		// 1/60過ぎるまで微笑なスリープを繰り返す
-		while (std::chrono::steady_clock::now() - reference_ < kMinTime)
-		{
-			// 1マイクロ秒スリープ
-			std::this_thread::sleep_for(std::chrono::microseconds(1));
-		}
+	// 締め切り手前までスリープして残りをスピンで待つ
+	framePacer_.Wait();
+}
+
+double DirectXCommon::QueryDisplayRefreshRate() const
+{
+	MONITORINFOEXW monitorInfo{};
+	monitorInfo.cbSize = sizeof(monitorInfo);
+	DEVMODEW mode{};
+	mode.dmSize = sizeof(mode);
+	HMONITOR monitor = MonitorFromWindow(winApp_->GetHwnd(), MONITOR_DEFAULTTONEAREST);
+	// 0 と 1 は「ハードウェアの既定」なので使わない
+	if (GetMonitorInfoW(monitor, &monitorInfo) &&
+		EnumDisplaySettingsW(monitorInfo.szDevice, ENUM_CURRENT_SETTINGS, &mode) &&
+		mode.dmDisplayFrequency > 1) {
+		return static_cast<double>(mode.dmDisplayFrequency);
 	}
-	// 現在の時間を記録
-	reference_ = std::chrono::steady_clock::now();
+	return 60.0;
 }
 
 Microsoft::WRL::ComPtr<IDxcBlob> DirectXCommon::CompileShader(const wstring& filePath, const wchar_t* profile)
@@ -534,15 +587,14 @@ Microsoft::WRL::ComPtr<IDxcBlob> DirectXCommon::CompileShader(const wstring& fil
 	// 1.hlslファイルを読み込む
 	// これからシェーダーをコンパイルする旨をログに出す
 	Log(ConvertString(std::format(L"Begin CompileShader,path:{},profile:{}\n", filePath, profile)));
-	// hlslファイルを読み込む
-	IDxcBlobEncoding* shaderSource = nullptr;
-	HRESULT hr = dxcUtils_->LoadFile(filePath.c_str(), nullptr, &shaderSource);
+	// hlslファイルを FileSystem から読み込む (コンパイルが終わるまでマップを直接渡す)
+	FileSystem::FileView shaderSource = FileSystem::GetInstance()->Open(ConvertString(filePath));
 	// 読めなかったら止める
-	assert(SUCCEEDED(hr));
+	assert(shaderSource.IsValid());
 	// 読み込んだファイルの内容を設定する
 	DxcBuffer shaderSourceBuffer;
-	shaderSourceBuffer.Ptr = shaderSource->GetBufferPointer();
-	shaderSourceBuffer.Size = shaderSource->GetBufferSize();
+	shaderSourceBuffer.Ptr = shaderSource.GetData();
+	shaderSourceBuffer.Size = shaderSource.GetSize();
 	shaderSourceBuffer.Encoding = DXC_CP_UTF8; // UTF8の文字コードであることを通知
 	// 2. Compileする
 	LPCWSTR arguments[] = {
@@ -555,7 +607,7 @@ Microsoft::WRL::ComPtr<IDxcBlob> DirectXCommon::CompileShader(const wstring& fil
 	};
 	// 実際にShaderをコンパイルする
 	IDxcResult* shaderResult = nullptr;
-	hr = dxcCompiler_->Compile(
+	HRESULT hr = dxcCompiler_->Compile(
 		&shaderSourceBuffer,		  // 読み込んだファイル
 		arguments,					  // コンパイルオプション
 		_countof(arguments),		  // コンパイルオプションの数
@@ -579,7 +631,6 @@ Microsoft::WRL::ComPtr<IDxcBlob> DirectXCommon::CompileShader(const wstring& fil
 	// 成功したログを出す
 	Log(ConvertString(std::format(L"Compile Succeeded,path:{},profile:{}\n", filePath, profile)));
 	// もう使わないリソースを解放
-	shaderSource->Release();
 	shaderResult->Release();
 	// 実行用のバイナリを返却
 	return shaderBlob;
@@ -11,6 +11,7 @@
 // Engine
 #include "WinApp./WinApp.h"
 #include "SrvManager/SrvManager.h"
+#include "Systems/GameTime/FramePacer.h"
 
 // DirectX
 #include "DirectXTex.h"
@@ -175,6 +176,25 @@ public: // メンバ関数
 	D3D12_GPU_DESCRIPTOR_HANDLE GetDepthGPUHandle() { return depthSrvHandleGPU_; }
 	D3D12_CPU_DESCRIPTOR_HANDLE GetDepthCPUHandle() { return depthSrvHandleCPU_; }
 
+	/// <summary>
+	/// フレーム制限の有効化 (目標のレートは GetFramePacer().SetTargetFps で変える)
+	/// VSyncを切っている時はこれだけが描画のレートを決める。入力の再生で全速で回す時だけ切る
+	/// </summary>
+	void SetFixFPSEnabled(bool enabled) { isFixFPSEnabled_ = enabled; }
+	bool IsFixFPSEnabled() const { return isFixFPSEnabled_; }
+	FramePacer& GetFramePacer() { return framePacer_; }
+
+	/// <summary>
+	/// ウィンドウのあるディスプレイのリフレッシュレート (取れなければ60)
+	/// </summary>
+	double GetDisplayRefreshRate() const { return displayRefreshRate_; }
+
+	/// <summary>
+	/// VSyncを待つか (入力の再生で全速で回す時は切る)
+	/// </summary>
+	void SetVSyncEnabled(bool enabled) { isVSyncEnabled_ = enabled; }
+	bool IsVSyncEnabled() const { return isVSyncEnabled_; }
+
 private:
 	/// <summary>
 	/// FPS固定初期化
@@ -186,8 +206,16 @@ private:
 	/// </summary>
 	void UpdateFixFPS();
 
-	// 記録時間（FPS固定用）
-	std::chrono::steady_clock::time_point reference_;
+	/// <summary>
+	/// ウィンドウのあるディスプレイの現在のリフレッシュレートを調べる
+	/// </summary>
+	double QueryDisplayRefreshRate() const;
+
+	// FPS固定用のフレーム制限
+	FramePacer framePacer_;
+	bool isFixFPSEnabled_ = true;
+	double displayRefreshRate_ = 60.0;
+	bool isVSyncEnabled_ = true;
 
 public:
 	/// <summary>
@@ -1,7 +1,13 @@
 #include "Framework.h"
 
+// C++
+#include <chrono>
+
 void Framework::Initialize()
 {
+	// 素材のアーカイブをマウント (各ローダーより先)
+	FileSystem::GetInstance()->Initialize();
+
 	// ウィンドウ生成
 	winApp_ = WinApp::GetInstance();
 	winApp_->Initialize();
@@ -26,12 +32,21 @@ void Framework::Initialize()
 	srvManager_ = SrvManager::GetInstance();
 	srvManager_->Initialize();
 
+	// 定数データ用アップロードリングの生成
+	FrameUploadRing::GetInstance()->Initialize(dxCommon_);
+
+	// 3Dオブジェクトの描画キューの生成
+	RenderQueueManager::GetInstance()->Initialize(dxCommon_);
+
 	// オフスクリーンのSRV生成
 	dxCommon_->CreateSRVForOffScreen();
 	dxCommon_->CreateSRVDepth();
 	// テクスチャマネージャの生成
 	textureManager_ = TextureManager::GetInstance();
 	textureManager_->Initialize(dxCommon_, srvManager_);
+
+	// UI・スプライト用の小さい画像をアトラスにまとめる
+	TextureAtlas::GetInstance()->Initialize({ "Resources/Textures", "Resources/images" });
 	
 	// PSOマネージャの生成
 	pipelineManager_ = PipelineManager::GetInstance();
@@ -64,28 +79,49 @@ void Framework::Initialize()
 	skinningManager_ = SkinningManager::GetInstance();
 	skinningManager_->Initialize(dxCommon_);
 
+	// フレーム時間の生成
+	// 更新は固定ステップで回し、描画は補間する
+	frameTimer_ = FrameTimer::GetInstance();
+	frameTimer_->Initialize(1.0f / 60.0f);
+	frameTimer_->SetMode(FrameTimer::Mode::kFixedInterpolated);
+	// 描画のレートはFramePacerで制限する (更新のステップ幅とは別に変えられる)
+	// 既定はリフレッシュレートなので、120/144Hz のディスプレイでは補間した描画がそのレートで出る
+	dxCommon_->GetFramePacer().SetTargetFps(kFrameRateCap > 0.0 ? kFrameRateCap : dxCommon_->GetDisplayRefreshRate());
+
+	// 入力の記録・再生と乱数のシード (シーンの初期化より先)
+	InitializeReplay();
+
 }
 
 void Framework::Finalize()
 {
+	// 記録中ならステップ数を書き込んで閉じる
+	InputRecorder::GetInstance()->Stop();
+	timingLog_.Close();
+
 	// 各解放処理
 	imguiManager_->Finalize();
 	SceneManager::GetInstance()->Finalize();
+	// SRVを持つものは SrvManager より先に解放する
+	ParticleManager::GetInstance()->Finalize();
+	TextureAtlas::GetInstance()->Finalize();
+	modelManager_->Finalize();
 	textureManager_->Finalize();
+	RenderQueueManager::GetInstance()->Finalize();
+	FrameUploadRing::GetInstance()->Finalize();
 	srvManager_->Finalize();
 	audio_->Finalize();
 	input_->Finalize();
 	winApp_->Finalize();
 	winApp_ = nullptr;
+	// 読み込んだ素材を参照するものが無くなってからアーカイブを閉じる
+	FileSystem::GetInstance()->Finalize();
 
 
 }
 
 void Framework::Update()
 {
-	
-	// ImGui受付開始
-	imguiManager_->Begin();
 	// 入力は初めに更新
 	input_->Update();
 
@@ -96,11 +132,15 @@ void Framework::Update()
 
 	// シーン全体の更新
 	SceneManager::GetInstance()->Update();
+}
 
-
-
-	// ImGui受付終了
-	imguiManager_->End();
+void Framework::UpdateImGui()
+{
+#ifdef _DEBUG
+	// フレーム制限の計測結果
+	dxCommon_->GetFramePacer().ShowImGui();
+#endif
+	SceneManager::GetInstance()->UpdateImGui();
 }
 
 void Framework::Run()
@@ -108,17 +148,69 @@ void Framework::Run()
 	// ゲームの生成
 	Initialize();
 
+	using Clock = std::chrono::steady_clock;
+	InputRecorder* recorder = InputRecorder::GetInstance();
+
 	while (true) // ゲームループ
 	{
-		// 毎フレーム更新
-		Update();
-		// 終了リクエストが着たら抜ける
-		if (IsEndRequst()) {
+		const Clock::time_point frameStart = Clock::now();
+
+		// 経過時間を積算して、溜まった分だけ固定ステップで更新
+		frameTimer_->BeginFrame();
+		// ImGuiと音声は描画フレームごとに1回 (更新のステップ数は0回のことも複数回のこともある)
+		imguiManager_->Begin();
+		// 再生し終えたボイスをプールへ戻す
+		audio_->Update();
+		while (frameTimer_->StepSimulation()) {
+			Update();
+		}
+		UpdateImGui();
+		imguiManager_->End();
+		const Clock::time_point updateEnd = Clock::now();
+
+		// 終了リクエストが着たら抜ける (再生は最後のステップまで進めたら終わる)
+		if (IsEndRequst() || recorder->IsReplayFinished()) {
 			break;
 		}
 		// 描画
 		Draw();
+
+		if (timingLog_.IsOpen()) {
+			const Clock::time_point frameEnd = Clock::now();
+			FrameTimingLog::Sample sample;
+			sample.steps = frameTimer_->GetStepsThisFrame();
+			sample.updateMs = std::chrono::duration<float, std::milli>(updateEnd - frameStart).count();
+			sample.drawMs = std::chrono::duration<float, std::milli>(frameEnd - updateEnd).count();
+			sample.frameMs = std::chrono::duration<float, std::milli>(frameEnd - frameStart).count();
+			timingLog_.Record(sample);
+		}
 	}
 	// ゲームの終了
 	Finalize();
 }
+
+void Framework::InitializeReplay()
+{
+	InputRecorder* recorder = InputRecorder::GetInstance();
+	uint32_t seed = replayOptions_.hasSeed ? replayOptions_.seed : RandomSeed::MakeNondeterministicSeed();
+
+	if (replayOptions_.mode == InputRecorder::Mode::kRecording) {
+		recorder->StartRecording(replayOptions_.logPath, seed, frameTimer_->GetDeltaTime());
+	} else if (replayOptions_.mode == InputRecorder::Mode::kReplaying && recorder->StartReplay(replayOptions_.logPath)) {
+		// 記録と同じシード・同じステップ幅で、1フレーム1ステップずつ待たずに回す
+		// (ステップの並びが記録と同じなら、1フレームに何ステップ進めたかは結果に影響しない)
+		seed = recorder->GetSeed();
+		frameTimer_->Initialize(recorder->GetFixedDeltaTime());
+		frameTimer_->SetMode(FrameTimer::Mode::kLockStep);
+		// 処理時間を測るため、この起動の間はフレーム制限もVSyncもかけない
+		dxCommon_->SetFixFPSEnabled(false);
+		dxCommon_->SetVSyncEnabled(false);
+		// 機器は読まないので入力スレッドも止める
+		input_->SetSamplingThreadEnabled(false);
+	}
+	RandomSeed::GetInstance()->Initialize(seed);
+
+	if (!replayOptions_.timingPath.empty()) {
+		timingLog_.Open(replayOptions_.timingPath);
+	}
+}
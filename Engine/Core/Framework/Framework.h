@@ -6,8 +6,12 @@
 #include "WinApp./WinApp.h"
 #include "Debugger./ImGuiManager.h"
 #include "SrvManager./SrvManager.h"
+#include "FrameAllocator/FrameUploadRing.h"
+#include "RenderQueue/RenderQueueManager.h"
 #include "DX./DirectXCommon.h"
 #include "Loaders./Texture/TextureManager.h"
+#include "Loaders./Texture/TextureAtlas.h"
+#include "Loaders./Archive/FileSystem.h"
 #include "Sprite./SpriteCommon.h"
 #include "CoreScenes./Manager/SceneManager.h"
 #include "Object3D/Object3dCommon.h"
@@ -15,12 +19,17 @@
 #include "LightManager./LightManager.h"
 #include "Drawer./LineManager/LineManager.h"
 #include "Loaders./Model./ModelManager.h"
+#include "Particle/ParticleManager.h"
 #include "Systems./Input/Input.h"
 #include "Systems./Audio/Audio.h"
 #include "Corescenes./Factory/AbstractSceneFactory.h"
 #include "Debugger./LeakChecker.h"
 #include "PipelineManager/SkinningManager.h"
 #include "PipelineManager/PipelineManager.h"
+#include "Systems/GameTime/FrameTimer.h"
+#include "Systems/GameTime/FrameTimingLog.h"
+#include "Systems/Input/InputRecorder.h"
+#include "Systems/Random/RandomSeed.h"
 
 // ゲーム全体
 class Framework
@@ -60,7 +69,16 @@ public: // メンバ関数
 	/// 実行
 	/// </summary>
 	void Run();
+
+	/// <summary>
+	/// 入力の記録・再生の設定 (Run より前に、起動引数から)
+	/// </summary>
+	void SetReplayOptions(const InputRecorder::Options& options) { replayOptions_ = options; }
 protected:
+	// 描画のフレームレートの上限 (FramePacer の目標。ImGui からも変えられる)
+	// 0 ならディスプレイのリフレッシュレートまで。60 等に固定したい時だけ指定する
+	static constexpr double kFrameRateCap = 0.0;
+
 	// 基本的なゲームのコンポーネント
 	DirectXCommon* dxCommon_;
 	std::unique_ptr<AbstractSceneFactory> sceneFactory_;
@@ -80,10 +98,28 @@ protected:
 	LineManager* lineManager_ = nullptr;
 	SkinningManager* skinningManager_ = nullptr;
 	PipelineManager* pipelineManager_ = nullptr;
+	FrameTimer* frameTimer_ = nullptr;
+private:
+
+	/// <summary>
+	/// ImGui (固定ステップの更新とは別に、描画フレームごとに1回)
+	/// </summary>
+	void UpdateImGui();
+
+	/// <summary>
+	/// 入力の記録・再生を始め、乱数のシードを決める
+	/// </summary>
+	void InitializeReplay();
+
 private:
 	
 	// ゲーム終了フラグ
 	bool endRequst_ = false;
 
+	// 入力の記録・再生
+	InputRecorder::Options replayOptions_;
+	// フレームごとの処理時間 (--timing か再生時)
+	FrameTimingLog timingLog_;
+
 };
 
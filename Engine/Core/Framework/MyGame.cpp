@@ -44,9 +44,16 @@ void MyGame::Draw()
 	dxCommon_->PreDrawScene();
 	// Srvの描画準備
 	srvManager_->PreDraw();
+	// 定数データのアップロードリングを次のフレーム枠へ
+	FrameUploadRing::GetInstance()->BeginFrame();
+	RenderQueueManager::GetInstance()->BeginFrame();
+	// スプライトの頂点リングを先頭に戻す
+	spriteCommon_->PreDraw();
 
 	// ゲームの描画
 	SceneManager::GetInstance()->Draw();
+	// シーン側で描画し忘れた分
+	RenderQueueManager::GetInstance()->Flush();
 
 	dxCommon_->PreDrawImGui();
 	offScreen_->SetProjection(SceneManager::GetInstance()->GetScene()->GetViewProjection());
@@ -54,6 +61,7 @@ void MyGame::Draw()
 
 	dxCommon_->DepthBarrier();
 	SceneManager::GetInstance()->DrawForOffscreen();
+	RenderQueueManager::GetInstance()->Flush();
 
 
 	imguiManager_->Draw();
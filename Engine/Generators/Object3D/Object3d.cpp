@@ -11,25 +11,23 @@
 #include "Loaders./Model/ModelManager.h"
 #include "Loaders./Model/Model.h"
 #include "WorldTransform./WorldTransform.h"
+#include "RenderQueue/RenderQueueManager.h"
+#include "Culling/FrustumCuller.h"
+#include "WinApp./WinApp.h"
 
 
 #ifdef _DEBUG
 #include "imgui.h"
 #endif // _DEBUG
 
-Object3d::Object3d()
-{
-	queryIndex_ = OcclusionCullingManager::GetInstance()->AddOcclusionQuery();
-}
-
 void Object3d::Initialize()
 {
 	// 引数で受け取ってメンバ変数に記録する
 	this->object3dCommon_ = Object3dCommon::GetInstance();
 
-	CreateMaterialResource();
+	InitializeMaterial();
 
-	CreateCameraResource();
+	InitializeCamera();
 }
 void Object3d::UpdateAnimation()
 {
@@ -41,57 +39,78 @@ void Object3d::UpdateAnimation()
 void Object3d::Draw(Camera* camera,WorldTransform& worldTransform)
 {
 
-	
-	// クエリは毎回実行する
-	OcclusionCullingManager::GetInstance()->BeginOcclusionQuery(queryIndex_);
-
-	// 数フレーム連続で見えてなかったら描画しない
-	bool shouldDraw = OcclusionCullingManager::GetInstance()->ShouldDraw(queryIndex_, 10);
-	static uint32_t globalFrameCounter = 0;
-	globalFrameCounter++;
-	if (!shouldDraw && globalFrameCounter % 1 == 0) {
-		shouldDraw = true;
-	}
-
-
-	if (shouldDraw) {
+	if (model_) {
 		Matrix4x4 worldViewProjectionMatrix;
 		Matrix4x4 worldMatrix;
-		if (model_) {
-			if (camera) {
-				const Matrix4x4& viewProjectionMatrix = camera->GetViewProjectionMatrix();
-
-				// 
-				if (!model_->GetModelData().hasBones) {
-					worldViewProjectionMatrix = worldTransform.GetMatWorld() * model_->GetModelData().rootNode.localMatrix * viewProjectionMatrix;
-					worldMatrix = worldTransform.GetMatWorld() * model_->GetModelData().rootNode.localMatrix;
-				} else {
-					worldViewProjectionMatrix = worldTransform.GetMatWorld() * viewProjectionMatrix;
-					worldMatrix = worldTransform.GetMatWorld();
-				}
+		// 固定ステップの間を補間した行列
+		const Matrix4x4 matWorld = worldTransform.GetInterpolatedMatWorld();
+		if (camera) {
+			const Matrix4x4& viewProjectionMatrix = camera->GetViewProjectionMatrix();
+
+			// 
+			if (!model_->GetModelData().hasBones) {
+				worldViewProjectionMatrix = matWorld * model_->GetModelData().rootNode.localMatrix * viewProjectionMatrix;
+				worldMatrix = matWorld * model_->GetModelData().rootNode.localMatrix;
 			} else {
-
-				worldViewProjectionMatrix = worldTransform.GetMatWorld();
-				worldMatrix = worldTransform.GetMatWorld(); // 初期化が必要
+				worldViewProjectionMatrix = matWorld * viewProjectionMatrix;
+				worldMatrix = matWorld;
 			}
+		} else {
+
+			worldViewProjectionMatrix = matWorld;
+			worldMatrix = matWorld; // 初期化が必要
 		}
 
 		worldTransform.SetMapWVP(worldViewProjectionMatrix);
 		worldTransform.SetMapWorld(worldMatrix);
 
-		// マテリアル
-		object3dCommon_->GetDxCommon()->GetCommandList()->SetGraphicsRootConstantBufferView(0, materialResource_->GetGPUVirtualAddress());
-		// TransformatonMatrixCB
-		object3dCommon_->GetDxCommon()->GetCommandList()->SetGraphicsRootConstantBufferView(1, worldTransform.GetConstBuffer()->GetGPUVirtualAddress());
-		// カメラ
-		object3dCommon_->GetDxCommon()->GetCommandList()->SetGraphicsRootConstantBufferView(4, cameraResource_->GetGPUVirtualAddress());
+		// 描画キューに積む (状態ごとに並べ替えてからまとめて描画される)
+		RenderQueueManager* renderQueue = RenderQueueManager::GetInstance();
+
+		// 画面上の大きさでLODを選ぶ
+		UpdateLod(camera, worldMatrix);
 
+		RenderQueueManager::DrawItem item;
+		item.model = model_;
+		item.lod = lodLevel_;
+		// カメラ
+		uint32_t cameraId = renderQueue->UploadConstants(cameraData_);
+		item.camera = renderQueue->GetConstantAddress(cameraId);
+
+		// マテリアル (同じ内容のものは同じIDになる)
+		uint32_t material = renderQueue->UploadConstants(materialData_);
+
+		uint32_t pipeline = 0;
+		uint32_t batch = DrawPacket::kNoBatch;
+		if (model_->HasSkeleton()) {
+			// スケルトンを持つモデルはボーン行列が個別なのでまとめずに描く
+			pipeline = object3dCommon_->GetSkinningPipelineId();
+			// TransformatonMatrixCB
+			item.transform = worldTransform.UploadConstBuffer();
+		} else {
+			// 同じモデル・マテリアルの描画は1回のインスタンシング描画にまとめる
+			pipeline = model_->IsVertexPacked() ? object3dCommon_->GetPackedInstancingPipelineId() : object3dCommon_->GetInstancingPipelineId();
+			item.world = worldMatrix;
+			uint32_t viewProjection = renderQueue->UploadConstants(camera ? camera->GetViewProjectionMatrix() : MakeIdentity4x4());
+			item.viewProjection = renderQueue->GetConstantAddress(viewProjection);
+			batch = renderQueue->GetBatchId(model_, lodLevel_, viewProjection, cameraId);
+
+			// 視錐台の外ならFlushで間引かれる (スキニングは姿勢で範囲が変わるのでカリングしない)
+			if (camera) {
+				item.bounds = FrustumCuller::TransformBounds(model_->GetLocalBounds(), worldMatrix);
+				item.frustum = renderQueue->GetFrustumId(camera->GetViewProjectionMatrix());
+			}
+		}
 
-		if (model_) {
-			model_->Draw();
+		// 手前から描くためのビュー空間の深度
+		uint32_t depth = 0;
+		if (camera) {
+			Vector3 viewPosition = Transform({ worldMatrix.m[3][0], worldMatrix.m[3][1], worldMatrix.m[3][2] }, camera->GetViewMatrix());
+			depth = RenderKey::QuantizeDepth(viewPosition.z, camera->GetNearClip(), camera->GetFarClip());
 		}
+
+		renderQueue->Submit(RenderPass::Opaque, pipeline, material, model_->GetModelData().material.textureHandle, batch, depth, item);
 	}
-		OcclusionCullingManager::GetInstance()->EndOcclusionQuery(queryIndex_);
 }
 
 void Object3d::DrawSkeleton(Line& line)
@@ -99,21 +118,44 @@ void Object3d::DrawSkeleton(Line& line)
 	model_->DrawSkeleton(model_->GetSkeleton(),line);
 }
 
-void Object3d::CreateMaterialResource()
+void Object3d::InitializeMaterial()
+{
+	materialData_ = {};
+	materialData_.color = { 1.0f, 1.0f, 1.0f, 1.0f };
+	materialData_.enableLighting = true;
+	materialData_.shininess = 30.0f;
+	materialData_.uvTransform = MakeIdentity4x4();
+}
+
+void Object3d::InitializeCamera()
 {
-	materialResource_ = object3dCommon_->GetDxCommon()->CreateBufferResource(sizeof(Material));
-	materialResource_->Map(0, nullptr, reinterpret_cast<void**>(&materialData_));
-	materialData_->color = { 1.0f, 1.0f, 1.0f, 1.0f };
-	materialData_->enableLighting = true;
-	materialData_->shininess = 30.0f;
-	materialData_->uvTransform = MakeIdentity4x4();
+	cameraData_.worldPosition = { 0.0f, 0.0f, 0.0f };
 }
 
-void Object3d::CreateCameraResource()
+void Object3d::UpdateLod(const Camera* camera, const Matrix4x4& worldMatrix)
 {
-	cameraResource_ = object3dCommon_->GetDxCommon()->CreateBufferResource(sizeof(CameraForGPU));
-	cameraResource_->Map(0, nullptr, reinterpret_cast<void**>(&cameraData_));
-	cameraData_->worldPosition = { 0.0f, 0.0f, 0.0f };
+	if (!camera) {
+		lodLevel_ = 0;
+		return;
+	}
+
+	// カメラからの奥行き (近すぎる・後ろにあるものは元のメッシュ)
+	Vector3 viewPosition = Transform({ worldMatrix.m[3][0], worldMatrix.m[3][1], worldMatrix.m[3][2] }, camera->GetViewMatrix());
+	if (viewPosition.z <= camera->GetNearClip()) {
+		lodLevel_ = 0;
+		return;
+	}
+
+	// ワールド行列の一番大きい拡大率 (モデル空間の長さ → ワールド空間の長さ)
+	float scale = 0.0f;
+	for (int i = 0; i < 3; ++i) {
+		const float* axis = worldMatrix.m[i];
+		scale = (std::max)(scale, std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]));
+	}
+
+	// モデル空間の長さ1が画面上で何ピクセルになるか (射影行列の[1][1]は 1/tan(fovY/2))
+	const float pixelsPerUnit = scale * camera->GetProjectionMatrix().m[1][1] * (static_cast<float>(WinApp::kClientHeight) * 0.5f) / viewPosition.z;
+	lodLevel_ = MeshSimplifier::SelectLod(model_->GetLods(), pixelsPerUnit, lodLevel_);
 }
 
 
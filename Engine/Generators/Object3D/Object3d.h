@@ -9,7 +9,6 @@
 // Engine
 #include "Systems/Camera/Camera.h"
 #include "Loaders/Model/Model.h"
-#include "../Graphics/Culling/OcclusionCullingManager.h"
 
 // Math
 #include "Vector4.h"
@@ -27,8 +26,6 @@ class Object3d
 {
 public: // メンバ関数
 
-	Object3d();
-
 	/// <summary>
 	/// 初期化
 	/// </summary>
@@ -62,17 +59,24 @@ public: // メンバ関数
 private:
 
 	/// <summary>
-	/// マテリアルリソース作成
+	/// マテリアルの初期化
+	/// </summary>
+	void InitializeMaterial();
+
+	/// <summary>
+	/// カメラデータの初期化
 	/// </summary>
-	void CreateMaterialResource();
+	void InitializeCamera();
 
 	/// <summary>
-	/// マテリアルリソース作成
+	/// 画面上の大きさからLODを選び直す
 	/// </summary>
-	void CreateCameraResource();
+	void UpdateLod(const Camera* camera, const Matrix4x4& worldMatrix);
 
 public: // アクセッサ
 	Model* GetModel() { return model_; }
+	// 直近の描画で選んだLOD
+	uint32_t GetLodLevel() const { return lodLevel_; }
 
 	/*===============================================//
 					　アンカーポイント
@@ -97,22 +101,22 @@ public: // アクセッサ
 	//void SetLine(Line* line) { this->line_ = line; }
 
 	// マテリアル
-	const Vector4& GetMaterialColor() const { return materialData_->color; }
-	void SetMaterialColor(const Vector4& color) { materialData_->color = color; }
-	void SetAlpha(const float& alpha) { materialData_->color.w = alpha; }
-	bool IsLightingEnabled() const { return materialData_->enableLighting != 0; }
-	bool IsSpecularEnabled() const { return materialData_->enableSpecular; }
-	bool IsHalfVectorEnabled() const { return materialData_->isHalfVector; }
+	const Vector4& GetMaterialColor() const { return materialData_.color; }
+	void SetMaterialColor(const Vector4& color) { materialData_.color = color; }
+	void SetAlpha(const float& alpha) { materialData_.color.w = alpha; }
+	bool IsLightingEnabled() const { return materialData_.enableLighting != 0; }
+	bool IsSpecularEnabled() const { return materialData_.enableSpecular; }
+	bool IsHalfVectorEnabled() const { return materialData_.isHalfVector; }
 	
-	void SetLightingEnabled(bool enabled) { materialData_->enableLighting = enabled ? 1 : 0; }
-	float GetMaterialShininess() const { return materialData_->shininess; }
-	void SetMaterialShininess(float shininess) { materialData_->shininess = shininess; }
-	const Matrix4x4& GetMaterialUVTransform() const { return materialData_->uvTransform; }
-	void SetMaterialUVTransform(const Matrix4x4& uvTransform) { materialData_->uvTransform = uvTransform; }
-	bool IsMaterialEnabled() const { return materialData_->enableLighting != 0; }
-	void SetMaterialEnabled(bool enable) { materialData_->enableLighting = enable; }
-	void SetMaterialSpecularEnabled(bool enable) { materialData_->enableSpecular = enable; }
-	void SetMaterialHalfVectorEnabled(bool enable) { materialData_->isHalfVector = enable; }
+	void SetLightingEnabled(bool enabled) { materialData_.enableLighting = enabled ? 1 : 0; }
+	float GetMaterialShininess() const { return materialData_.shininess; }
+	void SetMaterialShininess(float shininess) { materialData_.shininess = shininess; }
+	const Matrix4x4& GetMaterialUVTransform() const { return materialData_.uvTransform; }
+	void SetMaterialUVTransform(const Matrix4x4& uvTransform) { materialData_.uvTransform = uvTransform; }
+	bool IsMaterialEnabled() const { return materialData_.enableLighting != 0; }
+	void SetMaterialEnabled(bool enable) { materialData_.enableLighting = enable; }
+	void SetMaterialSpecularEnabled(bool enable) { materialData_.enableSpecular = enable; }
+	void SetMaterialHalfVectorEnabled(bool enable) { materialData_.isHalfVector = enable; }
 private:
 	// マテリアルデータ
 	struct Material {
@@ -129,18 +133,19 @@ private:
 		Vector3 worldPosition;
 		//float padding[3];
 	};
-	// マテリアルのリソース
-	Microsoft::WRL::ComPtr<ID3D12Resource> materialResource_;
-	Material* materialData_ = nullptr;
+	// マテリアル (GPUへは描画時にアップロードリング経由で渡す)
+	Material materialData_{};
 
-	Microsoft::WRL::ComPtr<ID3D12Resource> cameraResource_;
-	CameraForGPU* cameraData_ = nullptr;
+	CameraForGPU cameraData_{};
 
 	// 外部からのポインタ
 	Object3dCommon* object3dCommon_ = nullptr;
 	Model* model_ = nullptr;
 	//Camera* camera_ = nullptr;
 
+	// 今のLOD (切り替えの閾値に余裕を持たせるために覚えておく)
+	uint32_t lodLevel_ = 0;
+
 	// テクスチャ左上座標
 	Vector2 textureLeftTop_ = { 0.0f,0.0f };
 	// テクスチャ切り出しサイズ
@@ -152,8 +157,5 @@ private:
 	bool isFlipX_ = false;
 	// 上下フリップ
 	bool isFlipY_ = false;
-
-	// クエリインデックス
-	UINT queryIndex_ = 0;
 };
 
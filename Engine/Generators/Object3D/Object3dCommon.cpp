@@ -1,5 +1,6 @@
 #include "Object3dCommon.h"
 #include "PipelineManager/PipelineManager.h"
+#include "RenderQueue/RenderQueueManager.h"
 // シングルトンインスタンスの初期化
 std::unique_ptr<Object3dCommon> Object3dCommon::instance = nullptr;
 std::once_flag Object3dCommon::initInstanceFlag;
@@ -22,6 +23,16 @@ void Object3dCommon::Initialize(DirectXCommon* dxCommon)
 
 	rootSignature_ = PipelineManager::GetInstance()->GetRootSignature("Object");
 	graphicsPipelineState_ = PipelineManager::GetInstance()->GetPipeLineStateObject("Object");
+
+	instancingRootSignature_ = PipelineManager::GetInstance()->GetRootSignature("ObjectInstance");
+	instancingPipelineState_ = PipelineManager::GetInstance()->GetPipeLineStateObject("ObjectInstance");
+	packedInstancingPipelineState_ = PipelineManager::GetInstance()->GetPipeLineStateObject("ObjectInstancePacked");
+
+	// 描画キューで使うパイプライン
+	// 通常のモデルはまとめて描けるようにインスタンシング用 (頂点を圧縮したモデルは圧縮頂点用)、スケルトンを持つモデルはスキニング用
+	instancingPipelineId_ = RenderQueueManager::GetInstance()->RegisterPipeline("ObjectInstance");
+	packedInstancingPipelineId_ = RenderQueueManager::GetInstance()->RegisterPipeline("ObjectInstancePacked");
+	skinningPipelineId_ = RenderQueueManager::GetInstance()->RegisterPipeline("Animation");
 }
 
 void Object3dCommon::DrawPreference()
@@ -36,6 +47,18 @@ void Object3dCommon::DrawPreference()
 	SetPrimitiveTopology();
 }
 
+void Object3dCommon::DrawPreferenceInstancing()
+{
+	dxCommon_->GetCommandList()->SetGraphicsRootSignature(instancingRootSignature_.Get());
+	dxCommon_->GetCommandList()->SetPipelineState(instancingPipelineState_.Get());
+	SetPrimitiveTopology();
+}
+
+void Object3dCommon::SetInstancingPipelineState(bool isVertexPacked)
+{
+	dxCommon_->GetCommandList()->SetPipelineState(isVertexPacked ? packedInstancingPipelineState_.Get() : instancingPipelineState_.Get());
+}
+
 void Object3dCommon::SetRootSignature()
 {
 	dxCommon_->GetCommandList()->SetGraphicsRootSignature(rootSignature_.Get());
@@ -29,12 +29,26 @@ public: // メンバ関数
     /// </summary>
     void DrawPreference();
 
+    /// <summary>
+    /// インスタンシング描画用の共通部描画設定
+    /// </summary>
+    void DrawPreferenceInstancing();
+
+    /// <summary>
+    /// インスタンシング描画のパイプラインを頂点の形式に合わせる (ルートシグネチャは共通)
+    /// </summary>
+    void SetInstancingPipelineState(bool isVertexPacked);
+
 public: // アクセッサ
     // getter
     Camera* GetDefaultCamera() const { return defaultCamera_; }
 
     // setter
     DirectXCommon* GetDxCommon() const { return dxCommon_; }
+    // 描画キューに登録したパイプラインのID
+    uint32_t GetInstancingPipelineId() const { return instancingPipelineId_; }
+    uint32_t GetPackedInstancingPipelineId() const { return packedInstancingPipelineId_; }
+    uint32_t GetSkinningPipelineId() const { return skinningPipelineId_; }
     void SetDefaultCamera(Camera* camera) { this->defaultCamera_ = camera; }
 
 private:
@@ -71,4 +85,12 @@ private:
     // ルートシグネチャとグラフィックパイプラインステートのポインタ
     Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_ = nullptr;
     Microsoft::WRL::ComPtr<ID3D12PipelineState> graphicsPipelineState_ = nullptr;
+    Microsoft::WRL::ComPtr<ID3D12RootSignature> instancingRootSignature_ = nullptr;
+    Microsoft::WRL::ComPtr<ID3D12PipelineState> instancingPipelineState_ = nullptr;
+    Microsoft::WRL::ComPtr<ID3D12PipelineState> packedInstancingPipelineState_ = nullptr;
+
+    // 描画キューでのパイプラインID
+    uint32_t instancingPipelineId_ = 0;
+    uint32_t packedInstancingPipelineId_ = 0;
+    uint32_t skinningPipelineId_ = 0;
 };
@@ -0,0 +1,108 @@
+#include "Object3dInstancing.h"
+#include "Object3dCommon.h"
+#include <assert.h>
+
+// Engine
+#include "Loaders/Model/ModelManager.h"
+#include "Loaders/Model/Model.h"
+
+// Math
+#include "MathFunc.h"
+
+void Object3dInstancing::Initialize(uint32_t maxInstance)
+{
+	object3dCommon_ = Object3dCommon::GetInstance();
+	maxInstance_ = maxInstance;
+
+	CreateMaterialResource();
+
+	CreateInstancingResource();
+}
+
+void Object3dInstancing::SetModel(const std::string& filePath)
+{
+	// 拡張子を取り除く処理 (Object3d::SetModel と同じ規則)
+	std::string basePath = filePath;
+	std::string fileName;
+	if (basePath.size() > 4) {
+		if (basePath.substr(basePath.size() - 4) == ".obj") {
+			basePath = basePath.substr(0, basePath.size() - 4);
+			fileName = basePath + ".obj";
+		}
+		else if (basePath.size() > 5 && basePath.substr(basePath.size() - 5) == ".gltf") {
+			basePath = basePath.substr(0, basePath.size() - 5);
+			fileName = basePath + ".gltf";
+		}
+	}
+
+	ModelManager::GetInstance()->LoadModel("Resources/Models/" + basePath, fileName);
+
+	model_ = ModelManager::GetInstance()->FindModel(fileName);
+}
+
+void Object3dInstancing::SetInstances(const std::vector<Matrix4x4>& worldMatrices)
+{
+	assert(worldMatrices.size() <= maxInstance_);
+	instanceCount_ = static_cast<uint32_t>(worldMatrices.size());
+
+	// モデルのルートノードの行列もここで焼き込んでおく
+	Matrix4x4 rootMatrix = MakeIdentity4x4();
+	if (model_ && !model_->GetModelData().hasBones) {
+		rootMatrix = model_->GetModelData().rootNode.localMatrix;
+	}
+
+	for (uint32_t i = 0; i < instanceCount_; ++i) {
+		Matrix4x4 world = rootMatrix * worldMatrices[i];
+		instancingData_[i].World = world;
+		instancingData_[i].WorldInverseTranspose = TransPose(Inverse(world));
+	}
+}
+
+void Object3dInstancing::Draw(Camera* camera)
+{
+	if (!model_ || instanceCount_ == 0) {
+		return;
+	}
+
+	if (camera) {
+		viewProjectionData_->VP = camera->GetViewProjectionMatrix();
+	}
+	else {
+		viewProjectionData_->VP = MakeIdentity4x4();
+	}
+
+	// 頂点の形式に合わせたパイプライン
+	object3dCommon_->SetInstancingPipelineState(model_->IsVertexPacked());
+
+	ID3D12GraphicsCommandList* commandList = object3dCommon_->GetDxCommon()->GetCommandList();
+	// マテリアル
+	commandList->SetGraphicsRootConstantBufferView(0, materialResource_->GetGPUVirtualAddress());
+	// インスタンスごとの行列 (ルートSRV)
+	commandList->SetGraphicsRootShaderResourceView(1, instancingResource_->GetGPUVirtualAddress());
+	// ビュープロジェクション
+	commandList->SetGraphicsRootConstantBufferView(7, viewProjectionResource_->GetGPUVirtualAddress());
+
+	model_->Draw(instanceCount_);
+}
+
+void Object3dInstancing::CreateMaterialResource()
+{
+	materialResource_ = object3dCommon_->GetDxCommon()->CreateBufferResource(sizeof(Material));
+	materialResource_->Map(0, nullptr, reinterpret_cast<void**>(&materialData_));
+	materialData_->color = { 1.0f, 1.0f, 1.0f, 1.0f };
+	materialData_->enableLighting = true;
+	materialData_->shininess = 30.0f;
+	materialData_->uvTransform = MakeIdentity4x4();
+
+	viewProjectionResource_ = object3dCommon_->GetDxCommon()->CreateBufferResource(sizeof(ViewProjectionForGPU));
+	viewProjectionResource_->Map(0, nullptr, reinterpret_cast<void**>(&viewProjectionData_));
+	viewProjectionData_->VP = MakeIdentity4x4();
+}
+
+void Object3dInstancing::CreateInstancingResource()
+{
+	// Instancing用のリソースを生成
+	instancingResource_ = object3dCommon_->GetDxCommon()->CreateBufferResource(sizeof(InstanceForGPU) * maxInstance_);
+	instancingResource_->Map(0, nullptr, reinterpret_cast<void**>(&instancingData_));
+	instanceCount_ = 0;
+}
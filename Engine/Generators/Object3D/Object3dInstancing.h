@@ -0,0 +1,107 @@
+#pragma once
+
+// C++
+#include <wrl.h>
+#include <d3d12.h>
+#include <string>
+#include <vector>
+
+// Engine
+#include "Systems/Camera/Camera.h"
+
+// Math
+#include "Vector4.h"
+#include "Matrix4x4.h"
+
+class Model;
+class Object3dCommon;
+// 同じモデルを1回のドローコールでまとめて描画する
+class Object3dInstancing
+{
+public: // 構造体
+
+	// インスタンス1つ分の座標変換データ
+	struct InstanceForGPU {
+		Matrix4x4 World;
+		Matrix4x4 WorldInverseTranspose;
+	};
+
+public: // メンバ関数
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="maxInstance">確保するインスタンスの最大数</param>
+	void Initialize(uint32_t maxInstance);
+
+	/// <summary>
+	/// モデルのセット
+	/// </summary>
+	void SetModel(const std::string& filePath);
+
+	/// <summary>
+	/// インスタンスのワールド行列を転送する
+	/// 毎フレーム呼ぶ必要はなく、配置が変わった時だけ呼べばよい
+	/// </summary>
+	void SetInstances(const std::vector<Matrix4x4>& worldMatrices);
+
+	/// <summary>
+	/// 描画
+	/// Object3dCommon::DrawPreferenceInstancing を呼んだ後に使う
+	/// </summary>
+	void Draw(Camera* camera);
+
+public: // アクセッサ
+	Model* GetModel() { return model_; }
+	uint32_t GetInstanceCount() const { return instanceCount_; }
+	uint32_t GetMaxInstance() const { return maxInstance_; }
+
+	const Vector4& GetMaterialColor() const { return materialData_->color; }
+	void SetMaterialColor(const Vector4& color) { materialData_->color = color; }
+
+private:
+
+	/// <summary>
+	/// マテリアルリソース作成
+	/// </summary>
+	void CreateMaterialResource();
+
+	/// <summary>
+	/// インスタンシングリソース作成
+	/// </summary>
+	void CreateInstancingResource();
+
+private:
+	// マテリアルデータ (Object3d と同じレイアウト)
+	struct Material {
+		Vector4 color;
+		int32_t enableLighting;
+		float padding[3];
+		Matrix4x4 uvTransform;
+		float shininess;
+		bool enableSpecular;
+		bool isHalfVector;
+	};
+
+	struct ViewProjectionForGPU {
+		Matrix4x4 VP;
+	};
+
+	// 外部からのポインタ
+	Object3dCommon* object3dCommon_ = nullptr;
+	Model* model_ = nullptr;
+
+	// マテリアル
+	Microsoft::WRL::ComPtr<ID3D12Resource> materialResource_;
+	Material* materialData_ = nullptr;
+
+	// ビュープロジェクション
+	Microsoft::WRL::ComPtr<ID3D12Resource> viewProjectionResource_;
+	ViewProjectionForGPU* viewProjectionData_ = nullptr;
+
+	// インスタンシング
+	Microsoft::WRL::ComPtr<ID3D12Resource> instancingResource_;
+	InstanceForGPU* instancingData_ = nullptr;
+	uint32_t instanceCount_ = 0;
+	uint32_t maxInstance_ = 0;
+};
@@ -1,4 +1,5 @@
 #include "ParticleEmitter.h"
+#include "Systems/GameTime/FrameTimer.h"
 #ifdef _DEBUG
 #include "imgui.h"
 #endif
@@ -12,6 +13,7 @@ void ParticleEmitter::Initialize() {
 
 void ParticleEmitter::Update()
 {
+	deltaTime_ = FrameTimer::GetInstance()->GetDeltaTime();
 	emitter_.frequencyTime += deltaTime_;
 	if (emitter_.frequency <= emitter_.frequencyTime) {
 		// パーティクルを生成してグループに追加
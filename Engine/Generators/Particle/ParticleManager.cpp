@@ -5,6 +5,8 @@
 #include "SrvManager./SrvManager.h"
 #include "loaders./Texture./TextureManager.h"
 #include "WinApp./WinApp.h"
+#include "Systems/GameTime/FrameTimer.h"
+#include "Systems/Random/RandomSeed.h"
 
 // C++
 #include <numbers>
@@ -37,6 +39,10 @@ ParticleManager* ParticleManager::GetInstance()
 
 void ParticleManager::Finalize()
 {
+	// グループが持つSRVを返すので、SrvManager より先に呼ぶ
+	while (!particleGroups_.empty()) {
+		RemoveParticleGroup(particleGroups_.begin()->first);
+	}
 	instance.reset();
 }
 
@@ -65,6 +71,7 @@ void ParticleManager::Initialize(SrvManager* srvManager)
 /// </summary>
 void ParticleManager::Update()
 {
+	deltaTime_ = FrameTimer::GetInstance()->GetDeltaTime();
 
 
 
@@ -87,12 +94,14 @@ void ParticleManager::Update()
 	UpadateMatrix();
 	// ブレンドモードの設定を反映
 	Render(blendDesc_, currentBlendMode_);
-#ifdef _DEBUG
+}
 
+void ParticleManager::ShowImGui()
+{
+#ifdef _DEBUG
+	ShowBlendModeDropdown(currentBlendMode_);
 	ShowUpdateModeDropdown();
 #endif
-
-
 }
 
 
@@ -113,8 +122,7 @@ void ParticleManager::Draw()
 			dxCommon_->GetCommandList()->SetGraphicsRootConstantBufferView(0, materialResource_->GetGPUVirtualAddress());
 			// SRVのDescriptorTableを設定
 			srvManager_->SetGraphicsRootDescriptorTable(1, particleGroup.srvIndex);
-			// テクスチャのSRVのDescriptorTableを設定
-			D3D12_GPU_DESCRIPTOR_HANDLE textureHandle = TextureManager::GetInstance()->GetsrvHandleGPU(particleGroup.materialData.textureFilePath);
+			// テクスチャのSRVのDescriptorTableを設定 (読み込み時に記録した番号を使う)
 			srvManager_->SetGraphicsRootDescriptorTable(2, particleGroup.materialData.textureIndexSRV);
 			// 描画
 			dxCommon_->GetCommandList()->DrawInstanced(UINT(modelData_.vertices.size()), particleGroup.instance, 0, 0);
@@ -161,11 +169,11 @@ void ParticleManager::UpdateParticleMove()
 				break;
 			}
 			if (IsCollision(accelerationField.area, (*particleIterator).transform.translate)) {
-				(*particleIterator).velocity += accelerationField.acceleration * kDeltaTime;
+				(*particleIterator).velocity += accelerationField.acceleration * deltaTime_;
 			}
 			// パーティクルの更新処理
-			(*particleIterator).transform.translate += (*particleIterator).velocity * kDeltaTime;
-			(*particleIterator).currentTime += kDeltaTime;
+			(*particleIterator).transform.translate += (*particleIterator).velocity * deltaTime_;
+			(*particleIterator).currentTime += deltaTime_;
 			float alpha = 1.0f - ((*particleIterator).currentTime / (*particleIterator).lifeTime);
 
 			// ワールド行列の計算
@@ -240,7 +248,7 @@ void ParticleManager::UpdateParticles()
 				break;
 			}
 			// パーティクルの更新
-			(*particleIterator).currentTime += kDeltaTime;
+			(*particleIterator).currentTime += deltaTime_;
 
 			// アルファ値の更新（フェードアウト）
 			float alpha = 1.0f - ((*particleIterator).currentTime / (*particleIterator).lifeTime);
@@ -305,7 +313,7 @@ void ParticleManager::UpdateParticlesFor() {
 
 		while (particleIterator != particleGroup.particles.end()) {
 			// 経過時間を更新
-			(*particleIterator).currentTime += kDeltaTime;
+			(*particleIterator).currentTime += deltaTime_;
 
 			// 寿命が尽きたパーティクルは削除
 			if ((*particleIterator).currentTime >= (*particleIterator).lifeTime) {
@@ -326,9 +334,9 @@ void ParticleManager::UpdateParticlesFor() {
 			float noiseZ = std::cos(normalizedTime * frequency * 1.3f) * amplitude;
 
 			// 位置の更新
-			(*particleIterator).transform.translate.x += noiseX * kDeltaTime;
-			(*particleIterator).transform.translate.y -= descendSpeed * kDeltaTime;
-			(*particleIterator).transform.translate.z += noiseZ * kDeltaTime;
+			(*particleIterator).transform.translate.x += noiseX * deltaTime_;
+			(*particleIterator).transform.translate.y -= descendSpeed * deltaTime_;
+			(*particleIterator).transform.translate.z += noiseZ * deltaTime_;
 
 			// スケールの更新（雷の太さの変化）
 			float baseScale = 1.0f;
@@ -684,6 +692,16 @@ ParticleManager::Particle ParticleManager::MakeNewParticle(const std::string& na
 }
 
 
+void ParticleManager::RemoveParticleGroup(const std::string& name)
+{
+	auto it = particleGroups_.find(name);
+	if (it == particleGroups_.end()) {
+		return;
+	}
+	srvManager_->Free(it->second.srvIndex);
+	particleGroups_.erase(it);
+}
+
 void ParticleManager::CreateParticleGroup(const std::string name, const std::string textureFilePath)
 {
 	// 登録済みの名前かチェック
@@ -700,9 +718,9 @@ void ParticleManager::CreateParticleGroup(const std::string name, const std::str
 	// マテリアルデータにテクスチャファイルパスを設定
 	particleGroup.materialData.textureFilePath = textureFilePath;
 	// テクスチャ読み込み
-	TextureManager::GetInstance()->LoadTexture(particleGroup.materialData.textureFilePath);
+	particleGroup.materialData.textureHandle = TextureManager::GetInstance()->LoadTexture(particleGroup.materialData.textureFilePath);
 	// マテリアルデータにテクスチャのSRVインデックスを記録
-	particleGroup.materialData.textureIndexSRV = TextureManager::GetInstance()->GetTextureIndexByFilePath(particleGroup.materialData.textureFilePath);
+	particleGroup.materialData.textureIndexSRV = TextureManager::GetInstance()->GetSrvIndex(particleGroup.materialData.textureHandle);
 	// Instancing用のリソースを生成
 	particleGroup.instancingResource = dxCommon_->CreateBufferResource(sizeof(ParticleForGPU) * kNumMaxInstance);
 	particleGroup.srvIndex = srvManager_->Allocate();
@@ -771,7 +789,8 @@ std::list<ParticleManager::Particle> ParticleManager::Emit(const std::string& na
   ParticleGroup &group = it->second;
   std::list<Particle> emittedParticles;
 
-  std::mt19937 randomEngine = std::mt19937(seedGenerator_());
+  // シードは RandomSeed からもらう (入力の再生時に同じ並びにする)
+  std::mt19937 randomEngine = std::mt19937(RandomSeed::GetInstance()->Next());
   // 各パーティクルを生成し追加
   for (uint32_t i = 0; i < count; ++i) {
     Particle newParticle = MakeNewParticle(name,randomEngine, position);
@@ -892,8 +911,6 @@ void ParticleManager::Render(D3D12_BLEND_DESC& blendDesc, BlendMode& currentBlen
 
 	static BlendMode lastBlendMode = kBlendModeNone;
 
-	ShowBlendModeDropdown(currentBlendMode);
-
 	if (currentBlendMode != lastBlendMode)
 	{
 		// ブレンドモードの変更を適用
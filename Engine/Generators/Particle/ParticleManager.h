@@ -12,6 +12,7 @@
 #include <list>
 #include <unordered_map >
 #include "Loaders/Json/JsonManager.h"
+#include "Loaders/Texture/TextureHandle.h"
 // Engine
 #include "Systems./Camera/Camera.h"
 
@@ -55,6 +56,7 @@ public:
 	struct MaterialData {
 		std::string textureFilePath;
 		uint32_t textureIndexSRV = 0;
+		TextureHandle textureHandle = TextureHandleUtil::kInvalid;
 	};
 
 	struct ModelData {
@@ -191,6 +193,11 @@ public: // メンバ関数
 
 	void Render(D3D12_BLEND_DESC& blendDesc, BlendMode& currentBlendMode);
 
+	/// <summary>
+	/// ImGui (ブレンドモード・更新方法の切り替え)
+	/// </summary>
+	void ShowImGui();
+
 	/// <summary>
 	/// パーティクルグループ生成
 	/// </summary>
@@ -198,6 +205,11 @@ public: // メンバ関数
 	/// <param name="textureFilePath"></param>
 	void CreateParticleGroup(const std::string name, const std::string textureFilePath);
 
+	/// <summary>
+	/// パーティクルグループの削除 (インスタンシング用のSRVを返す)
+	/// </summary>
+	void RemoveParticleGroup(const std::string& name);
+
 
 	/// <summary>
 	/// パーティクルの発生
@@ -338,8 +350,6 @@ private: // メンバ変数
 
 
 	ModelData modelData_;
-	// 乱数生成器
-	std::random_device seedGenerator_;
 
 	// 最初のブレンドモード
 	BlendMode currentBlendMode_;
@@ -347,7 +357,7 @@ private: // メンバ変数
 	std::unordered_map<std::string, ParticleGroup> particleGroups_;
 	// パラメーター用のコンテナ
 	std::unordered_map<std::string, ParticleParameters> particleParameters_;
-	const float kDeltaTime = 1.0f / 60.0f;
+	float deltaTime_ = 1.0f / 60.0f;
 	// インスタンシング用リソース作成
 	const uint32_t kNumMaxInstance = 10000; // インスタンス数
 	// ブレンドモードごとのPSOを保持するマップ
@@ -7,6 +7,8 @@
 // Engine
 #include "Systems/Camera/Camera.h"
 #include "SrvManager./SrvManager.h"
+#include "SpriteBatch.h"
+#include "Loaders/Texture/TextureHandle.h"
 
 // Math
 #include "Vector4.h"
@@ -18,28 +20,6 @@
 class SpriteCommon;
 class Sprite
 {
-public: // 構造体
-	// 頂点データ
-	struct VertexData {
-		Vector4 position;
-		Vector2 texcoord;
-		Vector3 normal;
-	};
-
-	// マテリアルデータ
-	struct Material {
-		Vector4 color;
-		int32_t enableLighting;
-		float padding[3];
-		Matrix4x4 uvTransform;
-	};
-
-	// 座標変換データ
-	struct TransformationMatrix {
-		Matrix4x4 WVP;
-		Matrix4x4 World;
-	};
-
 public: // 基本的関数
 	Sprite();
 	/// <summary>
@@ -53,7 +33,7 @@ public: // 基本的関数
 	void Update();
 
 	/// <summary>
-	/// 描画
+	/// 描画 (SpriteCommonのバッチに積む。SpriteCommon::DrawBatchでまとめて描画される)
 	/// </summary>
 	void Draw();
 
@@ -71,35 +51,14 @@ public: // 基本的関数
 private: // メンバ関数
 
 	/// <summary>
-	/// 頂点リソース
-	/// </summary>
-	void VertexResource();
-
-	/// <summary>
-	/// 頂点
-	/// </summary>
-	void CreateVertex();
-
-	/// <summary>
-	/// インデックスリソース
-	/// </summary>
-	void IndexResource();
-
-	/// <summary>
-	/// 頂点インデックス
-	/// </summary>
-	void CreateIndex();
-
-	/// <summary>
-	/// マテリアルリソース
+	/// 頂点 (クリップ空間まで変換してバッチ用に保持する)
 	/// </summary>
-	void MaterialResource();
+	void CreateVertex(const Matrix4x4& worldViewProjection);
 
 	/// <summary>
-	/// 座標変換リソース
+	/// テクスチャの割り当て (アトラスに含まれていればページと領域に差し替える)
 	/// </summary>
-	void TransformResource();
-
+	void BindTexture(const std::string& textureFilePath);
 
 
 
@@ -126,14 +85,21 @@ public: // アクセッサ
 	/*===============================================//
 					　	 色を変更
 	//===============================================*/
-	const Vector4& GetColor()const { return materialData_->color; }
-	void SetColor(const Vector4& color) { materialData_->color = color; }
+	const Vector4& GetColor()const { return color_; }
+	void SetColor(const Vector4& color) { color_ = color; }
 
 	/*===============================================//
 				　		アルファ値の変更
 	//===============================================*/
 
-	void SetAlpha(const float& alpha) { materialData_->color.w = alpha; }
+	void SetAlpha(const float& alpha) { color_.w = alpha; }
+
+	/*===============================================//
+				　		描画レイヤー
+	//===============================================*/
+	// 小さいほど先 (奥) に描画される。同じレイヤー内はテクスチャごとにまとめられる
+	int32_t GetLayer() const { return layer_; }
+	void SetLayer(int32_t layer) { layer_ = layer; }
 
 	/*===============================================//
 					　アンカーポイント
@@ -170,44 +136,34 @@ public: // アクセッサ
 private: // メンバ変数
 
 	SpriteCommon* spriteCommon_ = nullptr;
-	SrvManager* srvManagaer_;
-	Camera* camera_;
+	SrvManager* srvManagaer_ = nullptr;
+	Camera* camera_ = nullptr;
 	/*===============================================//
-						Resouurces
+						バッチ用
 	//===============================================*/
 
-	// 頂点
-	Microsoft::WRL::ComPtr<ID3D12Resource> vertexResource_;
-	D3D12_VERTEX_BUFFER_VIEW vertexBufferView_{};
-
-	// インデックス
-	Microsoft::WRL::ComPtr<ID3D12Resource> indexResource_;
-	D3D12_INDEX_BUFFER_VIEW indexBufferView_{};
-
-	// マテリアル
-	Microsoft::WRL::ComPtr<ID3D12Resource> materialResource_;
-	Material* materialData_ = nullptr;
-
-	// 座標変換
-	Microsoft::WRL::ComPtr<ID3D12Resource> transformationMatrixResource_;
-	TransformationMatrix* transformationMatrixData_ = nullptr;
+	// クリップ空間の頂点 (左下, 左上, 右下, 右上)
+	SpriteBatch::Vertex vertices_[SpriteBatch::kVertexPerQuad] = {};
+	// 色
+	Vector4 color_ = { 1.0f, 1.0f, 1.0f, 1.0f };
+	// 描画レイヤー
+	int32_t layer_ = 0;
 
 	/*===============================================//
 						Texture
 	//===============================================*/
 
-	DirectX::ScratchImage mipImages[2] = {};
-	//const DirectX::TexMetadata& metadata = mipImages[0].GetMetadata();
-	const DirectX::TexMetadata& metadata2 = mipImages[1].GetMetadata();
-
-	Microsoft::WRL::ComPtr<ID3D12Resource> textureResource[2];
-	Microsoft::WRL::ComPtr<ID3D12Resource> intermediateResource[2];
-
-	D3D12_CPU_DESCRIPTOR_HANDLE textureSrvHandleCPU;
-	D3D12_GPU_DESCRIPTOR_HANDLE textureSrvHandleGPU;
+	// テクスチャハンドル
+	TextureHandle textureHandle_ = TextureHandleUtil::kInvalid;
 	// テクスチャ番号
 	uint32_t textureIndex_ = 0;
 	std::string filePath_;
+	// テクスチャ全体のサイズ (毎フレームのメタデータ検索を避ける)
+	Vector2 textureFullSize_ = { 1.0f,1.0f };
+	// 元画像のサイズ (アトラスに含まれる場合もページではなく元画像のサイズ)
+	Vector2 imageSize_ = { 1.0f,1.0f };
+	// アトラス内での元画像の左上 (textureLeftTop_ は元画像基準のまま扱える)
+	Vector2 atlasOffset_ = { 0.0f,0.0f };
 
 	// テクスチャ左上座標
 	Vector2 textureLeftTop_ = { 0.0f,0.0f };
@@ -218,7 +174,6 @@ private: // メンバ変数
 	Vector3 position_ = { 0.0f,0.0f ,0.0f};
 	Vector3 rotation_ = { 0.0f,0.0f,0.0f };
 	Vector2 size_ = { 100.0f,100.0f };
-	const float numVertices_ = 6.0f;
 
 	// アンカーポイント
 	Vector2 anchorPoint_ = { 0.0f,0.0f };
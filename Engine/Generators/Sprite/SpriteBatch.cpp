@@ -0,0 +1,111 @@
+#include "SpriteBatch.h"
+
+// C++
+#include <algorithm>
+#include <cassert>
+
+void SpriteBatch::Clear()
+{
+	vertices_.clear();
+	keys_.clear();
+	drawCommands_.clear();
+}
+
+void SpriteBatch::Add(int32_t layer, uint32_t textureIndex, const Vertex (&vertices)[kVertexPerQuad])
+{
+	assert(textureIndex <= 0xFFFF);
+
+	// 負のレイヤーも順番通りに並ぶように符号をずらす
+	int32_t clampedLayer = std::clamp(layer, -32768, 32767);
+	uint64_t layerKey = static_cast<uint64_t>(clampedLayer + 32768);
+	uint64_t order = static_cast<uint64_t>(keys_.size());
+	keys_.push_back((layerKey << 48) | (static_cast<uint64_t>(textureIndex & 0xFFFF) << 32) | order);
+
+	vertices_.insert(vertices_.end(), vertices, vertices + kVertexPerQuad);
+}
+
+uint32_t SpriteBatch::Build(Vertex* destination, uint32_t maxQuads)
+{
+	drawCommands_.clear();
+
+	// 登録順が下位に入っているのでキーは重複しない
+	std::sort(keys_.begin(), keys_.end());
+
+	uint32_t quadCount = (std::min)(static_cast<uint32_t>(keys_.size()), maxQuads);
+	for (uint32_t i = 0; i < quadCount; ++i) {
+		uint32_t order = static_cast<uint32_t>(keys_[i] & 0xFFFFFFFFull);
+		uint32_t textureIndex = static_cast<uint32_t>((keys_[i] >> 32) & 0xFFFF);
+
+		std::copy_n(&vertices_[static_cast<size_t>(order) * kVertexPerQuad], kVertexPerQuad,
+			destination + static_cast<size_t>(i) * kVertexPerQuad);
+
+		// テクスチャが変わったら新しい描画を始める
+		if (drawCommands_.empty() || drawCommands_.back().textureIndex != textureIndex) {
+			drawCommands_.push_back({ textureIndex, i, 0 });
+		}
+		++drawCommands_.back().quadCount;
+	}
+	return quadCount;
+}
+
+void SpriteBatch::MakeQuad(const Matrix4x4& worldViewProjection, const Vector2& anchorPoint, bool isFlipX, bool isFlipY,
+	const Vector2& uvLeftTop, const Vector2& uvRightBottom, Vertex (&vertices)[kVertexPerQuad])
+{
+	// アンカーポイント
+	float left = 0.0f - anchorPoint.x;
+	float right = 1.0f - anchorPoint.x;
+	float top = 0.0f - anchorPoint.y;
+	float bottom = 1.0f - anchorPoint.y;
+
+	// 左右反転
+	if (isFlipX) {
+		left = -left;
+		right = -right;
+	}
+	//上下反転
+	if (isFlipY) {
+		top = -top;
+		bottom = -bottom;
+	}
+
+	// ローカル座標をクリップ空間へ (wはGPU側で割る)
+	const Matrix4x4& m = worldViewProjection;
+	auto toClip = [&m](float x, float y) {
+		return Vector4{
+			x * m.m[0][0] + y * m.m[1][0] + m.m[3][0],
+			x * m.m[0][1] + y * m.m[1][1] + m.m[3][1],
+			x * m.m[0][2] + y * m.m[1][2] + m.m[3][2],
+			x * m.m[0][3] + y * m.m[1][3] + m.m[3][3],
+		};
+	};
+
+	// 左下
+	vertices[0].position = toClip(left, bottom);
+	vertices[0].texcoord = { uvLeftTop.x, uvRightBottom.y };
+
+	// 左上
+	vertices[1].position = toClip(left, top);
+	vertices[1].texcoord = { uvLeftTop.x, uvLeftTop.y };
+
+	// 右下
+	vertices[2].position = toClip(right, bottom);
+	vertices[2].texcoord = { uvRightBottom.x, uvRightBottom.y };
+
+	// 右上
+	vertices[3].position = toClip(right, top);
+	vertices[3].texcoord = { uvRightBottom.x, uvLeftTop.y };
+}
+
+void SpriteBatch::WriteQuadIndices(uint32_t* destination, uint32_t quadCount)
+{
+	for (uint32_t i = 0; i < quadCount; ++i) {
+		uint32_t base = i * kVertexPerQuad;
+		uint32_t* index = destination + static_cast<size_t>(i) * kIndexPerQuad;
+		index[0] = base + 0;
+		index[1] = base + 1;
+		index[2] = base + 2;
+		index[3] = base + 1;
+		index[4] = base + 3;
+		index[5] = base + 2;
+	}
+}
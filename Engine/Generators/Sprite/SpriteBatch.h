@@ -0,0 +1,88 @@
+#pragma once
+// C++
+#include <cstdint>
+#include <vector>
+
+// Math
+#include "Matrix4x4.h"
+#include "Vector2.h"
+#include "Vector4.h"
+
+/// <summary>
+/// スプライトをまとめて描画するためのCPU側の並べ替え
+/// レイヤー → テクスチャ → 登録順 に並べ、同じテクスチャが続く範囲を1回の描画にまとめる
+/// GPUには触らないので単体で動かせる
+/// </summary>
+class SpriteBatch
+{
+public: // 構造体
+	// まとめ描画用の頂点 (座標はクリップ空間まで変換済み)
+	struct Vertex {
+		Vector4 position;
+		Vector2 texcoord;
+		Vector4 color;
+	};
+
+	// 同じテクスチャが続く範囲
+	struct DrawCommand {
+		uint32_t textureIndex;
+		uint32_t firstQuad;
+		uint32_t quadCount;
+	};
+
+	// 1クアッドの頂点数とインデックス数
+	static constexpr uint32_t kVertexPerQuad = 4;
+	static constexpr uint32_t kIndexPerQuad = 6;
+
+public: // メンバ関数
+
+	/// <summary>
+	/// 溜めたスプライトを破棄
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// スプライトを1枚追加
+	/// </summary>
+	/// <param name="layer">小さいほど先に描画される</param>
+	/// <param name="textureIndex">SRVのインデックス</param>
+	/// <param name="vertices">左下, 左上, 右下, 右上 の順</param>
+	void Add(int32_t layer, uint32_t textureIndex, const Vertex (&vertices)[kVertexPerQuad]);
+
+	/// <summary>
+	/// 並べ替えて頂点を書き出し、描画コマンドを作る
+	/// </summary>
+	/// <param name="destination">書き出し先 (maxQuads * 4 頂点分)</param>
+	/// <param name="maxQuads">書き出せる最大クアッド数 (溢れた分は捨てる)</param>
+	/// <returns>書き出したクアッド数</returns>
+	uint32_t Build(Vertex* destination, uint32_t maxQuads);
+
+	/// <summary>
+	/// 1枚分の頂点をクリップ空間で作る (色は触らない)
+	/// </summary>
+	/// <param name="worldViewProjection">0～1 の四角をクリップ空間へ移す行列</param>
+	/// <param name="anchorPoint">回転・拡縮の中心 (0～1)</param>
+	/// <param name="uvLeftTop">切り出し範囲の左上 (正規化済み)</param>
+	/// <param name="uvRightBottom">切り出し範囲の右下 (正規化済み)</param>
+	/// <param name="vertices">左下, 左上, 右下, 右上 の順に書き出す</param>
+	static void MakeQuad(const Matrix4x4& worldViewProjection, const Vector2& anchorPoint, bool isFlipX, bool isFlipY,
+		const Vector2& uvLeftTop, const Vector2& uvRightBottom, Vertex (&vertices)[kVertexPerQuad]);
+
+	/// <summary>
+	/// 1クアッド分のインデックス (0,1,2 / 1,3,2)
+	/// </summary>
+	static void WriteQuadIndices(uint32_t* destination, uint32_t quadCount);
+
+public: // アクセッサ
+
+	uint32_t GetQuadCount() const { return static_cast<uint32_t>(keys_.size()); }
+	const std::vector<DrawCommand>& GetDrawCommands() const { return drawCommands_; }
+
+private:
+	// 登録順の頂点
+	std::vector<Vertex> vertices_;
+	// 並べ替え用のキー (レイヤー16bit | テクスチャ16bit | 登録順32bit)
+	std::vector<uint64_t> keys_;
+	// Buildで作った描画コマンド
+	std::vector<DrawCommand> drawCommands_;
+};
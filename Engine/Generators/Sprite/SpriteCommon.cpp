@@ -1,5 +1,13 @@
 #include "SpriteCommon.h"
 #include "PipelineManager/PipelineManager.h"
+#include "SrvManager/SrvManager.h"
+#include "WinApp./WinApp.h"
+
+// C++
+#include <cassert>
+
+// Math
+#include "MathFunc.h"
 
 // シングルトンインスタンスの初期化
 std::unique_ptr<SpriteCommon> SpriteCommon::instance = nullptr;
@@ -25,8 +33,76 @@ void SpriteCommon::Initialize(DirectXCommon* dxCommon)
 	dxCommon_ = dxCommon;
 	
 
-	rootSignature_ = PipelineManager::GetInstance()->GetRootSignature("Sprite");
-	graphicsPipelineState_ = PipelineManager::GetInstance()->GetPipeLineStateObject("Sprite");
+	rootSignature_ = PipelineManager::GetInstance()->GetRootSignature("SpriteBatch");
+	graphicsPipelineState_ = PipelineManager::GetInstance()->GetPipeLineStateObject("SpriteBatch");
+
+	// 画面サイズの正射影行列
+	projectionMatrix_ = MakeOrthographicMatrix(0.0f, 0.0f, float(WinApp::kClientWidth), float(WinApp::kClientHeight), 0.0f, 100.0f);
+
+	CreateBatchResource();
+}
+
+void SpriteCommon::CreateBatchResource()
+{
+	// 頂点リング (毎フレーム先頭から書き直す)
+	batchVertexResource_ = dxCommon_->CreateBufferResource(sizeof(SpriteBatch::Vertex) * SpriteBatch::kVertexPerQuad * kMaxBatchSprite);
+	batchVertexResource_->Map(0, nullptr, reinterpret_cast<void**>(&batchVertexData_));
+	batchVertexBufferView_.BufferLocation = batchVertexResource_->GetGPUVirtualAddress();
+	batchVertexBufferView_.SizeInBytes = sizeof(SpriteBatch::Vertex) * SpriteBatch::kVertexPerQuad * kMaxBatchSprite;
+	batchVertexBufferView_.StrideInBytes = sizeof(SpriteBatch::Vertex);
+
+	// インデックスはクアッドの並びが変わらないので最初に1回だけ書く
+	batchIndexResource_ = dxCommon_->CreateBufferResource(sizeof(uint32_t) * SpriteBatch::kIndexPerQuad * kMaxBatchSprite);
+	uint32_t* indexData = nullptr;
+	batchIndexResource_->Map(0, nullptr, reinterpret_cast<void**>(&indexData));
+	SpriteBatch::WriteQuadIndices(indexData, kMaxBatchSprite);
+	batchIndexResource_->Unmap(0, nullptr);
+	batchIndexBufferView_.BufferLocation = batchIndexResource_->GetGPUVirtualAddress();
+	batchIndexBufferView_.SizeInBytes = sizeof(uint32_t) * SpriteBatch::kIndexPerQuad * kMaxBatchSprite;
+	batchIndexBufferView_.Format = DXGI_FORMAT_R32_UINT;
+}
+
+void SpriteCommon::PreDraw()
+{
+	// 前フレームのGPU処理は終わっているので先頭から使い直す
+	batchWriteOffset_ = 0;
+	drawCallCount_ = 0;
+	spriteCount_ = 0;
+	batch_.Clear();
+}
+
+void SpriteCommon::AddSprite(int32_t layer, uint32_t textureIndex, const SpriteBatch::Vertex (&vertices)[SpriteBatch::kVertexPerQuad])
+{
+	batch_.Add(layer, textureIndex, vertices);
+}
+
+void SpriteCommon::DrawBatch()
+{
+	if (batch_.GetQuadCount() == 0) {
+		return;
+	}
+
+	// リングの空き分だけ書き出す (溢れた分は描画しない)
+	uint32_t quadCount = batch_.Build(batchVertexData_ + batchWriteOffset_ * SpriteBatch::kVertexPerQuad,
+		kMaxBatchSprite - batchWriteOffset_);
+	assert(quadCount == batch_.GetQuadCount() && "SpriteCommon : sprite batch overflow");
+
+	DrawPreference();
+	ID3D12GraphicsCommandList* commandList = dxCommon_->GetCommandList().Get();
+	commandList->IASetVertexBuffers(0, 1, &batchVertexBufferView_);
+	commandList->IASetIndexBuffer(&batchIndexBufferView_);
+
+	// テクスチャが続く範囲ごとに1回描画
+	for (const SpriteBatch::DrawCommand& command : batch_.GetDrawCommands()) {
+		SrvManager::GetInstance()->SetGraphicsRootDescriptorTable(0, command.textureIndex);
+		commandList->DrawIndexedInstanced(command.quadCount * SpriteBatch::kIndexPerQuad, 1, 0,
+			static_cast<INT>((batchWriteOffset_ + command.firstQuad) * SpriteBatch::kVertexPerQuad), 0);
+		++drawCallCount_;
+	}
+
+	batchWriteOffset_ += quadCount;
+	spriteCount_ += quadCount;
+	batch_.Clear();
 }
 
 void SpriteCommon::DrawPreference()
@@ -1,8 +1,12 @@
 #pragma once
 #include "DX./DirectXCommon.h"
+#include "SpriteBatch.h"
 #include <memory>
 #include <mutex>
 
+// Math
+#include "Matrix4x4.h"
+
 class SpriteCommon
 {
 public: // メンバ関数
@@ -41,9 +45,29 @@ public: // メンバ関数
     /// </summary>
     void SetPrimitiveTopology();
 
+    /// <summary>
+    /// フレーム開始 (頂点リングの書き込み位置を戻す)
+    /// </summary>
+    void PreDraw();
+
+    /// <summary>
+    /// スプライトをバッチに積む
+    /// </summary>
+    void AddSprite(int32_t layer, uint32_t textureIndex, const SpriteBatch::Vertex (&vertices)[SpriteBatch::kVertexPerQuad]);
+
+    /// <summary>
+    /// 積んだスプライトをレイヤー・テクスチャ順に並べ、テクスチャごとに1回で描画する
+    /// </summary>
+    void DrawBatch();
+
 public: // アクセッサ
 
     DirectXCommon* GetDxCommon() const { return dxCommon_; }
+    // スプライト共通の正射影行列
+    const Matrix4x4& GetProjectionMatrix() const { return projectionMatrix_; }
+    // 今フレームの描画数
+    uint32_t GetDrawCallCount() const { return drawCallCount_; }
+    uint32_t GetSpriteCount() const { return spriteCount_; }
 
 private:
     // シングルトンインスタンス
@@ -54,9 +78,35 @@ private:
     SpriteCommon(SpriteCommon&) = delete;
     SpriteCommon& operator=(const SpriteCommon&) = delete;
 
+    /// <summary>
+    /// バッチ用の頂点リングとインデックスを作る
+    /// </summary>
+    void CreateBatchResource();
+
     DirectXCommon* dxCommon_;
 
     Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_ = nullptr;
     Microsoft::WRL::ComPtr<ID3D12PipelineState> graphicsPipelineState_= nullptr;
 
+    // 1フレームに描画できる最大スプライト数
+    static const uint32_t kMaxBatchSprite = 8192;
+
+    Matrix4x4 projectionMatrix_;
+
+    // CPU側の並べ替え
+    SpriteBatch batch_;
+
+    // 1フレーム分の頂点リング
+    Microsoft::WRL::ComPtr<ID3D12Resource> batchVertexResource_;
+    D3D12_VERTEX_BUFFER_VIEW batchVertexBufferView_{};
+    SpriteBatch::Vertex* batchVertexData_ = nullptr;
+    uint32_t batchWriteOffset_ = 0;
+
+    // 全クアッド共通のインデックス
+    Microsoft::WRL::ComPtr<ID3D12Resource> batchIndexResource_;
+    D3D12_INDEX_BUFFER_VIEW batchIndexBufferView_{};
+
+    uint32_t drawCallCount_ = 0;
+    uint32_t spriteCount_ = 0;
+
 };
@@ -0,0 +1,153 @@
+#include "FrustumCuller.h"
+
+// C++
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#include <xmmintrin.h>
+#define FRUSTUM_CULLER_SSE
+#endif
+
+void FrustumCuller::SetFrustum(const Matrix4x4& viewProjection)
+{
+	const float(&m)[4][4] = viewProjection.m;
+
+	// clip = (x, y, z, 1) * M なので、各平面は列の組み合わせになる
+	for (int i = 0; i < 4; ++i) {
+		planes_[0][i] = m[i][3] + m[i][0];	// 左
+		planes_[1][i] = m[i][3] - m[i][0];	// 右
+		planes_[2][i] = m[i][3] + m[i][1];	// 下
+		planes_[3][i] = m[i][3] - m[i][1];	// 上
+		planes_[4][i] = m[i][2];			// 近 (z >= 0)
+		planes_[5][i] = m[i][3] - m[i][2];	// 遠
+	}
+}
+
+void FrustumCuller::Reserve(size_t count)
+{
+	centerX_.reserve(count);
+	centerY_.reserve(count);
+	centerZ_.reserve(count);
+	extentX_.reserve(count);
+	extentY_.reserve(count);
+	extentZ_.reserve(count);
+}
+
+void FrustumCuller::Clear()
+{
+	centerX_.clear();
+	centerY_.clear();
+	centerZ_.clear();
+	extentX_.clear();
+	extentY_.clear();
+	extentZ_.clear();
+}
+
+uint32_t FrustumCuller::Add(const AABB& bounds)
+{
+	uint32_t index = static_cast<uint32_t>(centerX_.size());
+	centerX_.push_back((bounds.min.x + bounds.max.x) * 0.5f);
+	centerY_.push_back((bounds.min.y + bounds.max.y) * 0.5f);
+	centerZ_.push_back((bounds.min.z + bounds.max.z) * 0.5f);
+	extentX_.push_back((bounds.max.x - bounds.min.x) * 0.5f);
+	extentY_.push_back((bounds.max.y - bounds.min.y) * 0.5f);
+	extentZ_.push_back((bounds.max.z - bounds.min.z) * 0.5f);
+	return index;
+}
+
+void FrustumCuller::Cull(std::vector<uint32_t>& outVisible) const
+{
+	outVisible.clear();
+	const uint32_t count = static_cast<uint32_t>(centerX_.size());
+	uint32_t i = 0;
+
+#ifdef FRUSTUM_CULLER_SSE
+	// 4個ずつ、平面ごとに「中心の距離 + 半径の射影」が負なら外側
+	__m128 planeX[6], planeY[6], planeZ[6], planeW[6];
+	__m128 absX[6], absY[6], absZ[6];
+	for (int p = 0; p < 6; ++p) {
+		planeX[p] = _mm_set1_ps(planes_[p][0]);
+		planeY[p] = _mm_set1_ps(planes_[p][1]);
+		planeZ[p] = _mm_set1_ps(planes_[p][2]);
+		planeW[p] = _mm_set1_ps(planes_[p][3]);
+		absX[p] = _mm_set1_ps(std::fabs(planes_[p][0]));
+		absY[p] = _mm_set1_ps(std::fabs(planes_[p][1]));
+		absZ[p] = _mm_set1_ps(std::fabs(planes_[p][2]));
+	}
+	const __m128 zero = _mm_setzero_ps();
+
+	for (; i + 4 <= count; i += 4) {
+		const __m128 cx = _mm_loadu_ps(&centerX_[i]);
+		const __m128 cy = _mm_loadu_ps(&centerY_[i]);
+		const __m128 cz = _mm_loadu_ps(&centerZ_[i]);
+		const __m128 ex = _mm_loadu_ps(&extentX_[i]);
+		const __m128 ey = _mm_loadu_ps(&extentY_[i]);
+		const __m128 ez = _mm_loadu_ps(&extentZ_[i]);
+
+		__m128 inside = _mm_cmpeq_ps(zero, zero);
+		for (int p = 0; p < 6; ++p) {
+			__m128 distance = _mm_add_ps(_mm_mul_ps(planeX[p], cx), planeW[p]);
+			distance = _mm_add_ps(distance, _mm_mul_ps(planeY[p], cy));
+			distance = _mm_add_ps(distance, _mm_mul_ps(planeZ[p], cz));
+			__m128 radius = _mm_mul_ps(absX[p], ex);
+			radius = _mm_add_ps(radius, _mm_mul_ps(absY[p], ey));
+			radius = _mm_add_ps(radius, _mm_mul_ps(absZ[p], ez));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+		}
+
+		int mask = _mm_movemask_ps(inside);
+		while (mask) {
+			int bit = 0;
+			while (!(mask & (1 << bit))) {
+				++bit;
+			}
+			outVisible.push_back(i + bit);
+			mask &= mask - 1;
+		}
+	}
+#endif
+
+	// 残り (SIMDが使えない環境では全部)
+	for (; i < count; ++i) {
+		bool inside = true;
+		for (int p = 0; p < 6 && inside; ++p) {
+			float distance = planes_[p][0] * centerX_[i] + planes_[p][1] * centerY_[i] + planes_[p][2] * centerZ_[i] + planes_[p][3];
+			float radius = std::fabs(planes_[p][0]) * extentX_[i] + std::fabs(planes_[p][1]) * extentY_[i] + std::fabs(planes_[p][2]) * extentZ_[i];
+			inside = distance + radius >= 0.0f;
+		}
+		if (inside) {
+			outVisible.push_back(i);
+		}
+	}
+}
+
+AABB FrustumCuller::TransformBounds(const AABB& local, const Matrix4x4& world)
+{
+	// 中心は点として、半径は各軸の絶対値で変換する
+	const float center[3] = {
+		(local.min.x + local.max.x) * 0.5f,
+		(local.min.y + local.max.y) * 0.5f,
+		(local.min.z + local.max.z) * 0.5f,
+	};
+	const float extent[3] = {
+		(local.max.x - local.min.x) * 0.5f,
+		(local.max.y - local.min.y) * 0.5f,
+		(local.max.z - local.min.z) * 0.5f,
+	};
+
+	float worldCenter[3];
+	float worldExtent[3];
+	for (int j = 0; j < 3; ++j) {
+		worldCenter[j] = world.m[3][j];
+		worldExtent[j] = 0.0f;
+		for (int i = 0; i < 3; ++i) {
+			worldCenter[j] += center[i] * world.m[i][j];
+			worldExtent[j] += extent[i] * std::fabs(world.m[i][j]);
+		}
+	}
+
+	AABB result;
+	result.min = { worldCenter[0] - worldExtent[0], worldCenter[1] - worldExtent[1], worldCenter[2] - worldExtent[2] };
+	result.max = { worldCenter[0] + worldExtent[0], worldCenter[1] + worldExtent[1], worldCenter[2] + worldExtent[2] };
+	return result;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+// C++
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Math
+#include "MathFunc.h"
+#include "Matrix4x4.h"
+
+/// <summary>
+/// 視錐台カリング (D3D12には依存しない)
+/// ワールド空間のAABBを中心・半径の配列で持ち、6平面との判定を4個ずつSIMDでまとめて行う
+/// </summary>
+class FrustumCuller
+{
+public: // メンバ関数
+
+	/// <summary>
+	/// ビュープロジェクション行列から6平面を取り出す (行ベクトル × 行列、深度は0～1)
+	/// </summary>
+	void SetFrustum(const Matrix4x4& viewProjection);
+
+	/// <summary>
+	/// 容量の確保
+	/// </summary>
+	void Reserve(size_t count);
+
+	/// <summary>
+	/// 登録したAABBを空にする
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// ワールド空間のAABBを登録して番号を返す
+	/// </summary>
+	uint32_t Add(const AABB& bounds);
+
+	/// <summary>
+	/// 視錐台に掛かっているものの番号を昇順で outVisible に入れる
+	/// </summary>
+	void Cull(std::vector<uint32_t>& outVisible) const;
+
+	/// <summary>
+	/// ローカル空間のAABBをワールド行列で変換したものを包むAABB
+	/// </summary>
+	static AABB TransformBounds(const AABB& local, const Matrix4x4& world);
+
+	size_t GetCount() const { return centerX_.size(); }
+
+private: // メンバ変数
+
+	// 平面 (a, b, c, d) : ax + by + cz + d >= 0 が内側
+	float planes_[6][4] = {};
+
+	// AABBの中心と半径 (SoA)
+	std::vector<float> centerX_;
+	std::vector<float> centerY_;
+	std::vector<float> centerZ_;
+	std::vector<float> extentX_;
+	std::vector<float> extentY_;
+	std::vector<float> extentZ_;
+};
@@ -0,0 +1,367 @@
+#include "OcclusionRasterizer.h"
+
+// C++
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <execution>
+#include <numeric>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#include <xmmintrin.h>
+#define OCCLUSION_RASTERIZER_SSE
+#endif
+
+namespace {
+	// 箱の12枚の三角形 (角の番号は bit0=x, bit1=y, bit2=z が max 側)
+	const uint32_t kBoxIndices[36] = {
+		0, 2, 1, 1, 2, 3,	// -z
+		4, 5, 6, 5, 7, 6,	// +z
+		0, 1, 4, 1, 5, 4,	// -y
+		2, 6, 3, 3, 6, 7,	// +y
+		0, 4, 2, 2, 4, 6,	// -x
+		1, 3, 5, 3, 7, 5,	// +x
+	};
+}
+
+void OcclusionRasterizer::Initialize(uint32_t width, uint32_t height)
+{
+	assert(width > 0 && height > 0);
+	assert(width % kTileWidth_ == 0 && height % kTileHeight_ == 0);
+
+	width_ = width;
+	height_ = height;
+	tilesX_ = width / kTileWidth_;
+	tilesY_ = height / kTileHeight_;
+
+	depth_.assign(static_cast<size_t>(width_) * height_, 1.0f);
+	tileMaxDepth_.assign(static_cast<size_t>(tilesX_) * tilesY_, 1.0f);
+	bins_.assign(tileMaxDepth_.size(), {});
+	tileIndices_.resize(tileMaxDepth_.size());
+	std::iota(tileIndices_.begin(), tileIndices_.end(), 0u);
+	isReady_ = false;
+}
+
+void OcclusionRasterizer::BeginFrame(const Matrix4x4& viewProjection)
+{
+	viewProjection_ = viewProjection;
+	isReady_ = false;
+	stats_ = {};
+
+	std::fill(depth_.begin(), depth_.end(), 1.0f);
+	std::fill(tileMaxDepth_.begin(), tileMaxDepth_.end(), 1.0f);
+	for (std::vector<uint32_t>& bin : bins_) {
+		bin.clear();
+	}
+	triangles_.clear();
+}
+
+void OcclusionRasterizer::AddOccluder(const float* positions, uint32_t stride, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount, const Matrix4x4& world)
+{
+	const Matrix4x4 worldViewProjection = world * viewProjection_;
+
+	// 頂点は共有されるので先にまとめてクリップ空間へ
+	clipVertices_.resize(vertexCount);
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>(positions);
+	for (uint32_t i = 0; i < vertexCount; ++i) {
+		const float* p = reinterpret_cast<const float*>(bytes + static_cast<size_t>(i) * stride);
+		clipVertices_[i] = ToClip(p[0], p[1], p[2], worldViewProjection);
+	}
+
+	for (uint32_t i = 0; i + 2 < indexCount; i += 3) {
+		assert(indices[i] < vertexCount && indices[i + 1] < vertexCount && indices[i + 2] < vertexCount);
+		AddClipTriangle(clipVertices_[indices[i]], clipVertices_[indices[i + 1]], clipVertices_[indices[i + 2]]);
+	}
+}
+
+void OcclusionRasterizer::AddOccluderBox(const AABB& local, const Matrix4x4& world)
+{
+	float corners[8][3];
+	for (uint32_t i = 0; i < 8; ++i) {
+		corners[i][0] = (i & 1) ? local.max.x : local.min.x;
+		corners[i][1] = (i & 2) ? local.max.y : local.min.y;
+		corners[i][2] = (i & 4) ? local.max.z : local.min.z;
+	}
+	AddOccluder(&corners[0][0], sizeof(corners[0]), 8, kBoxIndices, 36, world);
+}
+
+void OcclusionRasterizer::Rasterize()
+{
+	auto start = std::chrono::steady_clock::now();
+
+	// タイルごとに独立しているので並列に描く
+	std::for_each(std::execution::par, tileIndices_.begin(), tileIndices_.end(), [this](uint32_t tile) {
+		RasterizeTile(tile);
+		});
+
+	auto end = std::chrono::steady_clock::now();
+	stats_.rasterizeMicroseconds = std::chrono::duration<float, std::micro>(end - start).count();
+	isReady_ = true;
+}
+
+bool OcclusionRasterizer::IsVisible(const AABB& bounds)
+{
+	if (!isReady_) {
+		return true;
+	}
+	++stats_.testedBounds;
+
+	// 8つの角を画面へ。近面より手前の角があれば隠れていない扱い
+	float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f, minZ = 0.0f;
+	for (uint32_t i = 0; i < 8; ++i) {
+		ClipVertex v = ToClip(
+			(i & 1) ? bounds.max.x : bounds.min.x,
+			(i & 2) ? bounds.max.y : bounds.min.y,
+			(i & 4) ? bounds.max.z : bounds.min.z,
+			viewProjection_);
+		if (v.z < 0.0f || v.w <= 0.0f) {
+			return true;
+		}
+		const float invW = 1.0f / v.w;
+		const float x = (v.x * invW * 0.5f + 0.5f) * static_cast<float>(width_);
+		const float y = (0.5f - v.y * invW * 0.5f) * static_cast<float>(height_);
+		const float z = v.z * invW;
+		if (i == 0) {
+			minX = maxX = x;
+			minY = maxY = y;
+			minZ = z;
+		} else {
+			minX = (std::min)(minX, x);
+			maxX = (std::max)(maxX, x);
+			minY = (std::min)(minY, y);
+			maxY = (std::max)(maxY, y);
+			minZ = (std::min)(minZ, z);
+		}
+	}
+
+	// 掛かっている画素 (画面外は隠れていない扱い)
+	const int32_t x0 = (std::max)(static_cast<int32_t>(std::floor(minX)), 0);
+	const int32_t y0 = (std::max)(static_cast<int32_t>(std::floor(minY)), 0);
+	const int32_t x1 = (std::min)(static_cast<int32_t>(std::ceil(maxX)) - 1, static_cast<int32_t>(width_) - 1);
+	const int32_t y1 = (std::min)(static_cast<int32_t>(std::ceil(maxY)) - 1, static_cast<int32_t>(height_) - 1);
+	if (x0 > x1 || y0 > y1 || minZ > 1.0f) {
+		return true;
+	}
+
+	for (int32_t ty = y0 / static_cast<int32_t>(kTileHeight_); ty <= y1 / static_cast<int32_t>(kTileHeight_); ++ty) {
+		for (int32_t tx = x0 / static_cast<int32_t>(kTileWidth_); tx <= x1 / static_cast<int32_t>(kTileWidth_); ++tx) {
+			// タイルの一番奥より奥ならタイル全体で隠れている
+			if (minZ > tileMaxDepth_[ty * tilesX_ + tx]) {
+				continue;
+			}
+			const int32_t px0 = (std::max)(x0, tx * static_cast<int32_t>(kTileWidth_));
+			const int32_t px1 = (std::min)(x1, (tx + 1) * static_cast<int32_t>(kTileWidth_) - 1);
+			const int32_t py0 = (std::max)(y0, ty * static_cast<int32_t>(kTileHeight_));
+			const int32_t py1 = (std::min)(y1, (ty + 1) * static_cast<int32_t>(kTileHeight_) - 1);
+			for (int32_t y = py0; y <= py1; ++y) {
+				const float* row = depth_.data() + static_cast<size_t>(y) * width_;
+				for (int32_t x = px0; x <= px1; ++x) {
+					if (row[x] >= minZ) {
+						return true;
+					}
+				}
+			}
+		}
+	}
+
+	++stats_.occludedBounds;
+	return false;
+}
+
+void OcclusionRasterizer::AddClipTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2)
+{
+	// 全部が同じ面の外側なら描かない
+	if ((v0.x < -v0.w && v1.x < -v1.w && v2.x < -v2.w) ||
+		(v0.x > v0.w && v1.x > v1.w && v2.x > v2.w) ||
+		(v0.y < -v0.w && v1.y < -v1.w && v2.y < -v2.w) ||
+		(v0.y > v0.w && v1.y > v1.w && v2.y > v2.w) ||
+		(v0.z > v0.w && v1.z > v1.w && v2.z > v2.w)) {
+		return;
+	}
+
+	const bool inside0 = v0.z >= 0.0f;
+	const bool inside1 = v1.z >= 0.0f;
+	const bool inside2 = v2.z >= 0.0f;
+	if (inside0 && inside1 && inside2) {
+		SetupTriangle(v0, v1, v2);
+		return;
+	}
+	if (!inside0 && !inside1 && !inside2) {
+		return;
+	}
+
+	// 近面 (z = 0) で切る
+	const ClipVertex input[3] = { v0, v1, v2 };
+	ClipVertex output[4];
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < 3; ++i) {
+		const ClipVertex& p = input[i];
+		const ClipVertex& q = input[(i + 1) % 3];
+		if (p.z >= 0.0f) {
+			output[count++] = p;
+		}
+		if ((p.z >= 0.0f) != (q.z >= 0.0f)) {
+			const float t = p.z / (p.z - q.z);
+			output[count++] = {
+				p.x + (q.x - p.x) * t,
+				p.y + (q.y - p.y) * t,
+				0.0f,
+				p.w + (q.w - p.w) * t,
+			};
+		}
+	}
+	for (uint32_t i = 1; i + 1 < count; ++i) {
+		SetupTriangle(output[0], output[i], output[i + 1]);
+	}
+}
+
+void OcclusionRasterizer::SetupTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2)
+{
+	if (v0.w <= 0.0f || v1.w <= 0.0f || v2.w <= 0.0f) {
+		return;
+	}
+
+	// 画面空間へ (yは下向き)
+	float x[3], y[3], z[3];
+	const ClipVertex* vertices[3] = { &v0, &v1, &v2 };
+	for (uint32_t i = 0; i < 3; ++i) {
+		const float invW = 1.0f / vertices[i]->w;
+		x[i] = (vertices[i]->x * invW * 0.5f + 0.5f) * static_cast<float>(width_);
+		y[i] = (0.5f - vertices[i]->y * invW * 0.5f) * static_cast<float>(height_);
+		z[i] = vertices[i]->z * invW;
+	}
+
+	// 向きはどちらでも描く (裏向きなら入れ替えて辺関数が内側で正になるようにする)
+	float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+	if (area < 0.0f) {
+		std::swap(x[1], x[2]);
+		std::swap(y[1], y[2]);
+		std::swap(z[1], z[2]);
+		area = -area;
+	}
+	if (area <= 1.0e-6f) {
+		return;
+	}
+
+	// 画素の中心が入る範囲
+	const float minXf = (std::min)({ x[0], x[1], x[2] });
+	const float maxXf = (std::max)({ x[0], x[1], x[2] });
+	const float minYf = (std::min)({ y[0], y[1], y[2] });
+	const float maxYf = (std::max)({ y[0], y[1], y[2] });
+	Triangle triangle;
+	triangle.minX = (std::max)(static_cast<int32_t>(std::ceil(minXf - 0.5f)), 0);
+	triangle.minY = (std::max)(static_cast<int32_t>(std::ceil(minYf - 0.5f)), 0);
+	triangle.maxX = (std::min)(static_cast<int32_t>(std::floor(maxXf - 0.5f)), static_cast<int32_t>(width_) - 1);
+	triangle.maxY = (std::min)(static_cast<int32_t>(std::floor(maxYf - 0.5f)), static_cast<int32_t>(height_) - 1);
+	if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) {
+		return;
+	}
+
+	// 辺 a→b : E(p) = A * p.x + B * p.y + C (内側で正)
+	for (uint32_t i = 0; i < 3; ++i) {
+		const uint32_t a = i;
+		const uint32_t b = (i + 1) % 3;
+		triangle.edgeA[i] = y[a] - y[b];
+		triangle.edgeB[i] = x[b] - x[a];
+		triangle.edgeC[i] = -(triangle.edgeA[i] * x[a] + triangle.edgeB[i] * y[a]);
+	}
+
+	// 深度は画面空間で線形
+	triangle.depthA = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+	triangle.depthB = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) / area;
+	triangle.depthC = z[0] - triangle.depthA * x[0] - triangle.depthB * y[0];
+
+	const uint32_t index = static_cast<uint32_t>(triangles_.size());
+	triangles_.push_back(triangle);
+	++stats_.occluderTriangles;
+
+	// 掛かっているタイルに振り分ける
+	for (int32_t ty = triangle.minY / static_cast<int32_t>(kTileHeight_); ty <= triangle.maxY / static_cast<int32_t>(kTileHeight_); ++ty) {
+		for (int32_t tx = triangle.minX / static_cast<int32_t>(kTileWidth_); tx <= triangle.maxX / static_cast<int32_t>(kTileWidth_); ++tx) {
+			bins_[ty * tilesX_ + tx].push_back(index);
+			++stats_.binnedTriangles;
+		}
+	}
+}
+
+void OcclusionRasterizer::RasterizeTile(uint32_t tile)
+{
+	const int32_t tileX0 = static_cast<int32_t>((tile % tilesX_) * kTileWidth_);
+	const int32_t tileY0 = static_cast<int32_t>((tile / tilesX_) * kTileHeight_);
+	const int32_t tileX1 = tileX0 + static_cast<int32_t>(kTileWidth_) - 1;
+	const int32_t tileY1 = tileY0 + static_cast<int32_t>(kTileHeight_) - 1;
+
+	for (uint32_t index : bins_[tile]) {
+		const Triangle& t = triangles_[index];
+		// 4画素ずつ処理するので左端は4の倍数にそろえる (範囲外の画素は辺関数で外れる)
+		const int32_t x0 = (std::max)(t.minX, tileX0) & ~3;
+		const int32_t x1 = (std::min)(t.maxX, tileX1);
+		const int32_t y0 = (std::max)(t.minY, tileY0);
+		const int32_t y1 = (std::min)(t.maxY, tileY1);
+
+		for (int32_t y = y0; y <= y1; ++y) {
+			const float py = static_cast<float>(y) + 0.5f;
+			float* row = depth_.data() + static_cast<size_t>(y) * width_;
+			int32_t x = x0;
+
+#ifdef OCCLUSION_RASTERIZER_SSE
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 offset = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+			__m128 rowEdge[3];
+			__m128 edgeA[3];
+			for (uint32_t e = 0; e < 3; ++e) {
+				rowEdge[e] = _mm_set1_ps(t.edgeB[e] * py + t.edgeC[e]);
+				edgeA[e] = _mm_set1_ps(t.edgeA[e]);
+			}
+			const __m128 rowDepth = _mm_set1_ps(t.depthB * py + t.depthC);
+			const __m128 depthA = _mm_set1_ps(t.depthA);
+
+			for (; x <= x1; x += 4) {
+				const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), offset);
+				__m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA[0], px), rowEdge[0]), zero);
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA[1], px), rowEdge[1]), zero));
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA[2], px), rowEdge[2]), zero));
+				if (_mm_movemask_ps(inside) == 0) {
+					continue;
+				}
+				const __m128 depth = _mm_add_ps(_mm_mul_ps(depthA, px), rowDepth);
+				const __m128 old = _mm_loadu_ps(row + x);
+				const __m128 nearest = _mm_min_ps(old, depth);
+				_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, old)));
+			}
+#endif
+
+			for (; x <= x1; ++x) {
+				const float px = static_cast<float>(x) + 0.5f;
+				if (t.edgeA[0] * px + t.edgeB[0] * py + t.edgeC[0] < 0.0f ||
+					t.edgeA[1] * px + t.edgeB[1] * py + t.edgeC[1] < 0.0f ||
+					t.edgeA[2] * px + t.edgeB[2] * py + t.edgeC[2] < 0.0f) {
+					continue;
+				}
+				const float depth = t.depthA * px + t.depthB * py + t.depthC;
+				row[x] = (std::min)(row[x], depth);
+			}
+		}
+	}
+
+	// タイル内の一番奥
+	float maxDepth = 0.0f;
+	for (int32_t y = tileY0; y <= tileY1; ++y) {
+		const float* row = depth_.data() + static_cast<size_t>(y) * width_;
+		for (int32_t x = tileX0; x <= tileX1; ++x) {
+			maxDepth = (std::max)(maxDepth, row[x]);
+		}
+	}
+	tileMaxDepth_[tile] = maxDepth;
+}
+
+OcclusionRasterizer::ClipVertex OcclusionRasterizer::ToClip(float x, float y, float z, const Matrix4x4& m)
+{
+	return {
+		x * m.m[0][0] + y * m.m[1][0] + z * m.m[2][0] + m.m[3][0],
+		x * m.m[0][1] + y * m.m[1][1] + z * m.m[2][1] + m.m[3][1],
+		x * m.m[0][2] + y * m.m[1][2] + z * m.m[2][2] + m.m[3][2],
+		x * m.m[0][3] + y * m.m[1][3] + z * m.m[2][3] + m.m[3][3],
+	};
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+// C++
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Math
+#include "MathFunc.h"
+#include "Matrix4x4.h"
+
+/// <summary>
+/// ソフトウェアオクルージョンカリング (D3D12には依存しない)
+/// 大きい遮蔽物だけを低解像度の深度バッファにCPUで描き、AABBがその奥に隠れているかを調べる
+/// 三角形はタイルごとに振り分けてタイル単位で並列に描く (各タイルは1つのスレッドしか書かないので結果は毎回同じ)
+/// 深度はD3Dと同じ0～1 (小さいほど手前)、画素の中心で判定する
+/// </summary>
+class OcclusionRasterizer
+{
+public: // 構造体
+
+	// 直近のフレームの結果
+	struct Stats {
+		uint32_t occluderTriangles = 0;		// 近面で切った後の三角形数
+		uint32_t binnedTriangles = 0;		// タイルに振り分けた延べ数
+		uint32_t testedBounds = 0;
+		uint32_t occludedBounds = 0;
+		float rasterizeMicroseconds = 0.0f;
+	};
+
+public: // メンバ関数
+
+	/// <summary>
+	/// 初期化 (幅は kTileWidth_、高さは kTileHeight_ の倍数)
+	/// </summary>
+	void Initialize(uint32_t width = kDefaultWidth_, uint32_t height = kDefaultHeight_);
+
+	/// <summary>
+	/// フレームの開始 (深度を一番奥で埋め、遮蔽物を空にする)
+	/// </summary>
+	void BeginFrame(const Matrix4x4& viewProjection);
+
+	/// <summary>
+	/// 遮蔽物のメッシュを追加 (三角形リスト)
+	/// </summary>
+	/// <param name="positions">先頭頂点の x (x, y, z が並んでいること)</param>
+	/// <param name="stride">頂点1つ分のバイト数</param>
+	void AddOccluder(const float* positions, uint32_t stride, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount, const Matrix4x4& world);
+
+	/// <summary>
+	/// 箱の遮蔽物を追加 (マップチップのブロックなど)
+	/// </summary>
+	void AddOccluderBox(const AABB& local, const Matrix4x4& world);
+
+	/// <summary>
+	/// 追加した遮蔽物を深度バッファに描く (ここから IsVisible が使える)
+	/// </summary>
+	void Rasterize();
+
+	/// <summary>
+	/// 描いた結果を使わないようにする (遮蔽物を描かないシーンなど)
+	/// </summary>
+	void Reset() { isReady_ = false; }
+
+	/// <summary>
+	/// ワールド空間のAABBが遮蔽物に隠れていなければtrue
+	/// 近面をまたぐものや画面外のものは隠れていない扱い
+	/// </summary>
+	bool IsVisible(const AABB& bounds);
+
+	/*===============================================//
+						アクセッサ
+	//===============================================*/
+
+	bool IsReady() const { return isReady_; }
+	const Matrix4x4& GetViewProjection() const { return viewProjection_; }
+	uint32_t GetWidth() const { return width_; }
+	uint32_t GetHeight() const { return height_; }
+	// 行ごとに並んだ深度 (確認用)
+	const std::vector<float>& GetDepthBuffer() const { return depth_; }
+	const Stats& GetStats() const { return stats_; }
+
+public:
+	static const uint32_t kTileWidth_ = 32;
+	static const uint32_t kTileHeight_ = 16;
+	static const uint32_t kDefaultWidth_ = 256;
+	static const uint32_t kDefaultHeight_ = 144;
+
+private:
+
+	// 画面空間で準備した三角形 (辺関数と深度の平面、画素の範囲)
+	struct Triangle {
+		float edgeA[3];
+		float edgeB[3];
+		float edgeC[3];
+		float depthA;
+		float depthB;
+		float depthC;
+		int32_t minX, minY, maxX, maxY;
+	};
+
+	// クリップ空間の頂点
+	struct ClipVertex {
+		float x, y, z, w;
+	};
+
+	/// <summary>
+	/// クリップ空間の三角形を近面で切って、画面空間で準備してタイルに振り分ける
+	/// </summary>
+	void AddClipTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2);
+
+	/// <summary>
+	/// 画面空間の三角形を準備してタイルに振り分ける
+	/// </summary>
+	void SetupTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2);
+
+	/// <summary>
+	/// タイル1つ分を描く
+	/// </summary>
+	void RasterizeTile(uint32_t tile);
+
+	static ClipVertex ToClip(float x, float y, float z, const Matrix4x4& m);
+
+private: // メンバ変数
+
+	uint32_t width_ = 0;
+	uint32_t height_ = 0;
+	uint32_t tilesX_ = 0;
+	uint32_t tilesY_ = 0;
+
+	Matrix4x4 viewProjection_{};
+	bool isReady_ = false;
+
+	std::vector<float> depth_;
+	// タイル内の一番奥の深度 (これより奥のものはタイル全体で隠れている)
+	std::vector<float> tileMaxDepth_;
+
+	std::vector<ClipVertex> clipVertices_;
+	std::vector<Triangle> triangles_;
+	// タイルごとの三角形の番号 (追加した順)
+	std::vector<std::vector<uint32_t>> bins_;
+	std::vector<uint32_t> tileIndices_;
+
+	Stats stats_;
+};
@@ -2,6 +2,7 @@
 #include "DX./DirectXCommon.h"
 #include "LineManager.h"
 #include "Systems./Camera/Camera.h"
+#include "FrameAllocator/FrameUploadRing.h"
 
 // Math
 #include "MathFunc.h"
@@ -15,12 +16,11 @@ void Line::Initialize()
 	lineManager_ = LineManager::GetInstance();
 	dxCommon_ = DirectXCommon::GetInstance();
 
-	CrateMaterialResource();
+	materialData_.color = { 1.0f, 1.0f, 1.0f, 1.0f };
+	transformationMatrix_.WVP = MakeIdentity4x4();
 
 	CrateVetexResource();
 
-	CreateTransformResource();
-
 }
 
 void Line::DrawLine()
@@ -32,10 +32,10 @@ void Line::DrawLine()
 
 	// WVP行列を更新
 	if (camera_) {
-		transformationMatrix_->WVP = camera_->GetViewProjectionMatrix();
+		transformationMatrix_.WVP = camera_->GetViewProjectionMatrix();
 	}
 	else {
-		transformationMatrix_->WVP = MakeIdentity4x4();
+		transformationMatrix_.WVP = MakeIdentity4x4();
 	}
 
 	// GPUに頂点バッファを設定して描画
@@ -43,8 +43,8 @@ void Line::DrawLine()
 	commandList->SetGraphicsRootSignature(lineManager_->GetRootSignature().Get());
 	commandList->SetPipelineState(lineManager_->GetGraphicsPiplineState().Get());
 	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
-	commandList->SetGraphicsRootConstantBufferView(0, materialResource_->GetGPUVirtualAddress());
-	commandList->SetGraphicsRootConstantBufferView(1, transformationResource_->GetGPUVirtualAddress());
+	commandList->SetGraphicsRootConstantBufferView(0, FrameUploadRing::GetInstance()->Push(materialData_));
+	commandList->SetGraphicsRootConstantBufferView(1, FrameUploadRing::GetInstance()->Push(transformationMatrix_));
 	commandList->IASetVertexBuffers(0, 1, &vertexBufferView_);
 	commandList->DrawInstanced(index, index / 2, 0, 0); // ラインは2つの頂点で構成
 	
@@ -172,20 +172,3 @@ void Line::CrateVetexResource()
 	vertexBufferView_.StrideInBytes = sizeof(VertexData);
 	vertexResource_->Map(0, nullptr, reinterpret_cast<void**>(&vertexData_));
 }
-
-void Line::CrateMaterialResource()
-{
-
-	materialResource_ = dxCommon_->CreateBufferResource(sizeof(Vector4));
-	materialResource_->Map(0, nullptr, reinterpret_cast<void**>(&materialData_));
-	materialData_->color = { 1.0f, 1.0f, 1.0f, 1.0f };
-}
-
-void Line::CreateTransformResource()
-{
-	// WVP行列リソースを作成
-	
-	transformationResource_ = dxCommon_->CreateBufferResource(sizeof(Matrix4x4));
-	transformationResource_->Map(0, nullptr, reinterpret_cast<void**>(&transformationMatrix_));
-	transformationMatrix_->WVP = MakeIdentity4x4();
-}
@@ -46,15 +46,6 @@ private:
 	/// </summary>
 	void CrateVetexResource();
 
-	/// <summary>
-	/// 頂点リソース
-	/// </summary>
-	void CrateMaterialResource();
-
-	/// <summary>
-	/// 座標変換リソース
-	/// </summary>
-	void CreateTransformResource();
 
 public:
 
@@ -84,13 +75,9 @@ private:
 	D3D12_VERTEX_BUFFER_VIEW  vertexBufferView_ = {};
 	VertexData* vertexData_ = nullptr;
 
-	// マテリアル関連
-	Microsoft::WRL::ComPtr<ID3D12Resource> materialResource_;
-	MaterialData* materialData_ = nullptr;
-
-	// 座標関連
-	Microsoft::WRL::ComPtr<ID3D12Resource> transformationResource_;
-	TransformationMatrix* transformationMatrix_ = nullptr;
+	// マテリアル・座標 (GPUへは描画時にアップロードリング経由で渡す)
+	MaterialData materialData_{};
+	TransformationMatrix transformationMatrix_{};
 
 	const uint32_t kMaxNum = 4096u * 4u;
 	uint32_t index = 0u;
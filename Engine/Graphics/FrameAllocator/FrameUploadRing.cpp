@@ -0,0 +1,53 @@
+#include "FrameUploadRing.h"
+#include "DX./DirectXCommon.h"
+
+// C++
+#include <cassert>
+
+FrameUploadRing* FrameUploadRing::instance = nullptr;
+const uint32_t FrameUploadRing::kPageSize_ = 2 * 1024 * 1024;
+const uint32_t FrameUploadRing::kFrameCount_ = 2;
+
+FrameUploadRing* FrameUploadRing::GetInstance()
+{
+	if (instance == nullptr) {
+		instance = new FrameUploadRing;
+	}
+	return instance;
+}
+
+void FrameUploadRing::Finalize()
+{
+	delete instance;
+	instance = nullptr;
+}
+
+void FrameUploadRing::Initialize(DirectXCommon* dxCommon)
+{
+	dxCommon_ = dxCommon;
+	// 定数バッファは256バイト境界で置く必要がある
+	allocator_.Initialize(kPageSize_, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT, kFrameCount_);
+	pages_.clear();
+}
+
+void FrameUploadRing::BeginFrame()
+{
+	allocator_.BeginFrame();
+}
+
+FrameUploadRing::Block FrameUploadRing::Allocate(uint32_t size)
+{
+	LinearPageAllocator::Allocation allocation = allocator_.Allocate(size);
+
+	// 足りなくなった時だけページを作る (以後はずっとマップしたまま使い回す)
+	while (allocation.page >= pages_.size()) {
+		Page& page = pages_.emplace_back();
+		page.resource = dxCommon_->CreateBufferResource(kPageSize_);
+		HRESULT hr = page.resource->Map(0, nullptr, reinterpret_cast<void**>(&page.cpu));
+		assert(SUCCEEDED(hr));
+		page.gpu = page.resource->GetGPUVirtualAddress();
+	}
+
+	const Page& page = pages_[allocation.page];
+	return { page.cpu + allocation.offset, page.gpu + allocation.offset };
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <wrl.h>
+#include <d3d12.h>
+
+// Engine
+#include "LinearPageAllocator.h"
+
+class DirectXCommon;
+
+/// <summary>
+/// 定数バッファ用のフレーム単位アップロードリング
+/// 大きいアップロードヒープのページをマップしたまま持ち、描画ごとに256バイト境界で切り出して書き込む
+/// 書き込んだ内容はそのフレームの描画でのみ有効 (ページは数フレーム後に再利用される)
+/// </summary>
+class FrameUploadRing
+{
+public: // 構造体
+
+	// 切り出した領域
+	struct Block {
+		void* cpu;							// 書き込み先
+		D3D12_GPU_VIRTUAL_ADDRESS gpu;		// ルートCBVに渡すアドレス
+	};
+
+public: // メンバ関数
+
+	// シングルトンインスタンスの取得
+	static FrameUploadRing* GetInstance();
+	// 終了
+	void Finalize();
+	FrameUploadRing() = default;
+	~FrameUploadRing() = default;
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	void Initialize(DirectXCommon* dxCommon);
+
+	/// <summary>
+	/// フレームの開始 (描画コマンドを積む前に1回呼ぶ)
+	/// </summary>
+	void BeginFrame();
+
+	/// <summary>
+	/// 領域の切り出し
+	/// </summary>
+	Block Allocate(uint32_t size);
+
+	/// <summary>
+	/// データを書き込んでGPUアドレスを返す
+	/// </summary>
+	template<class T>
+	D3D12_GPU_VIRTUAL_ADDRESS Push(const T& data) {
+		Block block = Allocate(static_cast<uint32_t>(sizeof(T)));
+		std::memcpy(block.cpu, &data, sizeof(T));
+		return block.gpu;
+	}
+
+	/// <summary>
+	/// 割り当て状況の取得
+	/// </summary>
+	const LinearPageAllocator& GetAllocator() const { return allocator_; }
+
+public:
+	// 1ページのサイズ
+	static const uint32_t kPageSize_;
+	// GPUが同時に扱うフレーム数
+	static const uint32_t kFrameCount_;
+
+private:
+	static FrameUploadRing* instance;
+	FrameUploadRing(FrameUploadRing&) = delete;
+	FrameUploadRing& operator = (FrameUploadRing&) = delete;
+
+	// アップロードヒープのページ
+	struct Page {
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+		uint8_t* cpu = nullptr;
+		D3D12_GPU_VIRTUAL_ADDRESS gpu = 0;
+	};
+
+	DirectXCommon* dxCommon_ = nullptr;
+	LinearPageAllocator allocator_;
+	std::vector<Page> pages_;
+};
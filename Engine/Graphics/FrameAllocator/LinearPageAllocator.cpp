@@ -0,0 +1,67 @@
+#include "LinearPageAllocator.h"
+
+// C++
+#include <cassert>
+
+void LinearPageAllocator::Initialize(uint32_t pageSize, uint32_t alignment, uint32_t frameCount)
+{
+	assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+	assert(pageSize >= alignment && pageSize % alignment == 0);
+	assert(frameCount > 0);
+
+	pageSize_ = pageSize;
+	alignment_ = alignment;
+	frameCount_ = frameCount;
+	frameIndex_ = 0;
+
+	pageCount_ = 0;
+	freePages_.clear();
+	usedPages_.assign(frameCount_, {});
+
+	currentPage_ = UINT32_MAX;
+	currentOffset_ = 0;
+	frameBytes_ = 0;
+	frameAllocations_ = 0;
+}
+
+void LinearPageAllocator::BeginFrame()
+{
+	frameIndex_ = (frameIndex_ + 1) % frameCount_;
+
+	// この枠を前に使ったフレームはGPUが使い終わっているのでページを戻す
+	for (uint32_t page : usedPages_[frameIndex_]) {
+		freePages_.push_back(page);
+	}
+	usedPages_[frameIndex_].clear();
+
+	// 前フレームのページの残りは使わない (そのフレームと一緒に回収される)
+	currentPage_ = UINT32_MAX;
+	currentOffset_ = 0;
+	frameBytes_ = 0;
+	frameAllocations_ = 0;
+}
+
+LinearPageAllocator::Allocation LinearPageAllocator::Allocate(uint32_t size)
+{
+	assert(size > 0 && size <= pageSize_);
+
+	const uint32_t alignedSize = (size + alignment_ - 1) & ~(alignment_ - 1);
+
+	// 今のページに入らなければ次のページへ
+	if (currentPage_ == UINT32_MAX || currentOffset_ + alignedSize > pageSize_) {
+		if (!freePages_.empty()) {
+			currentPage_ = freePages_.back();
+			freePages_.pop_back();
+		} else {
+			currentPage_ = pageCount_++;
+		}
+		currentOffset_ = 0;
+		usedPages_[frameIndex_].push_back(currentPage_);
+	}
+
+	Allocation allocation = { currentPage_, currentOffset_ };
+	currentOffset_ += alignedSize;
+	frameBytes_ += alignedSize;
+	++frameAllocations_;
+	return allocation;
+}
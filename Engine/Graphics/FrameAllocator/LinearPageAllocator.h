@@ -0,0 +1,76 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// フレーム単位の線形アロケータ (D3D12には依存しない)
+/// 固定サイズのページを先頭から詰めて使い、ページは frameCount フレーム後に丸ごと再利用する
+/// 実際のメモリ (アップロードヒープ等) はページ番号に対応させて呼び出し側が持つ
+/// </summary>
+class LinearPageAllocator
+{
+public: // 構造体
+
+	// 割り当て結果
+	struct Allocation {
+		uint32_t page;		// ページ番号 (呼び出し側が持つページ数以上なら、そこでページを追加する)
+		uint32_t offset;	// ページ先頭からのオフセット
+	};
+
+public: // メンバ関数
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="pageSize">1ページのサイズ</param>
+	/// <param name="alignment">割り当ての境界 (2のべき乗)</param>
+	/// <param name="frameCount">GPUが同時に扱うフレーム数</param>
+	void Initialize(uint32_t pageSize, uint32_t alignment, uint32_t frameCount);
+
+	/// <summary>
+	/// フレームの開始 (frameCount フレーム前に使ったページを空きに戻す)
+	/// </summary>
+	void BeginFrame();
+
+	/// <summary>
+	/// 割り当て (size はページサイズ以下)
+	/// </summary>
+	Allocation Allocate(uint32_t size);
+
+	/*===============================================//
+						情報
+	//===============================================*/
+
+	uint32_t GetPageSize() const { return pageSize_; }
+	uint32_t GetAlignment() const { return alignment_; }
+	// これまでに作られたページ数
+	uint32_t GetPageCount() const { return pageCount_; }
+	// 今フレームで使ったバイト数 (境界合わせ込み)
+	uint64_t GetFrameBytes() const { return frameBytes_; }
+	// 今フレームの割り当て回数
+	uint32_t GetFrameAllocationCount() const { return frameAllocations_; }
+
+private: // メンバ変数
+
+	uint32_t pageSize_ = 0;
+	uint32_t alignment_ = 256;
+	uint32_t frameCount_ = 1;
+	uint32_t frameIndex_ = 0;
+
+	// 作成済みページ数
+	uint32_t pageCount_ = 0;
+	// 空きページ
+	std::vector<uint32_t> freePages_;
+	// フレームごとに使ったページ
+	std::vector<std::vector<uint32_t>> usedPages_;
+
+	// 使用中のページと書き込み位置
+	uint32_t currentPage_ = UINT32_MAX;
+	uint32_t currentOffset_ = 0;
+
+	// 計測
+	uint64_t frameBytes_ = 0;
+	uint32_t frameAllocations_ = 0;
+};
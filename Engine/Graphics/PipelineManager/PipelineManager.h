@@ -54,11 +54,21 @@ private:
 	/// </summary>
 	void CreatePSO_Sprite();
 
+	/// <summary>
+	/// スプライトまとめ描画用パイプライン
+	/// </summary>
+	void CreatePSO_SpriteBatch();
+
 	/// <summary>
 	/// オブジェクト用のパイプライン
 	/// </summary>
 	void CreatePSO_Object();
 
+	/// <summary>
+	/// インスタンシング描画用のオブジェクトパイプライン (圧縮頂点用の ObjectInstancePacked も作る)
+	/// </summary>
+	void CreatePSO_ObjectInstance();
+
 	/// <summary>
 	/// ライン用のパイプライン
 	/// </summary>
@@ -0,0 +1,217 @@
+#include "RenderQueue.h"
+
+// C++
+#include <algorithm>
+
+namespace RenderKey {
+
+	uint32_t QuantizeDepth(float viewDepth, float nearZ, float farZ)
+	{
+		if (farZ <= nearZ) {
+			return 0;
+		}
+		float t = (viewDepth - nearZ) / (farZ - nearZ);
+		t = std::clamp(t, 0.0f, 1.0f);
+		return static_cast<uint32_t>(t * static_cast<float>(kDepthMax));
+	}
+
+	uint64_t Make(RenderPass pass, uint32_t pipeline, uint32_t material, uint32_t texture, uint32_t batch, uint32_t depth)
+	{
+		const uint64_t p = static_cast<uint64_t>(pass) & ((1ull << kPassBits) - 1);
+		const uint64_t pl = pipeline & ((1ull << kPipelineBits) - 1);
+		const uint64_t m = material & ((1ull << kMaterialBits) - 1);
+		const uint64_t t = texture & ((1ull << kTextureBits) - 1);
+		const uint64_t b = batch & ((1ull << kBatchBits) - 1);
+		const uint64_t d = std::min(depth, kDepthMax);
+
+		uint64_t key = p << (64 - kPassBits);
+		if (pass == RenderPass::Transparent) {
+			// 奥のものから描くので深度を反転して状態より上に置く
+			key |= static_cast<uint64_t>(kDepthMax - d) << (kPipelineBits + kMaterialBits + kTextureBits);
+			key |= pl << (kMaterialBits + kTextureBits);
+			key |= m << kTextureBits;
+			key |= t;
+		} else {
+			// 同じ状態の中では batch ごとに固め、その中で手前から
+			key |= pl << (kMaterialBits + kTextureBits + kBatchBits + kOpaqueDepthBits);
+			key |= m << (kTextureBits + kBatchBits + kOpaqueDepthBits);
+			key |= t << (kBatchBits + kOpaqueDepthBits);
+			key |= b << kOpaqueDepthBits;
+			key |= d >> (kDepthBits - kOpaqueDepthBits);
+		}
+		return key;
+	}
+}
+
+void RenderQueue::Reserve(size_t count)
+{
+	packets_.reserve(count);
+	scratch_.reserve(count);
+	batches_.reserve(count);
+}
+
+void RenderQueue::RemoveCulled(const std::vector<uint8_t>& visibleItems)
+{
+	auto end = std::remove_if(packets_.begin(), packets_.end(), [&](const DrawPacket& packet) {
+		return packet.item < visibleItems.size() && !visibleItems[packet.item];
+		});
+	packets_.erase(end, packets_.end());
+	batches_.clear();
+}
+
+void RenderQueue::Sort()
+{
+	const size_t count = packets_.size();
+	if (count < 2) {
+		return;
+	}
+	scratch_.resize(count);
+
+	// 8桁分の個数を1回の走査でまとめて数える
+	static constexpr uint32_t kDigits = 8;
+	uint32_t counts[kDigits][256] = {};
+	for (const DrawPacket& packet : packets_) {
+		uint64_t key = packet.key;
+		for (uint32_t d = 0; d < kDigits; ++d) {
+			++counts[d][(key >> (d * 8)) & 0xFF];
+		}
+	}
+
+	DrawPacket* src = packets_.data();
+	DrawPacket* dst = scratch_.data();
+
+	for (uint32_t d = 0; d < kDigits; ++d) {
+		const uint32_t shift = d * 8;
+		// 全部同じ値の桁は並びが変わらないので飛ばす
+		if (counts[d][(src[0].key >> shift) & 0xFF] == count) {
+			continue;
+		}
+
+		uint32_t offset = 0;
+		for (uint32_t& c : counts[d]) {
+			uint32_t n = c;
+			c = offset;
+			offset += n;
+		}
+		for (size_t i = 0; i < count; ++i) {
+			dst[counts[d][(src[i].key >> shift) & 0xFF]++] = src[i];
+		}
+		std::swap(src, dst);
+	}
+
+	// 結果が作業領域側に残っていたら入れ替える
+	if (src != packets_.data()) {
+		packets_.swap(scratch_);
+	}
+	if (overflowCount_ > 0) {
+		SortByIds();
+	}
+	batches_.clear();
+}
+
+void RenderQueue::SortByIds()
+{
+	using namespace RenderKey;
+	constexpr uint64_t kOpaqueDepthMask = (1ull << kOpaqueDepthBits) - 1;
+	constexpr uint32_t kTransparentDepthShift = kPipelineBits + kMaterialBits + kTextureBits;
+
+	// 基数ソートで大まかに並んでいるので、安定ソートでずれた分だけ直す
+	std::stable_sort(packets_.begin(), packets_.end(), [](const DrawPacket& a, const DrawPacket& b) {
+		const RenderPass pass = GetPass(a.key);
+		if (pass != GetPass(b.key)) {
+			return pass < GetPass(b.key);
+		}
+		if (pass == RenderPass::Transparent) {
+			const uint64_t depthA = (a.key >> kTransparentDepthShift) & kDepthMax;
+			const uint64_t depthB = (b.key >> kTransparentDepthShift) & kDepthMax;
+			if (depthA != depthB) { return depthA < depthB; }
+		}
+		if (a.pipeline != b.pipeline) { return a.pipeline < b.pipeline; }
+		if (a.material != b.material) { return a.material < b.material; }
+		if (a.texture != b.texture) { return a.texture < b.texture; }
+		if (pass == RenderPass::Transparent) {
+			return false;
+		}
+		// まとめない描画 (kNoBatch) はキーと同じく最後
+		if (a.batch != b.batch) { return a.batch < b.batch; }
+		return (a.key & kOpaqueDepthMask) < (b.key & kOpaqueDepthMask);
+		});
+}
+
+void RenderQueue::BuildBatches(uint32_t maxBatchSize)
+{
+	batches_.clear();
+	if (maxBatchSize == 0) {
+		maxBatchSize = 1;
+	}
+
+	const uint32_t count = static_cast<uint32_t>(packets_.size());
+	uint32_t i = 0;
+	while (i < count) {
+		const DrawPacket& head = packets_[i];
+		uint32_t end = i + 1;
+		if (head.batch != DrawPacket::kNoBatch) {
+			while (end < count && end - i < maxBatchSize) {
+				const DrawPacket& packet = packets_[end];
+				if (packet.batch != head.batch || packet.pipeline != head.pipeline ||
+					packet.material != head.material || packet.texture != head.texture) {
+					break;
+				}
+				++end;
+			}
+		}
+		batches_.push_back({ i, end - i });
+		i = end;
+	}
+}
+
+void RenderQueue::Execute(RenderCommandSink& sink)
+{
+	if (batches_.empty() && !packets_.empty()) {
+		BuildBatches(1);
+	}
+
+	stats_ = {};
+	stats_.packets = static_cast<uint32_t>(packets_.size());
+	stats_.keyOverflows = overflowCount_;
+
+	bool hasPipeline = false;
+	bool hasMaterial = false;
+	bool hasTexture = false;
+	uint32_t pipeline = 0;
+	uint32_t material = 0;
+	uint32_t texture = 0;
+
+	for (uint32_t batchIndex = 0; batchIndex < batches_.size(); ++batchIndex) {
+		const RenderBatch& batch = batches_[batchIndex];
+		const DrawPacket& packet = packets_[batch.first];
+		if (!hasPipeline || packet.pipeline != pipeline) {
+			sink.SetPipeline(packet.pipeline);
+			pipeline = packet.pipeline;
+			hasPipeline = true;
+			// パイプラインが変わるとルートの設定は引き継がれない
+			hasMaterial = false;
+			hasTexture = false;
+			++stats_.pipelineSets;
+		}
+		if (!hasMaterial || packet.material != material) {
+			sink.SetMaterial(packet.material);
+			material = packet.material;
+			hasMaterial = true;
+			++stats_.materialSets;
+		}
+		if (!hasTexture || packet.texture != texture) {
+			sink.SetTexture(packet.texture);
+			texture = packet.texture;
+			hasTexture = true;
+			++stats_.textureSets;
+		}
+		sink.Draw(batchIndex, &packet, batch.count);
+		++stats_.drawCalls;
+		if (batch.count > 1) {
+			stats_.batchedPackets += batch.count;
+		}
+	}
+
+	stats_.skippedSets = stats_.packets * 3 - (stats_.pipelineSets + stats_.materialSets + stats_.textureSets);
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+// C++
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 描画パス (ソートキーの最上位。小さいものから描画する)
+/// </summary>
+enum class RenderPass : uint32_t {
+	Opaque = 0,			// 不透明 (状態でまとめて手前から奥へ)
+	Transparent = 1,	// 半透明 (奥から手前へ)
+};
+
+/// <summary>
+/// 64bitソートキー
+/// 不透明 : pass 4 | pipeline 8 | material 12 | texture 16 | batch 8 | depth 16
+/// 半透明 : pass 4 | 反転depth 24 | pipeline 8 | material 12 | texture 16
+/// (各IDはビット幅で切り詰めるので、キーは並び順にだけ使い状態の比較には元のIDを使う。
+///  収まらないIDがあったフレームは、並べ替えの後に元のIDで並べ直す)
+/// </summary>
+namespace RenderKey {
+	constexpr uint32_t kPassBits = 4;
+	constexpr uint32_t kPipelineBits = 8;
+	constexpr uint32_t kMaterialBits = 12;
+	constexpr uint32_t kTextureBits = 16;
+	constexpr uint32_t kBatchBits = 8;
+	constexpr uint32_t kDepthBits = 24;
+	// 不透明ではまとめ描画の番号を入れる分、深度を上位16bitだけ使う
+	constexpr uint32_t kOpaqueDepthBits = 16;
+	constexpr uint32_t kDepthMax = (1u << kDepthBits) - 1;
+
+	/// <summary>
+	/// ビュー空間の深度を [near, far] で kDepthBits に量子化
+	/// </summary>
+	uint32_t QuantizeDepth(float viewDepth, float nearZ, float farZ);
+
+	/// <summary>
+	/// キーの生成 (パスに応じて並びを切り替える)
+	/// </summary>
+	uint64_t Make(RenderPass pass, uint32_t pipeline, uint32_t material, uint32_t texture, uint32_t batch, uint32_t depth);
+
+	/// <summary>
+	/// パスの取り出し
+	/// </summary>
+	inline RenderPass GetPass(uint64_t key) { return static_cast<RenderPass>(key >> (64 - kPassBits)); }
+
+	/// <summary>
+	/// 各IDがキーのビット幅に収まるか
+	/// まとめない描画の batch (UINT32_MAX) はフィールドの最大値に入るので、まとめ描画の番号はそれ未満
+	/// テクスチャはハンドルの下位 (添字) だけが入り、生きているハンドルの添字は重ならないので見ない
+	/// </summary>
+	inline bool Fits(RenderPass pass, uint32_t pipeline, uint32_t material, uint32_t batch) {
+		constexpr uint32_t kBatchMax = (1u << kBatchBits) - 1;
+		const bool batchFits = pass == RenderPass::Transparent || batch == UINT32_MAX || batch < kBatchMax;
+		return pipeline < (1u << kPipelineBits) && material < (1u << kMaterialBits) && batchFits;
+	}
+}
+
+/// <summary>
+/// 描画パケット (描画1回分)
+/// </summary>
+struct DrawPacket {
+	uint64_t key;			// ソートキー
+	uint32_t pipeline;		// パイプラインID
+	uint32_t material;		// マテリアルID
+	uint32_t texture;		// テクスチャID
+	uint32_t batch;			// まとめ描画の番号 (同じ状態で同じ番号のものは1回のインスタンシング描画にまとめる)
+	uint32_t item;			// 呼び出し側の描画データの番号
+
+	// まとめない
+	static constexpr uint32_t kNoBatch = UINT32_MAX;
+};
+
+/// <summary>
+/// 1回のドローコールで描くパケットの範囲
+/// </summary>
+struct RenderBatch {
+	uint32_t first;		// 並べ替え後の先頭パケット
+	uint32_t count;		// パケット数 (インスタンス数)
+};
+
+/// <summary>
+/// 描画キューの出力先 (D3D12のコマンドリストや、検証用の記録など)
+/// </summary>
+class RenderCommandSink
+{
+public:
+	virtual ~RenderCommandSink() = default;
+	// パイプラインの切り替え (ルートの設定はここで全て無効になる前提)
+	virtual void SetPipeline(uint32_t pipeline) = 0;
+	virtual void SetMaterial(uint32_t material) = 0;
+	virtual void SetTexture(uint32_t texture) = 0;
+	// packets は同じ状態・同じ batch の count 個 (batch が kNoBatch なら1個)
+	virtual void Draw(uint32_t batchIndex, const DrawPacket* packets, uint32_t count) = 0;
+};
+
+/// <summary>
+/// 描画キュー (D3D12には依存しない)
+/// パケットを積んでキーで基数ソートし、同じ batch の連続したパケットを1回の描画にまとめ、
+/// 前と同じ状態の設定を飛ばしながら出力先へ流す
+/// </summary>
+class RenderQueue
+{
+public: // 構造体
+
+	// 直近の実行結果
+	struct Stats {
+		uint32_t packets = 0;
+		uint32_t pipelineSets = 0;
+		uint32_t materialSets = 0;
+		uint32_t textureSets = 0;
+		// 毎回設定していた場合と比べて省いた回数
+		uint32_t skippedSets = 0;
+		// ドローコール数 (まとめた後)
+		uint32_t drawCalls = 0;
+		// インスタンシングにまとめられたパケット数
+		uint32_t batchedPackets = 0;
+		// キーに収まらないIDを持っていたパケット数 (0でなければ元のIDで並べ直している)
+		uint32_t keyOverflows = 0;
+	};
+
+public: // メンバ関数
+
+	/// <summary>
+	/// 容量の確保
+	/// </summary>
+	void Reserve(size_t count);
+
+	/// <summary>
+	/// パケットを積む
+	/// </summary>
+	void Submit(const DrawPacket& packet) {
+		if (!RenderKey::Fits(RenderKey::GetPass(packet.key), packet.pipeline, packet.material, packet.batch)) {
+			++overflowCount_;
+		}
+		packets_.push_back(packet);
+		batches_.clear();
+	}
+
+	/// <summary>
+	/// 見えない item のパケットを取り除く (残りの順番は変わらない)
+	/// </summary>
+	/// <param name="visibleItems">item 番号ごとの可視フラグ (0なら取り除く)</param>
+	void RemoveCulled(const std::vector<uint8_t>& visibleItems);
+
+	/// <summary>
+	/// キーで並べ替え (8bitずつの安定した基数ソート。キーが同じなら積んだ順)
+	/// キーに収まらないIDがあれば、切り詰めで混ざった並びを元のIDで並べ直す
+	/// </summary>
+	void Sort();
+
+	/// <summary>
+	/// 並べ替え後のパケットから、同じ状態・同じ batch の連続したものをまとめる
+	/// </summary>
+	/// <param name="maxBatchSize">1回の描画にまとめる最大数</param>
+	void BuildBatches(uint32_t maxBatchSize);
+
+	/// <summary>
+	/// 出力先へ流す (並べ替えは行わない。BuildBatches をしていなければ1つずつ描画する)
+	/// </summary>
+	void Execute(RenderCommandSink& sink);
+
+	/// <summary>
+	/// 空にする
+	/// </summary>
+	void Clear() { packets_.clear(); batches_.clear(); overflowCount_ = 0; }
+
+	/*===============================================//
+						アクセッサ
+	//===============================================*/
+
+	size_t GetSize() const { return packets_.size(); }
+	const std::vector<DrawPacket>& GetPackets() const { return packets_; }
+	const std::vector<RenderBatch>& GetBatches() const { return batches_; }
+	const Stats& GetStats() const { return stats_; }
+
+private: // 内部処理
+
+	/// <summary>
+	/// キーと同じ優先順で、切り詰める前のIDを比べて並べ直す (キーの並びが同じなら順番は変わらない)
+	/// </summary>
+	void SortByIds();
+
+private: // メンバ変数
+
+	std::vector<DrawPacket> packets_;
+	// ソート用の作業領域
+	std::vector<DrawPacket> scratch_;
+	std::vector<RenderBatch> batches_;
+	Stats stats_;
+	// キーに収まらないIDを持つパケット数
+	uint32_t overflowCount_ = 0;
+};
@@ -0,0 +1,343 @@
+#include "RenderQueueManager.h"
+#include "DX./DirectXCommon.h"
+#include "PipelineManager/PipelineManager.h"
+#include "LightManager/LightManager.h"
+#include "FrameAllocator/FrameUploadRing.h"
+#include "Loaders./Texture./TextureManager.h"
+#include "Loaders/Model/Model.h"
+
+// C++
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <execution>
+
+// Math
+#include "MathFunc.h"
+
+// シングルトンインスタンスの初期化
+std::unique_ptr<RenderQueueManager> RenderQueueManager::instance = nullptr;
+std::once_flag RenderQueueManager::initInstanceFlag;
+const uint32_t RenderQueueManager::kMaxBatchSize_ = 1024;
+
+namespace {
+	// FNV-1a
+	uint64_t HashBytes(const void* data, uint32_t size)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		uint64_t hash = 14695981039346656037ull;
+		for (uint32_t i = 0; i < size; ++i) {
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+		return hash ^ size;
+	}
+}
+
+/// <summary>
+/// シングルトンインスタンスの取得
+/// </summary>
+RenderQueueManager* RenderQueueManager::GetInstance()
+{
+	std::call_once(initInstanceFlag, []() {
+		instance.reset(new RenderQueueManager());
+		});
+	return instance.get();
+}
+
+void RenderQueueManager::Finalize()
+{
+	instance.reset();
+}
+
+void RenderQueueManager::Initialize(DirectXCommon* dxCommon)
+{
+	dxCommon_ = dxCommon;
+
+	queue_.Reserve(4096);
+	items_.reserve(4096);
+	pipelines_.clear();
+	pipelineIds_.clear();
+	occlusion_.Initialize();
+	BeginFrame();
+}
+
+void RenderQueueManager::BeginFrame()
+{
+	constants_.clear();
+	constantBytes_.clear();
+	constantIds_.clear();
+	batchIds_.clear();
+	frustumMatrices_.clear();
+	cullers_.clear();
+	cullerItems_.clear();
+	// 今フレームの遮蔽物が描かれるまでは使わない
+	occlusion_.Reset();
+}
+
+uint32_t RenderQueueManager::RegisterPipeline(const std::string& name)
+{
+	auto it = pipelineIds_.find(name);
+	if (it != pipelineIds_.end()) {
+		return it->second;
+	}
+
+	Pipeline pipeline;
+	pipeline.rootSignature = PipelineManager::GetInstance()->GetRootSignature(name);
+	pipeline.pipelineState = PipelineManager::GetInstance()->GetPipeLineStateObject(name);
+	assert(pipeline.rootSignature && pipeline.pipelineState);
+
+	uint32_t id = static_cast<uint32_t>(pipelines_.size());
+	pipelines_.push_back(pipeline);
+	pipelineIds_[name] = id;
+	return id;
+}
+
+uint32_t RenderQueueManager::UploadConstants(const void* data, uint32_t size)
+{
+	// 同じ内容がもうあればそれを使う
+	const uint64_t hash = HashBytes(data, size);
+	auto it = constantIds_.find(hash);
+	if (it != constantIds_.end()) {
+		const Constant& constant = constants_[it->second];
+		if (constant.size == size && std::memcmp(constantBytes_.data() + constant.offset, data, size) == 0) {
+			return it->second;
+		}
+	}
+
+	Constant constant;
+	constant.offset = static_cast<uint32_t>(constantBytes_.size());
+	constant.size = size;
+
+	// アップロード先とは別に比較用の控えを持つ (アップロードヒープは読むと遅い)
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	constantBytes_.insert(constantBytes_.end(), bytes, bytes + size);
+
+	FrameUploadRing::Block block = FrameUploadRing::GetInstance()->Allocate(size);
+	std::memcpy(block.cpu, data, size);
+	constant.address = block.gpu;
+
+	uint32_t id = static_cast<uint32_t>(constants_.size());
+	constants_.push_back(constant);
+	if (it == constantIds_.end()) {
+		constantIds_[hash] = id;
+	}
+	return id;
+}
+
+uint32_t RenderQueueManager::GetBatchId(const Model* model, uint32_t lod, uint32_t viewProjection, uint32_t camera)
+{
+	BatchKey key = { model, lod, viewProjection, camera };
+	auto it = batchIds_.find(key);
+	if (it != batchIds_.end()) {
+		return it->second;
+	}
+	uint32_t id = static_cast<uint32_t>(batchIds_.size());
+	batchIds_.emplace(key, id);
+	return id;
+}
+
+uint32_t RenderQueueManager::GetFrustumId(const Matrix4x4& viewProjection)
+{
+	// カメラは数個なので線形に探す
+	for (uint32_t i = 0; i < frustumMatrices_.size(); ++i) {
+		if (std::memcmp(&frustumMatrices_[i], &viewProjection, sizeof(Matrix4x4)) == 0) {
+			return i;
+		}
+	}
+
+	uint32_t id = static_cast<uint32_t>(frustumMatrices_.size());
+	frustumMatrices_.push_back(viewProjection);
+	cullers_.emplace_back();
+	cullers_.back().SetFrustum(viewProjection);
+	cullers_.back().Reserve(1024);
+	cullerItems_.emplace_back();
+	return id;
+}
+
+void RenderQueueManager::Submit(RenderPass pass, uint32_t pipeline, uint32_t material, uint32_t texture, uint32_t batch, uint32_t depth, const DrawItem& item)
+{
+	DrawPacket packet;
+	packet.key = RenderKey::Make(pass, pipeline, material, texture, batch, depth);
+	packet.pipeline = pipeline;
+	packet.material = material;
+	packet.texture = texture;
+	packet.batch = batch;
+	packet.item = static_cast<uint32_t>(items_.size());
+	if (item.frustum != UINT32_MAX) {
+		assert(item.frustum < cullers_.size());
+		cullers_[item.frustum].Add(item.bounds);
+		cullerItems_[item.frustum].push_back(packet.item);
+	}
+	items_.push_back(item);
+	queue_.Submit(packet);
+}
+
+void RenderQueueManager::Flush()
+{
+	if (queue_.GetSize() == 0) {
+		return;
+	}
+
+	Cull();
+
+	auto start = std::chrono::steady_clock::now();
+	queue_.Sort();
+	auto end = std::chrono::steady_clock::now();
+	sortMicroseconds_ = std::chrono::duration<float, std::micro>(end - start).count();
+
+	queue_.BuildBatches(kMaxBatchSize_);
+	BuildInstances();
+
+	CommandListSink sink(this, dxCommon_->GetCommandList());
+	queue_.Execute(sink);
+	stats_ = queue_.GetStats();
+	if (stats_.keyOverflows > 0 && !keyOverflowLogged_) {
+		// 並べ直すので描画は正しいが、毎フレーム比較ソートが走る
+		DirectXCommon::Log("RenderQueueManager: " + std::to_string(stats_.keyOverflows) +
+			" draws have ids wider than the sort key (batch >= 255, material >= 4096 or pipeline >= 256), re-sorting by full ids\n");
+		keyOverflowLogged_ = true;
+	}
+
+	queue_.Clear();
+	items_.clear();
+	for (uint32_t i = 0; i < cullers_.size(); ++i) {
+		cullers_[i].Clear();
+		cullerItems_[i].clear();
+	}
+}
+
+void RenderQueueManager::Cull()
+{
+	auto start = std::chrono::steady_clock::now();
+	const size_t before = queue_.GetSize();
+
+	// カリングしない item は見える扱い、登録した item は視錐台ごとの結果で決める
+	visibleItems_.assign(items_.size(), 1);
+	occludedCount_ = 0;
+	bool culled = false;
+	for (uint32_t i = 0; i < cullers_.size(); ++i) {
+		const std::vector<uint32_t>& cullerItems = cullerItems_[i];
+		if (cullerItems.empty()) {
+			continue;
+		}
+		cullers_[i].Cull(visibleIndices_);
+
+		// 視錐台に残ったものは、同じカメラの遮蔽物の深度があればそれでも調べる
+		const bool useOcclusion = occlusion_.IsReady() &&
+			std::memcmp(&occlusion_.GetViewProjection(), &frustumMatrices_[i], sizeof(Matrix4x4)) == 0;
+		if (!useOcclusion && visibleIndices_.size() == cullerItems.size()) {
+			continue;
+		}
+		for (uint32_t item : cullerItems) {
+			visibleItems_[item] = 0;
+		}
+		for (uint32_t index : visibleIndices_) {
+			const uint32_t item = cullerItems[index];
+			if (useOcclusion && !occlusion_.IsVisible(items_[item].bounds)) {
+				++occludedCount_;
+				continue;
+			}
+			visibleItems_[item] = 1;
+		}
+		culled = true;
+	}
+	if (culled) {
+		queue_.RemoveCulled(visibleItems_);
+	}
+
+	culledCount_ = static_cast<uint32_t>(before - queue_.GetSize());
+	auto end = std::chrono::steady_clock::now();
+	cullMicroseconds_ = std::chrono::duration<float, std::micro>(end - start).count();
+}
+
+void RenderQueueManager::BuildInstances()
+{
+	const std::vector<DrawPacket>& packets = queue_.GetPackets();
+	const std::vector<RenderBatch>& batches = queue_.GetBatches();
+
+	batchInstances_.assign(batches.size(), 0);
+	instanceJobs_.clear();
+
+	// 書き込み先の確保はアップロードリングが単一スレッド前提なのでここで先にまとめて行う
+	for (uint32_t i = 0; i < batches.size(); ++i) {
+		if (packets[batches[i].first].batch == DrawPacket::kNoBatch) {
+			continue;
+		}
+		FrameUploadRing::Block block = FrameUploadRing::GetInstance()->Allocate(batches[i].count * static_cast<uint32_t>(sizeof(InstanceForGPU)));
+		batchInstances_[i] = block.gpu;
+		instanceJobs_.push_back({ i, static_cast<InstanceForGPU*>(block.cpu) });
+	}
+
+	// 逆行列の計算が重いので、まとめごとに並列で書き込む
+	std::for_each(std::execution::par, instanceJobs_.begin(), instanceJobs_.end(), [&](const InstanceJob& job) {
+		const RenderBatch& batch = batches[job.batchIndex];
+		for (uint32_t i = 0; i < batch.count; ++i) {
+			const Matrix4x4& world = items_[packets[batch.first + i].item].world;
+			InstanceForGPU instance;
+			instance.World = world;
+			instance.WorldInverseTranspose = TransPose(Inverse(world));
+			job.cpu[i] = instance;
+		}
+		});
+}
+
+/*===============================================//
+				コマンドリストへの出力
+//===============================================*/
+
+RenderQueueManager::CommandListSink::CommandListSink(RenderQueueManager* manager, ID3D12GraphicsCommandList* commandList)
+	: manager_(manager), commandList_(commandList)
+{
+}
+
+void RenderQueueManager::CommandListSink::SetPipeline(uint32_t pipeline)
+{
+	const Pipeline& state = manager_->pipelines_[pipeline];
+
+	// ルートシグネチャが変わる時だけ設定し直す (ライトもここで設定し直す)
+	if (rootSignature_ != state.rootSignature.Get()) {
+		rootSignature_ = state.rootSignature.Get();
+		commandList_->SetGraphicsRootSignature(rootSignature_);
+		commandList_->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+		LightManager::GetInstance()->SetCommandList();
+		camera_ = 0;
+		viewProjection_ = 0;
+	}
+	commandList_->SetPipelineState(state.pipelineState.Get());
+}
+
+void RenderQueueManager::CommandListSink::SetMaterial(uint32_t material)
+{
+	commandList_->SetGraphicsRootConstantBufferView(0, manager_->GetConstantAddress(material));
+}
+
+void RenderQueueManager::CommandListSink::SetTexture(uint32_t texture)
+{
+	commandList_->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetSrvHandleGPU(texture));
+}
+
+void RenderQueueManager::CommandListSink::Draw(uint32_t batchIndex, const DrawPacket* packets, uint32_t count)
+{
+	const DrawItem& drawItem = manager_->items_[packets[0].item];
+
+	if (drawItem.camera != camera_) {
+		commandList_->SetGraphicsRootConstantBufferView(4, drawItem.camera);
+		camera_ = drawItem.camera;
+	}
+
+	// まとめた描画はインスタンス配列を読む1回のドローコール
+	if (packets[0].batch != DrawPacket::kNoBatch) {
+		commandList_->SetGraphicsRootShaderResourceView(1, manager_->batchInstances_[batchIndex]);
+		if (drawItem.viewProjection != viewProjection_) {
+			commandList_->SetGraphicsRootConstantBufferView(7, drawItem.viewProjection);
+			viewProjection_ = drawItem.viewProjection;
+		}
+		drawItem.model->DrawMesh(count, drawItem.lod);
+		return;
+	}
+
+	commandList_->SetGraphicsRootConstantBufferView(1, drawItem.transform);
+	drawItem.model->DrawMesh(drawItem.instanceCount, drawItem.lod);
+}
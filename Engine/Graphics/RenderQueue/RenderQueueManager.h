@@ -0,0 +1,263 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <wrl.h>
+#include <d3d12.h>
+
+// Engine
+#include "RenderQueue.h"
+#include "Culling/FrustumCuller.h"
+#include "Culling/OcclusionRasterizer.h"
+
+// Math
+#include "MathFunc.h"
+#include "Matrix4x4.h"
+
+class DirectXCommon;
+class Model;
+
+/// <summary>
+/// 3Dオブジェクトの描画キュー
+/// Object3dの描画はここに積まれ、Flushでキー順に並べてまとめて描画する
+/// ルートシグネチャ・パイプライン・マテリアル・テクスチャは前と同じなら設定しない
+/// 同じモデル・マテリアル・パイプラインの描画は1回のインスタンシング描画にまとめる
+/// ワールド空間のAABBを持つ描画は並べ替えの前に視錐台カリングで間引き、
+/// 同じカメラで遮蔽物を描いてあればソフトウェアオクルージョンでも間引く
+/// </summary>
+class RenderQueueManager
+{
+public: // 構造体
+
+	// 描画1回分のデータ (状態の切り替えとは別に毎回設定するもの)
+	struct DrawItem {
+		Model* model = nullptr;
+		uint32_t lod = 0;								// モデルのLOD
+		D3D12_GPU_VIRTUAL_ADDRESS camera = 0;			// ルート4
+		// まとめない描画
+		D3D12_GPU_VIRTUAL_ADDRESS transform = 0;		// ルート1 (定数バッファ)
+		uint32_t instanceCount = 1;
+		// まとめる描画 (インスタンスの配列はFlushで作る)
+		Matrix4x4 world;
+		D3D12_GPU_VIRTUAL_ADDRESS viewProjection = 0;	// ルート7
+		// 視錐台カリング (frustum が UINT32_MAX ならカリングしない)
+		AABB bounds;									// ワールド空間
+		uint32_t frustum = UINT32_MAX;					// GetFrustumIdで得た番号
+	};
+
+	// インスタンス1つ分の座標変換データ (InstanceObj.VS.hlsl と同じレイアウト)
+	struct InstanceForGPU {
+		Matrix4x4 World;
+		Matrix4x4 WorldInverseTranspose;
+	};
+
+public: // メンバ関数
+
+	// シングルトンインスタンスの取得
+	static RenderQueueManager* GetInstance();
+
+	// 終了処理
+	void Finalize();
+
+	// コンストラクタとデストラクタ
+	RenderQueueManager() = default;
+	~RenderQueueManager() = default;
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	void Initialize(DirectXCommon* dxCommon);
+
+	/// <summary>
+	/// フレームの開始 (定数データの重複除去を空にする)
+	/// </summary>
+	void BeginFrame();
+
+	/// <summary>
+	/// パイプラインの登録 (PipelineManagerの名前で登録し、IDを返す)
+	/// </summary>
+	uint32_t RegisterPipeline(const std::string& name);
+
+	/// <summary>
+	/// 定数データをアップロードリングに書き込みIDを返す
+	/// 同じフレームで同じ内容のものは同じIDになる (マテリアルIDとしてそのまま使う)
+	/// </summary>
+	uint32_t UploadConstants(const void* data, uint32_t size);
+	template<class T>
+	uint32_t UploadConstants(const T& data) { return UploadConstants(&data, static_cast<uint32_t>(sizeof(T))); }
+
+	/// <summary>
+	/// 定数データのGPUアドレス
+	/// </summary>
+	D3D12_GPU_VIRTUAL_ADDRESS GetConstantAddress(uint32_t id) const { return constants_[id].address; }
+
+	/// <summary>
+	/// まとめ描画の番号 (今フレームでモデル・LOD・ビュープロジェクション・カメラが同じなら同じ番号)
+	/// </summary>
+	/// <param name="viewProjection">UploadConstantsで得たビュープロジェクション行列のID</param>
+	/// <param name="camera">UploadConstantsで得たカメラのID</param>
+	uint32_t GetBatchId(const Model* model, uint32_t lod, uint32_t viewProjection, uint32_t camera);
+
+	/// <summary>
+	/// 視錐台の番号 (今フレームで同じビュープロジェクション行列なら同じ番号)
+	/// </summary>
+	uint32_t GetFrustumId(const Matrix4x4& viewProjection);
+
+	/// <summary>
+	/// ソフトウェアオクルージョンの深度 (フレームごとに BeginFrame → 遮蔽物の追加 → Rasterize してから描画を積む)
+	/// 描画の視錐台と同じビュープロジェクション行列で描いた時だけ使われる
+	/// </summary>
+	OcclusionRasterizer& GetOcclusionRasterizer() { return occlusion_; }
+
+	/// <summary>
+	/// 描画を積む
+	/// </summary>
+	/// <param name="material">UploadConstantsで得たID (ルート0)</param>
+	/// <param name="texture">テクスチャハンドル (ルート2)</param>
+	/// <param name="batch">GetBatchIdで得た番号 (まとめないならDrawPacket::kNoBatch)</param>
+	/// <param name="depth">RenderKey::QuantizeDepthで量子化した深度</param>
+	void Submit(RenderPass pass, uint32_t pipeline, uint32_t material, uint32_t texture, uint32_t batch, uint32_t depth, const DrawItem& item);
+
+	/// <summary>
+	/// 積んだ描画を視錐台カリングし、残りを並べ替えて実行してキューを空にする
+	/// </summary>
+	void Flush();
+
+	/*===============================================//
+						情報
+	//===============================================*/
+
+	// 直近のFlushの状態設定・ドローコールの回数
+	const RenderQueue::Stats& GetStats() const { return stats_; }
+	// 直近のFlushのソート時間
+	float GetSortMicroseconds() const { return sortMicroseconds_; }
+	// 直近のFlushで視錐台カリングにより省いた描画数
+	uint32_t GetCulledCount() const { return culledCount_; }
+	// 直近のFlushでオクルージョンカリングにより省いた描画数 (GetCulledCountに含まれる)
+	uint32_t GetOccludedCount() const { return occludedCount_; }
+	// 直近のFlushのカリング時間
+	float GetCullMicroseconds() const { return cullMicroseconds_; }
+
+public:
+	// 1回のインスタンシング描画にまとめる最大数
+	static const uint32_t kMaxBatchSize_;
+
+private:
+
+	/// <summary>
+	/// 視錐台の外の描画をキューから取り除く
+	/// </summary>
+	void Cull();
+
+	/// <summary>
+	/// まとめ描画のインスタンス配列を作る (まとめごとに並列で書き込む)
+	/// </summary>
+	void BuildInstances();
+
+	/// <summary>
+	/// コマンドリストへの出力
+	/// </summary>
+	class CommandListSink : public RenderCommandSink
+	{
+	public:
+		CommandListSink(RenderQueueManager* manager, ID3D12GraphicsCommandList* commandList);
+		void SetPipeline(uint32_t pipeline) override;
+		void SetMaterial(uint32_t material) override;
+		void SetTexture(uint32_t texture) override;
+		void Draw(uint32_t batchIndex, const DrawPacket* packets, uint32_t count) override;
+
+	private:
+		RenderQueueManager* manager_;
+		ID3D12GraphicsCommandList* commandList_;
+		ID3D12RootSignature* rootSignature_ = nullptr;
+		D3D12_GPU_VIRTUAL_ADDRESS camera_ = 0;
+		D3D12_GPU_VIRTUAL_ADDRESS viewProjection_ = 0;
+	};
+
+	// パイプライン
+	struct Pipeline {
+		Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature;
+		Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState;
+	};
+
+	// まとめ描画の番号の検索用
+	struct BatchKey {
+		const Model* model;
+		uint32_t lod;
+		uint32_t viewProjection;
+		uint32_t camera;
+		bool operator==(const BatchKey& other) const {
+			return model == other.model && lod == other.lod && viewProjection == other.viewProjection && camera == other.camera;
+		}
+	};
+	struct BatchKeyHash {
+		size_t operator()(const BatchKey& key) const {
+			size_t hash = std::hash<const Model*>()(key.model);
+			hash ^= (static_cast<size_t>(key.viewProjection) << 1) ^ (static_cast<size_t>(key.camera) << 17) ^ (static_cast<size_t>(key.lod) << 29);
+			return hash;
+		}
+	};
+
+	// インスタンス配列を書き込む仕事 (まとめ1つ分)
+	struct InstanceJob {
+		uint32_t batchIndex;
+		InstanceForGPU* cpu;
+	};
+
+	// 定数データ
+	struct Constant {
+		D3D12_GPU_VIRTUAL_ADDRESS address;
+		uint32_t offset;	// constantBytes_ 内の位置 (内容の比較用)
+		uint32_t size;
+	};
+
+private:
+	// シングルトンインスタンス
+	static std::unique_ptr<RenderQueueManager> instance;
+	static std::once_flag initInstanceFlag;
+
+	// コピーコンストラクタと代入演算子を削除
+	RenderQueueManager(RenderQueueManager&) = delete;
+	RenderQueueManager& operator=(RenderQueueManager&) = delete;
+
+	DirectXCommon* dxCommon_ = nullptr;
+
+	RenderQueue queue_;
+	std::vector<DrawItem> items_;
+
+	std::vector<Pipeline> pipelines_;
+	std::unordered_map<std::string, uint32_t> pipelineIds_;
+
+	// 今フレームの定数データ (内容のハッシュ → ID)
+	std::vector<Constant> constants_;
+	std::vector<uint8_t> constantBytes_;
+	std::unordered_map<uint64_t, uint32_t> constantIds_;
+
+	// 今フレームのまとめ描画の番号
+	std::unordered_map<BatchKey, uint32_t, BatchKeyHash> batchIds_;
+	// まとめごとのインスタンス配列のアドレス (ルート1)
+	std::vector<D3D12_GPU_VIRTUAL_ADDRESS> batchInstances_;
+	std::vector<InstanceJob> instanceJobs_;
+
+	// 今フレームの視錐台 (番号ごとにビュープロジェクション行列・カリング・登録した item)
+	std::vector<Matrix4x4> frustumMatrices_;
+	std::vector<FrustumCuller> cullers_;
+	std::vector<std::vector<uint32_t>> cullerItems_;
+	std::vector<uint32_t> visibleIndices_;
+	std::vector<uint8_t> visibleItems_;
+	// 大きい遮蔽物を描いた低解像度の深度
+	OcclusionRasterizer occlusion_;
+
+	RenderQueue::Stats stats_;
+	// キーに収まらないIDのログは1回だけ
+	bool keyOverflowLogged_ = false;
+	float sortMicroseconds_ = 0.0f;
+	uint32_t culledCount_ = 0;
+	uint32_t occludedCount_ = 0;
+	float cullMicroseconds_ = 0.0f;
+};
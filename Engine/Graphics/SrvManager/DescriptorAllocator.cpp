@@ -0,0 +1,108 @@
+#include "DescriptorAllocator.h"
+
+// C++
+#include <cassert>
+
+void DescriptorAllocator::Initialize(uint32_t persistentCount, uint32_t transientCount, uint32_t frameCount)
+{
+	assert(persistentCount + transientCount <= DescriptorHandleUtil::kIndexMask);
+	assert(frameCount > 0);
+
+	persistentCount_ = persistentCount;
+	transientCount_ = transientCount;
+	frameCount_ = frameCount;
+	frameIndex_ = 0;
+
+	generations_.assign(persistentCount_, 0);
+	used_.assign(persistentCount_, 0);
+	freeList_.resize(persistentCount_);
+	for (uint32_t i = 0; i < persistentCount_; ++i) {
+		freeList_[i] = persistentCount_ - 1 - i;
+	}
+	pendingFrees_.assign(frameCount_, {});
+	persistentUsed_ = 0;
+
+	head_ = 0;
+	tail_ = 0;
+	frameEnds_.assign(frameCount_, 0);
+}
+
+void DescriptorAllocator::BeginFrame()
+{
+	// 終わったフレームの終了位置を記録して次の枠へ
+	frameEnds_[frameIndex_] = head_;
+	frameIndex_ = (frameIndex_ + 1) % frameCount_;
+
+	// この枠を前に使ったフレームはGPUが使い終わっているので回収する
+	if (tail_ < frameEnds_[frameIndex_]) {
+		tail_ = frameEnds_[frameIndex_];
+	}
+	for (uint32_t index : pendingFrees_[frameIndex_]) {
+		freeList_.push_back(index);
+	}
+	pendingFrees_[frameIndex_].clear();
+}
+
+DescriptorHandle DescriptorAllocator::Allocate()
+{
+	if (freeList_.empty()) {
+		return DescriptorHandleUtil::kInvalid;
+	}
+	uint32_t index = freeList_.back();
+	freeList_.pop_back();
+	used_[index] = 1;
+	++persistentUsed_;
+	return DescriptorHandleUtil::Make(index, generations_[index]);
+}
+
+void DescriptorAllocator::Free(DescriptorHandle handle)
+{
+	// 二重解放・古いハンドルでの解放はここで止める
+	assert(IsValid(handle));
+	if (!IsValid(handle)) {
+		return;
+	}
+	uint32_t index = DescriptorHandleUtil::GetIndex(handle);
+	used_[index] = 0;
+	generations_[index] = DescriptorHandleUtil::NextGeneration(generations_[index]);
+	--persistentUsed_;
+	pendingFrees_[frameIndex_].push_back(index);
+}
+
+bool DescriptorAllocator::IsValid(DescriptorHandle handle) const
+{
+	if (handle == DescriptorHandleUtil::kInvalid) {
+		return false;
+	}
+	uint32_t index = DescriptorHandleUtil::GetIndex(handle);
+	if (index >= persistentCount_ || !used_[index]) {
+		return false;
+	}
+	return generations_[index] == DescriptorHandleUtil::GetGeneration(handle);
+}
+
+DescriptorHandle DescriptorAllocator::GetHandle(uint32_t index) const
+{
+	if (index >= persistentCount_ || !used_[index]) {
+		return DescriptorHandleUtil::kInvalid;
+	}
+	return DescriptorHandleUtil::Make(index, generations_[index]);
+}
+
+uint32_t DescriptorAllocator::AllocateTransient(uint32_t count)
+{
+	if (count == 0 || count > transientCount_) {
+		return DescriptorHandleUtil::kInvalid;
+	}
+
+	// 末尾をまたぐ場合は先頭から取り直す (残りは捨てる)
+	uint64_t position = head_ % transientCount_;
+	uint64_t skip = (position + count > transientCount_) ? transientCount_ - position : 0;
+	if (head_ + skip + count - tail_ > transientCount_) {
+		return DescriptorHandleUtil::kInvalid;
+	}
+	head_ += skip;
+	uint32_t index = persistentCount_ + static_cast<uint32_t>(head_ % transientCount_);
+	head_ += count;
+	return index;
+}
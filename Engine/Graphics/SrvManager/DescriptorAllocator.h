@@ -0,0 +1,104 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <vector>
+
+// Engine
+#include "Systems/Handle/GenerationalHandle.h"
+
+/// <summary>
+/// ディスクリプタのハンドル
+/// </summary>
+using DescriptorHandle = GenerationalHandle;
+namespace DescriptorHandleUtil = GenerationalHandleUtil;
+
+/// <summary>
+/// ディスクリプタヒープの番号割り当て (D3D12には依存しない)
+/// [0, persistentCount)              : 常駐領域。フリーリストで解放・再利用する
+/// [persistentCount, +transientCount) : 一時領域。フレーム単位のリングで、フレームが終われば丸ごと戻る
+/// 解放・リングの回収は frameCount フレーム後 (GPUが使い終わった後) に行う
+/// </summary>
+class DescriptorAllocator
+{
+public: // メンバ関数
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="persistentCount">常駐領域の数</param>
+	/// <param name="transientCount">一時領域の数</param>
+	/// <param name="frameCount">GPUが同時に扱うフレーム数</param>
+	void Initialize(uint32_t persistentCount, uint32_t transientCount, uint32_t frameCount);
+
+	/// <summary>
+	/// フレームの開始 (frameCount フレーム前の解放と一時領域を回収する)
+	/// </summary>
+	void BeginFrame();
+
+	/*===============================================//
+						常駐領域
+	//===============================================*/
+
+	/// <summary>
+	/// 確保 (空きが無ければ無効値)
+	/// </summary>
+	DescriptorHandle Allocate();
+
+	/// <summary>
+	/// 解放 (番号はGPUが使い終わってから再利用される)
+	/// </summary>
+	void Free(DescriptorHandle handle);
+
+	/// <summary>
+	/// ハンドルが有効か
+	/// </summary>
+	bool IsValid(DescriptorHandle handle) const;
+
+	/// <summary>
+	/// 番号から現在のハンドルを作る (番号だけを持っている呼び出し元向け)
+	/// </summary>
+	DescriptorHandle GetHandle(uint32_t index) const;
+
+	/*===============================================//
+						一時領域
+	//===============================================*/
+
+	/// <summary>
+	/// 連続した count 個を確保し、先頭の番号を返す (このフレームの間だけ有効。足りなければ無効値)
+	/// </summary>
+	uint32_t AllocateTransient(uint32_t count = 1);
+
+	/*===============================================//
+						情報
+	//===============================================*/
+
+	uint32_t GetPersistentCapacity() const { return persistentCount_; }
+	uint32_t GetPersistentUsed() const { return persistentUsed_; }
+	uint32_t GetPersistentFree() const { return static_cast<uint32_t>(freeList_.size()); }
+	uint32_t GetTransientCapacity() const { return transientCount_; }
+	uint32_t GetTransientUsed() const { return static_cast<uint32_t>(head_ - tail_); }
+	uint32_t GetTotalCount() const { return persistentCount_ + transientCount_; }
+
+private: // メンバ変数
+
+	uint32_t persistentCount_ = 0;
+	uint32_t transientCount_ = 0;
+	uint32_t frameCount_ = 1;
+	uint32_t frameIndex_ = 0;
+
+	// 常駐領域
+	std::vector<uint32_t> generations_;
+	std::vector<uint8_t> used_;
+	// 空き番号 (末尾から取り出す。小さい番号から使われるよう逆順に積む)
+	std::vector<uint32_t> freeList_;
+	// フレームごとの解放待ち
+	std::vector<std::vector<uint32_t>> pendingFrees_;
+	uint32_t persistentUsed_ = 0;
+
+	// 一時領域 (単調増加の位置。リング上の位置は剰余で求める)
+	uint64_t head_ = 0;
+	uint64_t tail_ = 0;
+	// フレームごとの終了位置
+	std::vector<uint64_t> frameEnds_;
+};
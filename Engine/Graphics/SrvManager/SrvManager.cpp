@@ -4,6 +4,8 @@
 
 SrvManager* SrvManager::instance = nullptr;
 const uint32_t SrvManager::kMaxSRVCount_ = 512;
+const uint32_t SrvManager::kTransientSRVCount_ = 256;
+const uint32_t SrvManager::kFrameCount_ = 2;
 
 SrvManager* SrvManager::GetInstance()
 {
@@ -26,8 +28,11 @@ void SrvManager::Initialize()
 	// 引数で受け取ってメンバ変数に記録する
 	dxCommon_ = DirectXCommon::GetInstance();
 
+	// 番号の割り当て (常駐領域の後ろに一時領域を置く)
+	allocator_.Initialize(kMaxSRVCount_, kTransientSRVCount_, kFrameCount_);
+
 	// デスクリプタヒープの生成
-	descriptorHeap_ = dxCommon_->CreateDescriptorHeap(dxCommon_->GetDevice(),D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, kMaxSRVCount_,true);
+	descriptorHeap_ = dxCommon_->CreateDescriptorHeap(dxCommon_->GetDevice(),D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, allocator_.GetTotalCount(),true);
 	// デスクリプタ1個分のサイズを取得して記録
 	descriptorSize_ = dxCommon_->GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
@@ -35,6 +40,9 @@ void SrvManager::Initialize()
 
 void SrvManager::PreDraw()
 {
+	// 前のフレームまでに解放されたものと一時領域を回収
+	allocator_.BeginFrame();
+
 	ID3D12DescriptorHeap* descriptorHeaps[] = { descriptorHeap_.Get() };
 	dxCommon_->GetCommandList()->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
 }
@@ -46,14 +54,38 @@ void SrvManager::SetGraphicsRootDescriptorTable(UINT RootParameterIndex, uint32_
 
 uint32_t SrvManager::Allocate()
 {
+	return GetIndex(AllocateHandle());
+}
+
+void SrvManager::Free(uint32_t srvIndex)
+{
+	Release(allocator_.GetHandle(srvIndex));
+}
+
+DescriptorHandle SrvManager::AllocateHandle()
+{
+	DescriptorHandle handle = allocator_.Allocate();
 	// 上限に達していないかチェックしてassert
-	assert(kMaxSRVCount_ > useIndex_);
+	assert(handle != DescriptorHandleUtil::kInvalid);
+	return handle;
+}
 
-	// return する番号を一旦記録しておく
-	int index = useIndex_;
-	// 次回のために番号を1進める
-	useIndex_++;
-	// 上で記録して番号をreturn
+void SrvManager::Release(DescriptorHandle handle)
+{
+	allocator_.Free(handle);
+}
+
+uint32_t SrvManager::GetIndex(DescriptorHandle handle) const
+{
+	assert(allocator_.IsValid(handle));
+	return DescriptorHandleUtil::GetIndex(handle);
+}
+
+uint32_t SrvManager::AllocateTransient(uint32_t count)
+{
+	uint32_t index = allocator_.AllocateTransient(count);
+	// 1フレームで一時領域を使い切っていないかチェック
+	assert(index != DescriptorHandleUtil::kInvalid);
 	return index;
 }
 
@@ -73,13 +105,7 @@ D3D12_GPU_DESCRIPTOR_HANDLE SrvManager::GetGPUSRVDescriptorHandle(uint32_t index
 
 bool SrvManager::IsAllocation()
 {
-	if (kMaxSRVCount_ > useIndex_) {
-		return true;
-	}
-	else {
-		return false;
-	}
-	
+	return allocator_.GetPersistentFree() > 0;
 }
 
 void SrvManager::CreateSRVforTexture2D(uint32_t srvIndex, ID3D12Resource* pResource, DXGI_FORMAT Format, UINT MipLevels)
@@ -6,6 +6,9 @@
 #include <d3d12.h>
 #include <dxgi1_6.h>
 
+// Engine
+#include "DescriptorAllocator.h"
+
 class DirectXCommon;
 // SRV管理
 class SrvManager
@@ -30,13 +33,39 @@ public: // メンバ関数
 	void Initialize();
 
 	/// <summary>
-	/// アロケータ
+	/// アロケータ (常駐領域から確保して番号を返す)
 	/// </summary>
 	/// <returns></returns>
 	uint32_t Allocate();
 
 	/// <summary>
-	/// 描画の前準備
+	/// 番号で確保したSRVの解放 (GPUが使い終わった後に再利用される)
+	/// </summary>
+	void Free(uint32_t srvIndex);
+
+	/// <summary>
+	/// 常駐領域からハンドルで確保 (世代付きなので解放後の使用を検出できる)
+	/// </summary>
+	DescriptorHandle AllocateHandle();
+
+	/// <summary>
+	/// ハンドルで確保したSRVの解放
+	/// </summary>
+	void Release(DescriptorHandle handle);
+
+	/// <summary>
+	/// ハンドルが有効か / ハンドルからSRVの番号を取得
+	/// </summary>
+	bool IsValid(DescriptorHandle handle) const { return allocator_.IsValid(handle); }
+	uint32_t GetIndex(DescriptorHandle handle) const;
+
+	/// <summary>
+	/// 一時領域から連続して確保 (そのフレームの間だけ有効。フレームが終われば自動で戻る)
+	/// </summary>
+	uint32_t AllocateTransient(uint32_t count = 1);
+
+	/// <summary>
+	/// 描画の前準備 (フレームの切り替えもここで行う)
 	/// </summary>
 	void PreDraw();
 
@@ -71,9 +100,18 @@ public: // メンバ関数
 	void CreateSRVforRenderTexture(uint32_t srvIndex, ID3D12Resource* pResource);
 	void CreateSRVforDepth(uint32_t srvIndex, ID3D12Resource* pResource);
 
+	/// <summary>
+	/// 割り当て状況の取得
+	/// </summary>
+	const DescriptorAllocator& GetAllocator() const { return allocator_; }
+
 public:
-	// 最大SRV数（最大テクスチャ枚数）
+	// 最大SRV数（常駐領域の数。最大テクスチャ枚数）
 	static const uint32_t kMaxSRVCount_;
+	// 一時領域の数
+	static const uint32_t kTransientSRVCount_;
+	// GPUが同時に扱うフレーム数 (スワップチェーンのバッファ数)
+	static const uint32_t kFrameCount_;
 
 
 private:
@@ -83,8 +121,8 @@ private:
 
 	// ポインタ
 	DirectXCommon* dxCommon_ = nullptr;
-	// 次に使用するSRVインデックス
-	uint32_t useIndex_ = 0;
+	// 番号の割り当て (常駐領域のフリーリストと一時領域のリング)
+	DescriptorAllocator allocator_;
 	// SRV用のデスクリプタサイズ
 	uint32_t descriptorSize_ = 0;
 	// SRV用デスクリプタヒープ
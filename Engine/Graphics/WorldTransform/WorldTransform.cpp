@@ -1,7 +1,7 @@
 #include "WorldTransform.h"
 // Engine
-#include "DX./DirectXCommon.h"
-#include "Object3D/Object3dCommon.h"
+#include "FrameAllocator/FrameUploadRing.h"
+#include "Systems/GameTime/FrameTimer.h"
 
 // Math
 #include "MathFunc.h"
@@ -13,20 +13,22 @@ void WorldTransform::Initialize()
 	// ワールド行列の初期化
 	matWorld_ = MakeAffineMatrix(scale_, rotation_, translation_);
 
-	// 定数バッファ生成
-	CreateConstBuffer();
+	// 転送データの初期化
+	InitializeTransformData();
 }
 
-void WorldTransform::CreateConstBuffer()
+void WorldTransform::InitializeTransformData()
 {
-	// MVP用のリソースを作る。Matrix4x4 1つ分のサイズを用意する
-	constBuffer_ = Object3dCommon::GetInstance()->GetDxCommon()->CreateBufferResource(sizeof(TransformationMatrix));
-	// 書き込むためのアドレスを取得
-	constBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&transformData_));
-	// 単位行列を書き込んでおく
-	transformData_->WVP = MakeIdentity4x4();
-	transformData_->World = MakeIdentity4x4();
-	transformData_->WorldInverse = TransPose(Inverse(transformData_->World));
+	// 単位行列を入れておく
+	transformData_.WVP = MakeIdentity4x4();
+	transformData_.World = MakeIdentity4x4();
+	transformData_.WorldInverse = TransPose(Inverse(transformData_.World));
+	isInitialized_ = true;
+}
+
+D3D12_GPU_VIRTUAL_ADDRESS WorldTransform::UploadConstBuffer() const
+{
+	return FrameUploadRing::GetInstance()->Push(transformData_);
 }
 
 void WorldTransform::UpdateMatrix()
@@ -37,31 +39,69 @@ void WorldTransform::UpdateMatrix()
 	// 固定された行列合成順序でワールド行列作成
 	/// else
 	// 固定された行列合成順序でワールド行列作成
+	Snapshot state = { scale_, rotation_, translation_ };
 	if (useAnchorPoint_) {
 		Vector3 offset = ScaleRotateToAnchor(anchorPoint_, scale_, rotation_);
 
 		Vector3 anchoredTranslation = translation_ + anchorPoint_ - offset;
 
 		matWorld_ = MakeAffineMatrix(scale_, rotation_, anchoredTranslation);
+		state.translation = anchoredTranslation;
 
 	} else {
 		
 		matWorld_ = MakeAffineMatrix(scale_, rotation_, translation_);
 	}
 
+	// ステップが進んでいたら前回の状態を補間元として残す
+	// 1ステップ以上飛んでいたら補間せずにその場へ移す
+	uint64_t step = FrameTimer::GetInstance()->GetStepIndex();
+	if (!hasSnapshot_ || step != snapshotStep_) {
+		prevState_ = (hasSnapshot_ && step == snapshotStep_ + 1) ? currState_ : state;
+		snapshotStep_ = step;
+		hasSnapshot_ = true;
+	}
+	currState_ = state;
+
 
 	// 親の合成
-	if (transformData_ != nullptr) {
+	if (isInitialized_) {
 		if (parent_) {
 			matWorld_ = matWorld_ * parent_->matWorld_;
 		}
 
-		transformData_->World = matWorld_;
-		transformData_->WorldInverse = Inverse(matWorld_);
+		transformData_.World = matWorld_;
+		transformData_.WorldInverse = Inverse(matWorld_);
 	}
 }
 
 
+Matrix4x4 WorldTransform::GetInterpolatedMatWorld() const
+{
+	FrameTimer* frameTimer = FrameTimer::GetInstance();
+	if (!frameTimer->IsInterpolating() || !hasSnapshot_) {
+		return matWorld_;
+	}
+
+	// 今ステップで更新されていないものは止まっているので補間しない
+	float alpha = (snapshotStep_ == frameTimer->GetStepIndex()) ? frameTimer->GetInterpolationAlpha() : 1.0f;
+	Vector3 rotation = {
+		LerpShortAngle(prevState_.rotation.x, currState_.rotation.x, alpha),
+		LerpShortAngle(prevState_.rotation.y, currState_.rotation.y, alpha),
+		LerpShortAngle(prevState_.rotation.z, currState_.rotation.z, alpha),
+	};
+	Matrix4x4 matWorld = MakeAffineMatrix(
+		Lerp(prevState_.scale, currState_.scale, alpha),
+		rotation,
+		Lerp(prevState_.translation, currState_.translation, alpha));
+
+	// 親も補間した行列で合成する
+	if (parent_ && isInitialized_) {
+		matWorld = matWorld * parent_->GetInterpolatedMatWorld();
+	}
+	return matWorld;
+}
+
 /// <summary>
 /// アンカーポイントの取得
 /// </summary>
@@ -1,5 +1,6 @@
 #pragma once
 // C++
+#include <cstdint>
 #include <d3d12.h>
 #include <type_traits>
 #include <wrl.h>
@@ -59,27 +60,32 @@ public:
 	void SetAnchorPoint(const Vector3& anchorPoint);
 
 	/// <summary>
-	/// 定数バッファの取得
+	/// 定数バッファの内容をフレームのアップロードリングに書き込み、GPUアドレスを返す
+	/// (描画のたびに呼ぶ。同じフレームで複数回描画してもそれぞれの内容が残る)
 	/// </summary>
-	/// <returns>定数バッファ</returns>
-	const Microsoft::WRL::ComPtr<ID3D12Resource>& GetConstBuffer() const { return constBuffer_; }
+	D3D12_GPU_VIRTUAL_ADDRESS UploadConstBuffer() const;
 
 	/// <summary>
-	/// マップの設定・取得
+	/// 転送するデータの設定・取得
 	/// </summary>
 	/// <param name="wvp">WVP行列</param>
-	TransformationMatrix* GetTransformData() { return transformData_; }
-	void SetMapWVP(const Matrix4x4& wvp) { transformData_->WVP = wvp; }
-	void SetMapWorld(const Matrix4x4& world) { transformData_->World = world; }
+	TransformationMatrix* GetTransformData() { return &transformData_; }
+	void SetMapWVP(const Matrix4x4& wvp) { transformData_.WVP = wvp; }
+	void SetMapWorld(const Matrix4x4& world) { transformData_.World = world; }
 	const Matrix4x4& GetMatWorld() { return matWorld_; }
 
+	/// <summary>
+	/// 描画用のワールド行列 (固定ステップ間を補間したもの)
+	/// </summary>
+	Matrix4x4 GetInterpolatedMatWorld() const;
+
 
 private:
 
 	/// <summary>
-	/// 定数バッファ生成
+	/// 転送データの初期化
 	/// </summary>
-	void CreateConstBuffer();
+	void InitializeTransformData();
 
 	/// <summary>
 	/// スケール・回転を適用した座標を計算
@@ -91,10 +97,21 @@ private:
 	Vector3 ScaleRotateToAnchor(const Vector3& point, const Vector3& scale, const Vector3& rotation);
 
 private:
-	// 定数バッファ
-	Microsoft::WRL::ComPtr<ID3D12Resource> constBuffer_;
-	// マッピング済みアドレス
-	TransformationMatrix* transformData_ = nullptr;
+	// 補間用のSRT (平行移動はアンカーポイント補正後)
+	struct Snapshot {
+		Vector3 scale;
+		Vector3 rotation;
+		Vector3 translation;
+	};
+
+	// 転送するデータ (GPUへは描画時にアップロードリング経由で渡す)
+	TransformationMatrix transformData_;
+	bool isInitialized_ = false;
+	// 前ステップと現ステップの状態
+	Snapshot prevState_;
+	Snapshot currState_;
+	uint64_t snapshotStep_ = 0;
+	bool hasSnapshot_ = false;
 	// コピー禁止
 	WorldTransform(const WorldTransform&) = delete;
 	WorldTransform& operator=(const WorldTransform&) = delete;
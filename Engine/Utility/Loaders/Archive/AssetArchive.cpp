@@ -0,0 +1,352 @@
+#include "AssetArchive.h"
+
+// C++
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+	// ASCIIだけ小文字にする (パスの比較用)
+	char ToLowerAscii(char c)
+	{
+		return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+	}
+
+	// 大文字小文字を無視した比較
+	bool EqualsIgnoreCase(std::string_view a, std::string_view b)
+	{
+		if (a.size() != b.size()) {
+			return false;
+		}
+		for (size_t i = 0; i < a.size(); ++i) {
+			if (ToLowerAscii(a[i]) != ToLowerAscii(b[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	uint64_t AlignUp(uint64_t value, uint64_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	// 作成時の1ファイル分
+	struct SourceFile {
+		std::string path;		// 正規化したパス
+		std::filesystem::path sourcePath;
+		uint64_t hash = 0;
+		uint64_t size = 0;
+		int64_t writeTime = 0;
+	};
+}
+
+/// <summary>
+/// アーカイブを開く
+/// </summary>
+bool AssetArchive::Open(const std::string& archivePath)
+{
+	Close();
+	if (!file_.Open(archivePath)) {
+		return false;
+	}
+
+	const uint8_t* data = file_.GetData();
+	const uint64_t fileSize = file_.GetSize();
+	if (fileSize < sizeof(Header)) {
+		Close();
+		return false;
+	}
+
+	Header header;
+	std::memcpy(&header, data, sizeof(header));
+	const uint64_t tocEnd = header.tocOffset + uint64_t(header.entryCount) * sizeof(Entry);
+	if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+		header.version != kVersion ||
+		header.fileSize != fileSize ||
+		header.tocOffset % alignof(Entry) != 0 ||
+		tocEnd > header.stringsOffset ||
+		header.stringsOffset > header.dataOffset ||
+		header.dataOffset > fileSize) {
+		Close();
+		return false;
+	}
+
+	// 目次が範囲外を指していないか確かめてから使う
+	const Entry* entries = reinterpret_cast<const Entry*>(data + header.tocOffset);
+	const uint64_t stringsSize = header.dataOffset - header.stringsOffset;
+	for (uint32_t i = 0; i < header.entryCount; ++i) {
+		const Entry& entry = entries[i];
+		if (entry.offset < header.dataOffset || entry.offset > fileSize || entry.size > fileSize - entry.offset ||
+			uint64_t(entry.pathOffset) + entry.pathLength > stringsSize ||
+			(i > 0 && entries[i - 1].pathHash > entry.pathHash)) {
+			Close();
+			return false;
+		}
+	}
+
+	entries_ = entries;
+	entryCount_ = header.entryCount;
+	strings_ = reinterpret_cast<const char*>(data + header.stringsOffset);
+	return true;
+}
+
+/// <summary>
+/// マップの解除
+/// </summary>
+void AssetArchive::Close()
+{
+	file_.Close();
+	entries_ = nullptr;
+	entryCount_ = 0;
+	strings_ = nullptr;
+}
+
+/// <summary>
+/// 項目の検索
+/// </summary>
+const AssetArchive::Entry* AssetArchive::Find(std::string_view filePath) const
+{
+	if (!entries_) {
+		return nullptr;
+	}
+
+	const std::string normalized = NormalizePath(filePath);
+	const uint64_t hash = HashPath(normalized);
+
+	const Entry* end = entries_ + entryCount_;
+	const Entry* it = std::lower_bound(entries_, end, hash, [](const Entry& entry, uint64_t value) {
+		return entry.pathHash < value;
+		});
+
+	// 同じハッシュが複数あってもパスで確かめる
+	for (; it != end && it->pathHash == hash; ++it) {
+		if (EqualsIgnoreCase(GetPath(*it), normalized)) {
+			return it;
+		}
+	}
+	return nullptr;
+}
+
+/// <summary>
+/// 項目のパス
+/// </summary>
+std::string_view AssetArchive::GetPath(const Entry& entry) const
+{
+	return std::string_view(strings_ + entry.pathOffset, entry.pathLength);
+}
+
+/// <summary>
+/// アーカイブの作成
+/// </summary>
+bool AssetArchive::Build(const std::string& sourceDirectory, const std::string& archivePath, BuildStats* outStats,
+	const std::vector<std::string>& excludeDirectories)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	std::error_code ec;
+	if (!std::filesystem::is_directory(sourceDirectory, ec)) {
+		return false;
+	}
+
+	// 出力先のアーカイブ自身は含めない
+	const std::string normalizedArchive = NormalizePath(archivePath);
+	// 除外するフォルダ
+	std::vector<std::string> normalizedExcludes;
+	for (const std::string& directory : excludeDirectories) {
+		normalizedExcludes.push_back(NormalizePath(directory));
+	}
+
+	std::vector<SourceFile> files;
+	uint32_t excludedDirectoryCount = 0;
+	for (auto it = std::filesystem::recursive_directory_iterator(sourceDirectory, ec);
+		!ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+		if (it->is_directory(ec)) {
+			// 除外するフォルダには入らない
+			const std::string directory = NormalizePath(it->path().generic_string());
+			for (const std::string& exclude : normalizedExcludes) {
+				if (EqualsIgnoreCase(directory, exclude)) {
+					it.disable_recursion_pending();
+					++excludedDirectoryCount;
+					break;
+				}
+			}
+			continue;
+		}
+		if (!it->is_regular_file(ec)) {
+			continue;
+		}
+		SourceFile file;
+		file.sourcePath = it->path();
+		file.path = NormalizePath(it->path().generic_string());
+		if (it->path().extension() == ".pak" || EqualsIgnoreCase(file.path, normalizedArchive)) {
+			continue;
+		}
+		file.hash = HashPath(file.path);
+		file.size = static_cast<uint64_t>(it->file_size(ec));
+		file.writeTime = static_cast<int64_t>(it->last_write_time(ec).time_since_epoch().count());
+		files.push_back(std::move(file));
+	}
+	if (ec) {
+		return false;
+	}
+
+	// ハッシュ順 (同じハッシュならパス順) にして、大文字小文字だけ違う重複は先の方を残す
+	std::sort(files.begin(), files.end(), [](const SourceFile& a, const SourceFile& b) {
+		return a.hash != b.hash ? a.hash < b.hash : a.path < b.path;
+		});
+	files.erase(std::unique(files.begin(), files.end(), [](const SourceFile& a, const SourceFile& b) {
+		return a.hash == b.hash && EqualsIgnoreCase(a.path, b.path);
+		}), files.end());
+
+	// 配置を決める
+	Header header{};
+	std::memcpy(header.magic, kMagic, sizeof(kMagic));
+	header.version = kVersion;
+	header.entryCount = static_cast<uint32_t>(files.size());
+	header.dataAlignment = kDataAlignment;
+	header.tocOffset = AlignUp(sizeof(Header), kDataAlignment);
+	header.stringsOffset = header.tocOffset + uint64_t(header.entryCount) * sizeof(Entry);
+
+	std::vector<Entry> entries(files.size());
+	std::string strings;
+	for (size_t i = 0; i < files.size(); ++i) {
+		entries[i].pathHash = files[i].hash;
+		entries[i].size = files[i].size;
+		entries[i].writeTime = files[i].writeTime;
+		entries[i].pathOffset = static_cast<uint32_t>(strings.size());
+		entries[i].pathLength = static_cast<uint32_t>(files[i].path.size());
+		strings += files[i].path;
+	}
+	header.dataOffset = AlignUp(header.stringsOffset + strings.size(), kDataAlignment);
+
+	uint64_t offset = header.dataOffset;
+	for (Entry& entry : entries) {
+		entry.offset = offset;
+		offset = AlignUp(offset + entry.size, kDataAlignment);
+	}
+	header.fileSize = entries.empty() ? header.dataOffset : entries.back().offset + entries.back().size;
+
+	// 一時ファイルに書いてから置き換える (途中で失敗しても古いアーカイブは壊さない)
+	const std::filesystem::path outputPath = archivePath;
+	if (outputPath.has_parent_path()) {
+		std::filesystem::create_directories(outputPath.parent_path(), ec);
+	}
+	const std::string temporaryPath = archivePath + ".tmp";
+	{
+		std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+		if (!output) {
+			return false;
+		}
+
+		const char zeros[kDataAlignment] = {};
+		auto padTo = [&](uint64_t position) {
+			const uint64_t current = static_cast<uint64_t>(output.tellp());
+			if (position > current) {
+				output.write(zeros, static_cast<std::streamsize>(position - current));
+			}
+			};
+
+		output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		padTo(header.tocOffset);
+		output.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(Entry)));
+		output.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+
+		for (size_t i = 0; i < files.size(); ++i) {
+			padTo(entries[i].offset);
+			if (entries[i].size == 0) {
+				continue;
+			}
+			MappedFile source;
+			if (!source.Open(files[i].sourcePath.string()) || source.GetSize() != entries[i].size) {
+				output.close();
+				std::filesystem::remove(temporaryPath, ec);
+				return false;
+			}
+			output.write(reinterpret_cast<const char*>(source.GetData()), static_cast<std::streamsize>(source.GetSize()));
+		}
+		if (!output) {
+			output.close();
+			std::filesystem::remove(temporaryPath, ec);
+			return false;
+		}
+	}
+
+	std::filesystem::rename(temporaryPath, outputPath, ec);
+	if (ec) {
+		std::filesystem::remove(temporaryPath, ec);
+		return false;
+	}
+
+	if (outStats) {
+		outStats->fileCount = header.entryCount;
+		outStats->excludedDirectoryCount = excludedDirectoryCount;
+		outStats->sourceBytes = 0;
+		for (const SourceFile& file : files) {
+			outStats->sourceBytes += file.size;
+		}
+		outStats->archiveBytes = header.fileSize;
+		outStats->elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+	return true;
+}
+
+/// <summary>
+/// パスの表記をそろえる
+/// </summary>
+std::string AssetArchive::NormalizePath(std::string_view filePath)
+{
+	std::string path(filePath);
+	std::replace(path.begin(), path.end(), '\\', '/');
+
+	// "/" で区切って "." と空の要素を除き、".." は1つ前を消す
+	std::vector<std::string_view> segments;
+	std::string_view rest = path;
+	const bool absolute = !rest.empty() && rest.front() == '/';
+	while (!rest.empty()) {
+		const size_t slash = rest.find('/');
+		std::string_view segment = rest.substr(0, slash);
+		rest = slash == std::string_view::npos ? std::string_view() : rest.substr(slash + 1);
+
+		// Windowsと同じく末尾の "." は無視する ("Resources./images./a.png" の書き方があるため)
+		if (segment != "." && segment != "..") {
+			while (!segment.empty() && segment.back() == '.') {
+				segment.remove_suffix(1);
+			}
+		}
+
+		if (segment.empty() || segment == ".") {
+			continue;
+		}
+		if (segment == ".." && !segments.empty() && segments.back() != "..") {
+			segments.pop_back();
+			continue;
+		}
+		segments.push_back(segment);
+	}
+
+	std::string result = absolute ? "/" : "";
+	for (size_t i = 0; i < segments.size(); ++i) {
+		if (i > 0) {
+			result += '/';
+		}
+		result += segments[i];
+	}
+	return result;
+}
+
+/// <summary>
+/// パスのハッシュ (FNV-1a 64bit)
+/// </summary>
+uint64_t AssetArchive::HashPath(std::string_view normalizedPath)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (char c : normalizedPath) {
+		hash ^= static_cast<uint8_t>(ToLowerAscii(c));
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Engine
+#include "MappedFile.h"
+
+/// <summary>
+/// Resources/ を1つにまとめたアーカイブ (D3D12には依存しない)
+/// ヘッダー・目次・パス文字列・データの順に並べ、目次はパスのハッシュ順にして二分探索で引く
+/// 読み込み時はファイル全体をメモリマップし、各ファイルの中身はマップをそのまま指す
+/// </summary>
+class AssetArchive
+{
+public: // 構造体
+
+	// ファイルの先頭
+	struct Header {
+		char magic[4];			// "YPAK"
+		uint32_t version;
+		uint32_t entryCount;
+		uint32_t dataAlignment;
+		uint64_t tocOffset;		// 目次 (Entry の配列) の位置
+		uint64_t stringsOffset;	// パス文字列の位置
+		uint64_t dataOffset;	// 最初のデータの位置
+		uint64_t fileSize;		// 途中で切れていないかの確認用
+	};
+	static_assert(sizeof(Header) == 48);
+
+	// 目次の1項目
+	struct Entry {
+		uint64_t pathHash;		// 正規化したパスを小文字にした FNV-1a
+		uint64_t offset;		// データの位置 (kDataAlignment の倍数)
+		uint64_t size;
+		int64_t writeTime;		// 元ファイルの更新日時 (std::filesystem の値、キャッシュの鮮度判定に使う)
+		uint32_t pathOffset;	// パス文字列内の位置
+		uint32_t pathLength;
+	};
+	static_assert(sizeof(Entry) == 40);
+
+	// 作成結果
+	struct BuildStats {
+		uint32_t fileCount = 0;
+		uint32_t excludedDirectoryCount = 0;	// excludeDirectories で飛ばしたフォルダ数
+		uint64_t sourceBytes = 0;	// 元ファイルの合計
+		uint64_t archiveBytes = 0;	// アーカイブのサイズ
+		float elapsedMs = 0.0f;
+	};
+
+public: // 定数
+
+	static constexpr char kMagic[4] = { 'Y', 'P', 'A', 'K' };
+	// 形式が変わったら上げる
+	static constexpr uint32_t kVersion = 1;
+	// 目次と各データの先頭をそろえる境界 (キャッシュライン)
+	static constexpr uint32_t kDataAlignment = 64;
+
+public: // メンバ関数
+
+	AssetArchive() = default;
+	~AssetArchive() = default;
+
+	AssetArchive(const AssetArchive&) = delete;
+	AssetArchive& operator=(const AssetArchive&) = delete;
+
+	/// <summary>
+	/// アーカイブをマップして目次を確認する (壊れていれば false)
+	/// </summary>
+	bool Open(const std::string& archivePath);
+
+	/// <summary>
+	/// マップの解除
+	/// </summary>
+	void Close();
+
+	/// <summary>
+	/// パスに対応する項目の取得 (無ければ nullptr、大文字小文字と "\\"・"./" の違いは無視する)
+	/// </summary>
+	const Entry* Find(std::string_view filePath) const;
+
+	/// <summary>
+	/// 項目の中身 (マップを直接指す)
+	/// </summary>
+	const uint8_t* GetData(const Entry& entry) const { return file_.GetData() + entry.offset; }
+
+	/// <summary>
+	/// 項目のパス (Resources/ を含む、作成時の大文字小文字のまま)
+	/// </summary>
+	std::string_view GetPath(const Entry& entry) const;
+
+	bool IsOpen() const { return entries_ != nullptr; }
+	uint32_t GetEntryCount() const { return entryCount_; }
+	const Entry* GetEntries() const { return entries_; }
+
+	/// <summary>
+	/// フォルダ以下の全ファイルをまとめたアーカイブを書き出す
+	/// </summary>
+	/// <param name="sourceDirectory">まとめるフォルダ (パスはこのフォルダ名から記録する)</param>
+	/// <param name="archivePath">出力先 (sourceDirectory の中でもよい、.pak は含めない)</param>
+	/// <param name="excludeDirectories">含めないフォルダ (sourceDirectory から始まるパス、実行時に作り直すキャッシュなど)</param>
+	static bool Build(const std::string& sourceDirectory, const std::string& archivePath, BuildStats* outStats = nullptr,
+		const std::vector<std::string>& excludeDirectories = {});
+
+	/// <summary>
+	/// パスの表記ゆれ ("\\"、"./"、"a/../"、連続した "/") をそろえる
+	/// </summary>
+	static std::string NormalizePath(std::string_view filePath);
+
+	/// <summary>
+	/// 正規化したパスのハッシュ (大文字小文字は区別しない)
+	/// </summary>
+	static uint64_t HashPath(std::string_view normalizedPath);
+
+private:
+	MappedFile file_;
+	const Entry* entries_ = nullptr;
+	uint32_t entryCount_ = 0;
+	const char* strings_ = nullptr;
+};
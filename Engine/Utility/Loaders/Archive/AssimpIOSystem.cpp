@@ -0,0 +1,80 @@
+#include "AssimpIOSystem.h"
+
+// C++
+#include <algorithm>
+#include <cstring>
+
+/// <summary>
+/// ファイルがあるか
+/// </summary>
+bool AssimpIOSystem::Exists(const char* pFile) const
+{
+	return FileSystem::GetInstance()->Exists(pFile);
+}
+
+/// <summary>
+/// ファイルを開く (書き込みには対応しない)
+/// </summary>
+Assimp::IOStream* AssimpIOSystem::Open(const char* pFile, const char* pMode)
+{
+	if (std::strchr(pMode, 'w') || std::strchr(pMode, 'a')) {
+		return nullptr;
+	}
+	FileSystem::FileView view = FileSystem::GetInstance()->Open(pFile);
+	if (!view.IsValid()) {
+		return nullptr;
+	}
+	return new AssimpIOStream(std::move(view));
+}
+
+/// <summary>
+/// ファイルを閉じる
+/// </summary>
+void AssimpIOSystem::Close(Assimp::IOStream* pFile)
+{
+	delete pFile;
+}
+
+/// <summary>
+/// 読み込み (fread と同じく読めた要素数を返す)
+/// </summary>
+size_t AssimpIOStream::Read(void* pvBuffer, size_t pSize, size_t pCount)
+{
+	if (pSize == 0 || pCount == 0) {
+		return 0;
+	}
+	const size_t remaining = view_.GetSize() - position_;
+	const size_t count = (std::min)(pCount, remaining / pSize);
+	std::memcpy(pvBuffer, view_.GetData() + position_, count * pSize);
+	position_ += count * pSize;
+	return count;
+}
+
+/// <summary>
+/// 読み取り位置の移動 (aiOrigin_END の pOffset は末尾からの距離)
+/// </summary>
+aiReturn AssimpIOStream::Seek(size_t pOffset, aiOrigin pOrigin)
+{
+	size_t position = 0;
+	switch (pOrigin) {
+	case aiOrigin_SET:
+		position = pOffset;
+		break;
+	case aiOrigin_CUR:
+		position = position_ + pOffset;
+		break;
+	case aiOrigin_END:
+		if (pOffset > view_.GetSize()) {
+			return aiReturn_FAILURE;
+		}
+		position = view_.GetSize() - pOffset;
+		break;
+	default:
+		return aiReturn_FAILURE;
+	}
+	if (position > view_.GetSize()) {
+		return aiReturn_FAILURE;
+	}
+	position_ = position;
+	return aiReturn_SUCCESS;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+// assimp
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+
+// Engine
+#include "FileSystem.h"
+
+/// <summary>
+/// Assimp の読み込みを FileSystem 経由にする
+/// .obj から参照する .mtl や .gltf の .bin もアーカイブから読めるように、Importer::SetIOHandler で渡す
+/// </summary>
+class AssimpIOSystem : public Assimp::IOSystem
+{
+public:
+	bool Exists(const char* pFile) const override;
+	char getOsSeparator() const override { return '/'; }
+	Assimp::IOStream* Open(const char* pFile, const char* pMode = "rb") override;
+	void Close(Assimp::IOStream* pFile) override;
+};
+
+/// <summary>
+/// FileSystem::FileView の読み取り専用ストリーム (中身はコピーしない)
+/// </summary>
+class AssimpIOStream : public Assimp::IOStream
+{
+public:
+	explicit AssimpIOStream(FileSystem::FileView view) : view_(std::move(view)) {}
+
+	size_t Read(void* pvBuffer, size_t pSize, size_t pCount) override;
+	size_t Write(const void*, size_t, size_t) override { return 0; }
+	aiReturn Seek(size_t pOffset, aiOrigin pOrigin) override;
+	size_t Tell() const override { return position_; }
+	size_t FileSize() const override { return view_.GetSize(); }
+	void Flush() override {}
+
+private:
+	FileSystem::FileView view_;
+	size_t position_ = 0;
+};
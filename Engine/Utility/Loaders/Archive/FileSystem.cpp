@@ -0,0 +1,210 @@
+#include "FileSystem.h"
+
+// C++
+#include <algorithm>
+#include <filesystem>
+#include <map>
+
+// Engine
+#include "DX./DirectXCommon.h"
+
+namespace {
+
+	// 大文字小文字をそろえたキー (一覧の重複除去用)
+	std::string ToLowerKey(std::string_view path)
+	{
+		std::string key(path);
+		std::transform(key.begin(), key.end(), key.begin(), [](char c) {
+			return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+			});
+		return key;
+	}
+}
+
+// シングルトンインスタンスの初期化
+std::unique_ptr<FileSystem> FileSystem::instance = nullptr;
+std::once_flag FileSystem::initInstanceFlag;
+
+/// <summary>
+/// シングルトンインスタンスの取得
+/// </summary>
+FileSystem* FileSystem::GetInstance()
+{
+	std::call_once(initInstanceFlag, []() {
+		instance = std::make_unique<FileSystem>();
+		});
+	return instance.get();
+}
+
+/// <summary>
+/// 初期化
+/// </summary>
+void FileSystem::Initialize(const std::string& archivePath)
+{
+	if (!archive_.Open(archivePath)) {
+		DirectXCommon::Log("FileSystem: archive not mounted, loading loose files (" + archivePath + ")\n");
+		return;
+	}
+	DirectXCommon::Log("FileSystem: mounted " + archivePath + " (" + std::to_string(archive_.GetEntryCount()) + " files, loose override " +
+		(looseFileOverride_ ? "on" : "off") + ")\n");
+}
+
+/// <summary>
+/// 終了処理
+/// </summary>
+void FileSystem::Finalize()
+{
+	archive_.Close();
+	instance.reset();
+}
+
+/// <summary>
+/// ファイルを開く
+/// </summary>
+FileSystem::FileView FileSystem::Open(const std::string& filePath) const
+{
+	// 上書きが有効ならディスクを先に見る、無効でもアーカイブに無いもの (実行中に書き出したファイル等) はディスクから読む
+	if (looseFileOverride_ || !IsMounted()) {
+		FileView view = OpenLoose(filePath);
+		return view.IsValid() ? view : OpenArchive(filePath);
+	}
+	FileView view = OpenArchive(filePath);
+	return view.IsValid() ? view : OpenLoose(filePath);
+}
+
+/// <summary>
+/// ファイルがあるか
+/// </summary>
+bool FileSystem::Exists(const std::string& filePath) const
+{
+	if (archive_.Find(filePath)) {
+		return true;
+	}
+	std::error_code ec;
+	return std::filesystem::is_regular_file(filePath, ec);
+}
+
+/// <summary>
+/// サイズと更新日時の取得
+/// </summary>
+bool FileSystem::GetStamp(const std::string& filePath, FileStamp& outStamp) const
+{
+	auto getLoose = [&]() {
+		std::error_code ec;
+		const uint64_t size = static_cast<uint64_t>(std::filesystem::file_size(filePath, ec));
+		if (ec) {
+			return false;
+		}
+		const int64_t writeTime = static_cast<int64_t>(std::filesystem::last_write_time(filePath, ec).time_since_epoch().count());
+		if (ec) {
+			return false;
+		}
+		outStamp = { size, writeTime };
+		return true;
+		};
+	auto getArchive = [&]() {
+		const AssetArchive::Entry* entry = archive_.Find(filePath);
+		if (!entry) {
+			return false;
+		}
+		outStamp = { entry->size, entry->writeTime };
+		return true;
+		};
+
+	// Open と同じ順で探す
+	if (looseFileOverride_ || !IsMounted()) {
+		return getLoose() || getArchive();
+	}
+	return getArchive() || getLoose();
+}
+
+/// <summary>
+/// フォルダ直下のファイルの一覧
+/// </summary>
+std::vector<std::string> FileSystem::EnumerateFiles(const std::string& directory) const
+{
+	const std::string normalizedDirectory = AssetArchive::NormalizePath(directory);
+	const std::string directoryKey = ToLowerKey(normalizedDirectory) + "/";
+
+	// 小文字のパス → 表示用のパス (ディスクの方を優先する)
+	std::map<std::string, std::string> files;
+
+	std::error_code ec;
+	if (std::filesystem::is_directory(directory, ec)) {
+		for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+			if (!entry.is_regular_file(ec)) {
+				continue;
+			}
+			std::string path = AssetArchive::NormalizePath(entry.path().generic_string());
+			files.emplace(ToLowerKey(path), std::move(path));
+		}
+	}
+
+	for (uint32_t i = 0; i < archive_.GetEntryCount(); ++i) {
+		const std::string_view path = archive_.GetPath(archive_.GetEntries()[i]);
+		if (path.size() <= directoryKey.size() || path.find('/', directoryKey.size()) != std::string_view::npos) {
+			continue;
+		}
+		std::string key = ToLowerKey(path);
+		if (key.compare(0, directoryKey.size(), directoryKey) == 0) {
+			files.emplace(std::move(key), std::string(path));
+		}
+	}
+
+	std::vector<std::string> result;
+	result.reserve(files.size());
+	for (auto& [key, path] : files) {
+		result.push_back(std::move(path));
+	}
+	return result;
+}
+
+/// <summary>
+/// Resources/ をアーカイブにまとめる
+/// </summary>
+bool FileSystem::PackResources(const std::string& archivePath)
+{
+	AssetArchive::BuildStats stats;
+	if (!AssetArchive::Build(kSourceDirectory, archivePath, &stats, kGeneratedDirectories)) {
+		DirectXCommon::Log("FileSystem: failed to pack " + kSourceDirectory + " into " + archivePath + "\n");
+		return false;
+	}
+	DirectXCommon::Log("FileSystem: packed " + std::to_string(stats.fileCount) + " files (" +
+		std::to_string(stats.sourceBytes) + " -> " + std::to_string(stats.archiveBytes) + " bytes) in " +
+		std::to_string(stats.elapsedMs) + "ms, skipped " + std::to_string(stats.excludedDirectoryCount) + " generated folders\n");
+	return true;
+}
+
+/// <summary>
+/// 単体ファイルを開く
+/// </summary>
+FileSystem::FileView FileSystem::OpenLoose(const std::string& filePath)
+{
+	FileView view;
+	auto file = std::make_shared<MappedFile>();
+	if (!file->Open(filePath)) {
+		return view;
+	}
+	view.data_ = file->GetData();
+	view.size_ = file->GetSize();
+	view.valid_ = true;
+	view.looseFile_ = std::move(file);
+	return view;
+}
+
+/// <summary>
+/// アーカイブから開く
+/// </summary>
+FileSystem::FileView FileSystem::OpenArchive(const std::string& filePath) const
+{
+	FileView view;
+	const AssetArchive::Entry* entry = archive_.Find(filePath);
+	if (!entry) {
+		return view;
+	}
+	view.data_ = archive_.GetData(*entry);
+	view.size_ = static_cast<size_t>(entry->size);
+	view.valid_ = true;
+	view.fromArchive_ = true;
+	return view;
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Engine
+#include "AssetArchive.h"
+#include "MappedFile.h"
+
+/// <summary>
+/// 素材の読み込み口 (仮想ファイルシステム)
+/// Resources/ をまとめたアーカイブをマウントし、各ローダーはここを通して読む
+/// 単体ファイルの上書きが有効な間は、ディスク上のファイルがあればアーカイブより優先する (開発中の編集用)
+/// </summary>
+class FileSystem
+{
+public: // 構造体
+
+	/// <summary>
+	/// 読み込んだファイルの中身 (コピーはしない)
+	/// アーカイブ内ならアーカイブのマップを、単体ファイルならそのファイルのマップを指す
+	/// アーカイブ内の中身は FileSystem::Finalize まで有効
+	/// </summary>
+	class FileView {
+	public:
+		bool IsValid() const { return valid_; }
+		bool IsFromArchive() const { return fromArchive_; }
+		const uint8_t* GetData() const { return data_; }
+		size_t GetSize() const { return size_; }
+		std::string_view GetText() const { return std::string_view(reinterpret_cast<const char*>(data_), size_); }
+
+	private:
+		friend class FileSystem;
+		const uint8_t* data_ = nullptr;
+		size_t size_ = 0;
+		bool valid_ = false;
+		bool fromArchive_ = false;
+		// 単体ファイルのマップ (コピーしたビューの間で共有する)
+		std::shared_ptr<MappedFile> looseFile_;
+	};
+
+	// キャッシュの鮮度判定に使う情報
+	struct FileStamp {
+		uint64_t size = 0;
+		int64_t writeTime = 0;	// std::filesystem::last_write_time の値
+	};
+
+public: // メンバ関数
+
+	/// <summary>
+	/// シングルトンインスタンスの取得
+	/// </summary>
+	static FileSystem* GetInstance();
+
+	FileSystem() = default;
+	~FileSystem() = default;
+
+	/// <summary>
+	/// 初期化 (アーカイブがあればマウントする、無ければ単体ファイルだけで動く)
+	/// </summary>
+	void Initialize(const std::string& archivePath = kArchivePath);
+
+	/// <summary>
+	/// 終了処理 (アーカイブのマップを解除する)
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// ファイルを開く (見つからなければ IsValid() が false)
+	/// </summary>
+	FileView Open(const std::string& filePath) const;
+
+	/// <summary>
+	/// ファイルがあるか
+	/// </summary>
+	bool Exists(const std::string& filePath) const;
+
+	/// <summary>
+	/// サイズと更新日時の取得 (アーカイブ内なら作成時の元ファイルの値)
+	/// </summary>
+	bool GetStamp(const std::string& filePath, FileStamp& outStamp) const;
+
+	/// <summary>
+	/// フォルダ直下のファイルの一覧 (アーカイブと単体ファイルを合わせる、サブフォルダは含まない)
+	/// </summary>
+	/// <returns>正規化したパス (名前順)</returns>
+	std::vector<std::string> EnumerateFiles(const std::string& directory) const;
+
+	/// <summary>
+	/// 単体ファイルの上書きの切り替え (デフォルトはDebugで有効、Releaseで無効)
+	/// </summary>
+	void SetLooseFileOverride(bool enable) { looseFileOverride_ = enable; }
+	bool IsLooseFileOverride() const { return looseFileOverride_; }
+
+	bool IsMounted() const { return archive_.IsOpen(); }
+	const AssetArchive& GetArchive() const { return archive_; }
+
+	/// <summary>
+	/// Resources/ をアーカイブにまとめる (起動引数 kPackArgument で呼ばれるビルド手順)
+	/// </summary>
+	static bool PackResources(const std::string& archivePath = kArchivePath);
+
+public: // 定数
+
+	// まとめる素材のフォルダ
+	static inline const std::string kSourceDirectory = "Resources";
+	// アーカイブの出力先 (Cooked は無視リストに入っている)
+	static inline const std::string kArchivePath = "Resources/Cooked/Resources.pak";
+	// まとめないフォルダ (実行時に作り直すもの: クック済みテクスチャ・LOD、アトラスのページとマニフェスト)
+	// アーカイブに入れると単体ファイルの上書きが無効な時に古い中身が優先されてしまう
+	static inline const std::vector<std::string> kGeneratedDirectories = { "Resources/Cooked", "Resources/Atlas" };
+	// アーカイブを作って終了する起動引数
+	static inline const std::string kPackArgument = "--pack-assets";
+
+private:
+
+	/// <summary>
+	/// 単体ファイルを開く
+	/// </summary>
+	static FileView OpenLoose(const std::string& filePath);
+
+	/// <summary>
+	/// アーカイブから開く
+	/// </summary>
+	FileView OpenArchive(const std::string& filePath) const;
+
+private: // メンバ変数
+
+	// シングルトンインスタンス
+	static std::unique_ptr<FileSystem> instance;
+	static std::once_flag initInstanceFlag;
+
+	FileSystem(FileSystem&) = delete;
+	FileSystem& operator=(FileSystem&) = delete;
+
+	AssetArchive archive_;
+#ifdef _DEBUG
+	bool looseFileOverride_ = true;
+#else
+	bool looseFileOverride_ = false;
+#endif
+};
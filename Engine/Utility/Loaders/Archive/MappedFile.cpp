@@ -0,0 +1,131 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& filePath)
+{
+	Close();
+
+	// パスはUTF-8として扱う
+	const int length = MultiByteToWideChar(CP_UTF8, 0, filePath.c_str(), -1, nullptr, 0);
+	if (length <= 0) {
+		return false;
+	}
+	std::wstring filePathW(static_cast<size_t>(length), L'\0');
+	MultiByteToWideChar(CP_UTF8, 0, filePath.c_str(), -1, filePathW.data(), length);
+
+	HANDLE file = CreateFileW(filePathW.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(file, &fileSize)) {
+		CloseHandle(file);
+		return false;
+	}
+	file_ = file;
+	size_ = static_cast<size_t>(fileSize.QuadPart);
+	isOpen_ = true;
+
+	// サイズ0はマップできないので、開けたことだけ記録する
+	if (size_ == 0) {
+		return true;
+	}
+
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr) {
+		Close();
+		return false;
+	}
+	mapping_ = mapping;
+
+	data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (data_ == nullptr) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (data_) {
+		UnmapViewOfFile(data_);
+	}
+	if (mapping_) {
+		CloseHandle(static_cast<HANDLE>(mapping_));
+	}
+	if (file_) {
+		CloseHandle(static_cast<HANDLE>(file_));
+	}
+	data_ = nullptr;
+	mapping_ = nullptr;
+	file_ = nullptr;
+	size_ = 0;
+	isOpen_ = false;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& filePath)
+{
+	Close();
+
+	const int file = open(filePath.c_str(), O_RDONLY);
+	if (file < 0) {
+		return false;
+	}
+
+	struct stat status {};
+	if (fstat(file, &status) != 0 || !S_ISREG(status.st_mode)) {
+		close(file);
+		return false;
+	}
+	size_ = static_cast<size_t>(status.st_size);
+	isOpen_ = true;
+
+	if (size_ > 0) {
+		void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file, 0);
+		if (data == MAP_FAILED) {
+			close(file);
+			size_ = 0;
+			isOpen_ = false;
+			return false;
+		}
+		data_ = static_cast<const uint8_t*>(data);
+	}
+
+	// マップした後はファイル記述子がなくても中身は読める
+	close(file);
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (data_) {
+		munmap(const_cast<uint8_t*>(data_), size_);
+	}
+	data_ = nullptr;
+	mapping_ = nullptr;
+	file_ = nullptr;
+	size_ = 0;
+	isOpen_ = false;
+}
+
+#endif
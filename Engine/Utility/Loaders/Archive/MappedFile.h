@@ -0,0 +1,43 @@
+#pragma once
+
+// C++
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// <summary>
+/// 読み取り専用でメモリマップしたファイル
+/// 中身はOSのページキャッシュをそのまま指すので、読み込みのコピーが発生しない
+/// </summary>
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/// <summary>
+	/// ファイル全体をマップする (サイズ0のファイルも成功扱い)
+	/// </summary>
+	bool Open(const std::string& filePath);
+
+	/// <summary>
+	/// マップの解除
+	/// </summary>
+	void Close();
+
+	bool IsOpen() const { return isOpen_; }
+	const uint8_t* GetData() const { return data_; }
+	size_t GetSize() const { return size_; }
+
+private:
+	const uint8_t* data_ = nullptr;
+	size_t size_ = 0;
+	bool isOpen_ = false;
+
+	// Windowsのファイルとマッピングのハンドル (それ以外ではマップ後すぐ閉じるので使わない)
+	void* file_ = nullptr;
+	void* mapping_ = nullptr;
+};
@@ -1,5 +1,6 @@
 #include "JsonManager.h"
 #include <filesystem>
+#include "Loaders/Archive/FileSystem.h"
 
 JsonManager::JsonManager(const std::string& fileName, const std::string& folderPath)
 	: fileName_(fileName), folderPath_(folderPath)
@@ -37,16 +38,17 @@ void JsonManager::Unregister(const std::string& name)
 
 	// JSONファイルから削除
 	std::string fullPath = MakeFullPath(folderPath_, fileName_);
-	std::ifstream ifs(fullPath);
-	if (!ifs)
+	FileSystem::FileView file = FileSystem::GetInstance()->Open(fullPath);
+	if (!file.IsValid())
 	{
 		std::cerr << "ファイルを開けませんでした: " << fullPath << std::endl;
 		return;
 	}
 
-	nlohmann::json jsonData;
-	ifs >> jsonData;
-	ifs.close();
+	const std::string_view text = file.GetText();
+	nlohmann::json jsonData = nlohmann::json::parse(text.begin(), text.end());
+	// 書き戻す前にマップを閉じる
+	file = {};
 
 	// JSONデータから該当のキーを削除
 	if (jsonData.contains(name))
@@ -113,23 +115,18 @@ void JsonManager::Save()
 void JsonManager::LoadAll()
 {
 	std::string fullPath = MakeFullPath(folderPath_, fileName_);
-	std::ifstream ifs(fullPath);
-	if (!ifs)
+	FileSystem::FileView file = FileSystem::GetInstance()->Open(fullPath);
+	if (!file.IsValid())
 	{
 		// ファイルが存在しない場合などは何もしない（新規作成扱い）
 		return;
 	}
 
-	// ファイルサイズをチェックするために末尾にシーク
-	ifs.seekg(0, std::ios::end);
-	std::streampos fileSize = ifs.tellg();
-	ifs.seekg(0, std::ios::beg);
-
 	// ファイルサイズが 0（空）なら、新規ファイルとして扱う
-	if (fileSize == 0)
+	if (file.GetSize() == 0)
 	{
 		// いったん閉じる
-		ifs.close();
+		file = {};
 
 		// 登録された変数で Save()（=「初期値をJSONとして書き出し」）し、終了
 		Save();
@@ -137,9 +134,8 @@ void JsonManager::LoadAll()
 	}
 
 	// JSON として読み込み
-	nlohmann::json jsonData;
-	ifs >> jsonData;
-	ifs.close();
+	const std::string_view text = file.GetText();
+	nlohmann::json jsonData = nlohmann::json::parse(text.begin(), text.end());
 
 	// JSON から各変数に反映
 	for (auto& pair : variables_)
@@ -0,0 +1,119 @@
+#include "MeshLodCache.h"
+
+// C++
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+// Engine
+#include "Loaders/Archive/FileSystem.h"
+
+namespace {
+	// 生成の手順やファイルの形を変えたら上げる (古いキャッシュは自然に使われなくなる)
+	constexpr uint32_t kCookVersion = 1;
+	constexpr uint32_t kMagic = 0x444F4C59; // "YLOD"
+
+	// ファイルの先頭
+	struct Header {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t lodCount;
+		uint32_t lodIndexCount;
+	};
+
+	/// <summary>
+	/// FNV-1a 64bit
+	/// </summary>
+	uint64_t HashBytes(const void* data, size_t size, uint64_t hash = 14695981039346656037ull)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; ++i) {
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+}
+
+namespace MeshLodCache {
+
+	uint64_t HashMesh(const void* vertices, size_t vertexBytes, const std::vector<uint32_t>& indices)
+	{
+		uint64_t hash = HashBytes(vertices, vertexBytes);
+		hash = HashBytes(indices.data(), indices.size() * sizeof(uint32_t), hash);
+
+		// 簡略化の設定が変わったら別のキャッシュになる
+		const float settings[] = {
+			static_cast<float>(MeshSimplifier::kMaxLodCount), MeshSimplifier::kLodReduction,
+			MeshSimplifier::kLodTargetError, MeshSimplifier::kMinLodReduction };
+		hash = HashBytes(settings, sizeof(settings), hash);
+		return HashBytes(&kCookVersion, sizeof(kCookVersion), hash);
+	}
+
+	std::string GetCachePath(uint64_t hash, const std::string& cacheDirectory)
+	{
+		char name[32];
+		std::snprintf(name, sizeof(name), "%016llx.lod", static_cast<unsigned long long>(hash));
+		return cacheDirectory + "/" + name;
+	}
+
+	bool Read(const std::string& cachePath, uint32_t indexCount, uint32_t vertexCount,
+		std::vector<MeshSimplifier::Lod>& outLods, std::vector<uint32_t>& outLodIndices)
+	{
+		FileSystem::FileView file = FileSystem::GetInstance()->Open(cachePath);
+		if (!file.IsValid() || file.GetSize() < sizeof(Header)) {
+			return false;
+		}
+
+		Header header;
+		std::memcpy(&header, file.GetData(), sizeof(Header));
+		const size_t size = sizeof(Header) + size_t(header.lodCount) * sizeof(MeshSimplifier::Lod) + size_t(header.lodIndexCount) * sizeof(uint32_t);
+		if (header.magic != kMagic || header.version != kCookVersion || header.lodCount == 0 ||
+			header.lodCount > MeshSimplifier::kMaxLodCount || file.GetSize() != size) {
+			return false;
+		}
+
+		const uint8_t* data = static_cast<const uint8_t*>(file.GetData()) + sizeof(Header);
+		std::vector<MeshSimplifier::Lod> lods(header.lodCount);
+		std::memcpy(lods.data(), data, lods.size() * sizeof(MeshSimplifier::Lod));
+		std::vector<uint32_t> lodIndices(header.lodIndexCount);
+		std::memcpy(lodIndices.data(), data + lods.size() * sizeof(MeshSimplifier::Lod), lodIndices.size() * sizeof(uint32_t));
+
+		// 範囲が元のインデックスの後ろに収まり、頂点の外を指していないこと
+		if (lods[0].indexOffset != 0 || lods[0].indexCount != indexCount) {
+			return false;
+		}
+		for (size_t i = 1; i < lods.size(); ++i) {
+			if (lods[i].indexOffset < indexCount || lods[i].indexCount % 3 != 0 ||
+				size_t(lods[i].indexOffset - indexCount) + lods[i].indexCount > lodIndices.size()) {
+				return false;
+			}
+		}
+		for (uint32_t index : lodIndices) {
+			if (index >= vertexCount) {
+				return false;
+			}
+		}
+
+		outLods = std::move(lods);
+		outLodIndices = std::move(lodIndices);
+		return true;
+	}
+
+	bool Write(const std::string& cachePath, const std::vector<MeshSimplifier::Lod>& lods, const std::vector<uint32_t>& lodIndices)
+	{
+		std::error_code ec;
+		std::filesystem::create_directories(std::filesystem::path(cachePath).parent_path(), ec);
+		std::ofstream file(cachePath, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			return false;
+		}
+
+		const Header header = { kMagic, kCookVersion, static_cast<uint32_t>(lods.size()), static_cast<uint32_t>(lodIndices.size()) };
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(lods.data()), std::streamsize(lods.size() * sizeof(MeshSimplifier::Lod)));
+		file.write(reinterpret_cast<const char*>(lodIndices.data()), std::streamsize(lodIndices.size() * sizeof(uint32_t)));
+		return static_cast<bool>(file);
+	}
+}
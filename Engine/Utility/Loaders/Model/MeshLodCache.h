@@ -0,0 +1,73 @@
+#pragma once
+
+// C++
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Engine
+#include "MeshSimplifier.h"
+
+/// <summary>
+/// LODのクック (MeshSimplifier の結果をモデルごとにキャッシュする)
+/// 最適化後の頂点・インデックスの中身と簡略化の設定からハッシュを作り、一致するファイルがあれば読むだけで済ませる
+/// (D3D12・Assimpには依存しない)
+/// </summary>
+namespace MeshLodCache {
+
+	// キャッシュの出力先
+	static inline const std::string kCacheDirectory = "Resources/Cooked/Models";
+
+	// 読み込み結果
+	struct Result {
+		bool cacheHit = false;		// キャッシュから読んだか
+		float elapsedMs = 0.0f;		// 読み込み (+生成) にかかった時間
+	};
+
+	/// <summary>
+	/// メッシュの中身と簡略化の設定のハッシュ
+	/// </summary>
+	uint64_t HashMesh(const void* vertices, size_t vertexBytes, const std::vector<uint32_t>& indices);
+
+	/// <summary>
+	/// キャッシュファイルのパス
+	/// </summary>
+	std::string GetCachePath(uint64_t hash, const std::string& cacheDirectory = kCacheDirectory);
+
+	/// <summary>
+	/// キャッシュを読む (無い・壊れている・メッシュと合わない時は false)
+	/// </summary>
+	/// <param name="indexCount">LOD0のインデックス数</param>
+	/// <param name="vertexCount">インデックスが指してよい頂点数</param>
+	bool Read(const std::string& cachePath, uint32_t indexCount, uint32_t vertexCount,
+		std::vector<MeshSimplifier::Lod>& outLods, std::vector<uint32_t>& outLodIndices);
+
+	/// <summary>
+	/// キャッシュを書き出す (失敗しても読み込みには影響しない)
+	/// </summary>
+	bool Write(const std::string& cachePath, const std::vector<MeshSimplifier::Lod>& lods, const std::vector<uint32_t>& lodIndices);
+
+	/// <summary>
+	/// キャッシュしたLODを読む。無ければ MeshSimplifier::GenerateLods で作って書き出す
+	/// </summary>
+	template<class Vertex>
+	Result Load(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+		std::vector<MeshSimplifier::Lod>& outLods, std::vector<uint32_t>& outLodIndices,
+		const std::string& cacheDirectory = kCacheDirectory)
+	{
+		Result result;
+		const auto start = std::chrono::steady_clock::now();
+
+		const std::string cachePath = GetCachePath(HashMesh(vertices.data(), vertices.size() * sizeof(Vertex), indices), cacheDirectory);
+		if (Read(cachePath, static_cast<uint32_t>(indices.size()), static_cast<uint32_t>(vertices.size()), outLods, outLodIndices)) {
+			result.cacheHit = true;
+		} else {
+			outLods = MeshSimplifier::GenerateLods(vertices, indices, outLodIndices);
+			Write(cachePath, outLods, outLodIndices);
+		}
+
+		result.elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+		return result;
+	}
+}
@@ -0,0 +1,390 @@
+#include "MeshOptimizer.h"
+
+// C++
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+	// FNV-1a
+	uint64_t HashBytes(const void* data, uint32_t size)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		uint64_t hash = 14695981039346656037ull;
+		for (uint32_t i = 0; i < size; ++i) {
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	/// <summary>
+	/// FIFOキャッシュ (時刻で管理) に三角形を通して、入っていなかった頂点数を返す
+	/// </summary>
+	uint32_t UpdateFifoCache(const uint32_t* triangle, std::vector<uint32_t>& timestamps, uint32_t& time, uint32_t cacheSize)
+	{
+		uint32_t misses = 0;
+		for (uint32_t k = 0; k < 3; ++k) {
+			const uint32_t v = triangle[k];
+			if (time - timestamps[v] > cacheSize) {
+				timestamps[v] = time++;
+				++misses;
+			}
+		}
+		return misses;
+	}
+
+	// Forsythの頂点スコア
+	float VertexScore(int32_t cachePosition, uint32_t liveTriangles)
+	{
+		if (liveTriangles == 0) {
+			return -1.0f;
+		}
+
+		float score = 0.0f;
+		if (cachePosition >= 0) {
+			if (cachePosition < 3) {
+				// 直前の三角形の頂点は少し下げる (同じ辺ばかり使わないように)
+				score = 0.75f;
+			} else {
+				const float scale = 1.0f / static_cast<float>(MeshOptimizer::kOptimizeCacheSize - 3);
+				score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scale, 1.5f);
+			}
+		}
+		// 残りの三角形が少ない頂点を先に使い切る
+		score += 2.0f / std::sqrt(static_cast<float>(liveTriangles));
+		return score;
+	}
+}
+
+namespace MeshOptimizer {
+
+	CacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize)
+	{
+		CacheStats stats;
+		const size_t triangleCount = indices.size() / 3;
+		if (triangleCount == 0 || vertexCount == 0) {
+			return stats;
+		}
+
+		std::vector<uint32_t> timestamps(vertexCount, 0);
+		std::vector<uint8_t> used(vertexCount, 0);
+		uint32_t time = cacheSize + 1;
+		uint32_t misses = 0;
+		uint32_t usedCount = 0;
+		for (size_t i = 0; i < triangleCount; ++i) {
+			misses += UpdateFifoCache(&indices[i * 3], timestamps, time, cacheSize);
+			for (uint32_t k = 0; k < 3; ++k) {
+				uint8_t& flag = used[indices[i * 3 + k]];
+				usedCount += flag ? 0 : 1;
+				flag = 1;
+			}
+		}
+
+		stats.acmr = static_cast<float>(misses) / static_cast<float>(triangleCount);
+		stats.atvr = static_cast<float>(misses) / static_cast<float>(usedCount);
+		return stats;
+	}
+
+	uint32_t GenerateWeldRemap(std::vector<uint32_t>& remap, const void* vertices, uint32_t vertexCount, uint32_t stride, const uint32_t* vertexClasses)
+	{
+		remap.assign(vertexCount, kUnused);
+		const uint8_t* bytes = static_cast<const uint8_t*>(vertices);
+
+		// 開番地法のハッシュ表 (中身は代表の頂点番号)
+		uint32_t tableSize = 1;
+		while (tableSize < vertexCount * 2) {
+			tableSize <<= 1;
+		}
+		std::vector<uint32_t> table(tableSize, kUnused);
+
+		uint32_t newCount = 0;
+		for (uint32_t i = 0; i < vertexCount; ++i) {
+			const uint8_t* vertex = bytes + static_cast<size_t>(i) * stride;
+			const uint32_t vertexClass = vertexClasses ? vertexClasses[i] : 0;
+			uint64_t hash = HashBytes(vertex, stride);
+			hash = (hash ^ vertexClass) * 1099511628211ull;
+			uint32_t slot = static_cast<uint32_t>(hash ^ (hash >> 32)) & (tableSize - 1);
+			while (true) {
+				const uint32_t other = table[slot];
+				if (other == kUnused) {
+					table[slot] = i;
+					remap[i] = newCount++;
+					break;
+				}
+				const bool sameClass = !vertexClasses || vertexClasses[other] == vertexClass;
+				if (sameClass && std::memcmp(vertex, bytes + static_cast<size_t>(other) * stride, stride) == 0) {
+					remap[i] = remap[other];
+					break;
+				}
+				slot = (slot + 1) & (tableSize - 1);
+			}
+		}
+		return newCount;
+	}
+
+	void OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount)
+	{
+		const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+		if (triangleCount == 0) {
+			return;
+		}
+
+		// 頂点 → 三角形 の隣接 (CSR)
+		std::vector<uint32_t> offsets(vertexCount + 1, 0);
+		for (uint32_t index : indices) {
+			++offsets[index + 1];
+		}
+		for (uint32_t v = 0; v < vertexCount; ++v) {
+			offsets[v + 1] += offsets[v];
+		}
+		std::vector<uint32_t> adjacency(offsets[vertexCount]);
+		std::vector<uint32_t> liveTriangles(vertexCount, 0);
+		for (uint32_t t = 0; t < triangleCount; ++t) {
+			for (uint32_t k = 0; k < 3; ++k) {
+				const uint32_t v = indices[t * 3 + k];
+				adjacency[offsets[v] + liveTriangles[v]++] = t;
+			}
+		}
+
+		std::vector<int32_t> cachePosition(vertexCount, -1);
+		std::vector<float> vertexScores(vertexCount);
+		for (uint32_t v = 0; v < vertexCount; ++v) {
+			vertexScores[v] = VertexScore(-1, liveTriangles[v]);
+		}
+		std::vector<uint8_t> emitted(triangleCount, 0);
+		uint32_t bestTriangle = 0;
+		float bestScore = -1.0f;
+		for (uint32_t t = 0; t < triangleCount; ++t) {
+			const float score = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+			if (score > bestScore) {
+				bestScore = score;
+				bestTriangle = t;
+			}
+		}
+
+		std::vector<uint32_t> result;
+		result.reserve(indices.size());
+		std::vector<uint32_t> cache;
+		std::vector<uint32_t> nextCache;
+		cache.reserve(kOptimizeCacheSize + 3);
+		nextCache.reserve(kOptimizeCacheSize + 3);
+		uint32_t inputCursor = 0;
+
+		for (uint32_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+			// キャッシュから続けられる三角形が無ければ入力順で次のもの
+			if (bestTriangle == kUnused) {
+				while (emitted[inputCursor]) {
+					++inputCursor;
+				}
+				bestTriangle = inputCursor;
+			}
+
+			const uint32_t* triangle = &indices[bestTriangle * 3];
+			result.insert(result.end(), triangle, triangle + 3);
+			emitted[bestTriangle] = 1;
+
+			// 使った三角形を隣接から外す
+			for (uint32_t k = 0; k < 3; ++k) {
+				const uint32_t v = triangle[k];
+				uint32_t* begin = &adjacency[offsets[v]];
+				uint32_t* end = begin + liveTriangles[v];
+				uint32_t* it = std::find(begin, end, bestTriangle);
+				if (it != end) {
+					*it = *(end - 1);
+					--liveTriangles[v];
+				}
+			}
+
+			// LRU: 使った頂点を先頭へ
+			nextCache.assign(triangle, triangle + 3);
+			for (uint32_t v : cache) {
+				if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+					nextCache.push_back(v);
+				}
+			}
+
+			// キャッシュの頂点 (と追い出された頂点) のスコアを更新
+			for (uint32_t i = 0; i < nextCache.size(); ++i) {
+				const uint32_t v = nextCache[i];
+				cachePosition[v] = i < kOptimizeCacheSize ? static_cast<int32_t>(i) : -1;
+				vertexScores[v] = VertexScore(cachePosition[v], liveTriangles[v]);
+			}
+			if (nextCache.size() > kOptimizeCacheSize) {
+				nextCache.resize(kOptimizeCacheSize);
+			}
+			cache.swap(nextCache);
+
+			// キャッシュの頂点を使う三角形から次を選ぶ
+			bestTriangle = kUnused;
+			bestScore = -1.0f;
+			for (uint32_t v : cache) {
+				for (uint32_t a = offsets[v]; a < offsets[v] + liveTriangles[v]; ++a) {
+					const uint32_t t = adjacency[a];
+					const float score = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+					if (score > bestScore) {
+						bestScore = score;
+						bestTriangle = t;
+					}
+				}
+			}
+		}
+
+		indices.swap(result);
+	}
+
+	void OptimizeOverdraw(std::vector<uint32_t>& indices, const float* positions, const float* normals, uint32_t stride, uint32_t vertexCount, float threshold)
+	{
+		const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+		if (triangleCount < 2) {
+			return;
+		}
+
+		auto position = [&](uint32_t v) {
+			return reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(positions) + static_cast<size_t>(v) * stride);
+			};
+		auto normal = [&](uint32_t v) {
+			return reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(normals) + static_cast<size_t>(v) * stride);
+			};
+
+		std::vector<uint32_t> timestamps(vertexCount, 0);
+		uint32_t time = kAnalyzeCacheSize + 1;
+
+		// 3頂点とも入っていない三角形でキャッシュが入れ替わったとみなして区切る
+		std::vector<uint32_t> hardBoundaries;
+		uint32_t originalMisses = 0;
+		for (uint32_t t = 0; t < triangleCount; ++t) {
+			const uint32_t misses = UpdateFifoCache(&indices[t * 3], timestamps, time, kAnalyzeCacheSize);
+			originalMisses += misses;
+			if (t == 0 || misses == 3) {
+				hardBoundaries.push_back(t);
+			}
+		}
+		hardBoundaries.push_back(triangleCount);
+
+		// さらに、区切りのACMRが区切り全体の threshold 倍以下に下がった所で細かく分ける
+		std::vector<uint32_t> boundaries;
+		for (size_t c = 0; c + 1 < hardBoundaries.size(); ++c) {
+			const uint32_t start = hardBoundaries[c];
+			const uint32_t end = hardBoundaries[c + 1];
+
+			time += kAnalyzeCacheSize + 1;
+			uint32_t clusterMisses = 0;
+			for (uint32_t t = start; t < end; ++t) {
+				clusterMisses += UpdateFifoCache(&indices[t * 3], timestamps, time, kAnalyzeCacheSize);
+			}
+			const float clusterThreshold = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - start);
+
+			boundaries.push_back(start);
+			time += kAnalyzeCacheSize + 1;
+			uint32_t runningMisses = 0;
+			uint32_t runningTriangles = 0;
+			for (uint32_t t = start; t < end; ++t) {
+				runningMisses += UpdateFifoCache(&indices[t * 3], timestamps, time, kAnalyzeCacheSize);
+				++runningTriangles;
+				if (t + 1 < end && static_cast<float>(runningMisses) / static_cast<float>(runningTriangles) <= clusterThreshold) {
+					boundaries.push_back(t + 1);
+					time += kAnalyzeCacheSize + 1;
+					runningMisses = 0;
+					runningTriangles = 0;
+				}
+			}
+		}
+		boundaries.push_back(triangleCount);
+		const uint32_t clusterCount = static_cast<uint32_t>(boundaries.size() - 1);
+		if (clusterCount < 2) {
+			return;
+		}
+
+		// メッシュ全体の中心 (面積で重み付け)
+		float meshCenter[3] = {};
+		float meshArea = 0.0f;
+		std::vector<float> clusterData(static_cast<size_t>(clusterCount) * 7, 0.0f);	// 中心×面積 (3)、法線 (3)、面積
+		for (uint32_t c = 0; c < clusterCount; ++c) {
+			float* data = &clusterData[static_cast<size_t>(c) * 7];
+			for (uint32_t t = boundaries[c]; t < boundaries[c + 1]; ++t) {
+				const float* p0 = position(indices[t * 3]);
+				const float* p1 = position(indices[t * 3 + 1]);
+				const float* p2 = position(indices[t * 3 + 2]);
+				const float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+				const float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+				const float cross[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+				const float area = std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+				for (uint32_t k = 0; k < 3; ++k) {
+					data[k] += (p0[k] + p1[k] + p2[k]) / 3.0f * area;
+					// 向きは頂点の法線から取る (巻き順の決まりに依らない)
+					data[3 + k] += (normal(indices[t * 3])[k] + normal(indices[t * 3 + 1])[k] + normal(indices[t * 3 + 2])[k]) * area;
+				}
+				data[6] += area;
+			}
+			for (uint32_t k = 0; k < 3; ++k) {
+				meshCenter[k] += data[k];
+			}
+			meshArea += data[6];
+		}
+		if (meshArea <= 0.0f) {
+			return;
+		}
+		for (float& value : meshCenter) {
+			value /= meshArea;
+		}
+
+		// 外を向いているクラスタほど先に描く
+		std::vector<float> sortKeys(clusterCount, 0.0f);
+		for (uint32_t c = 0; c < clusterCount; ++c) {
+			const float* data = &clusterData[static_cast<size_t>(c) * 7];
+			if (data[6] <= 0.0f) {
+				continue;
+			}
+			const float length = std::sqrt(data[3] * data[3] + data[4] * data[4] + data[5] * data[5]);
+			if (length <= 0.0f) {
+				continue;
+			}
+			float key = 0.0f;
+			for (uint32_t k = 0; k < 3; ++k) {
+				key += (data[k] / data[6] - meshCenter[k]) * data[3 + k] / length;
+			}
+			sortKeys[c] = key;
+		}
+		std::vector<uint32_t> order(clusterCount);
+		for (uint32_t c = 0; c < clusterCount; ++c) {
+			order[c] = c;
+		}
+		std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+
+		std::vector<uint32_t> result;
+		result.reserve(indices.size());
+		for (uint32_t c : order) {
+			result.insert(result.end(), indices.begin() + boundaries[c] * 3, indices.begin() + boundaries[c + 1] * 3);
+		}
+
+		// キャッシュ効率が悪くなりすぎるなら並べ替えない
+		const float originalAcmr = static_cast<float>(originalMisses) / static_cast<float>(triangleCount);
+		if (AnalyzeVertexCache(result, vertexCount).acmr <= originalAcmr * threshold) {
+			indices.swap(result);
+		}
+	}
+
+	uint32_t GenerateFetchRemap(std::vector<uint32_t>& remap, const std::vector<uint32_t>& indices, uint32_t vertexCount)
+	{
+		remap.assign(vertexCount, kUnused);
+		uint32_t newCount = 0;
+		for (uint32_t index : indices) {
+			assert(index < vertexCount);
+			if (remap[index] == kUnused) {
+				remap[index] = newCount++;
+			}
+		}
+		return newCount;
+	}
+
+	void RemapIndices(std::vector<uint32_t>& indices, const std::vector<uint32_t>& remap)
+	{
+		for (uint32_t& index : indices) {
+			assert(remap[index] != kUnused);
+			index = remap[index];
+		}
+	}
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+// C++
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// インポート時のメッシュ最適化 (D3D12・Assimpには依存しない)
+/// 重複頂点の統合 → 頂点キャッシュ向けの三角形の並べ替え → オーバードローを減らすクラスタの並べ替え
+/// → 頂点フェッチ向けの頂点の並べ替え、の順に行う
+/// </summary>
+namespace MeshOptimizer {
+
+	// 解析に使う頂点キャッシュ (FIFO) の大きさ
+	static constexpr uint32_t kAnalyzeCacheSize = 16;
+	// 並べ替えで想定する頂点キャッシュ (LRU) の大きさ
+	static constexpr uint32_t kOptimizeCacheSize = 32;
+	// オーバードローの並べ替えで許すACMRの悪化率
+	static constexpr float kOverdrawThreshold = 1.05f;
+	// 使われなくなった頂点の remap の値
+	static constexpr uint32_t kUnused = UINT32_MAX;
+
+	// 頂点キャッシュの効率
+	struct CacheStats {
+		float acmr = 0.0f;	// 三角形あたりの頂点シェーダー実行数 (0.5～3、小さいほど良い)
+		float atvr = 0.0f;	// 頂点あたりの頂点シェーダー実行数 (1が最良)
+	};
+
+	// Optimize の結果
+	struct Report {
+		uint32_t vertexCountBefore = 0;
+		uint32_t vertexCountAfter = 0;
+		uint32_t triangleCount = 0;
+		CacheStats before;
+		CacheStats after;
+		float milliseconds = 0.0f;
+	};
+
+	/// <summary>
+	/// FIFOの頂点キャッシュを真似てACMR/ATVRを求める
+	/// </summary>
+	CacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize = kAnalyzeCacheSize);
+
+	/// <summary>
+	/// 内容が同じ頂点をまとめる remap[古い番号] = 新しい番号 (最初に出てきた順) を作り、新しい頂点数を返す
+	/// </summary>
+	/// <param name="vertexClasses">頂点ごとの番号 (番号が違う頂点はバイトが同じでもまとめない。不要ならnullptr)</param>
+	uint32_t GenerateWeldRemap(std::vector<uint32_t>& remap, const void* vertices, uint32_t vertexCount, uint32_t stride, const uint32_t* vertexClasses = nullptr);
+
+	/// <summary>
+	/// スキニングの重み (ジョイントと重みの組) が同じ頂点に同じ番号を振る
+	/// GenerateWeldRemap に渡すと、別のジョイントに付いた頂点がバイトだけ同じでもまとめられなくなる
+	/// </summary>
+	/// <param name="jointWeights">ジョイントごとの重みの並び (Weight は vertexIndex と weight を持つこと)</param>
+	template<class Weight>
+	std::vector<uint32_t> ClassifyVertexInfluences(const std::vector<const std::vector<Weight>*>& jointWeights, uint32_t vertexCount)
+	{
+		using Influence = std::pair<uint32_t, float>;
+		std::vector<std::vector<Influence>> influences(vertexCount);
+		for (uint32_t joint = 0; joint < jointWeights.size(); ++joint) {
+			for (const Weight& weight : *jointWeights[joint]) {
+				if (weight.vertexIndex < vertexCount) {
+					influences[weight.vertexIndex].emplace_back(joint, weight.weight);
+				}
+			}
+		}
+
+		// 重みの組ごとに出てきた順で番号を振る (重みの無い頂点はすべて0)
+		std::vector<uint32_t> classes(vertexCount);
+		std::map<std::vector<Influence>, uint32_t> ids;
+		for (uint32_t v = 0; v < vertexCount; ++v) {
+			std::sort(influences[v].begin(), influences[v].end());
+			classes[v] = ids.try_emplace(std::move(influences[v]), static_cast<uint32_t>(ids.size())).first->second;
+		}
+		return classes;
+	}
+
+	/// <summary>
+	/// 頂点キャッシュに残っている頂点を使う三角形から順に並べ替える (Forsythの方法)
+	/// </summary>
+	void OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount);
+
+	/// <summary>
+	/// 頂点キャッシュが空になる所でクラスタに分け、外を向いているクラスタから描くように並べ替える
+	/// ACMRが threshold 倍より悪くなるなら元のまま
+	/// </summary>
+	/// <param name="positions">先頭頂点の位置 (x, y, z)</param>
+	/// <param name="normals">先頭頂点の法線 (x, y, z)</param>
+	/// <param name="stride">頂点1つ分のバイト数</param>
+	void OptimizeOverdraw(std::vector<uint32_t>& indices, const float* positions, const float* normals, uint32_t stride, uint32_t vertexCount, float threshold = kOverdrawThreshold);
+
+	/// <summary>
+	/// インデックスで最初に使われる順に頂点を並べる remap を作り、使われている頂点数を返す (使われない頂点は kUnused)
+	/// </summary>
+	uint32_t GenerateFetchRemap(std::vector<uint32_t>& remap, const std::vector<uint32_t>& indices, uint32_t vertexCount);
+
+	/// <summary>
+	/// インデックスを remap で付け替える
+	/// </summary>
+	void RemapIndices(std::vector<uint32_t>& indices, const std::vector<uint32_t>& remap);
+
+	/// <summary>
+	/// 頂点を remap で並べ替える (kUnused のものは捨てる)
+	/// </summary>
+	template<class Vertex>
+	void RemapVertices(std::vector<Vertex>& vertices, const std::vector<uint32_t>& remap, uint32_t newCount)
+	{
+		std::vector<Vertex> result(newCount);
+		for (size_t i = 0; i < vertices.size(); ++i) {
+			if (remap[i] != kUnused) {
+				result[remap[i]] = vertices[i];
+			}
+		}
+		vertices.swap(result);
+	}
+
+	/// <summary>
+	/// スキニングの重みの頂点番号を remap で付け替える (Weight は vertexIndex を持つこと)
+	/// ClassifyVertexInfluences で分けてまとめた頂点は同じ重みを持つので、各頂点の代表 (元の番号が一番小さいもの) の重みだけ残す
+	/// </summary>
+	template<class Weight>
+	void RemapVertexWeights(std::vector<Weight>& weights, const std::vector<uint32_t>& remap, uint32_t newCount)
+	{
+		std::vector<uint32_t> representative(newCount, kUnused);
+		for (uint32_t i = 0; i < remap.size(); ++i) {
+			if (remap[i] != kUnused && representative[remap[i]] == kUnused) {
+				representative[remap[i]] = i;
+			}
+		}
+		std::erase_if(weights, [&](const Weight& weight) {
+			const uint32_t index = remap[weight.vertexIndex];
+			return index == kUnused || representative[index] != weight.vertexIndex;
+			});
+		for (Weight& weight : weights) {
+			weight.vertexIndex = remap[weight.vertexIndex];
+		}
+	}
+
+	/// <summary>
+	/// まとめて最適化する (Vertex は position と normal を持つこと)
+	/// </summary>
+	/// <param name="outRemap">元の頂点番号 → 最適化後の番号 (スキニングの重みの付け替え用、不要ならnullptr)</param>
+	/// <param name="vertexClasses">まとめてよい頂点の番号 (ClassifyVertexInfluences の結果、不要ならnullptr)</param>
+	template<class Vertex>
+	Report Optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, std::vector<uint32_t>* outRemap = nullptr,
+		const std::vector<uint32_t>* vertexClasses = nullptr)
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		Report report;
+		report.vertexCountBefore = static_cast<uint32_t>(vertices.size());
+		report.triangleCount = static_cast<uint32_t>(indices.size() / 3);
+		report.before = AnalyzeVertexCache(indices, report.vertexCountBefore);
+
+		// 重複頂点の統合
+		std::vector<uint32_t> weld;
+		uint32_t vertexCount = GenerateWeldRemap(weld, vertices.data(), report.vertexCountBefore, static_cast<uint32_t>(sizeof(Vertex)),
+			vertexClasses ? vertexClasses->data() : nullptr);
+		RemapIndices(indices, weld);
+		RemapVertices(vertices, weld, vertexCount);
+
+		// 三角形の並べ替え
+		OptimizeVertexCache(indices, vertexCount);
+		if (!vertices.empty()) {
+			OptimizeOverdraw(indices, &vertices[0].position.x, &vertices[0].normal.x, static_cast<uint32_t>(sizeof(Vertex)), vertexCount);
+		}
+
+		// 頂点の並べ替え
+		std::vector<uint32_t> fetch;
+		vertexCount = GenerateFetchRemap(fetch, indices, vertexCount);
+		RemapIndices(indices, fetch);
+		RemapVertices(vertices, fetch, vertexCount);
+
+		if (outRemap) {
+			outRemap->resize(weld.size());
+			for (size_t i = 0; i < weld.size(); ++i) {
+				(*outRemap)[i] = fetch[weld[i]];
+			}
+		}
+
+		report.vertexCountAfter = vertexCount;
+		report.after = AnalyzeVertexCache(indices, vertexCount);
+		report.milliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+		return report;
+	}
+}
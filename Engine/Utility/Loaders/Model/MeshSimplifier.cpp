@@ -0,0 +1,491 @@
+#include "MeshSimplifier.h"
+
+// C++
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+	// 頂点の種類 (動かしてよい方向)
+	enum class VertexKind : uint8_t {
+		Manifold,	// どの辺に沿っても動かせる
+		Border,		// 穴の縁 (縁に沿ってだけ動かせる)
+		Seam,		// UVなどの継ぎ目 (同じ位置のもう1つの頂点と一緒に、継ぎ目に沿ってだけ動かせる)
+		Locked,		// 動かさない
+	};
+
+	// 継ぎ目や縁の平面の重み (面の平面より強く形を保つ)
+	const double kEdgeWeight = 10.0;
+
+	struct Position {
+		double x, y, z;
+	};
+
+	Position Subtract(const Position& a, const Position& b)
+	{
+		return { a.x - b.x, a.y - b.y, a.z - b.z };
+	}
+
+	Position Cross(const Position& a, const Position& b)
+	{
+		return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+	}
+
+	double Dot(const Position& a, const Position& b)
+	{
+		return a.x * b.x + a.y * b.y + a.z * b.z;
+	}
+
+	// 点から平面までの距離の二乗の和 (重み付き)
+	struct Quadric {
+		double a00 = 0.0, a11 = 0.0, a22 = 0.0;
+		double a01 = 0.0, a02 = 0.0, a12 = 0.0;
+		double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+		double c = 0.0;
+		double weight = 0.0;
+
+		// 平面 n・p + d = 0 (nは正規化済み) を重み w で足す
+		void AddPlane(const Position& n, double d, double w)
+		{
+			a00 += w * n.x * n.x;
+			a11 += w * n.y * n.y;
+			a22 += w * n.z * n.z;
+			a01 += w * n.x * n.y;
+			a02 += w * n.x * n.z;
+			a12 += w * n.y * n.z;
+			b0 += w * n.x * d;
+			b1 += w * n.y * d;
+			b2 += w * n.z * d;
+			c += w * d * d;
+			weight += w;
+		}
+
+		void Add(const Quadric& other)
+		{
+			a00 += other.a00; a11 += other.a11; a22 += other.a22;
+			a01 += other.a01; a02 += other.a02; a12 += other.a12;
+			b0 += other.b0; b1 += other.b1; b2 += other.b2;
+			c += other.c;
+			weight += other.weight;
+		}
+
+		// 重みで割った距離の二乗
+		double Evaluate(const Position& p) const
+		{
+			if (weight <= 0.0) {
+				return 0.0;
+			}
+			double error =
+				a00 * p.x * p.x + a11 * p.y * p.y + a22 * p.z * p.z +
+				2.0 * (a01 * p.x * p.y + a02 * p.x * p.z + a12 * p.y * p.z) +
+				2.0 * (b0 * p.x + b1 * p.y + b2 * p.z) + c;
+			return (std::max)(error, 0.0) / weight;
+		}
+	};
+
+	// 縮退の候補 (v を t に寄せる)
+	struct Collapse {
+		uint32_t v;
+		uint32_t t;
+		double cost;
+	};
+
+	uint64_t EdgeKey(uint32_t a, uint32_t b)
+	{
+		return (static_cast<uint64_t>(a) << 32) | b;
+	}
+
+	const uint32_t kInvalid = MeshOptimizer::kUnused;
+}
+
+float MeshSimplifier::CalculateExtent(const float* positions, uint32_t stride, uint32_t vertexCount)
+{
+	if (vertexCount == 0) {
+		return 0.0f;
+	}
+	const uint8_t* base = reinterpret_cast<const uint8_t*>(positions);
+	float minimum[3] = { positions[0], positions[1], positions[2] };
+	float maximum[3] = { positions[0], positions[1], positions[2] };
+	for (uint32_t i = 1; i < vertexCount; ++i) {
+		const float* p = reinterpret_cast<const float*>(base + static_cast<size_t>(i) * stride);
+		for (int axis = 0; axis < 3; ++axis) {
+			minimum[axis] = (std::min)(minimum[axis], p[axis]);
+			maximum[axis] = (std::max)(maximum[axis], p[axis]);
+		}
+	}
+	return (std::max)({ maximum[0] - minimum[0], maximum[1] - minimum[1], maximum[2] - minimum[2] });
+}
+
+std::vector<uint32_t> MeshSimplifier::Simplify(const std::vector<uint32_t>& indices, const float* positions, uint32_t stride, uint32_t vertexCount,
+	uint32_t targetIndexCount, float targetError, float* outError)
+{
+	if (outError) {
+		*outError = 0.0f;
+	}
+	const float extent = CalculateExtent(positions, stride, vertexCount);
+	if (indices.size() <= targetIndexCount || targetError <= 0.0f || extent <= 0.0f) {
+		return indices;
+	}
+
+	/*===============================================//
+						準備
+	//===============================================*/
+
+	// 大きさ1に正規化した位置 (誤差をメッシュの大きさに対する割合で扱う)
+	const uint8_t* base = reinterpret_cast<const uint8_t*>(positions);
+	std::vector<Position> points(vertexCount);
+	for (uint32_t i = 0; i < vertexCount; ++i) {
+		const float* p = reinterpret_cast<const float*>(base + static_cast<size_t>(i) * stride);
+		points[i] = { static_cast<double>(p[0]) / extent, static_cast<double>(p[1]) / extent, static_cast<double>(p[2]) / extent };
+	}
+
+	// 同じ位置の頂点の代表 (最初のもの) と、同じ位置の頂点を巡る輪
+	std::vector<uint32_t> remap(vertexCount);
+	std::vector<uint32_t> wedge(vertexCount);
+	{
+		std::unordered_map<uint64_t, std::vector<uint32_t>> buckets;
+		buckets.reserve(vertexCount);
+		for (uint32_t i = 0; i < vertexCount; ++i) {
+			const float* p = reinterpret_cast<const float*>(base + static_cast<size_t>(i) * stride);
+			uint32_t bits[3];
+			std::memcpy(bits, p, sizeof(bits));
+			const uint64_t hash = (static_cast<uint64_t>(bits[0]) * 73856093u) ^ (static_cast<uint64_t>(bits[1]) * 19349663u) ^ (static_cast<uint64_t>(bits[2]) * 83492791u);
+			std::vector<uint32_t>& bucket = buckets[hash];
+			remap[i] = i;
+			wedge[i] = i;
+			for (uint32_t other : bucket) {
+				const float* q = reinterpret_cast<const float*>(base + static_cast<size_t>(other) * stride);
+				if (std::memcmp(p, q, sizeof(float) * 3) == 0) {
+					remap[i] = other;
+					// 輪に差し込む
+					wedge[i] = wedge[other];
+					wedge[other] = i;
+					break;
+				}
+			}
+			if (remap[i] == i) {
+				bucket.push_back(i);
+			}
+		}
+	}
+
+	// 同じ位置の点が重なる三角形は最初から除く
+	std::vector<uint32_t> result;
+	result.reserve(indices.size());
+	for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+		const uint32_t r0 = remap[indices[i]];
+		const uint32_t r1 = remap[indices[i + 1]];
+		const uint32_t r2 = remap[indices[i + 2]];
+		if (r0 != r1 && r1 != r2 && r2 != r0) {
+			result.insert(result.end(), { indices[i], indices[i + 1], indices[i + 2] });
+		}
+	}
+
+	// 有向辺 (インデックスと位置の両方)
+	std::unordered_set<uint64_t> edges;
+	auto buildEdges = [&](std::unordered_set<uint64_t>& out, bool usePosition) {
+		out.clear();
+		out.reserve(result.size() * 2);
+		for (size_t i = 0; i < result.size(); i += 3) {
+			for (int e = 0; e < 3; ++e) {
+				uint32_t a = result[i + e];
+				uint32_t b = result[i + (e + 1) % 3];
+				if (usePosition) {
+					a = remap[a];
+					b = remap[b];
+				}
+				out.insert(EdgeKey(a, b));
+			}
+		}
+		};
+	// 逆向きの辺が無い辺 (穴の縁や継ぎ目)
+	auto isOpen = [&](uint32_t a, uint32_t b) {
+		const bool forward = edges.contains(EdgeKey(a, b));
+		const bool backward = edges.contains(EdgeKey(b, a));
+		return forward != backward;
+		};
+
+	// 頂点の種類
+	std::vector<VertexKind> kinds(vertexCount, VertexKind::Locked);
+	{
+		std::unordered_set<uint64_t> positionEdges;
+		buildEdges(positionEdges, true);
+		buildEdges(edges, false);
+
+		std::vector<uint32_t> openPosition(vertexCount, 0);
+		std::vector<uint32_t> openIndex(vertexCount, 0);
+		for (size_t i = 0; i < result.size(); i += 3) {
+			for (int e = 0; e < 3; ++e) {
+				const uint32_t a = result[i + e];
+				const uint32_t b = result[i + (e + 1) % 3];
+				if (!positionEdges.contains(EdgeKey(remap[b], remap[a]))) {
+					++openPosition[remap[a]];
+					++openPosition[remap[b]];
+				}
+				if (!edges.contains(EdgeKey(b, a))) {
+					++openIndex[a];
+					++openIndex[b];
+				}
+			}
+		}
+
+		for (uint32_t i = 0; i < vertexCount; ++i) {
+			uint32_t wedgeCount = 1;
+			for (uint32_t w = wedge[i]; w != i; w = wedge[w]) {
+				++wedgeCount;
+			}
+			const uint32_t open = openPosition[remap[i]];
+			if (wedgeCount == 1) {
+				kinds[i] = open == 0 ? VertexKind::Manifold : (open == 2 ? VertexKind::Border : VertexKind::Locked);
+			}
+			else if (wedgeCount == 2 && open == 0 && openIndex[i] == 2) {
+				kinds[i] = VertexKind::Seam;
+			}
+		}
+	}
+
+	// 二次誤差 (位置の代表ごと)
+	std::vector<Quadric> quadrics(vertexCount);
+	for (size_t i = 0; i < result.size(); i += 3) {
+		const uint32_t index[3] = { result[i], result[i + 1], result[i + 2] };
+		const Position& p0 = points[index[0]];
+		const Position normal = Cross(Subtract(points[index[1]], p0), Subtract(points[index[2]], p0));
+		const double length = std::sqrt(Dot(normal, normal));
+		if (length <= 0.0) {
+			continue;
+		}
+		const Position n = { normal.x / length, normal.y / length, normal.z / length };
+		const double area = length * 0.5;
+
+		Quadric face;
+		face.AddPlane(n, -Dot(n, p0), area);
+		for (uint32_t k : index) {
+			quadrics[remap[k]].Add(face);
+		}
+
+		// 縁と継ぎ目は辺を含み面に垂直な平面も足す
+		for (int e = 0; e < 3; ++e) {
+			const uint32_t a = index[e];
+			const uint32_t b = index[(e + 1) % 3];
+			if (edges.contains(EdgeKey(b, a))) {
+				continue;
+			}
+			const Position edge = Subtract(points[b], points[a]);
+			const double edgeLength = std::sqrt(Dot(edge, edge));
+			Position perpendicular = Cross(edge, n);
+			const double perpendicularLength = std::sqrt(Dot(perpendicular, perpendicular));
+			if (perpendicularLength <= 0.0) {
+				continue;
+			}
+			perpendicular = { perpendicular.x / perpendicularLength, perpendicular.y / perpendicularLength, perpendicular.z / perpendicularLength };
+			Quadric border;
+			border.AddPlane(perpendicular, -Dot(perpendicular, points[a]), edgeLength * edgeLength * kEdgeWeight);
+			quadrics[remap[a]].Add(border);
+			quadrics[remap[b]].Add(border);
+		}
+	}
+
+	/*===============================================//
+					縮退を繰り返す
+	//===============================================*/
+
+	const double errorLimit = static_cast<double>(targetError) * targetError;
+	const uint32_t targetTriangles = targetIndexCount / 3;
+	uint32_t triangleCount = static_cast<uint32_t>(result.size() / 3);
+	double maxError = 0.0;
+
+	std::vector<uint32_t> collapseRemap(vertexCount);
+	std::vector<uint8_t> locked(vertexCount);
+	std::vector<uint32_t> adjacencyOffsets(vertexCount + 1);
+	std::vector<uint32_t> adjacency;
+	std::vector<Collapse> candidates;
+
+	while (triangleCount > targetTriangles) {
+		buildEdges(edges, false);
+
+		// 位置の代表 → 周りの三角形
+		std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+		for (uint32_t index : result) {
+			++adjacencyOffsets[remap[index] + 1];
+		}
+		for (uint32_t i = 0; i < vertexCount; ++i) {
+			adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+		}
+		adjacency.resize(result.size());
+		{
+			std::vector<uint32_t> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+			for (size_t i = 0; i < result.size(); ++i) {
+				adjacency[cursor[remap[result[i]]]++] = static_cast<uint32_t>(i / 3);
+			}
+		}
+
+		// 継ぎ目の相方の移動先 (t と同じ位置で、v の相方と継ぎ目の辺で繋がっている頂点)
+		auto findSeamTarget = [&](uint32_t v, uint32_t t) {
+			const uint32_t twin = wedge[v];
+			uint32_t w = t;
+			do {
+				if (isOpen(twin, w)) {
+					return w;
+				}
+				w = wedge[w];
+			} while (w != t);
+			return kInvalid;
+			};
+
+		// v を t に寄せてよいか (よければ誤差、だめなら負)
+		auto evaluate = [&](uint32_t v, uint32_t t) {
+			switch (kinds[v]) {
+			case VertexKind::Manifold:
+				break;
+			case VertexKind::Border:
+				if (!isOpen(v, t) || (kinds[t] != VertexKind::Border && kinds[t] != VertexKind::Locked)) {
+					return -1.0;
+				}
+				break;
+			case VertexKind::Seam:
+				if (!isOpen(v, t) || (kinds[t] != VertexKind::Seam && kinds[t] != VertexKind::Locked) || findSeamTarget(v, t) == kInvalid) {
+					return -1.0;
+				}
+				break;
+			default:
+				return -1.0;
+			}
+			return quadrics[remap[v]].Evaluate(points[t]);
+			};
+
+		candidates.clear();
+		for (size_t i = 0; i < result.size(); i += 3) {
+			for (int e = 0; e < 3; ++e) {
+				const uint32_t a = result[i + e];
+				const uint32_t b = result[i + (e + 1) % 3];
+				// 内側の辺は2回出てくるので片方だけ
+				if (a > b && edges.contains(EdgeKey(b, a))) {
+					continue;
+				}
+				const double ab = evaluate(a, b);
+				const double ba = evaluate(b, a);
+				if (ab >= 0.0 && (ba < 0.0 || ab <= ba)) {
+					candidates.push_back({ a, b, ab });
+				}
+				else if (ba >= 0.0) {
+					candidates.push_back({ b, a, ba });
+				}
+			}
+		}
+		std::sort(candidates.begin(), candidates.end(), [](const Collapse& lhs, const Collapse& rhs) { return lhs.cost < rhs.cost; });
+
+		for (uint32_t i = 0; i < vertexCount; ++i) {
+			collapseRemap[i] = i;
+		}
+		std::fill(locked.begin(), locked.end(), uint8_t(0));
+
+		uint32_t collapsed = 0;
+		for (const Collapse& collapse : candidates) {
+			if (triangleCount <= targetTriangles || collapse.cost > errorLimit) {
+				break;
+			}
+			const uint32_t rv = remap[collapse.v];
+			const uint32_t rt = remap[collapse.t];
+			// このパスで既に動いた所には触らない
+			if (locked[rv] || locked[rt]) {
+				continue;
+			}
+
+			uint32_t twin = kInvalid;
+			uint32_t twinTarget = kInvalid;
+			if (kinds[collapse.v] == VertexKind::Seam) {
+				twin = wedge[collapse.v];
+				twinTarget = findSeamTarget(collapse.v, collapse.t);
+				if (twinTarget == kInvalid) {
+					continue;
+				}
+			}
+
+			// 周りの三角形が裏返らないか、いくつ消えるか
+			bool flipped = false;
+			uint32_t removed = 0;
+			for (uint32_t k = adjacencyOffsets[rv]; k < adjacencyOffsets[rv + 1] && !flipped; ++k) {
+				const uint32_t triangle = adjacency[k];
+				uint32_t r[3];
+				for (int j = 0; j < 3; ++j) {
+					r[j] = remap[collapseRemap[result[triangle * 3 + j]]];
+				}
+				if (r[0] == r[1] || r[1] == r[2] || r[2] == r[0]) {
+					continue;
+				}
+				if (r[0] == rt || r[1] == rt || r[2] == rt) {
+					++removed;
+					continue;
+				}
+				Position before[3];
+				Position after[3];
+				for (int j = 0; j < 3; ++j) {
+					before[j] = points[r[j]];
+					after[j] = r[j] == rv ? points[rt] : points[r[j]];
+				}
+				const Position n0 = Cross(Subtract(before[1], before[0]), Subtract(before[2], before[0]));
+				const Position n1 = Cross(Subtract(after[1], after[0]), Subtract(after[2], after[0]));
+				flipped = Dot(n0, n1) <= 0.0;
+			}
+			if (flipped) {
+				continue;
+			}
+
+			collapseRemap[collapse.v] = collapse.t;
+			if (twin != kInvalid) {
+				collapseRemap[twin] = twinTarget;
+			}
+			quadrics[rt].Add(quadrics[rv]);
+			locked[rv] = 1;
+			locked[rt] = 1;
+			triangleCount -= (std::min)(removed, triangleCount);
+			maxError = (std::max)(maxError, collapse.cost);
+			++collapsed;
+		}
+
+		if (collapsed == 0) {
+			break;
+		}
+
+		// 付け替えて、潰れた三角形を除く
+		size_t write = 0;
+		for (size_t i = 0; i < result.size(); i += 3) {
+			const uint32_t a = collapseRemap[result[i]];
+			const uint32_t b = collapseRemap[result[i + 1]];
+			const uint32_t c = collapseRemap[result[i + 2]];
+			if (remap[a] != remap[b] && remap[b] != remap[c] && remap[c] != remap[a]) {
+				result[write++] = a;
+				result[write++] = b;
+				result[write++] = c;
+			}
+		}
+		result.resize(write);
+		triangleCount = static_cast<uint32_t>(result.size() / 3);
+	}
+
+	if (outError) {
+		*outError = static_cast<float>(std::sqrt(maxError));
+	}
+	return result;
+}
+
+uint32_t MeshSimplifier::SelectLod(const std::vector<Lod>& lods, float pixelsPerUnit, uint32_t currentLod)
+{
+	if (lods.empty() || !(pixelsPerUnit > 0.0f)) {
+		return 0;
+	}
+	currentLod = (std::min)(currentLod, static_cast<uint32_t>(lods.size() - 1));
+
+	uint32_t selected = 0;
+	for (uint32_t i = 1; i < lods.size(); ++i) {
+		// 今より粗くする時だけ閾値を厳しくする
+		const float threshold = i > currentLod ? kMaxPixelError * (1.0f - kLodHysteresis) : kMaxPixelError;
+		if (lods[i].error * pixelsPerUnit > threshold) {
+			break;
+		}
+		selected = i;
+	}
+	return selected;
+}
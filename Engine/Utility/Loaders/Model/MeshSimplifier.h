@@ -0,0 +1,103 @@
+#pragma once
+
+// C++
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Engine
+#include "MeshOptimizer.h"
+
+/// <summary>
+/// インポート時のLOD生成と描画時のLOD選択 (D3D12・Assimpには依存しない)
+/// 二次誤差 (Quadric Error Metrics) で辺を縮退させて三角形を減らす。頂点は端点のどちらかに寄せるだけなので
+/// LODは元の頂点バッファを共有し、インデックスだけを持つ
+/// 穴の縁とUVなどの継ぎ目は形が崩れないように縁に沿ってしか縮退させない
+/// </summary>
+namespace MeshSimplifier {
+
+	// 元のメッシュを含めたLODの最大数
+	static constexpr uint32_t kMaxLodCount = 4;
+	// LODごとに目指す三角形数の割合 (1つ前のLODに対して)
+	static constexpr float kLodReduction = 0.5f;
+	// LODで許す誤差 (メッシュの大きさに対する割合)
+	static constexpr float kLodTargetError = 0.02f;
+	// 1つ前のLODよりこの割合までしか減らなければLODを作らない
+	static constexpr float kMinLodReduction = 0.85f;
+	// 画面上の誤差がこのピクセル数以下のLODまで粗くしてよい
+	static constexpr float kMaxPixelError = 1.0f;
+	// 粗いLODへ切り替える時は閾値をこの割合だけ厳しくする (行ったり来たりのちらつき防止)
+	static constexpr float kLodHysteresis = 0.25f;
+
+	// LOD1つ分 (インデックスバッファ内の範囲)
+	struct Lod {
+		uint32_t indexOffset = 0;
+		uint32_t indexCount = 0;
+		float error = 0.0f;		// 元のメッシュからの誤差 (モデル空間の距離)
+	};
+
+	/// <summary>
+	/// 三角形を targetIndexCount 個のインデックスまで減らす (誤差が targetError を超えるならそこで止める)
+	/// </summary>
+	/// <param name="positions">先頭頂点の x (x, y, z が並んでいること)</param>
+	/// <param name="stride">頂点1つ分のバイト数</param>
+	/// <param name="targetError">メッシュの大きさ (AABBの一番長い辺) に対する誤差の上限</param>
+	/// <param name="outError">実際の誤差 (メッシュの大きさに対する割合、不要ならnullptr)</param>
+	/// <returns>減らした後のインデックス</returns>
+	std::vector<uint32_t> Simplify(const std::vector<uint32_t>& indices, const float* positions, uint32_t stride, uint32_t vertexCount,
+		uint32_t targetIndexCount, float targetError, float* outError = nullptr);
+
+	/// <summary>
+	/// メッシュの大きさ (AABBの一番長い辺)
+	/// </summary>
+	float CalculateExtent(const float* positions, uint32_t stride, uint32_t vertexCount);
+
+	/// <summary>
+	/// LODを作る (Vertex は position を持つこと)
+	/// LOD0は indices そのもの、LOD1以降のインデックスは outLodIndices に続けて入れる (indexOffset は indices の後ろからの位置)
+	/// </summary>
+	template<class Vertex>
+	std::vector<Lod> GenerateLods(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, std::vector<uint32_t>& outLodIndices,
+		uint32_t maxLodCount = kMaxLodCount, float targetError = kLodTargetError)
+	{
+		outLodIndices.clear();
+
+		std::vector<Lod> lods;
+		lods.push_back({ 0, static_cast<uint32_t>(indices.size()), 0.0f });
+		if (vertices.empty() || indices.empty()) {
+			return lods;
+		}
+
+		const float* positions = &vertices[0].position.x;
+		const uint32_t stride = static_cast<uint32_t>(sizeof(Vertex));
+		const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+		const float extent = CalculateExtent(positions, stride, vertexCount);
+
+		// 1つ前のLODから減らしていく (誤差は元のメッシュからの分を足していく)
+		std::vector<uint32_t> previous = indices;
+		float accumulatedError = 0.0f;
+		while (lods.size() < maxLodCount) {
+			const uint32_t target = static_cast<uint32_t>(previous.size() / 3 * kLodReduction) * 3;
+			float error = 0.0f;
+			std::vector<uint32_t> lod = Simplify(previous, positions, stride, vertexCount, target, targetError - accumulatedError, &error);
+			if (lod.empty() || static_cast<float>(lod.size()) > static_cast<float>(previous.size()) * kMinLodReduction) {
+				break;
+			}
+			accumulatedError += error;
+
+			MeshOptimizer::OptimizeVertexCache(lod, vertexCount);
+			lods.push_back({ static_cast<uint32_t>(indices.size() + outLodIndices.size()), static_cast<uint32_t>(lod.size()), accumulatedError * extent });
+			outLodIndices.insert(outLodIndices.end(), lod.begin(), lod.end());
+			previous.swap(lod);
+		}
+		return lods;
+	}
+
+	/// <summary>
+	/// 画面上の誤差が kMaxPixelError 以下になる一番粗いLODを選ぶ
+	/// 今より粗いLODへは閾値を kLodHysteresis だけ厳しくして切り替える
+	/// </summary>
+	/// <param name="pixelsPerUnit">モデル空間の長さ1が画面上で何ピクセルになるか</param>
+	/// <param name="currentLod">今のLOD</param>
+	uint32_t SelectLod(const std::vector<Lod>& lods, float pixelsPerUnit, uint32_t currentLod);
+}
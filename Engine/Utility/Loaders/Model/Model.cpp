@@ -5,9 +5,17 @@
 #include "SrvManager/SrvManager.h"
 #include "Loaders./Texture./TextureManager.h"
 #include "Drawer./LineManager/Line.h"
+#include "Systems/GameTime/FrameTimer.h"
+#include "Loaders/Archive/FileSystem.h"
+#include "Loaders/Archive/AssimpIOSystem.h"
+#include "MeshOptimizer.h"
+#include "VertexQuantizer.h"
+#include "MeshSimplifier.h"
+#include "MeshLodCache.h"
 
 // C++
 #include <assert.h>
+#include <cstdio>
 #include <fstream>
 #include <sstream>
 
@@ -19,6 +27,14 @@
 #include <fstream>
 #include <iostream>
 
+Model::~Model()
+{
+	// パレット用のSRVを返す (ModelManager::Finalize で SrvManager より先に破棄される)
+	if (srvManager_ && skinCluster_.srvIndex != kInvalidSrvIndex) {
+		srvManager_->Free(skinCluster_.srvIndex);
+	}
+}
+
 void Model::Initialize(ModelCommon* modelCommon, const std::string& directorypath, const std::string& filename, bool isAnimation)
 {
 	isAnimation_ = isAnimation;
@@ -50,19 +66,35 @@ void Model::Initialize(ModelCommon* modelCommon, const std::string& directorypat
 	// 頂点データを参照してIndexデータの作成
 	CreteIndex();
 
-	// .objの参照しているテクスチャファイル読み込み
-	TextureManager::GetInstance()->LoadTexture(modelData_.material.textureFilePath);
+	// カリング用の範囲
+	CalculateLocalBounds();
+
+	// .objの参照しているテクスチャファイル読み込み (描画時はハンドルで引く)
+	modelData_.material.textureHandle = TextureManager::GetInstance()->LoadTexture(modelData_.material.textureFilePath);
 
 	// 読み込んだテクスチャ番号の取得
-	modelData_.material.textureIndex =TextureManager::GetInstance()->GetTextureIndexByFilePath(modelData_.material.textureFilePath);
+	modelData_.material.textureIndex = TextureManager::GetInstance()->GetSrvIndex(modelData_.material.textureHandle);
 
 }
 
-void Model::Draw()
+void Model::Draw(uint32_t instanceCount)
+{
+	// SRVの設定
+	modelCommon_->GetDxCommon()->GetCommandList()->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetSrvHandleGPU(modelData_.material.textureHandle)); // SRVのパラメータインデックスを変更
+
+	DrawMesh(instanceCount);
+}
+
+void Model::DrawMesh(uint32_t instanceCount, uint32_t lod)
 {
 	if (skeleton_.joints.empty()) {
 		// スケルトンが存在しない場合
 		modelCommon_->GetDxCommon()->GetCommandList()->IASetVertexBuffers(0, 1, &vertexBufferView_); // VBVを設定
+
+		// 圧縮頂点は位置の復元用の定数も設定する
+		if (isVertexPacked_) {
+			modelCommon_->GetDxCommon()->GetCommandList()->SetGraphicsRoot32BitConstants(8, VertexQuantizer::kQuantizationConstantCount, &quantization_, 0);
+		}
 	}
 	else {
 		// スケルトンが存在する場合
@@ -79,10 +111,15 @@ void Model::Draw()
 
 	// indexbufferView
 	modelCommon_->GetDxCommon()->GetCommandList()->IASetIndexBuffer(&indexBufferView_); // IBVを設定
-	// SRVの設定
-	modelCommon_->GetDxCommon()->GetCommandList()->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetsrvHandleGPU(modelData_.material.textureFilePath)); // SRVのパラメータインデックスを変更
+	// LODの範囲 (頂点バッファは全LODで共通)
+	UINT indexCount = static_cast<UINT>(modelData_.indices.size());
+	UINT indexOffset = 0;
+	if (lod > 0 && lod < modelData_.lods.size()) {
+		indexCount = modelData_.lods[lod].indexCount;
+		indexOffset = modelData_.lods[lod].indexOffset;
+	}
 	// 描画！！！DrawCall/ドローコール）
-	modelCommon_->GetDxCommon()->GetCommandList()->DrawIndexedInstanced(static_cast<UINT>(modelData_.indices.size()), 1, 0, 0,0);
+	modelCommon_->GetDxCommon()->GetCommandList()->DrawIndexedInstanced(indexCount, instanceCount, indexOffset, 0,0);
 
 }
 
@@ -158,7 +195,7 @@ void Model::DrawSkeleton(const Skeleton& skeleton,Line& line) {
 
 void Model::UpdateAnimation()
 {
-	animationTime_ += 1.0f / 60.0f;
+	animationTime_ += FrameTimer::GetInstance()->GetDeltaTime();
 	animationTime_ = std::fmod(animationTime_, animation_.duration);
 	if (modelData_.hasBones) {
 		ApplyAnimation(skeleton_, animation_, animationTime_);
@@ -230,6 +267,11 @@ void Model::UpdateSkinCluster(SkinCluster& skinCluster, const Skeleton& skeleton
 
 void Model::CreateVertex()
 {
+	// スケルトンを持たないモデルは圧縮した頂点で描く
+	if (usePackedVertex_ && skeleton_.joints.empty() && CreatePackedVertex()) {
+		return;
+	}
+
 	// リソース
 	vertexResource_ = modelCommon_->GetDxCommon()->CreateBufferResource(sizeof(VertexData) * modelData_.vertices.size());
 
@@ -243,16 +285,69 @@ void Model::CreateVertex()
 	vertexResource_->Unmap(0, nullptr);
 }
 
+bool Model::CreatePackedVertex()
+{
+	std::vector<VertexQuantizer::PackedVertex> packed;
+	if (!VertexQuantizer::PackVertices(modelData_.vertices, packed, quantization_)) {
+		return false;
+	}
+
+	vertexResource_ = modelCommon_->GetDxCommon()->CreateBufferResource(sizeof(VertexQuantizer::PackedVertex) * packed.size());
+
+	vertexBufferView_.BufferLocation = vertexResource_->GetGPUVirtualAddress();
+	vertexBufferView_.SizeInBytes = UINT(sizeof(VertexQuantizer::PackedVertex) * packed.size());
+	vertexBufferView_.StrideInBytes = sizeof(VertexQuantizer::PackedVertex);
+
+	void* mapped = nullptr;
+	vertexResource_->Map(0, nullptr, &mapped);
+	memcpy(mapped, packed.data(), sizeof(VertexQuantizer::PackedVertex) * packed.size());
+	vertexResource_->Unmap(0, nullptr);
+	isVertexPacked_ = true;
+
+	VertexQuantizer::Error error = VertexQuantizer::MeasureError(modelData_.vertices, packed, quantization_);
+	char message[512];
+	std::snprintf(message, sizeof(message), "Model: packed %zu vertices %zu -> %zu bytes, max error position %.6f normal %.4f deg texcoord %.6f\n",
+		packed.size(), sizeof(VertexData) * packed.size(), sizeof(VertexQuantizer::PackedVertex) * packed.size(),
+		error.position, error.normalDegrees, error.texcoord);
+	DirectXCommon::Log(message);
+	return true;
+}
+
+void Model::CalculateLocalBounds()
+{
+	if (modelData_.vertices.empty()) {
+		localBounds_ = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+		return;
+	}
+
+	const Vector4& first = modelData_.vertices[0].position;
+	localBounds_.min = { first.x, first.y, first.z };
+	localBounds_.max = localBounds_.min;
+	for (const VertexData& vertex : modelData_.vertices) {
+		localBounds_.min.x = (std::min)(localBounds_.min.x, vertex.position.x);
+		localBounds_.min.y = (std::min)(localBounds_.min.y, vertex.position.y);
+		localBounds_.min.z = (std::min)(localBounds_.min.z, vertex.position.z);
+		localBounds_.max.x = (std::max)(localBounds_.max.x, vertex.position.x);
+		localBounds_.max.y = (std::max)(localBounds_.max.y, vertex.position.y);
+		localBounds_.max.z = (std::max)(localBounds_.max.z, vertex.position.z);
+	}
+}
+
 void Model::CreteIndex()
 {
-	indexResource_ = modelCommon_->GetDxCommon()->CreateBufferResource(sizeof(uint32_t) * modelData_.indices.size());
+	// 元のメッシュの後ろにLODのインデックスを続ける
+	const size_t indexCount = modelData_.indices.size() + modelData_.lodIndices.size();
+	indexResource_ = modelCommon_->GetDxCommon()->CreateBufferResource(sizeof(uint32_t) * indexCount);
 
 	indexBufferView_.BufferLocation = indexResource_->GetGPUVirtualAddress();
-	indexBufferView_.SizeInBytes = sizeof(uint32_t) * static_cast<UINT>(modelData_.indices.size());
+	indexBufferView_.SizeInBytes = sizeof(uint32_t) * static_cast<UINT>(indexCount);
 	indexBufferView_.Format = DXGI_FORMAT_R32_UINT;
 
 	indexResource_->Map(0, nullptr, reinterpret_cast<void**>(&mappedIndex_));
 	std::memcpy(mappedIndex_, modelData_.indices.data(), sizeof(uint32_t) * modelData_.indices.size());
+	if (!modelData_.lodIndices.empty()) {
+		std::memcpy(mappedIndex_ + modelData_.indices.size(), modelData_.lodIndices.data(), sizeof(uint32_t) * modelData_.lodIndices.size());
+	}
 	indexResource_->Unmap(0, nullptr);
 }
 
@@ -504,6 +599,8 @@ Model::ModelData Model::LoadModelIndexFile(const std::string& directoryPath, con
 	//=================================================//
 	ModelData modelData;
 	Assimp::Importer importer;
+	// .mtl や .bin も含めて FileSystem から読む
+	importer.SetIOHandler(new AssimpIOSystem);
 	std::string filePath = directoryPath + "/" + filename;
 	const aiScene* scene = importer.ReadFile(filePath.c_str(), aiProcess_FlipWindingOrder | aiProcess_FlipUVs);
 	assert(scene->HasMeshes()); // メッシュが無いと非対応
@@ -520,15 +617,18 @@ Model::ModelData Model::LoadModelIndexFile(const std::string& directoryPath, con
 		aiMesh* mesh = scene->mMeshes[meshIndex];
 		assert(mesh->HasNormals());			  // 法線が無い場合のMeshは 04-00 では非対応
 		assert(mesh->HasTextureCoords(0));	  // TexcoordがないMeshは今回は非対応
-		modelData.vertices.resize(mesh->mNumVertices); // 最初に頂点数分のメモリを確保しておく
+		// 複数メッシュは後ろに足していき、インデックスと重みの頂点番号はその分ずらす
+		const uint32_t vertexOffset = static_cast<uint32_t>(modelData.vertices.size());
+		modelData.vertices.resize(vertexOffset + mesh->mNumVertices); // 最初に頂点数分のメモリを確保しておく
 		for (uint32_t vertexIndex = 0; vertexIndex < mesh->mNumVertices; ++vertexIndex) {
 			aiVector3D& position = mesh->mVertices[vertexIndex];
 			aiVector3D& normal = mesh->mNormals[vertexIndex];
 			aiVector3D& texcoords = mesh->mTextureCoords[0][vertexIndex];
 			// 右手系->左手系への変換を忘れずに
-			modelData.vertices[vertexIndex].position = { -position.x, position.y, position.z, 1.0f };
-			modelData.vertices[vertexIndex].normal = { -normal.x, normal.y, normal.z };
-			modelData.vertices[vertexIndex].texcoord = { texcoords.x, texcoords.y };
+			VertexData& vertex = modelData.vertices[vertexOffset + vertexIndex];
+			vertex.position = { -position.x, position.y, position.z, 1.0f };
+			vertex.normal = { -normal.x, normal.y, normal.z };
+			vertex.texcoord = { texcoords.x, texcoords.y };
 		}
 
 		// 面からIndexの情報を取得する
@@ -542,18 +642,18 @@ Model::ModelData Model::LoadModelIndexFile(const std::string& directoryPath, con
 				uint32_t i3 = face.mIndices[3];
 
 				// 四角形を2つの三角形に分割
-				modelData.indices.push_back(i0);
-				modelData.indices.push_back(i1);
-				modelData.indices.push_back(i2);
+				modelData.indices.push_back(vertexOffset + i0);
+				modelData.indices.push_back(vertexOffset + i1);
+				modelData.indices.push_back(vertexOffset + i2);
 
-				modelData.indices.push_back(i0);
-				modelData.indices.push_back(i2);
-				modelData.indices.push_back(i3);
+				modelData.indices.push_back(vertexOffset + i0);
+				modelData.indices.push_back(vertexOffset + i2);
+				modelData.indices.push_back(vertexOffset + i3);
 			}
 			// 三角形だったらそのまま使う
 			else if (face.mNumIndices == 3) {
 				for (uint32_t element = 0; element < face.mNumIndices; ++element) {
-					modelData.indices.push_back(face.mIndices[element]);
+					modelData.indices.push_back(vertexOffset + face.mIndices[element]);
 				}
 			}
 		}
@@ -576,10 +676,14 @@ Model::ModelData Model::LoadModelIndexFile(const std::string& directoryPath, con
 			jointWeightData.inverseBindPoseMatrix = Inverse(bindposeMatrix);
 
 			for (uint32_t weightIndex = 0; weightIndex < bone->mNumWeights; ++weightIndex) {
-				jointWeightData.vertexWeights.push_back({ bone->mWeights[weightIndex].mWeight,bone->mWeights[weightIndex].mVertexId });
+				jointWeightData.vertexWeights.push_back({ bone->mWeights[weightIndex].mWeight,vertexOffset + bone->mWeights[weightIndex].mVertexId });
 			}
 		}
 	}
+
+	// インポート時の最適化とLODの生成
+	OptimizeModelData(modelData, filePath);
+	GenerateModelLods(modelData, filePath);
 	//=================================================//
 	//				  materialを解析
 	//=================================================//
@@ -594,6 +698,50 @@ Model::ModelData Model::LoadModelIndexFile(const std::string& directoryPath, con
 	return modelData;
 }
 
+void Model::OptimizeModelData(ModelData& modelData, const std::string& filePath)
+{
+	// バイトが同じでも別のジョイントに付いた頂点 (体に触れている小物など) はまとめない
+	std::vector<uint32_t> influenceClasses;
+	if (!modelData.skinClusterData.empty()) {
+		std::vector<const std::vector<VertexWeightData>*> jointWeights;
+		for (const auto& jointWeight : modelData.skinClusterData) {
+			jointWeights.push_back(&jointWeight.second.vertexWeights);
+		}
+		influenceClasses = MeshOptimizer::ClassifyVertexInfluences(jointWeights, static_cast<uint32_t>(modelData.vertices.size()));
+	}
+
+	std::vector<uint32_t> remap;
+	MeshOptimizer::Report report = MeshOptimizer::Optimize(modelData.vertices, modelData.indices, &remap,
+		influenceClasses.empty() ? nullptr : &influenceClasses);
+
+	// スキニングの重みの頂点番号も付け替える
+	for (auto& jointWeight : modelData.skinClusterData) {
+		MeshOptimizer::RemapVertexWeights(jointWeight.second.vertexWeights, remap, report.vertexCountAfter);
+	}
+
+	char message[512];
+	std::snprintf(message, sizeof(message), "Model: %s vertices %u -> %u, triangles %u, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f (%.2f ms)\n",
+		filePath.c_str(), report.vertexCountBefore, report.vertexCountAfter, report.triangleCount,
+		report.before.acmr, report.after.acmr, report.before.atvr, report.after.atvr, report.milliseconds);
+	DirectXCommon::Log(message);
+}
+
+void Model::GenerateModelLods(ModelData& modelData, const std::string& filePath)
+{
+	// 最適化後のメッシュが同じなら前回作ったLODを読むだけで済ませる
+	MeshLodCache::Result result = MeshLodCache::Load(modelData.vertices, modelData.indices, modelData.lods, modelData.lodIndices);
+
+	char message[512];
+	int length = std::snprintf(message, sizeof(message), "Model: %s LOD %s %.2f ms,", filePath.c_str(),
+		result.cacheHit ? "(cooked)" : "(cooked now)", result.elapsedMs);
+	for (const MeshSimplifier::Lod& lod : modelData.lods) {
+		if (length < 0 || length >= static_cast<int>(sizeof(message))) {
+			break;
+		}
+		length += std::snprintf(message + length, sizeof(message) - length, " %u (%.4f)", lod.indexCount / 3, lod.error);
+	}
+	DirectXCommon::Log(std::string(message) + "\n");
+}
 
 Model::InterpolationType Model::MapAssimpBehaviourToInterpolation(aiAnimBehaviour preState, aiAnimBehaviour postState)
 {
@@ -614,6 +762,8 @@ Model::Animation Model::LoadAnimationFile(const std::string& directoryPath, cons
 {
 	Animation animation; // 今回作るアニメーション
 	Assimp::Importer importer;
+	// .mtl や .bin も含めて FileSystem から読む
+	importer.SetIOHandler(new AssimpIOSystem);
 	std::string filePath = directoryPath + "/" + filename;
 	const aiScene* scene = importer.ReadFile(filePath.c_str(), 0);
 	assert(scene->mNumAnimations != 0); // アニメーション無し
@@ -700,14 +850,14 @@ std::string Model::GetGLTFInterpolation(const std::string& gltfFilePath, uint32_
 
 std::string ParseGLTFInterpolation(const std::string& gltfFilePath, uint32_t samplerIndex) {
 	// GLTFファイルを開く
-	std::ifstream file(gltfFilePath);
-	if (!file.is_open()) {
+	FileSystem::FileView file = FileSystem::GetInstance()->Open(gltfFilePath);
+	if (!file.IsValid()) {
 		throw std::runtime_error("Failed to open GLTF file: " + gltfFilePath);
 	}
 
 	// JSONを読み込む
-	nlohmann::json gltfJson;
-	file >> gltfJson;
+	const std::string_view text = file.GetText();
+	nlohmann::json gltfJson = nlohmann::json::parse(text.begin(), text.end());
 
 	// サンプラー情報を取得
 	const auto& samplers = gltfJson["animations"][0]["samplers"];
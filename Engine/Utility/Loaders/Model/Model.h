@@ -14,6 +14,9 @@
 #include "WorldTransform./WorldTransform.h"
 #include "Material.h"
 #include "Mesh.h"
+#include "Loaders./Texture./TextureHandle.h"
+#include "VertexQuantizer.h"
+#include "MeshSimplifier.h"
 
 // Math
 #include "MathFunc.h"
@@ -63,6 +66,7 @@ public: // 構造体
 		uint32_t illum;
 		std::string textureFilePath;
 		uint32_t textureIndex = 0;
+		TextureHandle textureHandle = TextureHandleUtil::kInvalid;
 	};
 	// ノード
 	struct Node {
@@ -86,12 +90,17 @@ public: // 構造体
 		std::map<std::string, JointWeightData> skinClusterData;
 		std::vector<VertexData> vertices;
 		std::vector<uint32_t> indices;
+		// LOD (lods[0] は indices そのもの、LOD1以降のインデックスは lodIndices に続けて持つ)
+		std::vector<uint32_t> lodIndices;
+		std::vector<MeshSimplifier::Lod> lods;
 		MaterialData material;
 		Node rootNode;
 		bool hasBones;
 	};
 	// インフルエンス
 	const static uint32_t kNumMaxInfluence = 4;
+	// SRVを確保していない印
+	static constexpr uint32_t kInvalidSrvIndex = UINT32_MAX;
 	struct VertexInfluence {
 		std::array<float, kNumMaxInfluence> weights;
 		std::array<int32_t, kNumMaxInfluence> jointindices;
@@ -111,7 +120,7 @@ public: // 構造体
 		Microsoft::WRL::ComPtr<ID3D12Resource> paletteResource;
 		std::span<WellForGPU> mappedPalette;
 		std::pair<D3D12_CPU_DESCRIPTOR_HANDLE, D3D12_GPU_DESCRIPTOR_HANDLE> paletteSrvHandle;
-		uint32_t srvIndex;
+		uint32_t srvIndex = kInvalidSrvIndex;
 	};
 
 	
@@ -161,6 +170,15 @@ public: // 構造体
 
 
 public: // メンバ関数
+	Model() = default;
+	Model(const Model&) = delete;
+	Model& operator=(const Model&) = delete;
+
+	/// <summary>
+	/// デストラクタ (スキンクラスターのSRVを返す)
+	/// </summary>
+	~Model();
+
 	/// <summary>
 	/// 初期化
 	/// </summary>
@@ -169,7 +187,15 @@ public: // メンバ関数
 	/// <summary>
 	/// 描画
 	/// </summary>
-	void Draw();
+	/// <param name="instanceCount">インスタンス数</param>
+	void Draw(uint32_t instanceCount = 1);
+
+	/// <summary>
+	/// テクスチャを設定せずに描画 (テクスチャは描画キュー側でまとめて設定する)
+	/// </summary>
+	/// <param name="instanceCount">インスタンス数</param>
+	/// <param name="lod">LODの番号 (0が元のメッシュ)</param>
+	void DrawMesh(uint32_t instanceCount = 1, uint32_t lod = 0);
 
 	/// <summary>
 	//  スケルトンの描画　※DrawLineを調整中なので仮
@@ -206,11 +232,21 @@ private:
 	/// </summary>
 	void CreateVertex();
 
+	/// <summary>
+	/// 圧縮した頂点リソース (作れなければfalse)
+	/// </summary>
+	bool CreatePackedVertex();
+
 	/// <summary>
 	/// Indexリソース作成
 	/// </summary>
 	void CreteIndex();
 
+	/// <summary>
+	/// 頂点からローカル空間のAABBを求める (カリング用)
+	/// </summary>
+	void CalculateLocalBounds();
+
 	/// <summary>
 	/// ジョイント作成
 	/// </summary>
@@ -273,6 +309,16 @@ private:
 	/// </summary>
 	static ModelData LoadModelIndexFile(const std::string& directoryPath, const std::string& filename);
 
+	/// <summary>
+	/// 読み込んだメッシュの最適化 (重複頂点の統合・三角形と頂点の並べ替え、スキニングの重みも付け替える)
+	/// </summary>
+	static void OptimizeModelData(ModelData& modelData, const std::string& filePath);
+
+	/// <summary>
+	/// 最適化したメッシュから簡略化したLODを作る (前回作ったものがキャッシュにあれば読むだけ)
+	/// </summary>
+	static void GenerateModelLods(ModelData& modelData, const std::string& filePath);
+
 
 	/// <summary>
 	/// 補間の設定
@@ -303,9 +349,16 @@ public:
 							アクセッサ
 
 	=================================================================*/
-	ModelData GetModelData() { return modelData_; }
+	const ModelData& GetModelData() const { return modelData_; }
 	Matrix4x4 GetLocalMatrix() { return localMatrix_; }
 	Skeleton GetSkeleton() { return skeleton_; }
+	bool HasSkeleton() const { return !skeleton_.joints.empty(); }
+	// 頂点を圧縮しているか (ObjectInstancePacked で描く)
+	bool IsVertexPacked() const { return isVertexPacked_; }
+	// Initialize の前に設定する (スケルトンを持つモデルは常に圧縮しない)
+	void SetUsePackedVertex(bool usePackedVertex) { usePackedVertex_ = usePackedVertex; }
+	const AABB& GetLocalBounds() const { return localBounds_; }
+	const std::vector<MeshSimplifier::Lod>& GetLods() const { return modelData_.lods; }
 
 private: 
 	/*=================================================================
@@ -324,11 +377,19 @@ private:
 	// objファイルのデータ
 	ModelData modelData_;
 
+	// ローカル空間のAABB (バインドポーズ)
+	AABB localBounds_{};
+
 	// 頂点リソースなど
 	Microsoft::WRL::ComPtr<ID3D12Resource> vertexResource_;
 	D3D12_VERTEX_BUFFER_VIEW vertexBufferView_{};
 	VertexData* vertexData_ = nullptr;
 
+	// 圧縮した頂点 (位置の復元用の定数はルート8に送る)
+	bool usePackedVertex_ = true;
+	bool isVertexPacked_ = false;
+	VertexQuantizer::QuantizationParams quantization_{};
+
 	// Indexリソースなど
 	Microsoft::WRL::ComPtr<ID3D12Resource> indexResource_;
 	D3D12_INDEX_BUFFER_VIEW indexBufferView_;
@@ -15,6 +15,15 @@ ModelManager* ModelManager::GetInstance()
     return instance.get();
 }
 
+/// <summary>
+/// 終了処理
+/// </summary>
+void ModelManager::Finalize()
+{
+    // モデルが持つSRVを返すので、SrvManager より先に呼ぶ
+    instance.reset();
+}
+
 /// <summary>
 /// 初期化処理
 /// </summary>
@@ -40,6 +49,7 @@ void ModelManager::LoadModel(const std::string& directoryPath,const std::string&
 
     // 新しいモデルの生成、ファイル読み込み、初期化
     std::unique_ptr<Model> model = std::make_unique<Model>();
+    model->SetUsePackedVertex(usePackedVertex_);
     model->Initialize(modelCommon_.get(), directoryPath, filePath, isAnimation);
 
     // モデルをマップに格納（所有権を譲渡）
@@ -47,6 +47,11 @@ public: // 公開メンバ関数
     /// <returns></returns>
     Model* FindModel(const std::string& filePath);
 
+    /// <summary>
+    /// これから読み込むモデルの頂点を圧縮するか (既定はtrue、スケルトンを持つモデルは常に圧縮しない)
+    /// </summary>
+    void SetUsePackedVertex(bool usePackedVertex) { usePackedVertex_ = usePackedVertex; }
+
 private:
     // シングルトンインスタンス
     static std::unique_ptr<ModelManager> instance;
@@ -62,4 +67,6 @@ private:
 private: // メンバ変数
     // モデル共通部分
     std::unique_ptr<ModelCommon> modelCommon_;
+    // 頂点を圧縮するか
+    bool usePackedVertex_ = true;
 };
@@ -5,6 +5,9 @@
 #include "SrvManager/SrvManager.h"
 #include "Loaders./Texture./TextureManager.h"
 #include "Drawer./LineManager/Line.h"
+#include "Systems/GameTime/FrameTimer.h"
+#include "Loaders/Archive/FileSystem.h"
+#include "Loaders/Archive/AssimpIOSystem.h"
 
 // C++
 #include <assert.h>
@@ -50,11 +53,11 @@ void ModelTest::Initialize(ModelCommon* modelCommon, const std::string& director
 	// 頂点データを参照してIndexデータの作成
 	CreteIndex();
 
-	// .objの参照しているテクスチャファイル読み込み
-	TextureManager::GetInstance()->LoadTexture(modelData_.material.textureFilePath);
+	// .objの参照しているテクスチャファイル読み込み (描画時はハンドルで引く)
+	modelData_.material.textureHandle = TextureManager::GetInstance()->LoadTexture(modelData_.material.textureFilePath);
 
 	// 読み込んだテクスチャ番号の取得
-	modelData_.material.textureIndex = TextureManager::GetInstance()->GetTextureIndexByFilePath(modelData_.material.textureFilePath);
+	modelData_.material.textureIndex = TextureManager::GetInstance()->GetSrvIndex(modelData_.material.textureHandle);
 
 }
 
@@ -79,7 +82,7 @@ void ModelTest::Draw()
 	// indexbufferView
 	modelCommon_->GetDxCommon()->GetCommandList()->IASetIndexBuffer(&indexBufferView_); // IBVを設定
 	// SRVの設定
-	modelCommon_->GetDxCommon()->GetCommandList()->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetsrvHandleGPU(modelData_.material.textureFilePath)); // SRVのパラメータインデックスを変更
+	modelCommon_->GetDxCommon()->GetCommandList()->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetSrvHandleGPU(modelData_.material.textureHandle)); // SRVのパラメータインデックスを変更
 	// 描画！！！DrawCall/ドローコール）
 	modelCommon_->GetDxCommon()->GetCommandList()->DrawIndexedInstanced(static_cast<UINT>(modelData_.indices.size()), 1, 0, 0, 0);
 
@@ -157,7 +160,7 @@ void ModelTest::DrawSkeleton(const Skeleton& skeleton, Line& line) {
 
 void ModelTest::UpdateAnimation()
 {
-	animationTime_ += 1.0f / 60.0f;
+	animationTime_ += FrameTimer::GetInstance()->GetDeltaTime();
 	animationTime_ = std::fmod(animationTime_, animation_.duration);
 	if (modelData_.hasBones) {
 		ApplyAnimation(skeleton_, animation_, animationTime_);
@@ -501,6 +504,8 @@ ModelTest::ModelData ModelTest::LoadModelIndexFile(const std::string& directoryP
 	//=================================================//
 	ModelData modelData;
 	Assimp::Importer importer;
+	// .mtl や .bin も含めて FileSystem から読む
+	importer.SetIOHandler(new AssimpIOSystem);
 	std::string filePath = directoryPath + "/" + filename;
 	const aiScene* scene = importer.ReadFile(filePath.c_str(), aiProcess_FlipWindingOrder | aiProcess_FlipUVs);
 	assert(scene->HasMeshes()); // メッシュが無いと非対応
@@ -607,6 +612,8 @@ ModelTest::Animation ModelTest::LoadAnimationFile(const std::string& directoryPa
 {
 	Animation animation; // 今回作るアニメーション
 	Assimp::Importer importer;
+	// .mtl や .bin も含めて FileSystem から読む
+	importer.SetIOHandler(new AssimpIOSystem);
 	std::string filePath = directoryPath + "/" + filename;
 	const aiScene* scene = importer.ReadFile(filePath.c_str(), 0);
 	assert(scene->mNumAnimations != 0); // アニメーション無し
@@ -708,14 +715,14 @@ bool ModelTest::HasBones(const aiScene* scene)
 std::string ModelTest::ParseGLTFInterpolation(const std::string& gltfFilePath, uint32_t samplerIndex)
 {
 	// GLTFファイルを開く
-	std::ifstream file(gltfFilePath);
-	if (!file.is_open()) {
+	FileSystem::FileView file = FileSystem::GetInstance()->Open(gltfFilePath);
+	if (!file.IsValid()) {
 		throw std::runtime_error("Failed to open GLTF file: " + gltfFilePath);
 	}
 
 	// JSONを読み込む
-	nlohmann::json gltfJson;
-	file >> gltfJson;
+	const std::string_view text = file.GetText();
+	nlohmann::json gltfJson = nlohmann::json::parse(text.begin(), text.end());
 
 	// サンプラー情報を取得
 	const auto& samplers = gltfJson["animations"][0]["samplers"];
@@ -14,6 +14,7 @@
 #include "WorldTransform./WorldTransform.h"
 #include "Material.h"
 #include "Mesh.h"
+#include "Loaders./Texture./TextureHandle.h"
 
 // Math
 #include "MathFunc.h"
@@ -63,6 +64,7 @@ public: // 構造体
 		uint32_t illum;
 		std::string textureFilePath;
 		uint32_t textureIndex = 0;
+		TextureHandle textureHandle = TextureHandleUtil::kInvalid;
 	};
 	// ノード
 	struct Node {
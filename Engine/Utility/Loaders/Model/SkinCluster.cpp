@@ -1,6 +1,13 @@
 #include "SkinCluster.h"
 #include "../Core/DX/DirectXCommon.h"
 #include "../Graphics/SrvManager/SrvManager.h"
+SkinCluster::~SkinCluster()
+{
+	if (srvIndex_ != UINT32_MAX) {
+		SrvManager::GetInstance()->Free(srvIndex_);
+	}
+}
+
 void SkinCluster::Update(std::vector<Joint> joints_)
 {
 	for (size_t jointIndex = 0; jointIndex < joints_.size(); ++jointIndex) {
@@ -32,6 +32,14 @@ class SkinCluster
 
 public:
 
+	SkinCluster() = default;
+	SkinCluster(const SkinCluster&) = delete;
+	SkinCluster& operator=(const SkinCluster&) = delete;
+
+	/// <summary>
+	/// デストラクタ (パレット用のSRVを返す)
+	/// </summary>
+	~SkinCluster();
 
 	/// <summary>
 	/// 更新
@@ -74,7 +82,7 @@ private:
 	Microsoft::WRL::ComPtr<ID3D12Resource> paletteResource_;
 	std::span<WellForGPU> mappedPalette_;
 	std::pair<D3D12_CPU_DESCRIPTOR_HANDLE, D3D12_GPU_DESCRIPTOR_HANDLE> paletteSrvHandle_;
-	uint32_t srvIndex_;
+	uint32_t srvIndex_ = UINT32_MAX;
 
 };
 
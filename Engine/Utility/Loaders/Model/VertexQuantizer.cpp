@@ -0,0 +1,260 @@
+#include "VertexQuantizer.h"
+
+// C++
+#include <cassert>
+#include <cstring>
+
+namespace {
+
+	// 0は正として扱う符号
+	float SignNotZero(float value)
+	{
+		return value >= 0.0f ? 1.0f : -1.0f;
+	}
+
+	// 16bitの符号付き正規化整数の復元 (D3Dと同じく-32768は-1)
+	float DecodeSnorm16(int16_t value)
+	{
+		return (std::max)(static_cast<float>(value) / 32767.0f, -1.0f);
+	}
+}
+
+uint16_t VertexQuantizer::FloatToHalf(float value)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+
+	const uint32_t sign = (bits >> 16) & 0x8000u;
+	const uint32_t absolute = bits & 0x7fffffffu;
+
+	// 無限大とNaN
+	if (absolute >= 0x7f800000u) {
+		return static_cast<uint16_t>(sign | 0x7c00u | (absolute > 0x7f800000u ? 0x0200u : 0u));
+	}
+	// 65520以上は丸めると無限大
+	if (absolute >= 0x477ff000u) {
+		return static_cast<uint16_t>(sign | 0x7c00u);
+	}
+
+	// 半精度の非正規化数 (2^-14未満)
+	if (absolute < 0x38800000u) {
+		// 2^-25以下は0に丸まる
+		if (absolute <= 0x33000000u) {
+			return static_cast<uint16_t>(sign);
+		}
+		const uint32_t exponent = absolute >> 23;
+		const uint32_t mantissa = (absolute & 0x007fffffu) | 0x00800000u;
+		const uint32_t shift = 126 - exponent;
+		const uint32_t halfway = 1u << (shift - 1);
+		const uint32_t remainder = mantissa & ((1u << shift) - 1);
+		uint32_t result = mantissa >> shift;
+		if (remainder > halfway || (remainder == halfway && (result & 1u))) {
+			++result;
+		}
+		return static_cast<uint16_t>(sign | result);
+	}
+
+	// 正規化数 (指数のバイアスを127から15へ)
+	const uint32_t rebiased = absolute - 0x38000000u;
+	uint32_t result = rebiased >> 13;
+	const uint32_t remainder = rebiased & 0x1fffu;
+	if (remainder > 0x1000u || (remainder == 0x1000u && (result & 1u))) {
+		++result;
+	}
+	return static_cast<uint16_t>(sign | result);
+}
+
+float VertexQuantizer::HalfToFloat(uint16_t value)
+{
+	const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+	const uint32_t exponent = (value >> 10) & 0x1fu;
+	const uint32_t mantissa = value & 0x03ffu;
+
+	uint32_t bits;
+	if (exponent == 0x1fu) {
+		// 無限大とNaN
+		bits = sign | 0x7f800000u | (mantissa << 13);
+	}
+	else if (exponent != 0) {
+		bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+	}
+	else if (mantissa == 0) {
+		bits = sign;
+	}
+	else {
+		// 非正規化数は単精度では正規化数になる
+		float result = std::ldexp(static_cast<float>(mantissa), -24);
+		return sign ? -result : result;
+	}
+
+	float result;
+	std::memcpy(&result, &bits, sizeof(result));
+	return result;
+}
+
+uint16_t VertexQuantizer::EncodeUnorm16(float value)
+{
+	value = (std::clamp)(value, 0.0f, 1.0f);
+	return static_cast<uint16_t>(value * 65535.0f + 0.5f);
+}
+
+float VertexQuantizer::DecodeUnorm16(uint16_t value)
+{
+	return static_cast<float>(value) / 65535.0f;
+}
+
+void VertexQuantizer::EncodeOctahedral(const Vector3& normal, int16_t out[2])
+{
+	const float l1 = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+	if (l1 <= 0.0f) {
+		out[0] = 0;
+		out[1] = 0;
+		return;
+	}
+
+	// 八面体に投影し、下半分は外側の三角形に折り返す
+	float u = normal.x / l1;
+	float v = normal.y / l1;
+	if (normal.z < 0.0f) {
+		const float foldedU = (1.0f - std::fabs(v)) * SignNotZero(u);
+		const float foldedV = (1.0f - std::fabs(u)) * SignNotZero(v);
+		u = foldedU;
+		v = foldedV;
+	}
+
+	const float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+	const Vector3 unit = { normal.x / length, normal.y / length, normal.z / length };
+
+	// 切り捨てと切り上げの組み合わせから、復元した向きが一番近いものを選ぶ
+	const float baseU = std::floor((std::clamp)(u, -1.0f, 1.0f) * 32767.0f);
+	const float baseV = std::floor((std::clamp)(v, -1.0f, 1.0f) * 32767.0f);
+	float bestCos = -2.0f;
+	for (int i = 0; i < 4; ++i) {
+		const int16_t candidate[2] = {
+			static_cast<int16_t>((std::clamp)(baseU + static_cast<float>(i & 1), -32767.0f, 32767.0f)),
+			static_cast<int16_t>((std::clamp)(baseV + static_cast<float>(i >> 1), -32767.0f, 32767.0f)),
+		};
+		const Vector3 decoded = DecodeOctahedral(candidate);
+		const float cosine = decoded.x * unit.x + decoded.y * unit.y + decoded.z * unit.z;
+		if (cosine > bestCos) {
+			bestCos = cosine;
+			out[0] = candidate[0];
+			out[1] = candidate[1];
+		}
+	}
+}
+
+Vector3 VertexQuantizer::DecodeOctahedral(const int16_t encoded[2])
+{
+	// InstanceObjPacked.VS.hlsl の DecodeOctahedral と同じ計算
+	Vector3 n = { DecodeSnorm16(encoded[0]), DecodeSnorm16(encoded[1]), 0.0f };
+	n.z = 1.0f - std::fabs(n.x) - std::fabs(n.y);
+	const float t = (std::max)(-n.z, 0.0f);
+	n.x += n.x >= 0.0f ? -t : t;
+	n.y += n.y >= 0.0f ? -t : t;
+
+	const float length = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+	return { n.x / length, n.y / length, n.z / length };
+}
+
+VertexQuantizer::QuantizationParams VertexQuantizer::CalculateParams(const float* positions, uint32_t stride, uint32_t vertexCount)
+{
+	QuantizationParams params;
+	if (vertexCount == 0) {
+		return params;
+	}
+
+	const uint8_t* base = reinterpret_cast<const uint8_t*>(positions);
+	float minimum[3] = { positions[0], positions[1], positions[2] };
+	float maximum[3] = { positions[0], positions[1], positions[2] };
+	for (uint32_t i = 1; i < vertexCount; ++i) {
+		const float* p = reinterpret_cast<const float*>(base + static_cast<size_t>(i) * stride);
+		for (int axis = 0; axis < 3; ++axis) {
+			minimum[axis] = (std::min)(minimum[axis], p[axis]);
+			maximum[axis] = (std::max)(maximum[axis], p[axis]);
+		}
+	}
+
+	params.offset = { minimum[0], minimum[1], minimum[2] };
+	params.scale = { maximum[0] - minimum[0], maximum[1] - minimum[1], maximum[2] - minimum[2] };
+	return params;
+}
+
+VertexQuantizer::PackedVertex VertexQuantizer::EncodeVertex(const Vector3& position, const Vector2& texcoord, const Vector3& normal, const QuantizationParams& params)
+{
+	PackedVertex packed{};
+
+	// 幅が0の軸は offset だけで復元できるので0
+	const float p[3] = { position.x, position.y, position.z };
+	const float offset[3] = { params.offset.x, params.offset.y, params.offset.z };
+	const float scale[3] = { params.scale.x, params.scale.y, params.scale.z };
+	for (int axis = 0; axis < 3; ++axis) {
+		packed.position[axis] = scale[axis] > 0.0f ? EncodeUnorm16((p[axis] - offset[axis]) / scale[axis]) : 0;
+	}
+	packed.position[3] = 0;
+
+	packed.texcoord[0] = FloatToHalf(texcoord.x);
+	packed.texcoord[1] = FloatToHalf(texcoord.y);
+
+	EncodeOctahedral(normal, packed.normal);
+	return packed;
+}
+
+void VertexQuantizer::DecodeVertex(const PackedVertex& packed, const QuantizationParams& params, Vector3& position, Vector2& texcoord, Vector3& normal)
+{
+	position = {
+		params.offset.x + DecodeUnorm16(packed.position[0]) * params.scale.x,
+		params.offset.y + DecodeUnorm16(packed.position[1]) * params.scale.y,
+		params.offset.z + DecodeUnorm16(packed.position[2]) * params.scale.z,
+	};
+	texcoord = { HalfToFloat(packed.texcoord[0]), HalfToFloat(packed.texcoord[1]) };
+	normal = DecodeOctahedral(packed.normal);
+}
+
+VertexQuantizer::PackedInfluence VertexQuantizer::EncodeInfluence(const float weights[kNumInfluence], const int32_t jointIndices[kNumInfluence])
+{
+	PackedInfluence packed{};
+
+	float total = 0.0f;
+	for (uint32_t i = 0; i < kNumInfluence; ++i) {
+		total += (std::max)(weights[i], 0.0f);
+	}
+
+	// 切り捨てた後、端数の大きい順に1ずつ足して合計を255にする
+	if (total > 0.0f) {
+		float remainders[kNumInfluence];
+		uint32_t sum = 0;
+		for (uint32_t i = 0; i < kNumInfluence; ++i) {
+			const float scaled = (std::max)(weights[i], 0.0f) / total * 255.0f;
+			const uint32_t quantized = (std::min)(static_cast<uint32_t>(scaled), 255u);
+			packed.weights[i] = static_cast<uint8_t>(quantized);
+			remainders[i] = scaled - static_cast<float>(quantized);
+			sum += quantized;
+		}
+		while (sum < 255) {
+			uint32_t best = 0;
+			for (uint32_t i = 1; i < kNumInfluence; ++i) {
+				if (remainders[i] > remainders[best]) {
+					best = i;
+				}
+			}
+			++packed.weights[best];
+			remainders[best] = -1.0f;
+			++sum;
+		}
+	}
+
+	for (uint32_t i = 0; i < kNumInfluence; ++i) {
+		assert(jointIndices[i] >= 0 && static_cast<uint32_t>(jointIndices[i]) < kMaxPackedJoints);
+		packed.jointIndices[i] = static_cast<uint8_t>(jointIndices[i]);
+	}
+	return packed;
+}
+
+void VertexQuantizer::DecodeInfluence(const PackedInfluence& packed, float weights[kNumInfluence], int32_t jointIndices[kNumInfluence])
+{
+	for (uint32_t i = 0; i < kNumInfluence; ++i) {
+		weights[i] = static_cast<float>(packed.weights[i]) / 255.0f;
+		jointIndices[i] = packed.jointIndices[i];
+	}
+}
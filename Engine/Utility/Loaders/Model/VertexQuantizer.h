@@ -0,0 +1,181 @@
+#pragma once
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Math
+#include "Vector2.h"
+#include "Vector3.h"
+
+/// <summary>
+/// インポート時の頂点の圧縮 (D3D12・Assimpには依存しない)
+/// 位置はメッシュのAABBで正規化した16bit、法線は八面体マッピングの16bit×2、UVは半精度浮動小数にして
+/// 36バイトの頂点を16バイトにする。スキニングの重みとジョイント番号は8bitずつにする
+/// 復元はシェーダー (InstanceObjPacked.VS.hlsl) と同じ計算を Decode～ で行える
+/// </summary>
+namespace VertexQuantizer {
+
+	// 圧縮できるUVの絶対値の上限 (これより大きいと半精度では粗すぎる)
+	static constexpr float kMaxTexcoord = 256.0f;
+	// 8bitのジョイント番号で表せるジョイント数
+	static constexpr uint32_t kMaxPackedJoints = 256;
+	// 1頂点あたりのインフルエンス数
+	static constexpr uint32_t kNumInfluence = 4;
+
+	// 圧縮した頂点 (DXGI_FORMAT_R16G16B16A16_UNORM / R16G16_FLOAT / R16G16_SNORM)
+	struct PackedVertex {
+		uint16_t position[4];	// QuantizationParams で正規化した位置 (wは0)
+		uint16_t texcoord[2];	// 半精度浮動小数
+		int16_t normal[2];		// 八面体マッピングした法線
+	};
+	static_assert(sizeof(PackedVertex) == 16);
+
+	// 圧縮したインフルエンス (DXGI_FORMAT_R8G8B8A8_UNORM / R8G8B8A8_UINT)
+	struct PackedInfluence {
+		uint8_t weights[kNumInfluence];		// 合計が255になるように丸める
+		uint8_t jointIndices[kNumInfluence];
+	};
+	static_assert(sizeof(PackedInfluence) == 8);
+
+	// 位置の復元用の定数 (position = offset + unorm * scale、シェーダーのルート定数と同じレイアウト)
+	struct QuantizationParams {
+		Vector3 offset{};
+		float padding0 = 0.0f;
+		Vector3 scale{};
+		float padding1 = 0.0f;
+	};
+	static_assert(sizeof(QuantizationParams) == sizeof(float) * 8);
+	// ルート定数として送る32bit値の数
+	static constexpr uint32_t kQuantizationConstantCount = sizeof(QuantizationParams) / sizeof(float);
+
+	// 復元した時の最大誤差
+	struct Error {
+		float position = 0.0f;		// ワールド単位の距離
+		float normalDegrees = 0.0f;	// 正規化した元の法線との角度
+		float texcoord = 0.0f;
+	};
+
+	/*===============================================//
+						個別の変換
+	//===============================================*/
+
+	/// <summary>
+	/// 半精度浮動小数へ (最近接偶数丸め、範囲外は無限大)
+	/// </summary>
+	uint16_t FloatToHalf(float value);
+	float HalfToFloat(uint16_t value);
+
+	/// <summary>
+	/// 0～1を16bitの正規化整数へ (範囲外は切り詰める)
+	/// </summary>
+	uint16_t EncodeUnorm16(float value);
+	float DecodeUnorm16(uint16_t value);
+
+	/// <summary>
+	/// 法線を八面体マッピングして16bitの符号付き正規化整数2つにする
+	/// 丸め方4通りのうち復元後の誤差が一番小さいものを選ぶ (長さ0なら+Z)
+	/// </summary>
+	void EncodeOctahedral(const Vector3& normal, int16_t out[2]);
+	Vector3 DecodeOctahedral(const int16_t encoded[2]);
+
+	/// <summary>
+	/// 位置の範囲から復元用の定数を求める
+	/// </summary>
+	/// <param name="positions">先頭頂点の x (x, y, z が並んでいること)</param>
+	/// <param name="stride">頂点1つ分のバイト数</param>
+	QuantizationParams CalculateParams(const float* positions, uint32_t stride, uint32_t vertexCount);
+
+	/// <summary>
+	/// 1頂点分の圧縮と復元
+	/// </summary>
+	PackedVertex EncodeVertex(const Vector3& position, const Vector2& texcoord, const Vector3& normal, const QuantizationParams& params);
+	void DecodeVertex(const PackedVertex& packed, const QuantizationParams& params, Vector3& position, Vector2& texcoord, Vector3& normal);
+
+	/// <summary>
+	/// インフルエンスの圧縮 (重みは合計を255にして割り振り、ジョイント番号は kMaxPackedJoints 未満であること)
+	/// </summary>
+	PackedInfluence EncodeInfluence(const float weights[kNumInfluence], const int32_t jointIndices[kNumInfluence]);
+	void DecodeInfluence(const PackedInfluence& packed, float weights[kNumInfluence], int32_t jointIndices[kNumInfluence]);
+
+	/*===============================================//
+						メッシュ単位
+	//===============================================*/
+
+	/// <summary>
+	/// 圧縮できるか (UVが kMaxTexcoord を超える、または有限でない値があれば圧縮しない)
+	/// </summary>
+	template<class Vertex>
+	bool CanPack(const std::vector<Vertex>& vertices)
+	{
+		for (const Vertex& vertex : vertices) {
+			const float values[] = {
+				vertex.position.x, vertex.position.y, vertex.position.z,
+				vertex.normal.x, vertex.normal.y, vertex.normal.z,
+				vertex.texcoord.x, vertex.texcoord.y,
+			};
+			for (float value : values) {
+				if (!std::isfinite(value)) {
+					return false;
+				}
+			}
+			if (std::fabs(vertex.texcoord.x) > kMaxTexcoord || std::fabs(vertex.texcoord.y) > kMaxTexcoord) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// メッシュ全体を圧縮する (Vertex は position・texcoord・normal を持つこと)
+	/// </summary>
+	/// <returns>圧縮できなければfalse (outは変更しない)</returns>
+	template<class Vertex>
+	bool PackVertices(const std::vector<Vertex>& vertices, std::vector<PackedVertex>& out, QuantizationParams& outParams)
+	{
+		if (vertices.empty() || !CanPack(vertices)) {
+			return false;
+		}
+
+		outParams = CalculateParams(&vertices[0].position.x, static_cast<uint32_t>(sizeof(Vertex)), static_cast<uint32_t>(vertices.size()));
+		out.resize(vertices.size());
+		for (size_t i = 0; i < vertices.size(); ++i) {
+			const Vertex& vertex = vertices[i];
+			out[i] = EncodeVertex({ vertex.position.x, vertex.position.y, vertex.position.z }, vertex.texcoord, vertex.normal, outParams);
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// 圧縮前の頂点と比べた最大誤差
+	/// </summary>
+	template<class Vertex>
+	Error MeasureError(const std::vector<Vertex>& vertices, const std::vector<PackedVertex>& packed, const QuantizationParams& params)
+	{
+		Error error;
+		float minCos = 1.0f;
+		for (size_t i = 0; i < vertices.size() && i < packed.size(); ++i) {
+			Vector3 position;
+			Vector2 texcoord;
+			Vector3 normal;
+			DecodeVertex(packed[i], params, position, texcoord, normal);
+
+			const Vertex& vertex = vertices[i];
+			const float dx = position.x - vertex.position.x;
+			const float dy = position.y - vertex.position.y;
+			const float dz = position.z - vertex.position.z;
+			error.position = (std::max)(error.position, std::sqrt(dx * dx + dy * dy + dz * dz));
+			error.texcoord = (std::max)(error.texcoord, (std::max)(std::fabs(texcoord.x - vertex.texcoord.x), std::fabs(texcoord.y - vertex.texcoord.y)));
+
+			const float length = std::sqrt(vertex.normal.x * vertex.normal.x + vertex.normal.y * vertex.normal.y + vertex.normal.z * vertex.normal.z);
+			if (length > 0.0f) {
+				const float cosine = (normal.x * vertex.normal.x + normal.y * vertex.normal.y + normal.z * vertex.normal.z) / length;
+				minCos = (std::min)(minCos, cosine);
+			}
+		}
+		error.normalDegrees = std::acos((std::clamp)(minCos, -1.0f, 1.0f)) * 57.2957795f;
+		return error;
+	}
+}
@@ -0,0 +1,180 @@
+#include "AtlasPacker.h"
+// C++
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+/// <summary>
+/// 初期化
+/// </summary>
+void AtlasPacker::Initialize(uint32_t pageWidth, uint32_t pageHeight, uint32_t padding)
+{
+    pageWidth_ = pageWidth;
+    pageHeight_ = pageHeight;
+    padding_ = padding;
+    skylines_.clear();
+    usedArea_ = 0;
+}
+
+/// <summary>
+/// まとめて配置する
+/// </summary>
+bool AtlasPacker::Pack(const std::vector<Size>& sizes, std::vector<Rect>& outRects)
+{
+    outRects.assign(sizes.size(), Rect{});
+
+    // 高さ → 幅の大きい順に詰めると段差が減る
+    std::vector<uint32_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&sizes](uint32_t a, uint32_t b) {
+        if (sizes[a].height != sizes[b].height) { return sizes[a].height > sizes[b].height; }
+        return sizes[a].width > sizes[b].width;
+        });
+
+    bool allPacked = true;
+    for (uint32_t i : order) {
+        const uint32_t width = sizes[i].width + padding_ * 2;
+        const uint32_t height = sizes[i].height + padding_ * 2;
+        if (width > pageWidth_ || height > pageHeight_) {
+            allPacked = false;
+            outRects[i] = { UINT32_MAX, 0, 0, sizes[i].width, sizes[i].height };
+            continue;
+        }
+
+        // 既存ページの先頭から空きを探し、無ければページを追加
+        uint32_t page = 0;
+        uint32_t x = 0, y = 0;
+        size_t index = 0;
+        for (; page < skylines_.size(); ++page) {
+            if (FindPosition(skylines_[page], width, height, x, y, index)) {
+                break;
+            }
+        }
+        if (page == skylines_.size()) {
+            skylines_.push_back({ Node{ 0, 0, pageWidth_ } });
+            FindPosition(skylines_[page], width, height, x, y, index);
+        }
+
+        AddLevel(skylines_[page], index, x, y, width, height);
+        usedArea_ += uint64_t(width) * height;
+        outRects[i] = { page, x + padding_, y + padding_, sizes[i].width, sizes[i].height };
+    }
+    return allPacked;
+}
+
+/// <summary>
+/// ページ内で使っている高さ
+/// </summary>
+uint32_t AtlasPacker::GetUsedHeight(uint32_t page) const
+{
+    uint32_t height = 0;
+    for (const Node& node : skylines_[page]) {
+        height = (std::max)(height, node.y);
+    }
+    return height;
+}
+
+/// <summary>
+/// 充填率
+/// </summary>
+float AtlasPacker::GetOccupancy() const
+{
+    double total = 0.0;
+    for (uint32_t page = 0; page < GetPageCount(); ++page) {
+        total += double(pageWidth_) * GetUsedHeight(page);
+    }
+    if (total <= 0.0) {
+        return 0.0f;
+    }
+    return static_cast<float>(double(usedArea_) / total);
+}
+
+/// <summary>
+/// 最も低い位置を探す
+/// </summary>
+bool AtlasPacker::FindPosition(const std::vector<Node>& skyline, uint32_t width, uint32_t height,
+    uint32_t& outX, uint32_t& outY, size_t& outIndex) const
+{
+    uint32_t bestY = std::numeric_limits<uint32_t>::max();
+    uint32_t bestWidth = std::numeric_limits<uint32_t>::max();
+    bool found = false;
+
+    for (size_t i = 0; i < skyline.size(); ++i) {
+        uint32_t y = 0;
+        if (!Fit(skyline, i, width, height, y)) {
+            continue;
+        }
+        // 底の低い位置を優先し、同じなら幅の狭い区間 (隙間が残りにくい) を選ぶ
+        if (y < bestY || (y == bestY && skyline[i].width < bestWidth)) {
+            bestY = y;
+            bestWidth = skyline[i].width;
+            outX = skyline[i].x;
+            outY = y;
+            outIndex = i;
+            found = true;
+        }
+    }
+    return found;
+}
+
+/// <summary>
+/// 指定区間から置いたときの底の高さ
+/// </summary>
+bool AtlasPacker::Fit(const std::vector<Node>& skyline, size_t index, uint32_t width, uint32_t height, uint32_t& outY) const
+{
+    const uint32_t x = skyline[index].x;
+    if (x + width > pageWidth_) {
+        return false;
+    }
+
+    // 幅が覆う区間のうち最も高いところに乗る
+    uint32_t y = 0;
+    uint32_t remaining = width;
+    for (size_t i = index; remaining > 0; ++i) {
+        if (i >= skyline.size()) {
+            return false;
+        }
+        y = (std::max)(y, skyline[i].y);
+        if (y + height > pageHeight_) {
+            return false;
+        }
+        remaining -= (std::min)(remaining, skyline[i].width);
+    }
+    outY = y;
+    return true;
+}
+
+/// <summary>
+/// スカイラインの更新
+/// </summary>
+void AtlasPacker::AddLevel(std::vector<Node>& skyline, size_t index, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    skyline.insert(skyline.begin() + index, Node{ x, y + height, width });
+
+    // 新しい区間に覆われた部分を削る
+    for (size_t i = index + 1; i < skyline.size();) {
+        const Node& prev = skyline[i - 1];
+        const uint32_t prevRight = prev.x + prev.width;
+        if (skyline[i].x >= prevRight) {
+            break;
+        }
+        const uint32_t shrink = prevRight - skyline[i].x;
+        if (skyline[i].width <= shrink) {
+            skyline.erase(skyline.begin() + i);
+            continue;
+        }
+        skyline[i].x += shrink;
+        skyline[i].width -= shrink;
+        break;
+    }
+
+    // 同じ高さの隣接区間をまとめる
+    for (size_t i = 0; i + 1 < skyline.size();) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+}
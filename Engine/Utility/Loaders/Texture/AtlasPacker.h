@@ -0,0 +1,99 @@
+#pragma once
+// C++
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// スカイライン法による矩形パッカー
+/// 描画APIに依存しないので、アトラスのページ配置だけを計算する
+/// </summary>
+class AtlasPacker
+{
+public: // 構造体
+
+    // 配置する画像のサイズ
+    struct Size {
+        uint32_t width;
+        uint32_t height;
+    };
+
+    // 配置結果 (x, y はパディングを除いた画像の左上)
+    struct Rect {
+        uint32_t page;
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+        uint32_t height;
+    };
+
+public: // メンバ関数
+
+    /// <summary>
+    /// 初期化
+    /// </summary>
+    /// <param name="pageWidth">ページの幅</param>
+    /// <param name="pageHeight">ページの高さ</param>
+    /// <param name="padding">画像の周囲に確保する余白 (にじみ防止)</param>
+    void Initialize(uint32_t pageWidth, uint32_t pageHeight, uint32_t padding);
+
+    /// <summary>
+    /// まとめて配置する (高さの大きい順に詰め、結果は入力と同じ順に返す)
+    /// </summary>
+    /// <returns>1枚のページに収まらない画像があれば false</returns>
+    bool Pack(const std::vector<Size>& sizes, std::vector<Rect>& outRects);
+
+    /// <summary>
+    /// 使用ページ数
+    /// </summary>
+    uint32_t GetPageCount() const { return static_cast<uint32_t>(skylines_.size()); }
+
+    /// <summary>
+    /// ページ内で実際に使っている高さ (ページを切り詰めて作るときに使う)
+    /// </summary>
+    uint32_t GetUsedHeight(uint32_t page) const;
+
+    /// <summary>
+    /// 充填率 (パディング込みの使用面積 / 使用高さで切り詰めたページ面積)
+    /// </summary>
+    float GetOccupancy() const;
+
+    uint32_t GetPageWidth() const { return pageWidth_; }
+    uint32_t GetPageHeight() const { return pageHeight_; }
+
+private: // 内部処理
+
+    // スカイラインの1区間
+    struct Node {
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+    };
+
+    /// <summary>
+    /// 1枚のページ内で最も低い (同じ高さなら隙間の少ない) 位置を探す
+    /// </summary>
+    bool FindPosition(const std::vector<Node>& skyline, uint32_t width, uint32_t height,
+        uint32_t& outX, uint32_t& outY, size_t& outIndex) const;
+
+    /// <summary>
+    /// 指定区間から幅 width を置いたときの底の高さ
+    /// </summary>
+    bool Fit(const std::vector<Node>& skyline, size_t index, uint32_t width, uint32_t height, uint32_t& outY) const;
+
+    /// <summary>
+    /// 配置した矩形でスカイラインを更新する
+    /// </summary>
+    void AddLevel(std::vector<Node>& skyline, size_t index, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+private: // メンバ変数
+
+    uint32_t pageWidth_ = 2048;
+    uint32_t pageHeight_ = 2048;
+    uint32_t padding_ = 2;
+
+    // ページごとのスカイライン
+    std::vector<std::vector<Node>> skylines_;
+    // 使用済み面積
+    uint64_t usedArea_ = 0;
+};
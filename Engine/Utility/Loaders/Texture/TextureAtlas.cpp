@@ -0,0 +1,337 @@
+#include "TextureAtlas.h"
+// C++
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <json.hpp>
+
+// Engine
+#include "TextureManager.h"
+#include "AtlasPacker.h"
+#include "Loaders/Archive/FileSystem.h"
+#include "DirectXTex.h"
+
+using json = nlohmann::json;
+
+namespace {
+    // マニフェストの形式が変わったら上げる
+    constexpr uint32_t kManifestVersion = 2;
+}
+
+// シングルトンインスタンスの初期化
+std::unique_ptr<TextureAtlas> TextureAtlas::instance = nullptr;
+std::once_flag TextureAtlas::initInstanceFlag;
+
+/// <summary>
+/// シングルトンインスタンスの取得
+/// </summary>
+TextureAtlas* TextureAtlas::GetInstance()
+{
+    std::call_once(initInstanceFlag, []() {
+        instance = std::make_unique<TextureAtlas>();
+        });
+    return instance.get();
+}
+
+/// <summary>
+/// 終了処理
+/// </summary>
+void TextureAtlas::Finalize()
+{
+    instance.reset();
+}
+
+/// <summary>
+/// 初期化
+/// </summary>
+/// <param name="directories">走査する素材フォルダ</param>
+void TextureAtlas::Initialize(const std::vector<std::string>& directories)
+{
+    regions_.clear();
+    pagePaths_.clear();
+    stats_ = {};
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<Source> sources = CollectSources(directories);
+    if (sources.empty()) {
+        return;
+    }
+
+    // 素材が変わっていなければ詰め直さない
+    stats_.fromCache = LoadManifest(sources);
+    if (!stats_.fromCache) {
+        Build(sources);
+    }
+
+    // ページはTextureManagerで読み込む
+    // ミップやBC圧縮は隣の画像とにじむので、ページは非圧縮・ミップ無しにする
+    TextureCooker::Options pageOptions;
+    pageOptions.generateMips = false;
+    pageOptions.compress = false;
+    for (const std::string& pagePath : pagePaths_) {
+        TextureManager::GetInstance()->LoadTexture(pagePath, pageOptions);
+    }
+
+    stats_.imageCount = static_cast<uint32_t>(regions_.size());
+    stats_.pageCount = static_cast<uint32_t>(pagePaths_.size());
+    stats_.buildMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    TextureManager::GetInstance()->Log(
+        "TextureAtlas: " + std::to_string(stats_.imageCount) + " images, " +
+        std::to_string(stats_.pageCount) + " pages, occupancy " + std::to_string(stats_.occupancy * 100.0f) + "%, " +
+        (stats_.fromCache ? "cached" : "pack " + std::to_string(stats_.packMs) + "ms") +
+        ", total " + std::to_string(stats_.buildMs) + "ms\n");
+}
+
+/// <summary>
+/// 領域の取得
+/// </summary>
+const TextureAtlas::Region* TextureAtlas::FindRegion(const std::string& filePath) const
+{
+    if (regions_.empty()) {
+        return nullptr;
+    }
+    auto it = regions_.find(NormalizePath(filePath));
+    if (it == regions_.end()) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+/// <summary>
+/// 素材フォルダの走査
+/// </summary>
+std::vector<TextureAtlas::Source> TextureAtlas::CollectSources(const std::vector<std::string>& directories) const
+{
+    std::vector<Source> sources;
+    FileSystem* fileSystem = FileSystem::GetInstance();
+    for (const std::string& directory : directories) {
+        // アーカイブ内とディスク上のファイルを合わせて走査する
+        for (const std::string& filePath : fileSystem->EnumerateFiles(directory)) {
+            std::string extension = std::filesystem::path(filePath).extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+            if (extension != ".png" && extension != ".jpg") {
+                continue;
+            }
+
+            Source source;
+            source.filePath = NormalizePath(filePath);
+
+            // サイズはヘッダーだけ読んで判定する
+            DirectX::TexMetadata metadata{};
+            FileSystem::FileView file = fileSystem->Open(source.filePath);
+            FileSystem::FileStamp stamp;
+            if (!file.IsValid() || !fileSystem->GetStamp(source.filePath, stamp) ||
+                FAILED(DirectX::GetMetadataFromWICMemory(file.GetData(), file.GetSize(), DirectX::WIC_FLAGS_NONE, metadata))) {
+                continue;
+            }
+            if (metadata.width > kMaxImageSize || metadata.height > kMaxImageSize) {
+                continue;
+            }
+            source.width = static_cast<uint32_t>(metadata.width);
+            source.height = static_cast<uint32_t>(metadata.height);
+            source.fileSize = stamp.size;
+            source.writeTime = stamp.writeTime;
+            sources.push_back(source);
+        }
+    }
+
+    // 走査順に依存しないようにそろえる
+    std::sort(sources.begin(), sources.end(), [](const Source& a, const Source& b) {
+        return a.filePath < b.filePath;
+        });
+    return sources;
+}
+
+/// <summary>
+/// マニフェストからの復元
+/// </summary>
+bool TextureAtlas::LoadManifest(const std::vector<Source>& sources)
+{
+    FileSystem::FileView file = FileSystem::GetInstance()->Open(kManifestPath);
+    if (!file.IsValid()) {
+        return false;
+    }
+
+    const std::string_view text = file.GetText();
+    json manifest = json::parse(text.begin(), text.end(), nullptr, false);
+    if (manifest.is_discarded() ||
+        manifest.value("version", 0u) != kManifestVersion ||
+        manifest.value("pageSize", 0u) != kPageSize ||
+        manifest.value("padding", 0u) != kPadding ||
+        !manifest.contains("pages") || !manifest.contains("images")) {
+        return false;
+    }
+
+    // 素材の一覧・サイズ・更新日時が全て一致するときだけ使う
+    const json& images = manifest["images"];
+    if (images.size() != sources.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < sources.size(); ++i) {
+        const json& image = images[i];
+        if (image.value("path", "") != sources[i].filePath ||
+            image.value("width", 0u) != sources[i].width ||
+            image.value("height", 0u) != sources[i].height ||
+            image.value("fileSize", uint64_t(0)) != sources[i].fileSize ||
+            image.value("writeTime", int64_t(0)) != sources[i].writeTime) {
+            return false;
+        }
+    }
+
+    std::vector<std::string> pagePaths = manifest["pages"].get<std::vector<std::string>>();
+    for (const std::string& pagePath : pagePaths) {
+        if (!FileSystem::GetInstance()->Exists(pagePath)) {
+            return false;
+        }
+    }
+
+    pagePaths_ = std::move(pagePaths);
+    for (const json& image : images) {
+        uint32_t page = image["page"].get<uint32_t>();
+        if (page >= pagePaths_.size()) {
+            regions_.clear();
+            pagePaths_.clear();
+            return false;
+        }
+        Region& region = regions_[image["path"].get<std::string>()];
+        region.pagePath = pagePaths_[page];
+        region.leftTop = { image["x"].get<float>(), image["y"].get<float>() };
+        region.size = { image["width"].get<float>(), image["height"].get<float>() };
+    }
+    stats_.occupancy = manifest.value("occupancy", 0.0f);
+    return true;
+}
+
+/// <summary>
+/// 詰め込みと書き出し
+/// </summary>
+void TextureAtlas::Build(const std::vector<Source>& sources)
+{
+    // 配置の計算
+    std::vector<AtlasPacker::Size> sizes;
+    sizes.reserve(sources.size());
+    for (const Source& source : sources) {
+        sizes.push_back({ source.width, source.height });
+    }
+
+    AtlasPacker packer;
+    packer.Initialize(kPageSize, kPageSize, kPadding);
+    std::vector<AtlasPacker::Rect> rects;
+    auto packStart = std::chrono::steady_clock::now();
+    packer.Pack(sizes, rects);
+    stats_.packMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - packStart).count();
+    stats_.occupancy = packer.GetOccupancy();
+
+    // ページ画像を用意 (高さは使った分だけに切り詰める)
+    std::vector<DirectX::ScratchImage> pages(packer.GetPageCount());
+    for (uint32_t page = 0; page < packer.GetPageCount(); ++page) {
+        uint32_t height = (std::max)((packer.GetUsedHeight(page) + 3u) & ~3u, 4u);
+        HRESULT hr = pages[page].Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM, kPageSize, height, 1, 1);
+        assert(SUCCEEDED(hr));
+        std::memset(pages[page].GetPixels(), 0, pages[page].GetPixelsSize());
+    }
+
+    // 元画像をページへ書き込む
+    for (size_t i = 0; i < sources.size(); ++i) {
+        const AtlasPacker::Rect& rect = rects[i];
+        if (rect.page >= pages.size()) {
+            continue;
+        }
+
+        DirectX::ScratchImage image{};
+        FileSystem::FileView file = FileSystem::GetInstance()->Open(sources[i].filePath);
+        assert(file.IsValid());
+        // sRGBのタグは無視して、8bitの値をそのままページへ写す
+        // (ページは FORCE_SRGB で読むので、ここで線形へ変換すると個別に読んだ時より暗くなる)
+        HRESULT hr = DirectX::LoadFromWICMemory(file.GetData(), file.GetSize(), DirectX::WIC_FLAGS_IGNORE_SRGB, nullptr, image);
+        assert(SUCCEEDED(hr));
+        if (image.GetMetadata().format != DXGI_FORMAT_R8G8B8A8_UNORM) {
+            DirectX::ScratchImage converted{};
+            hr = DirectX::Convert(*image.GetImage(0, 0, 0), DXGI_FORMAT_R8G8B8A8_UNORM,
+                DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, converted);
+            assert(SUCCEEDED(hr));
+            image = std::move(converted);
+        }
+
+        const DirectX::Image* src = image.GetImage(0, 0, 0);
+        const DirectX::Image* dst = pages[rect.page].GetImage(0, 0, 0);
+        const int32_t width = static_cast<int32_t>(rect.width);
+        const int32_t height = static_cast<int32_t>(rect.height);
+        const int32_t pad = static_cast<int32_t>(kPadding);
+
+        // 余白は縁のピクセルを引き伸ばして埋める (バイリニアでのにじみ防止)
+        for (int32_t y = -pad; y < height + pad; ++y) {
+            const int32_t srcY = std::clamp(y, 0, height - 1);
+            const uint8_t* srcRow = src->pixels + size_t(srcY) * src->rowPitch;
+            uint8_t* dstRow = dst->pixels + size_t(int32_t(rect.y) + y) * dst->rowPitch;
+            for (int32_t x = -pad; x < width + pad; ++x) {
+                const int32_t srcX = std::clamp(x, 0, width - 1);
+                std::memcpy(dstRow + size_t(int32_t(rect.x) + x) * 4, srcRow + size_t(srcX) * 4, 4);
+            }
+        }
+    }
+
+    // ページ画像の保存
+    std::filesystem::create_directories(kOutputDirectory);
+    for (uint32_t page = 0; page < pages.size(); ++page) {
+        std::string pagePath = kOutputDirectory + "/AtlasPage" + std::to_string(page) + ".png";
+        std::wstring pagePathW = TextureManager::GetInstance()->ConvertString(pagePath);
+        HRESULT hr = DirectX::SaveToWICFile(*pages[page].GetImage(0, 0, 0), DirectX::WIC_FLAGS_NONE,
+            DirectX::GetWICCodec(DirectX::WIC_CODEC_PNG), pagePathW.c_str());
+        assert(SUCCEEDED(hr));
+        pagePaths_.push_back(pagePath);
+    }
+
+    // 領域とマニフェスト
+    json manifest;
+    manifest["version"] = kManifestVersion;
+    manifest["pageSize"] = kPageSize;
+    manifest["padding"] = kPadding;
+    manifest["occupancy"] = stats_.occupancy;
+    manifest["pages"] = pagePaths_;
+    manifest["images"] = json::array();
+    for (size_t i = 0; i < sources.size(); ++i) {
+        const AtlasPacker::Rect& rect = rects[i];
+        if (rect.page >= pagePaths_.size()) {
+            continue;
+        }
+        Region& region = regions_[sources[i].filePath];
+        region.pagePath = pagePaths_[rect.page];
+        region.leftTop = { float(rect.x), float(rect.y) };
+        region.size = { float(rect.width), float(rect.height) };
+
+        manifest["images"].push_back({
+            { "path", sources[i].filePath },
+            { "width", sources[i].width },
+            { "height", sources[i].height },
+            { "fileSize", sources[i].fileSize },
+            { "writeTime", sources[i].writeTime },
+            { "page", rect.page },
+            { "x", rect.x },
+            { "y", rect.y },
+            });
+    }
+
+    std::ofstream file(kManifestPath);
+    if (file.is_open()) {
+        file << manifest.dump(4);
+    }
+}
+
+/// <summary>
+/// パスの表記をそろえる
+/// </summary>
+std::string TextureAtlas::NormalizePath(const std::string& filePath)
+{
+    std::string result = filePath;
+    std::replace(result.begin(), result.end(), '\\', '/');
+    while (result.rfind("./", 0) == 0) {
+        result.erase(0, 2);
+    }
+    return result;
+}
@@ -0,0 +1,124 @@
+#pragma once
+// C++
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+
+// Math
+#include "Vector2.h"
+
+/// <summary>
+/// UI・スプライト用の小さい画像をまとめたテクスチャアトラス
+/// 起動時に素材フォルダを走査してページに詰め、結果をマニフェストに残す
+/// 素材が変わっていなければマニフェストとページ画像をそのまま使う
+/// </summary>
+class TextureAtlas
+{
+public: // 構造体
+
+    // アトラス内の1画像分の領域 (ピクセル単位)
+    struct Region {
+        std::string pagePath;   // ページ画像のファイルパス
+        Vector2 leftTop;        // ページ内の左上座標
+        Vector2 size;           // 元画像のサイズ
+    };
+
+    // 直近の構築情報
+    struct Stats {
+        bool fromCache = false; // マニフェストから復元したか
+        uint32_t imageCount = 0;
+        uint32_t pageCount = 0;
+        float occupancy = 0.0f; // ページの充填率
+        float packMs = 0.0f;    // 詰め込みにかかった時間
+        float buildMs = 0.0f;   // 読み込み〜保存まで含めた時間
+    };
+
+public: // メンバ関数
+
+    /// <summary>
+    /// シングルトンインスタンスの取得
+    /// </summary>
+    static TextureAtlas* GetInstance();
+
+    /// <summary>
+    /// 終了処理
+    /// </summary>
+    void Finalize();
+
+    TextureAtlas() = default;
+    ~TextureAtlas() = default;
+
+    /// <summary>
+    /// 初期化 (アトラスの構築またはキャッシュからの復元とページの読み込み)
+    /// </summary>
+    /// <param name="directories">走査する素材フォルダ</param>
+    void Initialize(const std::vector<std::string>& directories);
+
+    /// <summary>
+    /// ファイルパスに対応する領域の取得 (アトラスに含まれなければ nullptr)
+    /// </summary>
+    const Region* FindRegion(const std::string& filePath) const;
+
+    const Stats& GetStats() const { return stats_; }
+
+public: // 定数
+
+    // ページのサイズ
+    static constexpr uint32_t kPageSize = 2048;
+    // 画像の周囲に入れる余白 (縁のピクセルを複製してにじみを防ぐ)
+    static constexpr uint32_t kPadding = 2;
+    // これより大きい画像はアトラスに入れない
+    static constexpr uint32_t kMaxImageSize = 512;
+    // 出力先
+    static inline const std::string kOutputDirectory = "Resources/Atlas";
+    static inline const std::string kManifestPath = "Resources/Atlas/AtlasManifest.json";
+
+private: // 内部処理
+
+    // 素材1枚分の情報 (キャッシュの鮮度判定に使う)
+    struct Source {
+        std::string filePath;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint64_t fileSize = 0;
+        int64_t writeTime = 0;
+    };
+
+    /// <summary>
+    /// 素材フォルダの走査
+    /// </summary>
+    std::vector<Source> CollectSources(const std::vector<std::string>& directories) const;
+
+    /// <summary>
+    /// マニフェストからの復元 (素材が変わっていれば false)
+    /// </summary>
+    bool LoadManifest(const std::vector<Source>& sources);
+
+    /// <summary>
+    /// 詰め込みとページ画像・マニフェストの書き出し
+    /// </summary>
+    void Build(const std::vector<Source>& sources);
+
+    /// <summary>
+    /// パスの表記ゆれ ("./" や "\\") をそろえる
+    /// </summary>
+    static std::string NormalizePath(const std::string& filePath);
+
+private: // メンバ変数
+
+    // シングルトンインスタンス
+    static std::unique_ptr<TextureAtlas> instance;
+    static std::once_flag initInstanceFlag;
+
+    TextureAtlas(TextureAtlas&) = delete;
+    TextureAtlas& operator=(TextureAtlas&) = delete;
+
+    // 元画像のパス → 領域
+    std::unordered_map<std::string, Region> regions_;
+    // ページ画像のパス
+    std::vector<std::string> pagePaths_;
+
+    Stats stats_;
+};
@@ -0,0 +1,162 @@
+#include "TextureCooker.h"
+// C++
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+
+// Engine
+#include "TextureManager.h"
+#include "Loaders/Archive/FileSystem.h"
+
+namespace {
+    // クックの手順を変えたら上げる (古いキャッシュは自然に使われなくなる)
+    constexpr uint32_t kCookVersion = 1;
+
+    /// <summary>
+    /// FNV-1a 64bit
+    /// </summary>
+    uint64_t HashBytes(const void* data, size_t size, uint64_t hash = 14695981039346656037ull)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+}
+
+/// <summary>
+/// ファイル名から既定の設定を作る
+/// </summary>
+TextureCooker::Options TextureCooker::GetDefaultOptions(const std::string& filePath)
+{
+    Options options;
+    std::string stem = std::filesystem::path(filePath).stem().string();
+    std::transform(stem.begin(), stem.end(), stem.begin(), ::tolower);
+    auto endsWith = [&stem](const std::string& suffix) {
+        return stem.size() >= suffix.size() && stem.compare(stem.size() - suffix.size(), suffix.size(), suffix) == 0;
+        };
+    options.normalMap = endsWith("_normal") || endsWith("_n");
+    return options;
+}
+
+/// <summary>
+/// クック済みDDSの読み込み (無ければクック)
+/// </summary>
+TextureCooker::Result TextureCooker::Load(const std::string& filePath, const Options& options, DirectX::ScratchImage& outImage)
+{
+    Result result;
+    auto start = std::chrono::steady_clock::now();
+
+    std::string cachePath = GetCachePath(filePath, options);
+    std::wstring cachePathW = TextureManager::GetInstance()->ConvertString(cachePath);
+
+    // キャッシュがあればそのまま使う (アーカイブに入っていればそこから読む)
+    FileSystem::FileView cache = FileSystem::GetInstance()->Open(cachePath);
+    if (cache.IsValid() &&
+        SUCCEEDED(DirectX::LoadFromDDSMemory(cache.GetData(), cache.GetSize(), DirectX::DDS_FLAGS_NONE, nullptr, outImage))) {
+        result.cacheHit = true;
+    } else {
+        // 壊れたキャッシュを上書きできるようにマップを閉じておく
+        cache = {};
+        Cook(filePath, options, outImage);
+
+        // 書き出しに失敗しても今回の読み込みには影響しない
+        std::filesystem::create_directories(kCacheDirectory);
+        HRESULT hr = DirectX::SaveToDDSFile(outImage.GetImages(), outImage.GetImageCount(), outImage.GetMetadata(),
+            DirectX::DDS_FLAGS_NONE, cachePathW.c_str());
+        if (FAILED(hr)) {
+            TextureManager::GetInstance()->Log("Warning: failed to write cooked texture: " + cachePath + "\n");
+        }
+    }
+
+    result.elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+/// <summary>
+/// キャッシュファイルのパス
+/// </summary>
+std::string TextureCooker::GetCachePath(const std::string& filePath, const Options& options)
+{
+    // パスの表記ゆれをそろえてからハッシュする
+    std::string key = filePath;
+    std::replace(key.begin(), key.end(), '\\', '/');
+    while (key.rfind("./", 0) == 0) {
+        key.erase(0, 2);
+    }
+
+    uint64_t hash = HashBytes(key.data(), key.size());
+
+    // 元画像が更新されたら別のキャッシュになる (アーカイブ内なら作成時の元ファイルの値なので同じキャッシュを指す)
+    FileSystem::FileStamp stamp;
+    FileSystem::GetInstance()->GetStamp(filePath, stamp);
+    hash = HashBytes(&stamp.size, sizeof(stamp.size), hash);
+    hash = HashBytes(&stamp.writeTime, sizeof(stamp.writeTime), hash);
+
+    const uint32_t flags = kCookVersion << 8 |
+        (options.generateMips ? 1u : 0u) | (options.compress ? 2u : 0u) | (options.normalMap ? 4u : 0u);
+    hash = HashBytes(&flags, sizeof(flags), hash);
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.dds", static_cast<unsigned long long>(hash));
+    return kCacheDirectory + "/" + name;
+}
+
+/// <summary>
+/// WICで読み込んでクックする
+/// </summary>
+void TextureCooker::Cook(const std::string& filePath, const Options& options, DirectX::ScratchImage& outImage)
+{
+    // カラーはsRGB、法線はリニアのまま読む
+    DirectX::ScratchImage image{};
+    FileSystem::FileView file = FileSystem::GetInstance()->Open(filePath);
+    assert(file.IsValid());
+    const DirectX::WIC_FLAGS wicFlags = options.normalMap ? DirectX::WIC_FLAGS_NONE : DirectX::WIC_FLAGS_FORCE_SRGB;
+    HRESULT hr = DirectX::LoadFromWICMemory(file.GetData(), file.GetSize(), wicFlags, nullptr, image);
+    assert(SUCCEEDED(hr));
+
+    // ミップの生成 (1x1 は生成するものがない)
+    const DirectX::TexMetadata& metadata = image.GetMetadata();
+    if (options.generateMips && (metadata.width > 1 || metadata.height > 1)) {
+        DirectX::ScratchImage mipImages{};
+        const DirectX::TEX_FILTER_FLAGS filter = options.normalMap ? DirectX::TEX_FILTER_DEFAULT : DirectX::TEX_FILTER_SRGB;
+        hr = DirectX::GenerateMipMaps(image.GetImages(), image.GetImageCount(), metadata, filter, 0, mipImages);
+        assert(SUCCEEDED(hr));
+        image = std::move(mipImages);
+    }
+
+    // BCはミップ0が4の倍数でないと作れないので、その場合は非圧縮のまま残す
+    const DirectX::TexMetadata& mipMetadata = image.GetMetadata();
+    const bool blockAligned = (mipMetadata.width % 4) == 0 && (mipMetadata.height % 4) == 0;
+    if (!options.compress || !blockAligned) {
+        outImage = std::move(image);
+        return;
+    }
+
+    DXGI_FORMAT format = DXGI_FORMAT_BC7_UNORM_SRGB;
+    DirectX::TEX_COMPRESS_FLAGS compressFlags = DirectX::TEX_COMPRESS_PARALLEL;
+    if (options.normalMap) {
+        // XYだけ持ち、Zはシェーダー側で復元する
+        format = DXGI_FORMAT_BC5_UNORM;
+    } else if (image.IsAlphaAllOpaque()) {
+        // 不透明ならBC1で半分のサイズにする
+        format = DXGI_FORMAT_BC1_UNORM_SRGB;
+    } else {
+        compressFlags |= DirectX::TEX_COMPRESS_BC7_QUICK;
+    }
+
+    DirectX::ScratchImage compressed{};
+    hr = DirectX::Compress(image.GetImages(), image.GetImageCount(), mipMetadata, format,
+        compressFlags, DirectX::TEX_THRESHOLD_DEFAULT, compressed);
+    if (FAILED(hr)) {
+        // 圧縮できなくても描画はできるので非圧縮で続ける
+        TextureManager::GetInstance()->Log("Warning: block compression failed: " + filePath + "\n");
+        outImage = std::move(image);
+        return;
+    }
+    outImage = std::move(compressed);
+}
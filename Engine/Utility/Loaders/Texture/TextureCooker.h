@@ -0,0 +1,61 @@
+#pragma once
+// C++
+#include <string>
+#include <cstdint>
+
+// Engine
+#include "DirectXTex.h"
+
+/// <summary>
+/// テクスチャのクック (ミップ生成・ブロック圧縮済みのDDSをキャッシュする)
+/// 元画像のパス・サイズ・更新日時からハッシュを作り、一致するDDSがあればそれを読むだけで済ませる
+/// </summary>
+class TextureCooker
+{
+public: // 構造体
+
+    // クックの設定
+    struct Options {
+        bool generateMips = true;   // ミップを全段生成する
+        bool compress = true;       // BC圧縮する (カラー: 不透明ならBC1、それ以外はBC7 / 法線: BC5)
+        bool normalMap = false;     // 法線マップとして扱う (リニアで読み、BC5にする)
+    };
+
+    // 読み込み結果
+    struct Result {
+        bool cacheHit = false;      // キャッシュから読んだか
+        float elapsedMs = 0.0f;     // 読み込み (+クック) にかかった時間
+    };
+
+public: // メンバ関数
+
+    /// <summary>
+    /// ファイル名から既定の設定を作る (名前が _normal / _n で終わるものは法線マップ扱い)
+    /// </summary>
+    static Options GetDefaultOptions(const std::string& filePath);
+
+    /// <summary>
+    /// クック済みのDDSを読み込む。無ければWICで読み込んでクックし、キャッシュに書き出す
+    /// </summary>
+    /// <param name="filePath">元画像のパス</param>
+    /// <param name="options">クックの設定</param>
+    /// <param name="outImage">ミップ込みの画像</param>
+    static Result Load(const std::string& filePath, const Options& options, DirectX::ScratchImage& outImage);
+
+    /// <summary>
+    /// キャッシュファイルのパス
+    /// </summary>
+    static std::string GetCachePath(const std::string& filePath, const Options& options);
+
+public: // 定数
+
+    // キャッシュの出力先
+    static inline const std::string kCacheDirectory = "Resources/Cooked/Textures";
+
+private: // 内部処理
+
+    /// <summary>
+    /// WICで読み込んでクックする
+    /// </summary>
+    static void Cook(const std::string& filePath, const Options& options, DirectX::ScratchImage& outImage);
+};
@@ -0,0 +1,8 @@
+#pragma once
+#include "Systems/Handle/GenerationalHandle.h"
+
+/// <summary>
+/// TextureManager に読み込んだテクスチャのハンドル
+/// </summary>
+using TextureHandle = GenerationalHandle;
+namespace TextureHandleUtil = GenerationalHandleUtil;
@@ -43,47 +43,72 @@ void TextureManager::Initialize(DirectXCommon* dxCommon, SrvManager* srvManager)
     // SRVマネージャーの設定
     srvManager_ = srvManager;
 
-    // テクスチャデータのバケット数を予約
-    textureDatas.reserve(SrvManager::kMaxSRVCount_);
+    // テクスチャデータの領域を予約
+    textures_.reserve(SrvManager::kMaxSRVCount_);
+    slots_.Initialize(SrvManager::kMaxSRVCount_);
+    handles_.reserve(SrvManager::kMaxSRVCount_);
+
+    // 無効なハンドルの代わりに使う白テクスチャ (最初に読んで解放しない)
+    slots_.SetFallbackHandle(LoadTexture(kFallbackTexturePath));
+    assert(IsValid(slots_.GetFallbackHandle()));
 }
 
 /// <summary>
 /// テクスチャファイルの読み込み
 /// </summary>
 /// <param name="filePath">読み込むファイルパス</param>
-void TextureManager::LoadTexture(const std::string& filePath)
+/// <returns>テクスチャハンドル</returns>
+TextureHandle TextureManager::LoadTexture(const std::string& filePath)
+{
+    // 既に読み込み済みであれば設定を作る前に返す
+    auto it = handles_.find(filePath);
+    if (it != handles_.end()) {
+        return it->second;
+    }
+    return LoadTexture(filePath, TextureCooker::GetDefaultOptions(filePath));
+}
+
+/// <summary>
+/// テクスチャファイルの読み込み (クックの設定を指定)
+/// </summary>
+/// <param name="filePath">読み込むファイルパス</param>
+/// <param name="options">クックの設定</param>
+/// <returns>テクスチャハンドル</returns>
+TextureHandle TextureManager::LoadTexture(const std::string& filePath, const TextureCooker::Options& options)
 {
 
     if (!srvManager_ || !dxCommon_) {
         Log("Error: srvManager_ or dxCommon_ is null in TextureManager::LoadTexture");
-        return;
+        return TextureHandleUtil::kInvalid;
     }
 
     // 既に読み込み済みであれば早期リターン
-    if (textureDatas.contains(filePath)) {
-        return;
+    auto it = handles_.find(filePath);
+    if (it != handles_.end()) {
+        return it->second;
     }
 
     // テクスチャ上限枚数チェック
     assert(srvManager_->IsAllocation());
 
-    // テクスチャファイルをWICから読み込み
-    DirectX::ScratchImage image{};
-    std::wstring filepathW = ConvertString(filePath);
-    HRESULT hr = DirectX::LoadFromWICFile(filepathW.c_str(), DirectX::WIC_FLAGS_FORCE_SRGB, nullptr, image);
-    assert(SUCCEEDED(hr));
-
-    // ミップマップの生成
+    // クック済みのDDS (ミップ・圧縮済み) を読み込む。無ければここでクックする
     DirectX::ScratchImage mipImages{};
-    hr = DirectX::GenerateMipMaps(image.GetImages(), image.GetImageCount(), image.GetMetadata(), DirectX::TEX_FILTER_SRGB, 0, mipImages);
-    assert(SUCCEEDED(hr));
-
-    // テクスチャデータの追加
-    TextureData& textureData = textureDatas[filePath];
+    TextureCooker::Result result = TextureCooker::Load(filePath, options, mipImages);
+
+    // テクスチャデータの追加 (ミップ込みでアップロードする)
+    // 解放済みの添字があれば再利用する
+    const TextureHandle handle = slots_.Allocate();
+    const uint32_t index = TextureHandleUtil::GetIndex(handle);
+    if (index >= textures_.size()) {
+        textures_.emplace_back();
+    }
+    TextureData& textureData = textures_[index];
+    textureData.filePath = filePath;
+    handles_.emplace(filePath, handle);
     textureData.srvIndex = srvManager_->Allocate();
-    textureData.metadata = image.GetMetadata();
+    textureData.metadata = mipImages.GetMetadata();
     textureData.resource = dxCommon_->CreateTextureResource(textureData.metadata);
-    textureData.intermediateResource = dxCommon_->UploadTextureData(textureData.resource.Get(), image);
+    textureData.intermediateResource = dxCommon_->UploadTextureData(textureData.resource.Get(), mipImages);
 
     // SRVハンドルの設定
     textureData.srvHandleCPU = srvManager_->GetCPUSRVDescriptorHandle(textureData.srvIndex);
@@ -96,6 +121,53 @@ void TextureManager::LoadTexture(const std::string& filePath)
         textureData.metadata.format,
         UINT(textureData.metadata.mipLevels)
     );
+
+    // 計測
+    D3D12_RESOURCE_DESC desc = textureData.resource->GetDesc();
+    D3D12_RESOURCE_ALLOCATION_INFO allocation = dxCommon_->GetDevice()->GetResourceAllocationInfo(0, 1, &desc);
+    loadStats_.gpuBytes += allocation.SizeInBytes;
+    loadStats_.loadMs += result.elapsedMs;
+    if (result.cacheHit) {
+        ++loadStats_.cacheHits;
+    } else {
+        ++loadStats_.cacheMisses;
+    }
+    Log("TextureManager: " + filePath + (result.cacheHit ? " (cooked) " : " (cooked now) ") +
+        std::to_string(result.elapsedMs) + "ms, " + std::to_string(allocation.SizeInBytes / 1024) + "KB\n");
+
+    return handle;
+}
+
+/// <summary>
+/// テクスチャの解放
+/// </summary>
+/// <param name="handle">テクスチャハンドル</param>
+void TextureManager::UnloadTexture(TextureHandle handle)
+{
+    // 代わりの白テクスチャは最後まで残す (世代を進めて古いハンドルを使えなくする)
+    if (!slots_.Free(handle)) {
+        return;
+    }
+    TextureData& textureData = textures_[TextureHandleUtil::GetIndex(handle)];
+
+    // SRVを返す
+    srvManager_->Free(textureData.srvIndex);
+    handles_.erase(textureData.filePath);
+    textureData = TextureData{};
+}
+
+/// <summary>
+/// ファイルパスからハンドルを取得
+/// </summary>
+/// <param name="filePath">テクスチャファイルのパス</param>
+/// <returns>テクスチャハンドル (読み込まれていなければ無効値)</returns>
+TextureHandle TextureManager::GetHandle(const std::string& filePath) const
+{
+    auto it = handles_.find(filePath);
+    if (it == handles_.end()) {
+        return TextureHandleUtil::kInvalid;
+    }
+    return it->second;
 }
 
 /// <summary>
@@ -105,9 +177,9 @@ void TextureManager::LoadTexture(const std::string& filePath)
 /// <returns>SRVインデックス</returns>
 uint32_t TextureManager::GetTextureIndexByFilePath(const std::string& filePath)
 {
-    auto it = textureDatas.find(filePath);
-    if (it != textureDatas.end()) {
-        return it->second.srvIndex;
+    auto it = handles_.find(filePath);
+    if (it != handles_.end()) {
+        return GetSrvIndex(it->second);
     }
     Log("Error: Texture not found for filePath: " + filePath);
     assert(0);
@@ -121,12 +193,12 @@ uint32_t TextureManager::GetTextureIndexByFilePath(const std::string& filePath)
 /// <returns>GPUハンドル</returns>
 D3D12_GPU_DESCRIPTOR_HANDLE TextureManager::GetsrvHandleGPU(const std::string& filePath)
 {
-    auto it = textureDatas.find(filePath);
-    if (it == textureDatas.end()) {
+    auto it = handles_.find(filePath);
+    if (it == handles_.end()) {
         Log("Error: Texture not found for filePath: " + filePath);
         throw std::runtime_error("Texture not found for filePath: " + filePath);
     }
-    return it->second.srvHandleGPU;
+    return GetSrvHandleGPU(it->second);
 }
 
 std::wstring TextureManager::ConvertString(const std::string& str) {
@@ -160,10 +232,10 @@ void TextureManager::Log(const std::string& message) {
 /// <returns>メタデータ</returns>
 const DirectX::TexMetadata& TextureManager::GetMetaData(const std::string& filePath)
 {
-    auto it = textureDatas.find(filePath);
-    if (it == textureDatas.end()) {
+    auto it = handles_.find(filePath);
+    if (it == handles_.end()) {
         Log("Error: Texture not found for filePath: " + filePath);
         throw std::runtime_error("Texture not found for filePath: " + filePath);
     }
-    return it->second.metadata;
+    return GetMetaData(it->second);
 }
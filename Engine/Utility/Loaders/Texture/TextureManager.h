@@ -5,12 +5,16 @@
 #include <vector>
 #include <unordered_map>
 #include <mutex>
+#include <cassert>
 #include <d3d12.h>
 
 // Engine
 #include "DX./DirectXCommon.h"
 #include "DirectXTex.h"
 #include "SrvManager./SrvManager.h"
+#include "TextureCooker.h"
+#include "TextureHandle.h"
+#include "TextureSlotTable.h"
 
 
 // テクスチャマネージャー
@@ -25,6 +29,17 @@ private:
         uint32_t srvIndex;
         D3D12_CPU_DESCRIPTOR_HANDLE srvHandleCPU;
         D3D12_GPU_DESCRIPTOR_HANDLE srvHandleGPU;
+        std::string filePath;
+    };
+
+public: // 構造体
+
+    // 読み込みの計測結果
+    struct LoadStats {
+        uint32_t cacheHits = 0;     // クック済みDDSから読めた枚数
+        uint32_t cacheMisses = 0;   // WICから読んでクックした枚数
+        float loadMs = 0.0f;        // 読み込みの合計時間
+        uint64_t gpuBytes = 0;      // テクスチャが確保したVRAMの合計
     };
 
 public: // メンバ関数
@@ -50,9 +65,52 @@ public: // メンバ関数
     void Initialize(DirectXCommon* dxCommon, SrvManager* srvManager);
 
     /// <summary>
-    /// テクスチャファイルの読み込み
+    /// テクスチャファイルの読み込み (読み込み済みなら同じハンドルを返す)
+    /// </summary>
+    TextureHandle LoadTexture(const std::string& filePath);
+
+    /// <summary>
+    /// テクスチャファイルの読み込み (クックの設定を指定)
+    /// </summary>
+    TextureHandle LoadTexture(const std::string& filePath, const TextureCooker::Options& options);
+
+    /// <summary>
+    /// テクスチャの解放 (SRVも返す。ハンドルは無効になる)
+    /// 描画コマンドを積んだ後のフレーム中には呼ばないこと
+    /// </summary>
+    void UnloadTexture(TextureHandle handle);
+
+    /// <summary>
+    /// ファイルパスを指定してテクスチャを解放 (読み込んでいない・アトラスに入っている画像なら何もしない)
+    /// </summary>
+    void UnloadTexture(const std::string& filePath) { UnloadTexture(GetHandle(filePath)); }
+
+    /// <summary>
+    /// ファイルパスからハンドルを取得 (読み込み時用。毎フレームはハンドルを保持して使う)
+    /// </summary>
+    TextureHandle GetHandle(const std::string& filePath) const;
+
+    /// <summary>
+    /// ハンドルが有効か
+    /// </summary>
+    bool IsValid(TextureHandle handle) const { return slots_.IsValid(handle); }
+
+    /// <summary>
+    /// 無効なハンドルの代わりに使う白テクスチャ
     /// </summary>
-    void LoadTexture(const std::string& filePath);
+    TextureHandle GetFallbackHandle() const { return slots_.GetFallbackHandle(); }
+
+    /*===============================================//
+                ハンドルからの取得 (描画時用)
+    //===============================================*/
+
+    uint32_t GetSrvIndex(TextureHandle handle) const { return textures_[ToIndex(handle)].srvIndex; }
+    D3D12_GPU_DESCRIPTOR_HANDLE GetSrvHandleGPU(TextureHandle handle) const { return textures_[ToIndex(handle)].srvHandleGPU; }
+    const DirectX::TexMetadata& GetMetaData(TextureHandle handle) const { return textures_[ToIndex(handle)].metadata; }
+
+    /*===============================================//
+                ファイルパスからの取得 (互換用)
+    //===============================================*/
 
     /// <summary>
     /// SRVインデックスの取得
@@ -75,6 +133,22 @@ public: // メンバ関数
     /// </summary>
     const DirectX::TexMetadata& GetMetaData(const std::string& filePath);
 
+    /// <summary>
+    /// 読み込みの計測結果の取得
+    /// </summary>
+    const LoadStats& GetLoadStats() const { return loadStats_; }
+
+private: // 内部処理
+
+    /// <summary>
+    /// ハンドルを配列の添字にする (範囲と世代を確認する)
+    /// 解放済み・壊れたハンドルはリリースでも配列の外や使い回された枠を読まないよう、白テクスチャに差し替える
+    /// </summary>
+    uint32_t ToIndex(TextureHandle handle) const {
+        assert(slots_.IsValid(handle) && "TextureManager : invalid or stale texture handle");
+        return slots_.ToIndex(handle);
+    }
+
 private: // メンバ変数
 
     // シングルトンインスタンス
@@ -85,8 +159,12 @@ private: // メンバ変数
     TextureManager(TextureManager&) = delete;
     TextureManager& operator=(TextureManager&) = delete;
 
-    // テクスチャデータ
-    std::unordered_map<std::string, TextureData> textureDatas;
+    // テクスチャデータ (ハンドルの添字で引く)
+    std::vector<TextureData> textures_;
+    // ハンドルの払い出しと引き当て (白テクスチャを代わりに持つ)
+    TextureSlotTable slots_;
+    // ファイルパス → ハンドル (読み込み時だけ使う)
+    std::unordered_map<std::string, TextureHandle> handles_;
 
     // DirectX共通オブジェクト
     DirectXCommon* dxCommon_ = nullptr;
@@ -94,6 +172,11 @@ private: // メンバ変数
     // SRVマネージャー
     SrvManager* srvManager_ = nullptr;
 
+    // 読み込みの計測結果
+    LoadStats loadStats_;
+
     // SRVインデックスの開始番号
     static uint32_t kSRVIndexTop;
+    // 無効なハンドルの代わりに使うテクスチャ
+    static inline const std::string kFallbackTexturePath = "Resources/images/white.png";
 };
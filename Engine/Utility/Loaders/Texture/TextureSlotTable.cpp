@@ -0,0 +1,65 @@
+#include "TextureSlotTable.h"
+// C++
+#include <cassert>
+#include <string>
+
+// Engine
+#include "DX./DirectXCommon.h"
+
+/// <summary>
+/// 枠をすべて破棄
+/// </summary>
+void TextureSlotTable::Initialize(uint32_t capacity)
+{
+    generations_.clear();
+    freeSlots_.clear();
+    generations_.reserve(capacity);
+    fallbackHandle_ = TextureHandleUtil::kInvalid;
+    invalidHandleCount_ = 0;
+}
+
+/// <summary>
+/// 枠を1つ払い出す
+/// </summary>
+TextureHandle TextureSlotTable::Allocate()
+{
+    uint32_t index = 0;
+    if (!freeSlots_.empty()) {
+        index = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(generations_.size());
+        assert(index <= TextureHandleUtil::kMaxIndex && "TextureSlotTable : too many textures");
+        generations_.push_back(0);
+    }
+    return TextureHandleUtil::Make(index, generations_[index]);
+}
+
+/// <summary>
+/// 枠を返す
+/// </summary>
+bool TextureSlotTable::Free(TextureHandle handle)
+{
+    // 代わりのハンドルは最後まで残す
+    if (!IsValid(handle) || handle == fallbackHandle_) {
+        return false;
+    }
+    // 古いハンドルが使えないよう世代を進める
+    uint32_t index = TextureHandleUtil::GetIndex(handle);
+    generations_[index] = TextureHandleUtil::NextGeneration(generations_[index]);
+    freeSlots_.push_back(index);
+    return true;
+}
+
+/// <summary>
+/// 無効なハンドルの代わりの添字
+/// </summary>
+uint32_t TextureSlotTable::ResolveInvalidHandle(TextureHandle handle) const
+{
+    if (invalidHandleCount_++ == 0) {
+        DirectXCommon::Log("TextureManager: invalid or stale texture handle " + std::to_string(handle) +
+            ", drawing the fallback texture instead\n");
+    }
+    // 代わりのハンドルは Initialize 直後に設定し、解放しないので常に有効
+    return TextureHandleUtil::GetIndex(fallbackHandle_);
+}
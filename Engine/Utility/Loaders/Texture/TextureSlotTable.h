@@ -0,0 +1,84 @@
+#pragma once
+// C++
+#include <cstdint>
+#include <vector>
+
+// Engine
+#include "TextureHandle.h"
+
+/// <summary>
+/// テクスチャハンドルの払い出しと引き当て (添字・世代・解放済みの枠)
+/// GPUリソースは持たないので、TextureManager 無しで確かめられる
+/// </summary>
+class TextureSlotTable
+{
+public: // メンバ関数
+
+    /// <summary>
+    /// 枠をすべて破棄 (古いハンドルは世代ごと忘れる)
+    /// </summary>
+    /// <param name="capacity">予約しておく枠の数</param>
+    void Initialize(uint32_t capacity);
+
+    /// <summary>
+    /// 枠を1つ払い出す (解放済みの枠があれば使い回す)
+    /// </summary>
+    TextureHandle Allocate();
+
+    /// <summary>
+    /// 枠を返す。以後、そのハンドルは無効になる
+    /// </summary>
+    /// <returns>無効なハンドル・代わりのハンドルなら false</returns>
+    bool Free(TextureHandle handle);
+
+    /// <summary>
+    /// ハンドルが有効か
+    /// </summary>
+    bool IsValid(TextureHandle handle) const {
+        uint32_t index = TextureHandleUtil::GetIndex(handle);
+        return handle != TextureHandleUtil::kInvalid && index < generations_.size() &&
+            generations_[index] == TextureHandleUtil::GetGeneration(handle);
+    }
+
+    /// <summary>
+    /// ハンドルを配列の添字にする
+    /// 解放済み・壊れたハンドルは配列の外や使い回された枠を読まないよう、代わりのハンドルの添字にする
+    /// </summary>
+    uint32_t ToIndex(TextureHandle handle) const {
+        if (IsValid(handle)) {
+            return TextureHandleUtil::GetIndex(handle);
+        }
+        return ResolveInvalidHandle(handle);
+    }
+
+public: // アクセッサ
+
+    /// <summary>
+    /// 無効なハンドルの代わり (解放できない)
+    /// </summary>
+    void SetFallbackHandle(TextureHandle handle) { fallbackHandle_ = handle; }
+    TextureHandle GetFallbackHandle() const { return fallbackHandle_; }
+
+    // 使ったことのある枠の数 (データ側の配列の大きさ)
+    uint32_t GetSlotCount() const { return static_cast<uint32_t>(generations_.size()); }
+    // 無効なハンドルで引かれた回数
+    uint32_t GetInvalidHandleCount() const { return invalidHandleCount_; }
+
+private: // 内部処理
+
+    /// <summary>
+    /// 無効なハンドルをログに出し (初回だけ)、代わりのハンドルの添字を返す
+    /// </summary>
+    uint32_t ResolveInvalidHandle(TextureHandle handle) const;
+
+private: // メンバ変数
+
+    // 添字ごとの世代
+    std::vector<uint32_t> generations_;
+    // 解放済みの添字
+    std::vector<uint32_t> freeSlots_;
+    // 無効なハンドルの代わり
+    TextureHandle fallbackHandle_ = TextureHandleUtil::kInvalid;
+    // 無効なハンドルで引かれた回数 (ログは初回だけ)
+    mutable uint32_t invalidHandleCount_ = 0;
+};
@@ -6,10 +6,34 @@
 #include <mfidl.h>
 #include <mfreadwrite.h>
 #include <mferror.h>
+#include <shlwapi.h>
 #include <cassert>
+#include <filesystem>
 
+// Engine
+#include "DX./DirectXCommon.h"
+#include "Loaders/Archive/FileSystem.h"
+#include "MediaFoundationDecoder.h"
+#include "WaveDecoder.h"
+#include "WaveParser.h"
+#include "XAudio2StreamOutput.h"
 
 
+
+namespace {
+    // FileSystem に渡すためにUTF-8へ
+    std::string ToUtf8(const wchar_t* str)
+    {
+        const int length = WideCharToMultiByte(CP_UTF8, 0, str, -1, nullptr, 0, nullptr, nullptr);
+        if (length <= 1) {
+            return {};
+        }
+        std::string result(static_cast<size_t>(length - 1), '\0');
+        WideCharToMultiByte(CP_UTF8, 0, str, -1, result.data(), length, nullptr, nullptr);
+        return result;
+    }
+}
+
 // シングルトンの初期化
 Audio* Audio::instance = nullptr;
 
@@ -43,7 +67,7 @@ Audio::~Audio()
     FinalizeAudio();
 }
 
-void Audio::Initialize()
+void Audio::Initialize(Mixing mixing)
 {
     // COM の初期化
     HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
@@ -64,10 +88,46 @@ void Audio::Initialize()
     // マスターボイスの作成
     hr_ = xAudio2_->CreateMasteringVoice(&masterVoice_);
     assert(SUCCEEDED(hr_) && "Failed to create mastering voice");
+
+    // ボイスの再生先
+    if (mixing == Mixing::kSoftware) {
+        // エンジンで混ぜた結果をストリーミング用のボイス1つで鳴らす
+        auto mixer = std::make_unique<AudioMixer>();
+        mixer_ = mixer.get();
+        AudioStream::Settings settings;
+        settings.bufferCount = kMixerBufferCount;
+        settings.bufferMilliseconds = kMixerBufferMilliseconds;
+        mixerStream_ = std::make_unique<AudioStream>();
+        bool opened = mixerStream_->Open(mixer_->CreateSource(), std::make_unique<XAudio2StreamOutput>(xAudio2_), settings);
+        assert(opened && "Failed to open mixer stream");
+        (void)opened;
+        mixerStream_->Play();
+        voiceBackend_ = std::move(mixer);
+    } else {
+        voiceBackend_ = std::make_unique<XAudio2Backend>(xAudio2_);
+    }
+
+    // ソースボイスのプール (効果音が重なっても作り続けないように種類ごとに上限を設ける)
+    voicePool_.Initialize(voiceBackend_.get(), kMaxVoices);
+    voicePool_.SetCategoryLimit(kCategorySE, 32);
+    voicePool_.SetCategoryLimit(kCategoryUI, 8);
+    voicePool_.SetCategoryLimit(kCategoryVoice, 4);
+    voicePool_.SetCategoryLimit(kCategoryBGM, 2);
+}
+
+void Audio::Update()
+{
+    voicePool_.Update();
 }
 
 void Audio::FinalizeAudio()
 {
+    // ソースボイスはマスターボイスより先に破棄する (ミキサーは読み口を持つストリームを先に止める)
+    voicePool_.Finalize();
+    mixerStream_.reset();
+    voiceBackend_.reset();
+    mixer_ = nullptr;
+
     // マスターボイスの破棄
     if (masterVoice_) {
         masterVoice_->DestroyVoice();
@@ -94,8 +154,25 @@ void Audio::FinalizeAudio()
 Audio::SoundData Audio::LoadAudio(const wchar_t* filename)
 {
     SoundData soundData = {};
+
+    // FileSystem から読み、メモリ上のストリームとして Media Foundation に渡す
+    FileSystem::FileView file = FileSystem::GetInstance()->Open(ToUtf8(filename));
+    assert(file.IsValid() && "Failed to open audio file");
+    IStream* pStream = SHCreateMemStream(file.GetData(), static_cast<UINT>(file.GetSize()));
+    assert(pStream && "Failed to create memory stream");
+    IMFByteStream* pByteStream = nullptr;
+    HRESULT hr = MFCreateMFByteStreamOnStream(pStream, &pByteStream);
+    assert(SUCCEEDED(hr) && "Failed to create byte stream");
+
+    // 形式の判定に拡張子を使えるように元のファイル名を付けておく
+    IMFAttributes* pStreamAttributes = nullptr;
+    if (SUCCEEDED(pByteStream->QueryInterface(IID_PPV_ARGS(&pStreamAttributes)))) {
+        pStreamAttributes->SetString(MF_BYTESTREAM_ORIGIN_NAME, filename);
+        pStreamAttributes->Release();
+    }
+
     IMFSourceReader* pReader = nullptr;
-    HRESULT hr = MFCreateSourceReaderFromURL(filename, nullptr, &pReader);
+    hr = MFCreateSourceReaderFromByteStream(pByteStream, nullptr, &pReader);
     assert(SUCCEEDED(hr) && "Failed to create source reader");
 
     // PCM フォーマットを設定
@@ -175,12 +252,15 @@ Audio::SoundData Audio::LoadAudio(const wchar_t* filename)
     }
 
     pReader->Release();
+    pByteStream->Release();
+    pStream->Release();
 
     // バッファのサイズとデータを SoundData に設定
     if (!bufferData.empty()) {
         soundData.bufferSize = static_cast<DWORD>(bufferData.size());
-        soundData.pBuffer = new BYTE[soundData.bufferSize];
-        memcpy(soundData.pBuffer, bufferData.data(), soundData.bufferSize);
+        BYTE* pBuffer = new BYTE[soundData.bufferSize];
+        memcpy(pBuffer, bufferData.data(), soundData.bufferSize);
+        soundData.pBuffer = pBuffer;
     }
 
     return soundData;
@@ -189,7 +269,14 @@ Audio::SoundData Audio::LoadAudio(const wchar_t* filename)
 
 void Audio::SoundUnload(SoundData* soundData)
 {
-    if (soundData->pBuffer) {
+    // まだこの波形を鳴らしているボイスがあれば、読み終える前にメモリが消えるので先に止める
+    voicePool_.StopBuffer(soundData->pBuffer, soundData->bufferSize);
+
+    if (soundData->file.IsValid()) {
+        // LoadWave の波形はファイルのマップを指しているだけなので、マップを手放す
+        soundData->file = {};
+        soundData->pBuffer = nullptr;
+    } else if (soundData->pBuffer) {
         delete[] soundData->pBuffer;
         soundData->pBuffer = nullptr;
     }
@@ -197,142 +284,118 @@ void Audio::SoundUnload(SoundData* soundData)
     ZeroMemory(&soundData->wfex, sizeof(WAVEFORMATEX));
 }
 
-IXAudio2SourceVoice* Audio::SoundPlayAudio(const SoundData& soundData)
+VoicePool::Handle Audio::SoundPlayAudio(const SoundData& soundData, const VoicePool::PlayParams& params)
 {
-    HRESULT hr;
-
-    // SourceVoice の作成
-    IXAudio2SourceVoice* pSourceVoice = nullptr;
-    hr = xAudio2_->CreateSourceVoice(&pSourceVoice, &soundData.wfex);
-    assert(SUCCEEDED(hr) && "Failed to create source voice");
-
-    // XAUDIO2_BUFFER の設定
-    XAUDIO2_BUFFER buf = {};
-    buf.pAudioData = soundData.pBuffer;
-    buf.AudioBytes = soundData.bufferSize;
-    buf.Flags = XAUDIO2_END_OF_STREAM;
-
-    // バッファの送信
-    hr = pSourceVoice->SubmitSourceBuffer(&buf);
-    assert(SUCCEEDED(hr) && "Failed to submit source buffer");
-
-    // 再生開始
-    hr = pSourceVoice->Start();
-    assert(SUCCEEDED(hr) && "Failed to start source voice");
-
-    return pSourceVoice;
+    // デコード済みのPCMなのでWAVと同じ
+    return SoundPlayWave(soundData, params);
 }
 
-IXAudio2SourceVoice* Audio::SoundPlayWave(const SoundData& soundData)
+VoicePool::Handle Audio::SoundPlayWave(const SoundData& soundData, const VoicePool::PlayParams& params)
 {
-    HRESULT hr;
-
-    // SourceVoice の作成
-    IXAudio2SourceVoice* pSourceVoice = nullptr;
-    hr = xAudio2_->CreateSourceVoice(&pSourceVoice, &soundData.wfex);
-    assert(SUCCEEDED(hr) && "Failed to create source voice");
-
-    // XAUDIO2_BUFFER の設定
-    XAUDIO2_BUFFER buf = {};
-    buf.pAudioData = soundData.pBuffer;
-    buf.AudioBytes = soundData.bufferSize;
-    buf.Flags = XAUDIO2_END_OF_STREAM;
-
-    // バッファの送信
-    hr = pSourceVoice->SubmitSourceBuffer(&buf);
-    assert(SUCCEEDED(hr) && "Failed to submit source buffer");
-
-    // 再生開始
-    hr = pSourceVoice->Start();
-    assert(SUCCEEDED(hr) && "Failed to start source voice");
+    // 同じ形式の空いているソースボイスを使い回す
+    AudioFormat format;
+    format.formatTag = soundData.wfex.wFormatTag;
+    format.channels = soundData.wfex.nChannels;
+    format.sampleRate = soundData.wfex.nSamplesPerSec;
+    format.bitsPerSample = soundData.wfex.wBitsPerSample;
+    format.blockAlign = soundData.wfex.nBlockAlign;
+    return voicePool_.Play(format, soundData.pBuffer, soundData.bufferSize, params);
+}
 
-    return pSourceVoice;
+void Audio::SoundStop(VoicePool::Handle handle)
+{
+    voicePool_.Stop(handle);
 }
-void Audio::SetVolume(IXAudio2SourceVoice* pSourceVoice, float volume)
+
+void Audio::SetVolume(VoicePool::Handle handle, float volume)
 {
-    // 0.0f ～ 1.0f の範囲で音量を設定
-    HRESULT hr = pSourceVoice->SetVolume(volume);
-    assert(SUCCEEDED(hr) && "Failed to set volume");
+    // 0.0f ～ 1.0f の範囲で音量を設定 (再生し終えたハンドルなら何もしない)
+    voicePool_.SetVolume(handle, volume);
 }
 
-Audio::SoundData Audio::LoadWave(const char* filename)
+bool Audio::IsPlaying(VoicePool::Handle handle) const
 {
-    // ファイル入力ストリームのインスタンス
-    std::ifstream file;
-    // .wavファイルをバイナリモードで開く
-    file.open(filename, std::ios_base::binary);
-    // ファイルオープン失敗を検出
-    assert(file.is_open());
+    return voicePool_.IsPlaying(handle);
+}
 
+void Audio::SetCategoryLimit(Category category, uint32_t maxConcurrent)
+{
+    voicePool_.SetCategoryLimit(category, maxConcurrent);
+}
 
-    // RIFFヘッダーの読み込み
-    RiffHeader riff;
-    file.read((char*)&riff, sizeof(riff));
-    // ファイルがRIFFかチェック
-    if (strncmp(riff.chunk.id, "RIFF", 4) != 0) {
-        assert(0);
+void Audio::SetPan(VoicePool::Handle handle, float pan)
+{
+    if (mixer_) {
+        mixer_->SetPan(voicePool_.GetVoiceId(handle), pan);
     }
-    // タイプがWAVEかチェック
-    if (strncmp(riff.type, "WAVE", 4) != 0) {
-        assert(0);
+}
+
+void Audio::SetPitch(VoicePool::Handle handle, float pitch)
+{
+    if (mixer_) {
+        mixer_->SetPitch(voicePool_.GetVoiceId(handle), pitch);
     }
+}
 
-    // チャンクのループを開始
-    ChunkHeader chunkHeader;
-    FormatChunk format = {};
-
-    while (file.read((char*)&chunkHeader, sizeof(chunkHeader))) {
-        // チャンクIDが "fmt " かを確認
-        if (strncmp(chunkHeader.id, "fmt ", 4) == 0) {
-            // Formatチャンクのサイズを確認し、データを読み込む
-            assert(chunkHeader.size <= sizeof(format.fmt));
-            format.chunk = chunkHeader; // チャンクヘッダーをコピー
-            file.read((char*)&format.fmt, chunkHeader.size); // fmtのデータを読み込み
-            break;
+std::unique_ptr<AudioStream> Audio::OpenStream(const std::string& filePath)
+{
+    // 拡張子でデコーダを選ぶ
+    std::unique_ptr<IAudioDecoder> decoder;
+    const std::string extension = std::filesystem::path(filePath).extension().string();
+    if (_stricmp(extension.c_str(), ".wav") == 0) {
+        auto waveDecoder = std::make_unique<WaveDecoder>();
+        if (waveDecoder->Open(filePath)) {
+            decoder = std::move(waveDecoder);
         }
-        else {
-            // 次のチャンクに移動
-            file.seekg(chunkHeader.size, std::ios_base::cur);
+    } else {
+        auto mediaDecoder = std::make_unique<MediaFoundationDecoder>();
+        if (mediaDecoder->Open(filePath)) {
+            decoder = std::move(mediaDecoder);
         }
     }
-
-    // "fmt "チャンクが見つからなかった場合のエラー処理
-    if (strncmp(format.chunk.id, "fmt ", 4) != 0) {
-        //std::cerr << "Error: 'fmt ' chunk not found!" << std::endl;
-        assert(0);
+    assert(decoder && "Failed to open audio stream");
+    if (!decoder) {
+        return nullptr;
     }
 
+    auto stream = std::make_unique<AudioStream>();
+    if (!stream->Open(std::move(decoder), std::make_unique<XAudio2StreamOutput>(xAudio2_))) {
+        assert(false && "Failed to create stream voice");
+        return nullptr;
+    }
+    return stream;
+}
 
+Audio::SoundData Audio::LoadWave(const char* filename)
+{
+    SoundData soundData = {};
 
-    // Dataチャンクの読み込み
-    ChunkHeader data;
-    file.read((char*)&data, sizeof(data));
-    // JUNKチャンクを検出した場合
-    if (strncmp(data.id, "JUNK", 4) == 0) {
-        // 読み取り位置をJUNKチャンクの終わりまで進める
-        file.seekg(data.size, std::ios_base::cur);
-        // 再読み込み
-        file.read((char*)&data, sizeof(data));
-    }
+    // FileSystem から.wavファイルをマップして開く (アーカイブ内ならアーカイブのマップをそのまま使う)
+    soundData.file = FileSystem::GetInstance()->Open(filename);
+    // ファイルオープン失敗を検出
+    assert(soundData.file.IsValid());
 
-    if (strncmp(data.id, "data", 4) != 0) {
+    // チャンクを走査して fmt と data を探す
+    WaveParser::WaveView wave;
+    const WaveParser::Error error = WaveParser::Parse(soundData.file.GetData(), soundData.file.GetSize(), wave);
+    if (error != WaveParser::Error::kNone) {
+        DirectXCommon::Log(std::string("LoadWave: ") + filename + ": " + WaveParser::ToString(error) + "\n");
         assert(0);
+        soundData.file = {};
+        return soundData;
     }
 
-    // Dataチャンクのデータ部（波形データの読み込み）
-    char* pBuffer = new char[data.size];
-    file.read(pBuffer, data.size);
-
-    // Waveファイルを閉じる
-    file.close();
-
-
-    // returnする為のデータ
-    SoundData soundData = {};
-
-    soundData.wfex = format.fmt;
-    soundData.pBuffer = reinterpret_cast<BYTE*>(pBuffer);
-    soundData.bufferSize = data.size;
+    soundData.wfex.wFormatTag = wave.format.formatTag;
+    soundData.wfex.nChannels = wave.format.channels;
+    soundData.wfex.nSamplesPerSec = wave.format.sampleRate;
+    soundData.wfex.nAvgBytesPerSec = wave.format.GetBytesPerSecond();
+    soundData.wfex.nBlockAlign = wave.format.blockAlign;
+    soundData.wfex.wBitsPerSample = wave.format.bitsPerSample;
+    soundData.wfex.cbSize = 0;
+
+    // 波形はコピーせず data チャンクを直接指す
+    soundData.pBuffer = wave.data;
+    soundData.bufferSize = wave.size;
 
     return soundData;
 }
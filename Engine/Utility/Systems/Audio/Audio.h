@@ -8,59 +8,97 @@
 #include <mfreadwrite.h>
 #include <mferror.h>
 #include <cassert>
+#include <memory>
+#include <string>
+
+// Engine
+#include "VoicePool.h"
+#include "XAudio2Backend.h"
+#include "AudioStream.h"
+#include "AudioMixer.h"
+#include "Loaders/Archive/FileSystem.h"
 
 #pragma comment(lib, "mfplat.lib")
 #pragma comment(lib, "mfreadwrite.lib")
 #pragma comment(lib, "mfuuid.lib")
 #pragma comment(lib,"xaudio2.lib")
+#pragma comment(lib,"shlwapi.lib")
 class Audio {
 public:
 	// シングルトンの取得と破棄
 	static Audio* GetInstance();
 	static void Finalize();
 
+	// 音を混ぜる場所
+	enum class Mixing {
+		kXAudio2,		// XAudio2 のソースボイスで混ぜる (既定)
+		kSoftware,		// エンジンの AudioMixer で混ぜ、ストリーミング用のボイス1つで鳴らす (パンとピッチが使える)
+	};
+
 	// 初期化と終了処理
-	void Initialize();
+	void Initialize(Mixing mixing = Mixing::kXAudio2);
 	void FinalizeAudio();
 
-	struct ChunkHeader
-	{
-		char id[4];		 // チャンク毎のID
-		int32_t size;	 // チャンクサイズ
-	};
-	// RIFFヘッダチャンク
-	struct RiffHeader
-	{
-		ChunkHeader chunk;		// "RIFF"
-		char type[4];			// "WAVE"
-	};
-	// FMTチャンク
-	struct FormatChunk
-	{
-		ChunkHeader chunk;		// "fmt"
-		WAVEFORMATEX fmt;			// 波形フォーマット
+	// 再生し終えたボイスをプールへ戻す (毎フレーム呼ぶ)
+	void Update();
+
+	// 音の種類 (種類ごとに同時再生数の上限がある)
+	enum Category : uint32_t {
+		kCategorySE,		// 効果音
+		kCategoryUI,		// UIの操作音
+		kCategoryVoice,		// ボイス
+		kCategoryBGM,		// BGM
+
+		kCategoryCount,
 	};
+	// 全カテゴリ合計のボイス数の上限
+	static constexpr uint32_t kMaxVoices = 64;
+	// ソフトウェアミキサーの出力を先読みする量 (バッファ数 × 長さ、短いほど遅れが少ない)
+	static constexpr uint32_t kMixerBufferCount = 3;
+	static constexpr uint32_t kMixerBufferMilliseconds = 10;
+
 	// 音声データ
 	struct SoundData
 	{
 		// 波形フォーマット
 		WAVEFORMATEX wfex;
-		// バッファの先頭アドレス
-		BYTE* pBuffer;
+		// バッファの先頭アドレス (LoadWave ならファイルのマップの中を直接指す)
+		const BYTE* pBuffer;
 		// バッファサイズ
 		unsigned int bufferSize;
+		// LoadWave で開いたファイル (アーカイブ内ならアーカイブのマップ)。SoundUnload まで波形を保つ
+		FileSystem::FileView file;
 	};
 
-
+	// .wav 用 (ファイルをマップしてチャンクを走査し、波形はコピーせずにマップを指す)
 	SoundData LoadWave(const char* filename);
 	SoundData LoadAudio(const wchar_t* filename); // .mp3, .mp4 用
 	void SoundUnload(SoundData* soundData);
 
-	IXAudio2SourceVoice* SoundPlayWave(const SoundData& soundData);
-	IXAudio2SourceVoice* SoundPlayAudio(const SoundData& soundData); // .mp3, .mp4 用
+	// 再生 (ボイスはプールから借り、再生し終えたら Update で戻る。鳴らせなければ VoicePool::kInvalidHandle)
+	VoicePool::Handle SoundPlayWave(const SoundData& soundData, const VoicePool::PlayParams& params = {});
+	VoicePool::Handle SoundPlayAudio(const SoundData& soundData, const VoicePool::PlayParams& params = {}); // .mp3, .mp4 用
 
+	// 停止
+	void SoundStop(VoicePool::Handle handle);
 	// 音量設定
-	void SetVolume(IXAudio2SourceVoice* pSourceVoice, float volume);
+	void SetVolume(VoicePool::Handle handle, float volume);
+	// 再生中か
+	bool IsPlaying(VoicePool::Handle handle) const;
+	// カテゴリの同時再生数の上限 (0は上限なし)
+	void SetCategoryLimit(Category category, uint32_t maxConcurrent);
+	// パン (-1.0f ～ 1.0f) とピッチ (再生速度の倍率)。Mixing::kSoftware の時だけ効く
+	void SetPan(VoicePool::Handle handle, float pan);
+	void SetPitch(VoicePool::Handle handle, float pitch);
+
+	// ストリーミング再生用に開く (BGMなど長い音用。全体をデコードせず、鳴らしながら少しずつデコードする)
+	// .wav はそのまま、それ以外 (.mp3, .mp4) は Media Foundation でデコードする。ボイスプールとは別にボイスを持つ
+	std::unique_ptr<AudioStream> OpenStream(const std::string& filePath);
+
+	const VoicePool& GetVoicePool() const { return voicePool_; }
+	// ソフトウェアミキサー (Mixing::kXAudio2 なら nullptr)
+	AudioMixer* GetMixer() const { return mixer_; }
+	const AudioStream* GetMixerStream() const { return mixerStream_.get(); }
 
 private:
 	// シングルトンパターン
@@ -75,4 +113,12 @@ private:
 
 	// Media Foundation 関連
 	bool mediaFoundationInitialized_;
+
+	// ソースボイスのプール
+	std::unique_ptr<IAudioBackend> voiceBackend_;
+	VoicePool voicePool_;
+
+	// ソフトウェアミキサー (voiceBackend_ の中身) と、それを鳴らすストリーム
+	AudioMixer* mixer_ = nullptr;
+	std::unique_ptr<AudioStream> mixerStream_;
 };
@@ -0,0 +1,79 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 波形の形式 (ボイスプールはこれが同じボイスだけを使い回す)
+/// </summary>
+struct AudioFormat {
+	uint16_t formatTag = 1;		// 1: PCM、3: IEEE float (WAVEFORMATEX と同じ値)
+	uint16_t channels = 0;
+	uint32_t sampleRate = 0;
+	uint16_t bitsPerSample = 0;
+	uint16_t blockAlign = 0;	// 1サンプル (全チャンネル分) のバイト数
+
+	bool operator==(const AudioFormat&) const = default;
+
+	/// <summary>
+	/// プールのキー
+	/// </summary>
+	uint64_t GetKey() const
+	{
+		return uint64_t(formatTag) << 48 | uint64_t(channels) << 40 | uint64_t(bitsPerSample) << 32 | sampleRate;
+	}
+
+	uint32_t GetBytesPerSecond() const { return sampleRate * blockAlign; }
+};
+
+/// <summary>
+/// ボイスの再生先 (XAudio2 と、テストやサーバー用の何も鳴らさない実装がある)
+/// ボイスプールはこれだけを通して再生するので、再生先が無い環境でもプールの動きを確かめられる
+/// </summary>
+class IAudioBackend
+{
+public:
+	using VoiceId = uint32_t;
+	static constexpr VoiceId kInvalidVoice = 0;
+
+	// 再生し終えたボイス
+	struct Finished {
+		VoiceId voice = kInvalidVoice;
+		uint64_t context = 0;	// Play で渡した値
+	};
+
+	virtual ~IAudioBackend() = default;
+
+	/// <summary>
+	/// ボイスの作成 (失敗したら kInvalidVoice)
+	/// </summary>
+	virtual VoiceId CreateVoice(const AudioFormat& format) = 0;
+
+	/// <summary>
+	/// ボイスの破棄
+	/// </summary>
+	virtual void DestroyVoice(VoiceId voice) = 0;
+
+	/// <summary>
+	/// 波形を送って再生を始める (data は再生し終えるまで有効であること)
+	/// </summary>
+	/// <param name="loop">止めるまで繰り返す (再生し終えた通知は来ない)</param>
+	/// <param name="context">再生し終えた時に CollectFinished で返る値</param>
+	virtual bool Play(VoiceId voice, const uint8_t* data, uint32_t size, bool loop, uint64_t context) = 0;
+
+	/// <summary>
+	/// 止めて送った波形を捨てる (再生し終えた通知は来なくてもよい)
+	/// </summary>
+	virtual void Stop(VoiceId voice) = 0;
+
+	/// <summary>
+	/// 音量 (0.0f ～ 1.0f)
+	/// </summary>
+	virtual void SetVolume(VoiceId voice, float volume) = 0;
+
+	/// <summary>
+	/// 前回から再生し終えたボイスを受け取る (通知は別スレッドから来ることがある)
+	/// </summary>
+	virtual void CollectFinished(std::vector<Finished>& outFinished) = 0;
+};
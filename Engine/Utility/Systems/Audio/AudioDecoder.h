@@ -0,0 +1,39 @@
+#pragma once
+
+// C++
+#include <cstdint>
+
+// Engine
+#include "AudioBackend.h"
+
+/// <summary>
+/// ストリーミング再生で使うデコーダ (少しずつPCMを取り出す)
+/// AudioStream のデコード用スレッドからだけ呼ばれる
+/// </summary>
+class IAudioDecoder
+{
+public:
+	virtual ~IAudioDecoder() = default;
+
+	/// <summary>
+	/// 取り出すPCMの形式
+	/// </summary>
+	virtual const AudioFormat& GetFormat() const = 0;
+
+	/// <summary>
+	/// 全体のサンプル数 (1サンプルは全チャンネル分。分からなければ0)
+	/// </summary>
+	virtual uint64_t GetTotalSamples() const = 0;
+
+	/// <summary>
+	/// PCMを取り出す
+	/// </summary>
+	/// <param name="size">最大のバイト数 (blockAlign の倍数)</param>
+	/// <returns>書き込んだバイト数 (終端なら0)</returns>
+	virtual uint32_t Read(uint8_t* dst, uint32_t size) = 0;
+
+	/// <summary>
+	/// 指定のサンプルへ移動 (次の Read はそこから)
+	/// </summary>
+	virtual bool Seek(uint64_t sample) = 0;
+};
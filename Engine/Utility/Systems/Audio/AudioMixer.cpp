@@ -0,0 +1,311 @@
+#include "AudioMixer.h"
+
+// C++
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+// Engine
+#include "MixerKernels.h"
+
+namespace {
+	constexpr uint16_t kFormatPCM = 1;
+	constexpr uint16_t kFormatFloat = 3;
+
+	// 混ぜられる波形か
+	bool IsSupported(const AudioFormat& format)
+	{
+		const bool pcm16 = format.formatTag == kFormatPCM && format.bitsPerSample == 16;
+		const bool float32 = format.formatTag == kFormatFloat && format.bitsPerSample == 32;
+		return (pcm16 || float32) && (format.channels == 1 || format.channels == 2) &&
+			format.sampleRate > 0 && format.blockAlign == format.channels * format.bitsPerSample / 8;
+	}
+}
+
+/// <summary>
+/// AudioStream に渡す読み口
+/// </summary>
+class AudioMixer::Source : public IAudioDecoder
+{
+public:
+	explicit Source(AudioMixer* mixer)
+		: mixer_(mixer), block_(mixer->GetBlockFrames() * kOutputChannels), blockOffset_(static_cast<uint32_t>(block_.size() * sizeof(float))) {}
+
+	const AudioFormat& GetFormat() const override { return mixer_->GetOutputFormat(); }
+	uint64_t GetTotalSamples() const override { return 0; }
+
+	uint32_t Read(uint8_t* dst, uint32_t size) override
+	{
+		const uint32_t blockBytes = static_cast<uint32_t>(block_.size() * sizeof(float));
+		uint32_t written = 0;
+		while (written < size) {
+			if (blockOffset_ >= blockBytes) {
+				mixer_->Render(block_.data());
+				blockOffset_ = 0;
+			}
+			const uint32_t count = (std::min)(size - written, blockBytes - blockOffset_);
+			std::memcpy(dst + written, reinterpret_cast<const uint8_t*>(block_.data()) + blockOffset_, count);
+			blockOffset_ += count;
+			written += count;
+		}
+		return written;
+	}
+
+	// ミキサーは再生位置を持たないので、どこへでも移動できたことにする
+	bool Seek(uint64_t) override { return true; }
+
+private:
+	AudioMixer* mixer_;
+	std::vector<float> block_;
+	uint32_t blockOffset_;
+};
+
+AudioMixer::AudioMixer(uint32_t sampleRate, uint32_t blockFrames)
+	: blockFrames_((std::max)(blockFrames, 1u))
+{
+	outputFormat_.formatTag = kFormatFloat;
+	outputFormat_.channels = kOutputChannels;
+	outputFormat_.sampleRate = sampleRate;
+	outputFormat_.bitsPerSample = 32;
+	outputFormat_.blockAlign = kOutputChannels * sizeof(float);
+	resampled_.resize(size_t(blockFrames_) * kOutputChannels);
+}
+
+/// <summary>
+/// ボイスの作成
+/// </summary>
+IAudioBackend::VoiceId AudioMixer::CreateVoice(const AudioFormat& format)
+{
+	if (!IsSupported(format)) {
+		return kInvalidVoice;
+	}
+	std::lock_guard<std::mutex> lock(mutex_);
+	VoiceId id = kInvalidVoice;
+	if (!freeIds_.empty()) {
+		id = freeIds_.back();
+		freeIds_.pop_back();
+	} else {
+		voices_.emplace_back();
+		id = static_cast<VoiceId>(voices_.size());
+	}
+	Voice& voice = voices_[id - 1];
+	voice = Voice{};
+	voice.used = true;
+	voice.format = format;
+	return id;
+}
+
+/// <summary>
+/// ボイスの破棄
+/// </summary>
+void AudioMixer::DestroyVoice(VoiceId voice)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (Voice* v = FindVoice(voice)) {
+		*v = Voice{};
+		freeIds_.push_back(voice);
+	}
+}
+
+/// <summary>
+/// 再生開始
+/// </summary>
+bool AudioMixer::Play(VoiceId voice, const uint8_t* data, uint32_t size, bool loop, uint64_t context)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	Voice* v = FindVoice(voice);
+	if (!v || !data || size < v->format.blockAlign) {
+		return false;
+	}
+	v->data = data;
+	v->frames = size / v->format.blockAlign;
+	v->position = 0;
+	v->pan = 0.0f;
+	v->pitch = 1.0f;
+	UpdateStep(*v);
+	v->playing = true;
+	v->loop = loop;
+	v->context = context;
+	return true;
+}
+
+/// <summary>
+/// 停止
+/// </summary>
+void AudioMixer::Stop(VoiceId voice)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (Voice* v = FindVoice(voice)) {
+		v->playing = false;
+	}
+}
+
+/// <summary>
+/// 音量
+/// </summary>
+void AudioMixer::SetVolume(VoiceId voice, float volume)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (Voice* v = FindVoice(voice)) {
+		v->volume = volume;
+	}
+}
+
+/// <summary>
+/// 再生し終えたボイスを渡す
+/// </summary>
+void AudioMixer::CollectFinished(std::vector<Finished>& outFinished)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	outFinished.insert(outFinished.end(), finished_.begin(), finished_.end());
+	finished_.clear();
+}
+
+/// <summary>
+/// パン
+/// </summary>
+void AudioMixer::SetPan(VoiceId voice, float pan)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (Voice* v = FindVoice(voice)) {
+		v->pan = std::clamp(pan, -1.0f, 1.0f);
+	}
+}
+
+/// <summary>
+/// ピッチ
+/// </summary>
+void AudioMixer::SetPitch(VoiceId voice, float pitch)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (Voice* v = FindVoice(voice)) {
+		v->pitch = std::clamp(pitch, kMinPitch, kMaxPitch);
+		UpdateStep(*v);
+	}
+}
+
+/// <summary>
+/// 1ブロック分混ぜる
+/// </summary>
+void AudioMixer::Render(float* out)
+{
+	std::fill(out, out + size_t(blockFrames_) * kOutputChannels, 0.0f);
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	for (uint32_t i = 0; i < voices_.size(); ++i) {
+		if (voices_[i].playing) {
+			MixVoice(i + 1, voices_[i], out);
+		}
+	}
+}
+
+/// <summary>
+/// AudioStream に渡す読み口
+/// </summary>
+std::unique_ptr<IAudioDecoder> AudioMixer::CreateSource()
+{
+	return std::make_unique<Source>(this);
+}
+
+uint32_t AudioMixer::GetActiveCount() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return static_cast<uint32_t>(std::count_if(voices_.begin(), voices_.end(), [](const Voice& voice) { return voice.playing; }));
+}
+
+AudioMixer::Voice* AudioMixer::FindVoice(VoiceId voice)
+{
+	return voice != kInvalidVoice && voice <= voices_.size() && voices_[voice - 1].used ? &voices_[voice - 1] : nullptr;
+}
+
+const AudioMixer::Voice* AudioMixer::FindVoice(VoiceId voice) const
+{
+	return voice != kInvalidVoice && voice <= voices_.size() && voices_[voice - 1].used ? &voices_[voice - 1] : nullptr;
+}
+
+/// <summary>
+/// 再生速度から進む量を決める
+/// </summary>
+void AudioMixer::UpdateStep(Voice& voice) const
+{
+	const double ratio = double(voice.format.sampleRate) / outputFormat_.sampleRate * voice.pitch;
+	voice.step = (std::max)(static_cast<uint64_t>(ratio * 4294967296.0 + 0.5), uint64_t(1));
+}
+
+/// <summary>
+/// 1ボイス分を足し込む
+/// </summary>
+void AudioMixer::MixVoice(VoiceId id, Voice& voice, float* mix)
+{
+	const uint32_t channels = voice.format.channels;
+	const uint64_t end = uint64_t(voice.frames) << 32;
+
+	// パンは左右の片方だけを絞る (中央ならどちらもそのままの音量)
+	const float gainL = voice.volume * (std::min)(1.0f, 1.0f - voice.pan);
+	const float gainR = voice.volume * (std::min)(1.0f, 1.0f + voice.pan);
+
+	uint32_t done = 0;
+	while (done < blockFrames_) {
+		if (voice.position >= end) {
+			if (!voice.loop) {
+				voice.playing = false;
+				finished_.push_back({ id, voice.context });
+				return;
+			}
+			voice.position %= end;
+		}
+
+		// 終端までに作れる数だけ作る (残りは先頭へ戻ってから)
+		const uint64_t remaining = (end - voice.position + voice.step - 1) / voice.step;
+		const uint32_t count = static_cast<uint32_t>((std::min)(uint64_t(blockFrames_ - done), remaining));
+		const uint32_t first = static_cast<uint32_t>(voice.position >> 32);
+		float* out = mix + size_t(done) * kOutputChannels;
+
+		const float* samples = nullptr;
+		if (voice.step == (uint64_t(1) << 32) && static_cast<uint32_t>(voice.position) == 0) {
+			// 同じ速さなら変換だけ
+			sourceScratch_.resize(size_t(count) * channels);
+			ConvertFrames(voice, first, count, sourceScratch_.data());
+			samples = sourceScratch_.data();
+		} else {
+			// 補間の相手 (最後の次のサンプル) まで変換する。終端の次は、繰り返すなら先頭、でなければ最後のサンプル
+			const uint32_t last = static_cast<uint32_t>((voice.position + voice.step * (count - 1)) >> 32);
+			const uint32_t span = last - first + 1;
+			sourceScratch_.resize(size_t(span + 1) * channels);
+			ConvertFrames(voice, first, span, sourceScratch_.data());
+			const uint32_t next = last + 1 < voice.frames ? last + 1 : (voice.loop ? 0 : last);
+			ConvertFrames(voice, next, 1, sourceScratch_.data() + size_t(span) * channels);
+
+			MixerKernels::ResampleLinear(sourceScratch_.data(), channels, voice.position - (uint64_t(first) << 32), voice.step, resampled_.data(), count);
+			samples = resampled_.data();
+		}
+
+		if (channels == 1) {
+			MixerKernels::MixMonoToStereo(samples, out, count, gainL, gainR);
+		} else {
+			MixerKernels::MixStereoToStereo(samples, out, count, gainL, gainR);
+		}
+
+		voice.position += voice.step * count;
+		done += count;
+	}
+
+	// ちょうどブロックの終わりで鳴り終えた時もここで通知する
+	if (voice.position >= end && !voice.loop) {
+		voice.playing = false;
+		finished_.push_back({ id, voice.context });
+	}
+}
+
+/// <summary>
+/// 波形を float にする
+/// </summary>
+void AudioMixer::ConvertFrames(const Voice& voice, uint32_t first, uint32_t count, float* dst)
+{
+	const uint32_t channels = voice.format.channels;
+	if (voice.format.formatTag == kFormatPCM) {
+		MixerKernels::ConvertPcm16(reinterpret_cast<const int16_t*>(voice.data) + size_t(first) * channels, dst, count * channels);
+	} else {
+		std::memcpy(dst, reinterpret_cast<const float*>(voice.data) + size_t(first) * channels, size_t(count) * channels * sizeof(float));
+	}
+}
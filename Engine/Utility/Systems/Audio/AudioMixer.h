@@ -0,0 +1,124 @@
+#pragma once
+
+// C++
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Engine
+#include "AudioBackend.h"
+#include "AudioDecoder.h"
+
+/// <summary>
+/// エンジン側で音を混ぜるソフトウェアミキサー
+/// 鳴っている音を音量・パン・ピッチ (線形補間で再サンプル) を掛けて、決まった長さのステレオ float のブロックへ足し込む
+/// IAudioBackend なのでボイスプールの再生先にでき、CreateSource で作った読み口を AudioStream に渡すと
+/// デコード用スレッドで混ぜて出力先 (XAudio2 / WAVファイル / 何も鳴らさない) へ流せる
+/// 対応する波形は 16bit PCM と 32bit float の、モノラルとステレオ
+/// </summary>
+class AudioMixer : public IAudioBackend
+{
+public: // 定数
+
+	// 出力のチャンネル数 (ステレオ固定)
+	static constexpr uint32_t kOutputChannels = 2;
+	static constexpr uint32_t kDefaultSampleRate = 48000;
+	static constexpr uint32_t kDefaultBlockFrames = 256;
+	// ピッチの範囲
+	static constexpr float kMinPitch = 0.125f;
+	static constexpr float kMaxPitch = 4.0f;
+
+public: // メンバ関数
+
+	explicit AudioMixer(uint32_t sampleRate = kDefaultSampleRate, uint32_t blockFrames = kDefaultBlockFrames);
+	~AudioMixer() override = default;
+
+	AudioMixer(const AudioMixer&) = delete;
+	AudioMixer& operator=(const AudioMixer&) = delete;
+
+	// IAudioBackend
+	VoiceId CreateVoice(const AudioFormat& format) override;
+	void DestroyVoice(VoiceId voice) override;
+	bool Play(VoiceId voice, const uint8_t* data, uint32_t size, bool loop, uint64_t context) override;
+	void Stop(VoiceId voice) override;
+	void SetVolume(VoiceId voice, float volume) override;
+	void CollectFinished(std::vector<Finished>& outFinished) override;
+
+	/// <summary>
+	/// パン (-1.0f で左だけ、1.0f で右だけ。Play で中央に戻る)
+	/// </summary>
+	void SetPan(VoiceId voice, float pan);
+
+	/// <summary>
+	/// ピッチ (再生速度の倍率。Play で1.0f に戻る)
+	/// </summary>
+	void SetPitch(VoiceId voice, float pitch);
+
+	/// <summary>
+	/// 1ブロック分混ぜる
+	/// </summary>
+	/// <param name="out">GetBlockFrames() × 2 (L, R の交互) の float</param>
+	void Render(float* out);
+
+	/// <summary>
+	/// AudioStream に渡す読み口 (このミキサーより先に破棄すること)
+	/// </summary>
+	std::unique_ptr<IAudioDecoder> CreateSource();
+
+	const AudioFormat& GetOutputFormat() const { return outputFormat_; }
+	uint32_t GetBlockFrames() const { return blockFrames_; }
+	uint32_t GetActiveCount() const;
+
+private:
+
+	// ミキサーの1ボイス
+	struct Voice {
+		bool used = false;
+		AudioFormat format;
+		const uint8_t* data = nullptr;
+		uint32_t frames = 0;		// 波形のサンプル数
+		uint64_t position = 0;		// 再生位置 (32.32 の固定小数)
+		uint64_t step = 0;			// 出力1サンプルで進む量 (32.32 の固定小数)
+		float volume = 1.0f;
+		float pan = 0.0f;
+		float pitch = 1.0f;
+		bool playing = false;
+		bool loop = false;
+		uint64_t context = 0;
+	};
+
+	// AudioStream に渡す読み口 (ブロック単位で混ぜ、端数は次の Read へ持ち越す)
+	class Source;
+
+	Voice* FindVoice(VoiceId voice);
+	const Voice* FindVoice(VoiceId voice) const;
+
+	/// <summary>
+	/// 再生速度から進む量を決める
+	/// </summary>
+	void UpdateStep(Voice& voice) const;
+
+	/// <summary>
+	/// 1ボイス分を足し込む
+	/// </summary>
+	void MixVoice(VoiceId id, Voice& voice, float* mix);
+
+	/// <summary>
+	/// 波形の first から count サンプルを float にして dst へ (チャンネルはそのまま)
+	/// </summary>
+	static void ConvertFrames(const Voice& voice, uint32_t first, uint32_t count, float* dst);
+
+private: // メンバ変数
+
+	AudioFormat outputFormat_;
+	uint32_t blockFrames_ = kDefaultBlockFrames;
+
+	mutable std::mutex mutex_;
+	std::vector<Voice> voices_;		// VoiceId - 1 が添字
+	std::vector<VoiceId> freeIds_;
+	std::vector<Finished> finished_;
+
+	// 作業用
+	std::vector<float> sourceScratch_;	// float にした元の波形
+	std::vector<float> resampled_;		// 再サンプルした波形
+};
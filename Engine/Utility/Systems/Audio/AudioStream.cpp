@@ -0,0 +1,332 @@
+#include "AudioStream.h"
+
+// C++
+#include <algorithm>
+#include <chrono>
+
+AudioStream::~AudioStream()
+{
+	Close();
+}
+
+/// <summary>
+/// 開く
+/// </summary>
+bool AudioStream::Open(std::unique_ptr<IAudioDecoder> decoder, std::unique_ptr<IStreamOutput> output, const Settings& settings)
+{
+	Close();
+	if (!decoder || !output) {
+		return false;
+	}
+
+	format_ = decoder->GetFormat();
+	if (format_.blockAlign == 0 || format_.sampleRate == 0 || !output->Open(format_)) {
+		return false;
+	}
+	totalSamples_ = decoder->GetTotalSamples();
+	decoder_ = std::move(decoder);
+	output_ = std::move(output);
+
+	// バッファはサンプルの切れ目で区切る
+	const uint32_t bufferCount = (std::max)(settings.bufferCount, 2u);
+	const uint64_t samplesPerBuffer = (std::max)(uint64_t(format_.sampleRate) * settings.bufferMilliseconds / 1000, uint64_t(1));
+	buffers_.assign(bufferCount, std::vector<uint8_t>(static_cast<size_t>(samplesPerBuffer * format_.blockAlign)));
+	bufferStartSamples_.assign(bufferCount, 0);
+	writeIndex_ = 0;
+	queuedCount_ = 0;
+	decodeSample_ = 0;
+	decodeEnded_ = false;
+	outputStarted_ = false;
+	workStats_ = {};
+	positionSample_ = 0;
+
+	quit_ = false;
+	state_ = State::kStopped;
+	stats_ = {};
+	commands_.clear();
+	thread_ = std::thread(&AudioStream::ThreadMain, this);
+	return true;
+}
+
+/// <summary>
+/// 閉じる
+/// </summary>
+void AudioStream::Close()
+{
+	if (thread_.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			quit_ = true;
+		}
+		condition_.notify_one();
+		thread_.join();
+	}
+
+	// 出力先がバッファを読み終えてから捨てる
+	if (output_) {
+		output_->Stop();
+		output_->Close();
+		output_.reset();
+	}
+	decoder_.reset();
+	buffers_.clear();
+	bufferStartSamples_.clear();
+	state_ = State::kStopped;
+}
+
+/// <summary>
+/// 再生
+/// </summary>
+void AudioStream::Play(bool loop)
+{
+	loop_ = loop;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		state_ = State::kPlaying;
+		commands_.push_back({ Command::Type::kPlay });
+	}
+	condition_.notify_one();
+}
+
+/// <summary>
+/// 一時停止
+/// </summary>
+void AudioStream::Pause()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (state_ != State::kPlaying) {
+			return;
+		}
+		state_ = State::kPaused;
+		commands_.push_back({ Command::Type::kPause });
+	}
+	condition_.notify_one();
+}
+
+/// <summary>
+/// 停止
+/// </summary>
+void AudioStream::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		state_ = State::kStopped;
+		commands_.push_back({ Command::Type::kStop });
+	}
+	condition_.notify_one();
+}
+
+/// <summary>
+/// 再生位置の移動
+/// </summary>
+void AudioStream::Seek(double seconds)
+{
+	if (!IsOpen()) {
+		return;
+	}
+	uint64_t sample = static_cast<uint64_t>((std::max)(seconds, 0.0) * format_.sampleRate);
+	if (totalSamples_ > 0) {
+		sample = (std::min)(sample, totalSamples_);
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		commands_.push_back({ Command::Type::kSeek, sample });
+	}
+	condition_.notify_one();
+}
+
+/// <summary>
+/// 音量
+/// </summary>
+void AudioStream::SetVolume(float volume)
+{
+	if (output_) {
+		output_->SetVolume(volume);
+	}
+}
+
+AudioStream::State AudioStream::GetState() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return state_;
+}
+
+/// <summary>
+/// 再生位置 (秒)
+/// </summary>
+double AudioStream::GetPosition() const
+{
+	return format_.sampleRate ? static_cast<double>(positionSample_.load()) / format_.sampleRate : 0.0;
+}
+
+/// <summary>
+/// 長さ (秒)
+/// </summary>
+double AudioStream::GetDuration() const
+{
+	return format_.sampleRate ? static_cast<double>(totalSamples_) / format_.sampleRate : 0.0;
+}
+
+AudioStream::Stats AudioStream::GetStats() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return stats_;
+}
+
+/// <summary>
+/// デコード用スレッド
+/// </summary>
+void AudioStream::ThreadMain()
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (!quit_) {
+		// 依頼を来た順に処理する
+		while (!commands_.empty() && !quit_) {
+			const Command command = commands_.front();
+			commands_.pop_front();
+			lock.unlock();
+			Execute(command);
+			lock.lock();
+		}
+
+		if (state_ == State::kPlaying && !quit_) {
+			lock.unlock();
+			const bool finished = Pump();
+			lock.lock();
+			// 鳴り終えても、その間に来た依頼があればそちらを優先する
+			if (finished && commands_.empty()) {
+				state_ = State::kStopped;
+			}
+		}
+		stats_ = workStats_;
+
+		condition_.wait_for(lock, std::chrono::milliseconds(kPollMilliseconds), [this] {
+			return quit_ || !commands_.empty();
+			});
+	}
+}
+
+/// <summary>
+/// 依頼の処理
+/// </summary>
+void AudioStream::Execute(const Command& command)
+{
+	switch (command.type) {
+	case Command::Type::kPlay:
+		// 最後まで鳴り終えていれば先頭から、一時停止中なら続きから
+		if (decodeEnded_ && queuedCount_ == 0) {
+			Rewind(0);
+		} else if (outputStarted_) {
+			output_->Start();
+		}
+		break;
+
+	case Command::Type::kPause:
+		output_->Pause();
+		break;
+
+	case Command::Type::kStop:
+		Rewind(0);
+		break;
+
+	case Command::Type::kSeek:
+		Rewind(command.sample);
+		++workStats_.seeks;
+		break;
+	}
+}
+
+/// <summary>
+/// 鳴り終わったバッファを空け、空いたバッファを埋めて積む
+/// </summary>
+bool AudioStream::Pump()
+{
+	const uint32_t bufferCount = static_cast<uint32_t>(buffers_.size());
+
+	// 積んだ順に鳴り終わるので、減った分だけ古い方から空く
+	queuedCount_ = (std::min)(queuedCount_, output_->GetQueuedCount());
+	if (queuedCount_ > 0) {
+		positionSample_ = bufferStartSamples_[(writeIndex_ + bufferCount - queuedCount_) % bufferCount];
+	} else if (outputStarted_) {
+		if (decodeEnded_) {
+			positionSample_ = decodeSample_;
+			return true;
+		}
+		// デコードが追いつかず鳴らすものが無くなった
+		++workStats_.underruns;
+	}
+
+	while (queuedCount_ < bufferCount && !decodeEnded_) {
+		std::vector<uint8_t>& buffer = buffers_[writeIndex_];
+		bufferStartSamples_[writeIndex_] = decodeSample_;
+		const uint32_t bytes = FillBuffer(buffer);
+		if (bytes == 0) {
+			break;
+		}
+		if (!output_->Submit(buffer.data(), bytes)) {
+			decodeEnded_ = true;
+			break;
+		}
+		++queuedCount_;
+		++workStats_.submittedBuffers;
+		writeIndex_ = (writeIndex_ + 1) % bufferCount;
+
+		// 最初のバッファを積んだらすぐ鳴らし始め、残りはその間に埋める
+		if (!outputStarted_) {
+			output_->Start();
+			outputStarted_ = true;
+		}
+	}
+
+	return decodeEnded_ && queuedCount_ == 0;
+}
+
+/// <summary>
+/// バッファ1つ分デコードする
+/// </summary>
+uint32_t AudioStream::FillBuffer(std::vector<uint8_t>& buffer)
+{
+	const uint32_t capacity = static_cast<uint32_t>(buffer.size());
+	uint32_t filled = 0;
+	bool rewound = false;
+	while (filled < capacity) {
+		const uint32_t bytes = decoder_->Read(buffer.data() + filled, capacity - filled);
+		if (bytes > 0) {
+			filled += bytes;
+			decodeSample_ += bytes / format_.blockAlign;
+			workStats_.decodedBytes += bytes;
+			rewound = false;
+			continue;
+		}
+
+		// 終端。繰り返すなら先頭へ戻って同じバッファの続きを埋める (戻っても何も読めなければ終わる)
+		if (!loop_ || rewound || !decoder_->Seek(0)) {
+			decodeEnded_ = true;
+			break;
+		}
+		rewound = true;
+		decodeSample_ = 0;
+		++workStats_.loops;
+	}
+	return filled;
+}
+
+/// <summary>
+/// 積んだバッファを捨てて指定の位置から読み直す準備をする
+/// </summary>
+void AudioStream::Rewind(uint64_t sample)
+{
+	output_->Stop();
+	queuedCount_ = 0;
+	writeIndex_ = 0;
+	outputStarted_ = false;
+
+	if (!decoder_->Seek(sample)) {
+		sample = 0;
+		decoder_->Seek(0);
+	}
+	decodeSample_ = sample;
+	decodeEnded_ = false;
+	positionSample_ = sample;
+}
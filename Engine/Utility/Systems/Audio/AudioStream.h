@@ -0,0 +1,185 @@
+#pragma once
+
+// C++
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Engine
+#include "AudioDecoder.h"
+#include "StreamOutput.h"
+
+/// <summary>
+/// ストリーミング再生 (BGMなど長い音用)
+/// デコード用スレッドが数個のバッファを順に埋めて出力先へ積み、鳴り終わったバッファをまた埋める
+/// 最初のバッファを積んだ時点で鳴り始めるので、曲全体のデコードを待たず、全体をメモリに展開もしない
+/// 操作 (再生・停止・シーク) はスレッドへの依頼として積み、呼んだ側は待たない
+/// </summary>
+class AudioStream
+{
+public: // 型
+
+	// バッファの設定
+	struct Settings {
+		uint32_t bufferCount = 4;			// リングのバッファ数
+		uint32_t bufferMilliseconds = 250;	// 1バッファの長さ (バッファ数 × 長さ が先読みの量)
+	};
+
+	// 統計 (累計)
+	struct Stats {
+		uint64_t decodedBytes = 0;		// デコードしたバイト数
+		uint64_t submittedBuffers = 0;	// 出力先へ積んだバッファ数
+		uint32_t underruns = 0;			// 再生中に積んだバッファが尽きた回数
+		uint32_t loops = 0;				// 先頭へ戻った回数
+		uint32_t seeks = 0;				// シークした回数
+	};
+
+	enum class State {
+		kStopped,
+		kPlaying,
+		kPaused,
+	};
+
+public: // メンバ関数
+
+	AudioStream() = default;
+	~AudioStream();
+
+	AudioStream(const AudioStream&) = delete;
+	AudioStream& operator=(const AudioStream&) = delete;
+
+	/// <summary>
+	/// 開く (デコード用スレッドを立てる)
+	/// </summary>
+	bool Open(std::unique_ptr<IAudioDecoder> decoder, std::unique_ptr<IStreamOutput> output, const Settings& settings);
+	bool Open(std::unique_ptr<IAudioDecoder> decoder, std::unique_ptr<IStreamOutput> output) { return Open(std::move(decoder), std::move(output), Settings{}); }
+
+	/// <summary>
+	/// 閉じる (スレッドを止めて出力先を閉じる)
+	/// </summary>
+	void Close();
+
+	/// <summary>
+	/// 再生 (一時停止中なら続きから、再生し終えていれば先頭から)
+	/// </summary>
+	/// <param name="loop">終端まで来たら先頭へ戻って鳴らし続ける</param>
+	void Play(bool loop = false);
+
+	/// <summary>
+	/// 一時停止
+	/// </summary>
+	void Pause();
+
+	/// <summary>
+	/// 停止 (先頭へ戻る)
+	/// </summary>
+	void Stop();
+
+	/// <summary>
+	/// 再生位置の移動 (再生中ならそこから鳴り直す)
+	/// </summary>
+	void Seek(double seconds);
+
+	/// <summary>
+	/// 繰り返すか (再生中でも切り替えられる)
+	/// </summary>
+	void SetLoop(bool loop) { loop_ = loop; }
+
+	/// <summary>
+	/// 音量 (0.0f ～ 1.0f)
+	/// </summary>
+	void SetVolume(float volume);
+
+	bool IsOpen() const { return thread_.joinable(); }
+	bool IsPlaying() const { return GetState() == State::kPlaying; }
+	State GetState() const;
+
+	/// <summary>
+	/// 再生位置 (秒、鳴っているバッファの先頭の位置なのでバッファ1つ分の粗さがある)
+	/// </summary>
+	double GetPosition() const;
+
+	/// <summary>
+	/// 長さ (秒、分からなければ0)
+	/// </summary>
+	double GetDuration() const;
+
+	const AudioFormat& GetFormat() const { return format_; }
+	Stats GetStats() const;
+
+private:
+
+	// スレッドへの依頼
+	struct Command {
+		enum class Type {
+			kPlay,
+			kPause,
+			kStop,
+			kSeek,
+		};
+		Type type = Type::kPlay;
+		uint64_t sample = 0;	// kSeek の移動先
+	};
+
+	// デコード用スレッドの中身
+	void ThreadMain();
+
+	/// <summary>
+	/// 依頼の処理 (スレッドで呼ぶ)
+	/// </summary>
+	void Execute(const Command& command);
+
+	/// <summary>
+	/// 鳴り終わったバッファを空け、空いたバッファを埋めて積む (スレッドで呼ぶ)
+	/// </summary>
+	/// <returns>最後まで鳴り終えたか</returns>
+	bool Pump();
+
+	/// <summary>
+	/// バッファ1つ分デコードする (終端で繰り返すなら先頭へ戻って続ける)
+	/// </summary>
+	uint32_t FillBuffer(std::vector<uint8_t>& buffer);
+
+	/// <summary>
+	/// 積んだバッファを捨てて指定の位置から読み直す準備をする
+	/// </summary>
+	void Rewind(uint64_t sample);
+
+private: // メンバ変数
+
+	// 依頼が無い時にバッファの空きを見に行く間隔 (ミリ秒)
+	static constexpr uint32_t kPollMilliseconds = 5;
+
+	std::unique_ptr<IAudioDecoder> decoder_;
+	std::unique_ptr<IStreamOutput> output_;
+	AudioFormat format_;
+	uint64_t totalSamples_ = 0;
+
+	// スレッドと依頼
+	std::thread thread_;
+	mutable std::mutex mutex_;
+	std::condition_variable condition_;
+	std::deque<Command> commands_;
+	bool quit_ = false;
+	State state_ = State::kStopped;
+	std::atomic<bool> loop_ = false;
+	Stats stats_;				// 外から見る統計 (スレッドが workStats_ を写す)
+
+	// ここから下はスレッドだけが触る
+	std::vector<std::vector<uint8_t>> buffers_;
+	std::vector<uint64_t> bufferStartSamples_;	// バッファの先頭が何サンプル目か
+	uint32_t writeIndex_ = 0;		// 次に埋めるバッファ
+	uint32_t queuedCount_ = 0;		// 積んで鳴り終わっていないバッファ数
+	uint64_t decodeSample_ = 0;		// 次にデコードするサンプル
+	bool decodeEnded_ = false;		// 終端までデコードした (繰り返さない時)
+	bool outputStarted_ = false;
+	Stats workStats_;
+
+	// 再生位置 (サンプル)
+	std::atomic<uint64_t> positionSample_ = 0;
+};
@@ -0,0 +1,200 @@
+#include "MediaFoundationDecoder.h"
+
+// C++
+#include <Windows.h>
+#include <mfapi.h>
+#include <mferror.h>
+#include <shlwapi.h>
+#include <algorithm>
+#include <cstring>
+
+// Engine
+#include "Loaders/Archive/FileSystem.h"
+
+using Microsoft::WRL::ComPtr;
+
+namespace {
+	// Media Foundation の時間は100ナノ秒単位
+	constexpr uint64_t kTimeUnitsPerSecond = 10000000;
+
+	// FileSystem のパスをソースリーダーの元ファイル名 (拡張子で形式を判定する) に渡すためにUTF-16へ
+	std::wstring ToWide(const std::string& str)
+	{
+		const int length = MultiByteToWideChar(CP_UTF8, 0, str.c_str(), -1, nullptr, 0);
+		if (length <= 1) {
+			return {};
+		}
+		std::wstring result(static_cast<size_t>(length - 1), L'\0');
+		MultiByteToWideChar(CP_UTF8, 0, str.c_str(), -1, result.data(), length);
+		return result;
+	}
+}
+
+/// <summary>
+/// FileSystem から開く
+/// </summary>
+bool MediaFoundationDecoder::Open(const std::string& filePath)
+{
+	reader_.Reset();
+	pending_.clear();
+	pendingOffset_ = 0;
+	endOfStream_ = false;
+	trimAfterSeek_ = false;
+
+	// 圧縮されたままのファイルをメモリ上のストリームにする (SHCreateMemStream がコピーを持つので view はここで閉じてよい)
+	FileSystem::FileView file = FileSystem::GetInstance()->Open(filePath);
+	if (!file.IsValid()) {
+		return false;
+	}
+	ComPtr<IStream> stream;
+	stream.Attach(SHCreateMemStream(file.GetData(), static_cast<UINT>(file.GetSize())));
+	if (!stream) {
+		return false;
+	}
+	ComPtr<IMFByteStream> byteStream;
+	if (FAILED(MFCreateMFByteStreamOnStream(stream.Get(), &byteStream))) {
+		return false;
+	}
+	ComPtr<IMFAttributes> streamAttributes;
+	if (SUCCEEDED(byteStream.As(&streamAttributes))) {
+		streamAttributes->SetString(MF_BYTESTREAM_ORIGIN_NAME, ToWide(filePath).c_str());
+	}
+	if (FAILED(MFCreateSourceReaderFromByteStream(byteStream.Get(), nullptr, &reader_))) {
+		return false;
+	}
+
+	// 音声だけをPCMで取り出す
+	reader_->SetStreamSelection(static_cast<DWORD>(MF_SOURCE_READER_ALL_STREAMS), FALSE);
+	reader_->SetStreamSelection(static_cast<DWORD>(MF_SOURCE_READER_FIRST_AUDIO_STREAM), TRUE);
+
+	ComPtr<IMFMediaType> audioType;
+	if (FAILED(MFCreateMediaType(&audioType)) ||
+		FAILED(audioType->SetGUID(MF_MT_MAJOR_TYPE, MFMediaType_Audio)) ||
+		FAILED(audioType->SetGUID(MF_MT_SUBTYPE, MFAudioFormat_PCM)) ||
+		FAILED(reader_->SetCurrentMediaType(static_cast<DWORD>(MF_SOURCE_READER_FIRST_AUDIO_STREAM), nullptr, audioType.Get()))) {
+		reader_.Reset();
+		return false;
+	}
+
+	ComPtr<IMFMediaType> actualType;
+	WAVEFORMATEX* wfex = nullptr;
+	if (FAILED(reader_->GetCurrentMediaType(static_cast<DWORD>(MF_SOURCE_READER_FIRST_AUDIO_STREAM), &actualType)) ||
+		FAILED(MFCreateWaveFormatExFromMFMediaType(actualType.Get(), &wfex, nullptr))) {
+		reader_.Reset();
+		return false;
+	}
+	format_.formatTag = wfex->wFormatTag;
+	format_.channels = wfex->nChannels;
+	format_.sampleRate = wfex->nSamplesPerSec;
+	format_.bitsPerSample = wfex->wBitsPerSample;
+	format_.blockAlign = wfex->nBlockAlign;
+	CoTaskMemFree(wfex);
+
+	// 長さ (無ければ0のまま)
+	totalSamples_ = 0;
+	PROPVARIANT duration;
+	PropVariantInit(&duration);
+	if (SUCCEEDED(reader_->GetPresentationAttribute(static_cast<DWORD>(MF_SOURCE_READER_MEDIASOURCE), MF_PD_DURATION, &duration)) &&
+		duration.vt == VT_UI8) {
+		totalSamples_ = duration.uhVal.QuadPart * format_.sampleRate / kTimeUnitsPerSecond;
+	}
+	PropVariantClear(&duration);
+	return format_.blockAlign != 0;
+}
+
+/// <summary>
+/// PCMを取り出す
+/// </summary>
+uint32_t MediaFoundationDecoder::Read(uint8_t* dst, uint32_t size)
+{
+	uint32_t written = 0;
+	while (written < size) {
+		if (pendingOffset_ >= pending_.size() && !DecodeNext()) {
+			break;
+		}
+		const size_t count = (std::min)(size_t(size - written), pending_.size() - pendingOffset_);
+		std::memcpy(dst + written, pending_.data() + pendingOffset_, count);
+		pendingOffset_ += count;
+		written += static_cast<uint32_t>(count);
+	}
+	return written;
+}
+
+/// <summary>
+/// 指定のサンプルへ移動
+/// </summary>
+bool MediaFoundationDecoder::Seek(uint64_t sample)
+{
+	if (!reader_) {
+		return false;
+	}
+	PROPVARIANT position;
+	PropVariantInit(&position);
+	position.vt = VT_I8;
+	position.hVal.QuadPart = static_cast<LONGLONG>(sample * kTimeUnitsPerSecond / format_.sampleRate);
+	const HRESULT hr = reader_->SetCurrentPosition(GUID_NULL, position);
+	PropVariantClear(&position);
+	if (FAILED(hr)) {
+		return false;
+	}
+
+	pending_.clear();
+	pendingOffset_ = 0;
+	endOfStream_ = false;
+	seekTarget_ = sample;
+	trimAfterSeek_ = sample > 0;
+	return true;
+}
+
+/// <summary>
+/// 次のサンプルをデコードする
+/// </summary>
+bool MediaFoundationDecoder::DecodeNext()
+{
+	pending_.clear();
+	pendingOffset_ = 0;
+
+	while (!endOfStream_ && reader_) {
+		DWORD flags = 0;
+		LONGLONG timestamp = 0;
+		ComPtr<IMFSample> sample;
+		if (FAILED(reader_->ReadSample(static_cast<DWORD>(MF_SOURCE_READER_FIRST_AUDIO_STREAM), 0, nullptr, &flags, &timestamp, &sample))) {
+			endOfStream_ = true;
+			break;
+		}
+		if (flags & MF_SOURCE_READERF_ENDOFSTREAM) {
+			endOfStream_ = true;
+		}
+		if (!sample) {
+			continue;
+		}
+
+		ComPtr<IMFMediaBuffer> buffer;
+		if (FAILED(sample->ConvertToContiguousBuffer(&buffer))) {
+			endOfStream_ = true;
+			break;
+		}
+		BYTE* data = nullptr;
+		DWORD length = 0;
+		if (FAILED(buffer->Lock(&data, nullptr, &length))) {
+			endOfStream_ = true;
+			break;
+		}
+		pending_.assign(data, data + length);
+		pendingOffset_ = 0;
+		buffer->Unlock();
+
+		// シーク直後は目的の位置より前の分を捨てる (目的の位置を含むサンプルが来るまで続ける)
+		if (trimAfterSeek_) {
+			const uint64_t startSample = timestamp > 0 ? uint64_t(timestamp) * format_.sampleRate / kTimeUnitsPerSecond : 0;
+			if (seekTarget_ > startSample) {
+				pendingOffset_ = (std::min)(size_t((seekTarget_ - startSample) * format_.blockAlign), pending_.size());
+			}
+			trimAfterSeek_ = pendingOffset_ >= pending_.size();
+		}
+		if (pendingOffset_ < pending_.size()) {
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+// C++
+#include <mfidl.h>
+#include <mfreadwrite.h>
+#include <wrl/client.h>
+#include <string>
+#include <vector>
+
+// Engine
+#include "AudioDecoder.h"
+
+/// <summary>
+/// Media Foundation のソースリーダーで .mp3 / .mp4 を少しずつPCMにするデコーダ
+/// 圧縮されたままのファイルだけをメモリに置き、デコードは Read の分だけ行う
+/// </summary>
+class MediaFoundationDecoder : public IAudioDecoder
+{
+public:
+
+	/// <summary>
+	/// FileSystem から開く (MFStartup 済みであること)
+	/// </summary>
+	bool Open(const std::string& filePath);
+
+	const AudioFormat& GetFormat() const override { return format_; }
+	uint64_t GetTotalSamples() const override { return totalSamples_; }
+	uint32_t Read(uint8_t* dst, uint32_t size) override;
+	bool Seek(uint64_t sample) override;
+
+private:
+
+	/// <summary>
+	/// 次のサンプルをデコードして pending_ に入れる (終端なら false)
+	/// </summary>
+	bool DecodeNext();
+
+private:
+
+	Microsoft::WRL::ComPtr<IMFSourceReader> reader_;
+	AudioFormat format_;
+	uint64_t totalSamples_ = 0;
+
+	// デコードしたが、まだ Read で渡していないPCM
+	std::vector<uint8_t> pending_;
+	size_t pendingOffset_ = 0;
+	bool endOfStream_ = false;
+
+	// シーク直後は手前のフレームから出てくるので、目的の位置まで読み捨てる
+	uint64_t seekTarget_ = 0;
+	bool trimAfterSeek_ = false;
+};
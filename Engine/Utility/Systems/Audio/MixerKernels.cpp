@@ -0,0 +1,167 @@
+#include "MixerKernels.h"
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#include <emmintrin.h>
+#define AUDIO_MIXER_SSE
+#endif
+
+namespace {
+	// 固定小数の小数部を float に
+	constexpr float kFixedToFloat = 1.0f / 4294967296.0f;
+
+#ifdef AUDIO_MIXER_SSE
+	bool simdEnabled = true;
+#else
+	bool simdEnabled = false;
+#endif
+}
+
+void MixerKernels::SetSimdEnabled(bool enable)
+{
+#ifdef AUDIO_MIXER_SSE
+	simdEnabled = enable;
+#else
+	(void)enable;
+#endif
+}
+
+bool MixerKernels::IsSimdEnabled()
+{
+	return simdEnabled;
+}
+
+/// <summary>
+/// 16bit PCM を float にする
+/// </summary>
+void MixerKernels::ConvertPcm16(const int16_t* src, float* dst, uint32_t count)
+{
+	constexpr float kScale = 1.0f / 32768.0f;
+	uint32_t i = 0;
+
+#ifdef AUDIO_MIXER_SSE
+	if (simdEnabled) {
+		const __m128 scale = _mm_set1_ps(kScale);
+		for (; i + 8 <= count; i += 8) {
+			const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			// 上位16bitへ寄せてから算術シフトで符号を広げる
+			const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16);
+			const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(packed, packed), 16);
+			_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+			_mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+		}
+	}
+#endif
+
+	// 残り (SIMDが使えない環境では全部)
+	for (; i < count; ++i) {
+		dst[i] = src[i] * kScale;
+	}
+}
+
+/// <summary>
+/// 線形補間で間引き・水増しする
+/// </summary>
+void MixerKernels::ResampleLinear(const float* src, uint32_t channels, uint64_t position, uint64_t step, float* dst, uint32_t frames)
+{
+	uint32_t i = 0;
+
+#ifdef AUDIO_MIXER_SSE
+	if (simdEnabled && channels == 1) {
+		// 4サンプル分の前後の値を集めてまとめて補間する
+		for (; i + 4 <= frames; i += 4) {
+			alignas(16) float s0[4];
+			alignas(16) float s1[4];
+			alignas(16) float t[4];
+			for (uint32_t k = 0; k < 4; ++k) {
+				const uint64_t p = position + step * (i + k);
+				const uint32_t index = static_cast<uint32_t>(p >> 32);
+				s0[k] = src[index];
+				s1[k] = src[index + 1];
+				t[k] = static_cast<uint32_t>(p) * kFixedToFloat;
+			}
+			const __m128 a = _mm_load_ps(s0);
+			const __m128 b = _mm_load_ps(s1);
+			_mm_storeu_ps(dst + i, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), _mm_load_ps(t))));
+		}
+	} else if (simdEnabled && channels == 2) {
+		// ステレオは (L, R) の前後が並んでいるので、2サンプルずつ読んで補間する
+		for (; i + 2 <= frames; i += 2) {
+			const uint64_t p0 = position + step * i;
+			const uint64_t p1 = p0 + step;
+			const float* f0 = src + (p0 >> 32) * 2;
+			const float* f1 = src + (p1 >> 32) * 2;
+			const __m128 a = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(f0)), reinterpret_cast<const __m64*>(f1));
+			const __m128 b = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(f0 + 2)), reinterpret_cast<const __m64*>(f1 + 2));
+			const float t0 = static_cast<uint32_t>(p0) * kFixedToFloat;
+			const float t1 = static_cast<uint32_t>(p1) * kFixedToFloat;
+			const __m128 t = _mm_setr_ps(t0, t0, t1, t1);
+			_mm_storeu_ps(dst + i * 2, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t)));
+		}
+	}
+#endif
+
+	// 残り (SIMDが使えない環境では全部)
+	for (; i < frames; ++i) {
+		const uint64_t p = position + step * i;
+		const uint32_t index = static_cast<uint32_t>(p >> 32);
+		const float t = static_cast<uint32_t>(p) * kFixedToFloat;
+		for (uint32_t c = 0; c < channels; ++c) {
+			const float a = src[index * channels + c];
+			const float b = src[(index + 1) * channels + c];
+			dst[i * channels + c] = a + (b - a) * t;
+		}
+	}
+}
+
+/// <summary>
+/// モノラルをステレオに足し込む
+/// </summary>
+void MixerKernels::MixMonoToStereo(const float* src, float* mix, uint32_t frames, float gainL, float gainR)
+{
+	uint32_t i = 0;
+
+#ifdef AUDIO_MIXER_SSE
+	if (simdEnabled) {
+		const __m128 gain = _mm_setr_ps(gainL, gainR, gainL, gainR);
+		for (; i + 4 <= frames; i += 4) {
+			const __m128 s = _mm_loadu_ps(src + i);
+			// (s0, s0, s1, s1) と (s2, s2, s3, s3) に広げる
+			const __m128 lo = _mm_unpacklo_ps(s, s);
+			const __m128 hi = _mm_unpackhi_ps(s, s);
+			float* out = mix + i * 2;
+			_mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), _mm_mul_ps(lo, gain)));
+			_mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), _mm_mul_ps(hi, gain)));
+		}
+	}
+#endif
+
+	// 残り (SIMDが使えない環境では全部)
+	for (; i < frames; ++i) {
+		mix[i * 2] += src[i] * gainL;
+		mix[i * 2 + 1] += src[i] * gainR;
+	}
+}
+
+/// <summary>
+/// ステレオを足し込む
+/// </summary>
+void MixerKernels::MixStereoToStereo(const float* src, float* mix, uint32_t frames, float gainL, float gainR)
+{
+	uint32_t i = 0;
+
+#ifdef AUDIO_MIXER_SSE
+	if (simdEnabled) {
+		const __m128 gain = _mm_setr_ps(gainL, gainR, gainL, gainR);
+		for (; i + 2 <= frames; i += 2) {
+			float* out = mix + i * 2;
+			_mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), _mm_mul_ps(_mm_loadu_ps(src + i * 2), gain)));
+		}
+	}
+#endif
+
+	// 残り (SIMDが使えない環境では全部)
+	for (; i < frames; ++i) {
+		mix[i * 2] += src[i * 2] * gainL;
+		mix[i * 2 + 1] += src[i * 2 + 1] * gainR;
+	}
+}
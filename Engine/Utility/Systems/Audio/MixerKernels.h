@@ -0,0 +1,40 @@
+#pragma once
+
+// C++
+#include <cstdint>
+
+/// <summary>
+/// AudioMixer の中で使う計算 (SIMDが使える環境では4サンプルずつまとめて計算する)
+/// 出力はステレオ (L, R の交互) の float
+/// </summary>
+namespace MixerKernels {
+
+	/// <summary>
+	/// SIMDを使うか (比較用に切り替えられる。使えない環境では常に使わない)
+	/// </summary>
+	void SetSimdEnabled(bool enable);
+	bool IsSimdEnabled();
+
+	/// <summary>
+	/// 16bit PCM を float (-1.0f ～ 1.0f) にする
+	/// </summary>
+	void ConvertPcm16(const int16_t* src, float* dst, uint32_t count);
+
+	/// <summary>
+	/// 線形補間で間引き・水増しする
+	/// </summary>
+	/// <param name="src">元の波形 (frames 分の出力に必要な分 + 1 サンプルあること)</param>
+	/// <param name="position">src の先頭からの位置 (32.32 の固定小数)</param>
+	/// <param name="step">出力1サンプルごとに進む量 (32.32 の固定小数)</param>
+	void ResampleLinear(const float* src, uint32_t channels, uint64_t position, uint64_t step, float* dst, uint32_t frames);
+
+	/// <summary>
+	/// モノラルを左右の音量を掛けてステレオに足し込む
+	/// </summary>
+	void MixMonoToStereo(const float* src, float* mix, uint32_t frames, float gainL, float gainR);
+
+	/// <summary>
+	/// ステレオを左右の音量を掛けて足し込む
+	/// </summary>
+	void MixStereoToStereo(const float* src, float* mix, uint32_t frames, float gainL, float gainR);
+}
@@ -0,0 +1,109 @@
+#include "NullAudioBackend.h"
+
+/// <summary>
+/// ボイスの作成
+/// </summary>
+IAudioBackend::VoiceId NullAudioBackend::CreateVoice(const AudioFormat& format)
+{
+	if (format.channels == 0 || format.sampleRate == 0 || format.blockAlign == 0) {
+		return kInvalidVoice;
+	}
+	const VoiceId id = nextId_++;
+	voices_[id].format = format;
+	++createCount_;
+	return id;
+}
+
+/// <summary>
+/// ボイスの破棄
+/// </summary>
+void NullAudioBackend::DestroyVoice(VoiceId voice)
+{
+	voices_.erase(voice);
+}
+
+/// <summary>
+/// 再生開始
+/// </summary>
+bool NullAudioBackend::Play(VoiceId voice, const uint8_t* data, uint32_t size, bool loop, uint64_t context)
+{
+	auto it = voices_.find(voice);
+	if (it == voices_.end() || !data || size == 0) {
+		return false;
+	}
+	Voice& v = it->second;
+	v.playing = true;
+	v.loop = loop;
+	v.remaining = static_cast<double>(size) / v.format.GetBytesPerSecond();
+	v.context = context;
+	return true;
+}
+
+/// <summary>
+/// 停止
+/// </summary>
+void NullAudioBackend::Stop(VoiceId voice)
+{
+	auto it = voices_.find(voice);
+	if (it != voices_.end()) {
+		it->second.playing = false;
+	}
+}
+
+/// <summary>
+/// 音量
+/// </summary>
+void NullAudioBackend::SetVolume(VoiceId voice, float volume)
+{
+	auto it = voices_.find(voice);
+	if (it != voices_.end()) {
+		it->second.volume = volume;
+	}
+}
+
+/// <summary>
+/// 再生し終えたボイスを渡す
+/// </summary>
+void NullAudioBackend::CollectFinished(std::vector<Finished>& outFinished)
+{
+	outFinished.insert(outFinished.end(), finished_.begin(), finished_.end());
+	finished_.clear();
+}
+
+/// <summary>
+/// 時間を進める
+/// </summary>
+void NullAudioBackend::Advance(double seconds)
+{
+	for (auto& [id, voice] : voices_) {
+		if (!voice.playing || voice.loop) {
+			continue;
+		}
+		voice.remaining -= seconds;
+		if (voice.remaining <= 0.0) {
+			voice.playing = false;
+			finished_.push_back({ id, voice.context });
+		}
+	}
+}
+
+/// <summary>
+/// 再生中のボイス数
+/// </summary>
+uint32_t NullAudioBackend::GetPlayingCount() const
+{
+	uint32_t count = 0;
+	for (const auto& [id, voice] : voices_) {
+		count += voice.playing ? 1u : 0u;
+	}
+	return count;
+}
+
+/// <summary>
+/// ボイスの音量
+/// </summary>
+float NullAudioBackend::GetVolume(VoiceId voice) const
+{
+	auto it = voices_.find(voice);
+	return it != voices_.end() ? it->second.volume : 0.0f;
+}
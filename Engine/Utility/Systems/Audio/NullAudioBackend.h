@@ -0,0 +1,47 @@
+#pragma once
+
+// C++
+#include <unordered_map>
+
+// Engine
+#include "AudioBackend.h"
+
+/// <summary>
+/// 何も鳴らさない再生先 (テストやサーバー用)
+/// 波形の長さだけ時間を進めると再生し終えた扱いにする
+/// </summary>
+class NullAudioBackend : public IAudioBackend
+{
+public:
+	VoiceId CreateVoice(const AudioFormat& format) override;
+	void DestroyVoice(VoiceId voice) override;
+	bool Play(VoiceId voice, const uint8_t* data, uint32_t size, bool loop, uint64_t context) override;
+	void Stop(VoiceId voice) override;
+	void SetVolume(VoiceId voice, float volume) override;
+	void CollectFinished(std::vector<Finished>& outFinished) override;
+
+	/// <summary>
+	/// 時間を進める (再生し終えたボイスを通知に積む)
+	/// </summary>
+	void Advance(double seconds);
+
+	uint32_t GetVoiceCount() const { return static_cast<uint32_t>(voices_.size()); }
+	uint32_t GetPlayingCount() const;
+	uint32_t GetCreateCount() const { return createCount_; }
+	float GetVolume(VoiceId voice) const;
+
+private:
+	struct Voice {
+		AudioFormat format;
+		bool playing = false;
+		bool loop = false;
+		double remaining = 0.0;	// 残りの再生時間 (秒)
+		float volume = 1.0f;
+		uint64_t context = 0;
+	};
+
+	std::unordered_map<VoiceId, Voice> voices_;
+	std::vector<Finished> finished_;
+	VoiceId nextId_ = 1;
+	uint32_t createCount_ = 0;
+};
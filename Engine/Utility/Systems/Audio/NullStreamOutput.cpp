@@ -0,0 +1,148 @@
+#include "NullStreamOutput.h"
+
+// C++
+#include <algorithm>
+
+/// <summary>
+/// 開く
+/// </summary>
+bool NullStreamOutput::Open(const AudioFormat& format)
+{
+	if (format.channels == 0 || format.sampleRate == 0 || format.blockAlign == 0) {
+		return false;
+	}
+	std::lock_guard<std::mutex> lock(mutex_);
+	format_ = format;
+	queue_.clear();
+	started_ = false;
+	pendingBytes_ = 0.0;
+	return true;
+}
+
+/// <summary>
+/// 閉じる
+/// </summary>
+void NullStreamOutput::Close()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	queue_.clear();
+	started_ = false;
+}
+
+/// <summary>
+/// バッファを積む
+/// </summary>
+bool NullStreamOutput::Submit(const uint8_t* data, uint32_t size)
+{
+	if (!data || size == 0) {
+		return false;
+	}
+	std::lock_guard<std::mutex> lock(mutex_);
+	queue_.push_back({ data, size, 0 });
+	return true;
+}
+
+uint32_t NullStreamOutput::GetQueuedCount() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return static_cast<uint32_t>(queue_.size());
+}
+
+void NullStreamOutput::Start()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	started_ = true;
+}
+
+void NullStreamOutput::Pause()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	started_ = false;
+}
+
+void NullStreamOutput::Stop()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	started_ = false;
+	queue_.clear();
+	pendingBytes_ = 0.0;
+}
+
+void NullStreamOutput::SetVolume(float volume)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	volume_ = volume;
+}
+
+/// <summary>
+/// 時間を進める
+/// </summary>
+void NullStreamOutput::Advance(double seconds)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (!started_) {
+		return;
+	}
+
+	// サンプルの切れ目まで読み進め、端数は次へ持ち越す
+	pendingBytes_ += seconds * format_.GetBytesPerSecond();
+	uint64_t bytes = static_cast<uint64_t>(pendingBytes_ / format_.blockAlign) * format_.blockAlign;
+	pendingBytes_ -= static_cast<double>(bytes);
+
+	while (bytes > 0) {
+		if (queue_.empty()) {
+			++starvedCount_;
+			pendingBytes_ = 0.0;
+			break;
+		}
+		Buffer& buffer = queue_.front();
+		const uint32_t count = static_cast<uint32_t>((std::min)(bytes, uint64_t(buffer.size - buffer.read)));
+		if (capture_) {
+			captured_.insert(captured_.end(), buffer.data + buffer.read, buffer.data + buffer.read + count);
+		}
+		buffer.read += count;
+		playedBytes_ += count;
+		bytes -= count;
+		if (buffer.read == buffer.size) {
+			queue_.pop_front();
+		}
+	}
+}
+
+void NullStreamOutput::SetCapture(bool enable)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	capture_ = enable;
+}
+
+std::vector<uint8_t> NullStreamOutput::TakeCaptured()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	std::vector<uint8_t> result = std::move(captured_);
+	captured_.clear();
+	return result;
+}
+
+bool NullStreamOutput::IsStarted() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return started_;
+}
+
+uint64_t NullStreamOutput::GetPlayedBytes() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return playedBytes_;
+}
+
+uint32_t NullStreamOutput::GetStarvedCount() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return starvedCount_;
+}
+
+float NullStreamOutput::GetVolume() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return volume_;
+}
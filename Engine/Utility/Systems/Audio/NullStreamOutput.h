@@ -0,0 +1,65 @@
+#pragma once
+
+// C++
+#include <deque>
+#include <mutex>
+#include <vector>
+
+// Engine
+#include "StreamOutput.h"
+
+/// <summary>
+/// 何も鳴らさないストリーミングの出力先 (テストやサーバー用)
+/// Advance で進めた時間の分だけ積んだバッファを読み進める、読んだPCMは取っておくこともできる
+/// </summary>
+class NullStreamOutput : public IStreamOutput
+{
+public:
+	bool Open(const AudioFormat& format) override;
+	void Close() override;
+	bool Submit(const uint8_t* data, uint32_t size) override;
+	uint32_t GetQueuedCount() const override;
+	void Start() override;
+	void Pause() override;
+	void Stop() override;
+	void SetVolume(float volume) override;
+
+	/// <summary>
+	/// 時間を進める (再生中なら積んだバッファを読み進める)
+	/// </summary>
+	void Advance(double seconds);
+
+	/// <summary>
+	/// 読んだPCMを取っておくか
+	/// </summary>
+	void SetCapture(bool enable);
+
+	/// <summary>
+	/// 取っておいたPCMを受け取る (受け取った分は消える)
+	/// </summary>
+	std::vector<uint8_t> TakeCaptured();
+
+	bool IsStarted() const;
+	uint64_t GetPlayedBytes() const;
+	uint32_t GetStarvedCount() const;
+	float GetVolume() const;
+
+private:
+	// 積まれたバッファ
+	struct Buffer {
+		const uint8_t* data = nullptr;
+		uint32_t size = 0;
+		uint32_t read = 0;	// 読んだバイト数
+	};
+
+	mutable std::mutex mutex_;
+	AudioFormat format_;
+	std::deque<Buffer> queue_;
+	bool started_ = false;
+	float volume_ = 1.0f;
+	double pendingBytes_ = 0.0;		// 1サンプルに満たない端数の時間 (バイト換算)
+	uint64_t playedBytes_ = 0;
+	uint32_t starvedCount_ = 0;		// 再生中に読むものが無かった回数
+	bool capture_ = false;
+	std::vector<uint8_t> captured_;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+// C++
+#include <cstdint>
+
+// Engine
+#include "AudioBackend.h"
+
+/// <summary>
+/// ストリーミング再生の出力先 (積んだバッファを順に鳴らす)
+/// AudioStream のデコード用スレッドから呼ばれるので、実装はスレッドセーフにする
+/// </summary>
+class IStreamOutput
+{
+public:
+	virtual ~IStreamOutput() = default;
+
+	/// <summary>
+	/// 形式を決めて開く
+	/// </summary>
+	virtual bool Open(const AudioFormat& format) = 0;
+
+	/// <summary>
+	/// 閉じる
+	/// </summary>
+	virtual void Close() = 0;
+
+	/// <summary>
+	/// バッファを再生待ちの列に積む (data は再生し終えるまで有効であること)
+	/// </summary>
+	virtual bool Submit(const uint8_t* data, uint32_t size) = 0;
+
+	/// <summary>
+	/// まだ再生し終えていないバッファの数 (積んだ順に終わる)
+	/// </summary>
+	virtual uint32_t GetQueuedCount() const = 0;
+
+	/// <summary>
+	/// 再生開始 (一時停止からの再開も)
+	/// </summary>
+	virtual void Start() = 0;
+
+	/// <summary>
+	/// 一時停止 (積んだバッファは残る)
+	/// </summary>
+	virtual void Pause() = 0;
+
+	/// <summary>
+	/// 止めて積んだバッファを捨てる (戻った後は積んだバッファをもう読まない)
+	/// </summary>
+	virtual void Stop() = 0;
+
+	/// <summary>
+	/// 音量 (0.0f ～ 1.0f)
+	/// </summary>
+	virtual void SetVolume(float volume) = 0;
+};
@@ -0,0 +1,342 @@
+#include "VoicePool.h"
+
+// C++
+#include <algorithm>
+#include <cassert>
+
+namespace {
+	// ハンドルの組み立て
+	VoicePool::Handle MakeHandle(uint32_t index, uint32_t generation)
+	{
+		return uint64_t(generation) << 32 | (uint64_t(index) + 1);
+	}
+}
+
+/// <summary>
+/// 初期化
+/// </summary>
+void VoicePool::Initialize(IAudioBackend* backend, uint32_t maxVoices)
+{
+	assert(backend);
+	Finalize();
+	backend_ = backend;
+	maxVoices_ = (std::max)(maxVoices, 1u);
+	voices_.reserve(maxVoices_);
+}
+
+/// <summary>
+/// 終了処理
+/// </summary>
+void VoicePool::Finalize()
+{
+	if (backend_) {
+		for (Voice& voice : voices_) {
+			backend_->DestroyVoice(voice.id);
+		}
+	}
+	voices_.clear();
+	idleVoices_.clear();
+	std::fill(std::begin(categoryCounts_), std::end(categoryCounts_), 0u);
+	finished_.clear();
+	backend_ = nullptr;
+}
+
+/// <summary>
+/// 再生し終えたボイスを戻す
+/// </summary>
+void VoicePool::Update()
+{
+	if (!backend_) {
+		return;
+	}
+
+	finished_.clear();
+	backend_->CollectFinished(finished_);
+	for (const IAudioBackend::Finished& finished : finished_) {
+		// 止めた後や奪われた後に届いた古い通知は無視する
+		const int32_t index = FindActive(finished.context);
+		if (index >= 0 && voices_[index].id == finished.voice) {
+			StopVoice(static_cast<uint32_t>(index));
+		}
+	}
+}
+
+/// <summary>
+/// カテゴリの同時再生数の上限
+/// </summary>
+void VoicePool::SetCategoryLimit(uint32_t category, uint32_t maxConcurrent)
+{
+	assert(category < kMaxCategories);
+	categoryLimits_[category] = maxConcurrent;
+}
+
+/// <summary>
+/// 再生
+/// </summary>
+VoicePool::Handle VoicePool::Play(const AudioFormat& format, const uint8_t* data, uint32_t size, const PlayParams& params)
+{
+	assert(params.category < kMaxCategories);
+	if (!backend_ || !data || size == 0) {
+		return kInvalidHandle;
+	}
+
+	// カテゴリの上限に達していれば、同じカテゴリから奪う
+	const uint32_t limit = categoryLimits_[params.category];
+	if (limit > 0 && categoryCounts_[params.category] >= limit) {
+		const int32_t victim = SelectVictim(params.category, params.priority);
+		if (victim < 0) {
+			++stats_.rejected;
+			return kInvalidHandle;
+		}
+		StopVoice(static_cast<uint32_t>(victim));
+		++stats_.stolen;
+	}
+
+	const int32_t index = AcquireVoice(format, params.priority);
+	if (index < 0) {
+		++stats_.rejected;
+		return kInvalidHandle;
+	}
+
+	Voice& voice = voices_[index];
+	voice.active = true;
+	voice.category = params.category;
+	voice.priority = params.priority;
+	voice.startOrder = nextStartOrder_++;
+	voice.data = data;
+	voice.size = size;
+	++voice.generation;
+	++categoryCounts_[params.category];
+
+	const Handle handle = MakeHandle(static_cast<uint32_t>(index), voice.generation);
+	backend_->SetVolume(voice.id, params.volume);
+	if (!backend_->Play(voice.id, data, size, params.loop, handle)) {
+		StopVoice(static_cast<uint32_t>(index));
+		++stats_.rejected;
+		return kInvalidHandle;
+	}
+	return handle;
+}
+
+/// <summary>
+/// 停止
+/// </summary>
+void VoicePool::Stop(Handle handle)
+{
+	const int32_t index = FindActive(handle);
+	if (index >= 0) {
+		StopVoice(static_cast<uint32_t>(index));
+	}
+}
+
+void VoicePool::StopCategory(uint32_t category)
+{
+	for (uint32_t i = 0; i < voices_.size(); ++i) {
+		if (voices_[i].active && voices_[i].category == category) {
+			StopVoice(i);
+		}
+	}
+}
+
+void VoicePool::StopAll()
+{
+	for (uint32_t i = 0; i < voices_.size(); ++i) {
+		if (voices_[i].active) {
+			StopVoice(i);
+		}
+	}
+}
+
+void VoicePool::StopBuffer(const uint8_t* data, uint32_t size)
+{
+	if (!data || size == 0) {
+		return;
+	}
+	const uint8_t* end = data + size;
+	for (uint32_t i = 0; i < voices_.size(); ++i) {
+		const Voice& voice = voices_[i];
+		// 範囲が重なっていれば同じ波形を読んでいる
+		if (voice.active && voice.data < end && data < voice.data + voice.size) {
+			StopVoice(i);
+		}
+	}
+}
+
+/// <summary>
+/// 音量
+/// </summary>
+void VoicePool::SetVolume(Handle handle, float volume)
+{
+	const int32_t index = FindActive(handle);
+	if (index >= 0) {
+		backend_->SetVolume(voices_[index].id, volume);
+	}
+}
+
+/// <summary>
+/// まだ再生中か
+/// </summary>
+bool VoicePool::IsPlaying(Handle handle) const
+{
+	return FindActive(handle) >= 0;
+}
+
+/// <summary>
+/// 再生先でのボイスの識別子
+/// </summary>
+IAudioBackend::VoiceId VoicePool::GetVoiceId(Handle handle) const
+{
+	const int32_t index = FindActive(handle);
+	return index >= 0 ? voices_[index].id : IAudioBackend::kInvalidVoice;
+}
+
+uint32_t VoicePool::GetActiveCount() const
+{
+	uint32_t count = 0;
+	for (uint32_t category = 0; category < kMaxCategories; ++category) {
+		count += categoryCounts_[category];
+	}
+	return count;
+}
+
+uint32_t VoicePool::GetActiveCount(uint32_t category) const
+{
+	return category < kMaxCategories ? categoryCounts_[category] : 0;
+}
+
+/// <summary>
+/// ハンドルから再生中のボイスを探す
+/// </summary>
+int32_t VoicePool::FindActive(Handle handle) const
+{
+	const uint64_t slot = handle & 0xffffffffull;
+	if (slot == 0 || slot > voices_.size()) {
+		return -1;
+	}
+	const uint32_t index = static_cast<uint32_t>(slot - 1);
+	const Voice& voice = voices_[index];
+	if (!voice.active || voice.generation != static_cast<uint32_t>(handle >> 32)) {
+		return -1;
+	}
+	return static_cast<int32_t>(index);
+}
+
+/// <summary>
+/// 形式に合うボイスを用意する
+/// </summary>
+int32_t VoicePool::AcquireVoice(const AudioFormat& format, int32_t priority)
+{
+	// 1. 同じ形式の空きを使い回す
+	auto it = idleVoices_.find(format.GetKey());
+	if (it != idleVoices_.end() && !it->second.empty()) {
+		const uint32_t index = it->second.back();
+		it->second.pop_back();
+		++stats_.reused;
+		return static_cast<int32_t>(index);
+	}
+
+	// 2. 上限まではボイスを作る
+	if (voices_.size() < maxVoices_) {
+		Voice voice;
+		voice.id = backend_->CreateVoice(format);
+		if (voice.id == IAudioBackend::kInvalidVoice) {
+			return -1;
+		}
+		voice.format = format;
+		voices_.push_back(voice);
+		++stats_.created;
+		return static_cast<int32_t>(voices_.size() - 1);
+	}
+
+	// 3. 別の形式の空きを作り直す
+	for (auto& [key, indices] : idleVoices_) {
+		if (indices.empty()) {
+			continue;
+		}
+		const uint32_t index = indices.back();
+		indices.pop_back();
+		return RecreateVoice(index, format) ? static_cast<int32_t>(index) : -1;
+	}
+
+	// 4. 全て再生中なら、優先度が低く古い音を奪う
+	const int32_t victim = SelectVictim(kAnyCategory, priority);
+	if (victim < 0) {
+		return -1;
+	}
+	const uint32_t index = static_cast<uint32_t>(victim);
+	StopVoice(index);
+	RemoveIdle(index);
+	++stats_.stolen;
+	if (voices_[index].format == format) {
+		return victim;
+	}
+	return RecreateVoice(index, format) ? victim : -1;
+}
+
+/// <summary>
+/// 奪う音を選ぶ
+/// </summary>
+int32_t VoicePool::SelectVictim(uint32_t category, int32_t priority) const
+{
+	int32_t victim = -1;
+	for (uint32_t i = 0; i < voices_.size(); ++i) {
+		const Voice& voice = voices_[i];
+		if (!voice.active || voice.priority > priority || (category != kAnyCategory && voice.category != category)) {
+			continue;
+		}
+		if (victim < 0) {
+			victim = static_cast<int32_t>(i);
+			continue;
+		}
+		const Voice& best = voices_[victim];
+		if (voice.priority < best.priority || (voice.priority == best.priority && voice.startOrder < best.startOrder)) {
+			victim = static_cast<int32_t>(i);
+		}
+	}
+	return victim;
+}
+
+/// <summary>
+/// ボイスを止めてプールへ戻す
+/// </summary>
+void VoicePool::StopVoice(uint32_t index)
+{
+	Voice& voice = voices_[index];
+	if (!voice.active) {
+		return;
+	}
+	backend_->Stop(voice.id);
+	voice.active = false;
+	voice.data = nullptr;
+	voice.size = 0;
+	--categoryCounts_[voice.category];
+	idleVoices_[voice.format.GetKey()].push_back(index);
+}
+
+/// <summary>
+/// 空いているボイスを別の形式で作り直す
+/// </summary>
+bool VoicePool::RecreateVoice(uint32_t index, const AudioFormat& format)
+{
+	Voice& voice = voices_[index];
+	backend_->DestroyVoice(voice.id);
+	++stats_.destroyed;
+
+	voice.id = backend_->CreateVoice(format);
+	voice.format = format;
+	if (voice.id == IAudioBackend::kInvalidVoice) {
+		// 作れなかったスロットは使わない (空きにも戻さない)
+		return false;
+	}
+	++stats_.created;
+	return true;
+}
+
+/// <summary>
+/// 空きリストから取り除く
+/// </summary>
+void VoicePool::RemoveIdle(uint32_t index)
+{
+	std::vector<uint32_t>& indices = idleVoices_[voices_[index].format.GetKey()];
+	indices.erase(std::remove(indices.begin(), indices.end(), index), indices.end());
+}
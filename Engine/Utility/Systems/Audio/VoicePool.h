@@ -0,0 +1,175 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Engine
+#include "AudioBackend.h"
+
+/// <summary>
+/// 効果音などの再生に使うボイスのプール
+/// ボイスは形式ごとに使い回し、再生し終えたら Update で戻す
+/// 種類 (カテゴリ) ごとの同時再生数と全体のボイス数を超える時は、優先度が低く古い音から奪う
+/// 再生先は IAudioBackend 経由なので、NullAudioBackend でも同じように動く
+/// </summary>
+class VoicePool
+{
+public: // 型・定数
+
+	// 再生の識別子 (上位32bitが世代、下位32bitがスロット番号+1。再生し終えた後の古いハンドルは無視される)
+	using Handle = uint64_t;
+	static constexpr Handle kInvalidHandle = 0;
+
+	// カテゴリの数
+	static constexpr uint32_t kMaxCategories = 8;
+	// 作るボイス数の上限の既定値
+	static constexpr uint32_t kDefaultMaxVoices = 64;
+
+	// 再生の設定
+	struct PlayParams {
+		uint32_t category = 0;
+		int32_t priority = 0;	// 大きいほど奪われにくい (同じ優先度なら新しい音が古い音を奪う)
+		float volume = 1.0f;
+		bool loop = false;		// 止めるまで繰り返す
+	};
+
+	// 統計 (累計)
+	struct Stats {
+		uint64_t created = 0;	// ボイスを作った回数
+		uint64_t reused = 0;	// 空いているボイスを使い回した回数
+		uint64_t stolen = 0;	// 再生中の音を奪った回数
+		uint64_t rejected = 0;	// 奪える音が無く鳴らさなかった回数
+		uint64_t destroyed = 0;	// 形式が合わず壊して作り直した回数
+	};
+
+public: // メンバ関数
+
+	VoicePool() = default;
+	~VoicePool() = default;
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="maxVoices">作るボイス数の上限 (全カテゴリ合計)</param>
+	void Initialize(IAudioBackend* backend, uint32_t maxVoices = kDefaultMaxVoices);
+
+	/// <summary>
+	/// 終了処理 (全ボイスを破棄する)
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// 再生し終えたボイスをプールへ戻す (毎フレーム呼ぶ)
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// カテゴリの同時再生数の上限 (0は上限なし)
+	/// </summary>
+	void SetCategoryLimit(uint32_t category, uint32_t maxConcurrent);
+
+	/// <summary>
+	/// 再生 (鳴らせなければ kInvalidHandle)
+	/// </summary>
+	/// <param name="data">波形 (再生し終えるまで有効であること)</param>
+	Handle Play(const AudioFormat& format, const uint8_t* data, uint32_t size, const PlayParams& params);
+	Handle Play(const AudioFormat& format, const uint8_t* data, uint32_t size) { return Play(format, data, size, PlayParams{}); }
+
+	/// <summary>
+	/// 停止 (ボイスはすぐプールへ戻る)
+	/// </summary>
+	void Stop(Handle handle);
+	void StopCategory(uint32_t category);
+	void StopAll();
+
+	/// <summary>
+	/// 波形の範囲 [data, data + size) を読んでいるボイスを止める (波形を手放す前に呼ぶ)
+	/// </summary>
+	void StopBuffer(const uint8_t* data, uint32_t size);
+
+	/// <summary>
+	/// 音量 (0.0f ～ 1.0f)
+	/// </summary>
+	void SetVolume(Handle handle, float volume);
+
+	/// <summary>
+	/// まだ再生中か
+	/// </summary>
+	bool IsPlaying(Handle handle) const;
+
+	/// <summary>
+	/// 再生先でのボイスの識別子 (再生先の機能を直接使う時用。再生し終えていれば kInvalidVoice)
+	/// </summary>
+	IAudioBackend::VoiceId GetVoiceId(Handle handle) const;
+
+	uint32_t GetActiveCount() const;
+	uint32_t GetActiveCount(uint32_t category) const;
+	uint32_t GetVoiceCount() const { return static_cast<uint32_t>(voices_.size()); }
+	const Stats& GetStats() const { return stats_; }
+
+private:
+
+	// プールの1ボイス
+	struct Voice {
+		IAudioBackend::VoiceId id = IAudioBackend::kInvalidVoice;
+		AudioFormat format;
+		bool active = false;
+		uint32_t category = 0;
+		int32_t priority = 0;
+		uint64_t startOrder = 0;	// 再生を始めた順番 (奪う時は古い方から)
+		uint32_t generation = 0;
+		const uint8_t* data = nullptr;	// 再生中の波形 (StopBuffer で探す)
+		uint32_t size = 0;
+	};
+
+	// カテゴリを問わず奪う時の指定
+	static constexpr uint32_t kAnyCategory = UINT32_MAX;
+
+	/// <summary>
+	/// ハンドルから再生中のボイスを探す (古いハンドルなら -1)
+	/// </summary>
+	int32_t FindActive(Handle handle) const;
+
+	/// <summary>
+	/// 形式に合うボイスを用意する (用意できなければ -1)
+	/// </summary>
+	int32_t AcquireVoice(const AudioFormat& format, int32_t priority);
+
+	/// <summary>
+	/// 奪う音を選ぶ (priority 以下で一番優先度が低く、古いもの。無ければ -1)
+	/// </summary>
+	int32_t SelectVictim(uint32_t category, int32_t priority) const;
+
+	/// <summary>
+	/// ボイスを止めてプールへ戻す
+	/// </summary>
+	void StopVoice(uint32_t index);
+
+	/// <summary>
+	/// 空いているボイスを別の形式で作り直す
+	/// </summary>
+	bool RecreateVoice(uint32_t index, const AudioFormat& format);
+
+	/// <summary>
+	/// 空きリストから取り除く
+	/// </summary>
+	void RemoveIdle(uint32_t index);
+
+private: // メンバ変数
+
+	IAudioBackend* backend_ = nullptr;
+	uint32_t maxVoices_ = kDefaultMaxVoices;
+
+	std::vector<Voice> voices_;
+	// 形式のキー → 空いているボイスの番号
+	std::unordered_map<uint64_t, std::vector<uint32_t>> idleVoices_;
+
+	uint32_t categoryLimits_[kMaxCategories] = {};
+	uint32_t categoryCounts_[kMaxCategories] = {};
+
+	uint64_t nextStartOrder_ = 1;
+	std::vector<IAudioBackend::Finished> finished_;
+	Stats stats_;
+};
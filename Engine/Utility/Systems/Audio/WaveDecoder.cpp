@@ -0,0 +1,70 @@
+#include "WaveDecoder.h"
+
+// C++
+#include <algorithm>
+#include <cstring>
+
+// Engine
+#include "WaveParser.h"
+
+/// <summary>
+/// FileSystem から開く
+/// </summary>
+bool WaveDecoder::Open(const std::string& filePath)
+{
+	FileSystem::FileView file = FileSystem::GetInstance()->Open(filePath);
+	if (!file.IsValid() || !Open(file.GetData(), file.GetSize())) {
+		return false;
+	}
+	file_ = std::move(file);
+	return true;
+}
+
+/// <summary>
+/// メモリ上のWAVを開く
+/// </summary>
+bool WaveDecoder::Open(const uint8_t* data, size_t size)
+{
+	file_ = {};
+	samples_ = nullptr;
+	totalSamples_ = 0;
+	position_ = 0;
+
+	// 鳴らせるのは PCM と 32bit float だけ
+	WaveParser::WaveView wave;
+	if (WaveParser::Parse(data, size, wave) != WaveParser::Error::kNone ||
+		(wave.format.formatTag == 3 && wave.format.bitsPerSample != 32)) {
+		return false;
+	}
+	format_ = wave.format;
+	samples_ = wave.data;
+	totalSamples_ = wave.sampleCount;
+	return true;
+}
+
+/// <summary>
+/// PCMを取り出す
+/// </summary>
+uint32_t WaveDecoder::Read(uint8_t* dst, uint32_t size)
+{
+	if (!samples_ || position_ >= totalSamples_) {
+		return 0;
+	}
+	const uint64_t count = (std::min)(uint64_t(size / format_.blockAlign), totalSamples_ - position_);
+	const uint32_t bytes = static_cast<uint32_t>(count * format_.blockAlign);
+	std::memcpy(dst, samples_ + position_ * format_.blockAlign, bytes);
+	position_ += count;
+	return bytes;
+}
+
+/// <summary>
+/// 指定のサンプルへ移動
+/// </summary>
+bool WaveDecoder::Seek(uint64_t sample)
+{
+	if (!samples_ || sample > totalSamples_) {
+		return false;
+	}
+	position_ = sample;
+	return true;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+// C++
+#include <string>
+
+// Engine
+#include "AudioDecoder.h"
+#include "Loaders/Archive/FileSystem.h"
+
+/// <summary>
+/// WAV (PCM / IEEE float) のデコーダ
+/// マップしたファイルから data チャンクをそのまま切り出すだけなので、デコードの手間は無い
+/// </summary>
+class WaveDecoder : public IAudioDecoder
+{
+public:
+
+	/// <summary>
+	/// FileSystem から開く
+	/// </summary>
+	bool Open(const std::string& filePath);
+
+	/// <summary>
+	/// メモリ上のWAVを開く (data は閉じるまで有効であること)
+	/// </summary>
+	bool Open(const uint8_t* data, size_t size);
+
+	const AudioFormat& GetFormat() const override { return format_; }
+	uint64_t GetTotalSamples() const override { return totalSamples_; }
+	uint32_t Read(uint8_t* dst, uint32_t size) override;
+	bool Seek(uint64_t sample) override;
+
+private:
+
+	// 開いたファイル (FileSystem から開いた時だけ)
+	FileSystem::FileView file_;
+
+	AudioFormat format_;
+	const uint8_t* samples_ = nullptr;	// data チャンクの中身
+	uint64_t totalSamples_ = 0;
+	uint64_t position_ = 0;				// 次に読むサンプル
+};
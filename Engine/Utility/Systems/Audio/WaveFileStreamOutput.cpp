@@ -0,0 +1,130 @@
+#include "WaveFileStreamOutput.h"
+
+// C++
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace {
+	constexpr uint16_t kFormatFloat = 3;
+	// RIFF(12) + fmt(8 + 18) + data(8)
+	constexpr uint32_t kHeaderSize = 46;
+	constexpr uint32_t kRiffSizeOffset = 4;
+	constexpr uint32_t kDataSizeOffset = kHeaderSize - 4;
+
+	void Put16(std::ofstream& file, uint16_t value) { file.write(reinterpret_cast<const char*>(&value), sizeof(value)); }
+	void Put32(std::ofstream& file, uint32_t value) { file.write(reinterpret_cast<const char*>(&value), sizeof(value)); }
+}
+
+WaveFileStreamOutput::~WaveFileStreamOutput()
+{
+	Close();
+}
+
+/// <summary>
+/// ファイルを作ってヘッダを書く (サイズは閉じる時に書き直す)
+/// </summary>
+bool WaveFileStreamOutput::Open(const AudioFormat& format)
+{
+	Close();
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (format.channels == 0 || format.sampleRate == 0 || format.blockAlign == 0) {
+		return false;
+	}
+	file_.open(filePath_, std::ios::binary | std::ios::trunc);
+	if (!file_) {
+		return false;
+	}
+	format_ = format;
+	dataBytes_ = 0;
+
+	file_.write("RIFF", 4);
+	Put32(file_, 0);
+	file_.write("WAVE", 4);
+	file_.write("fmt ", 4);
+	Put32(file_, 18);
+	Put16(file_, format.formatTag);
+	Put16(file_, format.channels);
+	Put32(file_, format.sampleRate);
+	Put32(file_, format.GetBytesPerSecond());
+	Put16(file_, format.blockAlign);
+	Put16(file_, format.bitsPerSample);
+	Put16(file_, 0);
+	file_.write("data", 4);
+	Put32(file_, 0);
+	return static_cast<bool>(file_);
+}
+
+/// <summary>
+/// サイズを書き直して閉じる
+/// </summary>
+void WaveFileStreamOutput::Close()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (!file_.is_open()) {
+		return;
+	}
+	WriteSizes();
+	file_.close();
+}
+
+/// <summary>
+/// その場で書き出す (音量が1でなければ掛けてから)
+/// </summary>
+bool WaveFileStreamOutput::Submit(const uint8_t* data, uint32_t size)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (!file_.is_open() || !data) {
+		return false;
+	}
+	// 4GBを越える分はWAVに書けない
+	size = static_cast<uint32_t>((std::min)(uint64_t(size), uint64_t(UINT32_MAX - kHeaderSize) - dataBytes_));
+
+	if (volume_ == 1.0f) {
+		file_.write(reinterpret_cast<const char*>(data), size);
+	} else if (format_.formatTag == kFormatFloat && format_.bitsPerSample == 32) {
+		std::vector<float> samples(size / sizeof(float));
+		std::memcpy(samples.data(), data, samples.size() * sizeof(float));
+		for (float& sample : samples) {
+			sample *= volume_;
+		}
+		file_.write(reinterpret_cast<const char*>(samples.data()), samples.size() * sizeof(float));
+	} else if (format_.bitsPerSample == 16) {
+		std::vector<int16_t> samples(size / sizeof(int16_t));
+		std::memcpy(samples.data(), data, samples.size() * sizeof(int16_t));
+		for (int16_t& sample : samples) {
+			sample = static_cast<int16_t>(std::clamp(sample * volume_, -32768.0f, 32767.0f));
+		}
+		file_.write(reinterpret_cast<const char*>(samples.data()), samples.size() * sizeof(int16_t));
+	} else {
+		file_.write(reinterpret_cast<const char*>(data), size);
+	}
+	dataBytes_ += size;
+	return static_cast<bool>(file_);
+}
+
+void WaveFileStreamOutput::SetVolume(float volume)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	volume_ = volume;
+}
+
+uint64_t WaveFileStreamOutput::GetWrittenBytes() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return dataBytes_;
+}
+
+/// <summary>
+/// RIFF と data チャンクのサイズを書き直す
+/// </summary>
+void WaveFileStreamOutput::WriteSizes()
+{
+	const std::streampos end = file_.tellp();
+	file_.seekp(kRiffSizeOffset);
+	Put32(file_, static_cast<uint32_t>(kHeaderSize - 8 + dataBytes_));
+	file_.seekp(kDataSizeOffset);
+	Put32(file_, static_cast<uint32_t>(dataBytes_));
+	file_.seekp(end);
+	file_.flush();
+}
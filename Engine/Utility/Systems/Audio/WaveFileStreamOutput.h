@@ -0,0 +1,44 @@
+#pragma once
+
+// C++
+#include <fstream>
+#include <mutex>
+#include <string>
+
+// Engine
+#include "StreamOutput.h"
+
+/// <summary>
+/// WAVファイルへ書き出すストリーミングの出力先 (ミキサーの確認やサーバーでの録音用)
+/// 積まれたバッファはその場で書き出すので、積んだまま残るバッファは無い
+/// </summary>
+class WaveFileStreamOutput : public IStreamOutput
+{
+public:
+	explicit WaveFileStreamOutput(const std::string& filePath) : filePath_(filePath) {}
+	~WaveFileStreamOutput() override;
+
+	bool Open(const AudioFormat& format) override;
+	void Close() override;
+	bool Submit(const uint8_t* data, uint32_t size) override;
+	uint32_t GetQueuedCount() const override { return 0; }
+	void Start() override {}
+	void Pause() override {}
+	void Stop() override {}
+	void SetVolume(float volume) override;
+
+	uint64_t GetWrittenBytes() const;
+
+private:
+	/// <summary>
+	/// RIFF と data チャンクのサイズを書き直す
+	/// </summary>
+	void WriteSizes();
+
+	std::string filePath_;
+	mutable std::mutex mutex_;
+	std::ofstream file_;
+	AudioFormat format_;
+	uint64_t dataBytes_ = 0;
+	float volume_ = 1.0f;
+};
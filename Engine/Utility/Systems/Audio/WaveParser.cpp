@@ -0,0 +1,163 @@
+#include "WaveParser.h"
+
+// C++
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+	// リトルエンディアンの読み出し
+	uint16_t ReadU16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | p[1] << 8); }
+	uint32_t ReadU32(const uint8_t* p) { return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24; }
+
+	constexpr uint16_t kFormatPCM = 1;
+	constexpr uint16_t kFormatFloat = 3;
+	constexpr uint16_t kFormatExtensible = 0xFFFE;
+
+	constexpr size_t kRiffHeaderSize = 12;
+	constexpr size_t kChunkHeaderSize = 8;
+	// WAVEFORMATEX の cbSize より前
+	constexpr uint32_t kMinFormatSize = 16;
+	// WAVEFORMATEXTENSIBLE の大きさと、その中の SubFormat の位置
+	constexpr uint32_t kExtensibleFormatSize = 40;
+	constexpr size_t kSubFormatOffset = 24;
+
+	// KSDATAFORMAT_SUBTYPE_PCM などの SubFormat の先頭2バイト以外 ({xxxxxxxx-0000-0010-8000-00aa00389b71})
+	constexpr uint8_t kSubFormatTail[14] = { 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71 };
+
+	/// <summary>
+	/// fmt チャンクの読み取り
+	/// </summary>
+	WaveParser::Error ParseFormat(const uint8_t* fmt, uint32_t size, AudioFormat& outFormat)
+	{
+		if (size < kMinFormatSize) {
+			return WaveParser::Error::kBadFormatChunk;
+		}
+		outFormat.formatTag = ReadU16(fmt);
+		outFormat.channels = ReadU16(fmt + 2);
+		outFormat.sampleRate = ReadU32(fmt + 4);
+		outFormat.blockAlign = ReadU16(fmt + 12);
+		outFormat.bitsPerSample = ReadU16(fmt + 14);
+
+		// WAVE_FORMAT_EXTENSIBLE は SubFormat の先頭が本当の形式
+		if (outFormat.formatTag == kFormatExtensible) {
+			if (size < kExtensibleFormatSize) {
+				return WaveParser::Error::kBadFormatChunk;
+			}
+			const uint8_t* subFormat = fmt + kSubFormatOffset;
+			if (std::memcmp(subFormat + 2, kSubFormatTail, sizeof(kSubFormatTail)) != 0) {
+				return WaveParser::Error::kUnsupportedFormat;
+			}
+			outFormat.formatTag = ReadU16(subFormat);
+		}
+
+		if (outFormat.channels == 0 || outFormat.sampleRate == 0 || outFormat.bitsPerSample == 0 ||
+			outFormat.bitsPerSample % 8 != 0 || outFormat.blockAlign != outFormat.channels * (outFormat.bitsPerSample / 8)) {
+			return WaveParser::Error::kBadFormatChunk;
+		}
+		const bool pcm = outFormat.formatTag == kFormatPCM && outFormat.bitsPerSample <= 32;
+		const bool ieeeFloat = outFormat.formatTag == kFormatFloat && (outFormat.bitsPerSample == 32 || outFormat.bitsPerSample == 64);
+		if (!pcm && !ieeeFloat) {
+			return WaveParser::Error::kUnsupportedFormat;
+		}
+		return WaveParser::Error::kNone;
+	}
+}
+
+/// <summary>
+/// 読み取る
+/// </summary>
+WaveParser::Error WaveParser::Parse(const uint8_t* file, size_t fileSize, WaveView& outView)
+{
+	outView = {};
+	if (!file || fileSize < kRiffHeaderSize) {
+		return Error::kTooSmall;
+	}
+	if (std::memcmp(file, "RIFF", 4) != 0) {
+		return Error::kNotRiff;
+	}
+	if (std::memcmp(file + 8, "WAVE", 4) != 0) {
+		return Error::kNotWave;
+	}
+
+	// RIFF のサイズは書き出し途中のファイルだと当てにならないので、ファイルの大きさで区切る
+	const uint8_t* fmt = nullptr;
+	uint32_t fmtSize = 0;
+	const uint8_t* data = nullptr;
+	size_t dataSize = 0;
+	bool truncated = false;
+
+	size_t offset = kRiffHeaderSize;
+	while (fileSize - offset >= kChunkHeaderSize) {
+		const uint8_t* chunk = file + offset;
+		const uint32_t chunkSize = ReadU32(chunk + 4);
+		const size_t bodyOffset = offset + kChunkHeaderSize;
+		const size_t available = fileSize - bodyOffset;
+
+		if (std::memcmp(chunk, "data", 4) == 0) {
+			data = file + bodyOffset;
+			// 途中で切れた (またはサイズが未記入の) data は残り全部とみなす
+			if (chunkSize > available) {
+				dataSize = available;
+				truncated = true;
+			} else {
+				dataSize = chunkSize;
+			}
+		} else {
+			if (chunkSize > available) {
+				return Error::kBadChunk;
+			}
+			if (std::memcmp(chunk, "fmt ", 4) == 0 && !fmt) {
+				fmt = file + bodyOffset;
+				fmtSize = chunkSize;
+			}
+		}
+
+		// 奇数サイズのチャンクの後には詰め物が1バイトある
+		const size_t next = bodyOffset + (std::min)(size_t(chunkSize), available) + (chunkSize & 1);
+		if (next > fileSize || (data && fmt)) {
+			break;
+		}
+		offset = next;
+	}
+
+	if (!fmt) {
+		return Error::kMissingFormat;
+	}
+	const Error formatError = ParseFormat(fmt, fmtSize, outView.format);
+	if (formatError != Error::kNone) {
+		outView = {};
+		return formatError;
+	}
+	if (!data) {
+		outView = {};
+		return Error::kMissingData;
+	}
+
+	// 4GB を越える data は扱わない (WAV のサイズは32bit)
+	const size_t usable = (std::min)(dataSize, size_t(UINT32_MAX));
+	outView.sampleCount = static_cast<uint32_t>(usable / outView.format.blockAlign);
+	outView.size = outView.sampleCount * outView.format.blockAlign;
+	outView.data = data;
+	outView.truncated = truncated || outView.size != dataSize;
+	return Error::kNone;
+}
+
+/// <summary>
+/// エラーの説明
+/// </summary>
+const char* WaveParser::ToString(Error error)
+{
+	switch (error) {
+	case Error::kNone: return "ok";
+	case Error::kTooSmall: return "file is smaller than a RIFF header";
+	case Error::kNotRiff: return "not a RIFF file";
+	case Error::kNotWave: return "RIFF type is not WAVE";
+	case Error::kBadChunk: return "chunk extends past end of file";
+	case Error::kBadFormatChunk: return "malformed fmt chunk";
+	case Error::kMissingFormat: return "fmt chunk not found";
+	case Error::kMissingData: return "data chunk not found";
+	case Error::kUnsupportedFormat: return "unsupported sample format";
+	}
+	return "unknown";
+}
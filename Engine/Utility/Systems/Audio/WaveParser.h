@@ -0,0 +1,51 @@
+#pragma once
+
+// C++
+#include <cstddef>
+#include <cstdint>
+
+// Engine
+#include "AudioBackend.h"
+
+/// <summary>
+/// WAVファイルの読み取り (メモリ上のファイルのチャンクを走査して、形式と波形の場所を返す)
+/// 波形はコピーせず元のメモリを指すので、マップしたファイルやアーカイブからそのまま鳴らせる
+/// </summary>
+namespace WaveParser {
+
+	// 読み取りの結果
+	enum class Error {
+		kNone,
+		kTooSmall,			// RIFFヘッダより小さい
+		kNotRiff,			// "RIFF" で始まらない
+		kNotWave,			// 種類が "WAVE" ではない
+		kBadChunk,			// チャンクのサイズがファイルの外を指す
+		kBadFormatChunk,	// fmt チャンクが短い、または中身がおかしい
+		kMissingFormat,		// fmt チャンクが無い
+		kMissingData,		// data チャンクが無い
+		kUnsupportedFormat,	// PCM / IEEE float 以外
+	};
+
+	/// <summary>
+	/// 波形の場所 (所有しない。元のメモリが有効な間だけ使える)
+	/// </summary>
+	struct WaveView {
+		AudioFormat format;
+		const uint8_t* data = nullptr;	// data チャンクの中身
+		uint32_t size = 0;				// バイト数 (blockAlign の倍数に切り詰める)
+		uint32_t sampleCount = 0;		// サンプル数 (全チャンネル分で1)
+		bool truncated = false;			// data チャンクがファイルの途中で切れていた (ある分だけ使う)
+	};
+
+	/// <summary>
+	/// 読み取る
+	/// 知らないチャンク (LIST, JUNK, fact, bext 等) は飛ばし、奇数サイズの後の詰め物も考慮する
+	/// fmt と data の順番は問わない
+	/// </summary>
+	Error Parse(const uint8_t* file, size_t fileSize, WaveView& outView);
+
+	/// <summary>
+	/// エラーの説明 (ログ用)
+	/// </summary>
+	const char* ToString(Error error);
+}
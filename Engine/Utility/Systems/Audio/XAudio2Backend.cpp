@@ -0,0 +1,125 @@
+#include "XAudio2Backend.h"
+
+// C++
+#include <cassert>
+
+// 再生の識別子をバッファのコンテキスト (ポインタ) にそのまま入れる
+static_assert(sizeof(void*) >= sizeof(uint64_t));
+
+XAudio2Backend::~XAudio2Backend()
+{
+	for (auto& [id, voice] : voices_) {
+		voice.sourceVoice->DestroyVoice();
+	}
+	voices_.clear();
+}
+
+/// <summary>
+/// ソースボイスの作成
+/// </summary>
+IAudioBackend::VoiceId XAudio2Backend::CreateVoice(const AudioFormat& format)
+{
+	WAVEFORMATEX wfex{};
+	wfex.wFormatTag = format.formatTag;
+	wfex.nChannels = format.channels;
+	wfex.nSamplesPerSec = format.sampleRate;
+	wfex.nAvgBytesPerSec = format.GetBytesPerSecond();
+	wfex.nBlockAlign = format.blockAlign;
+	wfex.wBitsPerSample = format.bitsPerSample;
+	wfex.cbSize = 0;
+
+	const VoiceId id = nextId_++;
+	Voice voice;
+	voice.callback = std::make_unique<VoiceCallback>(this, id);
+	HRESULT hr = xAudio2_->CreateSourceVoice(&voice.sourceVoice, &wfex, 0, XAUDIO2_DEFAULT_FREQ_RATIO, voice.callback.get());
+	if (FAILED(hr)) {
+		return kInvalidVoice;
+	}
+	voices_.emplace(id, std::move(voice));
+	return id;
+}
+
+/// <summary>
+/// ソースボイスの破棄 (コールバックが終わるまで待つ)
+/// </summary>
+void XAudio2Backend::DestroyVoice(VoiceId voice)
+{
+	auto it = voices_.find(voice);
+	if (it == voices_.end()) {
+		return;
+	}
+	it->second.sourceVoice->DestroyVoice();
+	voices_.erase(it);
+}
+
+/// <summary>
+/// 再生開始
+/// </summary>
+bool XAudio2Backend::Play(VoiceId voice, const uint8_t* data, uint32_t size, bool loop, uint64_t context)
+{
+	IXAudio2SourceVoice* sourceVoice = FindVoice(voice);
+	if (!sourceVoice) {
+		return false;
+	}
+
+	XAUDIO2_BUFFER buffer{};
+	buffer.pAudioData = data;
+	buffer.AudioBytes = size;
+	buffer.Flags = XAUDIO2_END_OF_STREAM;
+	buffer.LoopCount = loop ? XAUDIO2_LOOP_INFINITE : 0;
+	buffer.pContext = reinterpret_cast<void*>(static_cast<uintptr_t>(context));
+
+	if (FAILED(sourceVoice->SubmitSourceBuffer(&buffer))) {
+		return false;
+	}
+	return SUCCEEDED(sourceVoice->Start());
+}
+
+/// <summary>
+/// 停止 (送ったバッファも捨てる)
+/// </summary>
+void XAudio2Backend::Stop(VoiceId voice)
+{
+	IXAudio2SourceVoice* sourceVoice = FindVoice(voice);
+	if (!sourceVoice) {
+		return;
+	}
+	sourceVoice->Stop();
+	sourceVoice->FlushSourceBuffers();
+}
+
+/// <summary>
+/// 音量
+/// </summary>
+void XAudio2Backend::SetVolume(VoiceId voice, float volume)
+{
+	IXAudio2SourceVoice* sourceVoice = FindVoice(voice);
+	if (sourceVoice) {
+		sourceVoice->SetVolume(volume);
+	}
+}
+
+/// <summary>
+/// 再生し終えたボイスを渡す
+/// </summary>
+void XAudio2Backend::CollectFinished(std::vector<Finished>& outFinished)
+{
+	std::lock_guard<std::mutex> lock(finishedMutex_);
+	outFinished.insert(outFinished.end(), finished_.begin(), finished_.end());
+	finished_.clear();
+}
+
+IXAudio2SourceVoice* XAudio2Backend::FindVoice(VoiceId voice) const
+{
+	auto it = voices_.find(voice);
+	return it != voices_.end() ? it->second.sourceVoice : nullptr;
+}
+
+/// <summary>
+/// バッファを再生し終えた (捨てた時も来るが、プール側で古い通知として無視される)
+/// </summary>
+void XAudio2Backend::VoiceCallback::OnBufferEnd(void* pBufferContext)
+{
+	std::lock_guard<std::mutex> lock(owner_->finishedMutex_);
+	owner_->finished_.push_back({ voice_, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pBufferContext)) });
+}
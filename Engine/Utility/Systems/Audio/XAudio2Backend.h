@@ -0,0 +1,66 @@
+#pragma once
+
+// C++
+#include <xaudio2.h>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+// Engine
+#include "AudioBackend.h"
+
+/// <summary>
+/// XAudio2 のソースボイスで鳴らす再生先
+/// 再生し終えた通知は XAudio2 のスレッドから来るので、ロックして溜めておき CollectFinished で渡す
+/// </summary>
+class XAudio2Backend : public IAudioBackend
+{
+public:
+	explicit XAudio2Backend(IXAudio2* xAudio2) : xAudio2_(xAudio2) {}
+	~XAudio2Backend() override;
+
+	XAudio2Backend(const XAudio2Backend&) = delete;
+	XAudio2Backend& operator=(const XAudio2Backend&) = delete;
+
+	VoiceId CreateVoice(const AudioFormat& format) override;
+	void DestroyVoice(VoiceId voice) override;
+	bool Play(VoiceId voice, const uint8_t* data, uint32_t size, bool loop, uint64_t context) override;
+	void Stop(VoiceId voice) override;
+	void SetVolume(VoiceId voice, float volume) override;
+	void CollectFinished(std::vector<Finished>& outFinished) override;
+
+private:
+
+	// ボイスごとのコールバック (どのボイスの通知か分かるように1つずつ持つ)
+	class VoiceCallback : public IXAudio2VoiceCallback {
+	public:
+		VoiceCallback(XAudio2Backend* owner, VoiceId voice) : owner_(owner), voice_(voice) {}
+
+		void STDMETHODCALLTYPE OnBufferEnd(void* pBufferContext) override;
+		void STDMETHODCALLTYPE OnVoiceProcessingPassStart(UINT32) override {}
+		void STDMETHODCALLTYPE OnVoiceProcessingPassEnd() override {}
+		void STDMETHODCALLTYPE OnStreamEnd() override {}
+		void STDMETHODCALLTYPE OnBufferStart(void*) override {}
+		void STDMETHODCALLTYPE OnLoopEnd(void*) override {}
+		void STDMETHODCALLTYPE OnVoiceError(void*, HRESULT) override {}
+
+	private:
+		XAudio2Backend* owner_;
+		VoiceId voice_;
+	};
+
+	struct Voice {
+		IXAudio2SourceVoice* sourceVoice = nullptr;
+		std::unique_ptr<VoiceCallback> callback;
+	};
+
+	IXAudio2SourceVoice* FindVoice(VoiceId voice) const;
+
+	IXAudio2* xAudio2_ = nullptr;
+	std::unordered_map<VoiceId, Voice> voices_;
+	VoiceId nextId_ = 1;
+
+	// XAudio2 のスレッドから積まれる通知
+	std::mutex finishedMutex_;
+	std::vector<Finished> finished_;
+};
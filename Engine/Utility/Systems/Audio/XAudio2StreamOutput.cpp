@@ -0,0 +1,110 @@
+#include "XAudio2StreamOutput.h"
+
+// C++
+#include <chrono>
+#include <thread>
+
+XAudio2StreamOutput::~XAudio2StreamOutput()
+{
+	Close();
+}
+
+/// <summary>
+/// ソースボイスの作成
+/// </summary>
+bool XAudio2StreamOutput::Open(const AudioFormat& format)
+{
+	Close();
+
+	WAVEFORMATEX wfex{};
+	wfex.wFormatTag = format.formatTag;
+	wfex.nChannels = format.channels;
+	wfex.nSamplesPerSec = format.sampleRate;
+	wfex.nAvgBytesPerSec = format.GetBytesPerSecond();
+	wfex.nBlockAlign = format.blockAlign;
+	wfex.wBitsPerSample = format.bitsPerSample;
+	wfex.cbSize = 0;
+
+	if (FAILED(xAudio2_->CreateSourceVoice(&sourceVoice_, &wfex))) {
+		sourceVoice_ = nullptr;
+		return false;
+	}
+	return true;
+}
+
+/// <summary>
+/// ソースボイスの破棄
+/// </summary>
+void XAudio2StreamOutput::Close()
+{
+	if (sourceVoice_) {
+		sourceVoice_->DestroyVoice();
+		sourceVoice_ = nullptr;
+	}
+}
+
+/// <summary>
+/// バッファを積む (ストリームの途中なので END_OF_STREAM は付けない)
+/// </summary>
+bool XAudio2StreamOutput::Submit(const uint8_t* data, uint32_t size)
+{
+	if (!sourceVoice_) {
+		return false;
+	}
+	XAUDIO2_BUFFER buffer{};
+	buffer.pAudioData = data;
+	buffer.AudioBytes = size;
+	return SUCCEEDED(sourceVoice_->SubmitSourceBuffer(&buffer));
+}
+
+/// <summary>
+/// まだ再生し終えていないバッファの数 (鳴っている途中のものも含む)
+/// </summary>
+uint32_t XAudio2StreamOutput::GetQueuedCount() const
+{
+	if (!sourceVoice_) {
+		return 0;
+	}
+	XAUDIO2_VOICE_STATE state{};
+	sourceVoice_->GetState(&state, XAUDIO2_VOICE_NOSAMPLESPLAYED);
+	return state.BuffersQueued;
+}
+
+void XAudio2StreamOutput::Start()
+{
+	if (sourceVoice_) {
+		sourceVoice_->Start();
+	}
+}
+
+void XAudio2StreamOutput::Pause()
+{
+	if (sourceVoice_) {
+		sourceVoice_->Stop();
+	}
+}
+
+/// <summary>
+/// 止めて積んだバッファを捨てる
+/// FlushSourceBuffers は次の処理パスで反映されるので、バッファが外れるまで待ってから返す
+/// </summary>
+void XAudio2StreamOutput::Stop()
+{
+	if (!sourceVoice_) {
+		return;
+	}
+	sourceVoice_->Stop();
+	sourceVoice_->FlushSourceBuffers();
+
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(kFlushTimeoutMilliseconds);
+	while (GetQueuedCount() > 0 && std::chrono::steady_clock::now() < deadline) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
+
+void XAudio2StreamOutput::SetVolume(float volume)
+{
+	if (sourceVoice_) {
+		sourceVoice_->SetVolume(volume);
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+// C++
+#include <xaudio2.h>
+
+// Engine
+#include "StreamOutput.h"
+
+/// <summary>
+/// XAudio2 のソースボイス1つで鳴らすストリーミングの出力先
+/// ボイスプールとは別にボイスを持ち、積んだバッファの数は GetState で調べる (ソースボイスの操作はスレッドセーフ)
+/// </summary>
+class XAudio2StreamOutput : public IStreamOutput
+{
+public:
+	explicit XAudio2StreamOutput(IXAudio2* xAudio2) : xAudio2_(xAudio2) {}
+	~XAudio2StreamOutput() override;
+
+	XAudio2StreamOutput(const XAudio2StreamOutput&) = delete;
+	XAudio2StreamOutput& operator=(const XAudio2StreamOutput&) = delete;
+
+	bool Open(const AudioFormat& format) override;
+	void Close() override;
+	bool Submit(const uint8_t* data, uint32_t size) override;
+	uint32_t GetQueuedCount() const override;
+	void Start() override;
+	void Pause() override;
+	void Stop() override;
+	void SetVolume(float volume) override;
+
+private:
+	// 捨てたバッファが外れるまで待つ時間の上限 (ミリ秒)
+	static constexpr uint32_t kFlushTimeoutMilliseconds = 200;
+
+	IXAudio2* xAudio2_ = nullptr;
+	IXAudio2SourceVoice* sourceVoice_ = nullptr;
+};
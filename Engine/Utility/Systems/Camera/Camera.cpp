@@ -8,6 +8,7 @@
 #include "MathFunc.h"
 #include "Matrix4x4.h"
 #include "Systems/Input/Input.h"
+#include "Systems/GameTime/FrameTimer.h"
 
 #ifdef _DEBUG
 #include "imgui.h"
@@ -42,6 +43,38 @@ void Camera::UpdateMatrix()
     projectionMatrix_ = MakePerspectiveFovMatrix(fovY_, aspectRatio_, nearClip_, farClip_);
     // 合成行列
     viewProjectionMatrix_ = Multiply(viewMatrix_, projectionMatrix_);
+
+    // 補間用にステップごとの状態を残す
+    EulerTransform state = { transform_.scale, transform_.rotate, transform_.translate + shakeOffset_ };
+    uint64_t step = FrameTimer::GetInstance()->GetStepIndex();
+    if (!hasSnapshot_ || step != snapshotStep_) {
+        prevTransform_ = (hasSnapshot_ && step == snapshotStep_ + 1) ? currTransform_ : state;
+        snapshotStep_ = step;
+        hasSnapshot_ = true;
+    }
+    currTransform_ = state;
+}
+
+void Camera::ApplyInterpolation(float alpha)
+{
+    if (!hasSnapshot_) {
+        return;
+    }
+    // 今ステップで更新されていなければ最新の状態のまま
+    if (snapshotStep_ != FrameTimer::GetInstance()->GetStepIndex()) {
+        alpha = 1.0f;
+    }
+    Vector3 rotate = {
+        LerpShortAngle(prevTransform_.rotate.x, currTransform_.rotate.x, alpha),
+        LerpShortAngle(prevTransform_.rotate.y, currTransform_.rotate.y, alpha),
+        LerpShortAngle(prevTransform_.rotate.z, currTransform_.rotate.z, alpha),
+    };
+    worldMatrix_ = MakeAffineMatrix(
+        Lerp(prevTransform_.scale, currTransform_.scale, alpha),
+        rotate,
+        Lerp(prevTransform_.translate, currTransform_.translate, alpha));
+    viewMatrix_ = Inverse(worldMatrix_);
+    viewProjectionMatrix_ = Multiply(viewMatrix_, projectionMatrix_);
 }
 
 void Camera::ShowImGui()
@@ -80,7 +113,7 @@ void Camera::Shake(float time, const Vector2 min, const Vector2 max)
 void Camera::UpdateShake()
 {
     if (cameraShake_.isShaking_) {
-		float deltaTime = 1.0f / 60.0f;
+		float deltaTime = FrameTimer::GetInstance()->GetDeltaTime();
         cameraShake_.shakeTimer_ += deltaTime;
 
         if (cameraShake_.shakeTimer_ >= cameraShake_.shakeDuration_) {
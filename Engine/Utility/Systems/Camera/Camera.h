@@ -1,4 +1,7 @@
 #pragma once
+// C++
+#include <cstdint>
+
 // Math
 #include "Vector3.h"
 #include "MathFunc.h"
@@ -31,6 +34,11 @@ public: // メンバ関数
 	/// </summary>
 	void UpdateMatrix();
 
+	/// <summary>
+	/// 描画用に前ステップとの間を補間した行列にする
+	/// </summary>
+	void ApplyInterpolation(float alpha);
+
 
 	/// <summary>
 	/// ImGui
@@ -70,6 +78,8 @@ public: // アクセッサ
 	Vector3 GetRotate() const { return transform_.rotate; }
 	Vector3 GetTranslate() const { return transform_.translate; }
 	Vector3 GetScale() const { return transform_.scale; }
+	float GetNearClip() const { return nearClip_; }
+	float GetFarClip() const { return farClip_; }
 
 public: 
 	EulerTransform transform_;	   
@@ -88,5 +98,14 @@ public:
 
 	CameraShake cameraShake_;
 	Vector3 shakeOffset_;
+
+private:
+	/*===============================================================//
+								補間
+	//===============================================================*/
+	EulerTransform prevTransform_;
+	EulerTransform currTransform_;
+	uint64_t snapshotStep_ = 0;
+	bool hasSnapshot_ = false;
 };
 
@@ -32,3 +32,11 @@ void CameraManager::UpdateAllCameras()
         camera->Update();
     }
 }
+
+void CameraManager::InterpolateAllCameras(float alpha)
+{
+    for (auto& camera : cameras_)
+    {
+        camera->ApplyInterpolation(alpha);
+    }
+}
@@ -42,6 +42,11 @@ public:
     /// </summary>
     void UpdateAllCameras();
 
+    /// <summary>
+    /// すべてのカメラを描画用に補間する
+    /// </summary>
+    void InterpolateAllCameras(float alpha);
+
 private:
     std::vector<std::shared_ptr<Camera>> cameras_;  // カメラのリスト
     std::shared_ptr<Camera> currentCamera_;         // 現在のカメラ
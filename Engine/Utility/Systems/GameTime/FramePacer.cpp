@@ -0,0 +1,139 @@
+#include "FramePacer.h"
+
+// C++
+#include <algorithm>
+#include <thread>
+
+#ifdef _DEBUG
+#include "imgui.h"
+#endif // _DEBUG
+
+namespace {
+    // ヒストグラム区間の上限 (マイクロ秒)
+    constexpr std::array<float, FramePacer::kHistogramBucketCount - 1> kBucketEdgesUs = {
+        50.0f, 100.0f, 250.0f, 500.0f, 1000.0f, 2000.0f
+    };
+    constexpr const char* kBucketLabels[FramePacer::kHistogramBucketCount] = {
+        "< 50us", "< 100us", "< 250us", "< 500us", "< 1ms", "< 2ms", ">= 2ms"
+    };
+    // スリープ余裕の範囲
+    constexpr float kMinSleepMarginUs = 100.0f;
+    constexpr float kMaxSleepMarginUs = 4000.0f;
+    // 余裕を縮めていく割合 (寝過ごしが減ったら少しずつスリープを長くする)
+    constexpr float kMarginDecay = 0.98f;
+}
+
+void FramePacer::Initialize(double targetFps)
+{
+    SetTargetFps(targetFps);
+    sleepMarginUs_ = 1500.0f;
+    ResetStats();
+    deadline_ = Now() + framePeriod_;
+}
+
+void FramePacer::SetTargetFps(double targetFps)
+{
+    targetFps_ = (std::max)(targetFps, 1.0);
+    framePeriod_ = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFps_));
+}
+
+void FramePacer::Wait()
+{
+    Clock::time_point now = Now();
+
+    // 処理落ちで締め切りを過ぎていたら待たずに基準を取り直す
+    if (now >= deadline_) {
+        ++stats_.lateFrameCount;
+        deadline_ = (now - deadline_ > framePeriod_) ? now + framePeriod_ : deadline_ + framePeriod_;
+        return;
+    }
+
+    // 余裕を残して粗くスリープ
+    std::chrono::microseconds margin(static_cast<int64_t>(sleepMarginUs_));
+    Clock::time_point wakeTarget = deadline_ - margin;
+    if (now < wakeTarget) {
+        Sleep(wakeTarget - now);
+        Clock::time_point woke = Now();
+
+        // 寝過ごした分を次の余裕に反映する
+        float oversleepUs = std::chrono::duration<float, std::micro>(woke - wakeTarget).count();
+        sleepMarginUs_ = std::clamp((std::max)(oversleepUs * 1.25f, sleepMarginUs_ * kMarginDecay),
+            kMinSleepMarginUs, kMaxSleepMarginUs);
+    }
+
+    // 残りはスピンで待つ
+    Clock::time_point spinStart = Now();
+    while (Now() < deadline_) {
+        std::this_thread::yield();
+    }
+    Clock::time_point end = Now();
+
+    Record(std::chrono::duration<float, std::micro>(end - deadline_).count(),
+        std::chrono::duration<float, std::micro>(end - spinStart).count());
+
+    // 締め切りは絶対時刻で進めて誤差を積み上げない
+    deadline_ += framePeriod_;
+}
+
+void FramePacer::Sleep(Clock::duration duration) const
+{
+    if (sleep_) {
+        sleep_(duration);
+    } else {
+        std::this_thread::sleep_for(duration);
+    }
+}
+
+void FramePacer::ResetStats()
+{
+    stats_ = Stats{};
+    stats_.sleepMarginUs = sleepMarginUs_;
+}
+
+void FramePacer::Record(float overshootUs, float spinUs)
+{
+    ++stats_.frameCount;
+    stats_.lastOvershootUs = overshootUs;
+    stats_.lastSpinUs = spinUs;
+    stats_.maxOvershootUs = (std::max)(stats_.maxOvershootUs, overshootUs);
+    stats_.meanOvershootUs += (overshootUs - stats_.meanOvershootUs) / static_cast<float>(stats_.frameCount);
+    stats_.sleepMarginUs = sleepMarginUs_;
+
+    uint32_t bucket = 0;
+    while (bucket < kBucketEdgesUs.size() && overshootUs >= kBucketEdgesUs[bucket]) {
+        ++bucket;
+    }
+    ++stats_.histogram[bucket];
+}
+
+const char* FramePacer::GetHistogramLabel(uint32_t bucket)
+{
+    return bucket < kHistogramBucketCount ? kBucketLabels[bucket] : "";
+}
+
+void FramePacer::ShowImGui()
+{
+#ifdef _DEBUG
+    ImGui::Begin("FramePacer");
+    float targetFps = static_cast<float>(targetFps_);
+    if (ImGui::DragFloat("Target FPS", &targetFps, 1.0f, 1.0f, 500.0f)) {
+        SetTargetFps(targetFps);
+    }
+    ImGui::Text("Frames      : %llu (late %llu)", stats_.frameCount, stats_.lateFrameCount);
+    ImGui::Text("Overshoot   : last %.1f us / mean %.1f us / max %.1f us",
+        stats_.lastOvershootUs, stats_.meanOvershootUs, stats_.maxOvershootUs);
+    ImGui::Text("Spin        : %.1f us", stats_.lastSpinUs);
+    ImGui::Text("Sleep margin: %.1f us", stats_.sleepMarginUs);
+
+    float histogram[kHistogramBucketCount];
+    for (uint32_t i = 0; i < kHistogramBucketCount; ++i) {
+        histogram[i] = static_cast<float>(stats_.histogram[i]);
+        ImGui::Text("%-8s %llu", kBucketLabels[i], stats_.histogram[i]);
+    }
+    ImGui::PlotHistogram("Overshoot", histogram, kHistogramBucketCount, 0, nullptr, 0.0f, FLT_MAX, ImVec2(0, 60));
+    if (ImGui::Button("Reset")) {
+        ResetStats();
+    }
+    ImGui::End();
+#endif // _DEBUG
+}
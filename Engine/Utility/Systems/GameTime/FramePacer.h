@@ -0,0 +1,83 @@
+#pragma once
+// C++
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+/// <summary>
+/// フレームレート制限
+/// 締め切りの手前まで粗くスリープし、残りをスピンで待つ
+/// GPUに依存しないので単体で動かせる
+/// </summary>
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+    // 現在時刻の取得とスリープ (テストでは偽の時計に差し替える)
+    using NowFunction = std::function<Clock::time_point()>;
+    using SleepFunction = std::function<void(Clock::duration)>;
+
+    // 締め切りからの超過時間のヒストグラム区間数
+    static constexpr uint32_t kHistogramBucketCount = 7;
+
+    struct Stats {
+        uint64_t frameCount = 0;        // 待機したフレーム数
+        uint64_t lateFrameCount = 0;    // 待つ前に締め切りを過ぎていたフレーム数
+        float lastOvershootUs = 0.0f;   // 直前フレームの超過時間
+        float meanOvershootUs = 0.0f;   // 超過時間の平均
+        float maxOvershootUs = 0.0f;    // 超過時間の最大
+        float lastSpinUs = 0.0f;        // 直前フレームのスピン時間
+        float sleepMarginUs = 0.0f;     // 現在のスリープ余裕
+        std::array<uint64_t, kHistogramBucketCount> histogram{};
+    };
+
+    /// <summary>
+    /// 初期化
+    /// </summary>
+    /// <param name="targetFps">目標フレームレート</param>
+    void Initialize(double targetFps = 60.0);
+
+    /// <summary>
+    /// 次のフレームの締め切りまで待つ
+    /// </summary>
+    void Wait();
+
+    /// <summary>
+    /// 統計のリセット
+    /// </summary>
+    void ResetStats();
+
+    /// <summary>
+    /// ImGui
+    /// </summary>
+    void ShowImGui();
+
+    void SetTargetFps(double targetFps);
+    double GetTargetFps() const { return targetFps_; }
+    const Stats& GetStats() const { return stats_; }
+
+    /// <summary>
+    /// 時刻の取得とスリープを差し替える (nullptrで steady_clock と sleep_for に戻す)
+    /// 次の Initialize から反映する
+    /// </summary>
+    void SetTimeSource(NowFunction now, SleepFunction sleep) { now_ = std::move(now); sleep_ = std::move(sleep); }
+
+    // ヒストグラム区間の名前
+    static const char* GetHistogramLabel(uint32_t bucket);
+
+private:
+    // 超過時間をヒストグラムに記録
+    void Record(float overshootUs, float spinUs);
+
+    Clock::time_point Now() const { return now_ ? now_() : Clock::now(); }
+    void Sleep(Clock::duration duration) const;
+
+    double targetFps_ = 60.0;
+    Clock::duration framePeriod_{};
+    Clock::time_point deadline_{};
+    // スリープの寝過ごしを吸収する余裕 (実測で調整する)
+    float sleepMarginUs_ = 1500.0f;
+    Stats stats_;
+    NowFunction now_;
+    SleepFunction sleep_;
+};
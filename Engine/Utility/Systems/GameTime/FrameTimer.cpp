@@ -0,0 +1,51 @@
+#include "FrameTimer.h"
+
+// C++
+#include <algorithm>
+
+void FrameTimer::Initialize(float fixedDeltaTime)
+{
+    fixedDeltaTime_ = fixedDeltaTime;
+    frameDeltaTime_ = fixedDeltaTime;
+    accumulator_ = 0.0f;
+    stepsThisFrame_ = 0;
+    stepIndex_ = 0;
+    reference_ = Now();
+}
+
+void FrameTimer::BeginFrame()
+{
+    std::chrono::steady_clock::time_point now = Now();
+    frameDeltaTime_ = std::chrono::duration<float>(now - reference_).count();
+    reference_ = now;
+    stepsThisFrame_ = 0;
+
+    if (mode_ == Mode::kLockStep) {
+        // 描画側で60FPSに固定しているので毎フレーム1ステップ
+        accumulator_ = fixedDeltaTime_;
+        return;
+    }
+
+    // ブレークポイント等で止まった後に大量のステップを回さないよう上限を設ける
+    float maxAccumulate = fixedDeltaTime_ * static_cast<float>(maxStepsPerFrame_);
+    accumulator_ = (std::min)(accumulator_ + frameDeltaTime_ * timeScale_, maxAccumulate);
+}
+
+bool FrameTimer::StepSimulation()
+{
+    if (accumulator_ < fixedDeltaTime_ || stepsThisFrame_ >= maxStepsPerFrame_) {
+        return false;
+    }
+    accumulator_ -= fixedDeltaTime_;
+    ++stepsThisFrame_;
+    ++stepIndex_;
+    return true;
+}
+
+float FrameTimer::GetInterpolationAlpha() const
+{
+    if (mode_ == Mode::kLockStep) {
+        return 1.0f;
+    }
+    return std::clamp(accumulator_ / fixedDeltaTime_, 0.0f, 1.0f);
+}
@@ -0,0 +1,93 @@
+#pragma once
+// C++
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+/// <summary>
+/// フレーム時間の唯一の取得元
+/// 実時間を積算して固定ステップでシミュレーションを進め、描画用の補間係数を出す
+/// </summary>
+class FrameTimer {
+public:
+    // ループの動かし方
+    enum class Mode {
+        kLockStep,          // 1フレームにつき1ステップ (描画側で60FPSに固定する従来の動き)
+        kFixedInterpolated, // 実時間で固定ステップを回し、描画は補間する
+    };
+
+    // 現在時刻の取得元 (テストや計測で差し替える)
+    using NowFunction = std::function<std::chrono::steady_clock::time_point()>;
+
+    static FrameTimer* GetInstance() {
+        static FrameTimer instance;
+        return &instance;
+    }
+
+    /// <summary>
+    /// 初期化
+    /// </summary>
+    /// <param name="fixedDeltaTime">シミュレーション1ステップの秒数</param>
+    void Initialize(float fixedDeltaTime = 1.0f / 60.0f);
+
+    /// <summary>
+    /// フレーム開始 (実時間を計測して積算する)
+    /// </summary>
+    void BeginFrame();
+
+    /// <summary>
+    /// 積算した時間から1ステップ取り出す
+    /// </summary>
+    /// <returns>ステップを進めるならtrue</returns>
+    bool StepSimulation();
+
+    // シミュレーション1ステップの秒数 (更新処理はすべてこれを使う)
+    float GetDeltaTime() const { return fixedDeltaTime_; }
+    // 直前フレームの実時間
+    float GetFrameDeltaTime() const { return frameDeltaTime_; }
+    // 前ステップと現ステップの間の補間係数 [0, 1]
+    float GetInterpolationAlpha() const;
+    // これまでに進めたステップ数 (補間用のスナップショットの判定に使う)
+    uint64_t GetStepIndex() const { return stepIndex_; }
+    // 直前フレームで進めたステップ数
+    uint32_t GetStepsThisFrame() const { return stepsThisFrame_; }
+
+    void SetMode(Mode mode) { mode_ = mode; accumulator_ = 0.0f; }
+    Mode GetMode() const { return mode_; }
+    bool IsInterpolating() const { return mode_ == Mode::kFixedInterpolated; }
+
+    // 実時間に掛ける倍率 (早送り・スロー)
+    void SetTimeScale(float scale) { timeScale_ = scale; }
+    float GetTimeScale() const { return timeScale_; }
+
+    // 1フレームで進める最大ステップ数 (処理落ち時の暴走防止)
+    void SetMaxStepsPerFrame(uint32_t steps) { maxStepsPerFrame_ = steps; }
+
+    /// <summary>
+    /// 時刻の取得元を差し替える (nullptrで steady_clock に戻す)
+    /// 次の Initialize から反映する
+    /// </summary>
+    void SetTimeSource(NowFunction now) { now_ = std::move(now); }
+
+private:
+    std::chrono::steady_clock::time_point Now() const {
+        return now_ ? now_() : std::chrono::steady_clock::now();
+    }
+
+
+    Mode mode_ = Mode::kLockStep;
+    float fixedDeltaTime_ = 1.0f / 60.0f;
+    float frameDeltaTime_ = 0.0f;
+    float accumulator_ = 0.0f;
+    float timeScale_ = 1.0f;
+    uint32_t maxStepsPerFrame_ = 5;
+    uint32_t stepsThisFrame_ = 0;
+    uint64_t stepIndex_ = 0;
+    std::chrono::steady_clock::time_point reference_;
+    NowFunction now_;
+
+    FrameTimer() = default;
+    ~FrameTimer() = default;
+    FrameTimer(const FrameTimer&) = delete;
+    FrameTimer& operator=(const FrameTimer&) = delete;
+};
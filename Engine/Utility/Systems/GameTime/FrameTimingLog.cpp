@@ -0,0 +1,82 @@
+#include "FrameTimingLog.h"
+
+// C++
+#include <algorithm>
+#include <cstdio>
+
+// Engine
+#include "DX./DirectXCommon.h"
+
+FrameTimingLog::~FrameTimingLog()
+{
+    Close();
+}
+
+bool FrameTimingLog::Open(const std::string& filePath)
+{
+    Close();
+    file_.open(filePath, std::ios::trunc);
+    if (!file_) {
+        DirectXCommon::Log("FrameTimingLog: failed to open " + filePath + "\n");
+        return false;
+    }
+    file_ << "frame,steps,update_ms,draw_ms,frame_ms\n";
+    filePath_ = filePath;
+    frameIndex_ = 0;
+    frameMs_.clear();
+    return true;
+}
+
+void FrameTimingLog::Close()
+{
+    if (!file_.is_open()) {
+        return;
+    }
+    file_.close();
+
+    const Summary summary = Summarize();
+    char text[256];
+    snprintf(text, sizeof(text), "FrameTimingLog: %llu frames, mean %.3f ms, p50 %.3f, p95 %.3f, p99 %.3f, max %.3f -> ",
+        static_cast<unsigned long long>(summary.frameCount), summary.meanMs, summary.p50Ms, summary.p95Ms, summary.p99Ms, summary.maxMs);
+    DirectXCommon::Log(text + filePath_ + "\n");
+}
+
+void FrameTimingLog::Record(const Sample& sample)
+{
+    if (!file_.is_open()) {
+        return;
+    }
+    char line[96];
+    const int length = snprintf(line, sizeof(line), "%llu,%u,%.4f,%.4f,%.4f\n",
+        static_cast<unsigned long long>(frameIndex_), sample.steps, sample.updateMs, sample.drawMs, sample.frameMs);
+    file_.write(line, length);
+    frameMs_.push_back(sample.frameMs);
+    ++frameIndex_;
+}
+
+FrameTimingLog::Summary FrameTimingLog::Summarize() const
+{
+    Summary summary;
+    summary.frameCount = frameMs_.size();
+    if (frameMs_.empty()) {
+        return summary;
+    }
+
+    std::vector<float> sorted = frameMs_;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0.0;
+    for (float ms : sorted) {
+        total += ms;
+    }
+    // 最も近い順位の値
+    auto percentile = [&sorted](float p) {
+        size_t index = static_cast<size_t>(p * static_cast<float>(sorted.size() - 1) + 0.5f);
+        return sorted[(std::min)(index, sorted.size() - 1)];
+    };
+    summary.meanMs = static_cast<float>(total / static_cast<double>(sorted.size()));
+    summary.p50Ms = percentile(0.50f);
+    summary.p95Ms = percentile(0.95f);
+    summary.p99Ms = percentile(0.99f);
+    summary.maxMs = sorted.back();
+    return summary;
+}
@@ -0,0 +1,62 @@
+#pragma once
+// C++
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// フレームごとの処理時間をCSVに書き出す
+/// 入力の再生と組み合わせ、同じプレイを回した時の時間を変更の前後で比べる
+/// </summary>
+class FrameTimingLog {
+public:
+    // 1フレーム分 (ミリ秒)
+    struct Sample {
+        uint32_t steps = 0;     // 進めた更新ステップ数
+        float updateMs = 0.0f;  // 更新 (全ステップ分)
+        float drawMs = 0.0f;    // 描画 (Present とGPU待ちを含む)
+        float frameMs = 0.0f;   // フレーム全体
+    };
+
+    // 終了時にまとめて出す値
+    struct Summary {
+        uint64_t frameCount = 0;
+        float meanMs = 0.0f;
+        float p50Ms = 0.0f;
+        float p95Ms = 0.0f;
+        float p99Ms = 0.0f;
+        float maxMs = 0.0f;
+    };
+
+    ~FrameTimingLog();
+
+    /// <summary>
+    /// 書き出し先を開く (見出しの行を書く)
+    /// </summary>
+    bool Open(const std::string& filePath);
+
+    /// <summary>
+    /// 閉じる (フレーム全体の時間の分布をログに出す)
+    /// </summary>
+    void Close();
+
+    /// <summary>
+    /// 1フレーム分を書く
+    /// </summary>
+    void Record(const Sample& sample);
+
+    /// <summary>
+    /// これまでのフレーム全体の時間の分布
+    /// </summary>
+    Summary Summarize() const;
+
+    bool IsOpen() const { return file_.is_open(); }
+
+private:
+    std::ofstream file_;
+    std::string filePath_;
+    uint64_t frameIndex_ = 0;
+    // 分布を出すためのフレーム全体の時間
+    std::vector<float> frameMs_;
+};
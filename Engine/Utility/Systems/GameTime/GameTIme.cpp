@@ -0,0 +1,95 @@
+#include "GameTIme.h"
+
+// C++
+#include <cassert>
+
+void GameTime::Initialize()
+{
+    globalTime_ = 0.0f;
+    globalTimeScale_ = 1.0f;
+    isPaused_ = false;
+    hitStop_ = HitStop::GetInstance();
+
+    // 世代は残したまま全て解放して、古いハンドルを無効にする
+    freeIndices_.clear();
+    for (uint32_t i = static_cast<uint32_t>(alive_.size()); i > 0; --i) {
+        uint32_t index = i - 1;
+        if (alive_[index]) {
+            alive_[index] = 0;
+            generations_[index] = TimeHandleUtil::NextGeneration(generations_[index]);
+        }
+        hitStop_->Clear(index);
+        freeIndices_.push_back(index);
+    }
+    aliveCount_ = 0;
+}
+
+TimeHandle GameTime::RegisterObject()
+{
+    if (!hitStop_) {
+        hitStop_ = HitStop::GetInstance();
+    }
+
+    uint32_t index = 0;
+    if (!freeIndices_.empty()) {
+        index = freeIndices_.back();
+        freeIndices_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(alive_.size());
+        assert(index <= TimeHandleUtil::kMaxIndex && "GameTime : too many time domains");
+        times_.push_back(0.0f);
+        timeScales_.push_back(1.0f);
+        deltaScales_.push_back(1.0f);
+        paused_.push_back(0);
+        alive_.push_back(0);
+        generations_.push_back(0);
+        hitStop_->Resize(alive_.size());
+    }
+
+    times_[index] = 0.0f;
+    timeScales_[index] = 1.0f;
+    deltaScales_[index] = 1.0f;
+    paused_[index] = 0;
+    alive_[index] = 1;
+    hitStop_->Clear(index);
+    ++aliveCount_;
+
+    return TimeHandleUtil::Make(index, generations_[index]);
+}
+
+void GameTime::UnregisterObject(TimeHandle handle)
+{
+    if (!IsValid(handle)) {
+        return;
+    }
+    uint32_t index = TimeHandleUtil::GetIndex(handle);
+    alive_[index] = 0;
+    generations_[index] = TimeHandleUtil::NextGeneration(generations_[index]);
+    hitStop_->Clear(index);
+    freeIndices_.push_back(index);
+    --aliveCount_;
+}
+
+void GameTime::GameUpdate(float deltaTime)
+{
+    const float DELTA_SPEED = 1.0f;  // 時間の進行速度（調整可能）
+
+    // グローバル時間の更新
+    float scaledDelta = isPaused_ ? 0.0f : deltaTime * DELTA_SPEED * globalTimeScale_;
+    globalTime_ += scaledDelta;
+
+    // 各オブジェクトの時間を更新
+    // 未登録の添字も一緒に回すが、値を読まれないので問題ない
+    float* remaining = hitStop_ ? hitStop_->remaining_.data() : nullptr;
+    const size_t count = alive_.size();
+    for (size_t i = 0; i < count; ++i) {
+        float scale = paused_[i] ? 0.0f : timeScales_[i];
+        if (remaining && remaining[i] > 0.0f) {
+            // ヒットストップは実時間で減らす
+            remaining[i] -= deltaTime;
+            scale = 0.0f;
+        }
+        deltaScales_[i] = scale;
+        times_[i] += scaledDelta * scale;
+    }
+}
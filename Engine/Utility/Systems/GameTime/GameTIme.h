@@ -1,11 +1,13 @@
 #pragma once
-#include "ObjectTime.h"
+#include "TimeHandle.h"
 #include "HitStop.h"
-#include <string>
-#include <unordered_map>
-#include <memory>
-#include <map>
+#include <cstdint>
+#include <vector>
 
+/// <summary>
+/// オブジェクトごとの時間領域を管理する
+/// 登録時にハンドルを払い出し、各値は添字で引ける密な配列に持つ
+/// </summary>
 class GameTime {
 public:
     static GameTime* GetInstance() {
@@ -13,66 +15,45 @@ public:
         return &instance;
     }
 
-    void Initialize() {
-        globalTime_ = 0.0f;
-        globalTimeScale_ = 1.0f;
-        isPaused_ = false;
-        objectTimes_.clear();
-        hitStop_ = HitStop::GetInstance();
-    }
-
-    void RegisterObject(const std::string& id) {
-        objectTimes_[id] = std::make_unique<ObjectTime>();
-        prevTimes_[id] = 0.0f;  // 前回の時間も初期化
-    }
-
-    void UnregisterObject(const std::string& id) {
-        objectTimes_.erase(id);
-    }
-
-    void GameUpdate(float deltaTime) {
-        const float DELTA_SPEED = 1.0f;  // 時間の進行速度（調整可能）
-
-        // グローバル時間の更新
-        globalTime_ += deltaTime * DELTA_SPEED;
-
-        // 各オブジェクトの時間を更新
-        for (auto& [id, objTime] : objectTimes_) {
-            if (objTime) {
-                // ヒットストップ中かチェック
-                float timeScale = HitStop::GetInstance()->GetTimeScale(id);
-                if (timeScale > 0.001f) {  // ヒットストップ中でなければ
-                    objTime->Update(deltaTime * DELTA_SPEED);  // 時間を更新
-                }
-            }
-        }
+    /// <summary>
+    /// 初期化 (登録済みのハンドルはすべて無効になる)
+    /// </summary>
+    void Initialize();
+
+    /// <summary>
+    /// 時間領域を登録してハンドルを受け取る
+    /// </summary>
+    TimeHandle RegisterObject();
+
+    /// <summary>
+    /// 登録解除 (無効なハンドルは無視する)
+    /// </summary>
+    void UnregisterObject(TimeHandle handle);
+
+    /// <summary>
+    /// 全時間領域を1回の走査で進める (ヒットストップの残り時間もここで進む)
+    /// </summary>
+    void GameUpdate(float deltaTime);
+
+    bool IsValid(TimeHandle handle) const {
+        uint32_t index = TimeHandleUtil::GetIndex(handle);
+        return handle != TimeHandleUtil::kInvalid && index < generations_.size() &&
+            alive_[index] && TimeHandleUtil::GetGeneration(handle) == generations_[index];
     }
 
     // オブジェクトの時間取得（存在しない場合は0.0fを返す）
-    float GetObjectTime(const std::string& id) const {
-        auto it = objectTimes_.find(id);
-        if (it != objectTimes_.end() && it->second) {
-            return it->second->GetTime();
-        }
-        return 0.0f;
+    float GetObjectTime(TimeHandle handle) const {
+        return IsValid(handle) ? times_[TimeHandleUtil::GetIndex(handle)] : 0.0f;
     }
 
-    // オブジェクトのデルタタイム取得
-    float GetDeltaTime(const std::string& id) const {
-        const float BASE_DELTA = 1.0f;  // 基準デルタタイム
-        const float SPEED_MULTIPLIER = 1.0f;     // 速度倍率（調整可能）
-
-        auto it = objectTimes_.find(id);
-        if (it != objectTimes_.end() && it->second) {
-            float timeScale = HitStop::GetInstance()->GetTimeScale(id);
-            if (timeScale < 0.001f) {
-                return 0.0f;  // ヒットストップ中
-            }
-            return BASE_DELTA * SPEED_MULTIPLIER;  // 通常時
-        }
-        return BASE_DELTA * SPEED_MULTIPLIER;
+    // オブジェクトのデルタタイム倍率取得 (ヒットストップ中、一時停止中は0)
+    float GetDeltaTime(TimeHandle handle) const {
+        return IsValid(handle) ? deltaScales_[TimeHandleUtil::GetIndex(handle)] : 1.0f;
     }
 
+    // 登録中の時間領域の数
+    uint32_t GetObjectCount() const { return aliveCount_; }
+
     // グローバル時間関連
     float GetGlobalTime() const { return globalTime_; }
     void SetGlobalTimeScale(float scale) { globalTimeScale_ = scale; }
@@ -83,31 +64,44 @@ public:
     bool IsPaused() const { return isPaused_; }
 
     // オブジェクト個別の一時停止
-    void SetObjectPaused(const std::string& id, bool paused) {
-        auto it = objectTimes_.find(id);
-        if (it != objectTimes_.end() && it->second) {
-            it->second->SetPaused(paused);
+    void SetObjectPaused(TimeHandle handle, bool paused) {
+        if (IsValid(handle)) {
+            paused_[TimeHandleUtil::GetIndex(handle)] = paused ? 1 : 0;
+        }
+    }
+
+    // オブジェクト個別の時間スケール
+    void SetObjectTimeScale(TimeHandle handle, float scale) {
+        if (IsValid(handle)) {
+            timeScales_[TimeHandleUtil::GetIndex(handle)] = scale;
         }
     }
 
     // 指定したオブジェクトの時間をリセット
-    void ResetObjectTime(const std::string& id) {
-        auto it = objectTimes_.find(id);
-        if (it != objectTimes_.end() && it->second) {
-            it->second->Reset();
+    void ResetObjectTime(TimeHandle handle) {
+        if (IsValid(handle)) {
+            times_[TimeHandleUtil::GetIndex(handle)] = 0.0f;
         }
     }
 
 private:
-    float globalTime_;      // グローバル時間
-    float globalTimeScale_; // グローバル時間スケール
-    bool isPaused_;         // グローバル一時停止フラグ
-    mutable std::unordered_map<std::string, float> prevTimes_;  // mutableを追加
-    HitStop* hitStop_;      // HitStopインスタンス
-    std::unordered_map<std::string, std::unique_ptr<ObjectTime>> objectTimes_; // オブジェクト時間管理
+    float globalTime_ = 0.0f;      // グローバル時間
+    float globalTimeScale_ = 1.0f; // グローバル時間スケール
+    bool isPaused_ = false;        // グローバル一時停止フラグ
+    HitStop* hitStop_ = nullptr;   // HitStopインスタンス
+
+    // 添字ごとの時間領域 (HitStop::remaining_ と同じ添字)
+    std::vector<float> times_;       // 経過時間
+    std::vector<float> timeScales_;  // 個別の時間スケール（1.0が通常速度）
+    std::vector<float> deltaScales_; // 今フレームのデルタタイム倍率
+    std::vector<uint8_t> paused_;    // 個別の一時停止フラグ
+    std::vector<uint8_t> alive_;     // 登録中か
+    std::vector<uint32_t> generations_;
+    std::vector<uint32_t> freeIndices_;
+    uint32_t aliveCount_ = 0;
 
     GameTime() = default;
     ~GameTime() = default;
     GameTime(const GameTime&) = delete;
     GameTime& operator=(const GameTime&) = delete;
-};
\ No newline at end of file
+};
@@ -1 +1,76 @@
 #include "HitStop.h"
+#include "GameTIme.h"
+
+float HitStop::GetDuration(HitStopType type)
+{
+    switch (type) {
+    case HitStopType::Light:
+        return 0.05f;
+    case HitStopType::Medium:
+        return 0.1f;
+    case HitStopType::Heavy:
+        return 0.2f;
+    case HitStopType::None:
+    default:
+        return 0.0f;
+    }
+}
+
+void HitStop::Start(TimeHandle target, HitStopType type)
+{
+    float duration = GetDuration(type);
+    if (duration <= 0.0f) {
+        return; // ヒットストップなしの場合は何もしない
+    }
+    StartWithDuration(target, duration);
+}
+
+void HitStop::StartBatch(const TimeHandle* targets, size_t count, HitStopType type)
+{
+    float duration = GetDuration(type);
+    if (duration <= 0.0f) {
+        return;
+    }
+    GameTime* gameTime = GameTime::GetInstance();
+    for (size_t i = 0; i < count; ++i) {
+        if (!gameTime->IsValid(targets[i])) {
+            continue;
+        }
+        float& remaining = remaining_[TimeHandleUtil::GetIndex(targets[i])];
+        if (remaining < duration) {
+            remaining = duration;
+        }
+    }
+}
+
+void HitStop::StartWithDuration(TimeHandle target, float duration)
+{
+    if (!GameTime::GetInstance()->IsValid(target)) {
+        return;
+    }
+    // 既に長いヒットストップ中なら短くしない
+    float& remaining = remaining_[TimeHandleUtil::GetIndex(target)];
+    if (remaining < duration) {
+        remaining = duration;
+    }
+}
+
+void HitStop::Stop(TimeHandle target)
+{
+    if (GameTime::GetInstance()->IsValid(target)) {
+        remaining_[TimeHandleUtil::GetIndex(target)] = 0.0f;
+    }
+}
+
+bool HitStop::IsActive(TimeHandle target) const
+{
+    return GameTime::GetInstance()->IsValid(target) &&
+        remaining_[TimeHandleUtil::GetIndex(target)] > 0.0f;
+}
+
+void HitStop::StopAll()
+{
+    for (float& remaining : remaining_) {
+        remaining = 0.0f;
+    }
+}
@@ -1,8 +1,15 @@
 // HitStop.h
 #pragma once
-#include <string>
-#include <unordered_map>
+#include "TimeHandle.h"
+#include <cstddef>
+#include <vector>
 
+class GameTime;
+
+/// <summary>
+/// 時間領域ごとのヒットストップ
+/// 残り時間は GameTime::GameUpdate の中でまとめて進める
+/// </summary>
 class HitStop {
 public:
     static HitStop* GetInstance() {
@@ -19,86 +26,43 @@ public:
         Custom          // カスタム設定のヒットストップ
     };
 
+    // 種類ごとの継続時間 (None / Custom は 0)
+    static float GetDuration(HitStopType type);
+
     // ヒットストップを開始（種類を指定）
-    void Start(const std::string& targetID, HitStopType type) {
-        float duration = 0.0f;
-        switch (type) {
-        case HitStopType::Light:
-            duration = 0.05f;
-            break;
-        case HitStopType::Medium:
-            duration = 0.1f;
-            break;
-        case HitStopType::Heavy:
-            duration = 0.2f;
-            break;
-        case HitStopType::None:
-            return; // ヒットストップなしの場合は何もしない
-        default:
-            return;
-        }
-        StartWithDuration(targetID, duration);
+    void Start(TimeHandle target, HitStopType type);
+
+    // 複数の対象にまとめてヒットストップを開始
+    void StartBatch(const TimeHandle* targets, size_t count, HitStopType type);
+    void StartBatch(const std::vector<TimeHandle>& targets, HitStopType type) {
+        StartBatch(targets.data(), targets.size(), type);
     }
 
     // カスタム時間でヒットストップを開始
-    void StartWithDuration(const std::string& targetID, float duration) {
-        HitStopData data;
-        data.duration = duration;
-        data.currentTime = 0.0f;
-        data.isActive = true;
-        data.timeScale = 0.0f; // 完全停止
-        hitStopData_[targetID] = data;
-    }
+    void StartWithDuration(TimeHandle target, float duration);
 
-    void Stop(const std::string& targetID) {
-        auto it = hitStopData_.find(targetID);
-        if (it != hitStopData_.end()) {
-            it->second.isActive = false;
-        }
-    }
+    void Stop(TimeHandle target);
 
-    void StopAll() {
-        for (auto& [id, data] : hitStopData_) {
-            data.isActive = false;
-        }
-    }
+    void StopAll();
 
-    void Update(float deltaTime) {
-        for (auto& [id, data] : hitStopData_) {
-            if (data.isActive) {
-                data.currentTime += deltaTime;
-                if (data.currentTime >= data.duration) {
-                    data.isActive = false;
-                }
-            }
-        }
-    }
-
-    bool IsActive(const std::string& targetID) const {
-        auto it = hitStopData_.find(targetID);
-        return it != hitStopData_.end() && it->second.isActive;
-    }
+    bool IsActive(TimeHandle target) const;
 
-    float GetTimeScale(const std::string& targetID) const {
-        auto it = hitStopData_.find(targetID);
-        if (it != hitStopData_.end() && it->second.isActive) {
-            return 0.0f;  // ヒットストップ中
-        }
-        return 1.0f;  // 通常時
+    float GetTimeScale(TimeHandle target) const {
+        return IsActive(target) ? 0.0f : 1.0f;
     }
 
 private:
-    struct HitStopData {
-        float duration = 0.0f;    // ヒットストップの継続時間
-        float currentTime = 0.0f; // 経過時間
-        float timeScale = 1.0f;   // 時間スケール（0=停止、1=通常）
-        bool isActive = false;    // アクティブフラグ
-    };
+    friend class GameTime;
+
+    // GameTime の登録に合わせて配列を確保、解除
+    void Resize(size_t count) { remaining_.resize(count, 0.0f); }
+    void Clear(uint32_t index) { remaining_[index] = 0.0f; }
 
-    std::unordered_map<std::string, HitStopData> hitStopData_;
+    // 添字ごとの残り時間 (0以下で非アクティブ)
+    std::vector<float> remaining_;
 
     HitStop() = default;
     ~HitStop() = default;
     HitStop(const HitStop&) = delete;
     HitStop& operator=(const HitStop&) = delete;
-};
\ No newline at end of file
+};
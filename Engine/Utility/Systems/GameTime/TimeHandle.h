@@ -0,0 +1,8 @@
+#pragma once
+#include "Systems/Handle/GenerationalHandle.h"
+
+/// <summary>
+/// GameTime に登録した時間領域のハンドル
+/// </summary>
+using TimeHandle = GenerationalHandle;
+namespace TimeHandleUtil = GenerationalHandleUtil;
@@ -0,0 +1,30 @@
+#pragma once
+
+// C++
+#include <cstdint>
+
+/// <summary>
+/// 世代付きハンドル (GameTime の時間領域・テクスチャ・ディスクリプタで共通)
+/// 下位ビットが配列の添字、上位ビットが世代 (解放済みハンドルの検出用)
+/// </summary>
+using GenerationalHandle = uint32_t;
+
+namespace GenerationalHandleUtil {
+	constexpr uint32_t kIndexBits = 20;
+	constexpr uint32_t kIndexMask = (1u << kIndexBits) - 1u;
+	constexpr uint32_t kGenerationMask = (1u << (32u - kIndexBits)) - 1u;
+	constexpr GenerationalHandle kInvalid = 0xFFFFFFFFu;
+	// 払い出せる添字の上限 (kIndexMask は最後の世代で kInvalid と同じビットになるので使わない)
+	constexpr uint32_t kMaxIndex = kIndexMask - 1u;
+
+	constexpr uint32_t GetIndex(GenerationalHandle handle) { return handle & kIndexMask; }
+	constexpr uint32_t GetGeneration(GenerationalHandle handle) { return handle >> kIndexBits; }
+	constexpr GenerationalHandle Make(uint32_t index, uint32_t generation) {
+		return ((generation & kGenerationMask) << kIndexBits) | (index & kIndexMask);
+	}
+	// 世代を1つ進める (一周したら0に戻る)
+	constexpr uint32_t NextGeneration(uint32_t generation) { return (generation + 1) & kGenerationMask; }
+
+	static_assert(Make(kIndexMask, kGenerationMask) == kInvalid);
+	static_assert(Make(kMaxIndex, kGenerationMask) != kInvalid);
+}
@@ -1,5 +1,24 @@
 #include "Input.h"
 
+namespace {
+
+	/// <summary>
+	/// スティックとトリガーのデッドゾーン処理
+	/// </summary>
+	void ApplyDeadZone(XINPUT_GAMEPAD& gamepad)
+	{
+		// スティックのデッドゾーン処理
+		gamepad.sThumbLX = (std::abs(gamepad.sThumbLX) < XINPUT_GAMEPAD_LEFT_THUMB_DEADZONE) ? 0 : gamepad.sThumbLX;
+		gamepad.sThumbLY = (std::abs(gamepad.sThumbLY) < XINPUT_GAMEPAD_LEFT_THUMB_DEADZONE) ? 0 : gamepad.sThumbLY;
+		gamepad.sThumbRX = (std::abs(gamepad.sThumbRX) < XINPUT_GAMEPAD_RIGHT_THUMB_DEADZONE) ? 0 : gamepad.sThumbRX;
+		gamepad.sThumbRY = (std::abs(gamepad.sThumbRY) < XINPUT_GAMEPAD_RIGHT_THUMB_DEADZONE) ? 0 : gamepad.sThumbRY;
+
+		// トリガーのデッドゾーン処理
+		gamepad.bLeftTrigger = (gamepad.bLeftTrigger < XINPUT_GAMEPAD_TRIGGER_THRESHOLD) ? 0 : gamepad.bLeftTrigger;
+		gamepad.bRightTrigger = (gamepad.bRightTrigger < XINPUT_GAMEPAD_TRIGGER_THRESHOLD) ? 0 : gamepad.bRightTrigger;
+	}
+}
+
 Input* Input::instance = nullptr;
 Input* Input::GetInstance()
 {
@@ -11,6 +30,8 @@ Input* Input::GetInstance()
 
 void Input::Finalize()
 {
+	// 入力スレッドが機器を読み終えてから消す
+	samplingThread_.Stop();
 	delete instance;
 	instance = nullptr;
 }
@@ -54,20 +75,60 @@ void Input::Initialize(WinApp* winApp)
 		joystick.type_ = PadType::XInput;
 		devJoysticks_.push_back(joystick);
 	}
+
+	// 入力スレッドで読み始める
+	SetSamplingThreadEnabled(true);
+}
+
+/// <summary>
+/// 入力スレッドの切り替え
+/// </summary>
+void Input::SetSamplingThreadEnabled(bool enabled)
+{
+	if (enabled == samplingThread_.IsRunning()) {
+		return;
+	}
+	if (enabled) {
+		samplerPadConnected_.fill(false);
+		samplerPadRetry_.fill(0);
+		samplingThread_.Start([this](InputRecorder::Frame& frame) { SampleDevices(frame); }, kSamplingHz);
+	} else {
+		samplingThread_.Stop();
+	}
 }
 
 void Input::Update()
 {
-	HRESULT result;
+	// 前回の状態を保存
 	memcpy(keyPre, key, sizeof(key));
-	// キーボード情報の取得開始
-	result = keyboard->Acquire();
-	result = keyboard->GetDeviceState(sizeof(key), key);
+	mousePre_ = mouse_;
+	for (Joystick& joystick : devJoysticks_) {
+		joystick.statePre_ = joystick.state_;
+	}
 
-	// マウスの更新処理
-	mousePre_ = mouse_; // 前回のマウス状態を保存
-	result = devMouse_->Acquire();
-	result = devMouse_->GetDeviceState(sizeof(DIMOUSESTATE2), &mouse_);
+	// 再生中は機器を読まず、記録した入力を流す
+	InputRecorder* recorder = InputRecorder::GetInstance();
+	if (recorder->IsReplaying()) {
+		// 最後まで再生したら何も押していない状態にする
+		InputRecorder::Frame frame;
+		if (!recorder->ReadFrame(frame)) {
+			frame = {};
+		}
+		ApplyFrame(frame);
+		// 押していた時間は再生の速さに左右されないよう、ステップ数から出す
+		const int64_t stepNanoseconds = static_cast<int64_t>(static_cast<double>(recorder->GetFixedDeltaTime()) * 1'000'000'000.0);
+		UpdateEvents(frame, static_cast<int64_t>(recorder->GetFrameIndex()) * stepNanoseconds);
+		return;
+	}
+
+	if (samplingThread_.IsRunning()) {
+		// 入力スレッドが積んだイベントを反映する
+		ReadSamplingThread();
+	} else {
+		// スレッドを使わない時はここで機器を読む
+		PollDevices();
+		UpdateEvents(CaptureFrame(), InputEventState::GetTimestamp());
+	}
 
 	// マウスの位置を更新する
 	POINT point;
@@ -76,29 +137,208 @@ void Input::Update()
 	mousePosition_.x = static_cast<float>(point.x);
 	mousePosition_.y = static_cast<float>(point.y);
 
+	// 記録中なら、ゲーム側が読むのと同じ値を書き出す
+	if (recorder->IsRecording()) {
+		recorder->WriteFrame(CaptureFrame());
+	}
+}
+
+/// <summary>
+/// 機器をここで読む (入力スレッドを使わない時)
+/// </summary>
+void Input::PollDevices()
+{
+	HRESULT result;
+	// キーボード情報の取得開始
+	result = keyboard->Acquire();
+	result = keyboard->GetDeviceState(sizeof(key), key);
+
+	// マウスの更新処理
+	result = devMouse_->Acquire();
+	result = devMouse_->GetDeviceState(sizeof(DIMOUSESTATE2), &mouse_);
+
 	// XInputコントローラーの更新処理
 	for (int i = 0; i < 4; ++i) {
 		Joystick& joystick = devJoysticks_[i];
 
 		if (joystick.type_ == PadType::XInput) {
-			joystick.statePre_ = joystick.state_; // 前回の状態を保存
-
 			// XInputのステートを取得
-			if (XInputGetState(i, &joystick.state_.xInput_) == ERROR_SUCCESS) {
-				auto& gamepad = joystick.state_.xInput_.Gamepad;
-
-				// スティックのデッドゾーン処理
-				gamepad.sThumbLX = (std::abs(gamepad.sThumbLX) < XINPUT_GAMEPAD_LEFT_THUMB_DEADZONE) ? 0 : gamepad.sThumbLX;
-				gamepad.sThumbLY = (std::abs(gamepad.sThumbLY) < XINPUT_GAMEPAD_LEFT_THUMB_DEADZONE) ? 0 : gamepad.sThumbLY;
-				gamepad.sThumbRX = (std::abs(gamepad.sThumbRX) < XINPUT_GAMEPAD_RIGHT_THUMB_DEADZONE) ? 0 : gamepad.sThumbRX;
-				gamepad.sThumbRY = (std::abs(gamepad.sThumbRY) < XINPUT_GAMEPAD_RIGHT_THUMB_DEADZONE) ? 0 : gamepad.sThumbRY;
-
-				// トリガーのデッドゾーン処理
-				gamepad.bLeftTrigger = (gamepad.bLeftTrigger < XINPUT_GAMEPAD_TRIGGER_THRESHOLD) ? 0 : gamepad.bLeftTrigger;
-				gamepad.bRightTrigger = (gamepad.bRightTrigger < XINPUT_GAMEPAD_TRIGGER_THRESHOLD) ? 0 : gamepad.bRightTrigger;
+			padConnected_[i] = XInputGetState(i, &joystick.state_.xInput_) == ERROR_SUCCESS;
+			if (padConnected_[i]) {
+				ApplyDeadZone(joystick.state_.xInput_.Gamepad);
+			}
+		}
+	}
+}
+
+/// <summary>
+/// 機器を1回読む (入力スレッドで呼ぶ)
+/// </summary>
+void Input::SampleDevices(InputRecorder::Frame& frame)
+{
+	// キーボード (読めなければ全部離している扱い)
+	BYTE keys[InputRecorder::kKeyCount] = {};
+	keyboard->Acquire();
+	keyboard->GetDeviceState(sizeof(keys), keys);
+	for (uint32_t i = 0; i < InputRecorder::kKeyCount; ++i) {
+		frame.SetKeyDown(i, keys[i] != 0);
+	}
+
+	// マウス (移動量は前回読んでからの分)
+	DIMOUSESTATE2 mouse = {};
+	devMouse_->Acquire();
+	devMouse_->GetDeviceState(sizeof(DIMOUSESTATE2), &mouse);
+	frame.mouseMoveX = mouse.lX;
+	frame.mouseMoveY = mouse.lY;
+	frame.mouseMoveZ = mouse.lZ;
+	for (uint32_t i = 0; i < InputRecorder::kMouseButtonCount; ++i) {
+		if (mouse.rgbButtons[i] & 0x80) {
+			frame.mouseButtons |= static_cast<uint8_t>(1 << i);
+		}
+	}
+
+	// パッド (繋がっていないパッドを読むのは重いので、間を空けて確かめる)
+	for (uint32_t i = 0; i < InputRecorder::kPadCount; ++i) {
+		if (!samplerPadConnected_[i] && samplerPadRetry_[i] > 0) {
+			--samplerPadRetry_[i];
+			continue;
+		}
+		XINPUT_STATE state = {};
+		samplerPadConnected_[i] = XInputGetState(i, &state) == ERROR_SUCCESS;
+		if (!samplerPadConnected_[i]) {
+			samplerPadRetry_[i] = kDisconnectedPadRetryPolls;
+			continue;
+		}
+		ApplyDeadZone(state.Gamepad);
+
+		InputRecorder::PadState& pad = frame.pads[i];
+		pad.connected = true;
+		pad.buttons = state.Gamepad.wButtons;
+		pad.leftTrigger = state.Gamepad.bLeftTrigger;
+		pad.rightTrigger = state.Gamepad.bRightTrigger;
+		pad.thumbLX = state.Gamepad.sThumbLX;
+		pad.thumbLY = state.Gamepad.sThumbLY;
+		pad.thumbRX = state.Gamepad.sThumbRX;
+		pad.thumbRY = state.Gamepad.sThumbRY;
+	}
+}
+
+/// <summary>
+/// 入力スレッドが積んだイベントを反映する
+/// </summary>
+void Input::ReadSamplingThread()
+{
+	eventState_.BeginFrame(InputEventState::GetTimestamp());
+	InputEvent event;
+	while (samplingThread_.TryPopEvent(event)) {
+		eventState_.Apply(event);
+	}
+
+	// スティックなどは最後に読んだ値、ボタンはイベントから作った状態
+	// フレームの間に押して離したボタンも、このフレームは押されていたことにする (トリガーを取りこぼさない)
+	InputRecorder::Frame frame = samplingThread_.GetLatest();
+	for (uint32_t i = 0; i < InputRecorder::kKeyCount; ++i) {
+		frame.SetKeyDown(i, eventState_.IsHeldThisFrame(InputEventState::KeyButton(i)));
+	}
+	frame.mouseButtons = 0;
+	for (uint32_t i = 0; i < InputRecorder::kMouseButtonCount; ++i) {
+		if (eventState_.IsHeldThisFrame(InputEventState::MouseButton(i))) {
+			frame.mouseButtons |= static_cast<uint8_t>(1 << i);
+		}
+	}
+	for (uint32_t pad = 0; pad < InputRecorder::kPadCount; ++pad) {
+		frame.pads[pad].buttons = 0;
+		for (uint32_t bit = 0; bit < InputEventState::kPadButtonCount; ++bit) {
+			if (eventState_.IsHeldThisFrame(InputEventState::PadButton(pad, bit))) {
+				frame.pads[pad].buttons |= static_cast<uint16_t>(1 << bit);
 			}
 		}
 	}
+	samplingThread_.TakeMouseMove(frame.mouseMoveX, frame.mouseMoveY, frame.mouseMoveZ);
+
+	ApplyFrame(frame);
+	polledFrame_ = frame;
+}
+
+/// <summary>
+/// 前回からのボタンの変化をイベントにして反映する (入力スレッドを使わない時と再生中)
+/// </summary>
+void Input::UpdateEvents(const InputRecorder::Frame& frame, int64_t timestamp)
+{
+	eventState_.BeginFrame(timestamp);
+	const uint32_t count = InputEventState::Diff(polledFrame_, frame, timestamp, diffEvents_.data());
+	for (uint32_t i = 0; i < count; ++i) {
+		eventState_.Apply(diffEvents_[i]);
+	}
+	polledFrame_ = frame;
+}
+
+/// <summary>
+/// 今のステップの入力を記録用にまとめる
+/// </summary>
+InputRecorder::Frame Input::CaptureFrame() const
+{
+	InputRecorder::Frame frame;
+	for (uint32_t i = 0; i < InputRecorder::kKeyCount; ++i) {
+		frame.SetKeyDown(i, key[i] != 0);
+	}
+	for (uint32_t i = 0; i < InputRecorder::kMouseButtonCount; ++i) {
+		if (mouse_.rgbButtons[i] & 0x80) {
+			frame.mouseButtons |= static_cast<uint8_t>(1 << i);
+		}
+	}
+	frame.mouseMoveX = mouse_.lX;
+	frame.mouseMoveY = mouse_.lY;
+	frame.mouseMoveZ = mouse_.lZ;
+	frame.cursorX = static_cast<int32_t>(mousePosition_.x);
+	frame.cursorY = static_cast<int32_t>(mousePosition_.y);
+
+	// 繋がっていないパッドも、残っている値をそのまま残す
+	for (uint32_t i = 0; i < InputRecorder::kPadCount; ++i) {
+		const XINPUT_GAMEPAD& gamepad = devJoysticks_[i].state_.xInput_.Gamepad;
+		InputRecorder::PadState& pad = frame.pads[i];
+		pad.connected = padConnected_[i];
+		pad.buttons = gamepad.wButtons;
+		pad.leftTrigger = gamepad.bLeftTrigger;
+		pad.rightTrigger = gamepad.bRightTrigger;
+		pad.thumbLX = gamepad.sThumbLX;
+		pad.thumbLY = gamepad.sThumbLY;
+		pad.thumbRX = gamepad.sThumbRX;
+		pad.thumbRY = gamepad.sThumbRY;
+	}
+	return frame;
+}
+
+/// <summary>
+/// 記録した入力を機器から読んだ値の代わりに入れる
+/// </summary>
+void Input::ApplyFrame(const InputRecorder::Frame& frame)
+{
+	for (uint32_t i = 0; i < InputRecorder::kKeyCount; ++i) {
+		key[i] = frame.IsKeyDown(i) ? 0x80 : 0;
+	}
+	mouse_ = {};
+	for (uint32_t i = 0; i < InputRecorder::kMouseButtonCount; ++i) {
+		mouse_.rgbButtons[i] = (frame.mouseButtons >> i) & 1 ? 0x80 : 0;
+	}
+	mouse_.lX = frame.mouseMoveX;
+	mouse_.lY = frame.mouseMoveY;
+	mouse_.lZ = frame.mouseMoveZ;
+	mousePosition_.x = static_cast<float>(frame.cursorX);
+	mousePosition_.y = static_cast<float>(frame.cursorY);
+
+	for (uint32_t i = 0; i < InputRecorder::kPadCount; ++i) {
+		const InputRecorder::PadState& pad = frame.pads[i];
+		XINPUT_GAMEPAD& gamepad = devJoysticks_[i].state_.xInput_.Gamepad;
+		padConnected_[i] = pad.connected;
+		gamepad.wButtons = pad.buttons;
+		gamepad.bLeftTrigger = pad.leftTrigger;
+		gamepad.bRightTrigger = pad.rightTrigger;
+		gamepad.sThumbLX = pad.thumbLX;
+		gamepad.sThumbLY = pad.thumbLY;
+		gamepad.sThumbRX = pad.thumbRX;
+		gamepad.sThumbRY = pad.thumbRY;
+	}
 }
 
 /// <summary>
@@ -131,17 +371,8 @@ bool Input::TriggerKey(BYTE keyNumber)
 /// </summary>
 int32_t Input::GetKeyPressDuration(BYTE keyNumber)
 {
-	auto now = std::chrono::steady_clock::now();
-	if (PushKey(keyNumber)) {
-		if (keyPressStart[keyNumber] == std::chrono::steady_clock::time_point()) {
-			keyPressStart[keyNumber] = now;
-		}
-		return static_cast<int32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now - keyPressStart[keyNumber]).count());
-	}
-	else {
-		keyPressStart[keyNumber] = std::chrono::steady_clock::time_point();
-		return 0;
-	}
+	// 押された時刻からこのフレームの時刻まで (イベントの時刻から出すので、フレームの区切りに丸められない)
+	return static_cast<int32_t>(eventState_.GetHoldDuration(InputEventState::KeyButton(keyNumber)) / 1'000'000);
 }
 
 /// <summary>
@@ -149,7 +380,8 @@ int32_t Input::GetKeyPressDuration(BYTE keyNumber)
 /// </summary>
 bool Input::BufferedKeyPress(BYTE keyNumber)
 {
-	return TriggerKey(keyNumber);
+	// 押しっぱなしの間にフレーム内で離して押し直したのも拾う
+	return eventState_.WasPressed(InputEventState::KeyButton(keyNumber));
 }
 
 /// <summary>
@@ -388,13 +620,10 @@ Vector2 Input::GetRightStickInput(int32_t stickNo) const
 	};
 }
 
-bool Input::IsControllerConnected()
+bool Input::IsControllerConnected() const
 {
-	XINPUT_STATE state; ZeroMemory(&state, sizeof(XINPUT_STATE));
-	// コントローラの状態を取得
-	DWORD result = XInputGetState(0, &state);
-	// コントローラが接続されている場合は true を返す
-	return (result == ERROR_SUCCESS);
+	// Update で取得した状態を返す (再生中は記録した状態)
+	return padConnected_[0];
 }
 
 /// <summary>
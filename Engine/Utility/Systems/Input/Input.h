@@ -12,6 +12,9 @@
 
 // Engine
 #include "WinApp./WinApp.h"
+#include "InputEventState.h"
+#include "InputRecorder.h"
+#include "InputThread.h"
 
 // Math
 #include "Vector2.h"
@@ -82,6 +85,18 @@ public:
     /// </summary>
     void Update();
 
+    /// <summary>
+    /// 入力スレッドの切り替え (切ると Update で機器を直接読む)
+    /// </summary>
+    void SetSamplingThreadEnabled(bool enabled);
+    bool IsSamplingThreadEnabled() const { return samplingThread_.IsRunning(); }
+    InputThread::Stats GetSamplingThreadStats() const { return samplingThread_.GetStats(); }
+
+    /// <summary>
+    /// イベントから作ったボタンの状態 (押した時刻・押していた時間をナノ秒で引ける)
+    /// </summary>
+    const InputEventState& GetEventState() const { return eventState_; }
+
     // ========================== キーボード ==========================//
 
     /// <summary>
@@ -102,7 +117,7 @@ public:
     /// 特定のキーが押され続けている時間を取得する
     /// </summary>
     /// <param name="keyNumber">キー番号</param>
-    /// <returns>押され続けているフレーム数</returns>
+    /// <returns>押され続けているミリ秒 (押された時刻からこのフレームの Update まで)</returns>
     int32_t GetKeyPressDuration(BYTE keyNumber);
 
     /// <summary>
@@ -262,10 +277,10 @@ public:
 
 
     /// <summary>
-    /// コントローラーの接続確認
+    /// コントローラーの接続確認 (Update で取得した0番のパッドの状態)
     /// </summary>
     /// <returns></returns>
-    static bool IsControllerConnected();
+    bool IsControllerConnected() const;
 
     /// <summary>
     /// 左スティックの入力があるか
@@ -279,6 +294,38 @@ public:
     /// <returns></returns>
     bool IsRightStickMoving();
 
+private:
+
+    /// <summary>
+    /// 機器をここで読む (入力スレッドを使わない時)
+    /// </summary>
+    void PollDevices();
+
+    /// <summary>
+    /// 機器を1回読む (入力スレッドで呼ぶ)
+    /// </summary>
+    void SampleDevices(InputRecorder::Frame& frame);
+
+    /// <summary>
+    /// 入力スレッドが積んだイベントを反映する
+    /// </summary>
+    void ReadSamplingThread();
+
+    /// <summary>
+    /// 前回からのボタンの変化をイベントにして反映する (入力スレッドを使わない時と再生中)
+    /// </summary>
+    void UpdateEvents(const InputRecorder::Frame& frame, int64_t timestamp);
+
+    /// <summary>
+    /// 今のステップの入力を記録用にまとめる
+    /// </summary>
+    InputRecorder::Frame CaptureFrame() const;
+
+    /// <summary>
+    /// 記録した入力を機器から読んだ値の代わりに入れる
+    /// </summary>
+    void ApplyFrame(const InputRecorder::Frame& frame);
+
 private:
 
     static Input* instance;
@@ -290,8 +337,6 @@ private:
     BYTE key[256] = {};
     // 前回のキーの状態
     BYTE keyPre[256] = {};
-    // キー押下時間を記録する
-    std::chrono::steady_clock::time_point keyPressStart[256] = {};
     // WindowsAPI
     WinApp* winApp_ = nullptr;
 
@@ -301,4 +346,24 @@ private:
     Vector2 mousePosition_;
 
     std::vector<Joystick> devJoysticks_;
+    // XInputのパッドが繋がっているか
+    std::array<bool, InputRecorder::kPadCount> padConnected_ = {};
+
+    // 入力スレッドが1秒に機器を読む回数
+    static constexpr uint32_t kSamplingHz = 1000;
+    // 繋がっていないパッドを確かめ直すまでに飛ばす回数
+    static constexpr uint32_t kDisconnectedPadRetryPolls = 250;
+
+    // イベントから作ったボタンの状態
+    InputEventState eventState_;
+    // 前回の Update のボタンの状態 (イベントを作る基準)
+    InputRecorder::Frame polledFrame_;
+    std::array<InputEvent, InputEventState::kMaxDiffEvents> diffEvents_ = {};
+
+    // ここから下は入力スレッドだけが触る
+    std::array<bool, InputRecorder::kPadCount> samplerPadConnected_ = {};
+    std::array<uint32_t, InputRecorder::kPadCount> samplerPadRetry_ = {};
+
+    // 入力スレッド (機器より先に止まるよう最後に置く)
+    InputThread samplingThread_;
 };
@@ -0,0 +1,107 @@
+#include "InputEventState.h"
+
+// C++
+#include <algorithm>
+#include <bit>
+#include <chrono>
+
+/// <summary>
+/// 今の時刻
+/// </summary>
+int64_t InputEventState::GetTimestamp()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// <summary>
+/// 2つの入力の間で変わったボタンをイベントにする
+/// </summary>
+uint32_t InputEventState::Diff(const InputRecorder::Frame& previous, const InputRecorder::Frame& current, int64_t timestamp, InputEvent* out)
+{
+	uint32_t count = 0;
+
+	// キーは8個ずつ比べ、変わったバイトだけ見る
+	for (uint32_t byte = 0; byte < current.keys.size(); ++byte) {
+		uint32_t changed = previous.keys[byte] ^ current.keys[byte];
+		while (changed) {
+			const uint32_t bit = static_cast<uint32_t>(std::countr_zero(changed));
+			changed &= changed - 1;
+			out[count++] = { timestamp, KeyButton(byte * 8 + bit), ((current.keys[byte] >> bit) & 1) != 0 };
+		}
+	}
+
+	uint32_t changedMouse = previous.mouseButtons ^ current.mouseButtons;
+	while (changedMouse) {
+		const uint32_t bit = static_cast<uint32_t>(std::countr_zero(changedMouse));
+		changedMouse &= changedMouse - 1;
+		out[count++] = { timestamp, MouseButton(bit), ((current.mouseButtons >> bit) & 1) != 0 };
+	}
+
+	for (uint32_t pad = 0; pad < InputRecorder::kPadCount; ++pad) {
+		uint32_t changedPad = previous.pads[pad].buttons ^ current.pads[pad].buttons;
+		while (changedPad) {
+			const uint32_t bit = static_cast<uint32_t>(std::countr_zero(changedPad));
+			changedPad &= changedPad - 1;
+			out[count++] = { timestamp, PadButton(pad, bit), ((current.pads[pad].buttons >> bit) & 1) != 0 };
+		}
+	}
+	return count;
+}
+
+/// <summary>
+/// 全部離した状態に戻す
+/// </summary>
+void InputEventState::Reset()
+{
+	*this = {};
+}
+
+/// <summary>
+/// フレームの始まり
+/// </summary>
+void InputEventState::BeginFrame(int64_t now)
+{
+	frameTimestamp_ = now;
+	pressCount_.fill(0);
+	releaseCount_.fill(0);
+}
+
+/// <summary>
+/// イベントを1つ反映する
+/// </summary>
+void InputEventState::Apply(const InputEvent& event)
+{
+	if (event.button >= kButtonCount) {
+		return;
+	}
+	// フレームの時刻を取った後に起きたイベントなら、フレームの時刻をそこまで進める
+	frameTimestamp_ = (std::max)(frameTimestamp_, event.timestamp);
+
+	const uint16_t button = event.button;
+	if (event.down) {
+		if (down_[button]) {
+			return;
+		}
+		down_[button] = 1;
+		pressTimestamp_[button] = event.timestamp;
+		pressCount_[button] = static_cast<uint8_t>((std::min)(pressCount_[button] + 1, 0xFF));
+	} else {
+		if (!down_[button]) {
+			return;
+		}
+		down_[button] = 0;
+		lastHoldDuration_[button] = (std::max)(event.timestamp - pressTimestamp_[button], int64_t(0));
+		releaseCount_[button] = static_cast<uint8_t>((std::min)(releaseCount_[button] + 1, 0xFF));
+	}
+}
+
+/// <summary>
+/// 押され続けている時間
+/// </summary>
+int64_t InputEventState::GetHoldDuration(uint16_t button) const
+{
+	if (button >= kButtonCount || !down_[button]) {
+		return 0;
+	}
+	return (std::max)(frameTimestamp_ - pressTimestamp_[button], int64_t(0));
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+// C++
+#include <array>
+#include <cstdint>
+
+// Engine
+#include "InputRecorder.h"
+
+/// <summary>
+/// ボタン1つが押された・離された瞬間 (時刻はナノ秒)
+/// </summary>
+struct InputEvent {
+	int64_t timestamp = 0;	// 起きた時刻 (InputEventState::GetTimestamp と同じ時計)
+	uint16_t button = 0;	// InputEventState の通し番号
+	bool down = false;		// 押されたか (false なら離された)
+};
+
+/// <summary>
+/// 時刻付きのイベントからボタンの状態を作る
+/// フレームの間に押して離した短い入力も「このフレームで押された」として残し、
+/// 押していた時間はフレームの区切りではなくイベントの時刻から出す
+/// 機器に触らないので、イベントを手で積めばそのまま確かめられる
+/// </summary>
+class InputEventState
+{
+public: // 定数
+
+	// ボタンの通し番号 (キーボード・マウス・パッドの順)
+	static constexpr uint32_t kKeyboardBase = 0;
+	static constexpr uint32_t kMouseBase = kKeyboardBase + InputRecorder::kKeyCount;
+	static constexpr uint32_t kPadBase = kMouseBase + InputRecorder::kMouseButtonCount;
+	static constexpr uint32_t kPadButtonCount = 16;
+	static constexpr uint32_t kButtonCount = kPadBase + InputRecorder::kPadCount * kPadButtonCount;
+
+	static constexpr uint16_t KeyButton(uint32_t key) { return static_cast<uint16_t>(kKeyboardBase + key); }
+	static constexpr uint16_t MouseButton(uint32_t button) { return static_cast<uint16_t>(kMouseBase + button); }
+	static constexpr uint16_t PadButton(uint32_t pad, uint32_t bit) { return static_cast<uint16_t>(kPadBase + pad * kPadButtonCount + bit); }
+
+	// 1回の比較で出るイベントの最大数
+	static constexpr uint32_t kMaxDiffEvents = kButtonCount;
+
+public: // メンバ関数
+
+	/// <summary>
+	/// 今の時刻 (ナノ秒、steady_clock)
+	/// </summary>
+	static int64_t GetTimestamp();
+
+	/// <summary>
+	/// 2つの入力の間で変わったボタンをイベントにする
+	/// </summary>
+	/// <param name="out">kMaxDiffEvents 個以上の配列</param>
+	/// <returns>書いたイベントの数</returns>
+	static uint32_t Diff(const InputRecorder::Frame& previous, const InputRecorder::Frame& current, int64_t timestamp, InputEvent* out);
+
+	/// <summary>
+	/// 全部離した状態に戻す
+	/// </summary>
+	void Reset();
+
+	/// <summary>
+	/// フレームの始まり (前のフレームの押した・離したを消し、時間の基準を now にする)
+	/// </summary>
+	void BeginFrame(int64_t now);
+
+	/// <summary>
+	/// イベントを1つ反映する (押しているのに押された等の重複は無視する)
+	/// </summary>
+	void Apply(const InputEvent& event);
+
+	// 今押されているか
+	bool IsDown(uint16_t button) const { return down_[button] != 0; }
+	// 今押されているか、このフレームの間に押された (短い押しを取りこぼさない)
+	bool IsHeldThisFrame(uint16_t button) const { return down_[button] != 0 || pressCount_[button] > 0; }
+	// このフレームの間に押されたか
+	bool WasPressed(uint16_t button) const { return pressCount_[button] > 0; }
+	// このフレームの間に離されたか
+	bool WasReleased(uint16_t button) const { return releaseCount_[button] > 0; }
+	// このフレームの間に押された回数
+	uint32_t GetPressCount(uint16_t button) const { return pressCount_[button]; }
+
+	/// <summary>
+	/// 押され続けている時間 (ナノ秒、フレームの時刻まで。押されていなければ0)
+	/// </summary>
+	int64_t GetHoldDuration(uint16_t button) const;
+
+	/// <summary>
+	/// 最後に離した時に押していた時間 (ナノ秒)
+	/// </summary>
+	int64_t GetLastHoldDuration(uint16_t button) const { return lastHoldDuration_[button]; }
+
+	// 押された時刻 (押されていなければ0)
+	int64_t GetPressTimestamp(uint16_t button) const { return down_[button] ? pressTimestamp_[button] : 0; }
+	// フレームの時刻
+	int64_t GetFrameTimestamp() const { return frameTimestamp_; }
+
+private: // メンバ変数
+
+	int64_t frameTimestamp_ = 0;
+	std::array<uint8_t, kButtonCount> down_ = {};
+	std::array<uint8_t, kButtonCount> pressCount_ = {};
+	std::array<uint8_t, kButtonCount> releaseCount_ = {};
+	std::array<int64_t, kButtonCount> pressTimestamp_ = {};
+	std::array<int64_t, kButtonCount> lastHoldDuration_ = {};
+};
@@ -0,0 +1,384 @@
+#include "InputRecorder.h"
+
+// C++
+#include <cstdlib>
+#include <cstring>
+
+// Engine
+#include "DX./DirectXCommon.h"
+
+namespace {
+
+	// ファイルの先頭
+	constexpr char kMagic[4] = { 'Y', 'R', 'I', 'N' };
+	constexpr uint32_t kVersion = 1;
+	// マジック・バージョン・シード・1ステップの秒数・ステップ数
+	constexpr size_t kHeaderSize = 20;
+	constexpr size_t kFrameCountOffset = 16;
+
+	// 1ステップの先頭に置く、前のステップから変わった所のビット
+	constexpr uint8_t kChangedKeys = 1 << 0;
+	constexpr uint8_t kChangedMouseButtons = 1 << 1;
+	constexpr uint8_t kChangedMouseMove = 1 << 2;
+	constexpr uint8_t kChangedCursor = 1 << 3;
+	constexpr uint8_t kChangedPadShift = 4;	// パッド i は 1 << (4 + i)
+
+	// パッド1つ分のバイト数
+	constexpr size_t kPadSize = 13;
+
+	void Put16(std::vector<uint8_t>& out, uint16_t value) {
+		out.push_back(static_cast<uint8_t>(value));
+		out.push_back(static_cast<uint8_t>(value >> 8));
+	}
+	void Put32(std::vector<uint8_t>& out, uint32_t value) {
+		for (int i = 0; i < 4; ++i) {
+			out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+		}
+	}
+	uint16_t Get16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | p[1] << 8); }
+	uint32_t Get32(const uint8_t* p) { return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24; }
+
+	// 小さい値ほど短くなる可変長 (7bitずつ)
+	void PutVarint(std::vector<uint8_t>& out, uint32_t value) {
+		while (value >= 0x80) {
+			out.push_back(static_cast<uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+		out.push_back(static_cast<uint8_t>(value));
+	}
+	// 符号付きは 0, -1, 1, -2 ... の順に並べ替えて可変長にする
+	uint32_t ZigZag(int32_t value) { return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31); }
+	int32_t UnZigZag(uint32_t value) { return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1); }
+}
+
+InputRecorder* InputRecorder::GetInstance()
+{
+	static InputRecorder instance;
+	return &instance;
+}
+
+InputRecorder::~InputRecorder()
+{
+	Stop();
+}
+
+/// <summary>
+/// 起動引数を読む
+/// </summary>
+InputRecorder::Options InputRecorder::ParseCommandLine(const std::string& commandLine)
+{
+	// 空白で区切る ("" で囲めば空白を含むパスも渡せる)
+	std::vector<std::string> tokens;
+	std::string token;
+	bool quoted = false;
+	bool hasToken = false;
+	for (char c : commandLine) {
+		if (c == '"') {
+			quoted = !quoted;
+			hasToken = true;
+		} else if ((c == ' ' || c == '\t') && !quoted) {
+			if (hasToken) {
+				tokens.push_back(token);
+			}
+			token.clear();
+			hasToken = false;
+		} else {
+			token += c;
+			hasToken = true;
+		}
+	}
+	if (hasToken) {
+		tokens.push_back(token);
+	}
+
+	Options options;
+	for (size_t i = 0; i + 1 < tokens.size(); ++i) {
+		const std::string& name = tokens[i];
+		const std::string& value = tokens[i + 1];
+		if (name == kRecordArgument) {
+			options.mode = Mode::kRecording;
+			options.logPath = value;
+		} else if (name == kReplayArgument) {
+			options.mode = Mode::kReplaying;
+			options.logPath = value;
+		} else if (name == kSeedArgument) {
+			options.hasSeed = true;
+			options.seed = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 0));
+		} else if (name == kTimingArgument) {
+			options.timingPath = value;
+		} else {
+			continue;
+		}
+		++i;
+	}
+	if (options.mode == Mode::kReplaying && options.timingPath.empty()) {
+		options.timingPath = options.logPath + ".csv";
+	}
+	return options;
+}
+
+/// <summary>
+/// 記録を始める
+/// </summary>
+bool InputRecorder::StartRecording(const std::string& filePath, uint32_t seed, float fixedDeltaTime)
+{
+	Stop();
+	output_.open(filePath, std::ios::binary | std::ios::trunc);
+	if (!output_) {
+		DirectXCommon::Log("InputRecorder: failed to open " + filePath + " for recording\n");
+		return false;
+	}
+
+	// ステップ数は閉じる時に書き込む (途中で落ちたら0のまま残り、再生側は最後まで読む)
+	std::vector<uint8_t> header(kMagic, kMagic + sizeof(kMagic));
+	Put32(header, kVersion);
+	Put32(header, seed);
+	uint32_t deltaBits = 0;
+	std::memcpy(&deltaBits, &fixedDeltaTime, sizeof(deltaBits));
+	Put32(header, deltaBits);
+	Put32(header, 0);
+	output_.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+	mode_ = Mode::kRecording;
+	seed_ = seed;
+	fixedDeltaTime_ = fixedDeltaTime;
+	frameIndex_ = 0;
+	frameCount_ = 0;
+	byteCount_ = header.size();
+	finished_ = false;
+	previous_ = {};
+	return true;
+}
+
+/// <summary>
+/// 再生を始める
+/// </summary>
+bool InputRecorder::StartReplay(const std::string& filePath)
+{
+	Stop();
+	std::ifstream input(filePath, std::ios::binary | std::ios::ate);
+	if (!input) {
+		DirectXCommon::Log("InputRecorder: failed to open " + filePath + " for replay\n");
+		return false;
+	}
+	replayData_.resize(static_cast<size_t>(input.tellg()));
+	input.seekg(0);
+	input.read(reinterpret_cast<char*>(replayData_.data()), replayData_.size());
+
+	if (!input || replayData_.size() < kHeaderSize || std::memcmp(replayData_.data(), kMagic, sizeof(kMagic)) != 0 ||
+		Get32(replayData_.data() + 4) != kVersion) {
+		DirectXCommon::Log("InputRecorder: " + filePath + " is not an input recording\n");
+		replayData_.clear();
+		return false;
+	}
+
+	mode_ = Mode::kReplaying;
+	seed_ = Get32(replayData_.data() + 8);
+	const uint32_t deltaBits = Get32(replayData_.data() + 12);
+	std::memcpy(&fixedDeltaTime_, &deltaBits, sizeof(fixedDeltaTime_));
+	frameCount_ = Get32(replayData_.data() + kFrameCountOffset);
+	frameIndex_ = 0;
+	byteCount_ = replayData_.size();
+	readOffset_ = kHeaderSize;
+	finished_ = readOffset_ == replayData_.size();
+	previous_ = {};
+	return true;
+}
+
+/// <summary>
+/// 記録・再生を終える
+/// </summary>
+void InputRecorder::Stop()
+{
+	if (mode_ == Mode::kRecording) {
+		// ステップ数を埋める
+		std::vector<uint8_t> count;
+		Put32(count, frameIndex_);
+		output_.seekp(kFrameCountOffset);
+		output_.write(reinterpret_cast<const char*>(count.data()), count.size());
+		output_.close();
+		DirectXCommon::Log("InputRecorder: recorded " + std::to_string(frameIndex_) + " frames (" + std::to_string(byteCount_) + " bytes)\n");
+	}
+	mode_ = Mode::kNone;
+	replayData_.clear();
+	replayData_.shrink_to_fit();
+	readOffset_ = 0;
+}
+
+/// <summary>
+/// 1ステップ分を書き出す
+/// </summary>
+void InputRecorder::WriteFrame(const Frame& frame)
+{
+	if (mode_ != Mode::kRecording) {
+		return;
+	}
+
+	std::vector<uint8_t>& out = encodeBuffer_;
+	out.clear();
+	out.push_back(0);
+	uint8_t changed = 0;
+
+	// キーは変わったバイトだけ (番号と値の組)
+	uint8_t changedKeyBytes = 0;
+	for (size_t i = 0; i < frame.keys.size(); ++i) {
+		changedKeyBytes += frame.keys[i] != previous_.keys[i];
+	}
+	if (changedKeyBytes > 0) {
+		changed |= kChangedKeys;
+		out.push_back(changedKeyBytes);
+		for (size_t i = 0; i < frame.keys.size(); ++i) {
+			if (frame.keys[i] != previous_.keys[i]) {
+				out.push_back(static_cast<uint8_t>(i));
+				out.push_back(frame.keys[i]);
+			}
+		}
+	}
+
+	if (frame.mouseButtons != previous_.mouseButtons) {
+		changed |= kChangedMouseButtons;
+		out.push_back(frame.mouseButtons);
+	}
+
+	// 移動量はステップごとの値なので、動いた時だけ書く
+	if (frame.mouseMoveX != 0 || frame.mouseMoveY != 0 || frame.mouseMoveZ != 0) {
+		changed |= kChangedMouseMove;
+		PutVarint(out, ZigZag(frame.mouseMoveX));
+		PutVarint(out, ZigZag(frame.mouseMoveY));
+		PutVarint(out, ZigZag(frame.mouseMoveZ));
+	}
+
+	// カーソルは前のステップからの差
+	if (frame.cursorX != previous_.cursorX || frame.cursorY != previous_.cursorY) {
+		changed |= kChangedCursor;
+		PutVarint(out, ZigZag(frame.cursorX - previous_.cursorX));
+		PutVarint(out, ZigZag(frame.cursorY - previous_.cursorY));
+	}
+
+	for (uint32_t i = 0; i < kPadCount; ++i) {
+		const PadState& pad = frame.pads[i];
+		if (pad == previous_.pads[i]) {
+			continue;
+		}
+		changed |= static_cast<uint8_t>(1 << (kChangedPadShift + i));
+		out.push_back(pad.connected ? 1 : 0);
+		Put16(out, pad.buttons);
+		out.push_back(pad.leftTrigger);
+		out.push_back(pad.rightTrigger);
+		Put16(out, static_cast<uint16_t>(pad.thumbLX));
+		Put16(out, static_cast<uint16_t>(pad.thumbLY));
+		Put16(out, static_cast<uint16_t>(pad.thumbRX));
+		Put16(out, static_cast<uint16_t>(pad.thumbRY));
+	}
+
+	// 何も変わらないステップは1バイト
+	out[0] = changed;
+	output_.write(reinterpret_cast<const char*>(out.data()), out.size());
+	byteCount_ += out.size();
+	previous_ = frame;
+	++frameIndex_;
+}
+
+/// <summary>
+/// 1ステップ分を取り出す
+/// </summary>
+bool InputRecorder::ReadFrame(Frame& outFrame)
+{
+	if (mode_ != Mode::kReplaying || finished_) {
+		return false;
+	}
+
+	Frame frame = previous_;
+	frame.mouseMoveX = 0;
+	frame.mouseMoveY = 0;
+	frame.mouseMoveZ = 0;
+
+	uint8_t changed = 0;
+	bool valid = ReadBytes(&changed, 1);
+
+	if (valid && (changed & kChangedKeys)) {
+		uint8_t count = 0;
+		valid = ReadBytes(&count, 1);
+		for (uint8_t i = 0; valid && i < count; ++i) {
+			uint8_t pair[2] = {};
+			valid = ReadBytes(pair, sizeof(pair)) && pair[0] < frame.keys.size();
+			if (valid) {
+				frame.keys[pair[0]] = pair[1];
+			}
+		}
+	}
+	if (valid && (changed & kChangedMouseButtons)) {
+		valid = ReadBytes(&frame.mouseButtons, 1);
+	}
+	if (valid && (changed & kChangedMouseMove)) {
+		uint32_t x = 0, y = 0, z = 0;
+		valid = ReadVarint(x) && ReadVarint(y) && ReadVarint(z);
+		frame.mouseMoveX = UnZigZag(x);
+		frame.mouseMoveY = UnZigZag(y);
+		frame.mouseMoveZ = UnZigZag(z);
+	}
+	if (valid && (changed & kChangedCursor)) {
+		uint32_t x = 0, y = 0;
+		valid = ReadVarint(x) && ReadVarint(y);
+		frame.cursorX += UnZigZag(x);
+		frame.cursorY += UnZigZag(y);
+	}
+	for (uint32_t i = 0; valid && i < kPadCount; ++i) {
+		if (!(changed & (1 << (kChangedPadShift + i)))) {
+			continue;
+		}
+		uint8_t bytes[kPadSize] = {};
+		valid = ReadBytes(bytes, sizeof(bytes));
+		PadState& pad = frame.pads[i];
+		pad.connected = bytes[0] != 0;
+		pad.buttons = Get16(bytes + 1);
+		pad.leftTrigger = bytes[3];
+		pad.rightTrigger = bytes[4];
+		pad.thumbLX = static_cast<int16_t>(Get16(bytes + 5));
+		pad.thumbLY = static_cast<int16_t>(Get16(bytes + 7));
+		pad.thumbRX = static_cast<int16_t>(Get16(bytes + 9));
+		pad.thumbRY = static_cast<int16_t>(Get16(bytes + 11));
+	}
+
+	if (!valid) {
+		DirectXCommon::Log("InputRecorder: recording is corrupt at frame " + std::to_string(frameIndex_) + "\n");
+		finished_ = true;
+		return false;
+	}
+
+	previous_ = frame;
+	outFrame = frame;
+	++frameIndex_;
+	// ステップ数が書かれていなければ (記録中に落ちた) ファイルの終わりまで
+	finished_ = frameCount_ > 0 ? frameIndex_ >= frameCount_ : readOffset_ >= replayData_.size();
+	return true;
+}
+
+/// <summary>
+/// 再生ファイルのバイトを読む
+/// </summary>
+bool InputRecorder::ReadBytes(void* dst, size_t size)
+{
+	if (replayData_.size() - readOffset_ < size) {
+		return false;
+	}
+	std::memcpy(dst, replayData_.data() + readOffset_, size);
+	readOffset_ += size;
+	return true;
+}
+
+bool InputRecorder::ReadVarint(uint32_t& outValue)
+{
+	outValue = 0;
+	for (uint32_t shift = 0; shift < 35; shift += 7) {
+		uint8_t byte = 0;
+		if (!ReadBytes(&byte, 1)) {
+			return false;
+		}
+		outValue |= uint32_t(byte & 0x7F) << shift;
+		if (!(byte & 0x80)) {
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+// C++
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// 入力の記録と再生
+/// 更新1ステップ分の入力 (キーボード・マウス・パッド) を、前のステップから変わった所だけ書き出す
+/// 再生時は同じ順に取り出して Input へ流すので、ゲーム側は普段と同じ Input の関数で読める
+/// ヘッダーには乱数の元のシードも残し、再生時に同じシードで始めてプレイを再現する
+/// </summary>
+class InputRecorder
+{
+public: // 定数
+
+	static constexpr uint32_t kKeyCount = 256;
+	static constexpr uint32_t kMouseButtonCount = 8;
+	static constexpr uint32_t kPadCount = 4;
+
+	// 記録と再生を切り替える起動引数
+	static inline const std::string kRecordArgument = "--record";
+	static inline const std::string kReplayArgument = "--replay";
+	static inline const std::string kSeedArgument = "--seed";
+	static inline const std::string kTimingArgument = "--timing";
+
+public: // 型
+
+	// パッド1つ分 (XINPUT_GAMEPAD と同じ値)
+	struct PadState {
+		bool connected = false;
+		uint16_t buttons = 0;
+		uint8_t leftTrigger = 0;
+		uint8_t rightTrigger = 0;
+		int16_t thumbLX = 0;
+		int16_t thumbLY = 0;
+		int16_t thumbRX = 0;
+		int16_t thumbRY = 0;
+
+		bool operator==(const PadState&) const = default;
+	};
+
+	// 1ステップ分の入力
+	struct Frame {
+		std::array<uint8_t, kKeyCount / 8> keys = {};	// 押されているキー (DIK_ 番号のビット)
+		uint8_t mouseButtons = 0;						// 押されているマウスボタン (ビット)
+		int32_t mouseMoveX = 0;							// マウスの移動量
+		int32_t mouseMoveY = 0;
+		int32_t mouseMoveZ = 0;							// ホイール
+		int32_t cursorX = 0;							// カーソルの位置 (ウィンドウ座標)
+		int32_t cursorY = 0;
+		std::array<PadState, kPadCount> pads = {};
+
+		bool IsKeyDown(uint32_t key) const { return (keys[key >> 3] >> (key & 7)) & 1; }
+		void SetKeyDown(uint32_t key, bool down) {
+			keys[key >> 3] = static_cast<uint8_t>(down ? keys[key >> 3] | 1 << (key & 7) : keys[key >> 3] & ~(1 << (key & 7)));
+		}
+	};
+
+	enum class Mode {
+		kNone,
+		kRecording,
+		kReplaying,
+	};
+
+	// 起動引数で決まる設定
+	struct Options {
+		Mode mode = Mode::kNone;
+		std::string logPath;	// 記録先・再生元のファイル
+		std::string timingPath;	// フレーム時間のCSV (再生時は省略すると logPath + ".csv")
+		bool hasSeed = false;	// 記録時のシードを指定したか
+		uint32_t seed = 0;
+	};
+
+public: // メンバ関数
+
+	static InputRecorder* GetInstance();
+
+	/// <summary>
+	/// 起動引数を読む (--record <file> / --replay <file> / --seed <n> / --timing <file>)
+	/// </summary>
+	static Options ParseCommandLine(const std::string& commandLine);
+
+	/// <summary>
+	/// 記録を始める
+	/// </summary>
+	/// <param name="seed">乱数の元のシード (ヘッダーに残す)</param>
+	/// <param name="fixedDeltaTime">更新1ステップの秒数 (ヘッダーに残す)</param>
+	bool StartRecording(const std::string& filePath, uint32_t seed, float fixedDeltaTime);
+
+	/// <summary>
+	/// 再生を始める (ファイルを丸ごと読み込む)
+	/// </summary>
+	bool StartReplay(const std::string& filePath);
+
+	/// <summary>
+	/// 記録・再生を終える (記録中ならフレーム数を書き込んで閉じる)
+	/// </summary>
+	void Stop();
+
+	/// <summary>
+	/// 1ステップ分を書き出す (記録中だけ)
+	/// </summary>
+	void WriteFrame(const Frame& frame);
+
+	/// <summary>
+	/// 1ステップ分を取り出す (再生中だけ)
+	/// </summary>
+	/// <returns>取り出せたか (最後まで再生したか、壊れていれば false)</returns>
+	bool ReadFrame(Frame& outFrame);
+
+	Mode GetMode() const { return mode_; }
+	bool IsRecording() const { return mode_ == Mode::kRecording; }
+	bool IsReplaying() const { return mode_ == Mode::kReplaying; }
+	// 最後のステップまで再生し終えたか
+	bool IsReplayFinished() const { return mode_ == Mode::kReplaying && finished_; }
+
+	// 記録・再生したシードと1ステップの秒数
+	uint32_t GetSeed() const { return seed_; }
+	float GetFixedDeltaTime() const { return fixedDeltaTime_; }
+	// 記録・再生したステップ数
+	uint32_t GetFrameIndex() const { return frameIndex_; }
+	// 再生するファイルのステップ数
+	uint32_t GetFrameCount() const { return frameCount_; }
+	// 書き出した (読み込んだ) バイト数
+	uint64_t GetByteCount() const { return byteCount_; }
+
+private:
+
+	InputRecorder() = default;
+	~InputRecorder();
+	InputRecorder(const InputRecorder&) = delete;
+	InputRecorder& operator=(const InputRecorder&) = delete;
+
+	/// <summary>
+	/// 再生ファイルのバイトを読む (足りなければ壊れているので false)
+	/// </summary>
+	bool ReadBytes(void* dst, size_t size);
+	bool ReadVarint(uint32_t& outValue);
+
+private: // メンバ変数
+
+	Mode mode_ = Mode::kNone;
+	uint32_t seed_ = 0;
+	float fixedDeltaTime_ = 0.0f;
+	uint32_t frameIndex_ = 0;
+	uint32_t frameCount_ = 0;
+	uint64_t byteCount_ = 0;
+	bool finished_ = false;
+
+	// 差分の基準になる前のステップ
+	Frame previous_;
+
+	// 記録先
+	std::ofstream output_;
+	std::vector<uint8_t> encodeBuffer_;
+
+	// 再生元 (丸ごと読み込む)
+	std::vector<uint8_t> replayData_;
+	size_t readOffset_ = 0;
+};
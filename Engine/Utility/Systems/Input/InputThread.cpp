@@ -0,0 +1,138 @@
+#include "InputThread.h"
+
+// C++
+#include <chrono>
+#include <vector>
+
+InputThread::~InputThread()
+{
+	Stop();
+}
+
+/// <summary>
+/// スレッドを立てる
+/// </summary>
+bool InputThread::Start(Sampler sampler, uint32_t pollHz)
+{
+	Stop();
+	if (!sampler || pollHz == 0) {
+		return false;
+	}
+	sampler_ = std::move(sampler);
+	intervalNanoseconds_ = 1'000'000'000LL / pollHz;
+
+	// 前に積んで読まれなかったイベントは捨てる
+	InputEvent stale;
+	while (queue_.TryPop(stale)) {
+	}
+	mouseMoveX_ = 0;
+	mouseMoveY_ = 0;
+	mouseMoveZ_ = 0;
+	published_ = {};
+	{
+		std::lock_guard<std::mutex> lock(latestMutex_);
+		latest_ = {};
+	}
+
+	quit_ = false;
+	thread_ = std::thread(&InputThread::ThreadMain, this);
+	return true;
+}
+
+/// <summary>
+/// スレッドを止める
+/// </summary>
+void InputThread::Stop()
+{
+	if (!thread_.joinable()) {
+		return;
+	}
+	quit_ = true;
+	thread_.join();
+	sampler_ = nullptr;
+}
+
+/// <summary>
+/// 溜まったマウスの移動量を受け取る
+/// </summary>
+void InputThread::TakeMouseMove(int32_t& outX, int32_t& outY, int32_t& outZ)
+{
+	outX = mouseMoveX_.exchange(0);
+	outY = mouseMoveY_.exchange(0);
+	outZ = mouseMoveZ_.exchange(0);
+}
+
+/// <summary>
+/// 最後に読んだ入力
+/// </summary>
+InputRecorder::Frame InputThread::GetLatest() const
+{
+	std::lock_guard<std::mutex> lock(latestMutex_);
+	return latest_;
+}
+
+InputThread::Stats InputThread::GetStats() const
+{
+	Stats stats;
+	stats.polls = polls_.load();
+	stats.events = events_.load();
+	stats.droppedEvents = droppedEvents_.load();
+	stats.maxPollIntervalMs = static_cast<float>(maxPollIntervalNanoseconds_.load()) / 1'000'000.0f;
+	return stats;
+}
+
+/// <summary>
+/// スレッドの中身
+/// </summary>
+void InputThread::ThreadMain()
+{
+	std::vector<InputEvent> events(InputEventState::kMaxDiffEvents);
+	int64_t previousPoll = 0;
+	auto deadline = std::chrono::steady_clock::now();
+
+	while (!quit_) {
+		InputRecorder::Frame frame;
+		sampler_(frame);
+		const int64_t timestamp = InputEventState::GetTimestamp();
+
+		// 移動量は更新側が受け取るまで足していく
+		mouseMoveX_ += frame.mouseMoveX;
+		mouseMoveY_ += frame.mouseMoveY;
+		mouseMoveZ_ += frame.mouseMoveZ;
+		{
+			std::lock_guard<std::mutex> lock(latestMutex_);
+			latest_ = frame;
+		}
+
+		// 変わったボタンを積む。満杯で積めなければ次に読んだ時にもう一度出す
+		// (積めた分が重複しても、更新側は押しているのに押された等を無視する)
+		const uint32_t count = InputEventState::Diff(published_, frame, timestamp, events.data());
+		uint32_t pushed = 0;
+		while (pushed < count && queue_.TryPush(events[pushed])) {
+			++pushed;
+		}
+		events_ += pushed;
+		if (pushed == count) {
+			published_ = frame;
+		} else {
+			droppedEvents_ += count - pushed;
+		}
+
+		++polls_;
+		if (previousPoll != 0) {
+			const int64_t interval = timestamp - previousPoll;
+			if (interval > maxPollIntervalNanoseconds_.load(std::memory_order_relaxed)) {
+				maxPollIntervalNanoseconds_ = interval;
+			}
+		}
+		previousPoll = timestamp;
+
+		// 決まった間隔で読む (遅れたら追いつこうとせず、今から数え直す)
+		deadline += std::chrono::nanoseconds(intervalNanoseconds_);
+		const auto now = std::chrono::steady_clock::now();
+		if (deadline < now) {
+			deadline = now;
+		}
+		std::this_thread::sleep_until(deadline);
+	}
+}
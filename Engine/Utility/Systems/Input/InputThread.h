@@ -0,0 +1,109 @@
+#pragma once
+
+// C++
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Engine
+#include "InputEventState.h"
+#include "SpscQueue.h"
+
+/// <summary>
+/// 入力を読むスレッド
+/// フレームとは別に高い頻度で機器を読み、ボタンの変化を時刻付きのイベントにしてキューへ積む
+/// 更新側はフレームごとにキューを空にして、フレームの間に起きた押す・離すを全部受け取る
+/// 機器を読む処理は Sampler として外から渡す (このクラスは機器を知らない)
+/// </summary>
+class InputThread
+{
+public: // 型
+
+	// 機器を1回読む (スレッドで呼ぶ。マウスの移動量は前回読んでからの分を入れる)
+	using Sampler = std::function<void(InputRecorder::Frame& outFrame)>;
+
+	// 統計 (累計)
+	struct Stats {
+		uint64_t polls = 0;				// 機器を読んだ回数
+		uint64_t events = 0;			// キューへ積んだイベントの数
+		uint64_t droppedEvents = 0;		// キューが満杯で積めなかったイベントの数 (次に読んだ時に積み直す)
+		float maxPollIntervalMs = 0.0f;	// 読む間隔の最大
+	};
+
+	// キューに溜められるイベントの数 (1フレームで読み切れる量)
+	static constexpr size_t kQueueCapacity = 1024;
+
+public: // メンバ関数
+
+	InputThread() = default;
+	~InputThread();
+
+	InputThread(const InputThread&) = delete;
+	InputThread& operator=(const InputThread&) = delete;
+
+	/// <summary>
+	/// スレッドを立てる
+	/// </summary>
+	/// <param name="sampler">機器を1回読む処理</param>
+	/// <param name="pollHz">1秒に読む回数</param>
+	bool Start(Sampler sampler, uint32_t pollHz);
+
+	/// <summary>
+	/// スレッドを止める (戻った後は Sampler を呼ばない)
+	/// </summary>
+	void Stop();
+
+	bool IsRunning() const { return thread_.joinable(); }
+
+	/// <summary>
+	/// 積まれたイベントを起きた順に1つ取り出す (更新側のスレッドだけが呼ぶ)
+	/// </summary>
+	bool TryPopEvent(InputEvent& outEvent) { return queue_.TryPop(outEvent); }
+
+	/// <summary>
+	/// 前回受け取ってから溜まったマウスの移動量を受け取る
+	/// </summary>
+	void TakeMouseMove(int32_t& outX, int32_t& outY, int32_t& outZ);
+
+	/// <summary>
+	/// 最後に読んだ入力 (スティックやトリガーなど、イベントにしない値用)
+	/// </summary>
+	InputRecorder::Frame GetLatest() const;
+
+	Stats GetStats() const;
+
+private:
+
+	// スレッドの中身
+	void ThreadMain();
+
+private: // メンバ変数
+
+	std::thread thread_;
+	std::atomic<bool> quit_ = false;
+	Sampler sampler_;
+	int64_t intervalNanoseconds_ = 0;
+
+	// 押す・離すのイベント
+	SpscQueue<InputEvent, kQueueCapacity> queue_;
+
+	// 溜まったマウスの移動量
+	std::atomic<int32_t> mouseMoveX_ = 0;
+	std::atomic<int32_t> mouseMoveY_ = 0;
+	std::atomic<int32_t> mouseMoveZ_ = 0;
+
+	// 最後に読んだ入力
+	mutable std::mutex latestMutex_;
+	InputRecorder::Frame latest_;
+
+	// 統計
+	std::atomic<uint64_t> polls_ = 0;
+	std::atomic<uint64_t> events_ = 0;
+	std::atomic<uint64_t> droppedEvents_ = 0;
+	std::atomic<int64_t> maxPollIntervalNanoseconds_ = 0;
+
+	// ここから下はスレッドだけが触る
+	InputRecorder::Frame published_;	// イベントにして積み終えた状態
+};
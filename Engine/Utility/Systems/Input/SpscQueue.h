@@ -0,0 +1,77 @@
+#pragma once
+
+// C++
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/// <summary>
+/// 書き込み1スレッド・読み出し1スレッド専用のロックフリーなキュー (固定長のリング)
+/// 書き込み側は tail_ だけ、読み出し側は head_ だけを進めるので、ロックもCASも要らない
+/// 相手側の位置は手元に写しておき、満杯・空に見えた時だけ読み直す (キャッシュラインの行き来を減らす)
+/// </summary>
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+	static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+
+	/// <summary>
+	/// 積む (書き込み側のスレッドだけが呼ぶ)
+	/// </summary>
+	/// <returns>満杯なら false</returns>
+	bool TryPush(const T& value) {
+		const size_t tail = tail_.load(std::memory_order_relaxed);
+		if (tail - cachedHead_ == Capacity) {
+			cachedHead_ = head_.load(std::memory_order_acquire);
+			if (tail - cachedHead_ == Capacity) {
+				return false;
+			}
+		}
+		items_[tail & kMask] = value;
+		tail_.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// <summary>
+	/// 取り出す (読み出し側のスレッドだけが呼ぶ)
+	/// </summary>
+	/// <returns>空なら false</returns>
+	bool TryPop(T& outValue) {
+		const size_t head = head_.load(std::memory_order_relaxed);
+		if (head == cachedTail_) {
+			cachedTail_ = tail_.load(std::memory_order_acquire);
+			if (head == cachedTail_) {
+				return false;
+			}
+		}
+		outValue = items_[head & kMask];
+		head_.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// <summary>
+	/// 積まれている数 (他方のスレッドが動いている間は目安)
+	/// </summary>
+	size_t GetSize() const {
+		return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+	}
+
+	static constexpr size_t GetCapacity() { return Capacity; }
+
+private:
+
+	static constexpr size_t kMask = Capacity - 1;
+	static constexpr size_t kCacheLineSize = 64;
+
+	// 読み出し側が触る
+	alignas(kCacheLineSize) std::atomic<size_t> head_ = 0;
+	size_t cachedTail_ = 0;
+
+	// 書き込み側が触る
+	alignas(kCacheLineSize) std::atomic<size_t> tail_ = 0;
+	size_t cachedHead_ = 0;
+
+	alignas(kCacheLineSize) std::array<T, Capacity> items_ = {};
+};
@@ -0,0 +1,73 @@
+#include "MapChipBatch.h"
+
+// Math
+#include "MathFunc.h"
+
+void MapChipBatch::RegisterModel(MapChipType type, const std::string& modelName)
+{
+	auto it = batchIndexTable_.find(type);
+	if (it != batchIndexTable_.end()) {
+		batches_[it->second].modelName = modelName;
+	} else {
+		batchIndexTable_[type] = static_cast<uint32_t>(batches_.size());
+		batches_.push_back(Batch{ modelName, {} });
+	}
+	isDirty_ = true;
+}
+
+bool MapChipBatch::Build(const MapChipField& field)
+{
+	// 変化がなければ何もしない
+	if (!isDirty_ && builtField_ == &field && builtRevision_ == field.GetRevision() &&
+		(!boxes_ || builtBoxesRevision_ == boxes_->GetRevision())) {
+		return false;
+	}
+
+	for (Batch& batch : batches_) {
+		batch.worldMatrices.clear();
+	}
+
+	builtField_ = &field;
+	builtRevision_ = field.GetRevision();
+	isDirty_ = false;
+
+	// まとめた矩形を1つのインスタンスとして拡大して置く
+	if (boxes_) {
+		for (const MapChipBoxes::Box& box : boxes_->GetBoxes()) {
+			auto it = batchIndexTable_.find(box.type);
+			if (it == batchIndexTable_.end()) {
+				continue;
+			}
+			Vector3 scale = { static_cast<float>(box.width), 1.0f, static_cast<float>(box.height) };
+			batches_[it->second].worldMatrices.push_back(
+				MakeAffineMatrix(scale, Vector3{ 0.0f, 0.0f, 0.0f }, MapChipBoxes::GetCenter(box)));
+		}
+		builtBoxesRevision_ = boxes_->GetRevision();
+		return true;
+	}
+
+	uint32_t numBlockVirtical = MapChipField::GetNumBlockVertical();
+	uint32_t numBlockHorizotal = MapChipField::GetNumBlockHorizontal();
+	for (uint32_t i = 0; i < numBlockVirtical; ++i) {
+		for (uint32_t j = 0; j < numBlockHorizotal; ++j) {
+			auto it = batchIndexTable_.find(field.GetMapChipTypeByIndex(j, i));
+			if (it == batchIndexTable_.end()) {
+				continue;
+			}
+			// ブロックは動かないので平行移動のみ
+			batches_[it->second].worldMatrices.push_back(
+				MakeTranslateMatrix(MapChipField::GetMapChipPositionByIndex(j, i)));
+		}
+	}
+
+	return true;
+}
+
+uint32_t MapChipBatch::GetInstanceCount() const
+{
+	uint32_t count = 0;
+	for (const Batch& batch : batches_) {
+		count += static_cast<uint32_t>(batch.worldMatrices.size());
+	}
+	return count;
+}
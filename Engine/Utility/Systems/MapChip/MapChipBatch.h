@@ -0,0 +1,71 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Engine
+#include "MapChipField.h"
+#include "MapChipBoxes.h"
+
+// Math
+#include "Matrix4x4.h"
+
+/// <summary>
+/// マップチップをモデルごとにまとめたインスタンス配列を作る
+/// GPUに依存しないのでCPU側だけで確認できる
+/// </summary>
+class MapChipBatch
+{
+public:
+	// 1モデル分のインスタンス
+	struct Batch {
+		std::string modelName;
+		std::vector<Matrix4x4> worldMatrices;
+	};
+
+public:
+
+	/// <summary>
+	/// マップチップタイプに描画するモデルを登録
+	/// </summary>
+	/// <param name="type">マップチップタイプ</param>
+	/// <param name="modelName">モデル名 (例: "cube.obj")</param>
+	void RegisterModel(MapChipType type, const std::string& modelName);
+
+	/// <summary>
+	/// フィールドが変わっていればインスタンス配列を作り直す
+	/// </summary>
+	/// <returns>作り直した場合はtrue</returns>
+	bool Build(const MapChipField& field);
+
+	/// <summary>
+	/// 次の Build で必ず作り直す
+	/// </summary>
+	void MarkDirty() { isDirty_ = true; }
+
+	/// <summary>
+	/// まとめた矩形ごとに1インスタンスで描画する (nullptrならマスごと)
+	/// </summary>
+	void SetBoxes(const MapChipBoxes* boxes) { boxes_ = boxes; isDirty_ = true; }
+
+public: // アクセッサ
+	const std::vector<Batch>& GetBatches() const { return batches_; }
+	uint32_t GetInstanceCount() const;
+
+private:
+	// マップチップタイプ → バッチ番号
+	std::map<MapChipType, uint32_t> batchIndexTable_;
+	std::vector<Batch> batches_;
+
+	// 最後に作った時のフィールドの更新番号
+	const MapChipField* builtField_ = nullptr;
+	uint32_t builtRevision_ = 0;
+	bool isDirty_ = true;
+
+	// まとめた矩形
+	const MapChipBoxes* boxes_ = nullptr;
+	uint32_t builtBoxesRevision_ = 0;
+};
@@ -0,0 +1,172 @@
+#include "MapChipBoxes.h"
+
+// C++
+#include <algorithm>
+
+void MapChipBoxes::Build(const MapChipField& field)
+{
+	boxes_.clear();
+	owners_.assign(MapChipField::GetNumBlockHorizontal() * MapChipField::GetNumBlockVertical(), kNoBox);
+
+	MergeRegion(field, 0, 0, MapChipField::GetNumBlockHorizontal() - 1, MapChipField::GetNumBlockVertical() - 1);
+
+	builtField_ = &field;
+	builtFieldRevision_ = field.GetRevision();
+	++revision_;
+}
+
+bool MapChipBoxes::Refresh(const MapChipField& field)
+{
+	if (builtField_ == &field && builtFieldRevision_ == field.GetRevision()) {
+		return false;
+	}
+	Build(field);
+	return true;
+}
+
+void MapChipBoxes::OnCellChanged(const MapChipField& field, uint32_t xIndex, uint32_t yIndex)
+{
+	if (xIndex >= MapChipField::GetNumBlockHorizontal() || yIndex >= MapChipField::GetNumBlockVertical()) {
+		return;
+	}
+	// 中身が変わっていなければ何もしない
+	if (builtField_ == &field && field.GetRevision() == builtFieldRevision_) {
+		return;
+	}
+	// まだ作っていない、または他の変更が混ざっている場合は全体を作り直す
+	if (builtField_ != &field || owners_.empty() || field.GetRevision() != builtFieldRevision_ + 1) {
+		Build(field);
+		return;
+	}
+
+	// 作り直す領域 (変更マスと、変更マス・上下左右のマスを含む矩形を囲う範囲)
+	uint32_t left = xIndex;
+	uint32_t right = xIndex;
+	uint32_t top = yIndex;
+	uint32_t bottom = yIndex;
+
+	const int32_t offsets[5][2] = { { 0, 0 }, { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+	for (const auto& offset : offsets) {
+		int32_t x = static_cast<int32_t>(xIndex) + offset[0];
+		int32_t y = static_cast<int32_t>(yIndex) + offset[1];
+		int32_t boxIndex = GetBoxIndexByCell(static_cast<uint32_t>(x), static_cast<uint32_t>(y));
+		if (x < 0 || y < 0 || boxIndex == kNoBox) {
+			continue;
+		}
+		const Box& box = boxes_[boxIndex];
+		left = (std::min)(left, box.xIndex);
+		top = (std::min)(top, box.yIndex);
+		right = (std::max)(right, box.xIndex + box.width - 1);
+		bottom = (std::max)(bottom, box.yIndex + box.height - 1);
+		RemoveBox(boxIndex);
+	}
+
+	// 領域内の未使用マスだけをまとめ直す (他の矩形に属するマスはそのまま)
+	MergeRegion(field, left, top, right, bottom);
+
+	builtFieldRevision_ = field.GetRevision();
+	++revision_;
+}
+
+int32_t MapChipBoxes::GetBoxIndexByCell(uint32_t xIndex, uint32_t yIndex) const
+{
+	if (owners_.empty() || xIndex >= MapChipField::GetNumBlockHorizontal() || yIndex >= MapChipField::GetNumBlockVertical()) {
+		return kNoBox;
+	}
+	return Owner(xIndex, yIndex);
+}
+
+MapChipField::Rect MapChipBoxes::GetRect(const Box& box)
+{
+	// 左上マスと右下マスの中心から求める (yIndex が増えるほど z は小さい)
+	Vector3 topLeft = MapChipField::GetMapChipPositionByIndex(box.xIndex, box.yIndex);
+	Vector3 bottomRight = MapChipField::GetMapChipPositionByIndex(box.xIndex + box.width - 1, box.yIndex + box.height - 1);
+
+	MapChipField::Rect rect;
+	rect.left = topLeft.x - MapChipField::GetBlockWidth() / 2.0f;
+	rect.right = bottomRight.x + MapChipField::GetBlockWidth() / 2.0f;
+	rect.bottom = bottomRight.z - MapChipField::GetBlockHeight() / 2.0f;
+	rect.top = topLeft.z + MapChipField::GetBlockHeight() / 2.0f;
+	return rect;
+}
+
+Vector3 MapChipBoxes::GetCenter(const Box& box)
+{
+	Vector3 topLeft = MapChipField::GetMapChipPositionByIndex(box.xIndex, box.yIndex);
+	Vector3 bottomRight = MapChipField::GetMapChipPositionByIndex(box.xIndex + box.width - 1, box.yIndex + box.height - 1);
+	return (topLeft + bottomRight) * 0.5f;
+}
+
+void MapChipBoxes::MergeRegion(const MapChipField& field, uint32_t left, uint32_t top, uint32_t right, uint32_t bottom)
+{
+	for (uint32_t y = top; y <= bottom; ++y) {
+		for (uint32_t x = left; x <= right; ++x) {
+			MapChipType type = field.GetMapChipTypeByIndex(x, y);
+			if (type == MapChipType::kBlank || Owner(x, y) != kNoBox) {
+				continue;
+			}
+
+			// 横に伸ばせるだけ伸ばす
+			uint32_t width = 1;
+			while (x + width <= right &&
+				field.GetMapChipTypeByIndex(x + width, y) == type &&
+				Owner(x + width, y) == kNoBox) {
+				++width;
+			}
+
+			// 同じ幅のまま下に伸ばせるだけ伸ばす
+			uint32_t height = 1;
+			while (y + height <= bottom) {
+				bool canExtend = true;
+				for (uint32_t i = 0; i < width; ++i) {
+					if (field.GetMapChipTypeByIndex(x + i, y + height) != type ||
+						Owner(x + i, y + height) != kNoBox) {
+						canExtend = false;
+						break;
+					}
+				}
+				if (!canExtend) {
+					break;
+				}
+				++height;
+			}
+
+			AddBox(Box{ x, y, width, height, type });
+		}
+	}
+}
+
+void MapChipBoxes::RemoveBox(int32_t boxIndex)
+{
+	// 所属を外す
+	const Box removed = boxes_[boxIndex];
+	for (uint32_t y = removed.yIndex; y < removed.yIndex + removed.height; ++y) {
+		for (uint32_t x = removed.xIndex; x < removed.xIndex + removed.width; ++x) {
+			Owner(x, y) = kNoBox;
+		}
+	}
+
+	// 末尾と入れ替えて削除し、移動した矩形の所属を書き換える
+	int32_t lastIndex = static_cast<int32_t>(boxes_.size()) - 1;
+	if (boxIndex != lastIndex) {
+		boxes_[boxIndex] = boxes_[lastIndex];
+		const Box& moved = boxes_[boxIndex];
+		for (uint32_t y = moved.yIndex; y < moved.yIndex + moved.height; ++y) {
+			for (uint32_t x = moved.xIndex; x < moved.xIndex + moved.width; ++x) {
+				Owner(x, y) = boxIndex;
+			}
+		}
+	}
+	boxes_.pop_back();
+}
+
+void MapChipBoxes::AddBox(const Box& box)
+{
+	int32_t boxIndex = static_cast<int32_t>(boxes_.size());
+	boxes_.push_back(box);
+	for (uint32_t y = box.yIndex; y < box.yIndex + box.height; ++y) {
+		for (uint32_t x = box.xIndex; x < box.xIndex + box.width; ++x) {
+			Owner(x, y) = boxIndex;
+		}
+	}
+}
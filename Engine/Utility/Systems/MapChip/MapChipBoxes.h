@@ -0,0 +1,97 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <vector>
+
+// Engine
+#include "MapChipField.h"
+
+/// <summary>
+/// 同じタイプが連続するマップチップを矩形にまとめる (グリーディメッシング)
+/// 当たり判定と描画の両方から参照する
+/// </summary>
+class MapChipBoxes
+{
+public:
+	// まとめた矩形 (インデックスは左上のマス)
+	struct Box {
+		uint32_t xIndex = 0;
+		uint32_t yIndex = 0;
+		uint32_t width = 1;		// 横方向のマス数
+		uint32_t height = 1;	// 縦方向のマス数
+		MapChipType type = MapChipType::kBlank;
+	};
+
+	// どの矩形にも属さないマス
+	static inline const int32_t kNoBox = -1;
+
+public:
+
+	/// <summary>
+	/// フィールド全体から矩形を作り直す
+	/// </summary>
+	void Build(const MapChipField& field);
+
+	/// <summary>
+	/// フィールドが知らないところで変わっていれば作り直す
+	/// </summary>
+	/// <returns>作り直した場合はtrue</returns>
+	bool Refresh(const MapChipField& field);
+
+	/// <summary>
+	/// 1マス書き換わった時の部分更新
+	/// 書き換え後のフィールドを渡す
+	/// </summary>
+	void OnCellChanged(const MapChipField& field, uint32_t xIndex, uint32_t yIndex);
+
+	/// <summary>
+	/// 指定マスを含む矩形の番号 (無ければ kNoBox)
+	/// </summary>
+	int32_t GetBoxIndexByCell(uint32_t xIndex, uint32_t yIndex) const;
+
+	/// <summary>
+	/// 矩形のワールド上の境界
+	/// </summary>
+	static MapChipField::Rect GetRect(const Box& box);
+
+	/// <summary>
+	/// 矩形の中心座標
+	/// </summary>
+	static Vector3 GetCenter(const Box& box);
+
+public: // アクセッサ
+	const std::vector<Box>& GetBoxes() const { return boxes_; }
+	uint32_t GetRevision() const { return revision_; }
+
+private:
+
+	/// <summary>
+	/// 指定した領域の未使用マスを貪欲法で矩形にまとめる
+	/// </summary>
+	void MergeRegion(const MapChipField& field, uint32_t left, uint32_t top, uint32_t right, uint32_t bottom);
+
+	/// <summary>
+	/// 矩形を取り除き、所属していたマスを未使用に戻す
+	/// </summary>
+	void RemoveBox(int32_t boxIndex);
+
+	/// <summary>
+	/// 矩形を追加してマスに所属を書き込む
+	/// </summary>
+	void AddBox(const Box& box);
+
+	int32_t& Owner(uint32_t xIndex, uint32_t yIndex) { return owners_[yIndex * MapChipField::GetNumBlockHorizontal() + xIndex]; }
+	int32_t Owner(uint32_t xIndex, uint32_t yIndex) const { return owners_[yIndex * MapChipField::GetNumBlockHorizontal() + xIndex]; }
+
+private:
+	std::vector<Box> boxes_;
+	// マスごとの所属矩形番号
+	std::vector<int32_t> owners_;
+
+	// 矩形が変わるたびに進める (描画側の作り直し判定用)
+	uint32_t revision_ = 0;
+	// 最後に反映したフィールドの更新番号
+	const MapChipField* builtField_ = nullptr;
+	uint32_t builtFieldRevision_ = 0;
+};
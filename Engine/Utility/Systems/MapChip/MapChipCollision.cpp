@@ -1,6 +1,7 @@
 #include "MapChipCollision.h"
 
-#include "MapChipCollision.h"
+// C++
+#include <algorithm>
 
 // Z値を考慮
 void MapChipCollision::DetectAndResolveCollision(
@@ -34,7 +35,89 @@ void MapChipCollision::DetectAndResolveCollision(
 		// 検査範囲（速度に基づいて動的に調整）
 		int searchRadius = 2 + static_cast<int>(std::max(std::abs(velocity.x), std::abs(velocity.z)) / mapChipField_->GetBlockSize());
 
+		// オブジェクトの現在の矩形を計算
+		MapChipField::Rect objectRect = {
+			position.x - colliderRect.width / 2.0f + colliderRect.offsetX,
+			position.x + colliderRect.width / 2.0f + colliderRect.offsetX,
+			position.z - colliderRect.height / 2.0f + colliderRect.offsetY,
+			position.z + colliderRect.height / 2.0f + colliderRect.offsetY
+		};
+
+		// 移動後の予測位置
+		MapChipField::Rect nextObjectRect = {
+			objectRect.left + velocity.x,
+			objectRect.right + velocity.x,
+			objectRect.bottom + velocity.z,
+			objectRect.top + velocity.z
+		};
+
+		// 1つの矩形との衝突を調べて衝突リストに追加する
+		auto checkRect = [&](uint32_t xIndex, uint32_t zIndex, MapChipType blockType, const MapChipField::Rect& blockRect) {
+			// 矩形同士の衝突をチェック
+			bool willCollideX = nextObjectRect.right > blockRect.left &&
+				nextObjectRect.left < blockRect.right;
+			bool willCollideZ = nextObjectRect.top > blockRect.bottom &&
+				nextObjectRect.bottom < blockRect.top;
+
+			if (!willCollideX || !willCollideZ) {
+				return;
+			}
+
+			// 衝突情報を作成
+			CollisionInfo info;
+			info.xIndex = xIndex;
+			info.yIndex = zIndex;
+			info.blockType = blockType;
+			info.blockRect = blockRect;
+
+			// 衝突方向と深さを計算
+			// 水平方向
+			float leftPenetration = nextObjectRect.right - blockRect.left;
+			float rightPenetration = blockRect.right - nextObjectRect.left;
+
+			// 垂直方向
+			float topPenetration = nextObjectRect.top - blockRect.bottom;
+			float bottomPenetration = blockRect.top - nextObjectRect.bottom;
+
+			// 最小めり込み方向を探す
+			float minPenetration = std::numeric_limits<float>::max();
+			CollisionDirection collisionDirection{};
+
+			/// 左方向の衝突チェック
+			if ((checkFlags & CollisionFlag::Left) && velocity.x > 0 && leftPenetration < minPenetration) {
+				minPenetration = leftPenetration;
+				collisionDirection = CollisionDirection::LeftDir;
+			}
+
+			/// 右方向の衝突チェック
+			if ((checkFlags & CollisionFlag::Right) && velocity.x < 0 && rightPenetration < minPenetration) {
+				minPenetration = rightPenetration;
+				collisionDirection = CollisionDirection::RightDir;
+			}
+
+			/// 上方向の衝突チェック
+			if ((checkFlags & CollisionFlag::Top) && velocity.z > 0 && topPenetration < minPenetration) {
+				minPenetration = topPenetration;
+				collisionDirection = CollisionDirection::TopDir;
+			}
+
+			/// 下方向の衝突チェック
+			if ((checkFlags & CollisionFlag::Bottom) && velocity.z < 0 && bottomPenetration < minPenetration) {
+				minPenetration = bottomPenetration;
+				collisionDirection = CollisionDirection::BottomDir;
+			}
+
+			// 衝突情報を設定
+			info.direction = collisionDirection;
+			info.penetrationDepth = minPenetration;
+
+			// 衝突リストに追加
+			collisions.push_back(info);
+		};
+
 		// 検査範囲内のブロックをチェック
+		// まとめた矩形がある場合は同じ矩形を一度だけ調べる
+		visitedBoxes_.clear();
 		for (int dz = -searchRadius; dz <= searchRadius; dz++) {
 			for (int dx = -searchRadius; dx <= searchRadius; dx++) {
 				// チェック対象のインデックスを計算
@@ -51,6 +134,22 @@ void MapChipCollision::DetectAndResolveCollision(
 				uint32_t xIndex = static_cast<uint32_t>(checkX);
 				uint32_t zIndex = static_cast<uint32_t>(checkZ);
 
+				if (boxes_) {
+					int32_t boxIndex = boxes_->GetBoxIndexByCell(xIndex, zIndex);
+					if (boxIndex == MapChipBoxes::kNoBox ||
+						std::find(visitedBoxes_.begin(), visitedBoxes_.end(), boxIndex) != visitedBoxes_.end()) {
+						continue;
+					}
+					visitedBoxes_.push_back(boxIndex);
+
+					// 矩形内で現在位置に一番近いマスを衝突マスとして報告する
+					const MapChipBoxes::Box& box = boxes_->GetBoxes()[boxIndex];
+					uint32_t nearestX = std::clamp(currentIndex.xIndex, box.xIndex, box.xIndex + box.width - 1);
+					uint32_t nearestZ = std::clamp(currentIndex.yIndex, box.yIndex, box.yIndex + box.height - 1);
+					checkRect(nearestX, nearestZ, box.type, MapChipBoxes::GetRect(box));
+					continue;
+				}
+
 				// ブロックタイプを取得
 				MapChipType blockType = mapChipField_->GetMapChipTypeByIndex(xIndex, zIndex);
 
@@ -60,82 +159,7 @@ void MapChipCollision::DetectAndResolveCollision(
 				}
 
 				// ブロックの矩形を取得
-				MapChipField::Rect blockRect = mapChipField_->GetRectByIndex(xIndex, zIndex);
-
-				// オブジェクトの現在の矩形を計算
-				MapChipField::Rect objectRect = {
-					position.x - colliderRect.width / 2.0f + colliderRect.offsetX,
-					position.x + colliderRect.width / 2.0f + colliderRect.offsetX,
-					position.z - colliderRect.height / 2.0f + colliderRect.offsetY,
-					position.z + colliderRect.height / 2.0f + colliderRect.offsetY
-				};
-
-				// 移動後の予測位置
-				MapChipField::Rect nextObjectRect = {
-					objectRect.left + velocity.x,
-					objectRect.right + velocity.x,
-					objectRect.bottom + velocity.z,
-					objectRect.top + velocity.z
-				};
-
-				// 矩形同士の衝突をチェック
-				bool willCollideX = nextObjectRect.right > blockRect.left &&
-					nextObjectRect.left < blockRect.right;
-				bool willCollideZ = nextObjectRect.top > blockRect.bottom &&
-					nextObjectRect.bottom < blockRect.top;
-
-				if (willCollideX && willCollideZ) {
-					// 衝突情報を作成
-					CollisionInfo info;
-					info.xIndex = xIndex;
-					info.yIndex = zIndex;
-					info.blockType = blockType;
-					info.blockRect = blockRect;
-
-					// 衝突方向と深さを計算
-					// 水平方向
-					float leftPenetration = nextObjectRect.right - blockRect.left;
-					float rightPenetration = blockRect.right - nextObjectRect.left;
-
-					// 垂直方向
-					float topPenetration = nextObjectRect.top - blockRect.bottom;
-					float bottomPenetration = blockRect.top - nextObjectRect.bottom;
-
-					// 最小めり込み方向を探す
-					float minPenetration = std::numeric_limits<float>::max();
-					CollisionDirection collisionDirection{};
-
-					/// 左方向の衝突チェック
-					if ((checkFlags & CollisionFlag::Left) && velocity.x > 0 && leftPenetration < minPenetration) {
-						minPenetration = leftPenetration;
-						collisionDirection = CollisionDirection::LeftDir;
-					}
-
-					/// 右方向の衝突チェック
-					if ((checkFlags & CollisionFlag::Right) && velocity.x < 0 && rightPenetration < minPenetration) {
-						minPenetration = rightPenetration;
-						collisionDirection = CollisionDirection::RightDir;
-					}
-
-					/// 上方向の衝突チェック
-					if ((checkFlags & CollisionFlag::Top) && velocity.z > 0 && topPenetration < minPenetration) {
-						minPenetration = topPenetration;
-						collisionDirection = CollisionDirection::TopDir;
-					}
-
-					/// 下方向の衝突チェック
-					if ((checkFlags & CollisionFlag::Bottom) && velocity.z < 0 && bottomPenetration < minPenetration) {
-						minPenetration = bottomPenetration;
-						collisionDirection = CollisionDirection::BottomDir;
-					}
-
-					// 衝突情報を設定
-					info.direction = collisionDirection;
-					info.penetrationDepth = minPenetration;
-
-					// 衝突リストに追加
-					collisions.push_back(info);
-				}
+				checkRect(xIndex, zIndex, blockType, mapChipField_->GetRectByIndex(xIndex, zIndex));
 			}
 		}
 
@@ -176,6 +200,10 @@ void MapChipCollision::DetectAndResolveCollision(
 				position.z = collision.blockRect.top + colliderRect.height / 2.0f - colliderRect.offsetY;
 				velocity.z = 0;
 				break;
+
+			case CollisionDirection::NoneDir:
+				// チェックする方向が無い重なりは押し戻さない
+				break;
 			}
 
 			// コールバック関数が設定されていれば呼び出す
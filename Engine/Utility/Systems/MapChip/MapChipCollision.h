@@ -1,6 +1,7 @@
 #pragma once
 
 #include "MapChipField.h"
+#include "MapChipBoxes.h"
 #include "Vector3.h"
 #include <functional>
 #include <vector>
@@ -73,7 +74,12 @@ public:
         int checkFlags = CollisionFlag::All,
         std::function<void(const CollisionInfo&)> collisionCallback = nullptr);
 
+    // まとめた矩形を使って判定する (nullptrならマスごとに判定)
+    void SetBoxes(const MapChipBoxes* boxes) { boxes_ = boxes; }
 
 private:
     MapChipField* mapChipField_;
+    const MapChipBoxes* boxes_ = nullptr;
+    // 1回の判定で調べ終わった矩形
+    std::vector<int32_t> visitedBoxes_;
 };
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "MapChipField.h"
+#include "Loaders/Archive/FileSystem.h"
 
 MapChipField::MapChipField() {
     // デフォルトのマップチップタイプを登録
@@ -14,6 +15,7 @@ void MapChipField::ResetMapChipData() {
     mapChipData_.data.clear();
     mapChipData_.data.resize(kNumBlockVertical,
         std::vector<MapChipType>(kNumBlockHorizontal, MapChipType::kBlank));
+    ++revision_;
 }
 
 void MapChipField::RegisterMapChipType(const std::string& key, MapChipType type) {
@@ -25,9 +27,10 @@ void MapChipField::LoadMapChipCsv(const std::string& filePath) {
     ResetMapChipData();
 
     // ファイルを開く
-    std::ifstream file(filePath);
+    FileSystem::FileView view = FileSystem::GetInstance()->Open(filePath);
     // 元のコードと同様に、ファイルが開けなかった場合はassertでエラーを検出
-    assert(file.is_open());
+    assert(view.IsValid());
+    std::istringstream file{ std::string(view.GetText()) };
 
     // 行番号（デバッグ用）
     uint32_t lineNumber = 0;
@@ -80,7 +83,7 @@ void MapChipField::LoadMapChipCsv(const std::string& filePath) {
         ++lineNumber;
     }
 
-    file.close();
+    ++revision_;
 }
 
 MapChipType MapChipField::GetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex) const {
@@ -92,6 +95,18 @@ MapChipType MapChipField::GetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex
     return mapChipData_.data[yIndex][xIndex];
 }
 
+void MapChipField::SetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex, MapChipType type) {
+    if (xIndex >= kNumBlockHorizontal || yIndex >= kNumBlockVertical) {
+        return;
+    }
+    if (mapChipData_.data[yIndex][xIndex] == type) {
+        return;
+    }
+
+    mapChipData_.data[yIndex][xIndex] = type;
+    ++revision_;
+}
+
 Vector3 MapChipField::GetMapChipPositionByIndex(uint32_t xIndex, uint32_t yIndex) {
     return Vector3(
         kBlockWidth * xIndex,
@@ -78,6 +78,19 @@ public:
     /// <returns>ブロックの境界座標</returns>
     Rect GetRectByIndex(uint32_t xIndex, uint32_t yIndex) const;
 
+    /// <summary>
+    /// マップチップの種別を書き換える
+    /// </summary>
+    /// <param name="xIndex">横方向のインデックス</param>
+    /// <param name="yIndex">縦方向のインデックス</param>
+    /// <param name="type">新しいマップチップタイプ</param>
+    void SetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex, MapChipType type);
+
+    /// <summary>
+    /// マップの更新番号を取得 (中身が変わるたびに増える)
+    /// </summary>
+    uint32_t GetRevision() const { return revision_; }
+
     /// <summary>
     /// マップチップタイプの登録
     /// </summary>
@@ -92,6 +105,9 @@ private:
     MapChipData mapChipData_;
     std::map<std::string, MapChipType> mapChipTable_;
 
+    // 中身が変わるたびに進める更新番号
+    uint32_t revision_ = 0;
+
     // 1ブロックのサイズ(2で固定)
     static inline const float kBlockWidth = 2.0f;
     static inline const float kBlockHeight = 2.0f;
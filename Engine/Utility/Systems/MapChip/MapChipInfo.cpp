@@ -1,20 +1,16 @@
 #include "MapChipInfo.h"
+#include "Culling/OcclusionRasterizer.h"
+#include "Loaders/Model/Model.h"
 
-// Math
-#include "Matrix4x4.h"
-#include "MathFunc.h"
+// C++
+#include <chrono>
+
+#ifdef _DEBUG
+#include "imgui.h"
+#endif // _DEBUG
 
 MapChipInfo::~MapChipInfo()
 {
-
-	for (auto& row : wt_) {
-		for (auto& ptr : row) {
-			delete ptr;
-			ptr = nullptr;
-		}
-	}
-
-	//delete obj_;
 	delete mpField_;
 }
 
@@ -23,72 +19,85 @@ void MapChipInfo::Initialize()
 	mpField_ = new MapChipField();
 	mpField_->LoadMapChipCsv("Resources/images/MapChip.csv");
 
+	// 連続したブロックを矩形にまとめる
+	boxes_.Build(*mpField_);
+
+	// マップチップタイプごとのモデル
+	batch_.RegisterModel(MapChipType::kBlock, "cube.obj");
+
 	GenerateBlocks();
 }
 
 void MapChipInfo::Update()
 {
+	// ブロックは動かないので行列の再計算はしない
+	// フィールドが書き換わった時だけ作り直す
+	boxes_.Refresh(*mpField_);
+	GenerateBlocks();
+}
 
-	for (std::vector<WorldTransform*>& row : wt_) {
-		for (WorldTransform* wt : row) {
-			if (wt) {
-				Matrix4x4 scaleMatrix = MakeScaleMatrix(wt->scale_);
-				// 各軸の回転行列
-				Matrix4x4 rotX = MakeRotateMatrixX(wt->rotation_.x);
-				Matrix4x4 rotY = MakeRotateMatrixY(wt->rotation_.y);
-				Matrix4x4 rotZ = MakeRotateMatrixZ(wt->rotation_.z);
-				Matrix4x4 rotXYZ = Multiply(rotX, Multiply(rotY, rotZ));
-				// 平行移動行列
-				Matrix4x4 translateMatrix = MakeTranslateMatrix(wt->translation_);
-				wt->UpdateMatrix();
-			}
-		}
-	}
-
-
+void MapChipInfo::SetMapChipType(uint32_t xIndex, uint32_t yIndex, MapChipType type)
+{
+	mpField_->SetMapChipTypeByIndex(xIndex, yIndex, type);
+	boxes_.OnCellChanged(*mpField_, xIndex, yIndex);
 }
 
 void MapChipInfo::Draw() {
-	for (uint32_t i = 0; i < wt_.size(); ++i) {
-		for (uint32_t j = 0; j < wt_[i].size(); ++j) {
-			if (wt_[i][j] && objects_[i][j]) {
-				objects_[i][j]->Draw(camera_, *wt_[i][j]);
-			}
-		}
+	for (std::unique_ptr<Object3dInstancing>& instancing : instancings_) {
+		instancing->Draw(camera_);
 	}
 }
 
+void MapChipInfo::AddOccluders(OcclusionRasterizer& occlusion)
+{
+	const std::vector<MapChipBatch::Batch>& batches = batch_.GetBatches();
+	for (size_t i = 0; i < batches.size() && i < instancings_.size(); ++i) {
+		// インスタンスと同じ行列でモデルの範囲の箱を描く
+		const AABB& bounds = instancings_[i]->GetModel()->GetLocalBounds();
+		for (const Matrix4x4& worldMatrix : batches[i].worldMatrices) {
+			occlusion.AddOccluderBox(bounds, worldMatrix);
+		}
+	}
+}
 
 void MapChipInfo::GenerateBlocks()
 {
-	// 要素数
-	uint32_t numBlockVirtical = mpField_->GetNumBlockVertical();
-	uint32_t numBlockHorizotal = mpField_->GetNumBlockHorizontal();
-	// 列数を設定 (縦方向のブロック数)
-	wt_.resize(numBlockVirtical);
-	objects_.resize(numBlockVirtical);
-	// キューブの生成
-	for (uint32_t i = 0; i < numBlockVirtical; ++i) {
-		// 1列の要素数を設定 (横方向のブロック数)
-		wt_[i].resize(numBlockHorizotal);
-		objects_[i].resize(numBlockHorizotal);
+	auto start = std::chrono::steady_clock::now();
+
+	if (!batch_.Build(*mpField_)) {
+		return;
 	}
-	// ブロックの生成
-	for (uint32_t i = 0; i < numBlockVirtical; ++i) {
-		for (uint32_t j = 0; j < numBlockHorizotal; ++j) {
-			// どちらも2で割り切れる時またはどちらも割り切れない時
-			//i % 2 == 0 && j % 2 == 0 || i % 2 != 0 && j % 2 != 0 02_02の穴あき
-			if (mpField_->GetMapChipTypeByIndex(j, i) == MapChipType::kBlock) {
-				WorldTransform* worldTransform = new WorldTransform();
-				worldTransform->Initialize();
-				wt_[i][j] = worldTransform;
-				wt_[i][j]->translation_ = mpField_->GetMapChipPositionByIndex(j, i);
-
-				Object3d* obj = new Object3d();
-				obj->Initialize();
-				obj->SetModel("cube.obj");
-				objects_[i][j] = obj;
-			}
-		}
+
+	const std::vector<MapChipBatch::Batch>& batches = batch_.GetBatches();
+	// 最大数はマップ全体のマス数
+	uint32_t maxInstance = MapChipField::GetNumBlockVertical() * MapChipField::GetNumBlockHorizontal();
+
+	// モデルが増えた分だけ生成
+	while (instancings_.size() < batches.size()) {
+		std::unique_ptr<Object3dInstancing> instancing = std::make_unique<Object3dInstancing>();
+		instancing->Initialize(maxInstance);
+		instancing->SetModel(batches[instancings_.size()].modelName);
+		instancings_.push_back(std::move(instancing));
+	}
+
+	for (size_t i = 0; i < batches.size(); ++i) {
+		instancings_[i]->SetInstances(batches[i].worldMatrices);
+	}
+
+	lastBuildMs_ = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void MapChipInfo::ShowImGui()
+{
+#ifdef _DEBUG
+	ImGui::Begin("MapChip");
+	ImGui::Text("Boxes     : %u", static_cast<uint32_t>(boxes_.GetBoxes().size()));
+	ImGui::Text("Instances : %u", batch_.GetInstanceCount());
+	ImGui::Text("DrawCalls : %u", GetDrawCallCount());
+	ImGui::Text("Build     : %.3f ms", lastBuildMs_);
+	if (ImGui::Checkbox("Draw Merged Boxes", &isDrawMergedBoxes_)) {
+		batch_.SetBoxes(isDrawMergedBoxes_ ? &boxes_ : nullptr);
 	}
+	ImGui::End();
+#endif // _DEBUG
 }
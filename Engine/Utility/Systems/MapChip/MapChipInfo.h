@@ -3,15 +3,19 @@
 // Engine
 #include "MapChipField.h"
 #include "MapChipCollision.h"
+#include "MapChipBatch.h"
+#include "MapChipBoxes.h"
 #include "Systems/Camera/Camera.h"
-#include "Object3D/Object3d.h"
-#include "WorldTransform/WorldTransform.h"
+#include "Object3D/Object3dInstancing.h"
 
 // C++ 
+#include <memory>
 #include <vector>
 
 // Math
 
+class OcclusionRasterizer;
+
 class MapChipInfo
 {
 public:
@@ -30,20 +34,36 @@ public:
 
 	/// <summary>
 	/// 描画
+	/// Object3dCommon::DrawPreferenceInstancing の後に呼ぶ
 	/// </summary>
 	void Draw();
 
+	/// <summary>
+	/// 遮蔽物としてブロックの箱を追加
+	/// </summary>
+	void AddOccluders(OcclusionRasterizer& occlusion);
+
 	/// <summary>
 	/// カメラのセット
 	/// </summary>
 	/// <param name="camera"></param>
 	void SetCamera(Camera* camera) { camera_ = camera; }
 
+	/// <summary>
+	/// マスを書き換える (まとめた矩形も部分的に更新される)
+	/// </summary>
+	void SetMapChipType(uint32_t xIndex, uint32_t yIndex, MapChipType type);
+
+	/// <summary>
+	/// ImGui
+	/// </summary>
+	void ShowImGui();
 
 private:
 
 	/// <summary>
 	/// ブロック生成
+	/// フィールドが変わった時だけインスタンスを作り直す
 	/// </summary>
 	void GenerateBlocks();
 
@@ -51,8 +71,11 @@ private:
 public:
 
 	void SetMapChipField(MapChipField* mpField) { mpField_ = mpField; }
-	void SetWorldTransform(std::vector<std::vector<WorldTransform*>> wt) { wt_ = wt; }
 	MapChipField* GetMapChipField() { return mpField_; }
+	const MapChipBoxes* GetMapChipBoxes() const { return &boxes_; }
+
+	// 1フレームのドローコール数
+	uint32_t GetDrawCallCount() const { return static_cast<uint32_t>(instancings_.size()); }
 
 private:
 	/*=======================================================================
@@ -61,8 +84,18 @@ private:
 
 	========================================================================*/
 	Camera* camera_ = nullptr;
-	std::vector<std::vector<WorldTransform*>> wt_;
 	MapChipField* mpField_ = nullptr;
-	std::vector<std::vector<Object3d*>> objects_;
-};
 
+	// 連続したブロックをまとめた矩形
+	MapChipBoxes boxes_;
+	// 描画もまとめた矩形で行うか
+	bool isDrawMergedBoxes_ = false;
+
+	// モデルごとのインスタンス配列
+	MapChipBatch batch_;
+	// バッチと同じ並びの描画用オブジェクト
+	std::vector<std::unique_ptr<Object3dInstancing>> instancings_;
+
+	// 最後に作り直すのにかかった時間 (ミリ秒)
+	float lastBuildMs_ = 0.0f;
+};
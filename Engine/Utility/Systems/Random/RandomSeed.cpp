@@ -0,0 +1,27 @@
+#include "RandomSeed.h"
+
+/// <summary>
+/// 元になるシードを決める
+/// </summary>
+void RandomSeed::Initialize(uint32_t seed)
+{
+	seed_ = seed;
+	engine_.seed(seed);
+}
+
+/// <summary>
+/// 乱数エンジン用のシードを1つ払い出す
+/// </summary>
+uint32_t RandomSeed::Next()
+{
+	return static_cast<uint32_t>(engine_());
+}
+
+/// <summary>
+/// 起動ごとに変わるシード
+/// </summary>
+uint32_t RandomSeed::MakeNondeterministicSeed()
+{
+	std::random_device device;
+	return device();
+}
@@ -0,0 +1,46 @@
+#pragma once
+// C++
+#include <cstdint>
+#include <random>
+
+/// <summary>
+/// 乱数のシードの取得元
+/// ゲーム中の乱数エンジンはここからシードをもらうので、元のシードが同じなら同じ並びになる
+/// (入力の再生時は記録したシードを使い、記録したプレイを再現する)
+/// </summary>
+class RandomSeed
+{
+public:
+
+	static RandomSeed* GetInstance() {
+		static RandomSeed instance;
+		return &instance;
+	}
+
+	/// <summary>
+	/// 元になるシードを決める
+	/// </summary>
+	void Initialize(uint32_t seed);
+
+	/// <summary>
+	/// 乱数エンジン用のシードを1つ払い出す (呼んだ順に決まった値が出る)
+	/// </summary>
+	uint32_t Next();
+
+	/// <summary>
+	/// 起動ごとに変わるシード (再現しなくてよい時の元のシード)
+	/// </summary>
+	static uint32_t MakeNondeterministicSeed();
+
+	uint32_t GetSeed() const { return seed_; }
+
+private:
+
+	RandomSeed() = default;
+	~RandomSeed() = default;
+	RandomSeed(const RandomSeed&) = delete;
+	RandomSeed& operator=(const RandomSeed&) = delete;
+
+	uint32_t seed_ = 0;
+	std::mt19937 engine_;
+};
@@ -4,6 +4,7 @@
 #include <chrono>
 #include <thread>
 #include "Sprite/SpriteCommon.h"
+#include "Loaders/Archive/FileSystem.h"
 
 #ifdef _DEBUG
 #include <imgui.h>
@@ -30,7 +31,7 @@ void UIBase::Initialize(const std::string& jsonConfigPath) {
     sprite_ = std::make_unique<Sprite>();
 
     // JSONファイルが存在するか確認
-    bool jsonExists = std::filesystem::exists(jsonConfigPath);
+    bool jsonExists = FileSystem::GetInstance()->Exists(jsonConfigPath);
 
     if (jsonExists) {
         // JSONファイルが存在する場合は読み込み
@@ -61,11 +62,6 @@ void UIBase::Update() {
     if (sprite_) {
         sprite_->Update();
     }
-
-#ifdef _DEBUG
-    ImGUi();
-#endif // _DEBUG
-
 }
 
 void UIBase::Draw() {
@@ -140,6 +136,13 @@ void UIBase::ImGUi() {
             SetFlipY(flipY);
             modified = true;
         }
+
+        // 描画レイヤー
+        int layer = GetLayer();
+        if (ImGui::InputInt("レイヤー", &layer)) {
+            SetLayer(layer);
+            modified = true;
+        }
     }
 
     // テクスチャ設定
@@ -386,15 +389,14 @@ void UIBase::CheckForChanges() {
 bool UIBase::LoadFromJSON(const std::string& jsonPath) {
     try {
         // JSONファイルを開く
-        std::ifstream file(jsonPath);
-        if (!file.is_open()) {
+        FileSystem::FileView file = FileSystem::GetInstance()->Open(jsonPath);
+        if (!file.IsValid()) {
             return false;
         }
 
         // JSONをパース
-        nlohmann::json data;
-        file >> data;
-        file.close();
+        const std::string_view text = file.GetText();
+        nlohmann::json data = nlohmann::json::parse(text.begin(), text.end());
 
         // JSONを現在の状態に適用
         ApplyJSONToState(data);
@@ -547,6 +549,19 @@ void UIBase::SetFlipY(bool flipY) {
     }
 }
 
+void UIBase::SetLayer(int32_t layer) {
+    if (sprite_) {
+        sprite_->SetLayer(layer);
+    }
+}
+
+int32_t UIBase::GetLayer() const {
+    if (sprite_) {
+        return sprite_->GetLayer();
+    }
+    return 0;
+}
+
 bool UIBase::GetFlipX() const {
     if (sprite_) {
         return sprite_->GetIsFlipX();
@@ -637,6 +652,9 @@ nlohmann::json UIBase::CreateJSONFromCurrentState() {
     data["flipX"] = GetFlipX();
     data["flipY"] = GetFlipY();
 
+    // 描画レイヤー
+    data["layer"] = GetLayer();
+
     // テクスチャプロパティ
     if (sprite_) {
         data["textureLeftTop"] = {
@@ -735,6 +753,11 @@ void UIBase::ApplyJSONToState(const nlohmann::json& data) {
         SetFlipY(data["flipY"]);
     }
 
+    // 描画レイヤー
+    if (data.contains("layer")) {
+        SetLayer(data["layer"]);
+    }
+
     // テクスチャプロパティ
     if (sprite_) {
         if (data.contains("textureLeftTop")) {
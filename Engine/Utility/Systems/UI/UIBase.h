@@ -143,6 +143,12 @@ public:
     bool GetFlipX() const;
     bool GetFlipY() const;
 
+    /// <summary>
+    ///  描画レイヤーを設定 (小さいほど奥に描画される)
+    /// </summary>
+    void SetLayer(int32_t layer);
+    int32_t GetLayer() const;
+
     /// <summary>
     ///  スプライトポインタを取得
     /// </summary>
@@ -16,6 +16,13 @@ float Lerp(float a, float b, float t)
     return (1.0f - t) * a + t * b;
 }
 
+float LerpShortAngle(float a, float b, float t)
+{
+    const float kTwoPi = 6.28318530718f;
+    float diff = std::remainder(b - a, kTwoPi);
+    return a + diff * t;
+}
+
 
 
 float Magnitude(const float& v) {
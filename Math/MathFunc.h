@@ -78,6 +78,9 @@ float Distance(const Vector3& a, const Vector3& b);
 
 float Lerp(float a, float b, float t);
 
+// 角度を近い方向に補間する関数
+float LerpShortAngle(float a, float b, float t);
+
 // Vector3の長さの二乗を計算する関数
 float LengthSquared(const Vector3& v);
 
@@ -1,11 +1,15 @@
 #include "Object3d.hlsli"
-struct TransformationMatrix
+struct InstanceForGPU
 {
-    float4x4 WVP;
     float4x4 World;
     float4x4 WorldInverseTranspose;
 };
-ConstantBuffer<TransformationMatrix> gTransformationMatrix : register(b0);
+struct ViewProjection
+{
+    float4x4 VP;
+};
+StructuredBuffer<InstanceForGPU> gInstance : register(t0);
+ConstantBuffer<ViewProjection> gViewProjection : register(b0);
 
 struct VertexShaderInput
 {
@@ -13,13 +17,13 @@ struct VertexShaderInput
     float2 texcoord : TEXCOORD0;
     float3 normal : NORMAL0;
 };
-VertexShaderOutput main(VertexShaderInput input)
+VertexShaderOutput main(VertexShaderInput input, uint instanceId : SV_InstanceID)
 {
     VertexShaderOutput output;
-    output.position = mul(input.position, gTransformationMatrix.WVP);
+    float4 worldPosition = mul(input.position, gInstance[instanceId].World);
+    output.position = mul(worldPosition, gViewProjection.VP);
     output.texcoord = input.texcoord;
-    output.normal = normalize(mul(input.normal, (float3x3) gTransformationMatrix.World));
-    output.worldPosition = mul(input.position, gTransformationMatrix.World).xyz;
-    output.normal = normalize(mul(input.normal, (float3x3) gTransformationMatrix.WorldInverseTranspose));
+    output.worldPosition = worldPosition.xyz;
+    output.normal = normalize(mul(input.normal, (float3x3) gInstance[instanceId].WorldInverseTranspose));
     return output;
 }
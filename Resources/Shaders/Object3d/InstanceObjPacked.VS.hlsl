@@ -0,0 +1,49 @@
+#include "Object3d.hlsli"
+struct InstanceForGPU
+{
+    float4x4 World;
+    float4x4 WorldInverseTranspose;
+};
+struct ViewProjection
+{
+    float4x4 VP;
+};
+// 圧縮頂点の位置の復元用 (VertexQuantizer::QuantizationParams と同じレイアウト)
+struct Dequantize
+{
+    float3 offset;
+    float padding0;
+    float3 scale;
+    float padding1;
+};
+StructuredBuffer<InstanceForGPU> gInstance : register(t0);
+ConstantBuffer<ViewProjection> gViewProjection : register(b0);
+ConstantBuffer<Dequantize> gDequantize : register(b1);
+
+struct VertexShaderInput
+{
+    float4 position : POSITION;  // R16G16B16A16_UNORM
+    float2 texcoord : TEXCOORD0; // R16G16_FLOAT
+    float2 normal : NORMAL0;     // R16G16_SNORM (八面体マッピング)
+};
+
+float3 DecodeOctahedral(float2 e)
+{
+    float3 n = float3(e.x, e.y, 1.0f - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+    return normalize(n);
+}
+
+VertexShaderOutput main(VertexShaderInput input, uint instanceId : SV_InstanceID)
+{
+    VertexShaderOutput output;
+    float4 localPosition = float4(gDequantize.offset + input.position.xyz * gDequantize.scale, 1.0f);
+    float4 worldPosition = mul(localPosition, gInstance[instanceId].World);
+    output.position = mul(worldPosition, gViewProjection.VP);
+    output.texcoord = input.texcoord;
+    output.worldPosition = worldPosition.xyz;
+    output.normal = normalize(mul(DecodeOctahedral(input.normal), (float3x3) gInstance[instanceId].WorldInverseTranspose));
+    return output;
+}
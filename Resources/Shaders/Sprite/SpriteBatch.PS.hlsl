@@ -0,0 +1,16 @@
+#include "SpriteBatch.hlsli"
+
+struct PixelShaderOutput
+{
+    float4 color : SV_TARGET0;
+};
+
+Texture2D<float4> gTexture : register(t0);
+SamplerState gSampler : register(s0);
+PixelShaderOutput main(VertexShaderOutput input)
+{
+    PixelShaderOutput output;
+    float4 textureColor = gTexture.Sample(gSampler, input.texcoord);
+    output.color = input.color * textureColor;
+    return output;
+}
@@ -0,0 +1,17 @@
+#include "SpriteBatch.hlsli"
+
+// 座標はCPU側でクリップ空間まで変換済み
+struct VertexShaderInput
+{
+    float4 position : POSITION;
+    float2 texcoord : TEXCOORD0;
+    float4 color : COLOR0;
+};
+VertexShaderOutput main(VertexShaderInput input)
+{
+    VertexShaderOutput output;
+    output.position = input.position;
+    output.texcoord = input.texcoord;
+    output.color = input.color;
+    return output;
+}
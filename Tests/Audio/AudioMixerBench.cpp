@@ -0,0 +1,71 @@
+// C++
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Engine
+#include "AudioMixer.h"
+#include "MixerKernels.h"
+
+/// <summary>
+/// 64 / 256 / 1024 ボイス (変換だけ・再サンプル・ステレオの再サンプルを 1/3 ずつ) を混ぜる時間を、
+/// SIMD とスカラーで比べる
+/// </summary>
+int main()
+{
+	std::mt19937 random(1);
+	std::vector<int16_t> mono44(44100), stereo44(44100 * 2), mono48(48000);
+	for (std::vector<int16_t>* wave : { &mono44, &stereo44, &mono48 }) {
+		for (int16_t& sample : *wave) {
+			sample = static_cast<int16_t>(random());
+		}
+	}
+	const AudioFormat mono48Format = { 1, 1, 48000, 16, 2 };
+	const AudioFormat mono44Format = { 1, 1, 44100, 16, 2 };
+	const AudioFormat stereo44Format = { 1, 2, 44100, 16, 4 };
+
+	for (uint32_t count : { 64u, 256u, 1024u }) {
+		for (bool simd : { true, false }) {
+			MixerKernels::SetSimdEnabled(simd);
+			AudioMixer mixer;
+			std::vector<float> out(mixer.GetBlockFrames() * AudioMixer::kOutputChannels);
+			for (uint32_t i = 0; i < count; ++i) {
+				IAudioBackend::VoiceId voice = IAudioBackend::kInvalidVoice;
+				switch (i % 3) {
+				case 0:
+					voice = mixer.CreateVoice(mono48Format);
+					mixer.Play(voice, reinterpret_cast<const uint8_t*>(mono48.data()), 96000, true, 0);
+					break;
+				case 1:
+					voice = mixer.CreateVoice(mono44Format);
+					mixer.Play(voice, reinterpret_cast<const uint8_t*>(mono44.data()), 88200, true, 0);
+					break;
+				default:
+					voice = mixer.CreateVoice(stereo44Format);
+					mixer.Play(voice, reinterpret_cast<const uint8_t*>(stereo44.data()), 176400, true, 0);
+					break;
+				}
+				mixer.SetVolume(voice, 0.01f);
+				mixer.SetPan(voice, (i % 7) / 3.0f - 1.0f);
+			}
+			for (int i = 0; i < 50; ++i) {
+				mixer.Render(out.data());
+			}
+
+			const int blocks = count >= 1024 ? 400 : 2000;
+			const auto start = std::chrono::steady_clock::now();
+			for (int i = 0; i < blocks; ++i) {
+				mixer.Render(out.data());
+			}
+			const double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / blocks;
+			const double blockMicroseconds = mixer.GetBlockFrames() * 1e6 / AudioMixer::kDefaultSampleRate;
+			std::printf("%4u voices %-6s %8.1f us/block (%5.1f%% of a %.2f ms block) %6.1f ns/voice-frame\n",
+				count, simd ? "SIMD" : "scalar", microseconds, microseconds / blockMicroseconds * 100.0, blockMicroseconds / 1000.0,
+				microseconds * 1000.0 / (count * mixer.GetBlockFrames()));
+		}
+	}
+	MixerKernels::SetSimdEnabled(true);
+	return 0;
+}
@@ -0,0 +1,329 @@
+// C++
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Engine
+#include "AudioMixer.h"
+#include "AudioStream.h"
+#include "MixerKernels.h"
+#include "NullStreamOutput.h"
+#include "VoicePool.h"
+#include "WaveDecoder.h"
+#include "WaveFileStreamOutput.h"
+
+// Test
+#include "TestCommon.h"
+
+namespace {
+
+	const AudioFormat kMono16 = { 1, 1, 48000, 16, 2 };
+	const AudioFormat kMono24k = { 1, 1, 24000, 16, 2 };
+	const AudioFormat kStereoFloat = { 3, 2, 48000, 32, 8 };
+
+	bool Near(float a, float b, float epsilon = 1e-5f)
+	{
+		return std::fabs(a - b) <= epsilon;
+	}
+
+	const uint8_t* Bytes(const void* data)
+	{
+		return static_cast<const uint8_t*>(data);
+	}
+
+	/// <summary>
+	/// SIMD版とスカラー版が同じ結果を出す (端数の長さも含めて)
+	/// </summary>
+	void TestKernelsMatchScalar()
+	{
+		std::mt19937 random(1);
+		std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+		bool convertSame = true;
+		bool resampleNear = true;
+		bool mixNear = true;
+		for (uint32_t n : { 1u, 3u, 7u, 8u, 9u, 31u, 257u }) {
+			std::vector<int16_t> pcm(n * 2);
+			for (int16_t& sample : pcm) {
+				sample = static_cast<int16_t>(random());
+			}
+			std::vector<float> simd(n * 2), scalar(n * 2);
+			MixerKernels::SetSimdEnabled(true);
+			MixerKernels::ConvertPcm16(pcm.data(), simd.data(), n * 2);
+			MixerKernels::SetSimdEnabled(false);
+			MixerKernels::ConvertPcm16(pcm.data(), scalar.data(), n * 2);
+			convertSame = convertSame && simd == scalar && scalar[0] == pcm[0] / 32768.0f;
+
+			std::vector<float> source(n * 8 + 8);
+			for (float& sample : source) {
+				sample = uniform(random);
+			}
+			for (uint32_t channels = 1; channels <= 2; ++channels) {
+				const uint64_t step = static_cast<uint64_t>(0.73 * 4294967296.0);
+				const uint64_t position = 12345678;
+				std::vector<float> a(n * channels), b(n * channels);
+				MixerKernels::SetSimdEnabled(true);
+				MixerKernels::ResampleLinear(source.data(), channels, position, step, a.data(), n);
+				MixerKernels::SetSimdEnabled(false);
+				MixerKernels::ResampleLinear(source.data(), channels, position, step, b.data(), n);
+				for (size_t i = 0; i < a.size(); ++i) {
+					resampleNear = resampleNear && Near(a[i], b[i], 1e-6f);
+				}
+			}
+
+			std::vector<float> mixA(n * 2, 0.5f), mixB(n * 2, 0.5f);
+			MixerKernels::SetSimdEnabled(true);
+			MixerKernels::MixMonoToStereo(source.data(), mixA.data(), n, 0.3f, 0.9f);
+			MixerKernels::MixStereoToStereo(source.data(), mixA.data(), n, 0.2f, 0.4f);
+			MixerKernels::SetSimdEnabled(false);
+			MixerKernels::MixMonoToStereo(source.data(), mixB.data(), n, 0.3f, 0.9f);
+			MixerKernels::MixStereoToStereo(source.data(), mixB.data(), n, 0.2f, 0.4f);
+			for (size_t i = 0; i < mixA.size(); ++i) {
+				mixNear = mixNear && Near(mixA[i], mixB[i], 1e-6f);
+			}
+		}
+		MixerKernels::SetSimdEnabled(true);
+		CHECK(convertSame);
+		CHECK(resampleNear);
+		CHECK(mixNear);
+	}
+
+	/// <summary>
+	/// 同じ速さの波形: 音量・パンがそのまま掛かり、鳴り終えたら通知が来る
+	/// </summary>
+	void TestVolumeAndPan()
+	{
+		AudioMixer mixer;
+		std::vector<float> out(256 * 2);
+		std::vector<int16_t> pcm(300);
+		for (int i = 0; i < 300; ++i) {
+			pcm[i] = static_cast<int16_t>(i * 100 - 15000);
+		}
+
+		const IAudioBackend::VoiceId voice = mixer.CreateVoice(kMono16);
+		CHECK(voice != IAudioBackend::kInvalidVoice);
+		// 8bit と 6ch は扱わない
+		CHECK(mixer.CreateVoice(AudioFormat{ 1, 1, 48000, 8, 1 }) == IAudioBackend::kInvalidVoice);
+		CHECK(mixer.CreateVoice(AudioFormat{ 1, 6, 48000, 16, 12 }) == IAudioBackend::kInvalidVoice);
+
+		mixer.SetVolume(voice, 0.5f);
+		CHECK(mixer.Play(voice, Bytes(pcm.data()), 600, false, 77));
+		mixer.Render(out.data());
+		bool centered = true;
+		for (int i = 0; i < 256; ++i) {
+			centered = centered && out[i * 2] == pcm[i] / 32768.0f * 0.5f && out[i * 2 + 1] == out[i * 2];
+		}
+		CHECK(centered);
+		std::vector<IAudioBackend::Finished> finished;
+		mixer.CollectFinished(finished);
+		CHECK(finished.empty());
+
+		// 左だけ、44サンプルで鳴り終えて後ろは無音
+		mixer.SetPan(voice, -1.0f);
+		mixer.Render(out.data());
+		bool left = true;
+		for (int i = 0; i < 44; ++i) {
+			left = left && out[i * 2] == pcm[256 + i] / 32768.0f * 0.5f && out[i * 2 + 1] == 0.0f;
+		}
+		for (int i = 44; i < 256; ++i) {
+			left = left && out[i * 2] == 0.0f && out[i * 2 + 1] == 0.0f;
+		}
+		CHECK(left);
+		mixer.CollectFinished(finished);
+		CHECK(finished.size() == 1 && finished[0].voice == voice && finished[0].context == 77);
+		CHECK(mixer.GetActiveCount() == 0);
+
+		// ちょうどブロックの終わりで鳴り終える
+		CHECK(mixer.Play(voice, Bytes(pcm.data()), 512, false, 78));
+		mixer.Render(out.data());
+		finished.clear();
+		mixer.CollectFinished(finished);
+		CHECK(finished.size() == 1 && finished[0].context == 78);
+	}
+
+	/// <summary>
+	/// 再サンプル (24kHz → 48kHz) とループ、ピッチ、終端の補間
+	/// </summary>
+	void TestResampleAndLoop()
+	{
+		AudioMixer mixer;
+		std::vector<float> out(256 * 2);
+		std::vector<int16_t> pcm(100);
+		for (int i = 0; i < 100; ++i) {
+			pcm[i] = static_cast<int16_t>((i % 17) * 1000);
+		}
+
+		const IAudioBackend::VoiceId voice = mixer.CreateVoice(kMono24k);
+		CHECK(mixer.Play(voice, Bytes(pcm.data()), 200, true, 1));
+		bool interpolated = true;
+		for (int block = 0; block < 3; ++block) {
+			mixer.Render(out.data());
+			for (int i = 0; i < 256; ++i) {
+				const double position = (block * 256 + i) * 0.5;
+				const int index = static_cast<int>(position) % 100;
+				const double t = position - static_cast<int>(position);
+				const double a = pcm[index] / 32768.0;
+				const double b = pcm[(index + 1) % 100] / 32768.0;
+				interpolated = interpolated && Near(out[i * 2], static_cast<float>(a + (b - a) * t));
+			}
+		}
+		CHECK(interpolated);
+		std::vector<IAudioBackend::Finished> finished;
+		mixer.CollectFinished(finished);
+		CHECK(finished.empty());
+
+		// ピッチ2倍なら出力と同じ速さ
+		mixer.Stop(voice);
+		CHECK(mixer.Play(voice, Bytes(pcm.data()), 200, true, 2));
+		mixer.SetPitch(voice, 2.0f);
+		mixer.Render(out.data());
+		bool sameRate = true;
+		for (int i = 0; i < 256; ++i) {
+			sameRate = sameRate && Near(out[i * 2], pcm[i % 100] / 32768.0f, 1e-6f);
+		}
+		CHECK(sameRate);
+
+		// ループしない終端: 最後のサンプルは自分自身と補間する
+		mixer.Stop(voice);
+		CHECK(mixer.Play(voice, Bytes(pcm.data()), 200, false, 3));
+		mixer.Render(out.data());
+		CHECK(Near(out[199 * 2], pcm[99] / 32768.0f));
+		CHECK(out[200 * 2] == 0.0f);
+		mixer.CollectFinished(finished);
+		CHECK(finished.size() == 1);
+	}
+
+	/// <summary>
+	/// ボイスプールの再生先として: 鳴り終えたボイスが Update でプールへ戻る
+	/// </summary>
+	void TestAsVoicePoolBackend()
+	{
+		AudioMixer mixer;
+		VoicePool pool;
+		pool.Initialize(&mixer, 4);
+		const std::vector<int16_t> pcm(1000, 1000);
+		const std::vector<float> stereo(8000, 0.25f);
+
+		const VoicePool::Handle mono = pool.Play(kMono16, Bytes(pcm.data()), 2000);
+		const VoicePool::Handle right = pool.Play(kStereoFloat, Bytes(stereo.data()), 32000);
+		CHECK(mono != VoicePool::kInvalidHandle && right != VoicePool::kInvalidHandle);
+		CHECK(mixer.GetActiveCount() == 2);
+
+		std::vector<float> out(512);
+		mixer.SetPan(pool.GetVoiceId(right), 1.0f);
+		mixer.Render(out.data());
+		CHECK(Near(out[0], 1000 / 32768.0f));
+		CHECK(Near(out[1], 1000 / 32768.0f + 0.25f));
+
+		for (int i = 0; i < 4; ++i) {
+			mixer.Render(out.data());
+		}
+		pool.Update();
+		CHECK(!pool.IsPlaying(mono));
+		CHECK(pool.IsPlaying(right));
+		for (int i = 0; i < 20; ++i) {
+			mixer.Render(out.data());
+		}
+		pool.Update();
+		CHECK(pool.GetActiveCount() == 0);
+		CHECK(pool.GetVoiceId(right) == IAudioBackend::kInvalidVoice);
+		pool.Finalize();
+	}
+
+	/// <summary>
+	/// AudioStream で流した結果は直接 Render したものと同じで、WAVへ書いて読み直しても変わらない
+	/// </summary>
+	void TestStreamAndWaveFile()
+	{
+		std::vector<int16_t> pcm(48000);
+		for (int i = 0; i < 48000; ++i) {
+			pcm[i] = static_cast<int16_t>(std::sin(i * 0.05) * 20000);
+		}
+		constexpr uint32_t kBlocks = 200;
+		constexpr uint32_t kBlockBytes = 256 * 2 * sizeof(float);
+
+		// 直接 Render した結果
+		std::vector<float> expected;
+		std::vector<float> block(512);
+		{
+			AudioMixer reference;
+			const IAudioBackend::VoiceId voice = reference.CreateVoice(kMono16);
+			reference.Play(voice, Bytes(pcm.data()), 96000, false, 0);
+			for (uint32_t i = 0; i < kBlocks; ++i) {
+				reference.Render(block.data());
+				expected.insert(expected.end(), block.begin(), block.end());
+			}
+		}
+
+		{
+			AudioMixer mixer;
+			const IAudioBackend::VoiceId voice = mixer.CreateVoice(kMono16);
+			auto nullOutput = std::make_unique<NullStreamOutput>();
+			NullStreamOutput* output = nullOutput.get();
+			output->SetCapture(true);
+			AudioStream stream;
+			AudioStream::Settings settings;
+			settings.bufferCount = 3;
+			settings.bufferMilliseconds = 10;
+			CHECK(stream.Open(mixer.CreateSource(), std::move(nullOutput), settings));
+			mixer.Play(voice, Bytes(pcm.data()), 96000, false, 0);
+			stream.Play();
+			for (int i = 0; i < 120; ++i) {
+				for (int wait = 0; wait < 1000 && output->GetQueuedCount() < 3; ++wait) {
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+				output->Advance(0.01);
+			}
+			const std::vector<uint8_t> captured = output->TakeCaptured();
+			CHECK(captured.size() >= 48000 * 8 && captured.size() % 8 == 0);
+			CHECK(captured.size() >= 48000 * 8 && std::memcmp(captured.data(), expected.data(), 48000 * 8) == 0);
+			stream.Close();
+		}
+
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / "AudioMixerTest.wav";
+		AudioMixer mixer;
+		const IAudioBackend::VoiceId voice = mixer.CreateVoice(kMono16);
+		mixer.Play(voice, Bytes(pcm.data()), 96000, false, 0);
+		{
+			WaveFileStreamOutput file(path.string());
+			CHECK(file.Open(mixer.GetOutputFormat()));
+			bool written = true;
+			for (uint32_t i = 0; i < kBlocks; ++i) {
+				mixer.Render(block.data());
+				written = file.Submit(Bytes(block.data()), kBlockBytes) && written;
+			}
+			CHECK(written);
+		}
+
+		std::ifstream stream(path, std::ios::binary);
+		const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+		stream.close();
+		std::filesystem::remove(path);
+
+		WaveDecoder decoder;
+		CHECK(decoder.Open(bytes.data(), bytes.size()));
+		CHECK(decoder.GetFormat() == mixer.GetOutputFormat());
+		CHECK(decoder.GetTotalSamples() == kBlocks * 256);
+		std::vector<uint8_t> decoded(kBlocks * kBlockBytes);
+		CHECK(decoder.Read(decoded.data(), static_cast<uint32_t>(decoded.size())) == decoded.size());
+		CHECK(std::memcmp(decoded.data(), expected.data(), decoded.size()) == 0);
+	}
+
+} // namespace
+
+int main()
+{
+	TestKernelsMatchScalar();
+	TestVolumeAndPan();
+	TestResampleAndLoop();
+	TestAsVoicePoolBackend();
+	TestStreamAndWaveFile();
+	return Test::Finish("AudioMixerTest");
+}
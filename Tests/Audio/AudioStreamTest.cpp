@@ -0,0 +1,309 @@
+// C++
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Engine
+#include "AudioStream.h"
+#include "NullStreamOutput.h"
+#include "WaveDecoder.h"
+
+// Test
+#include "TestCommon.h"
+#include "WaveBuilder.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+	// 8kHz ステレオ 2秒
+	constexpr uint32_t kSampleRate = 8000;
+	constexpr uint32_t kSampleCount = kSampleRate * 2;
+	constexpr uint32_t kBlockAlign = 4;
+
+	/// <summary>
+	/// デコード用スレッドが追い付くのを待つ (2秒で諦める)
+	/// </summary>
+	template <typename Predicate>
+	bool WaitFor(Predicate predicate)
+	{
+		for (int i = 0; i < 2000; ++i) {
+			if (predicate()) {
+				return true;
+			}
+			std::this_thread::sleep_for(1ms);
+		}
+		return false;
+	}
+
+	/// <summary>
+	/// 出力を実時間に近い速さで進める
+	/// </summary>
+	void Run(NullStreamOutput* output, double seconds)
+	{
+		for (double time = 0.0; time < seconds; time += 0.01) {
+			output->Advance(0.01);
+			std::this_thread::sleep_for(1ms);
+		}
+	}
+
+	/// <summary>
+	/// pcm の offset バイト目から captured と同じ並びか
+	/// </summary>
+	bool MatchesAt(const std::vector<uint8_t>& captured, const std::vector<uint8_t>& pcm, size_t offset)
+	{
+		return !captured.empty() && offset + captured.size() <= pcm.size() && std::memcmp(captured.data(), pcm.data() + offset, captured.size()) == 0;
+	}
+
+	struct Fixture {
+		std::vector<uint8_t> pcm;
+		std::vector<uint8_t> wave;
+		AudioStream stream;
+		NullStreamOutput* output = nullptr;
+
+		bool Open(const AudioStream::Settings& settings, bool capture)
+		{
+			wave = WaveBuilder::MakePcm16(kSampleRate, 2, kSampleCount, pcm);
+			auto decoder = std::make_unique<WaveDecoder>();
+			if (!decoder->Open(wave.data(), wave.size())) {
+				return false;
+			}
+			auto nullOutput = std::make_unique<NullStreamOutput>();
+			output = nullOutput.get();
+			output->SetCapture(capture);
+			return stream.Open(std::move(decoder), std::move(nullOutput), settings);
+		}
+	};
+
+	AudioStream::Settings MakeSettings()
+	{
+		AudioStream::Settings settings;
+		settings.bufferCount = 4;
+		settings.bufferMilliseconds = 100;
+		return settings;
+	}
+
+	/// <summary>
+	/// WaveDecoder: 中身の切り出し・シーク・壊れたファイル
+	/// </summary>
+	void TestWaveDecoder()
+	{
+		std::vector<uint8_t> pcm;
+		const std::vector<uint8_t> wave = WaveBuilder::MakePcm16(kSampleRate, 2, kSampleCount, pcm);
+
+		WaveDecoder decoder;
+		CHECK(decoder.Open(wave.data(), wave.size()));
+		CHECK(decoder.GetTotalSamples() == kSampleCount);
+		CHECK(decoder.GetFormat().blockAlign == kBlockAlign);
+
+		std::vector<uint8_t> buffer(4003);
+		CHECK(decoder.Read(buffer.data(), 4000) == 4000);
+		CHECK(std::memcmp(buffer.data(), pcm.data(), 4000) == 0);
+		CHECK(decoder.Seek(kSampleCount - 1));
+		CHECK(decoder.Read(buffer.data(), 4000) == kBlockAlign);
+		CHECK(decoder.Read(buffer.data(), 4000) == 0);
+		CHECK(!decoder.Seek(kSampleCount + 1));
+
+		std::vector<uint8_t> broken = wave;
+		std::memcpy(&broken[8], "WAVX", 4);
+		CHECK(!decoder.Open(broken.data(), broken.size()));
+
+		// 途中で切れたものは揃ったサンプルだけ読む
+		broken = wave;
+		broken.resize(broken.size() - 6);
+		CHECK(decoder.Open(broken.data(), broken.size()));
+		CHECK(decoder.GetTotalSamples() == kSampleCount - 2);
+
+		CHECK(!decoder.Open(wave.data(), 40));
+
+		// LIST (12 + 8 + 5 + 詰め物) の後ろの fmt を壊す
+		broken = wave;
+		std::memcpy(&broken[12 + 14], "fmX ", 4);
+		CHECK(!decoder.Open(broken.data(), broken.size()));
+	}
+
+	/// <summary>
+	/// 最初のバッファで鳴り始め、先読みはリングの分だけで、最後まで同じPCMが出る
+	/// </summary>
+	void TestPlayToEnd()
+	{
+		Fixture fixture;
+		CHECK(fixture.Open(MakeSettings(), true));
+		AudioStream& stream = fixture.stream;
+		NullStreamOutput* output = fixture.output;
+		if (!output) {
+			return;
+		}
+
+		CHECK(stream.GetDuration() == 2.0);
+		stream.Play();
+		CHECK(stream.IsPlaying());
+		CHECK(WaitFor([&] { return output->IsStarted(); }));
+		CHECK(WaitFor([&] { return stream.GetStats().submittedBuffers == 4; }));
+		std::this_thread::sleep_for(20ms);
+		// 100ms × 4 = 800 サンプル × 4 バッファ
+		CHECK(stream.GetStats().decodedBytes == 4 * 800 * kBlockAlign);
+
+		Run(output, 2.3);
+		CHECK(WaitFor([&] { return !stream.IsPlaying(); }));
+		CHECK(output->TakeCaptured() == fixture.pcm);
+		CHECK(stream.GetStats().underruns == 0);
+		CHECK(stream.GetPosition() == 2.0);
+
+		// 最後まで鳴った後の Play は先頭から
+		stream.Play();
+		Run(output, 0.5);
+		stream.Stop();
+		CHECK(WaitFor([&] { return output->GetQueuedCount() == 0; }));
+		CHECK(MatchesAt(output->TakeCaptured(), fixture.pcm, 0));
+	}
+
+	/// <summary>
+	/// ループ: 継ぎ目無く先頭へ戻り、ループを切れば最後まで鳴って止まる
+	/// </summary>
+	void TestLoop()
+	{
+		Fixture fixture;
+		CHECK(fixture.Open(MakeSettings(), true));
+		AudioStream& stream = fixture.stream;
+		NullStreamOutput* output = fixture.output;
+		if (!output) {
+			return;
+		}
+
+		stream.Play(true);
+		CHECK(WaitFor([&] { return output->IsStarted(); }));
+		Run(output, 5.0);
+		CHECK(stream.IsPlaying());
+
+		const std::vector<uint8_t> captured = output->TakeCaptured();
+		CHECK(captured.size() > fixture.pcm.size() * 2);
+		size_t mismatch = captured.size();
+		for (size_t i = 0; i < captured.size() && mismatch == captured.size(); ++i) {
+			if (captured[i] != fixture.pcm[i % fixture.pcm.size()]) {
+				mismatch = i;
+			}
+		}
+		CHECK(mismatch == captured.size());
+		CHECK(stream.GetStats().loops >= 2);
+		CHECK(stream.GetStats().underruns == 0);
+
+		stream.SetLoop(false);
+		Run(output, 3.0);
+		CHECK(WaitFor([&] { return !stream.IsPlaying(); }));
+	}
+
+	/// <summary>
+	/// シークと一時停止: 移動先から鳴り直し、一時停止中は進まず、続きから鳴る
+	/// </summary>
+	void TestSeekAndPause()
+	{
+		Fixture fixture;
+		CHECK(fixture.Open(MakeSettings(), true));
+		AudioStream& stream = fixture.stream;
+		NullStreamOutput* output = fixture.output;
+		if (!output) {
+			return;
+		}
+
+		stream.Play();
+		CHECK(WaitFor([&] { return output->IsStarted(); }));
+		Run(output, 0.3);
+
+		stream.Seek(1.5);
+		CHECK(WaitFor([&] { return stream.GetStats().seeks == 1 && output->GetQueuedCount() == 4; }));
+		output->TakeCaptured();
+		CHECK(stream.GetPosition() == 1.5);
+		Run(output, 0.2);
+		std::vector<uint8_t> captured = output->TakeCaptured();
+		const size_t seekOffset = 12000 * kBlockAlign;
+		CHECK(MatchesAt(captured, fixture.pcm, seekOffset));
+		const size_t playedAfterSeek = captured.size();
+
+		stream.Pause();
+		CHECK(WaitFor([&] { return !output->IsStarted(); }));
+		Run(output, 0.2);
+		CHECK(output->TakeCaptured().empty());
+
+		stream.Play();
+		CHECK(WaitFor([&] { return output->IsStarted(); }));
+		Run(output, 0.1);
+		CHECK(MatchesAt(output->TakeCaptured(), fixture.pcm, seekOffset + playedAfterSeek));
+
+		// 一時停止中のシークは鳴らさずに位置だけ変える
+		stream.Pause();
+		stream.Seek(0.25);
+		CHECK(WaitFor([&] { return stream.GetStats().seeks == 2; }));
+		CHECK(!output->IsStarted());
+		output->TakeCaptured();
+		stream.Play();
+		CHECK(WaitFor([&] { return output->IsStarted(); }));
+		Run(output, 0.1);
+		CHECK(MatchesAt(output->TakeCaptured(), fixture.pcm, 2000 * kBlockAlign));
+
+		stream.SetVolume(0.25f);
+		CHECK(output->GetVolume() == 0.25f);
+	}
+
+	/// <summary>
+	/// 操作を乱暴に繰り返しても、止めれば必ず落ち着く
+	/// </summary>
+	void TestRandomOperations()
+	{
+		std::mt19937 random(7);
+		for (int round = 0; round < 20; ++round) {
+			Fixture fixture;
+			CHECK(fixture.Open(MakeSettings(), false));
+			AudioStream& stream = fixture.stream;
+			NullStreamOutput* output = fixture.output;
+			if (!output) {
+				return;
+			}
+
+			for (int i = 0; i < 200; ++i) {
+				switch (random() % 6) {
+				case 0: stream.Play(random() % 2 != 0); break;
+				case 1: stream.Pause(); break;
+				case 2: stream.Stop(); break;
+				case 3: stream.Seek((random() % 300) / 100.0); break;
+				default: output->Advance((random() % 50) / 1000.0); break;
+				}
+				if (random() % 4 == 0) {
+					std::this_thread::sleep_for(std::chrono::microseconds(random() % 500));
+				}
+			}
+			stream.Stop();
+			CHECK(WaitFor([&] { return !stream.IsPlaying() && output->GetQueuedCount() == 0; }));
+			if (round % 2) {
+				stream.Close();
+				CHECK(!stream.IsOpen());
+			}
+		}
+	}
+
+	/// <summary>
+	/// デコーダが無ければ開けない
+	/// </summary>
+	void TestOpenFailure()
+	{
+		AudioStream stream;
+		CHECK(!stream.Open(nullptr, std::make_unique<NullStreamOutput>()));
+		CHECK(!stream.IsOpen());
+	}
+
+} // namespace
+
+int main()
+{
+	TestWaveDecoder();
+	TestPlayToEnd();
+	TestLoop();
+	TestSeekAndPause();
+	TestRandomOperations();
+	TestOpenFailure();
+	return Test::Finish("AudioStreamTest");
+}
@@ -0,0 +1,323 @@
+// C++
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Engine
+#include "NullAudioBackend.h"
+#include "VoicePool.h"
+
+// Test
+#include "TestCommon.h"
+
+namespace {
+
+	const AudioFormat kMono = { 1, 1, 44100, 16, 2 };
+	const AudioFormat kStereo = { 1, 2, 48000, 16, 4 };
+	const AudioFormat kFloat = { 3, 2, 48000, 32, 8 };
+
+	// 0.1秒のモノラル波形
+	std::vector<uint8_t> MakeWave()
+	{
+		return std::vector<uint8_t>(44100 * 2 / 10);
+	}
+
+	VoicePool::Handle Play(VoicePool& pool, const std::vector<uint8_t>& wave, const VoicePool::PlayParams& params = {})
+	{
+		return pool.Play(kMono, wave.data(), static_cast<uint32_t>(wave.size()), params);
+	}
+
+	/// <summary>
+	/// 再生し終えたボイスは作り直さずに使い回す
+	/// </summary>
+	void TestReuse()
+	{
+		const std::vector<uint8_t> wave = MakeWave();
+		NullAudioBackend backend;
+		VoicePool pool;
+		pool.Initialize(&backend, 8);
+
+		for (int i = 0; i < 10; ++i) {
+			const VoicePool::Handle handle = Play(pool, wave);
+			CHECK(handle != VoicePool::kInvalidHandle);
+			CHECK(pool.IsPlaying(handle));
+			backend.Advance(0.2);
+			pool.Update();
+			CHECK(!pool.IsPlaying(handle));
+		}
+		CHECK(pool.GetStats().created == 1);
+		CHECK(pool.GetStats().reused == 9);
+		CHECK(backend.GetCreateCount() == 1);
+		pool.Finalize();
+		CHECK(backend.GetVoiceCount() == 0);
+	}
+
+	/// <summary>
+	/// カテゴリの上限を超えたら古い音から奪う
+	/// </summary>
+	void TestCategoryLimit()
+	{
+		const std::vector<uint8_t> wave = MakeWave();
+		NullAudioBackend backend;
+		VoicePool pool;
+		pool.Initialize(&backend, 8);
+		pool.SetCategoryLimit(0, 4);
+
+		std::vector<VoicePool::Handle> handles;
+		for (int i = 0; i < 6; ++i) {
+			handles.push_back(Play(pool, wave));
+		}
+		CHECK(pool.GetActiveCount(0) == 4);
+		CHECK(pool.GetStats().stolen == 2);
+		CHECK(!pool.IsPlaying(handles[0]));
+		CHECK(!pool.IsPlaying(handles[1]));
+		CHECK(pool.IsPlaying(handles[2]));
+		CHECK(pool.IsPlaying(handles[5]));
+		CHECK(backend.GetPlayingCount() == 4);
+		CHECK(pool.GetVoiceCount() == 4);
+
+		// 別のカテゴリは上限に数えない
+		VoicePool::PlayParams other;
+		other.category = 1;
+		CHECK(Play(pool, wave, other) != VoicePool::kInvalidHandle);
+		CHECK(pool.GetActiveCount(0) == 4);
+		CHECK(pool.GetActiveCount(1) == 1);
+
+		pool.StopCategory(0);
+		CHECK(pool.GetActiveCount(0) == 0);
+		CHECK(pool.GetActiveCount() == 1);
+		pool.Finalize();
+	}
+
+	/// <summary>
+	/// 優先度: 奪えるのは自分以下の優先度の音だけで、低いものから奪う
+	/// </summary>
+	void TestPriority()
+	{
+		const std::vector<uint8_t> wave = MakeWave();
+		NullAudioBackend backend;
+		VoicePool pool;
+		pool.Initialize(&backend, 8);
+		pool.SetCategoryLimit(0, 4);
+
+		VoicePool::PlayParams high;
+		high.priority = 10;
+		for (int i = 0; i < 4; ++i) {
+			CHECK(Play(pool, wave, high) != VoicePool::kInvalidHandle);
+		}
+		const uint64_t rejected = pool.GetStats().rejected;
+		CHECK(Play(pool, wave) == VoicePool::kInvalidHandle);
+		CHECK(pool.GetStats().rejected == rejected + 1);
+
+		pool.StopAll();
+		CHECK(pool.GetActiveCount() == 0);
+		CHECK(backend.GetPlayingCount() == 0);
+
+		VoicePool::PlayParams low;
+		low.priority = -5;
+		const VoicePool::Handle a = Play(pool, wave, high);
+		const VoicePool::Handle b = Play(pool, wave, low);
+		const VoicePool::Handle c = Play(pool, wave, high);
+		const VoicePool::Handle d = Play(pool, wave, high);
+		const VoicePool::Handle e = Play(pool, wave);
+		CHECK(e != VoicePool::kInvalidHandle);
+		CHECK(!pool.IsPlaying(b));
+		CHECK(pool.IsPlaying(a) && pool.IsPlaying(c) && pool.IsPlaying(d));
+		pool.Finalize();
+	}
+
+	/// <summary>
+	/// 古いハンドルや、止めた後に届いた再生終了の通知は、同じボイスの次の再生に影響しない
+	/// </summary>
+	void TestStaleHandles()
+	{
+		const std::vector<uint8_t> wave = MakeWave();
+		NullAudioBackend backend;
+		VoicePool pool;
+		pool.Initialize(&backend, 8);
+
+		const VoicePool::Handle old = Play(pool, wave);
+		backend.Advance(1.0);
+		pool.Update();
+		const VoicePool::Handle current = Play(pool, wave);
+		CHECK(pool.GetVoiceId(old) == IAudioBackend::kInvalidVoice);
+		pool.SetVolume(old, 0.1f);
+		pool.Stop(old);
+		CHECK(pool.IsPlaying(current));
+		CHECK(backend.GetVolume(pool.GetVoiceId(current)) == 1.0f);
+		pool.StopAll();
+
+		// 再生し終えた通知が溜まったまま止めて、同じボイスで鳴らし直す
+		const VoicePool::Handle first = Play(pool, wave);
+		backend.Advance(1.0);
+		pool.Stop(first);
+		const VoicePool::Handle second = Play(pool, wave);
+		pool.Update();
+		CHECK(pool.IsPlaying(second));
+		pool.Finalize();
+	}
+
+	/// <summary>
+	/// ループは止めるまで鳴り続ける
+	/// </summary>
+	void TestLoop()
+	{
+		const std::vector<uint8_t> wave = MakeWave();
+		NullAudioBackend backend;
+		VoicePool pool;
+		pool.Initialize(&backend, 8);
+
+		VoicePool::PlayParams loop;
+		loop.loop = true;
+		loop.category = 1;
+		const VoicePool::Handle handle = pool.Play(kStereo, wave.data(), static_cast<uint32_t>(wave.size()), loop);
+		backend.Advance(100.0);
+		pool.Update();
+		CHECK(pool.IsPlaying(handle));
+		pool.Stop(handle);
+		CHECK(!pool.IsPlaying(handle));
+		CHECK(backend.GetPlayingCount() == 0);
+		pool.Finalize();
+	}
+
+	/// <summary>
+	/// 全体の上限: 形式の違う空きボイスは作り直し、空きが無ければ奪って作り直す
+	/// </summary>
+	void TestFormatRecreate()
+	{
+		const std::vector<uint8_t> wave = MakeWave();
+		NullAudioBackend backend;
+		VoicePool pool;
+		pool.Initialize(&backend, 8);
+
+		for (int i = 0; i < 8; ++i) {
+			Play(pool, wave);
+		}
+		pool.StopAll();
+		CHECK(pool.GetVoiceCount() == 8);
+
+		for (int i = 0; i < 8; ++i) {
+			CHECK(pool.Play(kFloat, wave.data(), static_cast<uint32_t>(wave.size())) != VoicePool::kInvalidHandle);
+		}
+		CHECK(pool.GetVoiceCount() == 8);
+		CHECK(backend.GetVoiceCount() == 8);
+		CHECK(pool.GetStats().destroyed == 8);
+
+		const VoicePool::Handle stolen = pool.Play(kStereo, wave.data(), static_cast<uint32_t>(wave.size()));
+		CHECK(stolen != VoicePool::kInvalidHandle);
+		CHECK(pool.GetVoiceCount() == 8);
+		CHECK(backend.GetVoiceCount() == 8);
+		CHECK(pool.GetActiveCount() == 8);
+		pool.Finalize();
+		CHECK(backend.GetVoiceCount() == 0);
+	}
+
+	/// <summary>
+	/// StopBuffer: 手放す波形の範囲を読んでいるボイスだけが止まる
+	/// </summary>
+	void TestStopBuffer()
+	{
+		std::vector<uint8_t> wave(8000);
+		NullAudioBackend backend;
+		VoicePool pool;
+		pool.Initialize(&backend, 8);
+
+		VoicePool::PlayParams loop;
+		loop.loop = true;
+		// 同じ波形を丸ごと・途中から・後ろ半分だけ読むものと、別の波形
+		const std::vector<uint8_t> other(8000);
+		const VoicePool::Handle whole = pool.Play(kMono, wave.data(), 8000, loop);
+		const VoicePool::Handle middle = pool.Play(kMono, wave.data() + 2000, 2000, loop);
+		const VoicePool::Handle tail = pool.Play(kMono, wave.data() + 6000, 2000, loop);
+		const VoicePool::Handle unrelated = pool.Play(kMono, other.data(), 8000, loop);
+
+		// 前半だけ手放す
+		pool.StopBuffer(wave.data(), 4000);
+		CHECK(!pool.IsPlaying(whole));
+		CHECK(!pool.IsPlaying(middle));
+		CHECK(pool.IsPlaying(tail));
+		CHECK(pool.IsPlaying(unrelated));
+		CHECK(backend.GetPlayingCount() == 2);
+
+		// 境目だけ接する範囲は重ならない
+		pool.StopBuffer(wave.data() + 8000, 100);
+		CHECK(pool.IsPlaying(tail));
+
+		pool.StopBuffer(wave.data(), static_cast<uint32_t>(wave.size()));
+		CHECK(!pool.IsPlaying(tail));
+		CHECK(pool.IsPlaying(unrelated));
+		CHECK(pool.GetActiveCount() == 1);
+
+		// 止めたボイスはそのまま使い回せる
+		CHECK(pool.Play(kMono, other.data(), 8000) != VoicePool::kInvalidHandle);
+		CHECK(pool.GetVoiceCount() == 4);
+		pool.Finalize();
+	}
+
+	/// <summary>
+	/// ランダムな操作の間、プールと再生先の数が食い違わず、上限を守る
+	/// </summary>
+	void TestRandomOperations()
+	{
+		const std::vector<uint8_t> wave(8000);
+		NullAudioBackend backend;
+		VoicePool pool;
+		pool.Initialize(&backend, 8);
+		pool.SetCategoryLimit(0, 5);
+		pool.SetCategoryLimit(2, 3);
+
+		std::mt19937 random(1);
+		const AudioFormat formats[] = { kMono, kStereo, kFloat };
+		std::vector<VoicePool::Handle> live;
+		bool consistent = true;
+		for (int i = 0; i < 200000 && consistent; ++i) {
+			const uint32_t operation = random() % 10;
+			if (operation < 6) {
+				VoicePool::PlayParams params;
+				params.category = random() % 4;
+				params.priority = static_cast<int32_t>(random() % 5) - 2;
+				params.loop = random() % 20 == 0;
+				const uint32_t size = (1 + random() % 20) * 400;
+				const VoicePool::Handle handle = pool.Play(formats[random() % 3], wave.data(), size, params);
+				if (handle != VoicePool::kInvalidHandle) {
+					live.push_back(handle);
+				}
+			} else if (operation < 7 && !live.empty()) {
+				pool.Stop(live[random() % live.size()]);
+			} else {
+				backend.Advance((random() % 100) / 1000.0);
+				pool.Update();
+			}
+			consistent = pool.GetVoiceCount() <= 8 && backend.GetVoiceCount() == pool.GetVoiceCount() &&
+				backend.GetPlayingCount() == pool.GetActiveCount() &&
+				pool.GetActiveCount(0) <= 5 && pool.GetActiveCount(2) <= 3;
+			if (live.size() > 1000) {
+				live.erase(live.begin(), live.begin() + 500);
+			}
+		}
+		CHECK(consistent);
+
+		const VoicePool::Stats& stats = pool.GetStats();
+		std::printf("created %llu reused %llu stolen %llu rejected %llu destroyed %llu\n",
+			static_cast<unsigned long long>(stats.created), static_cast<unsigned long long>(stats.reused),
+			static_cast<unsigned long long>(stats.stolen), static_cast<unsigned long long>(stats.rejected),
+			static_cast<unsigned long long>(stats.destroyed));
+		pool.Finalize();
+		CHECK(backend.GetVoiceCount() == 0);
+	}
+
+} // namespace
+
+int main()
+{
+	TestReuse();
+	TestCategoryLimit();
+	TestPriority();
+	TestStaleHandles();
+	TestLoop();
+	TestFormatRecreate();
+	TestStopBuffer();
+	TestRandomOperations();
+	return Test::Finish("VoicePoolTest");
+}
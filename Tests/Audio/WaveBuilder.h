@@ -0,0 +1,103 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/// <summary>
+/// テスト用のWAVをメモリ上に組み立てる (チャンクの並びやサイズをわざと壊すこともできる)
+/// </summary>
+namespace WaveBuilder {
+
+	inline void Put16(std::vector<uint8_t>& out, uint16_t value)
+	{
+		out.push_back(static_cast<uint8_t>(value));
+		out.push_back(static_cast<uint8_t>(value >> 8));
+	}
+
+	inline void Put32(std::vector<uint8_t>& out, uint32_t value)
+	{
+		for (int i = 0; i < 4; ++i) {
+			out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+		}
+	}
+
+	/// <summary>
+	/// チャンクを1つ足す (奇数長なら詰め物を足す)
+	/// </summary>
+	/// <param name="sizeOverride">負でなければヘッダーに書くサイズ (壊れたファイル用)</param>
+	inline void AppendChunk(std::vector<uint8_t>& out, const char* id, const std::vector<uint8_t>& body, int64_t sizeOverride = -1)
+	{
+		out.insert(out.end(), id, id + 4);
+		Put32(out, sizeOverride >= 0 ? static_cast<uint32_t>(sizeOverride) : static_cast<uint32_t>(body.size()));
+		out.insert(out.end(), body.begin(), body.end());
+		if (body.size() & 1) {
+			out.push_back(0);
+		}
+	}
+
+	/// <summary>
+	/// fmt チャンクの中身
+	/// </summary>
+	/// <param name="extraSize">負でなければ cbSize を足す</param>
+	inline std::vector<uint8_t> MakeFormat(uint16_t formatTag, uint16_t channels, uint32_t sampleRate, uint16_t bitsPerSample, int32_t extraSize = -1)
+	{
+		std::vector<uint8_t> format;
+		Put16(format, formatTag);
+		Put16(format, channels);
+		Put32(format, sampleRate);
+		Put32(format, sampleRate * channels * bitsPerSample / 8);
+		Put16(format, static_cast<uint16_t>(channels * bitsPerSample / 8));
+		Put16(format, bitsPerSample);
+		if (extraSize >= 0) {
+			Put16(format, static_cast<uint16_t>(extraSize));
+		}
+		return format;
+	}
+
+	/// <summary>
+	/// チャンクの並びを RIFF/WAVE で包む
+	/// </summary>
+	inline std::vector<uint8_t> MakeRiff(const std::vector<uint8_t>& chunks)
+	{
+		std::vector<uint8_t> wave = { 'R', 'I', 'F', 'F' };
+		Put32(wave, static_cast<uint32_t>(chunks.size()) + 4);
+		wave.insert(wave.end(), { 'W', 'A', 'V', 'E' });
+		wave.insert(wave.end(), chunks.begin(), chunks.end());
+		return wave;
+	}
+
+	/// <summary>
+	/// 中身を見分けられるバイト列 (波形の中身の代わり)
+	/// </summary>
+	inline std::vector<uint8_t> MakeBytes(size_t size)
+	{
+		std::vector<uint8_t> bytes(size);
+		for (size_t i = 0; i < size; ++i) {
+			bytes[i] = static_cast<uint8_t>(i * 7);
+		}
+		return bytes;
+	}
+
+	/// <summary>
+	/// 16bit PCM のWAV (前に LIST と JUNK、後ろに何も無い一般的な並び)
+	/// </summary>
+	/// <param name="outPcm">data チャンクの中身</param>
+	inline std::vector<uint8_t> MakePcm16(uint32_t sampleRate, uint16_t channels, uint32_t sampleCount, std::vector<uint8_t>& outPcm)
+	{
+		outPcm.clear();
+		for (uint32_t i = 0; i < sampleCount; ++i) {
+			for (uint16_t channel = 0; channel < channels; ++channel) {
+				Put16(outPcm, static_cast<uint16_t>(i * 3 + channel * 7));
+			}
+		}
+		std::vector<uint8_t> chunks;
+		AppendChunk(chunks, "LIST", MakeBytes(5));
+		AppendChunk(chunks, "fmt ", MakeFormat(1, channels, sampleRate, 16));
+		AppendChunk(chunks, "JUNK", MakeBytes(4));
+		AppendChunk(chunks, "data", outPcm);
+		return MakeRiff(chunks);
+	}
+
+} // namespace WaveBuilder
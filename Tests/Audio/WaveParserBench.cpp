@@ -0,0 +1,152 @@
+// C++
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Engine
+#include "Loaders/Archive/FileSystem.h"
+#include "WaveParser.h"
+
+// Test
+#include "WaveBuilder.h"
+
+using namespace WaveBuilder;
+
+namespace {
+
+	constexpr int kFileCount = 300;
+
+	std::string GetPath(int index)
+	{
+		return "Resources/Sounds/se" + std::to_string(index) + ".wav";
+	}
+
+	// 以前の Audio::LoadWave と同じ手順の結果
+	struct OldSound {
+		uint8_t format[18];
+		char* buffer;
+		uint32_t size;
+	};
+
+	/// <summary>
+	/// 以前の読み込み (中身を istream に写してチャンクを読み、JUNK は1つだけ飛ばして new[] へコピーする)
+	/// </summary>
+	OldSound LoadOld(const std::string& path)
+	{
+		const FileSystem::FileView view = FileSystem::GetInstance()->Open(path);
+		std::istringstream file(std::string(view.GetText()), std::ios_base::binary);
+		struct ChunkHeader {
+			char id[4];
+			int32_t size;
+		} chunk;
+		char riff[12];
+		file.read(riff, sizeof(riff));
+
+		OldSound sound = {};
+		while (file.read(reinterpret_cast<char*>(&chunk), sizeof(chunk))) {
+			if (std::strncmp(chunk.id, "fmt ", 4) == 0) {
+				file.read(reinterpret_cast<char*>(sound.format), chunk.size);
+				break;
+			}
+			file.seekg(chunk.size, std::ios_base::cur);
+		}
+		file.read(reinterpret_cast<char*>(&chunk), sizeof(chunk));
+		if (std::strncmp(chunk.id, "JUNK", 4) == 0) {
+			file.seekg(chunk.size, std::ios_base::cur);
+			file.read(reinterpret_cast<char*>(&chunk), sizeof(chunk));
+		}
+		sound.buffer = new char[chunk.size];
+		file.read(sound.buffer, chunk.size);
+		sound.size = chunk.size;
+		return sound;
+	}
+
+	/// <summary>
+	/// 5回測って一番速いもの
+	/// </summary>
+	template <typename Load>
+	void Measure(const char* name, Load load)
+	{
+		double best = 1e30;
+		for (int i = 0; i < 5; ++i) {
+			const auto start = std::chrono::steady_clock::now();
+			load();
+			best = (std::min)(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+		}
+		std::printf("%-34s %8.2f ms for %d files (%.1f us/file)\n", name, best, kFileCount, best * 1000.0 / kFileCount);
+	}
+
+	/// <summary>
+	/// マップしたファイルを解析して、ビューを持ったままにする (効果音として鳴らす間と同じ)
+	/// </summary>
+	bool LoadMapped(bool expectArchive)
+	{
+		std::vector<FileSystem::FileView> files;
+		for (int i = 0; i < kFileCount; ++i) {
+			FileSystem::FileView file = FileSystem::GetInstance()->Open(GetPath(i));
+			WaveParser::WaveView view;
+			if (file.IsFromArchive() != expectArchive || WaveParser::Parse(file.GetData(), file.GetSize(), view) != WaveParser::Error::kNone) {
+				return false;
+			}
+			files.push_back(std::move(file));
+		}
+		return true;
+	}
+
+} // namespace
+
+/// <summary>
+/// 300個の効果音 (0.5秒 48kHz ステレオ 16bit、JUNK 入り) を、以前の読み込み・単体ファイルのマップ・アーカイブから読む時間で比べる
+/// </summary>
+int main()
+{
+	const std::filesystem::path previous = std::filesystem::current_path();
+	const std::filesystem::path work = std::filesystem::temp_directory_path() / "WaveParserBench";
+	std::filesystem::remove_all(work);
+	std::filesystem::create_directories(work / "Resources" / "Sounds");
+	std::filesystem::current_path(work);
+
+	std::vector<uint8_t> chunks;
+	AppendChunk(chunks, "fmt ", MakeFormat(1, 2, 48000, 16));
+	AppendChunk(chunks, "JUNK", MakeBytes(4));
+	AppendChunk(chunks, "data", MakeBytes(96000));
+	const std::vector<uint8_t> wave = MakeRiff(chunks);
+	for (int i = 0; i < kFileCount; ++i) {
+		std::ofstream(GetPath(i), std::ios::binary).write(reinterpret_cast<const char*>(wave.data()), wave.size());
+	}
+
+	bool ok = true;
+	Measure("old: copy + istream + new[]", [] {
+		std::vector<OldSound> sounds;
+		for (int i = 0; i < kFileCount; ++i) {
+			sounds.push_back(LoadOld(GetPath(i)));
+		}
+		for (OldSound& sound : sounds) {
+			delete[] sound.buffer;
+		}
+		});
+	Measure("new: mmap loose + parse", [&] { ok = LoadMapped(false) && ok; });
+
+	FileSystem* fileSystem = FileSystem::GetInstance();
+	ok = FileSystem::PackResources() && ok;
+	fileSystem->SetLooseFileOverride(false);
+	fileSystem->Initialize();
+	ok = fileSystem->IsMounted() && ok;
+	Measure("new: archive view + parse", [&] { ok = LoadMapped(true) && ok; });
+	fileSystem->Finalize();
+
+	std::filesystem::current_path(previous);
+	std::filesystem::remove_all(work);
+	if (!ok) {
+		std::printf("WaveParserBench: failed to load\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,294 @@
+// C++
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+// Engine
+#include "Loaders/Archive/FileSystem.h"
+#include "WaveDecoder.h"
+#include "WaveParser.h"
+
+// Test
+#include "TestCommon.h"
+#include "WaveBuilder.h"
+
+using namespace WaveBuilder;
+using Error = WaveParser::Error;
+
+namespace {
+
+	std::vector<uint8_t> MakeStereo16(const std::vector<uint8_t>& pcm)
+	{
+		std::vector<uint8_t> chunks;
+		AppendChunk(chunks, "fmt ", MakeFormat(1, 2, 44100, 16));
+		AppendChunk(chunks, "data", pcm);
+		return MakeRiff(chunks);
+	}
+
+	Error Parse(const std::vector<uint8_t>& wave, WaveParser::WaveView& view)
+	{
+		return WaveParser::Parse(wave.data(), wave.size(), view);
+	}
+
+	/// <summary>
+	/// 知らないチャンク (奇数長の LIST、JUNK、fact、bext) を挟んでも data をコピーせずに指す
+	/// </summary>
+	void TestSkipsUnknownChunks()
+	{
+		const std::vector<uint8_t> pcm = MakeBytes(4000);
+		std::vector<uint8_t> chunks;
+		AppendChunk(chunks, "LIST", MakeBytes(7));
+		AppendChunk(chunks, "JUNK", MakeBytes(28));
+		AppendChunk(chunks, "fmt ", MakeFormat(1, 2, 44100, 16));
+		AppendChunk(chunks, "fact", MakeBytes(4));
+		AppendChunk(chunks, "bext", MakeBytes(3));
+		AppendChunk(chunks, "data", pcm);
+		AppendChunk(chunks, "LIST", MakeBytes(5));
+		std::vector<uint8_t> wave = MakeRiff(chunks);
+
+		WaveParser::WaveView view;
+		CHECK(Parse(wave, view) == Error::kNone);
+		CHECK(view.format.channels == 2);
+		CHECK(view.format.sampleRate == 44100);
+		CHECK(view.format.blockAlign == 4);
+		CHECK(view.size == 4000);
+		CHECK(view.sampleCount == 1000);
+		CHECK(!view.truncated);
+		CHECK(view.data >= wave.data() && view.data + view.size <= wave.data() + wave.size());
+		CHECK(std::memcmp(view.data, pcm.data(), pcm.size()) == 0);
+
+		// RIFF のサイズが嘘でも、実際のファイルの長さで読む
+		wave[4] = wave[5] = wave[6] = wave[7] = 0xFF;
+		CHECK(Parse(wave, view) == Error::kNone);
+		CHECK(view.size == 4000);
+	}
+
+	/// <summary>
+	/// data が fmt より前にあってもよい
+	/// </summary>
+	void TestDataBeforeFormat()
+	{
+		std::vector<uint8_t> chunks;
+		AppendChunk(chunks, "data", MakeBytes(4000));
+		AppendChunk(chunks, "fmt ", MakeFormat(3, 1, 48000, 32, 0));
+		const std::vector<uint8_t> wave = MakeRiff(chunks);
+
+		WaveParser::WaveView view;
+		CHECK(Parse(wave, view) == Error::kNone);
+		CHECK(view.format.formatTag == 3);
+		CHECK(view.sampleCount == 1000);
+	}
+
+	/// <summary>
+	/// WAVE_FORMAT_EXTENSIBLE: PCM の GUID なら PCM として読み、知らない GUID は断る
+	/// </summary>
+	void TestExtensible()
+	{
+		for (bool known : { true, false }) {
+			std::vector<uint8_t> format = MakeFormat(0xFFFE, 2, 48000, 24, 22);
+			Put16(format, 24);
+			Put32(format, 3);
+			// KSDATAFORMAT_SUBTYPE_PCM
+			Put16(format, 1);
+			const uint8_t guidTail[14] = { 0, 0, 0, 0, 0x10, 0, 0x80, 0, 0, 0xAA, 0, 0x38, 0x9B, 0x71 };
+			format.insert(format.end(), guidTail, guidTail + 14);
+			if (!known) {
+				format.back() ^= 1;
+			}
+			std::vector<uint8_t> chunks;
+			AppendChunk(chunks, "fmt ", format);
+			AppendChunk(chunks, "data", MakeBytes(600));
+			const std::vector<uint8_t> wave = MakeRiff(chunks);
+
+			WaveParser::WaveView view;
+			const Error error = Parse(wave, view);
+			if (known) {
+				CHECK(error == Error::kNone);
+				CHECK(view.format.formatTag == 1);
+				CHECK(view.format.bitsPerSample == 24);
+				CHECK(view.sampleCount == 100);
+			} else {
+				CHECK(error == Error::kUnsupportedFormat);
+			}
+		}
+	}
+
+	/// <summary>
+	/// 途中で切れた data、サンプルの途中で終わる data はある分だけ使う
+	/// </summary>
+	void TestTruncatedData()
+	{
+		std::vector<uint8_t> wave = MakeStereo16(MakeBytes(4000));
+		wave.resize(wave.size() - 10);
+		WaveParser::WaveView view;
+		CHECK(Parse(wave, view) == Error::kNone);
+		CHECK(view.truncated);
+		CHECK(view.size == 3988);
+		CHECK(view.sampleCount == 997);
+
+		const std::vector<uint8_t> odd = MakeStereo16(MakeBytes(4003));
+		CHECK(Parse(odd, view) == Error::kNone);
+		CHECK(view.size == 4000);
+		CHECK(view.truncated);
+	}
+
+	/// <summary>
+	/// 壊れたファイルはそれぞれの理由で断る
+	/// </summary>
+	void TestMalformed()
+	{
+		WaveParser::WaveView view;
+		CHECK(WaveParser::Parse(nullptr, 0, view) == Error::kTooSmall);
+		const std::vector<uint8_t> tiny(11, 0);
+		CHECK(Parse(tiny, view) == Error::kTooSmall);
+
+		const std::vector<uint8_t> pcm = MakeBytes(4000);
+		const std::vector<uint8_t> wave = MakeStereo16(pcm);
+		std::vector<uint8_t> broken = wave;
+		broken[0] = 'X';
+		CHECK(Parse(broken, view) == Error::kNotRiff);
+		broken = wave;
+		broken[8] = 'X';
+		CHECK(Parse(broken, view) == Error::kNotWave);
+		broken = wave;
+		broken.resize(12);
+		CHECK(Parse(broken, view) == Error::kMissingFormat);
+
+		// チャンクのサイズがファイルの外を指す (足すと桁あふれする値も)
+		std::vector<uint8_t> chunks;
+		AppendChunk(chunks, "JUNK", MakeBytes(10), 0x7FFFFFF0);
+		CHECK(Parse(MakeRiff(chunks), view) == Error::kBadChunk);
+		chunks.clear();
+		AppendChunk(chunks, "LIST", MakeBytes(3), 0xFFFFFFFF);
+		CHECK(Parse(MakeRiff(chunks), view) == Error::kBadChunk);
+
+		// fmt が短い
+		chunks.clear();
+		AppendChunk(chunks, "fmt ", MakeBytes(14));
+		AppendChunk(chunks, "data", pcm);
+		CHECK(Parse(MakeRiff(chunks), view) == Error::kBadFormatChunk);
+
+		chunks.clear();
+		AppendChunk(chunks, "fmt ", MakeFormat(1, 2, 44100, 16));
+		CHECK(Parse(MakeRiff(chunks), view) == Error::kMissingData);
+
+		// チャンネル数0、blockAlign の食い違い、サンプリングレート0
+		chunks.clear();
+		AppendChunk(chunks, "fmt ", MakeFormat(1, 0, 44100, 16));
+		AppendChunk(chunks, "data", pcm);
+		CHECK(Parse(MakeRiff(chunks), view) == Error::kBadFormatChunk);
+		std::vector<uint8_t> format = MakeFormat(1, 2, 44100, 16);
+		format[12] = 3;
+		chunks.clear();
+		AppendChunk(chunks, "fmt ", format);
+		AppendChunk(chunks, "data", pcm);
+		CHECK(Parse(MakeRiff(chunks), view) == Error::kBadFormatChunk);
+		chunks.clear();
+		AppendChunk(chunks, "fmt ", MakeFormat(1, 1, 0, 16));
+		AppendChunk(chunks, "data", pcm);
+		CHECK(Parse(MakeRiff(chunks), view) == Error::kBadFormatChunk);
+
+		// ADPCM は扱わない
+		chunks.clear();
+		AppendChunk(chunks, "fmt ", MakeFormat(2, 1, 44100, 16));
+		AppendChunk(chunks, "data", pcm);
+		CHECK(Parse(MakeRiff(chunks), view) == Error::kUnsupportedFormat);
+
+		CHECK(std::strlen(WaveParser::ToString(Error::kBadChunk)) > 0);
+	}
+
+	/// <summary>
+	/// ランダムに壊したファイルでも、読めたなら必ずファイルの中を指す
+	/// (ちょうどの大きさで確保し直すので、サニタイザー付きで組めば越えた読み込みも見つかる)
+	/// </summary>
+	void TestRandomCorruption()
+	{
+		std::vector<uint8_t> chunks;
+		AppendChunk(chunks, "LIST", MakeBytes(9));
+		AppendChunk(chunks, "fmt ", MakeFormat(1, 2, 44100, 16));
+		AppendChunk(chunks, "fact", MakeBytes(4));
+		AppendChunk(chunks, "data", MakeBytes(64));
+		const std::vector<uint8_t> base = MakeRiff(chunks);
+
+		std::mt19937 random(3);
+		uint32_t parsed = 0;
+		uint32_t checksum = 0;
+		bool inside = true;
+		for (int i = 0; i < 300000; ++i) {
+			std::vector<uint8_t> wave = base;
+			const uint32_t mutations = 1 + random() % 6;
+			for (uint32_t k = 0; k < mutations; ++k) {
+				wave[random() % wave.size()] = static_cast<uint8_t>(random());
+			}
+			if (random() % 3 == 0) {
+				wave.resize(random() % wave.size());
+			}
+			const std::vector<uint8_t> exact(wave.begin(), wave.end());
+			WaveParser::WaveView view;
+			if (WaveParser::Parse(exact.data(), exact.size(), view) != Error::kNone) {
+				continue;
+			}
+			++parsed;
+			inside = inside && view.data >= exact.data() && view.data + view.size <= exact.data() + exact.size() &&
+				view.size == view.sampleCount * view.format.blockAlign;
+			for (uint32_t j = 0; j < view.size; ++j) {
+				checksum += view.data[j];
+			}
+		}
+		CHECK(inside);
+		CHECK(parsed > 0);
+		std::printf("random corruption: %u of 300000 still parsed (checksum %u)\n", parsed, checksum);
+	}
+
+	/// <summary>
+	/// ディスク上のファイルを FileSystem でマップし、そのまま解析・デコードする
+	/// </summary>
+	void TestMappedFile()
+	{
+		const std::vector<uint8_t> pcm = MakeBytes(4000);
+		std::vector<uint8_t> chunks;
+		AppendChunk(chunks, "fmt ", MakeFormat(1, 2, 44100, 16));
+		AppendChunk(chunks, "JUNK", MakeBytes(4));
+		AppendChunk(chunks, "data", pcm);
+		const std::vector<uint8_t> wave = MakeRiff(chunks);
+
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / "WaveParserTest.wav";
+		std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(wave.data()), wave.size());
+		{
+			const FileSystem::FileView file = FileSystem::GetInstance()->Open(path.string());
+			CHECK(file.IsValid());
+			WaveParser::WaveView view;
+			CHECK(WaveParser::Parse(file.GetData(), file.GetSize(), view) == Error::kNone);
+			CHECK(view.data >= file.GetData() && view.data + view.size <= file.GetData() + file.GetSize());
+			CHECK(view.size == pcm.size() && std::memcmp(view.data, pcm.data(), pcm.size()) == 0);
+
+			WaveDecoder decoder;
+			CHECK(decoder.Open(path.string()));
+			CHECK(decoder.GetTotalSamples() == 1000);
+			std::vector<uint8_t> decoded(pcm.size());
+			CHECK(decoder.Read(decoded.data(), static_cast<uint32_t>(decoded.size())) == decoded.size());
+			CHECK(decoded == pcm);
+		}
+		std::filesystem::remove(path);
+
+		WaveDecoder missing;
+		CHECK(!missing.Open((std::filesystem::temp_directory_path() / "WaveParserTest_missing.wav").string()));
+	}
+
+} // namespace
+
+int main()
+{
+	TestSkipsUnknownChunks();
+	TestDataBeforeFormat();
+	TestExtensible();
+	TestTruncatedData();
+	TestMalformed();
+	TestRandomCorruption();
+	TestMappedFile();
+	return Test::Finish("WaveParserTest");
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+// C++
+#include <cmath>
+
+/// <summary>
+/// libstdc++ (GCC 13 以前) は std::sinf 等の float 版を std に置いていないので補う
+/// Math/ は MSVC 前提でこれらを使っている。テストのビルドでだけ先頭に読み込む
+/// </summary>
+#if defined(__GLIBCXX__)
+namespace std {
+	using ::cosf;
+	using ::sinf;
+	using ::tanf;
+}
+#endif
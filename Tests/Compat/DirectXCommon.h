@@ -0,0 +1,20 @@
+#pragma once
+
+// C++
+#include <cstdio>
+#include <string>
+
+/// <summary>
+/// テストのビルド用の DirectXCommon (ログだけ)
+/// FileSystem など DirectXCommon::Log でしか D3D12 に触らないものを、デバイス無しで組むために使う
+/// CMake がビルドフォルダの DX./ へ写し、エンジンと同じ "DX./DirectXCommon.h" で読まれる
+/// </summary>
+class DirectXCommon
+{
+public:
+
+	/// <summary>
+	/// ログ (OutputDebugStringA の代わりに標準出力へ)
+	/// </summary>
+	static void Log(const std::string& message) { std::fputs(message.c_str(), stdout); }
+};
@@ -0,0 +1,205 @@
+// C++
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+
+// Engine
+#include "FramePacer.h"
+
+// Test
+#include "TestCommon.h"
+
+namespace {
+
+	using Clock = FramePacer::Clock;
+	using Microseconds = std::chrono::microseconds;
+
+	/// <summary>
+	/// 偽の時計: 読むたびに tick だけ進み、スリープは頼んだ時間 + oversleep だけ進む
+	/// </summary>
+	struct FakeClock {
+		Clock::time_point now{};
+		Microseconds tick{ 1 };
+		Microseconds oversleep{ 0 };
+		uint32_t sleepCount = 0;
+
+		void Connect(FramePacer& pacer) {
+			pacer.SetTimeSource(
+				[this] { Clock::time_point result = now; now += tick; return result; },
+				[this](Clock::duration duration) { now += duration + oversleep; ++sleepCount; });
+		}
+		void Work(Microseconds duration) { now += duration; }
+	};
+
+	constexpr double kFps = 100.0;
+	constexpr Microseconds kPeriod{ 10'000 };
+
+	/// <summary>
+	/// 締め切りは絶対時刻で進み、処理時間が揺れてもずれが積み上がらない
+	/// </summary>
+	void TestDeadline()
+	{
+		FramePacer pacer;
+		FakeClock clock;
+		clock.Connect(pacer);
+		pacer.Initialize(kFps);
+		const Clock::time_point start = clock.now;
+
+		std::mt19937 random(1);
+		std::uniform_int_distribution<int> work(0, 8'000);
+		bool onTime = true;
+		for (int frame = 1; frame <= 200; ++frame) {
+			clock.Work(Microseconds(work(random)));
+			pacer.Wait();
+			// 締め切りちょうどから数 tick 以内に戻る
+			const Clock::time_point deadline = start + kPeriod * frame;
+			onTime = onTime && clock.now >= deadline && clock.now - deadline <= Microseconds(5);
+		}
+		CHECK(onTime);
+		CHECK(pacer.GetStats().frameCount == 200);
+		CHECK(pacer.GetStats().lateFrameCount == 0);
+		CHECK(pacer.GetStats().maxOvershootUs < 5.0f);
+
+		// 目標は1FPS未満にならない
+		pacer.SetTargetFps(0.0);
+		CHECK(pacer.GetTargetFps() == 1.0);
+	}
+
+	/// <summary>
+	/// 締め切りを過ぎたら待たない。1周期以内の遅れは位相を保ち、それ以上なら今から数え直す
+	/// </summary>
+	void TestLateFrames()
+	{
+		FramePacer pacer;
+		FakeClock clock;
+		clock.Connect(pacer);
+		pacer.Initialize(kFps);
+		const Clock::time_point start = clock.now;
+
+		// 少し遅れた: 待たずに返り、次は元の位相の締め切り
+		clock.Work(Microseconds(12'000));
+		const Clock::time_point before = clock.now;
+		pacer.Wait();
+		CHECK(pacer.GetStats().lateFrameCount == 1);
+		CHECK(pacer.GetStats().frameCount == 0);
+		CHECK(clock.now - before <= Microseconds(2));
+		clock.Work(Microseconds(1'000));
+		pacer.Wait();
+		CHECK(clock.now >= start + kPeriod * 2 && clock.now - (start + kPeriod * 2) <= Microseconds(5));
+
+		// 大きく遅れた: 取り返そうとせず、今から1周期後を締め切りにする
+		clock.Work(Microseconds(35'000));
+		const Clock::time_point rebased = clock.now;
+		pacer.Wait();
+		CHECK(pacer.GetStats().lateFrameCount == 2);
+		clock.Work(Microseconds(1'000));
+		pacer.Wait();
+		CHECK(clock.now >= rebased + kPeriod && clock.now - (rebased + kPeriod) <= Microseconds(5));
+	}
+
+	/// <summary>
+	/// 寝過ごすとスリープの余裕が広がり (上限あり)、寝過ごさなくなると少しずつ縮む (下限あり)
+	/// </summary>
+	void TestMarginAdaptation()
+	{
+		FramePacer pacer;
+		FakeClock clock;
+		clock.Connect(pacer);
+		pacer.Initialize(kFps);
+		CHECK(pacer.GetStats().sleepMarginUs == 1500.0f);
+
+		// 3ms 寝過ごす環境: 初回は締め切りを 1.5ms 過ぎる
+		clock.oversleep = Microseconds(3'000);
+		pacer.Wait();
+		CHECK(pacer.GetStats().lastOvershootUs >= 1500.0f && pacer.GetStats().lastOvershootUs < 1510.0f);
+		CHECK(pacer.GetStats().sleepMarginUs >= 3750.0f && pacer.GetStats().sleepMarginUs < 3760.0f);
+
+		// 広げた余裕で、次からは締め切り前に起きてスピンで合わせる
+		clock.Work(Microseconds(1'000));
+		pacer.Wait();
+		CHECK(pacer.GetStats().lastOvershootUs < 5.0f);
+		CHECK(pacer.GetStats().lastSpinUs > 500.0f);
+
+		// 余裕は上限で止まる
+		clock.oversleep = Microseconds(10'000);
+		clock.Work(Microseconds(1'000));
+		pacer.Wait();
+		CHECK(pacer.GetStats().sleepMarginUs == 4000.0f);
+
+		// 寝過ごさなくなると 2% ずつ縮んで下限で止まる
+		clock.oversleep = Microseconds(0);
+		float previous = pacer.GetStats().sleepMarginUs;
+		bool shrinking = true;
+		for (int frame = 0; frame < 400; ++frame) {
+			clock.Work(Microseconds(1'000));
+			pacer.Wait();
+			const float margin = pacer.GetStats().sleepMarginUs;
+			shrinking = shrinking && margin <= previous;
+			previous = margin;
+		}
+		CHECK(shrinking);
+		CHECK(pacer.GetStats().sleepMarginUs == 100.0f);
+
+		// 余裕より手前まで仕事をしていればスリープしない
+		const uint32_t sleeps = clock.sleepCount;
+		clock.Work(Microseconds(9'950));
+		pacer.Wait();
+		CHECK(clock.sleepCount == sleeps);
+	}
+
+	/// <summary>
+	/// 超過時間は区間ごとに数え、合計はフレーム数と一致する
+	/// </summary>
+	void TestHistogram()
+	{
+		FramePacer pacer;
+		FakeClock clock;
+		clock.Connect(pacer);
+		pacer.Initialize(kFps);
+
+		// 余裕 1.5ms より 1.5ms 多く寝過ごす → 超過 1.5ms で "< 2ms" の区間
+		clock.oversleep = Microseconds(3'000);
+		pacer.Wait();
+		CHECK(pacer.GetStats().histogram[5] == 1);
+
+		// 以後は余裕が足りているので "< 50us"
+		for (int frame = 0; frame < 10; ++frame) {
+			clock.Work(Microseconds(1'000));
+			pacer.Wait();
+		}
+		CHECK(pacer.GetStats().histogram[0] == 10);
+
+		// 余裕の上限を大きく超えて寝過ごす → ">= 2ms"
+		clock.oversleep = Microseconds(20'000);
+		clock.Work(Microseconds(1'000));
+		pacer.Wait();
+		CHECK(pacer.GetStats().histogram[FramePacer::kHistogramBucketCount - 1] == 1);
+
+		uint64_t total = 0;
+		for (uint64_t count : pacer.GetStats().histogram) {
+			total += count;
+		}
+		CHECK(total == pacer.GetStats().frameCount);
+		CHECK(pacer.GetStats().maxOvershootUs >= 2000.0f);
+		CHECK(pacer.GetStats().meanOvershootUs > 0.0f && pacer.GetStats().meanOvershootUs < pacer.GetStats().maxOvershootUs);
+
+		pacer.ResetStats();
+		CHECK(pacer.GetStats().frameCount == 0);
+		CHECK(pacer.GetStats().histogram[0] == 0);
+		CHECK(pacer.GetStats().sleepMarginUs == 4000.0f);
+
+		CHECK(std::string(FramePacer::GetHistogramLabel(0)) == "< 50us");
+		CHECK(std::string(FramePacer::GetHistogramLabel(FramePacer::kHistogramBucketCount)).empty());
+	}
+
+} // namespace
+
+int main()
+{
+	TestDeadline();
+	TestLateFrames();
+	TestMarginAdaptation();
+	TestHistogram();
+	return Test::Finish("FramePacerTest");
+}
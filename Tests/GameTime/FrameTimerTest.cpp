@@ -0,0 +1,200 @@
+// C++
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Engine
+#include "FrameTimer.h"
+
+// Test
+#include "TestCommon.h"
+
+namespace {
+
+	using Clock = std::chrono::steady_clock;
+
+	/// <summary>
+	/// 手で進める時計
+	/// </summary>
+	struct FakeClock {
+		Clock::time_point now{};
+
+		void Advance(double seconds) {
+			now += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+		}
+	};
+
+	FakeClock gClock;
+
+	/// <summary>
+	/// 偽の時計につないで初期化する
+	/// </summary>
+	FrameTimer* Reset(FrameTimer::Mode mode, float fixedDeltaTime = 1.0f / 60.0f)
+	{
+		FrameTimer* timer = FrameTimer::GetInstance();
+		timer->SetTimeSource([] { return gClock.now; });
+		timer->SetMode(mode);
+		timer->SetTimeScale(1.0f);
+		timer->SetMaxStepsPerFrame(5);
+		timer->Initialize(fixedDeltaTime);
+		return timer;
+	}
+
+	/// <summary>
+	/// 1フレーム分時計を進め、回せるだけステップを回す
+	/// </summary>
+	uint32_t RunFrame(FrameTimer* timer, double seconds)
+	{
+		gClock.Advance(seconds);
+		timer->BeginFrame();
+		uint32_t steps = 0;
+		while (timer->StepSimulation()) {
+			++steps;
+		}
+		CHECK(steps == timer->GetStepsThisFrame());
+		return steps;
+	}
+
+	/// <summary>
+	/// 補間あり: 描画のレートに関係なく、実時間に見合った数だけステップが進む
+	/// </summary>
+	void TestStepsPerFrame()
+	{
+		const double fixed = 1.0 / 60.0;
+		// 描画 60 / 120 / 144 / 30 / 45 Hz
+		const double rates[] = { 60.0, 120.0, 144.0, 30.0, 45.0 };
+		for (double rate : rates) {
+			FrameTimer* timer = Reset(FrameTimer::Mode::kFixedInterpolated);
+			uint64_t steps = 0;
+			uint32_t maxSteps = 0;
+			const int frames = static_cast<int>(rate * 2.0);
+			for (int i = 0; i < frames; ++i) {
+				const uint32_t frameSteps = RunFrame(timer, 1.0 / rate);
+				steps += frameSteps;
+				maxSteps = (std::max)(maxSteps, frameSteps);
+			}
+			// 2秒で120ステップ (float の積算誤差で1つまでずれてよい)
+			const int64_t expected = static_cast<int64_t>(2.0 / fixed + 0.5);
+			CHECK(static_cast<int64_t>(steps) >= expected - 1 && static_cast<int64_t>(steps) <= expected);
+			CHECK(timer->GetStepIndex() == steps);
+			// 1フレームのステップ数は、フレーム時間に入るステップ数の切り上げ (+ 積算誤差の1つ) まで
+			CHECK(maxSteps <= static_cast<uint32_t>(std::ceil((1.0 / rate) / fixed)) + 1);
+		}
+
+		// 早送り: 時間の倍率を上げると同じ実時間で倍のステップが進む
+		FrameTimer* timer = Reset(FrameTimer::Mode::kFixedInterpolated);
+		timer->SetTimeScale(2.0f);
+		uint64_t steps = 0;
+		for (int i = 0; i < 60; ++i) {
+			steps += RunFrame(timer, fixed);
+		}
+		CHECK(steps >= 119 && steps <= 120);
+		timer->SetTimeScale(1.0f);
+		CHECK(timer->GetDeltaTime() == 1.0f / 60.0f);
+	}
+
+	/// <summary>
+	/// 処理落ち: 1フレームで進めるのは最大ステップ数までで、溜まった分は捨てる
+	/// </summary>
+	void TestCatchUpClamp()
+	{
+		FrameTimer* timer = Reset(FrameTimer::Mode::kFixedInterpolated);
+		RunFrame(timer, 1.0 / 60.0);
+
+		// ブレークポイント等で1秒止まっても5ステップだけ
+		CHECK(RunFrame(timer, 1.0) == 5);
+		// 次のフレームで残りを取り返そうとはしない
+		CHECK(RunFrame(timer, 1.0 / 60.0) <= 1);
+
+		// 上限は変えられる
+		timer->SetMaxStepsPerFrame(3);
+		CHECK(RunFrame(timer, 0.5) == 3);
+		CHECK(RunFrame(timer, 1.0 / 60.0) <= 1);
+		timer->SetMaxStepsPerFrame(5);
+
+		// ちょうど上限ぶん遅れた時も上限まで
+		RunFrame(timer, 1.0 / 120.0);
+		CHECK(RunFrame(timer, 5.5 / 60.0) == 5);
+	}
+
+	/// <summary>
+	/// 補間係数は常に [0, 1] で、積算の残りに比例する
+	/// </summary>
+	void TestAlphaRange()
+	{
+		FrameTimer* timer = Reset(FrameTimer::Mode::kFixedInterpolated);
+		std::mt19937 random(11);
+		std::uniform_real_distribution<double> frameTime(0.0, 0.2);
+		bool inRange = true;
+		for (int i = 0; i < 10000; ++i) {
+			RunFrame(timer, frameTime(random));
+			const float alpha = timer->GetInterpolationAlpha();
+			inRange = inRange && alpha >= 0.0f && alpha <= 1.0f;
+		}
+		CHECK(inRange);
+
+		// 1.5ステップ分進めれば1ステップ回して半分残る
+		timer = Reset(FrameTimer::Mode::kFixedInterpolated);
+		CHECK(RunFrame(timer, 1.5 / 60.0) == 1);
+		CHECK(timer->GetInterpolationAlpha() > 0.49f && timer->GetInterpolationAlpha() < 0.51f);
+		CHECK(RunFrame(timer, 0.25 / 60.0) == 0);
+		CHECK(timer->GetInterpolationAlpha() > 0.74f && timer->GetInterpolationAlpha() < 0.76f);
+
+		// 補間しない時は常に現在のステップを描く
+		timer = Reset(FrameTimer::Mode::kLockStep);
+		RunFrame(timer, 0.3 / 60.0);
+		CHECK(timer->GetInterpolationAlpha() == 1.0f);
+	}
+
+	/// <summary>
+	/// 1フレーム1ステップ: 実際のフレーム時間がどれだけ揺れても同じステップ列になる
+	/// (記録と再生で同じ結果になる前提)
+	/// </summary>
+	void TestLockStepReplay()
+	{
+		// 同じステップ幅で簡単な積分を回した結果を比べる
+		auto simulate = [](uint32_t seed, double maxFrameTime) {
+			FrameTimer* timer = Reset(FrameTimer::Mode::kLockStep);
+			std::mt19937 random(seed);
+			std::uniform_real_distribution<double> frameTime(0.0, maxFrameTime);
+			std::vector<float> trace;
+			float position = 0.0f;
+			float velocity = 3.0f;
+			for (int frame = 0; frame < 600; ++frame) {
+				gClock.Advance(frameTime(random));
+				timer->BeginFrame();
+				uint32_t steps = 0;
+				while (timer->StepSimulation()) {
+					velocity -= 9.8f * timer->GetDeltaTime();
+					position += velocity * timer->GetDeltaTime();
+					++steps;
+				}
+				CHECK(steps == 1);
+				trace.push_back(position);
+			}
+			CHECK(timer->GetStepIndex() == 600);
+			return trace;
+		};
+
+		// 記録時 (60FPS前後) と、待たずに全速で回す再生時・処理落ちした再生時
+		const std::vector<float> recorded = simulate(1, 1.0 / 50.0);
+		const std::vector<float> fastReplay = simulate(2, 1.0 / 1000.0);
+		const std::vector<float> slowReplay = simulate(3, 0.5);
+		CHECK(recorded == fastReplay);
+		CHECK(recorded == slowReplay);
+	}
+
+} // namespace
+
+int main()
+{
+	TestStepsPerFrame();
+	TestCatchUpClamp();
+	TestAlphaRange();
+	TestLockStepReplay();
+	FrameTimer::GetInstance()->SetTimeSource(nullptr);
+	return Test::Finish("FrameTimerTest");
+}
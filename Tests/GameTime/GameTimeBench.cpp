@@ -0,0 +1,57 @@
+// C++
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Engine
+#include "GameTIme.h"
+#include "HitStop.h"
+
+/// <summary>
+/// 10k 個の時間領域を登録し、毎フレーム一部にヒットストップを掛けながら GameUpdate を回す
+/// 1フレームあたりと1領域あたりの時間を出す
+/// </summary>
+int main()
+{
+	constexpr uint32_t kObjectCount = 10'000;
+	constexpr uint32_t kFrameCount = 10'000;
+	constexpr uint32_t kHitsPerFrame = 32;
+
+	GameTime* gameTime = GameTime::GetInstance();
+	HitStop* hitStop = HitStop::GetInstance();
+	gameTime->Initialize();
+
+	std::vector<TimeHandle> handles;
+	handles.reserve(kObjectCount);
+	for (uint32_t i = 0; i < kObjectCount; ++i) {
+		handles.push_back(gameTime->RegisterObject());
+	}
+
+	std::mt19937 random(5);
+	std::vector<TimeHandle> targets(kHitsPerFrame);
+	const float deltaTime = 1.0f / 60.0f;
+	double updateMilliseconds = 0.0;
+	double hitMilliseconds = 0.0;
+	uint64_t stoppedFrames = 0;
+	for (uint32_t frame = 0; frame < kFrameCount; ++frame) {
+		for (TimeHandle& target : targets) {
+			target = handles[random() % kObjectCount];
+		}
+		auto start = std::chrono::steady_clock::now();
+		hitStop->StartBatch(targets, HitStop::HitStopType::Light);
+		auto middle = std::chrono::steady_clock::now();
+		gameTime->GameUpdate(deltaTime);
+		auto end = std::chrono::steady_clock::now();
+		hitMilliseconds += std::chrono::duration<double, std::milli>(middle - start).count();
+		updateMilliseconds += std::chrono::duration<double, std::milli>(end - middle).count();
+		stoppedFrames += gameTime->GetDeltaTime(handles[frame % kObjectCount]) == 0.0f;
+	}
+
+	std::printf("objects=%u frames=%u\n", kObjectCount, kFrameCount);
+	std::printf("  GameUpdate %.2f us/frame (%.2f ns/object)  StartBatch(%u) %.2f us/frame  stopped samples=%llu\n",
+		updateMilliseconds * 1000.0 / kFrameCount, updateMilliseconds * 1e6 / (static_cast<double>(kFrameCount) * kObjectCount),
+		kHitsPerFrame, hitMilliseconds * 1000.0 / kFrameCount, static_cast<unsigned long long>(stoppedFrames));
+	return 0;
+}
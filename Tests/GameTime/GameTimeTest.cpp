@@ -0,0 +1,200 @@
+// C++
+#include <cstdint>
+#include <vector>
+
+// Engine
+#include "GameTIme.h"
+#include "HitStop.h"
+
+// Test
+#include "TestCommon.h"
+
+using namespace TimeHandleUtil;
+
+namespace {
+
+	/// <summary>
+	/// 共通の符号化: 添字と世代の往復と、無効値と重ならないこと
+	/// </summary>
+	void TestHandleCodec()
+	{
+		const TimeHandle handle = Make(1234, 56);
+		CHECK(GetIndex(handle) == 1234);
+		CHECK(GetGeneration(handle) == 56);
+		CHECK(NextGeneration(kGenerationMask) == 0);
+
+		// 最後の添字は最後の世代で kInvalid と同じビットになるので払い出さない
+		CHECK(Make(kIndexMask, kGenerationMask) == kInvalid);
+		CHECK(kMaxIndex < kIndexMask);
+		bool neverInvalid = true;
+		for (uint32_t generation = 0; generation <= kGenerationMask; ++generation) {
+			neverInvalid = neverInvalid && Make(kMaxIndex, generation) != kInvalid;
+		}
+		CHECK(neverInvalid);
+	}
+
+	/// <summary>
+	/// 解除した後の古いハンドルは、同じ添字が再登録されても弾かれる
+	/// </summary>
+	void TestStaleHandle()
+	{
+		GameTime* gameTime = GameTime::GetInstance();
+		HitStop* hitStop = HitStop::GetInstance();
+		gameTime->Initialize();
+
+		const TimeHandle first = gameTime->RegisterObject();
+		const TimeHandle other = gameTime->RegisterObject();
+		CHECK(gameTime->IsValid(first));
+		CHECK(gameTime->GetObjectCount() == 2);
+
+		gameTime->UnregisterObject(first);
+		CHECK(!gameTime->IsValid(first));
+		CHECK(gameTime->GetObjectCount() == 1);
+		// 二重解除は無視する
+		gameTime->UnregisterObject(first);
+		CHECK(gameTime->GetObjectCount() == 1);
+
+		// 同じ添字を別の世代で使い回す
+		const TimeHandle second = gameTime->RegisterObject();
+		CHECK(GetIndex(second) == GetIndex(first));
+		CHECK(second != first);
+		CHECK(gameTime->IsValid(second));
+		CHECK(!gameTime->IsValid(first));
+
+		// 古いハンドル経由の操作は新しい持ち主に届かない
+		gameTime->SetObjectTimeScale(first, 0.0f);
+		gameTime->SetObjectPaused(first, true);
+		hitStop->Start(first, HitStop::HitStopType::Heavy);
+		CHECK(!hitStop->IsActive(second));
+		CHECK(!hitStop->IsActive(first));
+		gameTime->GameUpdate(0.5f);
+		CHECK(gameTime->GetObjectTime(second) == 0.5f);
+		CHECK(gameTime->GetObjectTime(first) == 0.0f);
+		CHECK(gameTime->GetDeltaTime(second) == 1.0f);
+
+		// 解除すると解除前に掛けたヒットストップも残らない
+		hitStop->Start(other, HitStop::HitStopType::Heavy);
+		CHECK(hitStop->IsActive(other));
+		gameTime->UnregisterObject(other);
+		const TimeHandle reused = gameTime->RegisterObject();
+		CHECK(GetIndex(reused) == GetIndex(other));
+		CHECK(!hitStop->IsActive(reused));
+
+		// 初期化すると登録済みのハンドルはすべて無効
+		gameTime->Initialize();
+		CHECK(!gameTime->IsValid(second));
+		CHECK(!gameTime->IsValid(reused));
+		CHECK(gameTime->GetObjectCount() == 0);
+		CHECK(!gameTime->IsValid(kInvalid));
+	}
+
+	/// <summary>
+	/// 同じ添字を登録・解除し続けると世代が一周して0に戻り、その間も直前のハンドルは弾かれる
+	/// </summary>
+	void TestGenerationWrap()
+	{
+		GameTime* gameTime = GameTime::GetInstance();
+		gameTime->Initialize();
+
+		TimeHandle previous = gameTime->RegisterObject();
+		const uint32_t index = GetIndex(previous);
+		const uint32_t startGeneration = GetGeneration(previous);
+		bool sameIndex = true;
+		bool staleRejected = true;
+		bool neverInvalid = true;
+		bool wrapped = false;
+		for (uint32_t i = 0; i <= kGenerationMask; ++i) {
+			gameTime->UnregisterObject(previous);
+			const TimeHandle handle = gameTime->RegisterObject();
+			sameIndex = sameIndex && GetIndex(handle) == index;
+			staleRejected = staleRejected && !gameTime->IsValid(previous) && gameTime->IsValid(handle);
+			neverInvalid = neverInvalid && handle != kInvalid;
+			wrapped = wrapped || GetGeneration(handle) < GetGeneration(previous);
+			previous = handle;
+		}
+		CHECK(sameIndex);
+		CHECK(staleRejected);
+		CHECK(neverInvalid);
+		CHECK(wrapped);
+		// 世代の数だけ回すと元の世代に戻る (それより古いハンドルは区別できない)
+		CHECK(GetGeneration(previous) == startGeneration);
+	}
+
+	/// <summary>
+	/// まとめて掛けたヒットストップは、時間スケールに関係なく実時間で切れる
+	/// </summary>
+	void TestBatchHitStopExpiry()
+	{
+		GameTime* gameTime = GameTime::GetInstance();
+		HitStop* hitStop = HitStop::GetInstance();
+		gameTime->Initialize();
+		// スローモーション中でもヒットストップの長さは変わらない
+		gameTime->SetGlobalTimeScale(0.5f);
+
+		std::vector<TimeHandle> targets;
+		for (int i = 0; i < 8; ++i) {
+			targets.push_back(gameTime->RegisterObject());
+		}
+		const TimeHandle bystander = gameTime->RegisterObject();
+		// 解除済みのハンドルが混ざっていても無視する
+		const TimeHandle stale = gameTime->RegisterObject();
+		gameTime->UnregisterObject(stale);
+		targets.push_back(stale);
+
+		// 長いヒットストップ中の対象は短くしない
+		hitStop->Start(targets[0], HitStop::HitStopType::Heavy);
+		hitStop->StartBatch(targets, HitStop::HitStopType::Medium);
+		for (size_t i = 0; i + 1 < targets.size(); ++i) {
+			CHECK(hitStop->IsActive(targets[i]));
+		}
+		CHECK(!hitStop->IsActive(bystander));
+		CHECK(!hitStop->IsActive(stale));
+
+		const float deltaTime = 1.0f / 60.0f;
+		const float medium = HitStop::GetDuration(HitStop::HitStopType::Medium);
+		const float heavy = HitStop::GetDuration(HitStop::HitStopType::Heavy);
+		float elapsed = 0.0f;
+		int mediumFrames = 0;
+		int heavyFrames = 0;
+		for (int frame = 0; frame < 60; ++frame) {
+			gameTime->GameUpdate(deltaTime);
+			elapsed += deltaTime;
+			mediumFrames += gameTime->GetDeltaTime(targets[1]) == 0.0f;
+			heavyFrames += gameTime->GetDeltaTime(targets[0]) == 0.0f;
+			CHECK(gameTime->GetDeltaTime(bystander) == 1.0f);
+		}
+		// 1フレーム分の誤差の範囲で、実時間で継続時間だけ止まる
+		CHECK(mediumFrames >= static_cast<int>(medium / deltaTime) && mediumFrames <= static_cast<int>(medium / deltaTime) + 1);
+		CHECK(heavyFrames >= static_cast<int>(heavy / deltaTime) && heavyFrames <= static_cast<int>(heavy / deltaTime) + 1);
+		for (size_t i = 0; i + 1 < targets.size(); ++i) {
+			CHECK(!hitStop->IsActive(targets[i]));
+		}
+
+		// 止まっていた間の分だけ、スケールした時間が遅れる
+		const float scaled = elapsed * 0.5f;
+		CHECK(gameTime->GetObjectTime(bystander) > scaled - 1e-4f && gameTime->GetObjectTime(bystander) < scaled + 1e-4f);
+		const float expected = (elapsed - mediumFrames * deltaTime) * 0.5f;
+		CHECK(gameTime->GetObjectTime(targets[1]) > expected - 1e-4f && gameTime->GetObjectTime(targets[1]) < expected + 1e-4f);
+
+		// 途中で止めたものは次の更新から動く
+		hitStop->StartBatch(targets, HitStop::HitStopType::Light);
+		hitStop->Stop(targets[2]);
+		gameTime->GameUpdate(deltaTime);
+		CHECK(gameTime->GetDeltaTime(targets[2]) == 1.0f);
+		CHECK(gameTime->GetDeltaTime(targets[3]) == 0.0f);
+		hitStop->StopAll();
+		CHECK(!hitStop->IsActive(targets[3]));
+
+		gameTime->SetGlobalTimeScale(1.0f);
+	}
+
+} // namespace
+
+int main()
+{
+	TestHandleCodec();
+	TestStaleHandle();
+	TestGenerationWrap();
+	TestBatchHitStopExpiry();
+	return Test::Finish("GameTimeTest");
+}
@@ -0,0 +1,77 @@
+// C++
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Engine
+#include "AtlasPacker.h"
+
+namespace {
+
+	/// <summary>
+	/// 1組の画像を何度か詰め直して、ページ数・充填率・1回あたりの時間を出す
+	/// </summary>
+	void Run(const char* name, const std::vector<AtlasPacker::Size>& sizes)
+	{
+		constexpr uint32_t kRepeatCount = 20;
+		uint64_t pixels = 0;
+		for (const AtlasPacker::Size& size : sizes) {
+			pixels += uint64_t(size.width) * size.height;
+		}
+
+		AtlasPacker packer;
+		std::vector<AtlasPacker::Rect> rects;
+		double microseconds = 0.0;
+		for (uint32_t i = 0; i < kRepeatCount; ++i) {
+			auto start = std::chrono::steady_clock::now();
+			packer.Initialize(2048, 2048, 2);
+			packer.Pack(sizes, rects);
+			microseconds += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		// 画像そのものの面積 / 使ったページの面積 (余白・切り詰め前の高さを含む)
+		uint64_t pageArea = 0;
+		for (uint32_t page = 0; page < packer.GetPageCount(); ++page) {
+			pageArea += uint64_t(packer.GetPageWidth()) * packer.GetUsedHeight(page);
+		}
+		std::printf(" %-22s %5zu images  pages %u  occupancy %.1f%% (images only %.1f%%)  pack %.0f us\n",
+			name, sizes.size(), packer.GetPageCount(), packer.GetOccupancy() * 100.0f,
+			pageArea ? 100.0 * double(pixels) / double(pageArea) : 0.0, microseconds / kRepeatCount);
+	}
+
+} // namespace
+
+/// <summary>
+/// 2048x2048・余白2 のページに、よくある画像の組を詰めた時の効率と時間
+/// </summary>
+int main()
+{
+	std::mt19937 random(9);
+
+	// UI アイコン: 16～64 の正方形
+	std::vector<AtlasPacker::Size> icons;
+	for (int i = 0; i < 1000; ++i) {
+		const uint32_t size = 16u << (random() % 3);
+		icons.push_back({ size, size });
+	}
+
+	// スプライト: 8～256 のばらばらな長方形
+	std::vector<AtlasPacker::Size> sprites;
+	for (int i = 0; i < 1000; ++i) {
+		sprites.push_back({ static_cast<uint32_t>(8 + random() % 249), static_cast<uint32_t>(8 + random() % 249) });
+	}
+
+	// 文字・小物: 4～32 を大量に
+	std::vector<AtlasPacker::Size> glyphs;
+	for (int i = 0; i < 5000; ++i) {
+		glyphs.push_back({ static_cast<uint32_t>(4 + random() % 29), static_cast<uint32_t>(4 + random() % 29) });
+	}
+
+	std::printf("AtlasPacker 2048x2048, padding 2\n");
+	Run("icons 16-64 square", icons);
+	Run("sprites 8-256", sprites);
+	Run("glyphs 4-32", glyphs);
+	return 0;
+}
@@ -0,0 +1,129 @@
+// C++
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Engine
+#include "AtlasPacker.h"
+
+// Test
+#include "TestCommon.h"
+
+namespace {
+
+	/// <summary>
+	/// パディングを含めた矩形同士が同じページで重ならず、ページに収まっていること
+	/// </summary>
+	void CheckLayout(const AtlasPacker& packer, const std::vector<AtlasPacker::Size>& sizes,
+		const std::vector<AtlasPacker::Rect>& rects, uint32_t padding)
+	{
+		CHECK(rects.size() == sizes.size());
+		bool inBounds = true;
+		bool sizeKept = true;
+		for (size_t i = 0; i < rects.size(); ++i) {
+			const AtlasPacker::Rect& rect = rects[i];
+			sizeKept = sizeKept && rect.width == sizes[i].width && rect.height == sizes[i].height;
+			inBounds = inBounds && rect.page < packer.GetPageCount()
+				&& rect.x >= padding && rect.y >= padding
+				&& rect.x + rect.width + padding <= packer.GetPageWidth()
+				&& rect.y + rect.height + padding <= packer.GetUsedHeight(rect.page)
+				&& packer.GetUsedHeight(rect.page) <= packer.GetPageHeight();
+		}
+		CHECK(sizeKept);
+		CHECK(inBounds);
+
+		bool separated = true;
+		for (size_t a = 0; a < rects.size(); ++a) {
+			for (size_t b = a + 1; b < rects.size(); ++b) {
+				const AtlasPacker::Rect& ra = rects[a];
+				const AtlasPacker::Rect& rb = rects[b];
+				if (ra.page != rb.page) {
+					continue;
+				}
+				// 画像どうしの間は両側の余白ぶん (padding * 2) 空いている
+				const bool apart = ra.x + ra.width + padding * 2 <= rb.x || rb.x + rb.width + padding * 2 <= ra.x
+					|| ra.y + ra.height + padding * 2 <= rb.y || rb.y + rb.height + padding * 2 <= ra.y;
+				separated = separated && apart;
+			}
+		}
+		CHECK(separated);
+	}
+
+	/// <summary>
+	/// ばらばらな大きさの画像を詰めても重ならず、ページと余白を守る
+	/// </summary>
+	void TestRandomLayout()
+	{
+		const uint32_t paddings[] = { 0, 1, 2, 4 };
+		for (uint32_t padding : paddings) {
+			std::mt19937 random(padding + 7);
+			std::vector<AtlasPacker::Size> sizes;
+			for (int i = 0; i < 400; ++i) {
+				sizes.push_back({ static_cast<uint32_t>(1 + random() % 96), static_cast<uint32_t>(1 + random() % 96) });
+			}
+
+			AtlasPacker packer;
+			packer.Initialize(512, 512, padding);
+			std::vector<AtlasPacker::Rect> rects;
+			CHECK(packer.Pack(sizes, rects));
+			CHECK(packer.GetPageCount() >= 2);
+			CheckLayout(packer, sizes, rects, padding);
+			CHECK(packer.GetOccupancy() > 0.5f && packer.GetOccupancy() <= 1.0f);
+		}
+	}
+
+	/// <summary>
+	/// ぴったり収まる画像は隙間なく並ぶ
+	/// </summary>
+	void TestExactFit()
+	{
+		AtlasPacker packer;
+		packer.Initialize(256, 256, 2);
+		// 余白込みで 64x64 のタイル 16 枚で 1 ページがちょうど埋まる
+		std::vector<AtlasPacker::Size> sizes(16, AtlasPacker::Size{ 60, 60 });
+		std::vector<AtlasPacker::Rect> rects;
+		CHECK(packer.Pack(sizes, rects));
+		CHECK(packer.GetPageCount() == 1);
+		CHECK(packer.GetUsedHeight(0) == 256);
+		CHECK(packer.GetOccupancy() == 1.0f);
+		CheckLayout(packer, sizes, rects, 2);
+
+		// もう1枚は次のページへ
+		std::vector<AtlasPacker::Rect> more;
+		CHECK(packer.Pack({ { 60, 60 } }, more));
+		CHECK(more[0].page == 1 && more[0].x == 2 && more[0].y == 2);
+		CHECK(packer.GetUsedHeight(1) == 64);
+	}
+
+	/// <summary>
+	/// 余白込みでページに入らない画像は配置せず、残りは詰める
+	/// </summary>
+	void TestOversize()
+	{
+		AtlasPacker packer;
+		packer.Initialize(128, 128, 2);
+		const std::vector<AtlasPacker::Size> sizes = { { 32, 32 }, { 125, 10 }, { 124, 124 }, { 10, 200 } };
+		std::vector<AtlasPacker::Rect> rects;
+		CHECK(!packer.Pack(sizes, rects));
+		CHECK(rects[1].page == UINT32_MAX);
+		CHECK(rects[3].page == UINT32_MAX);
+		CHECK(rects[0].page != UINT32_MAX && rects[2].page != UINT32_MAX);
+		// ページいっぱいの画像と同じページには入らない
+		CHECK(rects[0].page != rects[2].page);
+		CHECK(packer.GetPageCount() == 2);
+
+		// 空のまま
+		packer.Initialize(128, 128, 2);
+		CHECK(packer.GetPageCount() == 0);
+		CHECK(packer.GetOccupancy() == 0.0f);
+	}
+
+} // namespace
+
+int main()
+{
+	TestRandomLayout();
+	TestExactFit();
+	TestOversize();
+	return Test::Finish("AtlasPackerTest");
+}
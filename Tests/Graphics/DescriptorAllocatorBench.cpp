@@ -0,0 +1,65 @@
+// C++
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Engine
+#include "DescriptorAllocator.h"
+
+using namespace DescriptorHandleUtil;
+
+/// <summary>
+/// 常駐 4096 個を確保・解放し続け (断片化)、毎フレーム一時領域から 1024 個を取る
+/// 1回あたりの時間と、使われた番号の最大値 (ヒープをどこまで使ったか) を出す
+/// </summary>
+int main()
+{
+	constexpr uint32_t kFrameCount = 10000;
+	constexpr uint32_t kPersistentOpsPerFrame = 64;
+	constexpr uint32_t kTransientPerFrame = 1024;
+	constexpr size_t kMaxLive = 3000;
+
+	DescriptorAllocator allocator;
+	allocator.Initialize(4096, 2048, 2);
+
+	std::mt19937 random(7);
+	std::vector<DescriptorHandle> live;
+	uint32_t highestIndex = 0;
+	uint64_t operations = 0;
+	uint64_t failures = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	for (uint32_t frame = 0; frame < kFrameCount; ++frame) {
+		allocator.BeginFrame();
+		for (uint32_t i = 0; i < kPersistentOpsPerFrame; ++i, ++operations) {
+			if (live.size() < kMaxLive && (live.empty() || (random() & 1))) {
+				const DescriptorHandle handle = allocator.Allocate();
+				if (handle == kInvalid) {
+					++failures;
+					continue;
+				}
+				live.push_back(handle);
+				highestIndex = (std::max)(highestIndex, GetIndex(handle));
+			} else {
+				const size_t victim = random() % live.size();
+				allocator.Free(live[victim]);
+				live[victim] = live.back();
+				live.pop_back();
+			}
+		}
+		for (uint32_t i = 0; i < kTransientPerFrame; ++i, ++operations) {
+			if (allocator.AllocateTransient(1) == kInvalid) {
+				++failures;
+			}
+		}
+	}
+	const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	std::printf("operations=%llu  %.1f ns/op  failures=%llu  live=%zu  highest index=%u (capacity %u)\n",
+		static_cast<unsigned long long>(operations), milliseconds * 1e6 / operations, static_cast<unsigned long long>(failures),
+		live.size(), highestIndex, allocator.GetPersistentCapacity());
+	return 0;
+}
@@ -0,0 +1,106 @@
+// C++
+#include <cstdint>
+
+// Engine
+#include "DescriptorAllocator.h"
+
+// Test
+#include "TestCommon.h"
+
+using namespace DescriptorHandleUtil;
+
+namespace {
+
+	/// <summary>
+	/// 常駐領域: 小さい番号から使い、使い切れば無効値
+	/// </summary>
+	void TestPersistentOrder()
+	{
+		DescriptorAllocator allocator;
+		allocator.Initialize(8, 16, 2);
+
+		for (uint32_t i = 0; i < 8; ++i) {
+			const DescriptorHandle handle = allocator.Allocate();
+			CHECK(handle != kInvalid);
+			CHECK(GetIndex(handle) == i);
+			CHECK(allocator.IsValid(handle));
+		}
+		CHECK(allocator.Allocate() == kInvalid);
+		CHECK(allocator.GetPersistentUsed() == 8);
+	}
+
+	/// <summary>
+	/// 解放した番号は frameCount フレーム後に再利用され、古いハンドルは無効になる
+	/// </summary>
+	void TestDeferredFree()
+	{
+		DescriptorAllocator allocator;
+		allocator.Initialize(8, 16, 2);
+
+		DescriptorHandle handles[8];
+		for (DescriptorHandle& handle : handles) {
+			handle = allocator.Allocate();
+		}
+
+		allocator.Free(handles[3]);
+		CHECK(!allocator.IsValid(handles[3]));
+		// GPUがまだ使っているかもしれないので、すぐには戻らない
+		CHECK(allocator.Allocate() == kInvalid);
+		allocator.BeginFrame();
+		CHECK(allocator.Allocate() == kInvalid);
+
+		allocator.BeginFrame();
+		const DescriptorHandle reused = allocator.Allocate();
+		CHECK(GetIndex(reused) == 3);
+		CHECK(reused != handles[3]);
+		CHECK(allocator.IsValid(reused));
+		CHECK(!allocator.IsValid(handles[3]));
+		CHECK(allocator.GetHandle(3) == reused);
+
+		// 古いハンドルでの二重解放は無視される
+		allocator.Free(handles[3]);
+		CHECK(allocator.IsValid(reused));
+	}
+
+	/// <summary>
+	/// 一時領域: フレーム単位で連続して確保し、frameCount フレーム後に回収して折り返す
+	/// </summary>
+	void TestTransientRing()
+	{
+		DescriptorAllocator allocator;
+		allocator.Initialize(8, 16, 2);
+
+		// 一時領域は常駐領域の後ろから
+		CHECK(allocator.AllocateTransient(10) == 8);
+		// 残りは6つ
+		CHECK(allocator.AllocateTransient(7) == kInvalid);
+		CHECK(allocator.AllocateTransient(6) == 18);
+
+		// 前のフレームの分はまだ使われている
+		allocator.BeginFrame();
+		CHECK(allocator.AllocateTransient(1) == kInvalid);
+
+		allocator.BeginFrame();
+		CHECK(allocator.AllocateTransient(4) == 8);
+		CHECK(allocator.GetTransientUsed() == 4);
+
+		allocator.BeginFrame();
+		CHECK(allocator.AllocateTransient(10) == 12);
+
+		// 末尾に連続した空きが足りなければ、先頭へ折り返す
+		allocator.BeginFrame();
+		CHECK(allocator.AllocateTransient(4) == 8);
+
+		CHECK(allocator.AllocateTransient(0) == kInvalid);
+		CHECK(allocator.AllocateTransient(17) == kInvalid);
+	}
+
+} // namespace
+
+int main()
+{
+	TestPersistentOrder();
+	TestDeferredFree();
+	TestTransientRing();
+	return Test::Finish("DescriptorAllocatorTest");
+}
@@ -0,0 +1,101 @@
+// C++
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Engine
+#include "FrustumCuller.h"
+
+namespace {
+
+	/// <summary>
+	/// 比較用: 1つずつ8頂点をクリップ空間へ送る素直な判定
+	/// </summary>
+	bool IsVisibleReference(const AABB& bounds, const Matrix4x4& viewProjection)
+	{
+		uint32_t outside[6] = {};
+		for (int i = 0; i < 8; ++i) {
+			const float x = (i & 1) ? bounds.max.x : bounds.min.x;
+			const float y = (i & 2) ? bounds.max.y : bounds.min.y;
+			const float z = (i & 4) ? bounds.max.z : bounds.min.z;
+			float v[4];
+			for (int j = 0; j < 4; ++j) {
+				v[j] = x * viewProjection.m[0][j] + y * viewProjection.m[1][j] + z * viewProjection.m[2][j] + viewProjection.m[3][j];
+			}
+			outside[0] += v[0] < -v[3];
+			outside[1] += v[0] > v[3];
+			outside[2] += v[1] < -v[3];
+			outside[3] += v[1] > v[3];
+			outside[4] += v[2] < 0.0f;
+			outside[5] += v[2] > v[3];
+		}
+		for (uint32_t count : outside) {
+			if (count == 8) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+} // namespace
+
+/// <summary>
+/// 100k 個のAABBの登録・カリングにかかる時間を、1つずつ8頂点を変換する判定と比べる
+/// </summary>
+int main()
+{
+	constexpr uint32_t kCount = 100000;
+	constexpr uint32_t kRepeatCount = 200;
+
+	const Matrix4x4 cameraWorld = MakeAffineMatrix(Vector3{ 1.0f, 1.0f, 1.0f }, Vector3{ 0.3f, 0.7f, 0.0f }, Vector3{ 0.0f, 5.0f, -20.0f });
+	const Matrix4x4 viewProjection = Inverse(cameraWorld) * MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 200.0f);
+
+	std::mt19937 random(39);
+	std::uniform_real_distribution<float> position(-300.0f, 300.0f);
+	std::uniform_real_distribution<float> rotation(-3.14f, 3.14f);
+	std::uniform_real_distribution<float> scale(0.2f, 4.0f);
+	const AABB local = { { -1.0f, -1.0f, -1.0f }, { 1.0f, 2.0f, 1.0f } };
+	std::vector<AABB> bounds(kCount);
+	for (AABB& b : bounds) {
+		const Vector3 s = { scale(random), scale(random), scale(random) };
+		const Vector3 r = { rotation(random), rotation(random), rotation(random) };
+		const Vector3 t = { position(random), position(random) * 0.2f, position(random) };
+		b = FrustumCuller::TransformBounds(local, MakeAffineMatrix(s, r, t));
+	}
+
+	FrustumCuller culler;
+	culler.SetFrustum(viewProjection);
+	culler.Reserve(kCount);
+
+	auto start = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < kRepeatCount; ++i) {
+		culler.Clear();
+		for (const AABB& b : bounds) {
+			culler.Add(b);
+		}
+	}
+	const double addMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / kRepeatCount;
+
+	std::vector<uint32_t> visible;
+	start = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < kRepeatCount; ++i) {
+		culler.Cull(visible);
+	}
+	const double cullMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / kRepeatCount;
+
+	uint32_t referenceVisible = 0;
+	start = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < kRepeatCount; ++i) {
+		referenceVisible = 0;
+		for (const AABB& b : bounds) {
+			referenceVisible += IsVisibleReference(b, viewProjection);
+		}
+	}
+	const double referenceMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / kRepeatCount;
+
+	std::printf("%u boxes: visible %zu (8-corner reference %u)\n", kCount, visible.size(), referenceVisible);
+	std::printf(" add %.3f ms, cull %.3f ms, 8-corner reference %.3f ms\n", addMilliseconds, cullMilliseconds, referenceMilliseconds);
+	return 0;
+}
@@ -0,0 +1,175 @@
+// C++
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Engine
+#include "FrustumCuller.h"
+
+// Test
+#include "TestCommon.h"
+
+namespace {
+
+	/// <summary>
+	/// 比較用: 8頂点をクリップ空間へ送り、全部が同じ面の外にあれば見えない (平面を介さない素直な判定)
+	/// </summary>
+	bool IsVisibleReference(const AABB& bounds, const Matrix4x4& viewProjection)
+	{
+		float clip[8][4];
+		for (int i = 0; i < 8; ++i) {
+			const float x = (i & 1) ? bounds.max.x : bounds.min.x;
+			const float y = (i & 2) ? bounds.max.y : bounds.min.y;
+			const float z = (i & 4) ? bounds.max.z : bounds.min.z;
+			for (int j = 0; j < 4; ++j) {
+				clip[i][j] = x * viewProjection.m[0][j] + y * viewProjection.m[1][j] + z * viewProjection.m[2][j] + viewProjection.m[3][j];
+			}
+		}
+		auto allOutside = [&](auto isOutside) {
+			for (const float* corner : clip) {
+				if (!isOutside(corner)) {
+					return false;
+				}
+			}
+			return true;
+		};
+		return !(allOutside([](const float* v) { return v[0] < -v[3]; }) ||
+			allOutside([](const float* v) { return v[0] > v[3]; }) ||
+			allOutside([](const float* v) { return v[1] < -v[3]; }) ||
+			allOutside([](const float* v) { return v[1] > v[3]; }) ||
+			allOutside([](const float* v) { return v[2] < 0.0f; }) ||
+			allOutside([](const float* v) { return v[2] > v[3]; }));
+	}
+
+	Matrix4x4 MakeViewProjection()
+	{
+		const Matrix4x4 cameraWorld = MakeAffineMatrix(Vector3{ 1.0f, 1.0f, 1.0f }, Vector3{ 0.3f, 0.7f, 0.0f }, Vector3{ 0.0f, 5.0f, -20.0f });
+		return Inverse(cameraWorld) * MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 200.0f);
+	}
+
+	std::vector<AABB> MakeRandomBounds(uint32_t count)
+	{
+		std::mt19937 random(39);
+		std::uniform_real_distribution<float> position(-300.0f, 300.0f);
+		std::uniform_real_distribution<float> rotation(-3.14f, 3.14f);
+		std::uniform_real_distribution<float> scale(0.2f, 4.0f);
+		const AABB local = { { -1.0f, -1.0f, -1.0f }, { 1.0f, 2.0f, 1.0f } };
+
+		std::vector<AABB> bounds(count);
+		for (AABB& b : bounds) {
+			const Vector3 s = { scale(random), scale(random), scale(random) };
+			const Vector3 r = { rotation(random), rotation(random), rotation(random) };
+			const Vector3 t = { position(random), position(random) * 0.2f, position(random) };
+			b = FrustumCuller::TransformBounds(local, MakeAffineMatrix(s, r, t));
+		}
+		return bounds;
+	}
+
+	/// <summary>
+	/// 変換後のAABBは変換した8頂点を全て含む
+	/// </summary>
+	void TestTransformBounds()
+	{
+		const AABB local = { { -1.0f, -1.0f, -1.0f }, { 1.0f, 2.0f, 1.0f } };
+		const Matrix4x4 world = MakeAffineMatrix(Vector3{ 2.0f, 1.0f, 3.0f }, Vector3{ 0.4f, 1.1f, -0.6f }, Vector3{ 5.0f, 6.0f, 7.0f });
+		const AABB bounds = FrustumCuller::TransformBounds(local, world);
+
+		constexpr float kEpsilon = 1e-4f;
+		for (int i = 0; i < 8; ++i) {
+			const Vector3 corner = { (i & 1) ? local.max.x : local.min.x, (i & 2) ? local.max.y : local.min.y, (i & 4) ? local.max.z : local.min.z };
+			const Vector3 p = Transform(corner, world);
+			CHECK(p.x >= bounds.min.x - kEpsilon && p.x <= bounds.max.x + kEpsilon);
+			CHECK(p.y >= bounds.min.y - kEpsilon && p.y <= bounds.max.y + kEpsilon);
+			CHECK(p.z >= bounds.min.z - kEpsilon && p.z <= bounds.max.z + kEpsilon);
+		}
+	}
+
+	/// <summary>
+	/// 見えているものは必ず残す (平面判定なので角の近くで余分に残るのは許す)
+	/// </summary>
+	void TestConservativeAgainstReference()
+	{
+		constexpr uint32_t kCount = 20000;
+		const Matrix4x4 viewProjection = MakeViewProjection();
+		const std::vector<AABB> bounds = MakeRandomBounds(kCount);
+
+		FrustumCuller culler;
+		culler.SetFrustum(viewProjection);
+		culler.Reserve(kCount);
+		for (const AABB& b : bounds) {
+			culler.Add(b);
+		}
+		std::vector<uint32_t> visible;
+		culler.Cull(visible);
+
+		std::vector<uint8_t> mask(kCount, 0);
+		for (uint32_t index : visible) {
+			mask[index] = 1;
+		}
+		uint32_t referenceVisible = 0;
+		uint32_t missed = 0;
+		uint32_t extra = 0;
+		for (uint32_t i = 0; i < kCount; ++i) {
+			const bool expected = IsVisibleReference(bounds[i], viewProjection);
+			referenceVisible += expected;
+			missed += expected && !mask[i];
+			extra += !expected && mask[i];
+		}
+		CHECK(missed == 0);
+		CHECK(referenceVisible > 0 && referenceVisible < kCount);
+		// 余分に残るのは見えている数の 5% 以内
+		CHECK(extra * 20 <= referenceVisible);
+		CHECK(std::is_sorted(visible.begin(), visible.end()));
+		CHECK(std::adjacent_find(visible.begin(), visible.end()) == visible.end());
+	}
+
+	/// <summary>
+	/// 4で割り切れない数 (SIMDの端数) でも同じ結果になる
+	/// </summary>
+	void TestTailCount()
+	{
+		const Matrix4x4 viewProjection = MakeViewProjection();
+		const std::vector<AABB> bounds = MakeRandomBounds(4003);
+
+		FrustumCuller all;
+		all.SetFrustum(viewProjection);
+		for (const AABB& b : bounds) {
+			all.Add(b);
+		}
+		std::vector<uint32_t> expected;
+		all.Cull(expected);
+
+		for (uint32_t count : { 1u, 2u, 3u, 5u, 7u }) {
+			FrustumCuller part;
+			part.SetFrustum(viewProjection);
+			for (uint32_t i = 0; i < count; ++i) {
+				part.Add(bounds[bounds.size() - count + i]);
+			}
+			std::vector<uint32_t> visible;
+			part.Cull(visible);
+
+			std::vector<uint32_t> shifted;
+			for (uint32_t index : expected) {
+				if (index >= bounds.size() - count) {
+					shifted.push_back(index - static_cast<uint32_t>(bounds.size() - count));
+				}
+			}
+			CHECK(visible == shifted);
+		}
+
+		all.Clear();
+		CHECK(all.GetCount() == 0);
+		all.Cull(expected);
+		CHECK(expected.empty());
+	}
+
+} // namespace
+
+int main()
+{
+	TestTransformBounds();
+	TestConservativeAgainstReference();
+	TestTailCount();
+	return Test::Finish("FrustumCullerTest");
+}
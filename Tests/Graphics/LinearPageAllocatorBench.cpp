@@ -0,0 +1,51 @@
+// C++
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Engine
+#include "LinearPageAllocator.h"
+
+/// <summary>
+/// 5000 オブジェクト分の定数 (変換 192B・マテリアル 112B・カメラ 16B) を毎フレーム詰める
+/// ページの中身は CPU のメモリで代用し、割り当てと書き込みにかかる時間を測る
+/// </summary>
+int main()
+{
+	constexpr uint32_t kPageSize = 2 * 1024 * 1024;
+	constexpr uint32_t kObjectCount = 5000;
+	constexpr uint32_t kFrameCount = 200;
+
+	LinearPageAllocator allocator;
+	allocator.Initialize(kPageSize, 256, 2);
+	std::vector<std::vector<uint8_t>> pages;
+
+	const uint8_t transform[192] = { 1 };
+	const uint8_t material[112] = { 2 };
+	const uint8_t camera[16] = { 3 };
+	const struct { const uint8_t* data; uint32_t size; } constants[] = {
+		{ transform, sizeof(transform) }, { material, sizeof(material) }, { camera, sizeof(camera) },
+	};
+
+	const auto start = std::chrono::steady_clock::now();
+	for (uint32_t frame = 0; frame < kFrameCount; ++frame) {
+		allocator.BeginFrame();
+		for (uint32_t object = 0; object < kObjectCount; ++object) {
+			for (const auto& constant : constants) {
+				const LinearPageAllocator::Allocation allocation = allocator.Allocate(constant.size);
+				while (allocation.page >= pages.size()) {
+					pages.emplace_back(kPageSize);
+				}
+				std::memcpy(pages[allocation.page].data() + allocation.offset, constant.data, constant.size);
+			}
+		}
+	}
+	const double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / kFrameCount;
+
+	std::printf("%u objects: pages=%u (%.1f MiB) frameBytes=%llu allocations=%u  %.1f us/frame\n",
+		kObjectCount, allocator.GetPageCount(), allocator.GetPageCount() * (kPageSize / (1024.0 * 1024.0)),
+		static_cast<unsigned long long>(allocator.GetFrameBytes()), allocator.GetFrameAllocationCount(), microseconds);
+	return 0;
+}
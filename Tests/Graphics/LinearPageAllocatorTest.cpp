@@ -0,0 +1,102 @@
+// C++
+#include <cstdint>
+#include <set>
+
+// Engine
+#include "LinearPageAllocator.h"
+
+// Test
+#include "TestCommon.h"
+
+namespace {
+
+	/// <summary>
+	/// 境界合わせとページの切り替え
+	/// </summary>
+	void TestAlignmentAndPaging()
+	{
+		LinearPageAllocator allocator;
+		allocator.Initialize(4096, 256, 2);
+		allocator.BeginFrame();
+
+		const LinearPageAllocator::Allocation first = allocator.Allocate(10);
+		const LinearPageAllocator::Allocation second = allocator.Allocate(300);
+		CHECK(first.page == 0 && first.offset == 0);
+		CHECK(second.page == 0 && second.offset == 256);
+		CHECK(allocator.GetFrameBytes() == 256 + 512);
+		CHECK(allocator.GetFrameAllocationCount() == 2);
+
+		// ちょうど埋まるまでは同じページ、入りきらなければ次のページの先頭から
+		const LinearPageAllocator::Allocation big = allocator.Allocate(4096 - 768);
+		CHECK(big.page == 0 && big.offset == 768);
+		const LinearPageAllocator::Allocation next = allocator.Allocate(1);
+		CHECK(next.page == 1 && next.offset == 0);
+		CHECK(allocator.GetPageCount() == 2);
+
+		// ページサイズちょうどは1ページを丸ごと使う
+		const LinearPageAllocator::Allocation whole = allocator.Allocate(4096);
+		CHECK(whole.page == 2 && whole.offset == 0);
+	}
+
+	/// <summary>
+	/// 使ったページは frameCount フレーム後まで再利用しない
+	/// </summary>
+	void TestPagesStayInFlight()
+	{
+		LinearPageAllocator allocator;
+		allocator.Initialize(4096, 256, 2);
+
+		allocator.BeginFrame();
+		const LinearPageAllocator::Allocation frame0 = allocator.Allocate(1);
+		allocator.BeginFrame();
+		const LinearPageAllocator::Allocation frame1 = allocator.Allocate(1);
+		// 前のフレームのページはGPUがまだ読んでいる
+		CHECK(frame1.page != frame0.page);
+		CHECK(allocator.GetPageCount() == 2);
+
+		allocator.BeginFrame();
+		const LinearPageAllocator::Allocation frame2 = allocator.Allocate(1);
+		// 2フレーム前のページは戻ってくる
+		CHECK(frame2.page == frame0.page);
+		CHECK(allocator.GetPageCount() == 2);
+		CHECK(allocator.GetFrameBytes() == 256);
+	}
+
+	/// <summary>
+	/// 毎フレーム同じ量を割り当てるならページ数は増え続けない
+	/// </summary>
+	void TestSteadyState()
+	{
+		LinearPageAllocator allocator;
+		allocator.Initialize(4096, 256, 3);
+
+		for (uint32_t frame = 0; frame < 3; ++frame) {
+			allocator.BeginFrame();
+			for (uint32_t i = 0; i < 40; ++i) {
+				allocator.Allocate(256);
+			}
+		}
+		const uint32_t settled = allocator.GetPageCount();
+		// 1フレーム 40 × 256 = 2.5 ページ → 3ページ × 3フレーム
+		CHECK(settled == 9);
+
+		for (uint32_t frame = 0; frame < 100; ++frame) {
+			allocator.BeginFrame();
+			std::set<uint32_t> pages;
+			for (uint32_t i = 0; i < 40; ++i) {
+				pages.insert(allocator.Allocate(256).page);
+			}
+			CHECK(pages.size() == 3);
+		}
+		CHECK(allocator.GetPageCount() == settled);
+	}
+
+} // namespace
+
+int main()
+{
+	TestAlignmentAndPaging();
+	TestPagesStayInFlight();
+	TestSteadyState();
+	return Test::Finish("LinearPageAllocatorTest");
+}
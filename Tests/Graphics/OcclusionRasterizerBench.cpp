@@ -0,0 +1,104 @@
+// C++
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Engine
+#include "OcclusionRasterizer.h"
+
+/// <summary>
+/// 遮蔽物を描く時間 (マップチップの壁と地面 / 起伏のある地形) と、AABB 100k 個を調べる時間を測る
+/// </summary>
+int main()
+{
+	constexpr uint32_t kRepeatCount = 200;
+	constexpr uint32_t kQueryCount = 100000;
+
+	const Matrix4x4 view = Inverse(MakeAffineMatrix(Vector3{ 1.0f, 1.0f, 1.0f }, Vector3{ 0.35f, 0.0f, 0.0f }, Vector3{ 0.0f, 12.0f, -30.0f }));
+	const Matrix4x4 viewProjection = view * MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 200.0f);
+
+	const AABB unitBox = { { -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f } };
+	std::vector<Matrix4x4> boxes;
+	for (int x = -10; x <= 10; ++x) {
+		for (int y = 0; y < 4; ++y) {
+			if (!(x > -2 && x < 2 && y < 2)) {
+				boxes.push_back(MakeAffineMatrix(Vector3{ 1.0f, 1.0f, 1.0f }, Vector3{ 0.0f, 0.0f, 0.0f }, Vector3{ x * 2.0f, y * 2.0f, 0.0f }));
+			}
+		}
+	}
+	const float ground[4][3] = { { -100.0f, -1.0f, -100.0f }, { 100.0f, -1.0f, -100.0f }, { -100.0f, -1.0f, 100.0f }, { 100.0f, -1.0f, 100.0f } };
+	const uint32_t groundIndices[6] = { 0, 2, 1, 1, 2, 3 };
+
+	// 22 × 22 頂点の起伏のある地形
+	constexpr uint32_t kGridSize = 22;
+	std::vector<float> grid;
+	std::vector<uint32_t> gridIndices;
+	for (uint32_t z = 0; z < kGridSize; ++z) {
+		for (uint32_t x = 0; x < kGridSize; ++x) {
+			grid.push_back(x - 10.5f);
+			grid.push_back(std::sin(x * 0.5f) * std::cos(z * 0.4f) * 1.5f - 2.0f);
+			grid.push_back(z - 10.5f);
+		}
+	}
+	for (uint32_t z = 0; z + 1 < kGridSize; ++z) {
+		for (uint32_t x = 0; x + 1 < kGridSize; ++x) {
+			const uint32_t a = z * kGridSize + x;
+			gridIndices.insert(gridIndices.end(), { a, a + kGridSize, a + 1, a + 1, a + kGridSize, a + kGridSize + 1 });
+		}
+	}
+	const Matrix4x4 terrainWorld = MakeAffineMatrix(Vector3{ 3.0f, 3.0f, 3.0f }, Vector3{ 0.0f, 0.0f, 0.0f }, Vector3{ 0.0f, 0.0f, 10.0f });
+
+	OcclusionRasterizer rasterizer;
+	rasterizer.Initialize();
+
+	auto start = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < kRepeatCount; ++i) {
+		rasterizer.BeginFrame(viewProjection);
+		for (const Matrix4x4& world : boxes) {
+			rasterizer.AddOccluderBox(unitBox, world);
+		}
+		rasterizer.AddOccluder(&ground[0][0], sizeof(ground[0]), 4, groundIndices, 6, MakeIdentity4x4());
+		rasterizer.Rasterize();
+	}
+	double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / kRepeatCount;
+	std::printf("%zu boxes + ground (%u triangles, %u binned): %.3f ms/frame (rasterize %.1f us)\n",
+		boxes.size(), rasterizer.GetStats().occluderTriangles, rasterizer.GetStats().binnedTriangles, milliseconds, rasterizer.GetStats().rasterizeMicroseconds);
+
+	start = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < kRepeatCount; ++i) {
+		rasterizer.BeginFrame(viewProjection);
+		rasterizer.AddOccluder(grid.data(), sizeof(float) * 3, static_cast<uint32_t>(grid.size() / 3), gridIndices.data(), static_cast<uint32_t>(gridIndices.size()), terrainWorld);
+		rasterizer.Rasterize();
+	}
+	milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / kRepeatCount;
+	std::printf("terrain grid (%u triangles): %.3f ms/frame\n", rasterizer.GetStats().occluderTriangles, milliseconds);
+
+	rasterizer.BeginFrame(viewProjection);
+	for (const Matrix4x4& world : boxes) {
+		rasterizer.AddOccluderBox(unitBox, world);
+	}
+	rasterizer.Rasterize();
+
+	std::mt19937 random(40);
+	std::uniform_real_distribution<float> positionX(-25.0f, 25.0f);
+	std::uniform_real_distribution<float> positionY(-0.9f, 10.0f);
+	std::uniform_real_distribution<float> positionZ(-15.0f, 40.0f);
+	std::uniform_real_distribution<float> size(0.1f, 2.0f);
+	std::vector<AABB> bounds(kQueryCount);
+	for (AABB& b : bounds) {
+		const Vector3 center = { positionX(random), positionY(random), positionZ(random) };
+		const float s = size(random);
+		b = { { center.x - s, center.y - s, center.z - s }, { center.x + s, center.y + s, center.z + s } };
+	}
+	uint32_t visible = 0;
+	start = std::chrono::steady_clock::now();
+	for (const AABB& b : bounds) {
+		visible += rasterizer.IsVisible(b);
+	}
+	milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	std::printf("test %u boxes: %.3f ms (%u visible)\n", kQueryCount, milliseconds, visible);
+	return 0;
+}
@@ -0,0 +1,290 @@
+// C++
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Engine
+#include "OcclusionRasterizer.h"
+
+// Test
+#include "TestCommon.h"
+
+namespace {
+
+	constexpr uint32_t kWidth = OcclusionRasterizer::kDefaultWidth_;
+	constexpr uint32_t kHeight = OcclusionRasterizer::kDefaultHeight_;
+
+	struct ClipVertex {
+		float x, y, z, w;
+	};
+
+	ClipVertex ToClip(const Vector3& p, const Matrix4x4& m)
+	{
+		return {
+			p.x * m.m[0][0] + p.y * m.m[1][0] + p.z * m.m[2][0] + m.m[3][0],
+			p.x * m.m[0][1] + p.y * m.m[1][1] + p.z * m.m[2][1] + m.m[3][1],
+			p.x * m.m[0][2] + p.y * m.m[1][2] + p.z * m.m[2][2] + m.m[3][2],
+			p.x * m.m[0][3] + p.y * m.m[1][3] + p.z * m.m[2][3] + m.m[3][3],
+		};
+	}
+
+	/// <summary>
+	/// 比較用の素直なラスタライザ: 全画素の中心で重心座標を double で求める (タイル分けも近面の切り取りもしない)
+	/// </summary>
+	void RasterizeReferenceTriangle(std::vector<float>& depth, const ClipVertex (&v)[3])
+	{
+		double x[3], y[3], z[3];
+		for (int i = 0; i < 3; ++i) {
+			x[i] = (v[i].x / v[i].w * 0.5 + 0.5) * kWidth;
+			y[i] = (0.5 - v[i].y / v[i].w * 0.5) * kHeight;
+			z[i] = v[i].z / v[i].w;
+		}
+		const double area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+		if (std::fabs(area) < 1e-6) {
+			return;
+		}
+		for (uint32_t py = 0; py < kHeight; ++py) {
+			for (uint32_t px = 0; px < kWidth; ++px) {
+				const double cx = px + 0.5;
+				const double cy = py + 0.5;
+				const double w0 = ((x[2] - x[1]) * (cy - y[1]) - (y[2] - y[1]) * (cx - x[1])) / area;
+				const double w1 = ((x[0] - x[2]) * (cy - y[2]) - (y[0] - y[2]) * (cx - x[2])) / area;
+				const double w2 = 1.0 - w0 - w1;
+				if (w0 < 0.0 || w1 < 0.0 || w2 < 0.0) {
+					continue;
+				}
+				float& out = depth[py * kWidth + px];
+				out = (std::min)(out, static_cast<float>(w0 * z[0] + w1 * z[1] + w2 * z[2]));
+			}
+		}
+	}
+
+	void RasterizeReferenceBox(std::vector<float>& depth, const AABB& local, const Matrix4x4& worldViewProjection)
+	{
+		static constexpr uint32_t kBoxIndices[36] = {
+			0, 2, 1, 1, 2, 3, 4, 5, 6, 5, 7, 6, 0, 1, 4, 1, 5, 4,
+			2, 6, 3, 3, 6, 7, 0, 4, 2, 2, 4, 6, 1, 3, 5, 3, 7, 5,
+		};
+		ClipVertex corners[8];
+		for (int i = 0; i < 8; ++i) {
+			corners[i] = ToClip({ (i & 1) ? local.max.x : local.min.x, (i & 2) ? local.max.y : local.min.y, (i & 4) ? local.max.z : local.min.z }, worldViewProjection);
+		}
+		for (uint32_t i = 0; i < 36; i += 3) {
+			const ClipVertex triangle[3] = { corners[kBoxIndices[i]], corners[kBoxIndices[i + 1]], corners[kBoxIndices[i + 2]] };
+			RasterizeReferenceTriangle(depth, triangle);
+		}
+	}
+
+	/// <summary>
+	/// 深度を8bitのPGMに書く (差が出た時に見比べる用)
+	/// </summary>
+	void WriteDepthImage(const char* path, const std::vector<float>& depth)
+	{
+		FILE* file = std::fopen(path, "wb");
+		if (!file) {
+			return;
+		}
+		std::fprintf(file, "P5 %u %u 255\n", kWidth, kHeight);
+		for (float value : depth) {
+			const uint8_t pixel = static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f);
+			std::fwrite(&pixel, 1, 1, file);
+		}
+		std::fclose(file);
+	}
+
+	/// <summary>
+	/// 少し見下ろすカメラの前に、中央下に穴の空いたマップチップの壁と地面を置いた場面
+	/// </summary>
+	struct Scene {
+		Matrix4x4 viewProjection;
+		AABB unitBox = { { -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f } };
+		std::vector<Matrix4x4> boxes;
+		float ground[4][5] = {
+			{ -100.0f, -1.0f, -100.0f, 0.0f, 0.0f },
+			{ 100.0f, -1.0f, -100.0f, 0.0f, 0.0f },
+			{ -100.0f, -1.0f, 100.0f, 0.0f, 0.0f },
+			{ 100.0f, -1.0f, 100.0f, 0.0f, 0.0f },
+		};
+		uint32_t groundIndices[6] = { 0, 2, 1, 1, 2, 3 };
+
+		Scene() {
+			const Matrix4x4 view = Inverse(MakeAffineMatrix(Vector3{ 1.0f, 1.0f, 1.0f }, Vector3{ 0.35f, 0.0f, 0.0f }, Vector3{ 0.0f, 12.0f, -30.0f }));
+			viewProjection = view * MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 200.0f);
+			for (int x = -10; x <= 10; ++x) {
+				for (int y = 0; y < 4; ++y) {
+					if (x > -2 && x < 2 && y < 2) {
+						continue;
+					}
+					boxes.push_back(MakeAffineMatrix(Vector3{ 1.0f, 1.0f, 1.0f }, Vector3{ 0.0f, 0.0f, 0.0f }, Vector3{ x * 2.0f, y * 2.0f, 0.0f }));
+				}
+			}
+		}
+
+		void Draw(OcclusionRasterizer& rasterizer, bool withGround) const {
+			rasterizer.BeginFrame(viewProjection);
+			for (const Matrix4x4& world : boxes) {
+				rasterizer.AddOccluderBox(unitBox, world);
+			}
+			if (withGround) {
+				rasterizer.AddOccluder(&ground[0][0], sizeof(ground[0]), 4, groundIndices, 6, MakeIdentity4x4());
+			}
+			rasterizer.Rasterize();
+		}
+	};
+
+	/// <summary>
+	/// 箱の壁を比較用のラスタライザと画素ごとに比べる
+	/// 辺の上にちょうど乗る画素 (どちらの三角形が取るか) 以外は同じ深度になる
+	/// </summary>
+	void TestImageDiffAgainstReference(const Scene& scene)
+	{
+		OcclusionRasterizer rasterizer;
+		rasterizer.Initialize(kWidth, kHeight);
+		scene.Draw(rasterizer, false);
+
+		std::vector<float> reference(kWidth * kHeight, 1.0f);
+		for (const Matrix4x4& world : scene.boxes) {
+			RasterizeReferenceBox(reference, scene.unitBox, world * scene.viewProjection);
+		}
+
+		const std::vector<float>& depth = rasterizer.GetDepthBuffer();
+		uint32_t differing = 0;
+		float maxError = 0.0f;
+		uint32_t covered = 0;
+		for (size_t i = 0; i < depth.size(); ++i) {
+			const float error = std::fabs(depth[i] - reference[i]);
+			covered += reference[i] < 1.0f;
+			if (error > 1e-4f) {
+				++differing;
+			} else {
+				maxError = (std::max)(maxError, error);
+			}
+		}
+		std::printf("image diff: %u / %u pixels differ, max depth error on the rest %.2e\n", differing, kWidth * kHeight, maxError);
+		// 壁は画面の大部分を覆う
+		CHECK(covered > kWidth * kHeight / 4);
+		CHECK(differing <= kWidth * kHeight / 1000);
+		if (differing > kWidth * kHeight / 1000) {
+			WriteDepthImage("OcclusionRasterizerTest_depth.pgm", depth);
+			WriteDepthImage("OcclusionRasterizerTest_reference.pgm", reference);
+		}
+	}
+
+	/// <summary>
+	/// 近面をまたぐ地面は切り取って描き、同じ入力なら結果はビット単位で同じ
+	/// </summary>
+	void TestNearClipAndDeterminism(const Scene& scene)
+	{
+		OcclusionRasterizer first;
+		first.Initialize(kWidth, kHeight);
+		scene.Draw(first, true);
+		// 地面は画面の下端まで覆う
+		CHECK(first.GetDepthBuffer()[(kHeight - 1) * kWidth + kWidth / 2] < 1.0f);
+
+		OcclusionRasterizer boxesOnly;
+		boxesOnly.Initialize(kWidth, kHeight);
+		scene.Draw(boxesOnly, false);
+		CHECK(boxesOnly.GetDepthBuffer()[(kHeight - 1) * kWidth + kWidth / 2] == 1.0f);
+		// 近面で切った地面は2つ以上の三角形になる
+		CHECK(first.GetStats().occluderTriangles >= boxesOnly.GetStats().occluderTriangles + 2);
+
+		OcclusionRasterizer second;
+		second.Initialize(kWidth, kHeight);
+		scene.Draw(second, true);
+		CHECK(std::memcmp(first.GetDepthBuffer().data(), second.GetDepthBuffer().data(), kWidth * kHeight * sizeof(float)) == 0);
+	}
+
+	/// <summary>
+	/// 壁の奥は隠れ、穴の奥・手前・近面をまたぐもの・描いていないフレームは見える
+	/// </summary>
+	void TestQueries(const Scene& scene)
+	{
+		OcclusionRasterizer rasterizer;
+		rasterizer.Initialize(kWidth, kHeight);
+		CHECK(rasterizer.IsVisible({ { 4.0f, 1.0f, 6.0f }, { 5.0f, 2.0f, 7.0f } }));
+
+		scene.Draw(rasterizer, true);
+		CHECK(!rasterizer.IsVisible({ { 4.0f, 1.0f, 6.0f }, { 5.0f, 2.0f, 7.0f } }));
+		CHECK(rasterizer.IsVisible({ { -0.5f, 0.0f, 6.0f }, { 0.5f, 1.0f, 7.0f } }));
+		CHECK(rasterizer.IsVisible({ { 4.0f, 1.0f, -6.0f }, { 5.0f, 2.0f, -5.0f } }));
+		CHECK(!rasterizer.IsVisible({ { 4.0f, -4.0f, 20.0f }, { 5.0f, -3.0f, 21.0f } }));
+		CHECK(rasterizer.IsVisible({ { -0.5f, 0.0f, -40.0f }, { 0.5f, 1.0f, -39.0f } }));
+
+		rasterizer.Reset();
+		CHECK(rasterizer.IsVisible({ { 4.0f, 1.0f, 6.0f }, { 5.0f, 2.0f, 7.0f } }));
+	}
+
+	/// <summary>
+	/// 隠れていると答えたものは、比較用の深度でも画面上の範囲全体が手前で塞がれている
+	/// </summary>
+	void TestConservativeAgainstReference(const Scene& scene)
+	{
+		OcclusionRasterizer rasterizer;
+		rasterizer.Initialize(kWidth, kHeight);
+		scene.Draw(rasterizer, false);
+
+		std::vector<float> reference(kWidth * kHeight, 1.0f);
+		for (const Matrix4x4& world : scene.boxes) {
+			RasterizeReferenceBox(reference, scene.unitBox, world * scene.viewProjection);
+		}
+
+		std::mt19937 random(40);
+		std::uniform_real_distribution<float> positionX(-25.0f, 25.0f);
+		std::uniform_real_distribution<float> positionY(-0.9f, 10.0f);
+		std::uniform_real_distribution<float> positionZ(-15.0f, 40.0f);
+		std::uniform_real_distribution<float> size(0.1f, 2.0f);
+
+		uint32_t occluded = 0;
+		uint32_t wrong = 0;
+		for (uint32_t i = 0; i < 20000; ++i) {
+			const Vector3 center = { positionX(random), positionY(random), positionZ(random) };
+			const float s = size(random);
+			const AABB bounds = { { center.x - s, center.y - s, center.z - s }, { center.x + s, center.y + s, center.z + s } };
+			if (rasterizer.IsVisible(bounds)) {
+				continue;
+			}
+			++occluded;
+
+			float minX = 1e9f, minY = 1e9f, maxX = -1e9f, maxY = -1e9f, minZ = 1e9f;
+			for (int k = 0; k < 8; ++k) {
+				const ClipVertex v = ToClip({ (k & 1) ? bounds.max.x : bounds.min.x, (k & 2) ? bounds.max.y : bounds.min.y, (k & 4) ? bounds.max.z : bounds.min.z }, scene.viewProjection);
+				minX = (std::min)(minX, (v.x / v.w * 0.5f + 0.5f) * kWidth);
+				maxX = (std::max)(maxX, (v.x / v.w * 0.5f + 0.5f) * kWidth);
+				minY = (std::min)(minY, (0.5f - v.y / v.w * 0.5f) * kHeight);
+				maxY = (std::max)(maxY, (0.5f - v.y / v.w * 0.5f) * kHeight);
+				minZ = (std::min)(minZ, v.z / v.w);
+			}
+			// 中心が範囲に入る画面内の画素
+			const int32_t x0 = (std::max)(static_cast<int32_t>(std::ceil(minX - 0.5f)), 0);
+			const int32_t x1 = (std::min)(static_cast<int32_t>(std::floor(maxX - 0.5f)), static_cast<int32_t>(kWidth) - 1);
+			const int32_t y0 = (std::max)(static_cast<int32_t>(std::ceil(minY - 0.5f)), 0);
+			const int32_t y1 = (std::min)(static_cast<int32_t>(std::floor(maxY - 0.5f)), static_cast<int32_t>(kHeight) - 1);
+			bool blocked = true;
+			for (int32_t y = y0; y <= y1 && blocked; ++y) {
+				for (int32_t x = x0; x <= x1 && blocked; ++x) {
+					blocked = reference[y * kWidth + x] < minZ;
+				}
+			}
+			wrong += !blocked;
+		}
+		std::printf("random boxes: %u occluded, %u not blocked in the reference\n", occluded, wrong);
+		CHECK(occluded > 0);
+		CHECK(wrong == 0);
+		CHECK(rasterizer.GetStats().occludedBounds == occluded);
+	}
+
+} // namespace
+
+int main()
+{
+	const Scene scene;
+	TestImageDiffAgainstReference(scene);
+	TestNearClipAndDeterminism(scene);
+	TestQueries(scene);
+	TestConservativeAgainstReference(scene);
+	return Test::Finish("OcclusionRasterizerTest");
+}
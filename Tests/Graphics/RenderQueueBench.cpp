@@ -0,0 +1,112 @@
+// C++
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Engine
+#include "RenderQueue.h"
+
+using namespace RenderKey;
+
+namespace {
+
+	class NullSink : public RenderCommandSink
+	{
+	public:
+		void SetPipeline(uint32_t) override {}
+		void SetMaterial(uint32_t) override {}
+		void SetTexture(uint32_t) override {}
+		void Draw(uint32_t, const DrawPacket*, uint32_t) override {}
+	};
+
+} // namespace
+
+/// <summary>
+/// 20k パケット (パイプライン 4・材質 64・テクスチャ 128) を積んだ順と並べ替えた後で流し、
+/// 状態の設定回数と、基数ソート・std::sort の時間を比べる
+/// </summary>
+int main()
+{
+	constexpr uint32_t kPacketCount = 20000;
+	constexpr uint32_t kRepeatCount = 200;
+
+	std::mt19937_64 random(1);
+	std::vector<DrawPacket> packets;
+	for (uint32_t i = 0; i < kPacketCount; ++i) {
+		const uint32_t pipeline = random() % 4;
+		const uint32_t material = random() % 64;
+		const uint32_t texture = random() % 128;
+		const uint32_t depth = random() % kDepthMax;
+		packets.push_back({ Make(RenderPass::Opaque, pipeline, material, texture, DrawPacket::kNoBatch, depth), pipeline, material, texture, DrawPacket::kNoBatch, i });
+	}
+
+	NullSink sink;
+	RenderQueue queue;
+	queue.Reserve(kPacketCount);
+	for (const DrawPacket& packet : packets) {
+		queue.Submit(packet);
+	}
+	queue.Execute(sink);
+	const RenderQueue::Stats unsorted = queue.GetStats();
+
+	double radixMicroseconds = 0.0;
+	double stdMicroseconds = 0.0;
+	std::vector<DrawPacket> shuffled = packets;
+	for (uint32_t i = 0; i < kRepeatCount; ++i) {
+		std::shuffle(shuffled.begin(), shuffled.end(), random);
+
+		queue.Clear();
+		for (const DrawPacket& packet : shuffled) {
+			queue.Submit(packet);
+		}
+		auto start = std::chrono::steady_clock::now();
+		queue.Sort();
+		radixMicroseconds += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+		std::vector<DrawPacket> copy = shuffled;
+		start = std::chrono::steady_clock::now();
+		std::sort(copy.begin(), copy.end(), [](const DrawPacket& a, const DrawPacket& b) { return a.key < b.key; });
+		stdMicroseconds += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+	}
+	queue.Execute(sink);
+	const RenderQueue::Stats sorted = queue.GetStats();
+
+	std::printf("%u packets (4 pipelines, 64 materials, 128 textures)\n", kPacketCount);
+	std::printf(" unsorted: P%u M%u T%u sets, skipped %u of %u\n", unsorted.pipelineSets, unsorted.materialSets, unsorted.textureSets, unsorted.skippedSets, unsorted.packets * 3);
+	std::printf(" sorted:   P%u M%u T%u sets, skipped %u of %u\n", sorted.pipelineSets, sorted.materialSets, sorted.textureSets, sorted.skippedSets, sorted.packets * 3);
+	std::printf(" radix sort %.0f us, std::sort %.0f us\n", radixMicroseconds / kRepeatCount, stdMicroseconds / kRepeatCount);
+
+	// 同じパケット数を 50 モデルの繰り返しとして積み、インスタンシングでまとめた後のドローコール数
+	constexpr uint32_t kModelCount = 50;
+	queue.Clear();
+	for (uint32_t i = 0; i < kPacketCount; ++i) {
+		const uint32_t model = random() % kModelCount;
+		const uint32_t material = model % 8;
+		queue.Submit({ Make(RenderPass::Opaque, 0, material, model, model, random() % kDepthMax), 0, material, model, model, i });
+	}
+	const auto start = std::chrono::steady_clock::now();
+	queue.Sort();
+	queue.BuildBatches(1024);
+	const double batchMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+	queue.Execute(sink);
+	std::printf("%u packets / %u models: %u draw calls after batching, sort + batch %.0f us\n", kPacketCount, kModelCount, queue.GetStats().drawCalls, batchMicroseconds);
+
+	// まとめの番号がキーの 8bit を超える (1000 モデル) と、元の番号で並べ直す分が掛かる
+	constexpr uint32_t kManyModelCount = 1000;
+	queue.Clear();
+	for (uint32_t i = 0; i < kPacketCount; ++i) {
+		const uint32_t model = random() % kManyModelCount;
+		queue.Submit({ Make(RenderPass::Opaque, 0, 0, 0, model, random() % kDepthMax), 0, 0, 0, model, i });
+	}
+	const auto overflowStart = std::chrono::steady_clock::now();
+	queue.Sort();
+	queue.BuildBatches(1024);
+	const double overflowMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - overflowStart).count();
+	queue.Execute(sink);
+	std::printf("%u packets / %u models: %u draw calls, %u key overflows, sort + batch %.0f us\n", kPacketCount, kManyModelCount,
+		queue.GetStats().drawCalls, queue.GetStats().keyOverflows, overflowMicroseconds);
+	return 0;
+}
@@ -0,0 +1,285 @@
+// C++
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+// Engine
+#include "RenderQueue.h"
+
+// Test
+#include "TestCommon.h"
+
+using namespace RenderKey;
+
+namespace {
+
+	/// <summary>
+	/// 出力先への呼び出しを文字列で記録する
+	/// </summary>
+	class RecordingSink : public RenderCommandSink
+	{
+	public:
+		void SetPipeline(uint32_t pipeline) override { Append('P', pipeline); }
+		void SetMaterial(uint32_t material) override { Append('M', material); }
+		void SetTexture(uint32_t texture) override { Append('T', texture); }
+		void Draw(uint32_t, const DrawPacket* packets, uint32_t count) override {
+			for (uint32_t i = 0; i < count; ++i) {
+				if (i > 0) {
+					log.back() = ',';
+				}
+				Append(i == 0 ? 'D' : '\0', packets[i].item);
+			}
+		}
+
+		std::string log;
+
+	private:
+		// "P0 " のように1つ書く (tag が '\0' なら番号だけ)
+		void Append(char tag, uint32_t value) {
+			if (tag != '\0') {
+				log.push_back(tag);
+			}
+			log.append(std::to_string(value));
+			log.push_back(' ');
+		}
+	};
+
+	DrawPacket MakePacket(RenderPass pass, uint32_t pipeline, uint32_t material, uint32_t texture, uint32_t depth, uint32_t item)
+	{
+		return { Make(pass, pipeline, material, texture, DrawPacket::kNoBatch, depth), pipeline, material, texture, DrawPacket::kNoBatch, item };
+	}
+
+	DrawPacket MakeBatchedPacket(uint32_t pipeline, uint32_t material, uint32_t texture, uint32_t batch, uint32_t depth, uint32_t item)
+	{
+		return { Make(RenderPass::Opaque, pipeline, material, texture, batch, depth), pipeline, material, texture, batch, item };
+	}
+
+	/// <summary>
+	/// キーの並び: パス → (不透明) 状態 → 手前から / (半透明) 奥から
+	/// </summary>
+	void TestKeyOrder()
+	{
+		// 不透明はパイプラインが最優先
+		CHECK(Make(RenderPass::Opaque, 1, 0, 0, 0, 0) > Make(RenderPass::Opaque, 0, 4095, 65535, 255, kDepthMax));
+		// 半透明は不透明の後
+		CHECK(Make(RenderPass::Transparent, 0, 0, 0, 0, 0) > Make(RenderPass::Opaque, 255, 4095, 65535, 255, kDepthMax));
+		// 半透明は奥 (深度が大きい) から
+		CHECK(Make(RenderPass::Transparent, 5, 0, 0, 0, 100) < Make(RenderPass::Transparent, 0, 0, 0, 0, 50));
+		// 不透明は同じ状態の中で手前から
+		CHECK(Make(RenderPass::Opaque, 0, 0, 0, 0, 1 << 10) < Make(RenderPass::Opaque, 0, 0, 0, 0, 1 << 20));
+		CHECK(GetPass(Make(RenderPass::Transparent, 1, 2, 3, 4, 5)) == RenderPass::Transparent);
+		CHECK(GetPass(Make(RenderPass::Opaque, 1, 2, 3, 4, 5)) == RenderPass::Opaque);
+
+		CHECK(QuantizeDepth(-1.0f, 0.1f, 100.0f) == 0);
+		CHECK(QuantizeDepth(1000.0f, 0.1f, 100.0f) == kDepthMax);
+		CHECK(QuantizeDepth(10.0f, 0.1f, 100.0f) < QuantizeDepth(20.0f, 0.1f, 100.0f));
+	}
+
+	/// <summary>
+	/// 並べ替え後は前と同じ状態の設定を飛ばす
+	/// </summary>
+	void TestStateChangeSkipping()
+	{
+		RenderQueue queue;
+		queue.Submit(MakePacket(RenderPass::Opaque, 1, 0, 0, 5, 0));
+		queue.Submit(MakePacket(RenderPass::Opaque, 0, 0, 0, 9, 1));
+		queue.Submit(MakePacket(RenderPass::Opaque, 0, 0, 0, 9, 2));
+		queue.Submit(MakePacket(RenderPass::Opaque, 0, 0, 1, 1, 3));
+		queue.Submit(MakePacket(RenderPass::Transparent, 0, 0, 0, 1, 4));
+		queue.Sort();
+
+		RecordingSink sink;
+		queue.Execute(sink);
+		// 同じキーは積んだ順 (1, 2)、パイプラインが変わると材質・テクスチャも設定し直す
+		CHECK(sink.log == "P0 M0 T0 D1 D2 T1 D3 P1 M0 T0 D0 P0 M0 T0 D4 ");
+
+		const RenderQueue::Stats& stats = queue.GetStats();
+		CHECK(stats.packets == 5);
+		CHECK(stats.pipelineSets == 3 && stats.materialSets == 3 && stats.textureSets == 4);
+		CHECK(stats.skippedSets == 5 * 3 - 10);
+		CHECK(stats.drawCalls == 5);
+	}
+
+	/// <summary>
+	/// 基数ソートは std::stable_sort と同じ並びになる
+	/// </summary>
+	void TestSortMatchesStableSort()
+	{
+		std::mt19937_64 random(1);
+		RenderQueue queue;
+		std::vector<DrawPacket> reference;
+		for (uint32_t i = 0; i < 20000; ++i) {
+			const RenderPass pass = (random() % 4 == 0) ? RenderPass::Transparent : RenderPass::Opaque;
+			// 同じキーが多く出るよう値の幅を狭くする
+			const DrawPacket packet = MakePacket(pass, random() % 4, random() % 8, random() % 16, static_cast<uint32_t>(random() % 4) << 20, i);
+			queue.Submit(packet);
+			reference.push_back(packet);
+		}
+		std::stable_sort(reference.begin(), reference.end(), [](const DrawPacket& a, const DrawPacket& b) { return a.key < b.key; });
+
+		queue.Sort();
+		CHECK(queue.GetSize() == reference.size());
+		bool same = true;
+		for (size_t i = 0; i < reference.size(); ++i) {
+			same = same && queue.GetPackets()[i].item == reference[i].item;
+		}
+		CHECK(same);
+	}
+
+	/// <summary>
+	/// 見えないものを取り除いても残りの順番は変わらない
+	/// </summary>
+	void TestRemoveCulled()
+	{
+		RenderQueue queue;
+		for (uint32_t i = 0; i < 6; ++i) {
+			queue.Submit(MakePacket(RenderPass::Opaque, 0, 0, 0, (6 - i) << 10, i));
+		}
+		queue.Sort();
+		queue.RemoveCulled({ 1, 0, 1, 0, 1, 1 });
+
+		std::vector<uint32_t> items;
+		for (const DrawPacket& packet : queue.GetPackets()) {
+			items.push_back(packet.item);
+		}
+		CHECK((items == std::vector<uint32_t>{ 5, 4, 2, 0 }));
+	}
+
+	/// <summary>
+	/// 同じ状態・同じ batch のものは積んだ順が離れていても1回の描画にまとまる
+	/// 材質が違えば分かれ、kNoBatch はまとめない
+	/// </summary>
+	void TestBatching()
+	{
+		constexpr uint32_t kNoBatch = DrawPacket::kNoBatch;
+
+		RenderQueue queue;
+		queue.Submit(MakeBatchedPacket(0, 0, 0, 0, 500 << 8, 0));
+		queue.Submit(MakeBatchedPacket(0, 0, 0, 1, 10 << 8, 1));
+		queue.Submit(MakeBatchedPacket(0, 0, 0, 0, 100 << 8, 2));
+		queue.Submit(MakeBatchedPacket(0, 1, 0, 0, 50 << 8, 3));
+		queue.Submit(MakeBatchedPacket(1, 0, 0, kNoBatch, 5 << 8, 4));
+		queue.Submit(MakeBatchedPacket(1, 0, 0, kNoBatch, 6 << 8, 5));
+		queue.Submit(MakeBatchedPacket(0, 0, 0, 0, 300 << 8, 6));
+		queue.Sort();
+		queue.BuildBatches(1024);
+
+		RecordingSink sink;
+		queue.Execute(sink);
+		// batch 0 は手前から 2, 6, 0
+		CHECK(sink.log == "P0 M0 T0 D2,6,0 D1 M1 D3 P1 M0 T0 D4 D5 ");
+		CHECK(queue.GetStats().drawCalls == 5);
+		CHECK(queue.GetStats().batchedPackets == 3);
+	}
+
+	/// <summary>
+	/// 1回にまとめる数の上限で分かれる
+	/// </summary>
+	void TestBatchSizeLimit()
+	{
+		RenderQueue queue;
+		for (uint32_t i = 0; i < 10; ++i) {
+			queue.Submit(MakeBatchedPacket(0, 0, 0, 7, i << 12, i));
+		}
+		queue.Sort();
+		queue.BuildBatches(4);
+
+		const std::vector<RenderBatch>& batches = queue.GetBatches();
+		CHECK(batches.size() == 3);
+		CHECK(batches.size() == 3 && batches[0].count == 4 && batches[1].count == 4 && batches[2].count == 2);
+		CHECK(batches.size() == 3 && batches[2].first == 8);
+	}
+
+	/// <summary>
+	/// BuildBatches をしなければ1つずつ描画する (Sort や Submit の後はまとめ直しが要る)
+	/// </summary>
+	void TestExecuteWithoutBatches()
+	{
+		RenderQueue queue;
+		for (uint32_t i = 0; i < 5; ++i) {
+			queue.Submit(MakeBatchedPacket(0, 0, 0, 7, i << 12, i));
+		}
+		queue.Sort();
+		RecordingSink sink;
+		queue.Execute(sink);
+		CHECK(queue.GetStats().drawCalls == 5);
+		CHECK(queue.GetStats().batchedPackets == 0);
+
+		queue.BuildBatches(1024);
+		queue.Submit(MakeBatchedPacket(0, 0, 0, 7, 0, 5));
+		CHECK(queue.GetBatches().empty());
+	}
+
+	/// <summary>
+	/// キーのビット幅を超える番号があっても、別の番号と混ざらずにまとまる
+	/// </summary>
+	void TestKeyOverflow()
+	{
+		constexpr uint32_t kNoBatch = DrawPacket::kNoBatch;
+		CHECK(Fits(RenderPass::Opaque, 255, 4095, 254));
+		CHECK(Fits(RenderPass::Opaque, 0, 0, kNoBatch));
+		// 255 は kNoBatch と同じビットになる
+		CHECK(!Fits(RenderPass::Opaque, 0, 0, 255));
+		CHECK(!Fits(RenderPass::Opaque, 0, 4096, 0));
+		CHECK(!Fits(RenderPass::Opaque, 256, 0, 0));
+		// 半透明のキーに batch は入らない
+		CHECK(Fits(RenderPass::Transparent, 0, 0, 1000));
+
+		// 300個のまとめを2回ずつ、離して積む (0 と 256 などはキーの上で同じ番号になる)
+		constexpr uint32_t kBatchCount = 300;
+		RenderQueue queue;
+		uint32_t item = 0;
+		for (uint32_t round = 0; round < 2; ++round) {
+			for (uint32_t batch = 0; batch < kBatchCount; ++batch) {
+				queue.Submit(MakeBatchedPacket(0, 0, 0, batch, round << 12, item++));
+			}
+		}
+		queue.Sort();
+		queue.BuildBatches(1024);
+		CHECK(queue.GetBatches().size() == kBatchCount);
+		bool paired = true;
+		for (const RenderBatch& batch : queue.GetBatches()) {
+			paired = paired && batch.count == 2;
+		}
+		CHECK(paired);
+		RecordingSink sink;
+		queue.Execute(sink);
+		CHECK(queue.GetStats().keyOverflows == (kBatchCount - 255) * 2);
+		CHECK(queue.GetStats().drawCalls == kBatchCount);
+
+		// 材質 5000 はキーの上では 904 と同じ。1000 より後に並ぶ
+		queue.Clear();
+		queue.Submit(MakePacket(RenderPass::Opaque, 0, 5000, 0, 0, 0));
+		queue.Submit(MakePacket(RenderPass::Opaque, 0, 1000, 0, 0, 1));
+		queue.Submit(MakePacket(RenderPass::Opaque, 0, 904, 0, 0, 2));
+		queue.Submit(MakePacket(RenderPass::Opaque, 0, 5000, 0, 0, 3));
+		queue.Sort();
+		RecordingSink materialSink;
+		queue.Execute(materialSink);
+		CHECK(materialSink.log == "P0 M904 T0 D2 M1000 D1 M5000 D0 D3 ");
+		CHECK(queue.GetStats().keyOverflows == 2);
+
+		// 収まっていれば並べ直さない
+		queue.Clear();
+		queue.Submit(MakePacket(RenderPass::Opaque, 0, 1, 0, 0, 0));
+		queue.Sort();
+		queue.Execute(materialSink);
+		CHECK(queue.GetStats().keyOverflows == 0);
+	}
+
+} // namespace
+
+int main()
+{
+	TestKeyOrder();
+	TestStateChangeSkipping();
+	TestSortMatchesStableSort();
+	TestRemoveCulled();
+	TestBatching();
+	TestBatchSizeLimit();
+	TestExecuteWithoutBatches();
+	TestKeyOverflow();
+	return Test::Finish("RenderQueueTest");
+}
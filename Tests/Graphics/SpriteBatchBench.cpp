@@ -0,0 +1,71 @@
+// C++
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Engine
+#include "SpriteBatch.h"
+
+/// <summary>
+/// 5,000 枚 (レイヤー 4・テクスチャ 16) を頂点の組み立てから積んで並べ替え、
+/// 1フレームあたりの時間と、積んだ順のまま描いた場合との描画回数を比べる
+/// </summary>
+int main()
+{
+	constexpr uint32_t kSpriteCount = 5000;
+	constexpr uint32_t kFrameCount = 1000;
+	constexpr uint32_t kLayerCount = 4;
+	constexpr uint32_t kTextureCount = 16;
+
+	struct Sprite {
+		int32_t layer;
+		uint32_t textureIndex;
+		Matrix4x4 world;
+	};
+	std::mt19937 random(3);
+	std::vector<Sprite> sprites;
+	for (uint32_t i = 0; i < kSpriteCount; ++i) {
+		const float x = static_cast<float>(random() % 1280);
+		const float y = static_cast<float>(random() % 720);
+		sprites.push_back({ static_cast<int32_t>(random() % kLayerCount), static_cast<uint32_t>(random() % kTextureCount),
+			MakeScaleMatrix({ 32.0f, 32.0f, 1.0f }) * MakeTranslateMatrix({ x, y, 0.0f }) });
+	}
+
+	// 積んだ順のまま描くとテクスチャが変わるたびに1回
+	uint32_t unsortedDraws = 0;
+	for (uint32_t i = 0; i < kSpriteCount; ++i) {
+		unsortedDraws += i == 0 || sprites[i].textureIndex != sprites[i - 1].textureIndex;
+	}
+
+	SpriteBatch batch;
+	std::vector<SpriteBatch::Vertex> destination(static_cast<size_t>(kSpriteCount) * SpriteBatch::kVertexPerQuad);
+	double addMicroseconds = 0.0;
+	double buildMicroseconds = 0.0;
+	uint32_t quadCount = 0;
+	for (uint32_t frame = 0; frame < kFrameCount; ++frame) {
+		auto start = std::chrono::steady_clock::now();
+		batch.Clear();
+		for (const Sprite& sprite : sprites) {
+			SpriteBatch::Vertex vertices[SpriteBatch::kVertexPerQuad];
+			SpriteBatch::MakeQuad(sprite.world, { 0.5f, 0.5f }, false, false, { 0.0f, 0.0f }, { 1.0f, 1.0f }, vertices);
+			for (SpriteBatch::Vertex& vertex : vertices) {
+				vertex.color = { 1.0f, 1.0f, 1.0f, 1.0f };
+			}
+			batch.Add(sprite.layer, sprite.textureIndex, vertices);
+		}
+		auto middle = std::chrono::steady_clock::now();
+		quadCount = batch.Build(destination.data(), kSpriteCount);
+		auto end = std::chrono::steady_clock::now();
+		addMicroseconds += std::chrono::duration<double, std::micro>(middle - start).count();
+		buildMicroseconds += std::chrono::duration<double, std::micro>(end - middle).count();
+	}
+
+	std::printf("%u sprites (%u layers, %u textures) x %u frames\n", kSpriteCount, kLayerCount, kTextureCount, kFrameCount);
+	std::printf(" draws: unsorted %u, batched %zu (quads %u)\n", unsortedDraws, batch.GetDrawCommands().size(), quadCount);
+	std::printf(" MakeQuad+Add %.1f us/frame, Build (sort+copy+merge) %.1f us/frame, %.1f ns/sprite\n",
+		addMicroseconds / kFrameCount, buildMicroseconds / kFrameCount,
+		(addMicroseconds + buildMicroseconds) * 1000.0 / (static_cast<double>(kFrameCount) * kSpriteCount));
+	return 0;
+}
@@ -0,0 +1,175 @@
+// C++
+#include <cstdint>
+#include <vector>
+
+// Engine
+#include "SpriteBatch.h"
+
+// Test
+#include "TestCommon.h"
+
+namespace {
+
+	/// <summary>
+	/// 何番目に積んだかを色の r に入れたクアッド
+	/// </summary>
+	void AddTagged(SpriteBatch& batch, int32_t layer, uint32_t textureIndex, uint32_t tag)
+	{
+		SpriteBatch::Vertex vertices[SpriteBatch::kVertexPerQuad] = {};
+		for (SpriteBatch::Vertex& vertex : vertices) {
+			vertex.color = { static_cast<float>(tag), 0.0f, 0.0f, 1.0f };
+		}
+		batch.Add(layer, textureIndex, vertices);
+	}
+
+	/// <summary>
+	/// 書き出した順のタグを取り出す (4頂点とも同じタグであることも確かめる)
+	/// </summary>
+	std::vector<uint32_t> ReadTags(const std::vector<SpriteBatch::Vertex>& vertices, uint32_t quadCount)
+	{
+		std::vector<uint32_t> tags;
+		for (uint32_t i = 0; i < quadCount; ++i) {
+			const float tag = vertices[i * SpriteBatch::kVertexPerQuad].color.x;
+			for (uint32_t v = 1; v < SpriteBatch::kVertexPerQuad; ++v) {
+				CHECK(vertices[i * SpriteBatch::kVertexPerQuad + v].color.x == tag);
+			}
+			tags.push_back(static_cast<uint32_t>(tag));
+		}
+		return tags;
+	}
+
+	/// <summary>
+	/// レイヤー → テクスチャ → 積んだ順 に並ぶ (負のレイヤーは先)
+	/// </summary>
+	void TestSortOrder()
+	{
+		SpriteBatch batch;
+		AddTagged(batch, 1, 3, 0);
+		AddTagged(batch, 0, 5, 1);
+		AddTagged(batch, 0, 2, 2);
+		AddTagged(batch, -1, 9, 3);
+		AddTagged(batch, 0, 5, 4);
+		AddTagged(batch, 1, 3, 5);
+		AddTagged(batch, -40000, 0, 6);
+		CHECK(batch.GetQuadCount() == 7);
+
+		std::vector<SpriteBatch::Vertex> vertices(7 * SpriteBatch::kVertexPerQuad);
+		CHECK(batch.Build(vertices.data(), 7) == 7);
+		CHECK(ReadTags(vertices, 7) == std::vector<uint32_t>({ 6, 3, 2, 1, 4, 0, 5 }));
+	}
+
+	/// <summary>
+	/// 同じテクスチャが続く範囲だけが1回の描画にまとまる
+	/// </summary>
+	void TestMerge()
+	{
+		SpriteBatch batch;
+		// レイヤー0: テクスチャ 1,2,1  レイヤー1: テクスチャ 2,3
+		AddTagged(batch, 0, 1, 0);
+		AddTagged(batch, 0, 2, 1);
+		AddTagged(batch, 0, 1, 2);
+		AddTagged(batch, 1, 2, 3);
+		AddTagged(batch, 1, 3, 4);
+
+		std::vector<SpriteBatch::Vertex> vertices(5 * SpriteBatch::kVertexPerQuad);
+		CHECK(batch.Build(vertices.data(), 5) == 5);
+		const std::vector<SpriteBatch::DrawCommand>& commands = batch.GetDrawCommands();
+		CHECK(commands.size() == 3);
+		if (commands.size() == 3) {
+			// 同じレイヤーの同じテクスチャは積んだ順が離れていてもまとまる
+			CHECK(commands[0].textureIndex == 1 && commands[0].firstQuad == 0 && commands[0].quadCount == 2);
+			// レイヤーをまたいでも同じテクスチャが続けばまとまる
+			CHECK(commands[1].textureIndex == 2 && commands[1].firstQuad == 2 && commands[1].quadCount == 2);
+			CHECK(commands[2].textureIndex == 3 && commands[2].firstQuad == 4 && commands[2].quadCount == 1);
+		}
+		// レイヤー1 のテクスチャ3 が最後
+		CHECK(ReadTags(vertices, 5).back() == 4);
+
+		uint32_t total = 0;
+		for (const SpriteBatch::DrawCommand& command : commands) {
+			total += command.quadCount;
+		}
+		CHECK(total == 5);
+
+		// Clear すると次のフレームは空から
+		batch.Clear();
+		CHECK(batch.GetQuadCount() == 0);
+		CHECK(batch.GetDrawCommands().empty());
+		CHECK(batch.Build(vertices.data(), 5) == 0);
+	}
+
+	/// <summary>
+	/// 書き出し先が足りない時は並べ替えた後ろの分を捨てる
+	/// </summary>
+	void TestTruncate()
+	{
+		SpriteBatch batch;
+		for (uint32_t i = 0; i < 10; ++i) {
+			AddTagged(batch, static_cast<int32_t>(9 - i), i % 2, i);
+		}
+		std::vector<SpriteBatch::Vertex> vertices(4 * SpriteBatch::kVertexPerQuad);
+		CHECK(batch.Build(vertices.data(), 4) == 4);
+		CHECK(ReadTags(vertices, 4) == std::vector<uint32_t>({ 9, 8, 7, 6 }));
+		uint32_t total = 0;
+		for (const SpriteBatch::DrawCommand& command : batch.GetDrawCommands()) {
+			total += command.quadCount;
+			CHECK(command.firstQuad + command.quadCount <= 4);
+		}
+		CHECK(total == 4);
+	}
+
+	/// <summary>
+	/// 1クアッド = 2三角形のインデックス
+	/// </summary>
+	void TestQuadIndices()
+	{
+		std::vector<uint32_t> indices(2 * SpriteBatch::kIndexPerQuad);
+		SpriteBatch::WriteQuadIndices(indices.data(), 2);
+		CHECK(indices == std::vector<uint32_t>({ 0, 1, 2, 1, 3, 2, 4, 5, 6, 5, 7, 6 }));
+	}
+
+	/// <summary>
+	/// 頂点の組み立て: アンカー・反転・切り出し範囲
+	/// </summary>
+	void TestMakeQuad()
+	{
+		// 単位行列なら 0～1 の四角がそのまま出る
+		SpriteBatch::Vertex vertices[SpriteBatch::kVertexPerQuad] = {};
+		SpriteBatch::MakeQuad(MakeIdentity4x4(), { 0.0f, 0.0f }, false, false, { 0.25f, 0.5f }, { 0.75f, 1.0f }, vertices);
+		// 左下, 左上, 右下, 右上
+		CHECK(vertices[0].position.x == 0.0f && vertices[0].position.y == 1.0f && vertices[0].position.w == 1.0f);
+		CHECK(vertices[1].position.x == 0.0f && vertices[1].position.y == 0.0f);
+		CHECK(vertices[2].position.x == 1.0f && vertices[2].position.y == 1.0f);
+		CHECK(vertices[3].position.x == 1.0f && vertices[3].position.y == 0.0f);
+		CHECK(vertices[0].texcoord.x == 0.25f && vertices[0].texcoord.y == 1.0f);
+		CHECK(vertices[1].texcoord.x == 0.25f && vertices[1].texcoord.y == 0.5f);
+		CHECK(vertices[2].texcoord.x == 0.75f && vertices[2].texcoord.y == 1.0f);
+		CHECK(vertices[3].texcoord.x == 0.75f && vertices[3].texcoord.y == 0.5f);
+
+		// 中心アンカーで大きさ 100x50 を (200,100) に置く
+		const Matrix4x4 world = MakeScaleMatrix({ 100.0f, 50.0f, 1.0f }) * MakeTranslateMatrix({ 200.0f, 100.0f, 0.0f });
+		SpriteBatch::MakeQuad(world, { 0.5f, 0.5f }, false, false, { 0.0f, 0.0f }, { 1.0f, 1.0f }, vertices);
+		CHECK(vertices[1].position.x == 150.0f && vertices[1].position.y == 75.0f);
+		CHECK(vertices[2].position.x == 250.0f && vertices[2].position.y == 125.0f);
+
+		// 左右反転は位置だけ入れ替わり、切り出し範囲はそのまま
+		SpriteBatch::MakeQuad(world, { 0.5f, 0.5f }, true, false, { 0.0f, 0.0f }, { 1.0f, 1.0f }, vertices);
+		CHECK(vertices[1].position.x == 250.0f && vertices[1].position.y == 75.0f);
+		CHECK(vertices[1].texcoord.x == 0.0f);
+		// 上下反転
+		SpriteBatch::MakeQuad(world, { 0.5f, 0.5f }, false, true, { 0.0f, 0.0f }, { 1.0f, 1.0f }, vertices);
+		CHECK(vertices[1].position.x == 150.0f && vertices[1].position.y == 125.0f);
+		CHECK(vertices[1].texcoord.y == 0.0f);
+	}
+
+} // namespace
+
+int main()
+{
+	TestSortOrder();
+	TestMerge();
+	TestTruncate();
+	TestQuadIndices();
+	TestMakeQuad();
+	return Test::Finish("SpriteBatchTest");
+}
@@ -0,0 +1,179 @@
+// C++
+#include <cstdint>
+#include <vector>
+
+// Engine
+#include "InputEventState.h"
+
+// Test
+#include "TestCommon.h"
+
+namespace {
+
+	/// <summary>
+	/// ボタンの通し番号はキーボード・マウス・パッドの順に隙間なく並ぶ
+	/// </summary>
+	void TestButtonNumbers()
+	{
+		CHECK(InputEventState::KeyButton(255) + 1 == InputEventState::MouseButton(0));
+		CHECK(InputEventState::MouseButton(InputRecorder::kMouseButtonCount - 1) + 1 == InputEventState::PadButton(0, 0));
+		CHECK(InputEventState::PadButton(2, 12) < InputEventState::kButtonCount);
+		CHECK(InputEventState::PadButton(3, 15) == InputEventState::kButtonCount - 1);
+	}
+
+	/// <summary>
+	/// フレームの間の押す・離すと、イベントの時刻から出す押していた時間
+	/// </summary>
+	void TestEventsWithinFrame()
+	{
+		const uint16_t key = InputEventState::KeyButton(30);
+		const uint16_t mouse = InputEventState::MouseButton(1);
+		const uint16_t pad = InputEventState::PadButton(2, 12);
+
+		InputEventState state;
+		state.BeginFrame(1000);
+
+		// フレームの間に押して離した短い入力も残る
+		state.Apply({ 100, key, true });
+		state.Apply({ 400, key, false });
+		CHECK(!state.IsDown(key));
+		CHECK(state.IsHeldThisFrame(key));
+		CHECK(state.WasPressed(key));
+		CHECK(state.WasReleased(key));
+		CHECK(state.GetLastHoldDuration(key) == 300);
+
+		// 押しているのに押されたは無視
+		state.Apply({ 500, mouse, true });
+		state.Apply({ 600, mouse, true });
+		CHECK(state.GetPressCount(mouse) == 1);
+		CHECK(state.GetHoldDuration(mouse) == 500);
+		CHECK(state.GetPressTimestamp(mouse) == 500);
+
+		// 1フレームに何度も押せば回数が数えられる
+		state.Apply({ 700, key, true });
+		state.Apply({ 800, key, false });
+		state.Apply({ 900, key, true });
+		CHECK(state.GetPressCount(key) == 3);
+		CHECK(state.IsDown(key));
+
+		// 次のフレーム: 押した・離したは消え、押している時間はフレームの時刻まで
+		state.BeginFrame(2000);
+		CHECK(!state.WasPressed(key));
+		CHECK(state.IsHeldThisFrame(key));
+		CHECK(state.GetHoldDuration(key) == 1100);
+		CHECK(state.GetHoldDuration(mouse) == 1500);
+
+		// 押していないのに離されたは無視
+		state.Apply({ 2500, pad, false });
+		CHECK(!state.WasReleased(pad));
+
+		// フレームの時刻より後のイベントはフレームの時刻を進める
+		state.Apply({ 2600, mouse, false });
+		CHECK(state.WasReleased(mouse));
+		CHECK(state.GetLastHoldDuration(mouse) == 2100);
+		CHECK(state.GetFrameTimestamp() == 2600);
+		CHECK(state.GetHoldDuration(key) == 1700);
+		CHECK(state.GetPressTimestamp(mouse) == 0);
+
+		// 範囲外のボタンは無視
+		state.Apply({ 1, 60000, true });
+		CHECK(state.GetHoldDuration(60000) == 0);
+
+		state.Reset();
+		CHECK(!state.IsDown(key));
+		CHECK(state.GetFrameTimestamp() == 0);
+	}
+
+	/// <summary>
+	/// Diff: 変わったボタンだけを、キーボード・マウス・パッドの順に出す
+	/// </summary>
+	void TestDiff()
+	{
+		InputRecorder::Frame released;
+		InputRecorder::Frame pressed;
+		pressed.SetKeyDown(0, true);
+		pressed.SetKeyDown(255, true);
+		pressed.mouseButtons = 0x81;
+		pressed.pads[3].buttons = 0x8001;
+		// スティックはイベントにしない
+		pressed.pads[0].thumbLX = 100;
+
+		std::vector<InputEvent> events(InputEventState::kMaxDiffEvents);
+		uint32_t count = InputEventState::Diff(released, pressed, 7, events.data());
+		CHECK(count == 6);
+		CHECK(events[0].button == InputEventState::KeyButton(0));
+		CHECK(events[1].button == InputEventState::KeyButton(255));
+		CHECK(events[2].button == InputEventState::MouseButton(0));
+		CHECK(events[3].button == InputEventState::MouseButton(7));
+		CHECK(events[4].button == InputEventState::PadButton(3, 0));
+		CHECK(events[5].button == InputEventState::PadButton(3, 15));
+		bool allDown = true;
+		for (uint32_t i = 0; i < count; ++i) {
+			allDown = allDown && events[i].down && events[i].timestamp == 7;
+		}
+		CHECK(allDown);
+
+		count = InputEventState::Diff(pressed, released, 8, events.data());
+		CHECK(count == 6);
+		CHECK(!events[0].down);
+
+		CHECK(InputEventState::Diff(pressed, pressed, 9, events.data()) == 0);
+
+		// 全部変わっても kMaxDiffEvents に収まる
+		InputRecorder::Frame all;
+		all.keys.fill(0xFF);
+		all.mouseButtons = 0xFF;
+		for (InputRecorder::PadState& padState : all.pads) {
+			padState.buttons = 0xFFFF;
+		}
+		CHECK(InputEventState::Diff(released, all, 0, events.data()) == InputEventState::kMaxDiffEvents);
+	}
+
+	/// <summary>
+	/// Diff で出したイベントを流すと、元の入力と同じ押している状態になる
+	/// </summary>
+	void TestDiffRoundTrip()
+	{
+		InputRecorder::Frame previous;
+		InputRecorder::Frame current;
+		InputEventState state;
+		std::vector<InputEvent> events(InputEventState::kMaxDiffEvents);
+		uint32_t seed = 1;
+		bool matches = true;
+		for (int frame = 0; frame < 500; ++frame) {
+			for (int i = 0; i < 8; ++i) {
+				seed = seed * 1664525u + 1013904223u;
+				current.SetKeyDown(seed >> 24, ((seed >> 8) & 1) != 0);
+			}
+			current.mouseButtons = static_cast<uint8_t>(seed >> 3);
+			current.pads[1].buttons = static_cast<uint16_t>(seed >> 11);
+
+			state.BeginFrame(frame * 100);
+			const uint32_t count = InputEventState::Diff(previous, current, frame * 100 + 50, events.data());
+			for (uint32_t i = 0; i < count; ++i) {
+				state.Apply(events[i]);
+			}
+			for (uint32_t key = 0; key < InputRecorder::kKeyCount; ++key) {
+				matches = matches && state.IsDown(InputEventState::KeyButton(key)) == current.IsKeyDown(key);
+			}
+			for (uint32_t bit = 0; bit < InputRecorder::kMouseButtonCount; ++bit) {
+				matches = matches && state.IsDown(InputEventState::MouseButton(bit)) == (((current.mouseButtons >> bit) & 1) != 0);
+			}
+			for (uint32_t bit = 0; bit < InputEventState::kPadButtonCount; ++bit) {
+				matches = matches && state.IsDown(InputEventState::PadButton(1, bit)) == (((current.pads[1].buttons >> bit) & 1) != 0);
+			}
+			previous = current;
+		}
+		CHECK(matches);
+	}
+
+} // namespace
+
+int main()
+{
+	TestButtonNumbers();
+	TestEventsWithinFrame();
+	TestDiff();
+	TestDiffRoundTrip();
+	return Test::Finish("InputEventStateTest");
+}
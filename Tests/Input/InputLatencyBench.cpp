@@ -0,0 +1,175 @@
+// C++
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Engine
+#include "InputThread.h"
+#include "SpscQueue.h"
+
+namespace {
+
+	int64_t Now()
+	{
+		return InputEventState::GetTimestamp();
+	}
+
+	void SpinUntil(int64_t timestamp)
+	{
+		while (Now() < timestamp) {
+			std::this_thread::yield();
+		}
+	}
+
+	// 押して離した時刻 (ナノ秒)
+	struct Tap {
+		int64_t down;
+		int64_t up;
+	};
+
+	/// <summary>
+	/// 離した時に測った押していた時間と、一番近い本当の長さとの差 (ミリ秒)
+	/// </summary>
+	double HoldError(const std::vector<Tap>& taps, int64_t measured)
+	{
+		double best = 1e18;
+		for (const Tap& tap : taps) {
+			best = (std::min)(best, std::fabs(static_cast<double>((tap.up - tap.down) - measured)));
+		}
+		return best / 1e6;
+	}
+
+	double Percentile(std::vector<double> values, double p)
+	{
+		if (values.empty()) {
+			return 0.0;
+		}
+		std::sort(values.begin(), values.end());
+		return values[static_cast<size_t>(p * (values.size() - 1))];
+	}
+
+	/// <summary>
+	/// キューの受け渡しの速さ (2スレッド)
+	/// </summary>
+	void MeasureQueue()
+	{
+		constexpr uint64_t kCount = 5'000'000;
+		static SpscQueue<uint64_t, 1024> queue;
+		const auto start = std::chrono::steady_clock::now();
+		std::thread producer([] {
+			for (uint64_t i = 0; i < kCount;) {
+				if (queue.TryPush(i)) {
+					++i;
+				} else {
+					std::this_thread::yield();
+				}
+			}
+			});
+		uint64_t received = 0;
+		uint64_t value = 0;
+		while (received < kCount) {
+			if (queue.TryPop(value)) {
+				++received;
+			} else {
+				std::this_thread::yield();
+			}
+		}
+		producer.join();
+		const double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kCount;
+		std::printf("SpscQueue: %llu items across threads, %.1f ns/item\n", static_cast<unsigned long long>(kCount), nanoseconds);
+	}
+
+} // namespace
+
+/// <summary>
+/// 仮想のキーボードを決まった時刻に押して離し (1/3 は 11ms より短い)、
+/// 10フレームに1回 50ms の処理落ちが入る 60fps のゲームで、
+/// 入力スレッド (1kHz) とフレームごとに読む方式の、取りこぼしと押していた時間の誤差を比べる
+/// </summary>
+int main()
+{
+	MeasureQueue();
+
+	constexpr int kTapCount = 150;
+	std::mt19937 random(5);
+	std::vector<Tap> taps;
+	int64_t time = Now() + 20'000'000;
+	for (int i = 0; i < kTapCount; ++i) {
+		time += 20'000'000 + random() % 30'000'000;
+		const int64_t length = (i % 3 == 0) ? 3'000'000 + random() % 8'000'000 : 30'000'000 + random() % 200'000'000;
+		taps.push_back({ time, time + length });
+		time += length;
+	}
+	const int64_t end = time + 50'000'000;
+
+	std::atomic<bool> keyDown = false;
+	std::thread device([&] {
+		for (const Tap& tap : taps) {
+			SpinUntil(tap.down);
+			keyDown = true;
+			SpinUntil(tap.up);
+			keyDown = false;
+		}
+		});
+
+	InputThread thread;
+	thread.Start([&](InputRecorder::Frame& frame) { frame.SetKeyDown(30, keyDown.load()); }, 1000);
+	InputEventState state;
+	const uint16_t key = InputEventState::KeyButton(30);
+
+	int threadPresses = 0;
+	int pollPresses = 0;
+	bool polledDown = false;
+	int64_t polledPressTime = 0;
+	std::vector<double> threadErrors;
+	std::vector<double> pollErrors;
+	int frame = 0;
+	while (Now() < end) {
+		const int64_t frameStart = Now();
+
+		// 入力スレッドのイベントから
+		state.BeginFrame(Now());
+		InputEvent event;
+		while (thread.TryPopEvent(event)) {
+			state.Apply(event);
+		}
+		threadPresses += state.GetPressCount(key);
+		if (state.WasReleased(key)) {
+			threadErrors.push_back(HoldError(taps, state.GetLastHoldDuration(key)));
+		}
+
+		// フレームの頭で1回読む (以前の Input::Update と同じ)
+		const bool down = keyDown.load();
+		const int64_t pollTime = Now();
+		if (down && !polledDown) {
+			++pollPresses;
+			polledPressTime = pollTime;
+		}
+		if (!down && polledDown) {
+			pollErrors.push_back(HoldError(taps, pollTime - polledPressTime));
+		}
+		polledDown = down;
+
+		++frame;
+		SpinUntil(frameStart + ((frame % 10 == 0) ? 50'000'000 : 16'666'667));
+	}
+	device.join();
+	thread.Stop();
+
+	const InputThread::Stats stats = thread.GetStats();
+	std::printf("taps: %d (1/3 shorter than 11 ms), frames: %d with a 50 ms hitch every 10th\n", kTapCount, frame);
+	std::printf("  thread 1 kHz  : presses seen %d, hold error p50 %.2f ms p95 %.2f ms max %.2f ms\n",
+		threadPresses, Percentile(threadErrors, 0.5), Percentile(threadErrors, 0.95), Percentile(threadErrors, 1.0));
+	std::printf("  per-frame poll: presses seen %d, hold error p50 %.2f ms p95 %.2f ms max %.2f ms\n",
+		pollPresses, Percentile(pollErrors, 0.5), Percentile(pollErrors, 0.95), Percentile(pollErrors, 1.0));
+	std::printf("  thread stats  : polls %llu, events %llu, dropped %llu, max poll interval %.2f ms\n",
+		static_cast<unsigned long long>(stats.polls), static_cast<unsigned long long>(stats.events),
+		static_cast<unsigned long long>(stats.droppedEvents), stats.maxPollIntervalMs);
+	return 0;
+}
@@ -0,0 +1,151 @@
+// C++
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+// Engine
+#include "InputThread.h"
+
+// Test
+#include "TestCommon.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+	/// <summary>
+	/// スレッドが count 回読み終えるまで待つ (10秒で諦める)
+	/// </summary>
+	bool WaitForPolls(const InputThread& thread, uint64_t count)
+	{
+		for (int i = 0; i < 10000; ++i) {
+			if (thread.GetStats().polls >= count) {
+				return true;
+			}
+			std::this_thread::sleep_for(1ms);
+		}
+		return false;
+	}
+
+	uint32_t Drain(InputThread& thread, InputEventState& state)
+	{
+		uint32_t count = 0;
+		InputEvent event;
+		while (thread.TryPopEvent(event)) {
+			state.Apply(event);
+			++count;
+		}
+		return count;
+	}
+
+	uint32_t CountDownKeys(const InputEventState& state)
+	{
+		uint32_t count = 0;
+		for (uint32_t key = 0; key < InputRecorder::kKeyCount; ++key) {
+			count += state.IsDown(InputEventState::KeyButton(key)) ? 1 : 0;
+		}
+		return count;
+	}
+
+	/// <summary>
+	/// 読む処理が無い、頻度が0なら立てない
+	/// </summary>
+	void TestStartArguments()
+	{
+		InputThread thread;
+		CHECK(!thread.Start(nullptr, 1000));
+		CHECK(!thread.Start([](InputRecorder::Frame&) {}, 0));
+		CHECK(!thread.IsRunning());
+	}
+
+	/// <summary>
+	/// 1回の読み込みで変わったボタンが全部イベントになり、マウスの移動量は受け取るまで溜まる
+	/// </summary>
+	void TestEventsAndMouse()
+	{
+		InputThread thread;
+		std::atomic<bool> pressed = false;
+		std::atomic<int32_t> samples = 0;
+		CHECK(thread.Start([&](InputRecorder::Frame& frame) {
+			if (pressed) {
+				frame.keys.fill(0xFF);
+			}
+			frame.mouseMoveX = 1;
+			++samples;
+			}, 2000));
+
+		CHECK(WaitForPolls(thread, 5));
+		pressed = true;
+		CHECK(WaitForPolls(thread, thread.GetStats().polls + 5));
+
+		InputEventState state;
+		state.BeginFrame(InputEventState::GetTimestamp());
+		CHECK(Drain(thread, state) == InputRecorder::kKeyCount);
+		CHECK(CountDownKeys(state) == InputRecorder::kKeyCount);
+		CHECK(thread.GetLatest().IsKeyDown(128));
+
+		thread.Stop();
+		CHECK(!thread.IsRunning());
+		int32_t x = 0, y = 0, z = 0;
+		thread.TakeMouseMove(x, y, z);
+		CHECK(x == samples.load());
+		CHECK(y == 0 && z == 0);
+		CHECK(thread.GetStats().droppedEvents == 0);
+		CHECK(thread.GetStats().events == InputRecorder::kKeyCount);
+	}
+
+	/// <summary>
+	/// 読まれずにキューが溢れても、積めなかった変化は後で積み直され、最後は実際の状態にそろう
+	/// </summary>
+	void TestOverflowRecovers()
+	{
+		InputThread thread;
+		std::atomic<uint32_t> toggles = 0;
+		// 最初の 2000 回は全キーを押す・離すを繰り返し (1回 256 イベント)、その後は離したまま
+		CHECK(thread.Start([&](InputRecorder::Frame& frame) {
+			const uint32_t n = toggles.fetch_add(1);
+			frame.keys.fill((n < 2000 && n % 2 == 0) ? 0xFF : 0);
+			}, 5000));
+
+		CHECK(WaitForPolls(thread, 2100));
+		InputEventState state;
+		state.BeginFrame(InputEventState::GetTimestamp());
+		Drain(thread, state);
+		// 空いた所へ積み直されるのを待ってもう一度
+		CHECK(WaitForPolls(thread, thread.GetStats().polls + 10));
+		Drain(thread, state);
+
+		const InputThread::Stats stats = thread.GetStats();
+		thread.Stop();
+		CHECK(stats.droppedEvents > 0);
+		CHECK(CountDownKeys(state) == 0);
+	}
+
+	/// <summary>
+	/// 立て直すと前に読まれなかったイベントは捨てる
+	/// </summary>
+	void TestRestartDiscardsStale()
+	{
+		InputThread thread;
+		CHECK(thread.Start([](InputRecorder::Frame& frame) { frame.SetKeyDown(30, true); }, 2000));
+		CHECK(WaitForPolls(thread, 3));
+		thread.Stop();
+
+		CHECK(thread.Start([](InputRecorder::Frame&) {}, 2000));
+		CHECK(WaitForPolls(thread, thread.GetStats().polls + 3));
+		thread.Stop();
+		InputEvent event;
+		CHECK(!thread.TryPopEvent(event));
+	}
+
+} // namespace
+
+int main()
+{
+	TestStartArguments();
+	TestEventsAndMouse();
+	TestOverflowRecovers();
+	TestRestartDiscardsStale();
+	return Test::Finish("InputThreadTest");
+}
@@ -0,0 +1,78 @@
+// C++
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// Engine
+#include "SpscQueue.h"
+
+// Test
+#include "TestCommon.h"
+
+namespace {
+
+	/// <summary>
+	/// 1スレッドで: 満杯・空の判定と、リングを一周した後の順番
+	/// </summary>
+	void TestSingleThread()
+	{
+		SpscQueue<int, 4> queue;
+		int value = -1;
+		CHECK(!queue.TryPop(value));
+		for (int i = 0; i < 4; ++i) {
+			CHECK(queue.TryPush(i));
+		}
+		CHECK(!queue.TryPush(9));
+		CHECK(queue.GetSize() == 4);
+		CHECK(queue.GetCapacity() == 4);
+
+		CHECK(queue.TryPop(value) && value == 0);
+		CHECK(queue.TryPush(4));
+		for (int i = 1; i <= 4; ++i) {
+			CHECK(queue.TryPop(value) && value == i);
+		}
+		CHECK(!queue.TryPop(value));
+		CHECK(queue.GetSize() == 0);
+	}
+
+	/// <summary>
+	/// 2スレッドで: 書いた順に欠けも重複も無く届く
+	/// </summary>
+	void TestTwoThreads()
+	{
+		constexpr uint64_t kCount = 1'000'000;
+		static SpscQueue<uint64_t, 1024> queue;
+
+		std::thread producer([] {
+			for (uint64_t i = 0; i < kCount;) {
+				if (queue.TryPush(i)) {
+					++i;
+				} else {
+					std::this_thread::yield();
+				}
+			}
+			});
+		uint64_t expected = 0;
+		bool ordered = true;
+		uint64_t value = 0;
+		while (expected < kCount) {
+			if (queue.TryPop(value)) {
+				ordered = ordered && value == expected;
+				++expected;
+			} else {
+				std::this_thread::yield();
+			}
+		}
+		producer.join();
+		CHECK(ordered);
+		CHECK(queue.GetSize() == 0);
+	}
+
+} // namespace
+
+int main()
+{
+	TestSingleThread();
+	TestTwoThreads();
+	return Test::Finish("SpscQueueTest");
+}
@@ -0,0 +1,75 @@
+// C++
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Engine
+#include "AssetArchive.h"
+
+// Test
+#include "TestCommon.h"
+
+namespace {
+
+	/// <summary>
+	/// 中身を書いたファイルを作る (フォルダも作る)
+	/// </summary>
+	void WriteFile(const std::filesystem::path& path, const std::string& text)
+	{
+		std::filesystem::create_directories(path.parent_path());
+		std::ofstream file(path, std::ios::binary);
+		file << text;
+	}
+
+	/// <summary>
+	/// 除外したフォルダ (実行時に作り直すキャッシュ) は中身ごとアーカイブに入らず、他はすべて入る
+	/// </summary>
+	void TestExcludeDirectories(const std::filesystem::path& root)
+	{
+		const std::filesystem::path resources = root / "Resources";
+		WriteFile(resources / "Textures/player.png", "png");
+		WriteFile(resources / "Models/cube/cube.obj", "obj");
+		WriteFile(resources / "Atlas/AtlasManifest.json", "{}");
+		WriteFile(resources / "Atlas/Atlas_0.png", "page");
+		WriteFile(resources / "Cooked/Textures/player.dds", "dds");
+		WriteFile(resources / "Cooked/Models/0123.lod", "lod");
+		// 名前が除外フォルダで始まるだけの別フォルダは入る
+		WriteFile(resources / "AtlasSource/icon.png", "icon");
+
+		const std::string archivePath = (resources / "Cooked/Resources.pak").generic_string();
+		AssetArchive::BuildStats stats;
+		// 大文字小文字の違いは無視する
+		CHECK(AssetArchive::Build(resources.generic_string(), archivePath, &stats,
+			{ (resources / "Cooked").generic_string(), (resources / "atlas").generic_string() }));
+		CHECK(stats.fileCount == 3);
+		CHECK(stats.excludedDirectoryCount == 2);
+
+		AssetArchive archive;
+		CHECK(archive.Open(archivePath));
+		CHECK(archive.GetEntryCount() == 3);
+		CHECK(archive.Find((resources / "Textures/player.png").generic_string()) != nullptr);
+		CHECK(archive.Find((resources / "Models/cube/cube.obj").generic_string()) != nullptr);
+		CHECK(archive.Find((resources / "AtlasSource/icon.png").generic_string()) != nullptr);
+		CHECK(archive.Find((resources / "Atlas/AtlasManifest.json").generic_string()) == nullptr);
+		CHECK(archive.Find((resources / "Atlas/Atlas_0.png").generic_string()) == nullptr);
+		CHECK(archive.Find((resources / "Cooked/Textures/player.dds").generic_string()) == nullptr);
+		CHECK(archive.Find((resources / "Cooked/Models/0123.lod").generic_string()) == nullptr);
+		archive.Close();
+
+		// 除外しなければキャッシュも入る (出力先の .pak は除く)
+		CHECK(AssetArchive::Build(resources.generic_string(), archivePath, &stats));
+		CHECK(stats.fileCount == 7);
+		CHECK(stats.excludedDirectoryCount == 0);
+	}
+
+} // namespace
+
+int main()
+{
+	const std::filesystem::path root = std::filesystem::temp_directory_path() / "YoRigineAssetArchiveTest";
+	std::filesystem::remove_all(root);
+	TestExcludeDirectories(root);
+	std::filesystem::remove_all(root);
+	return Test::Finish("AssetArchiveTest");
+}
@@ -0,0 +1,54 @@
+// C++
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+// Engine
+#include "MeshLodCache.h"
+#include "MeshOptimizer.h"
+
+// Test
+#include "ObjMesh.h"
+
+/// <summary>
+/// Resources/Models の OBJ ごとに、読み込み時のLOD生成 (キャッシュなし) とキャッシュからの読み込みの時間を比べる
+/// </summary>
+int main()
+{
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "YoRigineMeshLodCacheBench";
+	std::filesystem::remove_all(directory);
+
+	std::vector<ObjMesh::Mesh> meshes = ObjMesh::LoadAll();
+	double generateTotal = 0.0;
+	double cachedTotal = 0.0;
+	std::printf("%-24s %9s %5s %12s %12s\n", "model", "triangles", "lods", "generate ms", "cached ms");
+	for (ObjMesh::Mesh& mesh : meshes) {
+		// Model と同じく最適化してからLODを作る
+		MeshOptimizer::Optimize(mesh.vertices, mesh.indices);
+
+		std::vector<MeshSimplifier::Lod> lods;
+		std::vector<uint32_t> lodIndices;
+		const MeshLodCache::Result miss = MeshLodCache::Load(mesh.vertices, mesh.indices, lods, lodIndices, directory.generic_string());
+		// 2回目以降 (読むだけ) は短いので数回の平均
+		constexpr int kRepeatCount = 10;
+		float cachedMs = 0.0f;
+		bool allHit = true;
+		for (int i = 0; i < kRepeatCount; ++i) {
+			const MeshLodCache::Result hit = MeshLodCache::Load(mesh.vertices, mesh.indices, lods, lodIndices, directory.generic_string());
+			cachedMs += hit.elapsedMs;
+			allHit = allHit && hit.cacheHit;
+		}
+		cachedMs /= kRepeatCount;
+
+		std::printf("%-24s %9zu %5zu %12.2f %12.3f%s\n", mesh.name.c_str(), mesh.indices.size() / 3, lods.size(),
+			miss.elapsedMs, cachedMs, (!miss.cacheHit && allHit) ? "" : "  (unexpected cache state)");
+		generateTotal += miss.elapsedMs;
+		cachedTotal += cachedMs;
+	}
+	std::printf("%zu models: generate %.1f ms total, cached %.2f ms total\n", meshes.size(), generateTotal, cachedTotal);
+
+	std::filesystem::remove_all(directory);
+	return 0;
+}
@@ -0,0 +1,141 @@
+// C++
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+// Engine
+#include "MeshLodCache.h"
+
+// Test
+#include "ObjMesh.h"
+#include "TestCommon.h"
+
+namespace {
+
+	using Vertex = ObjMesh::Vertex;
+
+	/// <summary>
+	/// 波打った n × n マスの格子 (簡略化でLODが作れる形)
+	/// </summary>
+	void MakeWavyGrid(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, uint32_t n)
+	{
+		for (uint32_t y = 0; y <= n; ++y) {
+			for (uint32_t x = 0; x <= n; ++x) {
+				const float height = 0.5f * std::sin(x * 0.2f) * std::cos(y * 0.2f);
+				vertices.push_back({ { static_cast<float>(x), height, static_cast<float>(y), 1.0f }, { static_cast<float>(x) / n, static_cast<float>(y) / n }, Vector3(0.0f, 1.0f, 0.0f) });
+			}
+		}
+		for (uint32_t y = 0; y < n; ++y) {
+			for (uint32_t x = 0; x < n; ++x) {
+				const uint32_t a = y * (n + 1) + x, b = a + 1, c = a + n + 1, d = c + 1;
+				indices.insert(indices.end(), { a, c, b, b, c, d });
+			}
+		}
+	}
+
+	bool SameLods(const std::vector<MeshSimplifier::Lod>& a, const std::vector<MeshSimplifier::Lod>& b)
+	{
+		if (a.size() != b.size()) {
+			return false;
+		}
+		for (size_t i = 0; i < a.size(); ++i) {
+			if (a[i].indexOffset != b[i].indexOffset || a[i].indexCount != b[i].indexCount || a[i].error != b[i].error) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// 初回は作って書き出し、2回目は同じ結果を読むだけ。メッシュが変われば作り直す
+	/// </summary>
+	void TestRoundTrip(const std::string& directory)
+	{
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+		MakeWavyGrid(vertices, indices, 48);
+
+		std::vector<MeshSimplifier::Lod> generated;
+		std::vector<uint32_t> generatedIndices;
+		const MeshLodCache::Result first = MeshLodCache::Load(vertices, indices, generated, generatedIndices, directory);
+		CHECK(!first.cacheHit);
+		CHECK(generated.size() >= 2);
+
+		// 直接作ったものと同じ
+		std::vector<uint32_t> directIndices;
+		const std::vector<MeshSimplifier::Lod> direct = MeshSimplifier::GenerateLods(vertices, indices, directIndices);
+		CHECK(SameLods(generated, direct));
+		CHECK(generatedIndices == directIndices);
+
+		std::vector<MeshSimplifier::Lod> cached;
+		std::vector<uint32_t> cachedIndices;
+		const MeshLodCache::Result second = MeshLodCache::Load(vertices, indices, cached, cachedIndices, directory);
+		CHECK(second.cacheHit);
+		CHECK(SameLods(cached, generated));
+		CHECK(cachedIndices == generatedIndices);
+
+		// 頂点が1つ動けば別のキャッシュ
+		vertices[100].position.y += 0.25f;
+		const MeshLodCache::Result changed = MeshLodCache::Load(vertices, indices, cached, cachedIndices, directory);
+		CHECK(!changed.cacheHit);
+		CHECK(MeshLodCache::Load(vertices, indices, cached, cachedIndices, directory).cacheHit);
+	}
+
+	/// <summary>
+	/// 壊れた・合わないキャッシュは読まずに作り直して上書きする
+	/// </summary>
+	void TestRejectBrokenCache(const std::string& directory)
+	{
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+		MakeWavyGrid(vertices, indices, 24);
+		const std::string path = MeshLodCache::GetCachePath(
+			MeshLodCache::HashMesh(vertices.data(), vertices.size() * sizeof(Vertex), indices), directory);
+
+		std::vector<MeshSimplifier::Lod> lods;
+		std::vector<uint32_t> lodIndices;
+		MeshLodCache::Load(vertices, indices, lods, lodIndices, directory);
+		CHECK(std::filesystem::exists(path));
+		const uint32_t indexCount = static_cast<uint32_t>(indices.size());
+		const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+		CHECK(MeshLodCache::Read(path, indexCount, vertexCount, lods, lodIndices));
+
+		// 別のメッシュの大きさでは読まない
+		CHECK(!MeshLodCache::Read(path, indexCount + 3, vertexCount, lods, lodIndices));
+		CHECK(!MeshLodCache::Read(path, indexCount, 10, lods, lodIndices));
+
+		// 途中で切れたファイル
+		std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+		CHECK(!MeshLodCache::Read(path, indexCount, vertexCount, lods, lodIndices));
+		CHECK(!MeshLodCache::Load(vertices, indices, lods, lodIndices, directory).cacheHit);
+		CHECK(MeshLodCache::Read(path, indexCount, vertexCount, lods, lodIndices));
+
+		// 先頭が違うファイル
+		{
+			std::ofstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+			file.write("XXXX", 4);
+		}
+		CHECK(!MeshLodCache::Read(path, indexCount, vertexCount, lods, lodIndices));
+		CHECK(!MeshLodCache::Load(vertices, indices, lods, lodIndices, directory).cacheHit);
+		CHECK(MeshLodCache::Load(vertices, indices, lods, lodIndices, directory).cacheHit);
+
+		// 無いファイル
+		CHECK(!MeshLodCache::Read(directory + "/missing.lod", indexCount, vertexCount, lods, lodIndices));
+	}
+
+} // namespace
+
+int main()
+{
+	// 書き出し先はテストごとに空から
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "YoRigineMeshLodCacheTest";
+	std::filesystem::remove_all(directory);
+
+	TestRoundTrip(directory.generic_string());
+	TestRejectBrokenCache(directory.generic_string());
+
+	std::filesystem::remove_all(directory);
+	return Test::Finish("MeshLodCacheTest");
+}
@@ -0,0 +1,220 @@
+// C++
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+// Engine
+#include "MeshOptimizer.h"
+
+// Test
+#include "ObjMesh.h"
+#include "TestCommon.h"
+
+namespace {
+
+	using Vertex = ObjMesh::Vertex;
+	static_assert(sizeof(Vertex) == 36);
+
+	// 頂点のバイト列 (比較用)
+	using VertexKey = std::array<uint32_t, sizeof(Vertex) / 4>;
+
+	VertexKey GetKey(const Vertex& vertex)
+	{
+		VertexKey key;
+		std::memcpy(key.data(), &vertex, sizeof(Vertex));
+		return key;
+	}
+
+	/// <summary>
+	/// 三角形の集合 (回転をそろえて向きは保つ)
+	/// </summary>
+	std::multiset<std::array<VertexKey, 3>> GetTriangles(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
+	{
+		std::multiset<std::array<VertexKey, 3>> triangles;
+		for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+			const std::array<VertexKey, 3> corners = { GetKey(vertices[indices[i]]), GetKey(vertices[indices[i + 1]]), GetKey(vertices[indices[i + 2]]) };
+			std::array<VertexKey, 3> best = corners;
+			for (int r = 1; r < 3; ++r) {
+				const std::array<VertexKey, 3> rotated = { corners[r], corners[(r + 1) % 3], corners[(r + 2) % 3] };
+				best = (std::min)(best, rotated);
+			}
+			triangles.insert(best);
+		}
+		return triangles;
+	}
+
+	/// <summary>
+	/// 緯度経度の球を、三角形ごとに頂点を持つ形 (読み込み直後と同じ) で作り、三角形の順番を混ぜる
+	/// </summary>
+	ObjMesh::Mesh MakeSphere(uint32_t rings, uint32_t segments)
+	{
+		auto point = [&](uint32_t ring, uint32_t segment) {
+			const float theta = 3.14159265f * ring / rings;
+			const float phi = 2.0f * 3.14159265f * (segment % segments) / segments;
+			const Vector3 n(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+			return Vertex{ { n.x, n.y, n.z, 1.0f }, { static_cast<float>(segment) / segments, static_cast<float>(ring) / rings }, n };
+		};
+
+		std::vector<std::array<Vertex, 3>> triangles;
+		for (uint32_t ring = 0; ring < rings; ++ring) {
+			for (uint32_t segment = 0; segment < segments; ++segment) {
+				const Vertex a = point(ring, segment), b = point(ring, segment + 1);
+				const Vertex c = point(ring + 1, segment), d = point(ring + 1, segment + 1);
+				triangles.push_back({ a, b, c });
+				triangles.push_back({ c, b, d });
+			}
+		}
+		std::mt19937 random(41);
+		std::shuffle(triangles.begin(), triangles.end(), random);
+
+		ObjMesh::Mesh mesh;
+		mesh.name = "sphere";
+		for (const auto& triangle : triangles) {
+			for (const Vertex& vertex : triangle) {
+				mesh.indices.push_back(static_cast<uint32_t>(mesh.vertices.size()));
+				mesh.vertices.push_back(vertex);
+			}
+		}
+		return mesh;
+	}
+
+	/// <summary>
+	/// 最適化しても同じ三角形が残り、頂点は重複せず、最初に使われる順に並ぶ
+	/// </summary>
+	void CheckOptimizedMesh(const ObjMesh::Mesh& source, uint32_t expectedVertexCount)
+	{
+		std::vector<Vertex> vertices = source.vertices;
+		std::vector<uint32_t> indices = source.indices;
+		std::vector<uint32_t> remap;
+		const MeshOptimizer::Report report = MeshOptimizer::Optimize(vertices, indices, &remap);
+
+		CHECK(report.vertexCountBefore == source.vertices.size());
+		CHECK(report.vertexCountAfter == vertices.size());
+		CHECK(report.triangleCount * 3 == indices.size());
+		CHECK(GetTriangles(source.vertices, source.indices) == GetTriangles(vertices, indices));
+
+		std::set<VertexKey> unique;
+		for (const Vertex& vertex : source.vertices) {
+			unique.insert(GetKey(vertex));
+		}
+		CHECK(vertices.size() == unique.size());
+		if (expectedVertexCount > 0) {
+			CHECK(vertices.size() == expectedVertexCount);
+		}
+
+		uint32_t next = 0;
+		bool fetchOrder = true;
+		for (uint32_t index : indices) {
+			fetchOrder = fetchOrder && index <= next;
+			next += index == next;
+		}
+		CHECK(fetchOrder && next == vertices.size());
+
+		bool remapMatches = remap.size() == source.vertices.size();
+		for (uint32_t i = 0; remapMatches && i < remap.size(); ++i) {
+			remapMatches = remap[i] != MeshOptimizer::kUnused && GetKey(vertices[remap[i]]) == GetKey(source.vertices[i]);
+		}
+		CHECK(remapMatches);
+
+		// オーバードローの並べ替えで少し戻ることはあるが、閾値より悪くはならない
+		CHECK(report.after.acmr <= report.before.acmr * MeshOptimizer::kOverdrawThreshold + 1e-4f);
+		CHECK(report.after.atvr >= 1.0f - 1e-4f);
+
+		std::printf("  %-24s %7u -> %6u vertices %6u triangles  ACMR %.3f -> %.3f  ATVR %.3f -> %.3f\n", source.name.c_str(),
+			report.vertexCountBefore, report.vertexCountAfter, report.triangleCount, report.before.acmr, report.after.acmr, report.before.atvr, report.after.atvr);
+	}
+
+	/// <summary>
+	/// FIFO キャッシュの解析
+	/// </summary>
+	void TestAnalyzeVertexCache()
+	{
+		// 辺を共有する2つの三角形: 4頂点を1回ずつ
+		const MeshOptimizer::CacheStats quad = MeshOptimizer::AnalyzeVertexCache({ 0, 1, 2, 2, 1, 3 }, 4);
+		CHECK(std::fabs(quad.acmr - 2.0f) < 1e-6f);
+		CHECK(std::fabs(quad.atvr - 1.0f) < 1e-6f);
+
+		// キャッシュが3つなら、同じ頂点も押し出されれば読み直す
+		const MeshOptimizer::CacheStats evicted = MeshOptimizer::AnalyzeVertexCache({ 0, 1, 2, 3, 4, 5, 0, 1, 2 }, 6, 3);
+		CHECK(std::fabs(evicted.acmr - 3.0f) < 1e-6f);
+		CHECK(std::fabs(evicted.atvr - 1.5f) < 1e-6f);
+	}
+
+	/// <summary>
+	/// 球: 継ぎ目 (経度0と1) と極は texcoord が違うので別の頂点のまま残る
+	/// </summary>
+	void TestSphere()
+	{
+		constexpr uint32_t kRings = 24, kSegments = 32;
+		const ObjMesh::Mesh sphere = MakeSphere(kRings, kSegments);
+		CheckOptimizedMesh(sphere, (kRings + 1) * (kSegments + 1));
+	}
+
+	/// <summary>
+	/// 別のジョイントに付いた頂点はバイトが同じでもまとめない
+	/// </summary>
+	void TestInfluenceClasses()
+	{
+		struct Weight {
+			float weight;
+			uint32_t vertexIndex;
+		};
+
+		// バイトが同じ四角形を2つ、1つ目はジョイントA、2つ目はジョイントB
+		std::vector<Vertex> vertices;
+		for (int quad = 0; quad < 2; ++quad) {
+			for (int i = 0; i < 4; ++i) {
+				vertices.push_back({ { static_cast<float>(i & 1), static_cast<float>(i >> 1), 0.0f, 1.0f }, { 0.0f, 0.0f }, Vector3(0.0f, 0.0f, 1.0f) });
+			}
+		}
+		std::vector<Weight> jointA = { { 1.0f, 0 }, { 1.0f, 1 }, { 1.0f, 2 }, { 1.0f, 3 } };
+		std::vector<Weight> jointB = { { 1.0f, 4 }, { 1.0f, 5 }, { 1.0f, 6 }, { 1.0f, 7 } };
+		const std::vector<const std::vector<Weight>*> jointWeights = { &jointA, &jointB };
+
+		const std::vector<uint32_t> classes = MeshOptimizer::ClassifyVertexInfluences(jointWeights, 8);
+		CHECK(classes[0] == classes[3] && classes[4] == classes[7] && classes[0] != classes[4]);
+
+		std::vector<uint32_t> remap;
+		CHECK(MeshOptimizer::GenerateWeldRemap(remap, vertices.data(), 8, sizeof(Vertex), classes.data()) == 8);
+		CHECK(MeshOptimizer::GenerateWeldRemap(remap, vertices.data(), 8, sizeof(Vertex)) == 4);
+
+		// 同じジョイントに同じ重みで付いた重複はまとめ、重みは代表の1組だけ残す
+		std::vector<Weight> shared = { { 0.5f, 0 }, { 0.5f, 1 }, { 0.5f, 4 }, { 0.5f, 5 } };
+		const std::vector<const std::vector<Weight>*> sharedWeights = { &shared };
+		const std::vector<uint32_t> sharedClasses = MeshOptimizer::ClassifyVertexInfluences(sharedWeights, 8);
+		const uint32_t count = MeshOptimizer::GenerateWeldRemap(remap, vertices.data(), 8, sizeof(Vertex), sharedClasses.data());
+		CHECK(count == 4);
+		MeshOptimizer::RemapVertexWeights(shared, remap, count);
+		CHECK(shared.size() == 2);
+		CHECK(shared.size() == 2 && shared[0].vertexIndex == remap[0] && shared[1].vertexIndex == remap[1]);
+	}
+
+	/// <summary>
+	/// Resources/Models の OBJ
+	/// </summary>
+	void TestResourceModels()
+	{
+		const std::vector<ObjMesh::Mesh> meshes = ObjMesh::LoadAll();
+		CHECK(!meshes.empty());
+		for (const ObjMesh::Mesh& mesh : meshes) {
+			CheckOptimizedMesh(mesh, 0);
+		}
+	}
+
+} // namespace
+
+int main()
+{
+	TestAnalyzeVertexCache();
+	TestSphere();
+	TestInfluenceClasses();
+	TestResourceModels();
+	return Test::Finish("MeshOptimizerTest");
+}
@@ -0,0 +1,397 @@
+// C++
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <set>
+#include <vector>
+
+// Engine
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+
+// Math
+#include "MathFunc.h"
+#include "Vector3.h"
+
+// Test
+#include "ObjMesh.h"
+#include "TestCommon.h"
+
+using namespace MeshSimplifier;
+
+namespace {
+
+	using Vertex = ObjMesh::Vertex;
+
+	constexpr float kPi = 3.14159265358979f;
+
+	Vector3 GetPosition(const Vertex& vertex) { return Vector3(vertex.position.x, vertex.position.y, vertex.position.z); }
+
+	/// <summary>
+	/// 点と三角形の距離 (Ericson, Real-Time Collision Detection 5.1.5)
+	/// </summary>
+	float PointTriangleDistance(const Vector3& p, const Vector3& a, const Vector3& b, const Vector3& c)
+	{
+		auto distance = [&](const Vector3& q) { const Vector3 d = Subtract(p, q); return std::sqrt(Dot(d, d)); };
+		auto lerp = [](const Vector3& from, const Vector3& delta, float t) { return Vector3(from.x + delta.x * t, from.y + delta.y * t, from.z + delta.z * t); };
+
+		const Vector3 ab = Subtract(b, a), ac = Subtract(c, a), ap = Subtract(p, a);
+		const float d1 = Dot(ab, ap), d2 = Dot(ac, ap);
+		if (d1 <= 0.0f && d2 <= 0.0f) {
+			return distance(a);
+		}
+		const Vector3 bp = Subtract(p, b);
+		const float d3 = Dot(ab, bp), d4 = Dot(ac, bp);
+		if (d3 >= 0.0f && d4 <= d3) {
+			return distance(b);
+		}
+		const float vc = d1 * d4 - d3 * d2;
+		if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+			return distance(lerp(a, ab, d1 / (d1 - d3)));
+		}
+		const Vector3 cp = Subtract(p, c);
+		const float d5 = Dot(ab, cp), d6 = Dot(ac, cp);
+		if (d6 >= 0.0f && d5 <= d6) {
+			return distance(c);
+		}
+		const float vb = d5 * d2 - d1 * d6;
+		if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+			return distance(lerp(a, ac, d2 / (d2 - d6)));
+		}
+		const float va = d3 * d6 - d5 * d4;
+		if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+			return distance(lerp(b, Subtract(c, b), (d4 - d3) / ((d4 - d3) + (d5 - d6))));
+		}
+		const float denominator = 1.0f / (va + vb + vc);
+		const float v = vb * denominator, w = vc * denominator;
+		return distance(Vector3(a.x + ab.x * v + ac.x * w, a.y + ab.y * v + ac.y * w, a.z + ab.z * v + ac.z * w));
+	}
+
+	float DistanceToMesh(const Vector3& p, const std::vector<Vertex>& vertices, const uint32_t* indices, uint32_t indexCount)
+	{
+		float best = 1e30f;
+		for (uint32_t i = 0; i < indexCount; i += 3) {
+			best = (std::min)(best, PointTriangleDistance(p, GetPosition(vertices[indices[i]]), GetPosition(vertices[indices[i + 1]]), GetPosition(vertices[indices[i + 2]])));
+		}
+		return best;
+	}
+
+	/// <summary>
+	/// 元のメッシュとLODの間の、頂点と三角形の重心で測った両方向のハウスドルフ距離
+	/// </summary>
+	float MeasureDeviation(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& base, const uint32_t* lod, uint32_t lodCount, uint32_t step)
+	{
+		float deviation = 0.0f;
+		std::vector<uint8_t> used(vertices.size(), 0);
+		for (uint32_t index : base) {
+			used[index] = 1;
+		}
+		for (uint32_t i = 0; i < vertices.size(); i += step) {
+			if (used[i]) {
+				deviation = (std::max)(deviation, DistanceToMesh(GetPosition(vertices[i]), vertices, lod, lodCount));
+			}
+		}
+		for (uint32_t i = 0; i < lodCount; i += 3 * step) {
+			const Vector3 a = GetPosition(vertices[lod[i]]), b = GetPosition(vertices[lod[i + 1]]), c = GetPosition(vertices[lod[i + 2]]);
+			const Vector3 center((a.x + b.x + c.x) / 3.0f, (a.y + b.y + c.y) / 3.0f, (a.z + b.z + c.z) / 3.0f);
+			deviation = (std::max)(deviation, DistanceToMesh(center, vertices, base.data(), static_cast<uint32_t>(base.size())));
+		}
+		return deviation;
+	}
+
+	/// <summary>
+	/// 位置で見て閉じているか (全ての辺に逆向きの辺が同じ数だけある)
+	/// </summary>
+	bool IsClosed(const std::vector<Vertex>& vertices, const uint32_t* indices, uint32_t indexCount)
+	{
+		std::map<std::array<float, 3>, uint32_t> ids;
+		auto id = [&](uint32_t i) {
+			const std::array<float, 3> key = { vertices[i].position.x, vertices[i].position.y, vertices[i].position.z };
+			return ids.emplace(key, static_cast<uint32_t>(ids.size())).first->second;
+		};
+		std::map<std::pair<uint32_t, uint32_t>, int32_t> edges;
+		for (uint32_t i = 0; i < indexCount; i += 3) {
+			const uint32_t corner[3] = { id(indices[i]), id(indices[i + 1]), id(indices[i + 2]) };
+			for (int k = 0; k < 3; ++k) {
+				++edges[{ corner[k], corner[(k + 1) % 3] }];
+				--edges[{ corner[(k + 1) % 3], corner[k] }];
+			}
+		}
+		return std::all_of(edges.begin(), edges.end(), [](const auto& edge) { return edge.second == 0; });
+	}
+
+	double CalculateArea(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
+	{
+		double area = 0.0;
+		for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+			const Vector3 a = GetPosition(vertices[indices[i]]);
+			const Vector3 n = Cross(Subtract(GetPosition(vertices[indices[i + 1]]), a), Subtract(GetPosition(vertices[indices[i + 2]]), a));
+			area += std::sqrt(Dot(n, n)) * 0.5;
+		}
+		return area;
+	}
+
+	/// <summary>
+	/// 緯度経度の球 (経度0と1の継ぎ目で頂点が重なり、極は1点に集まる)
+	/// </summary>
+	void MakeSphere(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, uint32_t segments, uint32_t rings)
+	{
+		for (uint32_t ring = 0; ring <= rings; ++ring) {
+			for (uint32_t segment = 0; segment <= segments; ++segment) {
+				const float theta = kPi * ring / rings;
+				const float phi = segment == segments ? 0.0f : 2.0f * kPi * segment / segments;
+				Vector3 n(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+				if (ring == 0 || ring == rings) {
+					n.x = 0.0f;
+					n.z = 0.0f;
+				}
+				vertices.push_back({ { n.x, n.y, n.z, 1.0f }, { static_cast<float>(segment) / segments, static_cast<float>(ring) / rings }, n });
+			}
+		}
+		for (uint32_t ring = 0; ring < rings; ++ring) {
+			for (uint32_t segment = 0; segment < segments; ++segment) {
+				const uint32_t a = ring * (segments + 1) + segment, b = a + 1, c = a + segments + 1, d = c + 1;
+				if (ring != 0) {
+					indices.insert(indices.end(), { a, b, c });
+				}
+				if (ring != rings - 1) {
+					indices.insert(indices.end(), { b, d, c });
+				}
+			}
+		}
+	}
+
+	/// <summary>
+	/// XZ 平面の n × n マスの格子 (上向き)
+	/// </summary>
+	void MakeGrid(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, uint32_t n)
+	{
+		for (uint32_t y = 0; y <= n; ++y) {
+			for (uint32_t x = 0; x <= n; ++x) {
+				vertices.push_back({ { static_cast<float>(x), 0.0f, static_cast<float>(y), 1.0f }, { static_cast<float>(x) / n, static_cast<float>(y) / n }, Vector3(0.0f, 1.0f, 0.0f) });
+			}
+		}
+		for (uint32_t y = 0; y < n; ++y) {
+			for (uint32_t x = 0; x < n; ++x) {
+				const uint32_t a = y * (n + 1) + x, b = a + 1, c = a + n + 1, d = c + 1;
+				indices.insert(indices.end(), { a, c, b, b, c, d });
+			}
+		}
+	}
+
+	/// <summary>
+	/// 閉じた球: LODも閉じたままで、測った形のずれは申告した誤差と LOD の予算に収まる
+	/// </summary>
+	void TestClosedSphere()
+	{
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+		MakeSphere(vertices, indices, 64, 32);
+		MeshOptimizer::Optimize(vertices, indices);
+		CHECK(IsClosed(vertices, indices.data(), static_cast<uint32_t>(indices.size())));
+
+		std::vector<uint32_t> lodIndices;
+		const std::vector<Lod> lods = GenerateLods(vertices, indices, lodIndices);
+		std::vector<uint32_t> all = indices;
+		all.insert(all.end(), lodIndices.begin(), lodIndices.end());
+
+		const float extent = CalculateExtent(&vertices[0].position.x, sizeof(Vertex), static_cast<uint32_t>(vertices.size()));
+		CHECK(std::fabs(extent - 2.0f) < 1e-4f);
+		CHECK(lods.size() >= 3);
+		std::printf("sphere:");
+		for (size_t i = 0; i < lods.size(); ++i) {
+			const Lod& lod = lods[i];
+			const float deviation = MeasureDeviation(vertices, indices, all.data() + lod.indexOffset, lod.indexCount, 1);
+			std::printf(" %u (error %.4f, measured %.4f)", lod.indexCount / 3, lod.error, deviation);
+			CHECK(IsClosed(vertices, all.data() + lod.indexOffset, lod.indexCount));
+			if (i == 0) {
+				continue;
+			}
+			CHECK(lod.indexCount < lods[i - 1].indexCount);
+			CHECK(lod.error >= lods[i - 1].error);
+			CHECK(lod.error <= kLodTargetError * extent * 1.0001f);
+			// 二次誤差は距離の見積りなので、測ったずれはその定数倍に収まる
+			CHECK(deviation <= kLodTargetError * extent * 1.5f);
+			CHECK(deviation <= lod.error * 2.0f + 1e-4f);
+		}
+		std::printf("\n");
+		CHECK(std::all_of(lodIndices.begin(), lodIndices.end(), [&](uint32_t index) { return index < vertices.size(); }));
+	}
+
+	/// <summary>
+	/// 平らな格子: 誤差0のまま大きく減らせ、面積・四隅・向きが保たれる
+	/// </summary>
+	void TestFlatGrid()
+	{
+		constexpr uint32_t kSize = 32;
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+		MakeGrid(vertices, indices, kSize);
+
+		float error = 1.0f;
+		const std::vector<uint32_t> simplified = Simplify(indices, &vertices[0].position.x, sizeof(Vertex), static_cast<uint32_t>(vertices.size()), 6, 0.01f, &error);
+		std::printf("grid: %zu -> %zu triangles, error %g\n", indices.size() / 3, simplified.size() / 3, error);
+		CHECK(simplified.size() < indices.size() / 4);
+		CHECK(error < 1e-5f);
+		CHECK(std::fabs(CalculateArea(vertices, simplified) - CalculateArea(vertices, indices)) < 1e-3);
+
+		const std::set<uint32_t> used(simplified.begin(), simplified.end());
+		for (uint32_t corner : { 0u, kSize, (kSize + 1) * kSize, (kSize + 1) * (kSize + 1) - 1 }) {
+			CHECK(used.count(corner) == 1);
+		}
+		bool facingUp = true;
+		for (size_t i = 0; i + 2 < simplified.size(); i += 3) {
+			const Vector3 a = GetPosition(vertices[simplified[i]]);
+			const Vector3 n = Cross(Subtract(GetPosition(vertices[simplified[i + 1]]), a), Subtract(GetPosition(vertices[simplified[i + 2]]), a));
+			facingUp = facingUp && n.y > 0.0f;
+		}
+		CHECK(facingUp);
+	}
+
+	/// <summary>
+	/// 小さな誤差の予算: 目標の三角形数に届かなくても予算を超えては減らさない
+	/// </summary>
+	void TestTinyBudget()
+	{
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+		MakeSphere(vertices, indices, 64, 32);
+		const float* positions = &vertices[0].position.x;
+		const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+		const float extent = CalculateExtent(positions, sizeof(Vertex), vertexCount);
+
+		float previousError = 0.0f;
+		size_t previousCount = indices.size();
+		for (float budget : { 0.0f, 1e-4f, 3e-4f, 1e-3f, 3e-3f }) {
+			float error = -1.0f;
+			const std::vector<uint32_t> simplified = Simplify(indices, positions, sizeof(Vertex), vertexCount, 0, budget, &error);
+			const float deviation = MeasureDeviation(vertices, indices, simplified.data(), static_cast<uint32_t>(simplified.size()), 1);
+			std::printf("sphere budget %.0e: %zu -> %zu triangles, error %.6f, measured %.6f\n", budget, indices.size() / 3, simplified.size() / 3, error, deviation / extent);
+			CHECK(error >= 0.0f && error <= budget + 1e-7f);
+			// 誤差は周りの面の平面までの距離を面積で平均したものなので、一様に曲がった面で
+			// 小さな面に囲まれた点 (極の周り) を動かすと、測ったずれは申告の数倍になる
+			CHECK(deviation <= budget * extent * 10.0f + 1e-6f);
+			// 予算を広げるほど減る
+			CHECK(simplified.size() <= previousCount);
+			CHECK(error >= previousError);
+			CHECK(IsClosed(vertices, simplified.data(), static_cast<uint32_t>(simplified.size())));
+			previousError = error;
+			previousCount = simplified.size();
+		}
+
+		// 分割の細かさより小さな予算なら曲面は減らせない
+		for (float budget : { 0.0f, 1e-5f, 1e-4f }) {
+			CHECK(Simplify(indices, positions, sizeof(Vertex), vertexCount, 0, budget) == indices);
+		}
+	}
+
+	/// <summary>
+	/// LODの選択: 近づく・離れるの一方向の動きでは1段ずつ最小回数で切り替わり、
+	/// 閾値の近くで行ったり来たりしても、ヒステリシスの幅の中なら切り替わらない
+	/// </summary>
+	void TestHysteresisSweep()
+	{
+		const std::vector<Lod> lods = { { 0, 300, 0.0f }, { 300, 150, 0.01f }, { 450, 75, 0.04f }, { 525, 30, 0.2f } };
+
+		CHECK(SelectLod(lods, 1000.0f, 0) == 0);
+		// LOD2 は 0.8px: 粗くする時は 0.75px 以下が要る
+		CHECK(SelectLod(lods, 20.0f, 0) == 1);
+		CHECK(SelectLod(lods, 20.0f, 2) == 2);
+		// 1px を超えたらすぐ細かくする
+		CHECK(SelectLod(lods, 26.0f, 2) == 1);
+		CHECK(SelectLod(lods, 18.0f, 1) == 2);
+		CHECK(SelectLod(lods, 1.0f, 0) == 3);
+		CHECK(SelectLod(lods, 0.0f, 3) == 0);
+		CHECK(SelectLod({}, 5.0f, 2) == 0);
+
+		// 離れていく
+		uint32_t current = 0;
+		uint32_t switches = 0;
+		bool monotone = true;
+		for (uint32_t i = 0; i < 20000; ++i) {
+			const uint32_t next = SelectLod(lods, 1000.0f / (1.0f + i * 0.05f), current);
+			monotone = monotone && next >= current;
+			switches += next != current;
+			current = next;
+		}
+		CHECK(monotone);
+		CHECK(switches == 3);
+
+		// 近づいてくる
+		switches = 0;
+		for (uint32_t i = 20000; i-- > 0;) {
+			const uint32_t next = SelectLod(lods, 1000.0f / (1.0f + i * 0.05f), current);
+			monotone = monotone && next <= current;
+			switches += next != current;
+			current = next;
+		}
+		CHECK(monotone);
+		CHECK(switches == 3);
+		CHECK(current == 0);
+
+		// LOD1 と LOD2 の境目 (LOD2 が 0.75px～1px になる 18.75～25 px/unit) で揺らしても動かない
+		for (uint32_t start : { 1u, 2u }) {
+			current = start;
+			switches = 0;
+			for (uint32_t i = 0; i < 1000; ++i) {
+				const float pixelsPerUnit = 21.875f + 3.0f * std::sin(i * 0.1f);
+				const uint32_t next = SelectLod(lods, pixelsPerUnit, current);
+				switches += next != current;
+				current = next;
+			}
+			CHECK(switches == 0);
+			CHECK(current == start);
+		}
+	}
+
+	/// <summary>
+	/// Resources/Models の OBJ: LODは減り続け、誤差は予算内、閉じたものは閉じたまま
+	/// </summary>
+	void TestResourceModels()
+	{
+		const std::vector<ObjMesh::Mesh> meshes = ObjMesh::LoadAll();
+		CHECK(!meshes.empty());
+		for (ObjMesh::Mesh mesh : meshes) {
+			MeshOptimizer::Optimize(mesh.vertices, mesh.indices);
+			std::vector<uint32_t> lodIndices;
+			const std::vector<Lod> lods = GenerateLods(mesh.vertices, mesh.indices, lodIndices);
+			std::vector<uint32_t> all = mesh.indices;
+			all.insert(all.end(), lodIndices.begin(), lodIndices.end());
+
+			const float extent = CalculateExtent(&mesh.vertices[0].position.x, sizeof(Vertex), static_cast<uint32_t>(mesh.vertices.size()));
+			const bool closed = IsClosed(mesh.vertices, mesh.indices.data(), static_cast<uint32_t>(mesh.indices.size()));
+			const uint32_t step = (std::max)(1u, static_cast<uint32_t>(mesh.vertices.size() / 1500));
+			std::printf("  %-24s", mesh.name.c_str());
+			for (size_t i = 0; i < lods.size(); ++i) {
+				const Lod& lod = lods[i];
+				std::printf(" %u", lod.indexCount / 3);
+				if (i == 0) {
+					continue;
+				}
+				const float deviation = MeasureDeviation(mesh.vertices, mesh.indices, all.data() + lod.indexOffset, lod.indexCount, step);
+				std::printf("(%.4f)", deviation / extent);
+				CHECK(lod.indexCount < lods[i - 1].indexCount);
+				CHECK(lod.error <= kLodTargetError * extent * 1.0001f);
+				CHECK(deviation <= kLodTargetError * extent * 1.5f);
+				if (closed) {
+					CHECK(IsClosed(mesh.vertices, all.data() + lod.indexOffset, lod.indexCount));
+				}
+			}
+			std::printf("%s\n", closed ? " [closed]" : "");
+		}
+	}
+
+} // namespace
+
+int main()
+{
+	TestClosedSphere();
+	TestFlatGrid();
+	TestTinyBudget();
+	TestHysteresisSweep();
+	TestResourceModels();
+	return Test::Finish("MeshSimplifierTest");
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+// C++
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Math
+#include "Vector2.h"
+#include "Vector3.h"
+#include "Vector4.h"
+
+/// <summary>
+/// テスト用の小さな OBJ 読み込み (v / vt / vn / f だけ読み、多角形は扇状に三角形へ分ける)
+/// Model と同じく頂点は面の角ごとに作る (インデックスは 0, 1, 2, ... の並び)
+/// </summary>
+namespace ObjMesh {
+
+	// Mesh::VertexData と同じ並び
+	struct Vertex {
+		Vector4 position;
+		Vector2 texcoord;
+		Vector3 normal;
+	};
+
+	struct Mesh {
+		std::string name;
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+	};
+
+	/// <summary>
+	/// 1つ読む (読めなければ空のメッシュ)
+	/// </summary>
+	inline Mesh Load(const std::filesystem::path& path)
+	{
+		Mesh mesh;
+		mesh.name = path.filename().string();
+		std::ifstream file(path);
+		if (!file) {
+			return mesh;
+		}
+
+		std::vector<Vector4> positions;
+		std::vector<Vector2> texcoords;
+		std::vector<Vector3> normals;
+		std::string line;
+		while (std::getline(file, line)) {
+			std::istringstream stream(line);
+			std::string tag;
+			stream >> tag;
+			if (tag == "v") {
+				Vector4 p = { 0.0f, 0.0f, 0.0f, 1.0f };
+				stream >> p.x >> p.y >> p.z;
+				positions.push_back(p);
+			} else if (tag == "vt") {
+				Vector2 t = {};
+				stream >> t.x >> t.y;
+				texcoords.push_back(t);
+			} else if (tag == "vn") {
+				Vector3 n;
+				stream >> n.x >> n.y >> n.z;
+				normals.push_back(n);
+			} else if (tag == "f") {
+				std::vector<Vertex> corners;
+				std::string corner;
+				while (stream >> corner) {
+					// "p/t/n" "p//n" "p/t" "p" (負の番号は後ろから)
+					int32_t index[3] = { 0, 0, 0 };
+					std::istringstream parts(corner);
+					std::string part;
+					for (int i = 0; i < 3 && std::getline(parts, part, '/'); ++i) {
+						index[i] = part.empty() ? 0 : std::stoi(part);
+					}
+					auto resolve = [](int32_t i, size_t count) { return i > 0 ? static_cast<size_t>(i - 1) : count + i; };
+					Vertex vertex = {};
+					vertex.position = positions[resolve(index[0], positions.size())];
+					if (index[1] != 0) {
+						vertex.texcoord = texcoords[resolve(index[1], texcoords.size())];
+					}
+					if (index[2] != 0) {
+						vertex.normal = normals[resolve(index[2], normals.size())];
+					}
+					corners.push_back(vertex);
+				}
+				for (size_t i = 2; i < corners.size(); ++i) {
+					for (const Vertex& vertex : { corners[0], corners[i - 1], corners[i] }) {
+						mesh.indices.push_back(static_cast<uint32_t>(mesh.vertices.size()));
+						mesh.vertices.push_back(vertex);
+					}
+				}
+			}
+		}
+		return mesh;
+	}
+
+	/// <summary>
+	/// Resources/Models 以下の OBJ を全部読む (名前順)
+	/// </summary>
+	inline std::vector<Mesh> LoadAll(const std::filesystem::path& directory = "Resources/Models")
+	{
+		std::vector<std::filesystem::path> paths;
+		if (std::filesystem::exists(directory)) {
+			for (const auto& entry : std::filesystem::recursive_directory_iterator(directory)) {
+				if (entry.is_regular_file() && entry.path().extension() == ".obj") {
+					paths.push_back(entry.path());
+				}
+			}
+		}
+		std::sort(paths.begin(), paths.end());
+
+		std::vector<Mesh> meshes;
+		for (const auto& path : paths) {
+			Mesh mesh = Load(path);
+			if (!mesh.indices.empty()) {
+				meshes.push_back(std::move(mesh));
+			}
+		}
+		return meshes;
+	}
+
+} // namespace ObjMesh
@@ -0,0 +1,78 @@
+// C++
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Engine
+#include "TextureSlotTable.h"
+
+namespace {
+
+	// TextureManager::TextureData の代わり (引いた結果を使う分だけ)
+	struct TextureData {
+		uint32_t srvIndex;
+	};
+
+} // namespace
+
+/// <summary>
+/// 10k 回のテクスチャの引き当てを、ファイルパスの連想配列とハンドルで比べる
+/// </summary>
+int main()
+{
+	constexpr uint32_t kTextureCount = 512;
+	constexpr uint32_t kLookupCount = 10'000;
+	constexpr uint32_t kRepeatCount = 1000;
+
+	TextureSlotTable slots;
+	slots.Initialize(kTextureCount);
+	std::vector<TextureData> textures;
+	std::unordered_map<std::string, TextureData> byPath;
+	std::vector<std::string> paths;
+	std::vector<TextureHandle> handles;
+	for (uint32_t i = 0; i < kTextureCount; ++i) {
+		const TextureHandle handle = slots.Allocate();
+		textures.push_back({ i + 1 });
+		paths.push_back("Resources/images/Sprites/texture_" + std::to_string(i) + ".png");
+		byPath.emplace(paths.back(), textures.back());
+		handles.push_back(handle);
+	}
+	slots.SetFallbackHandle(handles[0]);
+
+	// 毎フレーム描くスプライトが引く順
+	std::mt19937 random(4);
+	std::vector<uint32_t> order(kLookupCount);
+	for (uint32_t& index : order) {
+		index = random() % kTextureCount;
+	}
+
+	uint64_t pathSum = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (uint32_t repeat = 0; repeat < kRepeatCount; ++repeat) {
+		for (uint32_t index : order) {
+			pathSum += byPath.find(paths[index])->second.srvIndex;
+		}
+	}
+	const double pathMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+	uint64_t handleSum = 0;
+	start = std::chrono::steady_clock::now();
+	for (uint32_t repeat = 0; repeat < kRepeatCount; ++repeat) {
+		for (uint32_t index : order) {
+			handleSum += textures[slots.ToIndex(handles[index])].srvIndex;
+		}
+	}
+	const double handleMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+	std::printf("%u textures, %u lookups x %u\n", kTextureCount, kLookupCount, kRepeatCount);
+	std::printf(" path (unordered_map<string>) %.1f us per 10k (%.2f ns/lookup)\n",
+		pathMicroseconds / kRepeatCount, pathMicroseconds * 1000.0 / (double(kLookupCount) * kRepeatCount));
+	std::printf(" handle (generation check)     %.1f us per 10k (%.2f ns/lookup)\n",
+		handleMicroseconds / kRepeatCount, handleMicroseconds * 1000.0 / (double(kLookupCount) * kRepeatCount));
+	std::printf(" checksum %s, invalid lookups %u\n", pathSum == handleSum ? "match" : "MISMATCH", slots.GetInvalidHandleCount());
+	return pathSum == handleSum ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+// C++
+#include <cstdint>
+#include <vector>
+
+// Engine
+#include "TextureSlotTable.h"
+
+// Test
+#include "TestCommon.h"
+
+using namespace TextureHandleUtil;
+
+namespace {
+
+	/// <summary>
+	/// 解放した枠は世代を進めて使い回し、古いハンドルは通らない
+	/// </summary>
+	void TestReuse()
+	{
+		TextureSlotTable slots;
+		slots.Initialize(16);
+		const TextureHandle fallback = slots.Allocate();
+		slots.SetFallbackHandle(fallback);
+		const TextureHandle first = slots.Allocate();
+		const TextureHandle second = slots.Allocate();
+		CHECK(slots.IsValid(first) && slots.IsValid(second));
+		CHECK(slots.ToIndex(second) == GetIndex(second));
+		CHECK(slots.GetSlotCount() == 3);
+
+		CHECK(slots.Free(first));
+		CHECK(!slots.IsValid(first));
+		// 二重解放は無視する
+		CHECK(!slots.Free(first));
+
+		const TextureHandle reused = slots.Allocate();
+		CHECK(GetIndex(reused) == GetIndex(first));
+		CHECK(GetGeneration(reused) == NextGeneration(GetGeneration(first)));
+		CHECK(slots.IsValid(reused) && !slots.IsValid(first));
+		CHECK(slots.GetSlotCount() == 3);
+
+		// 代わりのハンドルは解放できない
+		CHECK(!slots.Free(fallback));
+		CHECK(slots.IsValid(fallback));
+	}
+
+	/// <summary>
+	/// 古い・壊れたハンドルは代わりのテクスチャの添字になり、回数を数える
+	/// </summary>
+	void TestStaleFallback()
+	{
+		TextureSlotTable slots;
+		slots.Initialize(16);
+		slots.SetFallbackHandle(slots.Allocate());
+		const uint32_t fallbackIndex = GetIndex(slots.GetFallbackHandle());
+
+		const TextureHandle handle = slots.Allocate();
+		slots.Free(handle);
+		// 同じ添字が別のテクスチャに使い回されても、古いハンドルはそちらを読まない
+		const TextureHandle other = slots.Allocate();
+		CHECK(GetIndex(other) == GetIndex(handle));
+		CHECK(slots.ToIndex(handle) == fallbackIndex);
+		CHECK(slots.ToIndex(other) == GetIndex(other));
+		CHECK(slots.GetInvalidHandleCount() == 1);
+
+		// 無効値・範囲外の添字
+		CHECK(slots.ToIndex(kInvalid) == fallbackIndex);
+		CHECK(slots.ToIndex(Make(1000, 0)) == fallbackIndex);
+		CHECK(slots.GetInvalidHandleCount() == 3);
+
+		// 初期化すると以前のハンドルはすべて無効
+		slots.Initialize(16);
+		CHECK(!slots.IsValid(other));
+		CHECK(slots.GetInvalidHandleCount() == 0);
+		CHECK(slots.GetSlotCount() == 0);
+	}
+
+	/// <summary>
+	/// 1つの枠で世代が一周しても、払い出すハンドルは無効値にならない
+	/// </summary>
+	void TestGenerationWrap()
+	{
+		TextureSlotTable slots;
+		slots.Initialize(1);
+		TextureHandle previous = slots.Allocate();
+		bool neverInvalid = true;
+		bool staleRejected = true;
+		for (uint32_t i = 0; i <= kGenerationMask; ++i) {
+			slots.Free(previous);
+			const TextureHandle handle = slots.Allocate();
+			neverInvalid = neverInvalid && handle != kInvalid;
+			staleRejected = staleRejected && !slots.IsValid(previous) && slots.IsValid(handle);
+			previous = handle;
+		}
+		CHECK(neverInvalid);
+		CHECK(staleRejected);
+		CHECK(GetGeneration(previous) == 0);
+	}
+
+} // namespace
+
+int main()
+{
+	TestReuse();
+	TestStaleFallback();
+	TestGenerationWrap();
+	return Test::Finish("TextureSlotTableTest");
+}
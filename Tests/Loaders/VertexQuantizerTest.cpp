@@ -0,0 +1,235 @@
+// C++
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Engine
+#include "MeshOptimizer.h"
+#include "VertexQuantizer.h"
+
+// Test
+#include "ObjMesh.h"
+#include "TestCommon.h"
+
+using namespace VertexQuantizer;
+
+namespace {
+
+	/// <summary>
+	/// 半精度: 全ての値が往復し、コンパイラの _Float16 があれば丸めを突き合わせる
+	/// </summary>
+	void TestHalf()
+	{
+		uint32_t roundTripFailures = 0;
+		for (uint32_t bits = 0; bits < 65536; ++bits) {
+			const float value = HalfToFloat(static_cast<uint16_t>(bits));
+			if (std::isnan(value)) {
+				continue;
+			}
+			roundTripFailures += FloatToHalf(value) != bits;
+		}
+		CHECK(roundTripFailures == 0);
+
+		CHECK(FloatToHalf(1.0f) == 0x3C00);
+		CHECK(FloatToHalf(-2.0f) == 0xC000);
+		CHECK(FloatToHalf(65504.0f) == 0x7BFF);
+		// 最大値を超えて丸めると無限大
+		CHECK(FloatToHalf(65520.0f) == 0x7C00);
+		CHECK(FloatToHalf(std::numeric_limits<float>::infinity()) == 0x7C00);
+		// 最近接偶数丸め (1 + 2^-11 は 1 と 1 + 2^-10 の真ん中)
+		CHECK(FloatToHalf(1.0f + 1.0f / 2048.0f) == 0x3C00);
+		CHECK(FloatToHalf(1.0f + 3.0f / 2048.0f) == 0x3C02);
+		// 非正規化数
+		CHECK(HalfToFloat(0x0001) == std::ldexp(1.0f, -24));
+
+#if defined(__FLT16_MAX__)
+		std::mt19937 random(1);
+		uint32_t mismatches = 0;
+		for (uint32_t i = 0; i < 2000000; ++i) {
+			const uint32_t bits = random();
+			float value;
+			std::memcpy(&value, &bits, sizeof(value));
+			if (std::isnan(value)) {
+				continue;
+			}
+			const _Float16 reference = static_cast<_Float16>(value);
+			uint16_t referenceBits;
+			std::memcpy(&referenceBits, &reference, sizeof(referenceBits));
+			mismatches += FloatToHalf(value) != referenceBits;
+		}
+		CHECK(mismatches == 0);
+#endif
+	}
+
+	/// <summary>
+	/// 16bit 正規化整数は全て往復し、範囲外は切り詰める
+	/// </summary>
+	void TestUnorm16()
+	{
+		uint32_t failures = 0;
+		for (uint32_t value = 0; value < 65536; ++value) {
+			failures += EncodeUnorm16(DecodeUnorm16(static_cast<uint16_t>(value))) != value;
+		}
+		CHECK(failures == 0);
+		CHECK(EncodeUnorm16(-1.0f) == 0);
+		CHECK(EncodeUnorm16(2.0f) == 65535);
+	}
+
+	/// <summary>
+	/// 八面体マッピング: 軸はほぼそのまま戻り、ランダムな向きの誤差も 0.01 度未満
+	/// </summary>
+	void TestOctahedral()
+	{
+		const Vector3 axes[] = {
+			{ 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f },
+			{ 0.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f }, { 0.0f, -0.0f, -1.0f },
+		};
+		for (const Vector3& axis : axes) {
+			int16_t encoded[2];
+			EncodeOctahedral(axis, encoded);
+			const Vector3 decoded = DecodeOctahedral(encoded);
+			CHECK(decoded.x * axis.x + decoded.y * axis.y + decoded.z * axis.z > 0.9999999f);
+		}
+		// 長さ0は +Z
+		int16_t zero[2];
+		EncodeOctahedral(Vector3(0.0f, 0.0f, 0.0f), zero);
+		CHECK(DecodeOctahedral(zero).z == 1.0f);
+
+		std::mt19937 random(2);
+		std::normal_distribution<float> distribution;
+		// float の acos では 1 に近い所が粗いので、角度は double で求める
+		double worst = 0.0;
+		for (uint32_t i = 0; i < 500000; ++i) {
+			Vector3 n(distribution(random), distribution(random), distribution(random));
+			const float length = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+			if (length < 1e-6f) {
+				continue;
+			}
+			n = Vector3(n.x / length, n.y / length, n.z / length);
+			int16_t encoded[2];
+			EncodeOctahedral(n, encoded);
+			const Vector3 decoded = DecodeOctahedral(encoded);
+			const double cx = static_cast<double>(decoded.y) * n.z - static_cast<double>(decoded.z) * n.y;
+			const double cy = static_cast<double>(decoded.z) * n.x - static_cast<double>(decoded.x) * n.z;
+			const double cz = static_cast<double>(decoded.x) * n.y - static_cast<double>(decoded.y) * n.x;
+			const double dot = static_cast<double>(decoded.x) * n.x + static_cast<double>(decoded.y) * n.y + static_cast<double>(decoded.z) * n.z;
+			worst = (std::max)(worst, std::atan2(std::sqrt(cx * cx + cy * cy + cz * cz), dot) * 57.29577951308232);
+		}
+		std::printf("octahedral max error %.5f deg\n", worst);
+		CHECK(worst < 0.01);
+	}
+
+	/// <summary>
+	/// インフルエンス: 重みの合計は255、0は0のまま、ジョイント番号はそのまま
+	/// </summary>
+	void TestInfluence()
+	{
+		std::mt19937 random(3);
+		std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+		uint32_t failures = 0;
+		float worst = 0.0f;
+		for (uint32_t i = 0; i < 200000; ++i) {
+			float weights[kNumInfluence] = { distribution(random), distribution(random), (i % 3) ? distribution(random) : 0.0f, (i % 5) ? distribution(random) : 0.0f };
+			const float sum = weights[0] + weights[1] + weights[2] + weights[3];
+			for (float& weight : weights) {
+				weight /= sum;
+			}
+			const int32_t joints[kNumInfluence] = { static_cast<int32_t>(random() % 256), static_cast<int32_t>(random() % 256), 0, 255 };
+
+			const PackedInfluence packed = EncodeInfluence(weights, joints);
+			float decodedWeights[kNumInfluence];
+			int32_t decodedJoints[kNumInfluence];
+			DecodeInfluence(packed, decodedWeights, decodedJoints);
+
+			uint32_t packedSum = 0;
+			for (uint32_t k = 0; k < kNumInfluence; ++k) {
+				packedSum += packed.weights[k];
+				failures += decodedJoints[k] != joints[k];
+				failures += weights[k] == 0.0f && packed.weights[k] != 0;
+				worst = (std::max)(worst, std::fabs(decodedWeights[k] - weights[k]) * 255.0f);
+			}
+			failures += packedSum != 255;
+		}
+		std::printf("influence max weight error %.3f / 255\n", worst);
+		CHECK(failures == 0);
+		// 合計を合わせるための割り振りでも1段階まで
+		CHECK(worst <= 1.0f + 1e-4f);
+	}
+
+	/// <summary>
+	/// UVが大きすぎるもの・有限でないものは圧縮しない
+	/// </summary>
+	void TestCanPack()
+	{
+		std::vector<ObjMesh::Vertex> vertices(1);
+		vertices[0].normal = Vector3(0.0f, 1.0f, 0.0f);
+		CHECK(CanPack(vertices));
+		vertices[0].texcoord.x = kMaxTexcoord * 2.0f;
+		CHECK(!CanPack(vertices));
+		vertices[0].texcoord.x = 0.0f;
+		vertices[0].position.y = std::numeric_limits<float>::quiet_NaN();
+		CHECK(!CanPack(vertices));
+
+		std::vector<PackedVertex> packed;
+		QuantizationParams params;
+		CHECK(!PackVertices(vertices, packed, params));
+		CHECK(packed.empty());
+	}
+
+	/// <summary>
+	/// Resources/Models の OBJ: 位置は量子化の半歩、UVは半精度の丸めに収まる
+	/// (MeasureError の法線の角度は float の acos なので 0.03 度ほどの刻みになる)
+	/// </summary>
+	void TestResourceModels()
+	{
+		const std::vector<ObjMesh::Mesh> meshes = ObjMesh::LoadAll();
+		CHECK(!meshes.empty());
+
+		uint64_t bytesBefore = 0;
+		uint64_t bytesAfter = 0;
+		for (ObjMesh::Mesh mesh : meshes) {
+			MeshOptimizer::Optimize(mesh.vertices, mesh.indices);
+
+			std::vector<PackedVertex> packed;
+			QuantizationParams params;
+			if (!PackVertices(mesh.vertices, packed, params)) {
+				std::printf("  %-24s not packable\n", mesh.name.c_str());
+				continue;
+			}
+			const Error error = MeasureError(mesh.vertices, packed, params);
+
+			float maxTexcoord = 0.0f;
+			for (const ObjMesh::Vertex& vertex : mesh.vertices) {
+				maxTexcoord = (std::max)(maxTexcoord, (std::max)(std::fabs(vertex.texcoord.x), std::fabs(vertex.texcoord.y)));
+			}
+			// 1段の半分 (各軸) を対角で足したものに少し余裕を持たせる
+			const float step = (std::max)({ params.scale.x, params.scale.y, params.scale.z });
+			CHECK(error.position <= step * 0.5f * 1.7321f + 1e-5f);
+			CHECK(error.texcoord <= (std::max)(maxTexcoord, 6.1e-5f) * (1.0f / 2048.0f));
+			CHECK(error.normalDegrees < 0.05f);
+
+			bytesBefore += mesh.vertices.size() * sizeof(ObjMesh::Vertex);
+			bytesAfter += packed.size() * sizeof(PackedVertex);
+			std::printf("  %-24s %6zu vertices  position %.6f  normal %.4f deg  uv %.6f\n",
+				mesh.name.c_str(), mesh.vertices.size(), error.position, error.normalDegrees, error.texcoord);
+		}
+		std::printf("vertex buffers %llu -> %llu bytes\n", static_cast<unsigned long long>(bytesBefore), static_cast<unsigned long long>(bytesAfter));
+	}
+
+} // namespace
+
+int main()
+{
+	TestHalf();
+	TestUnorm16();
+	TestOctahedral();
+	TestInfluence();
+	TestCanPack();
+	TestResourceModels();
+	return Test::Finish("VertexQuantizerTest");
+}
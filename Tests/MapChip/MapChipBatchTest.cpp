@@ -0,0 +1,163 @@
+// C++
+#include <cmath>
+#include <cstdint>
+
+// Engine
+#include "MapChipBatch.h"
+#include "MapChipBoxes.h"
+#include "MapChipField.h"
+
+// Test
+#include "TestCommon.h"
+
+namespace {
+
+	// 読み込むマップ (作業ディレクトリはリポジトリの直下)
+	const char* const kMapPath = "Resources/images/MapChip.csv";
+
+	/// <summary>
+	/// 空白でないマスの数
+	/// </summary>
+	uint32_t CountBlocks(const MapChipField& field)
+	{
+		uint32_t count = 0;
+		for (uint32_t y = 0; y < MapChipField::GetNumBlockVertical(); ++y) {
+			for (uint32_t x = 0; x < MapChipField::GetNumBlockHorizontal(); ++x) {
+				count += field.GetMapChipTypeByIndex(x, y) != MapChipType::kBlank;
+			}
+		}
+		return count;
+	}
+
+	/// <summary>
+	/// 行列の平行移動成分がマスの中心と一致するか
+	/// </summary>
+	bool IsAt(const Matrix4x4& matrix, const Vector3& position)
+	{
+		return std::abs(matrix.m[3][0] - position.x) <= 1e-5f &&
+			std::abs(matrix.m[3][1] - position.y) <= 1e-5f &&
+			std::abs(matrix.m[3][2] - position.z) <= 1e-5f;
+	}
+
+	/// <summary>
+	/// マスごと: インスタンス数は空白でないマスの数で、各マスの中心に置かれる
+	/// </summary>
+	void TestInstancePerCell()
+	{
+		MapChipField field;
+		field.LoadMapChipCsv(kMapPath);
+		MapChipBatch batch;
+		batch.RegisterModel(MapChipType::kBlock, "cube.obj");
+
+		CHECK(batch.Build(field));
+		CHECK(CountBlocks(field) > 0);
+		CHECK(batch.GetInstanceCount() == CountBlocks(field));
+		CHECK(batch.GetBatches().size() == 1);
+		CHECK(batch.GetBatches()[0].modelName == "cube.obj");
+
+		// 左上から行ごとに並ぶ
+		uint32_t instance = 0;
+		bool placed = true;
+		const auto& matrices = batch.GetBatches()[0].worldMatrices;
+		for (uint32_t y = 0; y < MapChipField::GetNumBlockVertical(); ++y) {
+			for (uint32_t x = 0; x < MapChipField::GetNumBlockHorizontal(); ++x) {
+				if (field.GetMapChipTypeByIndex(x, y) == MapChipType::kBlank) {
+					continue;
+				}
+				placed = placed && IsAt(matrices[instance++], MapChipField::GetMapChipPositionByIndex(x, y));
+			}
+		}
+		CHECK(placed);
+
+		// モデルを登録していないタイプは描かない
+		MapChipBatch empty;
+		CHECK(empty.Build(field));
+		CHECK(empty.GetInstanceCount() == 0);
+	}
+
+	/// <summary>
+	/// 作り直すのはフィールドの更新番号が変わった時 (と明示的に汚した時) だけ
+	/// </summary>
+	void TestRebuildOnRevision()
+	{
+		MapChipField field;
+		field.LoadMapChipCsv(kMapPath);
+		MapChipBatch batch;
+		batch.RegisterModel(MapChipType::kBlock, "cube.obj");
+
+		CHECK(batch.Build(field));
+		const uint32_t blocks = batch.GetInstanceCount();
+
+		// 何も変わっていなければ作り直さない
+		CHECK(!batch.Build(field));
+		CHECK(!batch.Build(field));
+		CHECK(batch.GetInstanceCount() == blocks);
+
+		// 同じタイプを書き込んでも更新番号は進まない
+		const uint32_t revision = field.GetRevision();
+		field.SetMapChipTypeByIndex(0, 0, field.GetMapChipTypeByIndex(0, 0));
+		CHECK(field.GetRevision() == revision);
+		CHECK(!batch.Build(field));
+
+		// 書き換えれば作り直し、数が追従する
+		field.SetMapChipTypeByIndex(5, 5, MapChipType::kBlock);
+		CHECK(field.GetRevision() != revision);
+		CHECK(batch.Build(field));
+		CHECK(batch.GetInstanceCount() == CountBlocks(field));
+		CHECK(!batch.Build(field));
+
+		field.SetMapChipTypeByIndex(5, 5, MapChipType::kBlank);
+		CHECK(batch.Build(field));
+		CHECK(batch.GetInstanceCount() == blocks);
+
+		// 別のフィールドを渡せば作り直す
+		MapChipField other;
+		CHECK(batch.Build(other));
+		CHECK(batch.GetInstanceCount() == 0);
+
+		batch.MarkDirty();
+		CHECK(batch.Build(other));
+		CHECK(!batch.Build(other));
+	}
+
+	/// <summary>
+	/// 矩形ごと: 1矩形1インスタンスで、矩形の部分更新でも作り直す
+	/// </summary>
+	void TestInstancePerBox()
+	{
+		MapChipField field;
+		field.LoadMapChipCsv(kMapPath);
+		MapChipBoxes boxes;
+		boxes.Build(field);
+		MapChipBatch batch;
+		batch.RegisterModel(MapChipType::kBlock, "cube.obj");
+		batch.SetBoxes(&boxes);
+
+		CHECK(batch.Build(field));
+		CHECK(batch.GetInstanceCount() == boxes.GetBoxes().size());
+		CHECK(batch.GetInstanceCount() < CountBlocks(field));
+
+		// 拡大率の面積の合計はマスの数
+		float area = 0.0f;
+		for (const Matrix4x4& matrix : batch.GetBatches()[0].worldMatrices) {
+			area += matrix.m[0][0] * matrix.m[2][2];
+		}
+		CHECK(std::abs(area - static_cast<float>(CountBlocks(field))) <= 1e-3f);
+		CHECK(!batch.Build(field));
+
+		field.SetMapChipTypeByIndex(5, 5, MapChipType::kBlock);
+		boxes.OnCellChanged(field, 5, 5);
+		CHECK(batch.Build(field));
+		CHECK(batch.GetInstanceCount() == boxes.GetBoxes().size());
+		CHECK(!batch.Build(field));
+	}
+
+} // namespace
+
+int main()
+{
+	TestInstancePerCell();
+	TestRebuildOnRevision();
+	TestInstancePerBox();
+	return Test::Finish("MapChipBatchTest");
+}
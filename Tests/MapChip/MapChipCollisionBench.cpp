@@ -0,0 +1,132 @@
+// C++
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Engine
+#include "MapChipBoxes.h"
+#include "MapChipCollision.h"
+#include "MapChipField.h"
+
+namespace {
+
+	// 読み込むマップ (リポジトリの直下で実行する)
+	const char* const kMaps[] = {
+		"Resources/images/MapChip.csv",
+	};
+
+	struct Query {
+		Vector3 position;
+		Vector3 velocity;
+	};
+
+	/// <summary>
+	/// 同じ問い合わせを流して、1回あたりの時間 (ns) を返す
+	/// </summary>
+	double MeasureQueries(MapChipCollision& collision, const std::vector<Query>& queries, uint32_t passes, float& checksum)
+	{
+		const MapChipCollision::ColliderRect collider(2.0f, 2.0f);
+		const auto start = std::chrono::steady_clock::now();
+		for (uint32_t pass = 0; pass < passes; ++pass) {
+			for (const Query& query : queries) {
+				Vector3 position = query.position;
+				Vector3 velocity = query.velocity;
+				collision.DetectAndResolveCollision(collider, position, velocity);
+				checksum += position.x + position.z;
+			}
+		}
+		const double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		return nanoseconds / (static_cast<double>(queries.size()) * passes);
+	}
+
+} // namespace
+
+/// <summary>
+/// 既存のマップごとに、ブロック数とまとめた矩形の数、作り直し・部分更新の時間、
+/// マスごとの判定と矩形の判定の1回あたりの時間を出す
+/// </summary>
+int main()
+{
+	constexpr uint32_t kQueryCount = 100'000;
+	constexpr uint32_t kPasses = 10;
+	constexpr uint32_t kBuildCount = 10'000;
+	constexpr uint32_t kEditCount = 100'000;
+
+	for (const char* path : kMaps) {
+		MapChipField field;
+		field.LoadMapChipCsv(path);
+
+		uint32_t blocks = 0;
+		for (uint32_t y = 0; y < MapChipField::GetNumBlockVertical(); ++y) {
+			for (uint32_t x = 0; x < MapChipField::GetNumBlockHorizontal(); ++x) {
+				blocks += field.GetMapChipTypeByIndex(x, y) != MapChipType::kBlank;
+			}
+		}
+
+		MapChipBoxes boxes;
+		auto start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < kBuildCount; ++i) {
+			boxes.Build(field);
+		}
+		const double buildMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / kBuildCount;
+		const size_t boxCount = boxes.GetBoxes().size();
+
+		// ブロックの周りを動き回る問い合わせ (開始位置でめり込んでいないものだけ)
+		std::mt19937 random(3);
+		std::uniform_real_distribution<float> positionX(-1.0f, 64.0f);
+		std::uniform_real_distribution<float> positionZ(4.0f, 40.0f);
+		std::uniform_real_distribution<float> speed(-1.5f, 1.5f);
+		std::vector<Query> queries;
+		queries.reserve(kQueryCount);
+		while (queries.size() < kQueryCount) {
+			const Query query{ Vector3{ positionX(random), 0.0f, positionZ(random) }, Vector3{ speed(random), 0.0f, speed(random) } };
+			const MapChipField::IndexSet index = field.GetMapChipIndexSetByPosition(query.position);
+			bool free = true;
+			for (int32_t dy = -1; dy <= 1 && free; ++dy) {
+				for (int32_t dx = -1; dx <= 1; ++dx) {
+					const int32_t x = static_cast<int32_t>(index.xIndex) + dx;
+					const int32_t y = static_cast<int32_t>(index.yIndex) + dy;
+					if (x < 0 || y < 0 || field.GetMapChipTypeByIndex(static_cast<uint32_t>(x), static_cast<uint32_t>(y)) == MapChipType::kBlank) {
+						continue;
+					}
+					const MapChipField::Rect rect = field.GetRectByIndex(static_cast<uint32_t>(x), static_cast<uint32_t>(y));
+					if (query.position.x + 1.0f > rect.left && query.position.x - 1.0f < rect.right &&
+						query.position.z + 1.0f > rect.bottom && query.position.z - 1.0f < rect.top) {
+						free = false;
+						break;
+					}
+				}
+			}
+			if (free) {
+				queries.push_back(query);
+			}
+		}
+
+		MapChipCollision cellCollision(&field);
+		MapChipCollision boxCollision(&field);
+		boxCollision.SetBoxes(&boxes);
+		float checksum = 0.0f;
+		const double cellNanoseconds = MeasureQueries(cellCollision, queries, kPasses, checksum);
+		const double boxNanoseconds = MeasureQueries(boxCollision, queries, kPasses, checksum);
+
+		// 1マスずつ書き換えて部分更新する
+		start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < kEditCount; ++i) {
+			const uint32_t x = random() % 32;
+			const uint32_t y = random() % 18;
+			field.SetMapChipTypeByIndex(x, y,
+				field.GetMapChipTypeByIndex(x, y) == MapChipType::kBlank ? MapChipType::kBlock : MapChipType::kBlank);
+			boxes.OnCellChanged(field, x, y);
+		}
+		const double editMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / kEditCount;
+
+		std::printf("%s\n", path);
+		std::printf("  blocks=%u  boxes=%zu (%.1fx fewer)  build %.2f us  cell edit %.2f us\n",
+			blocks, boxCount, static_cast<double>(blocks) / boxCount, buildMicroseconds, editMicroseconds);
+		std::printf("  query: cell %.1f ns  box %.1f ns  (%.2fx)  checksum=%.1f\n",
+			cellNanoseconds, boxNanoseconds, cellNanoseconds / boxNanoseconds, checksum);
+	}
+	return 0;
+}
@@ -0,0 +1,297 @@
+// C++
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// Engine
+#include "MapChipBoxes.h"
+#include "MapChipCollision.h"
+#include "MapChipField.h"
+
+// Test
+#include "TestCommon.h"
+
+namespace {
+
+	// 読み込むマップ (作業ディレクトリはリポジトリの直下)
+	const char* const kMaps[] = {
+		"Resources/images/MapChip.csv",
+	};
+
+	/// <summary>
+	/// 1回の判定の結果と、解決に使った接触面
+	/// </summary>
+	struct Outcome {
+		Vector3 position{};
+		Vector3 velocity{};
+		// 同じ種類のマスと接している面 (マスの継ぎ目) で止められた回数
+		uint32_t seamContacts = 0;
+		uint32_t contacts = 0;
+	};
+
+	/// <summary>
+	/// マスが空白でないか (範囲外は空白扱い)
+	/// </summary>
+	bool IsSolid(const MapChipField& field, int32_t xIndex, int32_t yIndex)
+	{
+		if (xIndex < 0 || yIndex < 0 ||
+			xIndex >= static_cast<int32_t>(MapChipField::GetNumBlockHorizontal()) ||
+			yIndex >= static_cast<int32_t>(MapChipField::GetNumBlockVertical())) {
+			return false;
+		}
+		return field.GetMapChipTypeByIndex(static_cast<uint32_t>(xIndex), static_cast<uint32_t>(yIndex)) != MapChipType::kBlank;
+	}
+
+	/// <summary>
+	/// 接触面の外側のマスがすべて埋まっていれば継ぎ目 (実際には触れられない面)
+	/// yIndex が増えるほど z は小さい
+	/// </summary>
+	bool IsSeam(const MapChipField& field, const CollisionInfo& info)
+	{
+		const float width = MapChipField::GetBlockWidth();
+		const float height = MapChipField::GetBlockHeight();
+		const int32_t left = static_cast<int32_t>(std::lround((info.blockRect.left + width / 2.0f) / width));
+		const int32_t right = static_cast<int32_t>(std::lround((info.blockRect.right - width / 2.0f) / width));
+		const int32_t lastRow = static_cast<int32_t>(MapChipField::GetNumBlockVertical()) - 1;
+		const int32_t top = lastRow - static_cast<int32_t>(std::lround((info.blockRect.top - height / 2.0f) / height));
+		const int32_t bottom = lastRow - static_cast<int32_t>(std::lround((info.blockRect.bottom + height / 2.0f) / height));
+
+		auto allSolid = [&](int32_t x0, int32_t x1, int32_t y0, int32_t y1) {
+			for (int32_t y = y0; y <= y1; ++y) {
+				for (int32_t x = x0; x <= x1; ++x) {
+					if (!IsSolid(field, x, y)) {
+						return false;
+					}
+				}
+			}
+			return true;
+		};
+
+		switch (info.direction) {
+		case CollisionDirection::LeftDir:	return allSolid(left - 1, left - 1, top, bottom);
+		case CollisionDirection::RightDir:	return allSolid(right + 1, right + 1, top, bottom);
+		case CollisionDirection::TopDir:	return allSolid(left, right, bottom + 1, bottom + 1);
+		case CollisionDirection::BottomDir:	return allSolid(left, right, top - 1, top - 1);
+		default:							return false;
+		}
+	}
+
+	/// <summary>
+	/// 判定を1回行い、結果と接触面を集める
+	/// </summary>
+	Outcome Resolve(MapChipCollision& collision, const MapChipField& field,
+		const MapChipCollision::ColliderRect& collider, const Vector3& position, const Vector3& velocity)
+	{
+		Outcome outcome;
+		outcome.position = position;
+		outcome.velocity = velocity;
+		collision.DetectAndResolveCollision(collider, outcome.position, outcome.velocity, MapChipCollision::All,
+			[&](const CollisionInfo& info) {
+				++outcome.contacts;
+				if (IsSeam(field, info)) {
+					++outcome.seamContacts;
+				}
+			});
+		return outcome;
+	}
+
+	bool IsSame(const Outcome& a, const Outcome& b)
+	{
+		return std::abs(a.position.x - b.position.x) <= 1e-4f && std::abs(a.position.z - b.position.z) <= 1e-4f &&
+			a.velocity.x == b.velocity.x && a.velocity.z == b.velocity.z;
+	}
+
+	/// <summary>
+	/// 開始位置でブロックにめり込んでいないか
+	/// </summary>
+	bool IsFree(const MapChipField& field, const MapChipCollision::ColliderRect& collider, const Vector3& position)
+	{
+		for (uint32_t y = 0; y < MapChipField::GetNumBlockVertical(); ++y) {
+			for (uint32_t x = 0; x < MapChipField::GetNumBlockHorizontal(); ++x) {
+				if (field.GetMapChipTypeByIndex(x, y) == MapChipType::kBlank) {
+					continue;
+				}
+				const MapChipField::Rect rect = field.GetRectByIndex(x, y);
+				if (position.x + collider.width / 2.0f > rect.left && position.x - collider.width / 2.0f < rect.right &&
+					position.z + collider.height / 2.0f > rect.bottom && position.z - collider.height / 2.0f < rect.top) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// 比べた結果の集計
+	/// </summary>
+	struct Comparison {
+		uint32_t queries = 0;
+		uint32_t contacts = 0;
+		uint32_t mismatches = 0;
+		// 違いが継ぎ目での引っかかりで説明できないもの
+		uint32_t unexplained = 0;
+		uint64_t cellSeamContacts = 0;
+		uint64_t boxSeamContacts = 0;
+	};
+
+	/// <summary>
+	/// 同じ問い合わせをマスごとの判定と矩形の判定に流して比べる
+	/// 違ってよいのは、マスごとの判定が継ぎ目で止められた時だけ
+	/// </summary>
+	Comparison Compare(MapChipField& field, const MapChipBoxes& boxes, uint32_t seed, uint32_t queries)
+	{
+		MapChipCollision cellCollision(&field);
+		MapChipCollision boxCollision(&field);
+		boxCollision.SetBoxes(&boxes);
+
+		std::mt19937 random(seed);
+		std::uniform_real_distribution<float> positionX(-1.0f, 64.0f);
+		std::uniform_real_distribution<float> positionZ(4.0f, 40.0f);
+		std::uniform_real_distribution<float> speed(-1.5f, 1.5f);
+		std::uniform_real_distribution<float> fastSpeed(-5.0f, 5.0f);
+		std::uniform_real_distribution<float> size(0.5f, 3.0f);
+
+		Comparison result;
+		while (result.queries < queries) {
+			// 大きさ・速さの違う当たりを混ぜる (速いものはサブステップに分かれる)
+			const bool fast = result.queries % 4 == 3;
+			const MapChipCollision::ColliderRect collider = result.queries % 2 == 0 ?
+				MapChipCollision::ColliderRect(2.0f, 2.0f) : MapChipCollision::ColliderRect(size(random), size(random));
+			const Vector3 position{ positionX(random), 0.0f, positionZ(random) };
+			const Vector3 velocity{ fast ? fastSpeed(random) : speed(random), 0.0f, fast ? fastSpeed(random) : speed(random) };
+			if (!IsFree(field, collider, position)) {
+				continue;
+			}
+			++result.queries;
+
+			const Outcome cell = Resolve(cellCollision, field, collider, position, velocity);
+			const Outcome box = Resolve(boxCollision, field, collider, position, velocity);
+			result.contacts += cell.contacts != 0;
+			result.cellSeamContacts += cell.seamContacts;
+			result.boxSeamContacts += box.seamContacts;
+			if (IsSame(cell, box)) {
+				continue;
+			}
+			++result.mismatches;
+			if (cell.seamContacts == 0) {
+				++result.unexplained;
+				if (result.unexplained <= 4) {
+					std::printf("  unexplained: p(%.3f, %.3f) v(%.3f, %.3f) cell(%.3f, %.3f) box(%.3f, %.3f)\n",
+						position.x, position.z, velocity.x, velocity.z,
+						cell.position.x, cell.position.z, box.position.x, box.position.z);
+				}
+			}
+		}
+		return result;
+	}
+
+	/// <summary>
+	/// 既存のマップで、矩形の判定がマスごとの判定と同じ結果になる
+	/// 違いは継ぎ目での引っかかり (ゴースト接触) が無くなった分だけ
+	/// </summary>
+	void TestMapsMatch()
+	{
+		for (const char* path : kMaps) {
+			MapChipField field;
+			field.LoadMapChipCsv(path);
+			MapChipBoxes boxes;
+			boxes.Build(field);
+
+			const Comparison result = Compare(field, boxes, 1, 100'000);
+			std::printf("%s: %u queries, %u with contacts, %u differ (cell seam contacts %llu, box seam contacts %llu)\n",
+				path, result.queries, result.contacts, result.mismatches,
+				static_cast<unsigned long long>(result.cellSeamContacts), static_cast<unsigned long long>(result.boxSeamContacts));
+
+			// 当たる問い合わせが十分に含まれている
+			CHECK(result.contacts > result.queries / 20);
+			CHECK(result.unexplained == 0);
+			// 矩形にまとめても継ぎ目は増えない (L字等で矩形同士の継ぎ目は残る)
+			CHECK(result.boxSeamContacts < result.cellSeamContacts);
+		}
+	}
+
+	/// <summary>
+	/// 床を斜めに押しながら進むと、マスごとの判定は隣のマスの側面に当たったことになり横の速度を失う
+	/// 矩形の判定では床が1枚なので、床に止められるだけで横の速度は残る
+	/// </summary>
+	void TestSeamGhostContact()
+	{
+		MapChipField field;
+		field.LoadMapChipCsv(kMaps[0]);
+		MapChipBoxes boxes;
+		boxes.Build(field);
+		MapChipCollision cellCollision(&field);
+		MapChipCollision boxCollision(&field);
+		boxCollision.SetBoxes(&boxes);
+
+		// 一番下の行 (yIndex 17) は全部ブロックで、上面は z = 5。x = 11 がマス5と6の継ぎ目
+		const MapChipCollision::ColliderRect collider(2.0f, 2.0f);
+		const Vector3 position{ 9.9f, 0.0f, 6.0f };
+		const Vector3 velocity{ 0.3f, 0.0f, -0.5f };
+
+		const Outcome cell = Resolve(cellCollision, field, collider, position, velocity);
+		const Outcome box = Resolve(boxCollision, field, collider, position, velocity);
+
+		CHECK(cell.seamContacts == 1);
+		CHECK(std::abs(cell.position.x - 10.0f) <= 1e-4f);
+		CHECK(cell.velocity.x == 0.0f);
+
+		// 当たったステップでは位置を進めないので、x はそのまま
+		CHECK(box.seamContacts == 0);
+		CHECK(box.contacts == 1);
+		CHECK(std::abs(box.position.x - position.x) <= 1e-4f);
+		CHECK(box.velocity.x == velocity.x);
+
+		// 床に乗る結果はどちらも同じ
+		CHECK(std::abs(cell.position.z - 6.0f) <= 1e-4f);
+		CHECK(std::abs(box.position.z - 6.0f) <= 1e-4f);
+		CHECK(cell.velocity.z == 0.0f && box.velocity.z == 0.0f);
+	}
+
+	/// <summary>
+	/// マスを書き換えて部分更新した矩形でも、同じ比べ方で一致する
+	/// </summary>
+	void TestIncrementalMatch()
+	{
+		MapChipField field;
+		field.LoadMapChipCsv(kMaps[0]);
+		MapChipBoxes boxes;
+		boxes.Build(field);
+
+		std::mt19937 random(7);
+		for (int round = 0; round < 8; ++round) {
+			for (int i = 0; i < 64; ++i) {
+				const uint32_t x = random() % 32;
+				const uint32_t y = random() % 18;
+				field.SetMapChipTypeByIndex(x, y, random() % 3 == 0 ? MapChipType::kBlock : MapChipType::kBlank);
+				boxes.OnCellChanged(field, x, y);
+			}
+			// 全体を作り直したものと覆うマスが同じ
+			MapChipBoxes rebuilt;
+			rebuilt.Build(field);
+			bool sameCoverage = true;
+			for (uint32_t y = 0; y < MapChipField::GetNumBlockVertical(); ++y) {
+				for (uint32_t x = 0; x < MapChipField::GetNumBlockHorizontal(); ++x) {
+					sameCoverage = sameCoverage &&
+						(boxes.GetBoxIndexByCell(x, y) == MapChipBoxes::kNoBox) == (rebuilt.GetBoxIndexByCell(x, y) == MapChipBoxes::kNoBox);
+				}
+			}
+			CHECK(sameCoverage);
+
+			const Comparison result = Compare(field, boxes, 100 + round, 5'000);
+			CHECK(result.unexplained == 0);
+		}
+	}
+
+} // namespace
+
+int main()
+{
+	TestMapsMatch();
+	TestSeamGhostContact();
+	TestIncrementalMatch();
+	return Test::Finish("MapChipCollisionTest");
+}
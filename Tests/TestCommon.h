@@ -0,0 +1,37 @@
+#pragma once
+
+// C++
+#include <cstdio>
+
+/// <summary>
+/// テスト共通の小さな道具 (外部のテストフレームワークは使わない)
+/// CHECK は失敗しても止めずに数え、main の最後に Finish で結果を返す
+/// </summary>
+namespace Test {
+
+	inline int& GetFailureCount() {
+		static int count = 0;
+		return count;
+	}
+
+	/// <summary>
+	/// 結果を出して終了コードを返す (失敗が1つでもあれば1)
+	/// </summary>
+	inline int Finish(const char* name) {
+		if (GetFailureCount() == 0) {
+			std::printf("%s: ok\n", name);
+			return 0;
+		}
+		std::printf("%s: %d failure(s)\n", name, GetFailureCount());
+		return 1;
+	}
+
+} // namespace Test
+
+#define CHECK(condition)                                                                  \
+	do {                                                                                  \
+		if (!(condition)) {                                                               \
+			std::printf("%s(%d): CHECK(%s) failed\n", __FILE__, __LINE__, #condition);    \
+			++Test::GetFailureCount();                                                    \
+		}                                                                                 \
+	} while (0)
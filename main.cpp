@@ -3,13 +3,21 @@
 #include <crtdbg.h>
 
 //Windowsアプリのエントリーポイント(main関数)
-int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
+int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR lpCmdLine, int) {
+
+	// ビルド手順: Resources/ をアーカイブにまとめて終了
+	if (lpCmdLine && std::string(lpCmdLine).find(FileSystem::kPackArgument) != std::string::npos) {
+		return FileSystem::PackResources() ? 0 : 1;
+	}
 
 	//_CrtSetBreakAlloc(6327); // ←{1730} を例に
 
 
 	std::unique_ptr<Framework> game = std::make_unique<MyGame>();
 
+	// 入力の記録・再生 (--record <file> / --replay <file>、--seed <n>、--timing <csv>)
+	game->SetReplayOptions(InputRecorder::ParseCommandLine(lpCmdLine ? lpCmdLine : ""));
+
 	game->Run();
 	_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
 